@@ -14,14 +14,20 @@
  limitations under the License.
 */
 #include <algorithm>
+#include <chrono>
 #include <cstring>
 #include <filesystem>
 #include <iomanip>
 #include <iostream>
 #include <map>
 #include <string>
+#include <vector>
 
 #include "commands.h"
+#include "dive_core/command_hierarchy_file.h"
+#include "dive_core/data_core.h"
+#include "dive_core/event_query.h"
+#include "dive_core/pm4_capture_data.h"
 #include "format_output.h"
 
 namespace Dive
@@ -470,6 +476,368 @@ bool RawPM4Command::PrintRawPm4(const char* file_name, int raw_cmd_buffer_type)
     return true;
 }
 
+//--------------------------------------------------------------------------------------------------
+struct HierarchyBenchCommand : Command
+{
+    HierarchyBenchCommand();
+    static int  Run(const char* capture_file, const char* hierarchy_file);
+    int         operator()(int argc, int at, char** argv) const override;
+    int         Help(int argc, int at, char** argv) const override;
+    std::string Description() const override;
+};
+
+HierarchyBenchCommand::HierarchyBenchCommand() :
+    Command("hierarchy_bench", kInternal)
+{
+}
+
+int HierarchyBenchCommand::operator()(int argc, int at, char** argv) const
+{
+    if (at + 3 != argc)
+    {
+        return Help(argc, at, argv);
+    }
+    return Run(argv[at + 1], argv[at + 2]);
+}
+
+int HierarchyBenchCommand::Help(int argc, int at, char** argv) const
+{
+    std::cout << "usage: " << ProgramName(argv[0]) << " " << GetName()
+              << " <capture_file> <hierarchy_file>" << std::endl;
+    std::cout << "  Saves the command hierarchy of <capture_file> to <hierarchy_file>, then times"
+              << std::endl;
+    std::cout << "  rebuilding it by emulation against reloading and memory-mapping the saved file"
+              << std::endl;
+    return EXIT_SUCCESS;
+}
+
+std::string HierarchyBenchCommand::Description() const
+{
+    return "compare command hierarchy rebuild vs reload times";
+}
+
+int HierarchyBenchCommand::Run(const char* capture_file, const char* hierarchy_file)
+{
+    using Clock = std::chrono::steady_clock;
+    auto elapsed_ms = [](Clock::time_point begin) {
+        return std::chrono::duration<double, std::milli>(Clock::now() - begin).count();
+    };
+
+    Dive::Pm4CaptureData capture_data;
+    if (capture_data.LoadCaptureFile(capture_file) != Dive::CaptureData::LoadResult::kSuccess)
+    {
+        std::cerr << "Not able to open: " << capture_file << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    Clock::time_point             begin = Clock::now();
+    Dive::CommandHierarchy        command_hierarchy;
+    Dive::CommandHierarchyCreator creator(command_hierarchy, capture_data);
+    if (!creator.CreateTrees(true, std::nullopt))
+    {
+        std::cerr << "Error parsing capture!" << std::endl;
+        return EXIT_FAILURE;
+    }
+    double rebuild_ms = elapsed_ms(begin);
+
+    begin = Clock::now();
+    if (!Dive::CommandHierarchyFile::Save(command_hierarchy, hierarchy_file))
+    {
+        std::cerr << "Not able to write: " << hierarchy_file << std::endl;
+        return EXIT_FAILURE;
+    }
+    double save_ms = elapsed_ms(begin);
+
+    begin = Clock::now();
+    Dive::CommandHierarchy loaded;
+    if (!Dive::CommandHierarchyFile::Load(hierarchy_file, loaded))
+    {
+        std::cerr << "Not able to load: " << hierarchy_file << std::endl;
+        return EXIT_FAILURE;
+    }
+    double load_ms = elapsed_ms(begin);
+
+    // Touch every node so the mapped timing includes paging the file in
+    begin = Clock::now();
+    Dive::MappedCommandHierarchy mapped;
+    if (!mapped.Open(hierarchy_file))
+    {
+        std::cerr << "Not able to map: " << hierarchy_file << std::endl;
+        return EXIT_FAILURE;
+    }
+    size_t desc_bytes = 0;
+    for (uint64_t node = 0; node < mapped.size(); ++node)
+    {
+        desc_bytes += strlen(mapped.GetNodeDesc(node));
+    }
+    double map_ms = elapsed_ms(begin);
+
+    std::cout << "Nodes: " << command_hierarchy.size() << " (" << desc_bytes
+              << " description bytes)" << std::endl;
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "Rebuild (emulation): " << rebuild_ms << " ms" << std::endl;
+    std::cout << "Save:                " << save_ms << " ms" << std::endl;
+    std::cout << "Reload (full copy):  " << load_ms << " ms" << std::endl;
+    std::cout << "Reload (mapped):     " << map_ms << " ms" << std::endl;
+    return EXIT_SUCCESS;
+}
+
+//--------------------------------------------------------------------------------------------------
+struct QueryCommand : Command
+{
+    QueryCommand();
+    static int  ListColumns();
+    static int  Run(const char*                     capture_file,
+                    const std::vector<const char*>& filters,
+                    const char*                     select);
+    int         operator()(int argc, int at, char** argv) const override;
+    int         Help(int argc, int at, char** argv) const override;
+    std::string Description() const override;
+};
+
+QueryCommand::QueryCommand() :
+    Command("query", kNormal)
+{
+}
+
+int QueryCommand::operator()(int argc, int at, char** argv) const
+{
+    if (at + 2 == argc && !strcmp(argv[at + 1], "--columns"))
+    {
+        return ListColumns();
+    }
+    if (at + 2 > argc)
+    {
+        return Help(argc, at, argv);
+    }
+
+    std::vector<const char*> filters;
+    const char*              select = nullptr;
+    for (int i = at + 2; i < argc; ++i)
+    {
+        if (!strcmp(argv[i], "--select") && i + 1 < argc)
+        {
+            select = argv[++i];
+        }
+        else
+        {
+            filters.push_back(argv[i]);
+        }
+    }
+    return Run(argv[at + 1], filters, select);
+}
+
+int QueryCommand::Help(int argc, int at, char** argv) const
+{
+    std::cout << "usage: " << ProgramName(argv[0]) << " " << GetName()
+              << " <capture_file> [<filter>...] [--select <column>[,<column>...]]" << std::endl;
+    std::cout << "       " << ProgramName(argv[0]) << " " << GetName() << " --columns" << std::endl;
+    std::cout << "  Lists the events matching all filters. A filter is <column><op><value>, with op"
+              << std::endl;
+    std::cout << "  one of == != < <= > >=, e.g. \"type==draw\" \"blend_enabled==true\" "
+                 "\"num_indices>10000\" \"submit==3\""
+              << std::endl;
+    return EXIT_SUCCESS;
+}
+
+std::string QueryCommand::Description() const
+{
+    return "filter and tabulate events by EventInfo and event state columns";
+}
+
+int QueryCommand::ListColumns()
+{
+    for (uint32_t column = 0; column < Dive::EventQuery::GetNumColumns(); ++column)
+    {
+        std::cout << std::left << std::setw(32) << Dive::EventQuery::GetColumnName(column)
+                  << Dive::EventQuery::GetColumnDescription(column) << std::endl;
+    }
+    return EXIT_SUCCESS;
+}
+
+int QueryCommand::Run(const char*                     capture_file,
+                      const std::vector<const char*>& filters,
+                      const char*                     select)
+{
+    Dive::DataCore data_core;
+    if (data_core.LoadPm4CaptureData(capture_file) != Dive::CaptureData::LoadResult::kSuccess)
+    {
+        std::cerr << "Not able to open: " << capture_file << std::endl;
+        return EXIT_FAILURE;
+    }
+    if (!data_core.CreatePm4MetaData())
+    {
+        std::cerr << "Error parsing capture!" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    Dive::EventQuery query(data_core.GetCaptureMetadata());
+    for (const char* filter : filters)
+    {
+        if (!query.AddFilter(filter))
+        {
+            std::cerr << "Invalid filter: " << filter << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    // Default to the columns that were filtered on, plus the event type
+    std::vector<std::string> columns;
+    if (select != nullptr)
+    {
+        std::string list = select;
+        for (size_t begin = 0, end; begin <= list.size(); begin = end + 1)
+        {
+            end = std::min(list.find(',', begin), list.size());
+            if (end > begin)
+                columns.push_back(list.substr(begin, end - begin));
+        }
+    }
+    else
+    {
+        columns.push_back("type");
+        for (const char* filter : filters)
+        {
+            std::string column(filter, strcspn(filter, "=!<>"));
+            if (std::find(columns.begin(), columns.end(), column) == columns.end())
+                columns.push_back(column);
+        }
+    }
+    for (const std::string& column : columns)
+    {
+        if (!query.AddProjection(column))
+        {
+            std::cerr << "Unknown column: " << column << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    Dive::EventQueryResult result;
+    auto                   begin = std::chrono::steady_clock::now();
+    query.Run(&result);
+    std::chrono::duration<double, std::milli> query_ms = std::chrono::steady_clock::now() - begin;
+
+    std::vector<uint32_t> column_ids;
+    std::cout << "event";
+    for (const std::string& column : result.m_columns)
+    {
+        column_ids.push_back(Dive::EventQuery::FindColumn(column));
+        std::cout << "\t" << column;
+    }
+    std::cout << std::endl;
+    for (size_t row = 0; row < result.m_event_ids.size(); ++row)
+    {
+        std::cout << result.m_event_ids[row];
+        for (size_t c = 0; c < column_ids.size(); ++c)
+        {
+            std::cout << "\t"
+                      << Dive::EventQuery::FormatValue(column_ids[c], result.m_values[c][row]);
+        }
+        std::cout << std::endl;
+    }
+    std::cerr << result.m_event_ids.size() << " of "
+              << data_core.GetCaptureMetadata().m_event_info.size() << " events matched in "
+              << std::fixed << std::setprecision(2) << query_ms.count() << " ms" << std::endl;
+    return EXIT_SUCCESS;
+}
+
+//--------------------------------------------------------------------------------------------------
+struct RefsCommand : Command
+{
+    RefsCommand();
+    static int  Run(const char* capture_file, uint64_t va_start, uint64_t va_end);
+    int         operator()(int argc, int at, char** argv) const override;
+    int         Help(int argc, int at, char** argv) const override;
+    std::string Description() const override;
+};
+
+RefsCommand::RefsCommand() :
+    Command("refs", kNormal)
+{
+}
+
+int RefsCommand::operator()(int argc, int at, char** argv) const
+{
+    if (at + 3 != argc)
+    {
+        return Help(argc, at, argv);
+    }
+
+    // <va> or <va>-<va_end>, in hex with or without 0x
+    const char* range = argv[at + 2];
+    char*       end = nullptr;
+    uint64_t    va_start = strtoull(range, &end, 16);
+    uint64_t    va_end = va_start + 1;
+    if (*end == '-')
+    {
+        va_end = strtoull(end + 1, &end, 16);
+    }
+    if (end == range || *end != '\0' || va_end <= va_start)
+    {
+        std::cerr << "Invalid address range: " << range << std::endl;
+        return EXIT_FAILURE;
+    }
+    return Run(argv[at + 1], va_start, va_end);
+}
+
+int RefsCommand::Help(int argc, int at, char** argv) const
+{
+    std::cout << "usage: " << ProgramName(argv[0]) << " " << GetName()
+              << " <capture_file> <va>[-<va_end>]" << std::endl;
+    std::cout << "  Lists the shaders, index buffers, descriptors and indirect buffers overlapping"
+              << std::endl;
+    std::cout << "  the GPU address range [va, va_end) in hex, and the events (with their command"
+              << std::endl;
+    std::cout << "  hierarchy node) referencing them" << std::endl;
+    return EXIT_SUCCESS;
+}
+
+std::string RefsCommand::Description() const
+{
+    return "find the events referencing a GPU address";
+}
+
+int RefsCommand::Run(const char* capture_file, uint64_t va_start, uint64_t va_end)
+{
+    Dive::DataCore data_core;
+    if (data_core.LoadPm4CaptureData(capture_file) != Dive::CaptureData::LoadResult::kSuccess)
+    {
+        std::cerr << "Not able to open: " << capture_file << std::endl;
+        return EXIT_FAILURE;
+    }
+    // The command hierarchy is needed to map the events to their nodes
+    if (!data_core.ParsePm4CaptureData())
+    {
+        std::cerr << "Error parsing capture!" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    const Dive::AddressIndex& address_index = data_core.GetCaptureMetadata().m_address_index;
+    std::vector<uint32_t>     range_indices;
+    address_index.FindOverlapping(va_start, va_end, &range_indices);
+    std::sort(range_indices.begin(), range_indices.end());
+    for (uint32_t range_index : range_indices)
+    {
+        const Dive::AddressRange& range = address_index.GetRange(range_index);
+        std::cout << std::left << std::setw(16) << Dive::GetAddressRangeTypeName(range.m_type)
+                  << std::hex << "0x" << range.m_va_start << "-0x" << range.m_va_end << std::dec
+                  << "\tevents " << range.m_first_event << "-" << range.m_end_event << std::endl;
+    }
+
+    const Dive::CommandHierarchy& command_hierarchy = data_core.GetCommandHierarchy();
+    std::vector<uint32_t>         events = address_index.FindEvents(va_start, va_end);
+    for (uint32_t event_id : events)
+    {
+        uint64_t node_index = command_hierarchy.GetEventNodeIndex(event_id);
+        std::cout << event_id << "\t";
+        if (node_index != UINT64_MAX)
+            std::cout << "node " << node_index << "\t" << command_hierarchy.GetNodeDesc(node_index);
+        std::cout << std::endl;
+    }
+    std::cerr << range_indices.size() << " ranges, " << events.size() << " events" << std::endl;
+    return EXIT_SUCCESS;
+}
+
 //--------------------------------------------------------------------------------------------------
 const Command& CommandOf<HelpCommand>::Get(const std::map<std::string, const Command*>* commands)
 {
@@ -488,6 +856,9 @@ template const Command& CommandOf<ExtractCommand>::Get();
 template const Command& CommandOf<PacketCommand>::Get();
 template const Command& CommandOf<InfoCommand>::Get();
 template const Command& CommandOf<RawPM4Command>::Get();
+template const Command& CommandOf<HierarchyBenchCommand>::Get();
+template const Command& CommandOf<QueryCommand>::Get();
+template const Command& CommandOf<RefsCommand>::Get();
 
 }  // namespace cli
 }  // namespace Dive
@@ -57,12 +57,15 @@ private:
 struct HelpCommand;
 struct VersionCommand;
 struct ExtractCommand;
+struct RefsCommand;
 
 // Internal utilities, originally from capture_reporter.
 // Hiding from user as they are not intended for normal end user flow.
 struct PacketCommand;
 struct InfoCommand;
 struct RawPM4Command;
+struct HierarchyBenchCommand;
+struct QueryCommand;
 
 template<typename T> struct CommandOf
 {
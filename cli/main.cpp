@@ -31,11 +31,14 @@ int main(int argc, char** argv)
         &CommandOf<HelpCommand>::Get(&commands),
         &CommandOf<VersionCommand>::Get(),
         &CommandOf<ExtractCommand>::Get(),
+        &CommandOf<QueryCommand>::Get(),
+        &CommandOf<RefsCommand>::Get(),
         // Internal, use `divecli help --internal`
         // It's hidden to not cause confusion.
         &CommandOf<PacketCommand>::Get(),
         &CommandOf<InfoCommand>::Get(),
         &CommandOf<RawPM4Command>::Get(),
+        &CommandOf<HierarchyBenchCommand>::Get(),
     };
     for (auto cmd : commandlist)
     {
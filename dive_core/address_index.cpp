@@ -0,0 +1,237 @@
+/*
+ Copyright 2025 Google LLC
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#include "address_index.h"
+#include <algorithm>
+#include <tuple>
+#include "command_hierarchy.h"
+#include "dive_core/common/common.h"
+
+namespace Dive
+{
+
+//--------------------------------------------------------------------------------------------------
+const char *GetAddressRangeTypeName(AddressRangeType type)
+{
+    switch (type)
+    {
+    case AddressRangeType::kShader:
+        return "shader";
+    case AddressRangeType::kIndexBuffer:
+        return "index_buffer";
+    case AddressRangeType::kDescriptors:
+        return "descriptors";
+    case AddressRangeType::kIndirectBuffer:
+        return "indirect_buffer";
+    case AddressRangeType::kCount:
+        break;
+    }
+    return "unknown";
+}
+
+// =================================================================================================
+// AddressIndex
+// =================================================================================================
+size_t AddressIndex::PendingKeyHash::operator()(const PendingKey &key) const
+{
+    uint64_t hash = key.m_va_start * 0x9E3779B97F4A7C15ull;
+    hash ^= (key.m_va_end - key.m_va_start) + (hash << 6) + (hash >> 2);
+    return static_cast<size_t>(hash ^ static_cast<uint64_t>(key.m_type));
+}
+
+//--------------------------------------------------------------------------------------------------
+void AddressIndex::Clear()
+{
+    *this = AddressIndex();
+}
+
+//--------------------------------------------------------------------------------------------------
+void AddressIndex::AddEventReference(AddressRangeType type,
+                                     uint64_t         va_start,
+                                     uint64_t         va_end,
+                                     uint32_t         event_id)
+{
+    DIVE_ASSERT(!m_is_built);
+    PendingKey key = { va_start, va_end, type };
+    auto       it = m_last_range.find(key);
+    if (it != m_last_range.end())
+    {
+        AddressRange &range = m_ranges[it->second];
+        if (range.m_end_event == event_id + 1)
+            return;  // Referenced more than once by the same event
+        if (range.m_end_event == event_id)
+        {
+            range.m_end_event = event_id + 1;
+            return;
+        }
+    }
+    m_last_range[key] = static_cast<uint32_t>(m_ranges.size());
+    AddRange(type, va_start, va_end, event_id, event_id + 1);
+}
+
+//--------------------------------------------------------------------------------------------------
+void AddressIndex::AddRange(AddressRangeType type,
+                            uint64_t         va_start,
+                            uint64_t         va_end,
+                            uint32_t         first_event,
+                            uint32_t         end_event)
+{
+    DIVE_ASSERT(!m_is_built);
+    DIVE_ASSERT(va_start < va_end && first_event <= end_event);
+    m_ranges.push_back({ va_start, va_end, first_event, end_event, type });
+}
+
+//--------------------------------------------------------------------------------------------------
+void AddressIndex::Build()
+{
+    m_last_range = {};
+    std::sort(m_ranges.begin(), m_ranges.end(), [](const AddressRange &a, const AddressRange &b) {
+        return std::tie(a.m_va_start, a.m_va_end, a.m_type, a.m_first_event) <
+               std::tie(b.m_va_start, b.m_va_end, b.m_type, b.m_first_event);
+    });
+    m_ranges.shrink_to_fit();
+    m_is_built = true;
+
+    size_t n = m_ranges.size();
+    m_max_end.resize(n);
+    m_max_level = 0;
+    if (n == 0)
+        return;
+
+    // Leaves (level 0) are the even indices. `last` tracks the max end of the rightmost subtree
+    // of the previous level, which stands in for right children past the end of the array
+    size_t   last_i = 0;
+    uint64_t last = 0;
+    for (size_t i = 0; i < n; i += 2)
+    {
+        last_i = i;
+        last = m_max_end[i] = m_ranges[i].m_va_end;
+    }
+    uint32_t level = 1;
+    for (; (size_t(1) << level) <= n; ++level)
+    {
+        size_t half = size_t(1) << (level - 1);
+        for (size_t i = (half << 1) - 1; i < n; i += half << 2)
+        {
+            uint64_t left = m_max_end[i - half];
+            uint64_t right = i + half < n ? m_max_end[i + half] : last;
+            m_max_end[i] = std::max({ m_ranges[i].m_va_end, left, right });
+        }
+        last_i = ((last_i >> level) & 1) ? last_i - half : last_i + half;
+        if (last_i < n)
+            last = std::max(last, m_max_end[last_i]);
+    }
+    m_max_level = level - 1;
+}
+
+//--------------------------------------------------------------------------------------------------
+void AddressIndex::FindOverlapping(uint64_t               va_start,
+                                   uint64_t               va_end,
+                                   std::vector<uint32_t> *range_indices) const
+{
+    DIVE_ASSERT(m_is_built);
+    size_t n = m_ranges.size();
+    if (n == 0 || va_start >= va_end)
+        return;
+
+    struct Visit
+    {
+        size_t   m_index;
+        uint32_t m_level;
+        bool     m_left_done;
+    };
+    // At most 2 pending visits per level
+    Visit    stack[128];
+    uint32_t top = 0;
+    stack[top++] = { (size_t(1) << m_max_level) - 1, m_max_level, false };
+    while (top > 0)
+    {
+        Visit visit = stack[--top];
+        if (visit.m_level <= 3)
+        {
+            // Small subtree: scan it in order, stopping at the first range starting past the end
+            size_t begin = visit.m_index >> visit.m_level << visit.m_level;
+            size_t end = std::min(begin + (size_t(1) << (visit.m_level + 1)) - 1, n);
+            for (size_t i = begin; i < end && m_ranges[i].m_va_start < va_end; ++i)
+            {
+                if (va_start < m_ranges[i].m_va_end)
+                    range_indices->push_back(static_cast<uint32_t>(i));
+            }
+        }
+        else if (!visit.m_left_done)
+        {
+            // Revisit this node after the left subtree, which is only searched if it can overlap
+            size_t left = visit.m_index - (size_t(1) << (visit.m_level - 1));
+            stack[top++] = { visit.m_index, visit.m_level, true };
+            if (left >= n || m_max_end[left] > va_start)
+                stack[top++] = { left, visit.m_level - 1, false };
+        }
+        else if (visit.m_index < n && m_ranges[visit.m_index].m_va_start < va_end)
+        {
+            if (va_start < m_ranges[visit.m_index].m_va_end)
+                range_indices->push_back(static_cast<uint32_t>(visit.m_index));
+            stack[top++] = { visit.m_index + (size_t(1) << (visit.m_level - 1)),
+                             visit.m_level - 1,
+                             false };
+        }
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+std::vector<uint32_t> AddressIndex::FindEvents(uint64_t         va_start,
+                                               uint64_t         va_end,
+                                               AddressRangeType type) const
+{
+    std::vector<uint32_t> range_indices;
+    FindOverlapping(va_start, va_end, &range_indices);
+
+    std::vector<uint32_t> events;
+    for (uint32_t range_index : range_indices)
+    {
+        const AddressRange &range = m_ranges[range_index];
+        if (type != AddressRangeType::kCount && range.m_type != type)
+            continue;
+        for (uint32_t event_id = range.m_first_event; event_id < range.m_end_event; ++event_id)
+            events.push_back(event_id);
+    }
+    std::sort(events.begin(), events.end());
+    events.erase(std::unique(events.begin(), events.end()), events.end());
+    return events;
+}
+
+//--------------------------------------------------------------------------------------------------
+std::vector<uint64_t> AddressIndex::FindEventNodes(const CommandHierarchy &command_hierarchy,
+                                                   uint64_t                va_start,
+                                                   uint64_t                va_end,
+                                                   AddressRangeType        type) const
+{
+    std::vector<uint64_t> nodes;
+    for (uint32_t event_id : FindEvents(va_start, va_end, type))
+    {
+        uint64_t node_index = command_hierarchy.GetEventNodeIndex(event_id);
+        if (node_index != UINT64_MAX)
+            nodes.push_back(node_index);
+    }
+    return nodes;
+}
+
+//--------------------------------------------------------------------------------------------------
+size_t AddressIndex::GetMemoryUsage() const
+{
+    return m_ranges.capacity() * sizeof(AddressRange) + m_max_end.capacity() * sizeof(uint64_t);
+}
+
+}  // namespace Dive
@@ -0,0 +1,138 @@
+/*
+ Copyright 2025 Google LLC
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+// =====================================================================================================================
+// Index from GPU virtual address ranges to the events referencing them. Answers "which events use
+// the shader/buffer/descriptors at this address" without scanning every event.
+// =====================================================================================================================
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace Dive
+{
+
+class CommandHierarchy;
+
+//--------------------------------------------------------------------------------------------------
+enum class AddressRangeType : uint8_t
+{
+    kShader,          // Shader code, by entry address only (the size is known once disassembled)
+    kIndexBuffer,     // Indices read by an indexed draw
+    kDescriptors,     // Texture, sampler, UBO and UAV descriptors loaded with CP_LOAD_STATE6
+    kIndirectBuffer,  // PM4 commands, referenced by the events issued from them
+    kCount
+};
+
+const char *GetAddressRangeTypeName(AddressRangeType type);
+
+//--------------------------------------------------------------------------------------------------
+// [m_va_start, m_va_end) is referenced by the events [m_first_event, m_end_event). The event range
+// is empty for an indirect buffer that issued no events.
+struct AddressRange
+{
+    uint64_t         m_va_start;
+    uint64_t         m_va_end;
+    uint32_t         m_first_event;
+    uint32_t         m_end_event;
+    AddressRangeType m_type;
+};
+
+//--------------------------------------------------------------------------------------------------
+// The ranges are kept sorted by start address in a flat array, which doubles as an implicit
+// binary tree: the node at index i is at level k when i has exactly k trailing 1 bits, and
+// m_max_end holds the largest end address of each node's subtree. Lookups are O(log n + k) for k
+// overlapping ranges.
+class AddressIndex
+{
+public:
+    void Clear();
+
+    // Records that `event_id` references [va_start, va_end). When the previous reference to the
+    // same range came from the previous event, that entry is extended instead, so a range used by
+    // a run of consecutive events costs a single entry. Must be called before Build().
+    void AddEventReference(AddressRangeType type,
+                           uint64_t         va_start,
+                           uint64_t         va_end,
+                           uint32_t         event_id);
+
+    // Records that the events [first_event, end_event) reference [va_start, va_end). Must be
+    // called before Build().
+    void AddRange(AddressRangeType type,
+                  uint64_t         va_start,
+                  uint64_t         va_end,
+                  uint32_t         first_event,
+                  uint32_t         end_event);
+
+    // Sorts the ranges and builds the search tree. Needs to be called once all ranges are added
+    void Build();
+    bool IsBuilt() const { return m_is_built; }
+
+    size_t              size() const { return m_ranges.size(); }
+    const AddressRange &GetRange(uint32_t index) const { return m_ranges[index]; }
+
+    // Appends the index of every range overlapping [va_start, va_end) to `range_indices`, in no
+    // particular order
+    void FindOverlapping(uint64_t               va_start,
+                         uint64_t               va_end,
+                         std::vector<uint32_t> *range_indices) const;
+
+    // Ids of the events referencing any address in [va_start, va_end), in ascending order.
+    // Restricted to ranges of `type` unless it is kCount
+    std::vector<uint32_t> FindEvents(uint64_t         va_start,
+                                     uint64_t         va_end,
+                                     AddressRangeType type = AddressRangeType::kCount) const;
+
+    // Same as FindEvents(), as indices of the event nodes in `command_hierarchy`
+    std::vector<uint64_t> FindEventNodes(const CommandHierarchy &command_hierarchy,
+                                         uint64_t                va_start,
+                                         uint64_t                va_end,
+                                         AddressRangeType type = AddressRangeType::kCount) const;
+
+    size_t GetMemoryUsage() const;
+
+private:
+    struct PendingKey
+    {
+        uint64_t         m_va_start;
+        uint64_t         m_va_end;
+        AddressRangeType m_type;
+
+        bool operator==(const PendingKey &other) const
+        {
+            return m_va_start == other.m_va_start && m_va_end == other.m_va_end &&
+                   m_type == other.m_type;
+        }
+    };
+    struct PendingKeyHash
+    {
+        size_t operator()(const PendingKey &key) const;
+    };
+
+    std::vector<AddressRange> m_ranges;
+    std::vector<uint64_t>     m_max_end;
+    uint32_t                  m_max_level = 0;
+    bool                      m_is_built = false;
+
+    // Last range added for each distinct address range, to extend runs of consecutive events.
+    // Only used while adding ranges
+    std::unordered_map<PendingKey, uint32_t, PendingKeyHash> m_last_range;
+};
+
+}  // namespace Dive
@@ -409,4 +409,168 @@ uint32_t Util::GetIndexCount(const IMemoryManager &mem_manager,
     return index_count;
 }
 
-}  // namespace Dive
\ No newline at end of file
+//--------------------------------------------------------------------------------------------------
+uint32_t Util::GetInstanceCount(const IMemoryManager &mem_manager,
+                                uint32_t              submit_index,
+                                uint64_t              va_addr,
+                                Pm4Type7Header        header)
+{
+    uint32_t instance_count = 0;
+
+    // Indirect draws are not handled, as in GetIndexCount()
+    if (header.opcode == CP_DRAW_INDX)
+    {
+        PM4_CP_DRAW_INDX packet;
+        DIVE_VERIFY(mem_manager.RetrieveMemoryData(&packet, submit_index, va_addr, sizeof(packet)))
+        instance_count = packet.bitfields1.NUM_INSTANCES;
+    }
+    else if (header.opcode == CP_DRAW_INDX_OFFSET)
+    {
+        PM4_CP_DRAW_INDX_OFFSET packet;
+        uint32_t                header_and_body_dword_count = header.count + 1;
+        DIVE_VERIFY(mem_manager.RetrieveMemoryData(&packet,
+                                                   submit_index,
+                                                   va_addr,
+                                                   header_and_body_dword_count * sizeof(uint32_t)));
+        instance_count = packet.bitfields1.NUM_INSTANCES;
+    }
+    return instance_count;
+}
+
+// =================================================================================================
+// EventInfoTable
+// =================================================================================================
+void EventInfoTable::clear()
+{
+    *this = EventInfoTable();
+}
+
+//--------------------------------------------------------------------------------------------------
+void EventInfoTable::reserve(size_t num_events)
+{
+    m_events.reserve(num_events);
+    m_str_offsets.reserve(num_events + 1);
+    m_shader_ref_offsets.reserve(num_events + 1);
+    m_buffer_offsets.reserve(num_events * kNumStages + 1);
+    m_log_offsets.reserve(num_events);
+}
+
+//--------------------------------------------------------------------------------------------------
+void EventInfoTable::push_back(const EventInfo &event_info, std::string_view str)
+{
+    m_events.push_back(event_info);
+
+    m_strings.append(str);
+    m_str_offsets.push_back(static_cast<uint32_t>(m_strings.size()));
+
+    m_shader_ref_offsets.push_back(static_cast<uint32_t>(m_shader_references.size()));
+    m_buffer_offsets.insert(m_buffer_offsets.end(),
+                            kNumStages,
+                            static_cast<uint32_t>(m_buffer_indices.size()));
+    m_log_offsets.push_back(m_metadata_log.GetNumRecords());
+    m_metadata_log.SetDefaultRef(CrossRef(CrossRefType::kEvent, m_events.size() - 1));
+}
+
+//--------------------------------------------------------------------------------------------------
+std::string_view EventInfoTable::GetString(size_t event_id) const
+{
+    DIVE_ASSERT(event_id < m_events.size());
+    uint32_t begin = m_str_offsets[event_id];
+    return std::string_view(m_strings).substr(begin, m_str_offsets[event_id + 1] - begin);
+}
+
+//--------------------------------------------------------------------------------------------------
+std::span<const ShaderReference> EventInfoTable::GetShaderReferences(size_t event_id) const
+{
+    DIVE_ASSERT(event_id < m_events.size());
+    uint32_t begin = m_shader_ref_offsets[event_id];
+    return std::span<const ShaderReference>(m_shader_references.data() + begin,
+                                            m_shader_ref_offsets[event_id + 1] - begin);
+}
+
+//--------------------------------------------------------------------------------------------------
+std::span<ShaderReference> EventInfoTable::GetShaderReferences(size_t event_id)
+{
+    DIVE_ASSERT(event_id < m_events.size());
+    uint32_t begin = m_shader_ref_offsets[event_id];
+    return std::span<ShaderReference>(m_shader_references.data() + begin,
+                                      m_shader_ref_offsets[event_id + 1] - begin);
+}
+
+//--------------------------------------------------------------------------------------------------
+std::span<const uint32_t> EventInfoTable::GetBufferIndices(size_t      event_id,
+                                                           ShaderStage stage) const
+{
+    DIVE_ASSERT(event_id < m_events.size());
+    size_t   range = event_id * kNumStages + (uint32_t)stage;
+    uint32_t begin = m_buffer_offsets[range];
+    return std::span<const uint32_t>(m_buffer_indices.data() + begin,
+                                     m_buffer_offsets[range + 1] - begin);
+}
+
+//--------------------------------------------------------------------------------------------------
+void EventInfoTable::AddShaderReference(const ShaderReference &reference)
+{
+    DIVE_ASSERT(!m_events.empty());
+    m_shader_references.push_back(reference);
+    m_shader_ref_offsets.back()++;
+}
+
+//--------------------------------------------------------------------------------------------------
+void EventInfoTable::AddBufferIndex(ShaderStage stage, uint32_t buffer_index)
+{
+    DIVE_ASSERT(!m_events.empty());
+
+    // The ranges of the later stages of the last event must still be empty, i.e. end where this
+    // stage's range ends
+    size_t range_end = (m_events.size() - 1) * kNumStages + (uint32_t)stage + 1;
+    DIVE_ASSERT(m_buffer_offsets[range_end] == m_buffer_indices.size());
+
+    m_buffer_indices.push_back(buffer_index);
+    for (size_t i = range_end; i < m_buffer_offsets.size(); ++i)
+        m_buffer_offsets[i]++;
+}
+
+//--------------------------------------------------------------------------------------------------
+uint32_t EventInfoTable::GetMetadataLogEnd(size_t event_id) const
+{
+    if (event_id + 1 < m_log_offsets.size())
+        return m_log_offsets[event_id + 1];
+    return m_metadata_log.GetNumRecords();
+}
+
+//--------------------------------------------------------------------------------------------------
+uint32_t EventInfoTable::GetNumMetadataLogEntries(size_t event_id) const
+{
+    DIVE_ASSERT(event_id < m_events.size());
+    return GetMetadataLogEnd(event_id) - GetMetadataLogBegin(event_id);
+}
+
+//--------------------------------------------------------------------------------------------------
+void EventInfoTable::LogMetadataEntriesTo(size_t         event_id,
+                                          LogAssociation association,
+                                          uint32_t       id,
+                                          ILog          &other) const
+{
+    DIVE_ASSERT(event_id < m_events.size());
+    for (uint32_t i = GetMetadataLogBegin(event_id); i < GetMetadataLogEnd(event_id); ++i)
+    {
+        ILog::LogEntry entry = m_metadata_log.GetEntry(i);
+        entry.m_ref = CrossRef(association, id);
+        other.Log(entry);
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+size_t EventInfoTable::GetMemoryUsage() const
+{
+    return m_events.capacity() * sizeof(EventInfo) + m_strings.capacity() +
+           m_str_offsets.capacity() * sizeof(uint32_t) +
+           m_shader_references.capacity() * sizeof(ShaderReference) +
+           m_shader_ref_offsets.capacity() * sizeof(uint32_t) +
+           m_buffer_indices.capacity() * sizeof(uint32_t) +
+           m_buffer_offsets.capacity() * sizeof(uint32_t) +
+           m_log_offsets.capacity() * sizeof(uint32_t);
+}
+
+}  // namespace Dive
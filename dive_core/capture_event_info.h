@@ -15,6 +15,9 @@
 */
 
 #pragma once
+#include <span>
+#include <string>
+#include <string_view>
 #include <vector>
 #include "capture_data.h"
 #include "common.h"
@@ -52,6 +55,11 @@ struct ShaderReference
             return m_stage < other.m_stage;
         return m_enable_mask < other.m_enable_mask;
     }
+    bool operator==(const ShaderReference &other) const
+    {
+        return m_shader_index == other.m_shader_index && m_stage == other.m_stage &&
+               m_enable_mask == other.m_enable_mask;
+    }
 };
 
 enum class RenderModeType
@@ -66,22 +74,16 @@ enum class RenderModeType
 };
 
 //--------------------------------------------------------------------------------------------------
+// Fixed-size part of an event. The variable-length parts (buffer indices, shader references,
+// event string, metadata log entries) live in the shared arrays of the owning EventInfoTable.
 struct EventInfo
 {
-    // Indices of each buffer used in the event, for each shader
-    std::vector<uint32_t> m_buffer_indices[(uint32_t)ShaderStage::kShaderStageCount];
-
-    // Log entries from parsing the capture metadata and disassembling the shaders.
-    // These cannot be directly output to the log because we don't know the eventIds while parsing
-    // the metadata.
-    DeferredLog m_metadata_log;
-
-    // References of each shader used in the event.
-    std::vector<ShaderReference> m_shader_references;
-
     // Number of indices processed, for draw calls (including non-indexed draws)
     uint32_t m_num_indices;
 
+    // Number of instances, for draw calls. 0 for indirect draws, like m_num_indices
+    uint32_t m_num_instances;
+
     // Submit that contains this event
     uint32_t m_submit_index;
 
@@ -109,7 +111,94 @@ struct EventInfo
     EventType m_type;
 
     RenderModeType m_render_mode = RenderModeType::kUnknown;
-    std::string    m_str;
+};
+
+//--------------------------------------------------------------------------------------------------
+// The events of a capture. The per-event lists are stored CSR-style: one capture-wide array per
+// list, plus the offset at which each event's range starts, so loading a capture does not allocate
+// per event. Lists can only be appended to for the most recently added event.
+class EventInfoTable
+{
+public:
+    using const_iterator = std::vector<EventInfo>::const_iterator;
+
+    size_t           size() const { return m_events.size(); }
+    bool             empty() const { return m_events.empty(); }
+    const EventInfo &operator[](size_t event_id) const { return m_events[event_id]; }
+    EventInfo       &operator[](size_t event_id) { return m_events[event_id]; }
+    const EventInfo &back() const { return m_events.back(); }
+    EventInfo       &back() { return m_events.back(); }
+    const_iterator   begin() const { return m_events.begin(); }
+    const_iterator   end() const { return m_events.end(); }
+    const EventInfo *data() const { return m_events.data(); }
+
+    void clear();
+    void reserve(size_t num_events);
+
+    // Adds an event whose lists are all empty
+    void push_back(const EventInfo &event_info, std::string_view str = {});
+
+    // Description of the event, e.g. "DrawIndexOffset(...)"
+    std::string_view GetString(size_t event_id) const;
+
+    // References of each shader used in the event
+    std::span<const ShaderReference> GetShaderReferences(size_t event_id) const;
+    std::span<ShaderReference>       GetShaderReferences(size_t event_id);
+
+    // Indices of each buffer used in the event by the shader of `stage`
+    std::span<const uint32_t> GetBufferIndices(size_t event_id, ShaderStage stage) const;
+
+    // Shader references of all events, in event order. Event i's references are
+    // [offsets[i], offsets[i + 1]), so there are size() + 1 offsets
+    std::span<const ShaderReference> GetAllShaderReferences() const { return m_shader_references; }
+    std::span<const uint32_t>        GetShaderReferenceOffsets() const
+    {
+        return m_shader_ref_offsets;
+    }
+
+    // Appends to the lists of the last event. Buffer indices must be added in stage order
+    void AddShaderReference(const ShaderReference &reference);
+    void AddBufferIndex(ShaderStage stage, uint32_t buffer_index);
+
+    // Log entries from parsing the capture metadata and disassembling the shaders, for all events.
+    // Entries logged to GetMetadataLog() belong to the last event, and are associated with it
+    // unless they carry their own reference. Use LogArena::FindProblems() for capture-wide queries.
+    LogArena       *GetMetadataLog() { return &m_metadata_log; }
+    const LogArena &GetMetadataLog() const { return m_metadata_log; }
+    uint32_t        GetNumMetadataLogEntries(size_t event_id) const;
+    void            LogMetadataEntriesTo(size_t         event_id,
+                                         LogAssociation association,
+                                         uint32_t       id,
+                                         ILog          &other) const;
+
+    // Bytes used by the table, excluding the metadata log
+    size_t GetMemoryUsage() const;
+
+private:
+    static constexpr uint32_t kNumStages = (uint32_t)ShaderStage::kShaderStageCount;
+
+    // Index of the first metadata log entry of each event. The last event's range ends at the
+    // current size of the log
+    uint32_t GetMetadataLogBegin(size_t event_id) const { return m_log_offsets[event_id]; }
+    uint32_t GetMetadataLogEnd(size_t event_id) const;
+
+    std::vector<EventInfo> m_events;
+
+    // Event i's string is m_strings[m_str_offsets[i], m_str_offsets[i + 1])
+    std::string           m_strings;
+    std::vector<uint32_t> m_str_offsets = { 0 };
+
+    // Event i's references are m_shader_references[m_shader_ref_offsets[i], ...[i + 1])
+    std::vector<ShaderReference> m_shader_references;
+    std::vector<uint32_t>        m_shader_ref_offsets = { 0 };
+
+    // One range per (event, stage): event i's indices for stage s are
+    // m_buffer_indices[m_buffer_offsets[i * kNumStages + s], ...[i * kNumStages + s + 1])
+    std::vector<uint32_t> m_buffer_indices;
+    std::vector<uint32_t> m_buffer_offsets = { 0 };
+
+    LogArena              m_metadata_log;
+    std::vector<uint32_t> m_log_offsets;
 };
 
 //--------------------------------------------------------------------------------------------------
@@ -160,6 +249,10 @@ public:
                                      uint32_t              submit_index,
                                      uint64_t              va_addr,
                                      Pm4Type7Header        header);
+    static uint32_t    GetInstanceCount(const IMemoryManager &mem_manager,
+                                        uint32_t              submit_index,
+                                        uint64_t              va_addr,
+                                        Pm4Type7Header        header);
 };
 
 }  // namespace Dive
@@ -30,6 +30,7 @@
 
 #include "dive_strings.h"
 #include "pm4_info.h"
+#include "thread_pool.h"
 
 namespace Dive
 {
@@ -206,6 +207,101 @@ void SharedNodeTopology::AddSharedChildren(uint64_t                    node_inde
     m_node_shared_children[node_index].m_num_children = children.size();
 }
 
+// =================================================================================================
+// FilteredTopology
+// =================================================================================================
+uint64_t FilteredTopology::GetNumChildren(uint64_t node_index) const
+{
+    DIVE_ASSERT(m_topology != nullptr);
+    if (m_visible_prefix.empty())
+        return m_topology->GetNumChildren(node_index);
+
+    DIVE_ASSERT(node_index < m_topology->m_node_children.size());
+    const Topology::ChildrenInfo &info = m_topology->m_node_children[node_index];
+    if (info.m_num_children == 0)
+        return 0;
+    return m_visible_prefix[info.m_start_index + info.m_num_children] -
+           m_visible_prefix[info.m_start_index];
+}
+
+//--------------------------------------------------------------------------------------------------
+uint64_t FilteredTopology::GetChildNodeIndex(uint64_t node_index, uint64_t child_index) const
+{
+    DIVE_ASSERT(m_topology != nullptr);
+    if (m_visible_prefix.empty())
+        return m_topology->GetChildNodeIndex(node_index, child_index);
+
+    DIVE_ASSERT(child_index < GetNumChildren(node_index));
+    const Topology::ChildrenInfo &info = m_topology->m_node_children[node_index];
+
+    // First position in the parent's range where the visible count passes child_index
+    const uint64_t *first = m_visible_prefix.data() + info.m_start_index + 1;
+    const uint64_t *last = first + info.m_num_children;
+    const uint64_t *it = std::upper_bound(first,
+                                          last,
+                                          m_visible_prefix[info.m_start_index] + child_index);
+    DIVE_ASSERT(it != last);
+    return m_topology->m_children_list[it - m_visible_prefix.data() - 1];
+}
+
+//--------------------------------------------------------------------------------------------------
+uint64_t FilteredTopology::GetChildIndex(uint64_t node_index) const
+{
+    DIVE_ASSERT(m_topology != nullptr);
+    if (m_visible_prefix.empty())
+        return m_topology->GetChildIndex(node_index);
+
+    uint64_t list_index = GetChildListIndex(node_index);
+    if (list_index == UINT64_MAX)
+        return m_topology->GetChildIndex(node_index);
+    if (m_visible_prefix[list_index + 1] == m_visible_prefix[list_index])
+        return UINT64_MAX;
+    uint64_t parent_start = m_topology->m_node_children[m_topology->GetParentNodeIndex(node_index)]
+                            .m_start_index;
+    return m_visible_prefix[list_index] - m_visible_prefix[parent_start];
+}
+
+//--------------------------------------------------------------------------------------------------
+bool FilteredTopology::IsExcluded(uint64_t node_index) const
+{
+    DIVE_ASSERT(m_topology != nullptr);
+    if (m_visible_prefix.empty())
+        return false;
+    uint64_t list_index = GetChildListIndex(node_index);
+    return list_index != UINT64_MAX &&
+           m_visible_prefix[list_index + 1] == m_visible_prefix[list_index];
+}
+
+//--------------------------------------------------------------------------------------------------
+void FilteredTopology::Build(const Topology &topology, const std::vector<uint8_t> &excluded)
+{
+    m_topology = &topology;
+    m_visible_prefix.clear();
+    if (excluded.empty())
+        return;
+
+    const DiveVector<uint64_t> &children_list = topology.m_children_list;
+    m_visible_prefix.resize(children_list.size() + 1);
+    uint64_t num_visible = 0;
+    for (uint64_t i = 0; i < children_list.size(); ++i)
+    {
+        m_visible_prefix[i] = num_visible;
+        uint64_t child = children_list[i];
+        num_visible += (child < excluded.size() && excluded[child]) ? 0 : 1;
+    }
+    m_visible_prefix[children_list.size()] = num_visible;
+}
+
+//--------------------------------------------------------------------------------------------------
+uint64_t FilteredTopology::GetChildListIndex(uint64_t node_index) const
+{
+    uint64_t parent_node_index = m_topology->GetParentNodeIndex(node_index);
+    if (parent_node_index == UINT64_MAX)
+        return UINT64_MAX;
+    return m_topology->m_node_children[parent_node_index].m_start_index +
+           m_topology->GetChildIndex(node_index);
+}
+
 // =================================================================================================
 // CommandHierarchy
 // =================================================================================================
@@ -226,6 +322,51 @@ const SharedNodeTopology &CommandHierarchy::GetAllEventHierarchyTopology() const
     return m_topology[kAllEventTopology];
 }
 
+//--------------------------------------------------------------------------------------------------
+bool CommandHierarchy::IsFilterExcluded(FilterListType filter_type, uint64_t node_index) const
+{
+    DIVE_ASSERT(filter_type < kFilterListTypeCount);
+    const std::vector<uint8_t> &excluded = m_filter_excluded[filter_type];
+    return node_index < excluded.size() && excluded[node_index] != 0;
+}
+
+//--------------------------------------------------------------------------------------------------
+const FilteredTopology &CommandHierarchy::GetFilteredSubmitHierarchyTopology(
+FilterListType filter_type) const
+{
+    DIVE_ASSERT(filter_type < kFilterListTypeCount);
+    return m_filtered_topology[kSubmitTopology][filter_type];
+}
+
+//--------------------------------------------------------------------------------------------------
+const FilteredTopology &CommandHierarchy::GetFilteredAllEventHierarchyTopology(
+FilterListType filter_type) const
+{
+    DIVE_ASSERT(filter_type < kFilterListTypeCount);
+    return m_filtered_topology[kAllEventTopology][filter_type];
+}
+
+//--------------------------------------------------------------------------------------------------
+void CommandHierarchy::BuildFilteredTopologies()
+{
+    for (uint32_t filter = 0; filter < kFilterListTypeCount; ++filter)
+    {
+        std::vector<uint8_t> &excluded = m_filter_excluded[filter];
+        excluded.clear();
+        if (!m_filter_exclude_indices_list[filter].empty())
+        {
+            excluded.resize(size(), 0);
+            for (uint64_t node_index : m_filter_exclude_indices_list[filter])
+            {
+                DIVE_ASSERT(node_index < size());
+                excluded[node_index] = 1;
+            }
+        }
+        for (uint32_t topology = 0; topology < kTopologyTypeCount; ++topology)
+            m_filtered_topology[topology][filter].Build(m_topology[topology], excluded);
+    }
+}
+
 //--------------------------------------------------------------------------------------------------
 NodeType CommandHierarchy::GetNodeType(uint64_t node_index) const
 {
@@ -399,6 +540,17 @@ size_t CommandHierarchy::GetEventIndex(uint64_t node_index) const
     return it - indices.begin() + 1;
 }
 
+//--------------------------------------------------------------------------------------------------
+uint64_t CommandHierarchy::GetEventNodeIndex(uint32_t event_id) const
+{
+    const DiveVector<uint64_t> &indices = m_nodes.m_event_node_indices;
+    if (event_id >= indices.size())
+    {
+        return UINT64_MAX;
+    }
+    return indices[event_id];
+}
+
 // =================================================================================================
 // CommandHierarchy::Nodes
 // =================================================================================================
@@ -2163,47 +2315,70 @@ uint64_t CommandHierarchyCreator::GetChildCount(CommandHierarchy::TopologyType t
 //--------------------------------------------------------------------------------------------------
 void CommandHierarchyCreator::CreateTopologies()
 {
-    uint64_t total_num_children[CommandHierarchy::kTopologyTypeCount] = {};
-    uint64_t total_num_shared_children[CommandHierarchy::kTopologyTypeCount] = {};
-
-    // Convert the m_node_children temporary structure into CommandHierarchy's topologies
+    // Size every topology up front, so the tasks below never resize shared arrays
     for (uint32_t topology = 0; topology < CommandHierarchy::kTopologyTypeCount; ++topology)
     {
-        size_t              num_nodes = m_node_children[topology][kSingleParentNodeChildren].size();
+        size_t num_nodes = m_node_children[topology][kSingleParentNodeChildren].size();
+        DIVE_ASSERT(num_nodes == m_node_children[topology][kSharedNodeChildren].size());
+        m_command_hierarchy.m_topology[topology].SetNumNodes(num_nodes);
+    }
+
+    // Convert the m_node_children temporary structure into CommandHierarchy's topologies.
+    // Each topology is independent once the node list is frozen, and within a topology the
+    // "normal" and shared children write disjoint arrays, so all of them can be built at once.
+    auto create_children = [this](uint32_t topology) {
+        const auto         &node_children = m_node_children[topology][kSingleParentNodeChildren];
         SharedNodeTopology &cur_topology = m_command_hierarchy.m_topology[topology];
-        cur_topology.SetNumNodes(num_nodes);
 
         // Optional loop: Pre-reserve to prevent the resize() from allocating memory later
-        // Note: The number of children for some of the topologies have been determined
-        // earlier in this function already
-        if (total_num_children[topology] == 0 && total_num_shared_children[topology] == 0)
-        {
-            for (uint64_t node_index = 0; node_index < num_nodes; ++node_index)
-            {
-                auto &node_children = m_node_children[topology];
-                total_num_children[topology] += node_children[kSingleParentNodeChildren][node_index]
-                                                .size();
-                total_num_shared_children[topology] += node_children[1][node_index].size();
-            }
-        }
-        cur_topology.m_children_list.reserve(total_num_children[topology]);
-        cur_topology.m_shared_children_indices.reserve(total_num_shared_children[topology]);
+        uint64_t total_num_children = 0;
+        for (uint64_t node_index = 0; node_index < node_children.size(); ++node_index)
+            total_num_children += node_children[node_index].size();
+        cur_topology.m_children_list.reserve(total_num_children);
+
+        for (uint64_t node_index = 0; node_index < node_children.size(); ++node_index)
+            cur_topology.AddChildren(node_index, node_children[node_index]);
+    };
+    auto create_shared_children = [this](uint32_t topology) {
+        const auto         &node_children = m_node_children[topology][kSharedNodeChildren];
+        SharedNodeTopology &cur_topology = m_command_hierarchy.m_topology[topology];
+
+        uint64_t total_num_shared_children = 0;
+        for (uint64_t node_index = 0; node_index < node_children.size(); ++node_index)
+            total_num_shared_children += node_children[node_index].size();
+        cur_topology.m_shared_children_indices.reserve(total_num_shared_children);
+
+        for (uint64_t node_index = 0; node_index < node_children.size(); ++node_index)
+            cur_topology.AddSharedChildren(node_index, node_children[node_index]);
 
-        for (uint64_t node_index = 0; node_index < num_nodes; ++node_index)
-        {
-            DIVE_ASSERT(m_node_children[topology][kSingleParentNodeChildren].size() ==
-                        m_node_children[topology][kSingleParentNodeChildren].size());
-            cur_topology
-            .AddChildren(node_index,
-                         m_node_children[topology][kSingleParentNodeChildren][node_index]);
-            cur_topology
-            .AddSharedChildren(node_index,
-                               m_node_children[topology][kSharedNodeChildren][node_index]);
-        }
         cur_topology.m_start_shared_child = std::move(m_node_start_shared_children[topology]);
         cur_topology.m_end_shared_child = std::move(m_node_end_shared_children[topology]);
         cur_topology.m_root_node_index = std::move(m_node_root_node_indices[topology]);
+    };
+
+    if (!m_parallel_topologies)
+    {
+        for (uint32_t topology = 0; topology < CommandHierarchy::kTopologyTypeCount; ++topology)
+        {
+            create_children(topology);
+            create_shared_children(topology);
+        }
     }
+    else
+    {
+        constexpr unsigned int kNumTasks = CommandHierarchy::kTopologyTypeCount * 2;
+        ThreadPool             thread_pool;
+        thread_pool.Start(std::min(kNumTasks, ThreadPool::GetDefaultThreadCount()));
+        for (uint32_t topology = 0; topology < CommandHierarchy::kTopologyTypeCount; ++topology)
+        {
+            thread_pool.Run([&create_children, topology]() { create_children(topology); });
+            thread_pool.Run(
+            [&create_shared_children, topology]() { create_shared_children(topology); });
+        }
+        thread_pool.Wait();
+    }
+
+    m_command_hierarchy.BuildFilteredTopologies();
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -106,6 +106,18 @@ public:
     uint64_t GetChildNodeIndex(uint64_t node_index, uint64_t child_index) const;
     uint64_t GetNextNodeIndex(uint64_t node_index) const;
 
+    // Raw arrays, for bulk export. The parent and child-index arrays have GetNumNodes() elements.
+    // The children array holds a (start, count) pair per node, indexing into the children list
+    const uint64_t *GetParentNodeIndexData() const { return m_node_parent.data(); }
+    const uint64_t *GetChildIndexData() const { return m_node_child_index.data(); }
+    const uint64_t *GetChildrenData() const
+    {
+        static_assert(sizeof(ChildrenInfo) == 2 * sizeof(uint64_t));
+        return reinterpret_cast<const uint64_t *>(m_node_children.data());
+    }
+    const uint64_t *GetChildrenListData() const { return m_children_list.data(); }
+    uint64_t        GetChildrenListSize() const { return m_children_list.size(); }
+
 protected:
     struct ChildrenInfo
     {
@@ -142,6 +154,8 @@ protected:
 
 private:
     friend class CommandHierarchy;
+    friend class CommandHierarchyFile;
+    friend class FilteredTopology;
     friend class GfxrVulkanCommandHierarchyCreator;
     friend class DiveCommandHierarchyCreator;
 };
@@ -173,6 +187,7 @@ public:
 private:
     friend class CommandHierarchy;
     friend class CommandHierarchyCreator;
+    friend class CommandHierarchyFile;
     friend class DiveCommandHierarchyCreator;
 
     // List of all children for shared nodes.
@@ -199,6 +214,38 @@ private:
     void AddSharedChildren(uint64_t node_index, const DiveVector<uint64_t> &children);
 };
 
+//--------------------------------------------------------------------------------------------------
+// A Topology's "normal" children with the nodes excluded by one filter list removed.
+// m_visible_prefix is a prefix sum of the visible flags over the topology's children list, so the
+// number of visible children of a node and the row of a visible node are O(1), and fetching a
+// visible child is a binary search within its parent's range of the children list.
+// When the filter excludes nothing, the view passes straight through to the topology.
+class FilteredTopology
+{
+public:
+    uint64_t GetNumChildren(uint64_t node_index) const;
+    uint64_t GetChildNodeIndex(uint64_t node_index, uint64_t child_index) const;
+
+    // Index of node w.r.t. the visible children of its parent, UINT64_MAX if it is excluded
+    uint64_t GetChildIndex(uint64_t node_index) const;
+
+    // Whether the node itself is excluded. Descendants of an excluded node are not reported as
+    // excluded, but they are unreachable through this view.
+    bool IsExcluded(uint64_t node_index) const;
+
+private:
+    friend class CommandHierarchy;
+
+    // `excluded` has one flag per node, or is empty if the filter excludes nothing
+    void Build(const Topology &topology, const std::vector<uint8_t> &excluded);
+
+    // Position of node_index in the topology's children list, UINT64_MAX if it has no parent
+    uint64_t GetChildListIndex(uint64_t node_index) const;
+
+    const Topology      *m_topology = nullptr;
+    DiveVector<uint64_t> m_visible_prefix;  // Children list size + 1, empty for pass-through
+};
+
 //--------------------------------------------------------------------------------------------------
 union SyncInfo
 {
@@ -283,6 +330,9 @@ public:
     NodeType    GetNodeType(uint64_t node_index) const;
     const char *GetNodeDesc(uint64_t node_index) const;
 
+    // Node types of all size() nodes, for bulk export
+    const NodeType *GetNodeTypeData() const { return m_nodes.m_node_type.data(); }
+
     Dive::EngineType GetSubmitNodeEngineType(uint64_t node_index) const;
     uint32_t         GetSubmitNodeIndex(uint64_t node_index) const;
     uint8_t          GetIbNodeIndex(uint64_t node_index) const;
@@ -302,6 +352,9 @@ public:
     // GetEventIndex returns sequence number for Event/Sync Nodes, 0 if not exist.
     size_t GetEventIndex(uint64_t node_index) const;
 
+    // Inverse of GetEventIndex(): the node of the event `event_id`, UINT64_MAX if not exist.
+    uint64_t GetEventNodeIndex(uint32_t event_id) const;
+
     // For kBinningPassOnly
     // - Keep Binning Pass
     // - Exclude all Tile&Resolve Passes (0 - N)
@@ -326,8 +379,17 @@ public:
         return m_filter_exclude_indices_list[filter_type];
     }
 
+    // O(1) equivalent of looking node_index up in GetFilterExcludeIndices()
+    bool IsFilterExcluded(FilterListType filter_type, uint64_t node_index) const;
+
+    // Topologies with a filter applied. These are built once the hierarchy is complete, so
+    // switching filters does not need to walk or re-check the hierarchy.
+    const FilteredTopology &GetFilteredSubmitHierarchyTopology(FilterListType filter_type) const;
+    const FilteredTopology &GetFilteredAllEventHierarchyTopology(FilterListType filter_type) const;
+
 private:
     friend class CommandHierarchyCreator;
+    friend class CommandHierarchyFile;
     friend class GfxrVulkanCommandHierarchyCreator;
     friend class DiveCommandHierarchyCreator;
 
@@ -427,9 +489,16 @@ private:
         m_filter_exclude_indices_list[filter_mode].insert(index);
     }
 
+    // Must be called after the topologies and the filter lists are final
+    void BuildFilteredTopologies();
+
     Nodes                        m_nodes;
     std::unordered_set<uint64_t> m_filter_exclude_indices_list[kFilterListTypeCount];
     SharedNodeTopology           m_topology[kTopologyTypeCount];
+
+    // Derived from the lists and topologies above by BuildFilteredTopologies()
+    std::vector<uint8_t> m_filter_excluded[kFilterListTypeCount];  // Per node, empty if none
+    FilteredTopology     m_filtered_topology[kTopologyTypeCount][kFilterListTypeCount];
 };
 
 //--------------------------------------------------------------------------------------------------
@@ -474,6 +543,9 @@ public:
                           uint64_t              va_addr,
                           Pm4Header             header) override;
 
+    // The topologies are built concurrently by default. Turning this off builds them one after
+    // another on the calling thread, which produces identical output.
+    void SetParallelTopologies(bool parallel) { m_parallel_topologies = parallel; }
     void CreateTopologies();
 
     virtual void OnSubmitStart(uint32_t submit_index, const SubmitInfo &submit_info) override;
@@ -685,6 +757,9 @@ private:
     // simpler.
     bool m_flatten_chain_nodes = false;
 
+    // Whether CreateTopologies() spreads its work over a thread pool
+    bool m_parallel_topologies = true;
+
     // Range of shared children associated with each non-top-level node, per topology
     DiveVector<uint64_t> m_node_start_shared_children[CommandHierarchy::kTopologyTypeCount];
     DiveVector<uint64_t> m_node_end_shared_children[CommandHierarchy::kTopologyTypeCount];
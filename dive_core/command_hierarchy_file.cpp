@@ -0,0 +1,567 @@
+/*
+ Copyright 2025 Google LLC
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#include "command_hierarchy_file.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <vector>
+#include "dive_core/common/common.h"
+
+#if defined(WIN32)
+#    include <windows.h>
+#else
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <unistd.h>
+#endif
+
+namespace Dive
+{
+
+// =================================================================================================
+// MappedFile
+// =================================================================================================
+class MappedFile
+{
+public:
+    ~MappedFile() { Close(); }
+
+    bool Open(const char *file_name);
+    void Close();
+
+    const uint8_t *Data() const { return m_data; }
+    uint64_t       Size() const { return m_size; }
+
+private:
+#if defined(WIN32)
+    HANDLE m_file = INVALID_HANDLE_VALUE;
+    HANDLE m_mapping = nullptr;
+#endif
+    const uint8_t *m_data = nullptr;
+    uint64_t       m_size = 0;
+};
+
+//--------------------------------------------------------------------------------------------------
+bool MappedFile::Open(const char *file_name)
+{
+    Close();
+#if defined(WIN32)
+    m_file = CreateFileA(file_name,
+                         GENERIC_READ,
+                         FILE_SHARE_READ,
+                         nullptr,
+                         OPEN_EXISTING,
+                         FILE_ATTRIBUTE_NORMAL,
+                         nullptr);
+    if (m_file == INVALID_HANDLE_VALUE)
+        return false;
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(m_file, &size) || size.QuadPart == 0)
+    {
+        Close();
+        return false;
+    }
+    m_mapping = CreateFileMappingA(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (m_mapping == nullptr)
+    {
+        Close();
+        return false;
+    }
+    m_data = static_cast<const uint8_t *>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+    if (m_data == nullptr)
+    {
+        Close();
+        return false;
+    }
+    m_size = static_cast<uint64_t>(size.QuadPart);
+#else
+    int fd = open(file_name, O_RDONLY);
+    if (fd < 0)
+        return false;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0)
+    {
+        close(fd);
+        return false;
+    }
+    void *ptr = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+
+    // The mapping keeps its own reference to the file
+    close(fd);
+    if (ptr == MAP_FAILED)
+        return false;
+    m_data = static_cast<const uint8_t *>(ptr);
+    m_size = static_cast<uint64_t>(st.st_size);
+#endif
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+void MappedFile::Close()
+{
+#if defined(WIN32)
+    if (m_data != nullptr)
+        UnmapViewOfFile(m_data);
+    if (m_mapping != nullptr)
+        CloseHandle(m_mapping);
+    if (m_file != INVALID_HANDLE_VALUE)
+        CloseHandle(m_file);
+    m_mapping = nullptr;
+    m_file = INVALID_HANDLE_VALUE;
+#else
+    if (m_data != nullptr)
+        munmap(const_cast<uint8_t *>(m_data), static_cast<size_t>(m_size));
+#endif
+    m_data = nullptr;
+    m_size = 0;
+}
+
+// =================================================================================================
+// CommandHierarchyFile
+// =================================================================================================
+namespace
+{
+
+// Accumulates sections in memory, then writes header + sections in one pass
+class SectionWriter
+{
+public:
+    explicit SectionWriter(CommandHierarchyFile::SectionInfo *sections) :
+        m_sections(sections)
+    {
+    }
+
+    void Add(uint32_t section, const void *data, uint64_t size)
+    {
+        m_sections[section].m_size = size;
+        m_pending.push_back({ section, data });
+    }
+    template<typename T> void Add(uint32_t section, const DiveVector<T> &vec)
+    {
+        Add(section, vec.data(), vec.size() * sizeof(T));
+    }
+    template<typename T> void Add(uint32_t section, const std::vector<T> &vec)
+    {
+        Add(section, vec.data(), vec.size() * sizeof(T));
+    }
+
+    // Assign 8-byte aligned offsets, following the header
+    void Layout(uint64_t header_size)
+    {
+        uint64_t offset = AlignUp(header_size);
+        for (const Pending &pending : m_pending)
+        {
+            m_sections[pending.m_section].m_offset = offset;
+            offset = AlignUp(offset + m_sections[pending.m_section].m_size);
+        }
+    }
+
+    bool Write(std::ofstream &file, uint64_t header_size) const
+    {
+        static const char kPadding[8] = {};
+        uint64_t          offset = header_size;
+        for (const Pending &pending : m_pending)
+        {
+            const CommandHierarchyFile::SectionInfo &info = m_sections[pending.m_section];
+            file.write(kPadding, static_cast<std::streamsize>(info.m_offset - offset));
+            file.write(static_cast<const char *>(pending.m_data),
+                       static_cast<std::streamsize>(info.m_size));
+            offset = info.m_offset + info.m_size;
+        }
+        return file.good();
+    }
+
+private:
+    struct Pending
+    {
+        uint32_t    m_section;
+        const void *m_data;
+    };
+
+    static uint64_t AlignUp(uint64_t value) { return (value + 7) & ~uint64_t(7); }
+
+    CommandHierarchyFile::SectionInfo *m_sections;
+    std::vector<Pending>               m_pending;
+};
+
+//--------------------------------------------------------------------------------------------------
+template<typename T>
+void CopySection(const T *src, uint64_t count, DiveVector<T> &dst)
+{
+    dst.resize(count);
+    if (count > 0)
+        memcpy(dst.data(), src, count * sizeof(T));
+}
+
+}  // namespace
+
+//--------------------------------------------------------------------------------------------------
+bool CommandHierarchyFile::Save(const CommandHierarchy &command_hierarchy, const char *file_name)
+{
+    static_assert(kNumTopologies == CommandHierarchy::kTopologyTypeCount,
+                  "Topology count mismatch!");
+    static_assert(uint32_t(MappedCommandHierarchy::kSubmitTopology) ==
+                  uint32_t(CommandHierarchy::kSubmitTopology),
+                  "Topology mismatch!");
+    static_assert(uint32_t(MappedCommandHierarchy::kAllEventTopology) ==
+                  uint32_t(CommandHierarchy::kAllEventTopology),
+                  "Topology mismatch!");
+    static_assert(sizeof(MappedCommandHierarchy::ChildrenInfo) == sizeof(Topology::ChildrenInfo),
+                  "ChildrenInfo layout mismatch!");
+    static_assert(static_cast<uint32_t>(NodeType::kGfxrRootFrameNode) <= UINT8_MAX,
+                  "NodeType no longer fits in a byte!");
+
+    const CommandHierarchy::Nodes &nodes = command_hierarchy.m_nodes;
+    const uint64_t                 num_nodes = nodes.m_node_type.size();
+
+    Header header = {};
+    memcpy(header.m_magic, kMagic, sizeof(kMagic));
+    header.m_version = kVersion;
+    header.m_num_sections = kNumSections;
+    header.m_num_nodes = num_nodes;
+
+    // Flatten the per-node data that isn't already a plain array
+    std::vector<uint8_t>  node_types(num_nodes);
+    std::vector<uint64_t> desc_offsets(num_nodes + 1);
+    std::vector<uint64_t> aux_info(num_nodes);
+    uint64_t              desc_size = 0;
+    for (uint64_t i = 0; i < num_nodes; ++i)
+    {
+        node_types[i] = static_cast<uint8_t>(nodes.m_node_type[i]);
+        aux_info[i] = nodes.m_aux_info[i].m_u64All;
+        desc_offsets[i] = desc_size;
+        desc_size += nodes.m_description[i].size() + 1;
+    }
+    desc_offsets[num_nodes] = desc_size;
+
+    std::vector<char> desc_data(desc_size);
+    for (uint64_t i = 0; i < num_nodes; ++i)
+    {
+        const std::string &desc = nodes.m_description[i];
+        memcpy(&desc_data[desc_offsets[i]], desc.c_str(), desc.size() + 1);
+    }
+
+    std::vector<uint64_t> filter_lists[CommandHierarchy::kFilterListTypeCount];
+    for (uint32_t filter = 0; filter < CommandHierarchy::kFilterListTypeCount; ++filter)
+    {
+        const auto &exclude_set = command_hierarchy.m_filter_exclude_indices_list[filter];
+        filter_lists[filter].assign(exclude_set.begin(), exclude_set.end());
+        std::sort(filter_lists[filter].begin(), filter_lists[filter].end());
+    }
+
+    SectionWriter writer(header.m_sections);
+    writer.Add(kNodeTypes, node_types);
+    writer.Add(kDescOffsets, desc_offsets);
+    writer.Add(kDescData, desc_data);
+    writer.Add(kAuxInfo, aux_info);
+    writer.Add(kEventNodeIndices, nodes.m_event_node_indices);
+    for (uint32_t topology = 0; topology < kNumTopologies; ++topology)
+    {
+        const SharedNodeTopology &src = command_hierarchy.m_topology[topology];
+        writer.Add(TopologySectionIndex(topology, kChildrenList), src.m_children_list);
+        writer.Add(TopologySectionIndex(topology, kNodeChildren), src.m_node_children);
+        writer.Add(TopologySectionIndex(topology, kNodeParent), src.m_node_parent);
+        writer.Add(TopologySectionIndex(topology, kNodeChildIndex), src.m_node_child_index);
+        writer.Add(TopologySectionIndex(topology, kSharedChildrenIndices),
+                   src.m_shared_children_indices);
+        writer.Add(TopologySectionIndex(topology, kNodeSharedChildren),
+                   src.m_node_shared_children);
+        writer.Add(TopologySectionIndex(topology, kStartSharedChild), src.m_start_shared_child);
+        writer.Add(TopologySectionIndex(topology, kEndSharedChild), src.m_end_shared_child);
+        writer.Add(TopologySectionIndex(topology, kRootNodeIndex), src.m_root_node_index);
+    }
+    for (uint32_t filter = 0; filter < CommandHierarchy::kFilterListTypeCount; ++filter)
+        writer.Add(kFirstFilterSection + filter, filter_lists[filter]);
+    writer.Layout(sizeof(Header));
+
+    std::ofstream file(file_name, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!file.is_open())
+        return false;
+    file.write(reinterpret_cast<const char *>(&header), sizeof(Header));
+    return writer.Write(file, sizeof(Header));
+}
+
+//--------------------------------------------------------------------------------------------------
+bool CommandHierarchyFile::Load(const char *file_name, CommandHierarchy &command_hierarchy)
+{
+    MappedCommandHierarchy mapped;
+    if (!mapped.Open(file_name))
+        return false;
+
+    command_hierarchy = CommandHierarchy();
+    CommandHierarchy::Nodes &nodes = command_hierarchy.m_nodes;
+
+    const uint64_t num_nodes = mapped.size();
+    const uint8_t *node_types = mapped.SectionData<uint8_t>(kNodeTypes);
+    const uint64_t *aux_info = mapped.SectionData<uint64_t>(kAuxInfo);
+    nodes.m_node_type.reserve(num_nodes);
+    nodes.m_description.reserve(num_nodes);
+    nodes.m_aux_info.reserve(num_nodes);
+    for (uint64_t i = 0; i < num_nodes; ++i)
+    {
+        nodes.m_node_type.push_back(static_cast<NodeType>(node_types[i]));
+        nodes.m_description.push_back(mapped.GetNodeDesc(i));
+        nodes.m_aux_info.push_back(CommandHierarchy::AuxInfo(aux_info[i]));
+    }
+    CopySection(mapped.SectionData<uint64_t>(kEventNodeIndices),
+                mapped.SectionCount<uint64_t>(kEventNodeIndices),
+                nodes.m_event_node_indices);
+
+    using ChildrenInfo = Topology::ChildrenInfo;
+    for (uint32_t topology = 0; topology < kNumTopologies; ++topology)
+    {
+        SharedNodeTopology &dst = command_hierarchy.m_topology[topology];
+        auto copy_u64 = [&](TopologySection section, DiveVector<uint64_t> &vec) {
+            uint32_t index = TopologySectionIndex(topology, section);
+            CopySection(mapped.SectionData<uint64_t>(index),
+                        mapped.SectionCount<uint64_t>(index),
+                        vec);
+        };
+        auto copy_children = [&](TopologySection section, DiveVector<ChildrenInfo> &vec) {
+            uint32_t index = TopologySectionIndex(topology, section);
+            CopySection(mapped.SectionData<ChildrenInfo>(index),
+                        mapped.SectionCount<ChildrenInfo>(index),
+                        vec);
+        };
+        copy_u64(kChildrenList, dst.m_children_list);
+        copy_children(kNodeChildren, dst.m_node_children);
+        copy_u64(kNodeParent, dst.m_node_parent);
+        copy_u64(kNodeChildIndex, dst.m_node_child_index);
+        copy_u64(kSharedChildrenIndices, dst.m_shared_children_indices);
+        copy_children(kNodeSharedChildren, dst.m_node_shared_children);
+        copy_u64(kStartSharedChild, dst.m_start_shared_child);
+        copy_u64(kEndSharedChild, dst.m_end_shared_child);
+        copy_u64(kRootNodeIndex, dst.m_root_node_index);
+    }
+
+    for (uint32_t filter = 0; filter < CommandHierarchy::kFilterListTypeCount; ++filter)
+    {
+        const uint64_t *indices = mapped.SectionData<uint64_t>(kFirstFilterSection + filter);
+        uint64_t        count = mapped.SectionCount<uint64_t>(kFirstFilterSection + filter);
+        command_hierarchy.m_filter_exclude_indices_list[filter].insert(indices, indices + count);
+    }
+    command_hierarchy.BuildFilteredTopologies();
+    return true;
+}
+
+// =================================================================================================
+// MappedCommandHierarchy
+// =================================================================================================
+MappedCommandHierarchy::MappedCommandHierarchy() {}
+
+//--------------------------------------------------------------------------------------------------
+MappedCommandHierarchy::~MappedCommandHierarchy() {}
+
+//--------------------------------------------------------------------------------------------------
+bool MappedCommandHierarchy::Open(const char *file_name)
+{
+    using File = CommandHierarchyFile;
+    Close();
+
+    auto file = std::make_unique<MappedFile>();
+    if (!file->Open(file_name) || file->Size() < sizeof(File::Header))
+        return false;
+
+    const File::Header *header = reinterpret_cast<const File::Header *>(file->Data());
+    if (memcmp(header->m_magic, File::kMagic, sizeof(File::kMagic)) != 0 ||
+        header->m_version != File::kVersion || header->m_num_sections != File::kNumSections)
+        return false;
+
+    // Every section must be aligned and fully contained within the file
+    for (uint32_t i = 0; i < File::kNumSections; ++i)
+    {
+        const File::SectionInfo &info = header->m_sections[i];
+        if ((info.m_offset % 8) != 0 || info.m_offset > file->Size() ||
+            info.m_size > file->Size() - info.m_offset)
+            return false;
+    }
+
+    // Per-node sections must agree on the node count
+    const uint64_t num_nodes = header->m_num_nodes;
+    if (header->m_sections[File::kNodeTypes].m_size != num_nodes * sizeof(uint8_t) ||
+        header->m_sections[File::kAuxInfo].m_size != num_nodes * sizeof(uint64_t) ||
+        header->m_sections[File::kDescOffsets].m_size != (num_nodes + 1) * sizeof(uint64_t))
+        return false;
+
+    // Every description must be null-terminated within its own slice of the description blob
+    const uint8_t  *data = file->Data();
+    const uint64_t *desc_offsets = reinterpret_cast<const uint64_t *>(
+    data + header->m_sections[File::kDescOffsets].m_offset);
+    const char *desc_data = reinterpret_cast<const char *>(
+    data + header->m_sections[File::kDescData].m_offset);
+    if (desc_offsets[num_nodes] != header->m_sections[File::kDescData].m_size)
+        return false;
+    for (uint64_t i = 0; i < num_nodes; ++i)
+    {
+        if (desc_offsets[i] >= desc_offsets[i + 1] || desc_data[desc_offsets[i + 1] - 1] != '\0')
+            return false;
+    }
+
+    // Every children range must lie within its list, and every child must be a valid node
+    auto valid_children = [&](uint32_t topology,
+                              File::TopologySection info_section,
+                              File::TopologySection list_section) {
+        const File::SectionInfo &info =
+        header->m_sections[File::TopologySectionIndex(topology, info_section)];
+        const File::SectionInfo &list =
+        header->m_sections[File::TopologySectionIndex(topology, list_section)];
+        const ChildrenInfo *children = reinterpret_cast<const ChildrenInfo *>(data + info.m_offset);
+        const uint64_t     *indices = reinterpret_cast<const uint64_t *>(data + list.m_offset);
+        const uint64_t      num_infos = info.m_size / sizeof(ChildrenInfo);
+        const uint64_t      num_indices = list.m_size / sizeof(uint64_t);
+        if (num_infos > num_nodes)
+            return false;
+        for (uint64_t i = 0; i < num_infos; ++i)
+        {
+            // Childless nodes keep the default (UINT64_MAX) start index
+            if (children[i].m_num_children > 0 &&
+                (children[i].m_start_index > num_indices ||
+                 children[i].m_num_children > num_indices - children[i].m_start_index))
+                return false;
+        }
+        for (uint64_t i = 0; i < num_indices; ++i)
+        {
+            if (indices[i] >= num_nodes)
+                return false;
+        }
+        return true;
+    };
+    for (uint32_t topology = 0; topology < File::kNumTopologies; ++topology)
+    {
+        const File::SectionInfo &node_parent = header->m_sections
+                                               [File::TopologySectionIndex(topology,
+                                                                           File::kNodeParent)];
+        if (node_parent.m_size / sizeof(uint64_t) > num_nodes ||
+            !valid_children(topology, File::kNodeChildren, File::kChildrenList) ||
+            !valid_children(topology, File::kNodeSharedChildren, File::kSharedChildrenIndices))
+            return false;
+    }
+
+    m_file = std::move(file);
+    m_data = data;
+    m_header = header;
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+void MappedCommandHierarchy::Close()
+{
+    m_header = nullptr;
+    m_data = nullptr;
+    m_file.reset();
+}
+
+//--------------------------------------------------------------------------------------------------
+uint64_t MappedCommandHierarchy::size() const
+{
+    return IsOpen() ? m_header->m_num_nodes : 0;
+}
+
+//--------------------------------------------------------------------------------------------------
+NodeType MappedCommandHierarchy::GetNodeType(uint64_t node_index) const
+{
+    DIVE_ASSERT(node_index < size());
+    return static_cast<NodeType>(SectionData<uint8_t>(CommandHierarchyFile::kNodeTypes)[node_index]);
+}
+
+//--------------------------------------------------------------------------------------------------
+const char *MappedCommandHierarchy::GetNodeDesc(uint64_t node_index) const
+{
+    DIVE_ASSERT(node_index < size());
+    uint64_t offset = SectionData<uint64_t>(CommandHierarchyFile::kDescOffsets)[node_index];
+    return SectionData<char>(CommandHierarchyFile::kDescData) + offset;
+}
+
+//--------------------------------------------------------------------------------------------------
+uint64_t MappedCommandHierarchy::GetParentNodeIndex(TopologyType type, uint64_t node_index) const
+{
+    DIVE_ASSERT(node_index <
+                SectionCount<uint64_t>(
+                CommandHierarchyFile::TopologySectionIndex(type,
+                                                           CommandHierarchyFile::kNodeParent)));
+    return TopologyData<uint64_t>(type, CommandHierarchyFile::kNodeParent)[node_index];
+}
+
+//--------------------------------------------------------------------------------------------------
+uint64_t MappedCommandHierarchy::GetNumChildren(TopologyType type, uint64_t node_index) const
+{
+    DIVE_ASSERT(node_index < size());
+
+    // A topology that was never built (e.g. the submit topology of a GFXR capture) has no nodes
+    uint32_t section = CommandHierarchyFile::TopologySectionIndex(
+    type,
+    CommandHierarchyFile::kNodeChildren);
+    if (node_index >= SectionCount<ChildrenInfo>(section))
+        return 0;
+    return TopologyData<ChildrenInfo>(type, CommandHierarchyFile::kNodeChildren)[node_index]
+    .m_num_children;
+}
+
+//--------------------------------------------------------------------------------------------------
+uint64_t MappedCommandHierarchy::GetChildNodeIndex(TopologyType type,
+                                                   uint64_t     node_index,
+                                                   uint64_t     child_index) const
+{
+    DIVE_ASSERT(node_index < size());
+    const ChildrenInfo &info = TopologyData<ChildrenInfo>(type,
+                                                          CommandHierarchyFile::kNodeChildren)
+    [node_index];
+    DIVE_ASSERT(child_index < info.m_num_children);
+    return TopologyData<uint64_t>(type, CommandHierarchyFile::kChildrenList)[info.m_start_index +
+                                                                             child_index];
+}
+
+//--------------------------------------------------------------------------------------------------
+uint64_t MappedCommandHierarchy::GetNumSharedChildren(TopologyType type, uint64_t node_index) const
+{
+    DIVE_ASSERT(node_index < size());
+    uint32_t section = CommandHierarchyFile::TopologySectionIndex(
+    type,
+    CommandHierarchyFile::kNodeSharedChildren);
+    if (node_index >= SectionCount<ChildrenInfo>(section))
+        return 0;
+    return TopologyData<ChildrenInfo>(type, CommandHierarchyFile::kNodeSharedChildren)[node_index]
+    .m_num_children;
+}
+
+//--------------------------------------------------------------------------------------------------
+uint64_t MappedCommandHierarchy::GetSharedChildNodeIndex(TopologyType type,
+                                                         uint64_t     node_index,
+                                                         uint64_t     child_index) const
+{
+    DIVE_ASSERT(node_index < size());
+    const ChildrenInfo &info = TopologyData<ChildrenInfo>(type,
+                                                          CommandHierarchyFile::kNodeSharedChildren)
+    [node_index];
+    DIVE_ASSERT(child_index < info.m_num_children);
+    return TopologyData<uint64_t>(type,
+                                  CommandHierarchyFile::kSharedChildrenIndices)[info.m_start_index +
+                                                                                child_index];
+}
+
+//--------------------------------------------------------------------------------------------------
+bool MappedCommandHierarchy::IsFilterExcluded(CommandHierarchy::FilterListType filter_type,
+                                              uint64_t                         node_index) const
+{
+    uint32_t        section = CommandHierarchyFile::kFirstFilterSection + filter_type;
+    const uint64_t *begin = SectionData<uint64_t>(section);
+    const uint64_t *end = begin + SectionCount<uint64_t>(section);
+    return std::binary_search(begin, end, node_index);
+}
+
+}  // namespace Dive
@@ -0,0 +1,175 @@
+/*
+ Copyright 2025 Google LLC
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+// =====================================================================================================================
+// Versioned on-disk image of a fully built CommandHierarchy. Every array (node types, descriptions,
+// aux info, both SharedNodeTopology instances and the filter lists) is stored as a flat, 8-byte
+// aligned section, so a saved file can either be loaded back into a CommandHierarchy or
+// memory-mapped and queried in place without re-running emulation.
+// =====================================================================================================================
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "command_hierarchy.h"
+
+namespace Dive
+{
+
+class MappedFile;
+
+//--------------------------------------------------------------------------------------------------
+class CommandHierarchyFile
+{
+public:
+    // Bump whenever the layout of any section changes
+    static constexpr uint32_t kVersion = 1;
+
+    // Write nodes, topologies and filter lists of `command_hierarchy` to `file_name`
+    static bool Save(const CommandHierarchy &command_hierarchy, const char *file_name);
+
+    // Rebuild a complete CommandHierarchy from a file written by Save()
+    static bool Load(const char *file_name, CommandHierarchy &command_hierarchy);
+
+    struct SectionInfo
+    {
+        uint64_t m_offset;  // From start of file
+        uint64_t m_size;    // In bytes
+    };
+
+    // Section layout, also used by tests to address individual sections of a saved file
+    enum NodeSection : uint32_t
+    {
+        kNodeTypes,
+        kDescOffsets,  // num_nodes + 1 offsets into kDescData
+        kDescData,     // Null-terminated descriptions, back to back
+        kAuxInfo,
+        kEventNodeIndices,
+        kNodeSectionCount
+    };
+
+    enum TopologySection : uint32_t
+    {
+        kChildrenList,
+        kNodeChildren,
+        kNodeParent,
+        kNodeChildIndex,
+        kSharedChildrenIndices,
+        kNodeSharedChildren,
+        kStartSharedChild,
+        kEndSharedChild,
+        kRootNodeIndex,
+        kTopologySectionCount
+    };
+
+    static constexpr uint32_t kNumTopologies = 2;
+    static constexpr uint32_t kFirstFilterSection = kNodeSectionCount +
+                                                    kNumTopologies * kTopologySectionCount;
+    static constexpr uint32_t kNumSections = kFirstFilterSection +
+                                             CommandHierarchy::kFilterListTypeCount;
+
+    struct Header
+    {
+        char        m_magic[8];
+        uint32_t    m_version;
+        uint32_t    m_num_sections;
+        uint64_t    m_num_nodes;
+        SectionInfo m_sections[kNumSections];
+    };
+
+    // Offset of the SectionInfo table (Header::m_sections) from the start of the file
+    static constexpr uint64_t kSectionTableOffset = offsetof(Header, m_sections);
+
+    static constexpr uint32_t TopologySectionIndex(uint32_t topology, TopologySection section)
+    {
+        return kNodeSectionCount + topology * kTopologySectionCount + section;
+    }
+
+private:
+    friend class MappedCommandHierarchy;
+
+    static constexpr char kMagic[8] = { 'D', 'I', 'V', 'E', 'C', 'H', 'F', '\0' };
+};
+
+//--------------------------------------------------------------------------------------------------
+// Read-only view over a file written by CommandHierarchyFile::Save(). Nothing is copied: all
+// queries are served straight from the mapping, once Open() has validated it in a single pass.
+class MappedCommandHierarchy
+{
+public:
+    enum TopologyType
+    {
+        kSubmitTopology,
+        kAllEventTopology,
+        kTopologyTypeCount
+    };
+
+    MappedCommandHierarchy();
+    ~MappedCommandHierarchy();
+
+    // Validates header, version, section bounds, descriptions and children. Returns false if the
+    // file is unusable
+    bool Open(const char *file_name);
+    void Close();
+    bool IsOpen() const { return m_header != nullptr; }
+
+    uint64_t size() const;
+
+    NodeType    GetNodeType(uint64_t node_index) const;
+    const char *GetNodeDesc(uint64_t node_index) const;
+
+    uint64_t GetParentNodeIndex(TopologyType type, uint64_t node_index) const;
+    uint64_t GetNumChildren(TopologyType type, uint64_t node_index) const;
+    uint64_t GetChildNodeIndex(TopologyType type, uint64_t node_index, uint64_t child_index) const;
+    uint64_t GetNumSharedChildren(TopologyType type, uint64_t node_index) const;
+    uint64_t GetSharedChildNodeIndex(TopologyType type,
+                                     uint64_t     node_index,
+                                     uint64_t     child_index) const;
+
+    // Filter lists are stored sorted, so lookups are a binary search
+    bool IsFilterExcluded(CommandHierarchy::FilterListType filter_type, uint64_t node_index) const;
+
+private:
+    friend class CommandHierarchyFile;
+
+    struct ChildrenInfo
+    {
+        uint64_t m_start_index;
+        uint64_t m_num_children;
+    };
+
+    template<typename T> const T *SectionData(uint32_t section) const
+    {
+        return reinterpret_cast<const T *>(m_data + m_header->m_sections[section].m_offset);
+    }
+    template<typename T> uint64_t SectionCount(uint32_t section) const
+    {
+        return m_header->m_sections[section].m_size / sizeof(T);
+    }
+    template<typename T> const T *TopologyData(TopologyType                        type,
+                                               CommandHierarchyFile::TopologySection section) const
+    {
+        return SectionData<T>(CommandHierarchyFile::TopologySectionIndex(type, section));
+    }
+
+    std::unique_ptr<MappedFile>         m_file;
+    const uint8_t                      *m_data = nullptr;
+    const CommandHierarchyFile::Header *m_header = nullptr;
+};
+
+}  // namespace Dive
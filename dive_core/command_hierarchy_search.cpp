@@ -0,0 +1,400 @@
+/*
+ Copyright 2025 Google LLC
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#include "command_hierarchy_search.h"
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <regex>
+#include "command_hierarchy.h"
+#include "dive_core/common/common.h"
+
+namespace Dive
+{
+
+namespace
+{
+
+inline unsigned char Lower(char c)
+{
+    return static_cast<unsigned char>(std::tolower(static_cast<unsigned char>(c)));
+}
+
+//--------------------------------------------------------------------------------------------------
+std::string ToLower(std::string_view text)
+{
+    std::string result(text.size(), '\0');
+    std::transform(text.begin(), text.end(), result.begin(), [](char c) { return Lower(c); });
+    return result;
+}
+
+//--------------------------------------------------------------------------------------------------
+// `lowered_needle` must already be lower case
+bool ContainsNoCase(std::string_view haystack, std::string_view lowered_needle)
+{
+    auto it = std::search(haystack.begin(),
+                          haystack.end(),
+                          lowered_needle.begin(),
+                          lowered_needle.end(),
+                          [](char h, char n) { return Lower(h) == static_cast<unsigned char>(n); });
+    return it != haystack.end() || lowered_needle.empty();
+}
+
+//--------------------------------------------------------------------------------------------------
+bool StartsWithNoCase(std::string_view text, std::string_view lowered_prefix)
+{
+    if (text.size() < lowered_prefix.size())
+        return false;
+    for (size_t i = 0; i < lowered_prefix.size(); ++i)
+    {
+        if (Lower(text[i]) != static_cast<unsigned char>(lowered_prefix[i]))
+            return false;
+    }
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+// Index of the bracket that closes the one at `pos`, or pattern.size() if unbalanced
+size_t SkipBracketed(const std::string &pattern, size_t pos, char open, char close)
+{
+    int depth = 0;
+    for (size_t i = pos; i < pattern.size(); ++i)
+    {
+        if (pattern[i] == '\\')
+            ++i;
+        else if (pattern[i] == open)
+            ++depth;
+        else if (pattern[i] == close && --depth == 0)
+            return i;
+    }
+    return pattern.size();
+}
+
+//--------------------------------------------------------------------------------------------------
+// Longest run of literal characters that every match of `pattern` must contain. Conservative:
+// groups, classes and anything under alternation are treated as unknown.
+std::string LongestMandatoryLiteral(const std::string &pattern)
+{
+    if (pattern.find('|') != std::string::npos)
+        return {};
+
+    std::string best, run;
+    auto        flush = [&]() {
+        if (run.size() > best.size())
+            best = run;
+        run.clear();
+    };
+    for (size_t i = 0; i < pattern.size(); ++i)
+    {
+        char c = pattern[i];
+        if (c == '\\')
+        {
+            // Escaped punctuation is a literal; anything else (\d, \w, \b, ...) is a class
+            if (i + 1 < pattern.size() && std::ispunct(static_cast<unsigned char>(pattern[i + 1])))
+            {
+                run += pattern[++i];
+            }
+            else
+            {
+                flush();
+                ++i;
+            }
+        }
+        else if (c == '*' || c == '?' || c == '{')
+        {
+            // The preceding character may be absent
+            if (!run.empty())
+                run.pop_back();
+            flush();
+            if (c == '{')
+                i = SkipBracketed(pattern, i, '{', '}');
+        }
+        else if (c == '(')
+        {
+            flush();
+            i = SkipBracketed(pattern, i, '(', ')');
+        }
+        else if (c == '[')
+        {
+            flush();
+            i = SkipBracketed(pattern, i, '[', ']');
+        }
+        else if (strchr(".+^$)]}", c) != nullptr)
+        {
+            flush();
+        }
+        else
+        {
+            run += c;
+        }
+    }
+    flush();
+    return ToLower(best);
+}
+
+//--------------------------------------------------------------------------------------------------
+std::string_view RegisterName(std::string_view desc)
+{
+    // kRegNodes are either "NAME: value" or "Base Register: NAME"
+    constexpr std::string_view kBaseRegisterPrefix = "Base Register: ";
+    if (desc.substr(0, kBaseRegisterPrefix.size()) == kBaseRegisterPrefix)
+        return desc.substr(kBaseRegisterPrefix.size());
+    return desc.substr(0, desc.find(':'));
+}
+
+}  // namespace
+
+// =================================================================================================
+// CommandHierarchySearchIndex::PostingList
+// =================================================================================================
+void CommandHierarchySearchIndex::PostingList::Append(uint64_t node_index)
+{
+    DIVE_ASSERT(m_count == 0 || node_index > m_last);
+    uint64_t delta = node_index - m_last;
+    while (delta >= 0x80)
+    {
+        m_bytes.push_back(static_cast<uint8_t>(delta | 0x80));
+        delta >>= 7;
+    }
+    m_bytes.push_back(static_cast<uint8_t>(delta));
+    m_last = node_index;
+    ++m_count;
+}
+
+//--------------------------------------------------------------------------------------------------
+std::vector<uint64_t> CommandHierarchySearchIndex::PostingList::Decode() const
+{
+    std::vector<uint64_t> nodes;
+    nodes.reserve(m_count);
+    uint64_t value = 0;
+    size_t   i = 0;
+    while (i < m_bytes.size())
+    {
+        uint64_t delta = 0;
+        uint32_t shift = 0;
+        uint8_t  byte;
+        do
+        {
+            byte = m_bytes[i++];
+            delta |= static_cast<uint64_t>(byte & 0x7f) << shift;
+            shift += 7;
+        } while (byte & 0x80);
+        value += delta;
+        nodes.push_back(value);
+    }
+    return nodes;
+}
+
+// =================================================================================================
+// CommandHierarchySearchIndex
+// =================================================================================================
+void CommandHierarchySearchIndex::Build(const CommandHierarchy &command_hierarchy)
+{
+    Clear();
+    m_command_hierarchy = &command_hierarchy;
+    m_num_nodes = command_hierarchy.size();
+
+    std::vector<uint32_t> node_trigrams;
+    for (uint64_t node_index = 0; node_index < m_num_nodes; ++node_index)
+    {
+        std::string_view desc = command_hierarchy.GetNodeDesc(node_index);
+
+        // Each trigram is recorded at most once per node
+        node_trigrams.clear();
+        for (size_t i = 0; i + 3 <= desc.size(); ++i)
+            node_trigrams.push_back(TrigramKey(Lower(desc[i]), Lower(desc[i + 1]), Lower(desc[i + 2])));
+        std::sort(node_trigrams.begin(), node_trigrams.end());
+        node_trigrams.erase(std::unique(node_trigrams.begin(), node_trigrams.end()),
+                            node_trigrams.end());
+        for (uint32_t key : node_trigrams)
+            m_trigrams[key].Append(node_index);
+
+        NodeType node_type = command_hierarchy.GetNodeType(node_index);
+        if (node_type == NodeType::kPacketNode)
+        {
+            m_opcode_nodes[command_hierarchy.GetPacketNodeOpcode(node_index)].push_back(node_index);
+        }
+        else if (node_type == NodeType::kRegNode)
+        {
+            m_register_nodes[ToLower(RegisterName(desc))].push_back(node_index);
+        }
+
+        size_t event_id = command_hierarchy.GetEventIndex(node_index);
+        if (event_id != 0)
+        {
+            if (m_event_nodes.size() < event_id)
+                m_event_nodes.resize(event_id, UINT64_MAX);
+            m_event_nodes[event_id - 1] = node_index;
+        }
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+void CommandHierarchySearchIndex::Clear()
+{
+    m_command_hierarchy = nullptr;
+    m_num_nodes = 0;
+    m_trigrams.clear();
+    for (std::vector<uint64_t> &nodes : m_opcode_nodes)
+        nodes.clear();
+    m_register_nodes.clear();
+    m_event_nodes.clear();
+}
+
+//--------------------------------------------------------------------------------------------------
+std::vector<uint64_t> CommandHierarchySearchIndex::FindSubstring(std::string_view text) const
+{
+    std::string lowered = ToLower(text);
+    auto pred = [&lowered](std::string_view desc) { return ContainsNoCase(desc, lowered); };
+    if (lowered.size() < 3)
+        return Verify(nullptr, pred);
+    std::vector<uint64_t> candidates = TrigramCandidates(lowered);
+    return Verify(&candidates, pred);
+}
+
+//--------------------------------------------------------------------------------------------------
+std::vector<uint64_t> CommandHierarchySearchIndex::FindPrefix(std::string_view prefix) const
+{
+    std::string lowered = ToLower(prefix);
+    auto pred = [&lowered](std::string_view desc) { return StartsWithNoCase(desc, lowered); };
+    if (lowered.size() < 3)
+        return Verify(nullptr, pred);
+    std::vector<uint64_t> candidates = TrigramCandidates(lowered);
+    return Verify(&candidates, pred);
+}
+
+//--------------------------------------------------------------------------------------------------
+bool CommandHierarchySearchIndex::FindRegex(const std::string     &pattern,
+                                            std::vector<uint64_t> *out_nodes) const
+{
+    std::regex regex;
+    try
+    {
+        regex.assign(pattern, std::regex::ECMAScript | std::regex::icase);
+    }
+    catch (const std::regex_error &)
+    {
+        return false;
+    }
+
+    auto pred = [&regex](std::string_view desc) {
+        return std::regex_search(desc.begin(), desc.end(), regex);
+    };
+    std::string literal = LongestMandatoryLiteral(pattern);
+    if (literal.size() < 3)
+    {
+        *out_nodes = Verify(nullptr, pred);
+        return true;
+    }
+    std::vector<uint64_t> candidates = TrigramCandidates(literal);
+    *out_nodes = Verify(&candidates, pred);
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+const std::vector<uint64_t> &CommandHierarchySearchIndex::FindByOpcode(uint8_t opcode) const
+{
+    return m_opcode_nodes[opcode];
+}
+
+//--------------------------------------------------------------------------------------------------
+const std::vector<uint64_t> &CommandHierarchySearchIndex::FindByRegisterName(
+std::string_view name) const
+{
+    static const std::vector<uint64_t> kEmpty;
+    auto                               it = m_register_nodes.find(ToLower(name));
+    return (it != m_register_nodes.end()) ? it->second : kEmpty;
+}
+
+//--------------------------------------------------------------------------------------------------
+uint64_t CommandHierarchySearchIndex::FindByEventId(uint64_t event_id) const
+{
+    if (event_id == 0 || event_id > m_event_nodes.size())
+        return UINT64_MAX;
+    return m_event_nodes[event_id - 1];
+}
+
+//--------------------------------------------------------------------------------------------------
+uint32_t CommandHierarchySearchIndex::TrigramKey(unsigned char a, unsigned char b, unsigned char c)
+{
+    return (static_cast<uint32_t>(a) << 16) | (static_cast<uint32_t>(b) << 8) | c;
+}
+
+//--------------------------------------------------------------------------------------------------
+std::vector<uint64_t> CommandHierarchySearchIndex::TrigramCandidates(
+std::string_view lowered_text) const
+{
+    DIVE_ASSERT(lowered_text.size() >= 3);
+
+    std::vector<const PostingList *> postings;
+    for (size_t i = 0; i + 3 <= lowered_text.size(); ++i)
+    {
+        uint32_t key = TrigramKey(lowered_text[i], lowered_text[i + 1], lowered_text[i + 2]);
+        auto     it = m_trigrams.find(key);
+        if (it == m_trigrams.end())
+            return {};
+        postings.push_back(&it->second);
+    }
+
+    // Intersect shortest lists first, so the working set only ever shrinks
+    std::sort(postings.begin(), postings.end());
+    postings.erase(std::unique(postings.begin(), postings.end()), postings.end());
+    std::sort(postings.begin(), postings.end(), [](const PostingList *a, const PostingList *b) {
+        return a->m_count < b->m_count;
+    });
+
+    std::vector<uint64_t> result = postings[0]->Decode();
+    std::vector<uint64_t> intersection;
+    for (size_t i = 1; i < postings.size() && !result.empty(); ++i)
+    {
+        std::vector<uint64_t> nodes = postings[i]->Decode();
+        intersection.clear();
+        std::set_intersection(result.begin(),
+                              result.end(),
+                              nodes.begin(),
+                              nodes.end(),
+                              std::back_inserter(intersection));
+        result.swap(intersection);
+    }
+    return result;
+}
+
+//--------------------------------------------------------------------------------------------------
+template<typename Pred>
+std::vector<uint64_t> CommandHierarchySearchIndex::Verify(const std::vector<uint64_t> *candidates,
+                                                          Pred                         pred) const
+{
+    std::vector<uint64_t> result;
+    if (m_command_hierarchy == nullptr)
+        return result;
+    if (candidates != nullptr)
+    {
+        for (uint64_t node_index : *candidates)
+        {
+            if (pred(m_command_hierarchy->GetNodeDesc(node_index)))
+                result.push_back(node_index);
+        }
+        return result;
+    }
+    for (uint64_t node_index = 0; node_index < m_num_nodes; ++node_index)
+    {
+        if (pred(m_command_hierarchy->GetNodeDesc(node_index)))
+            result.push_back(node_index);
+    }
+    return result;
+}
+
+}  // namespace Dive
@@ -0,0 +1,94 @@
+/*
+ Copyright 2025 Google LLC
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+// =====================================================================================================================
+// Search index over the nodes of a CommandHierarchy. Built once per hierarchy, it answers
+// case-insensitive substring, prefix and regex queries on node descriptions through a trigram
+// index, and exact lookups on typed fields (packet opcode, register name, event id).
+// =====================================================================================================================
+
+#pragma once
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace Dive
+{
+
+class CommandHierarchy;
+
+//--------------------------------------------------------------------------------------------------
+class CommandHierarchySearchIndex
+{
+public:
+    // The hierarchy must outlive the index; descriptions are verified against it, not copied
+    void Build(const CommandHierarchy &command_hierarchy);
+    void Clear();
+
+    // Number of nodes indexed, 0 if not built
+    uint64_t size() const { return m_num_nodes; }
+
+    // All queries return matching node indices in ascending order.
+    // Text queries are case-insensitive (ASCII).
+    std::vector<uint64_t> FindSubstring(std::string_view text) const;
+    std::vector<uint64_t> FindPrefix(std::string_view prefix) const;
+
+    // ECMAScript regex, searched anywhere in the description. The longest mandatory literal run in
+    // the pattern is used to narrow down candidates before the regex runs. Returns false if the
+    // pattern is invalid.
+    bool FindRegex(const std::string &pattern, std::vector<uint64_t> *out_nodes) const;
+
+    // kPacketNodes with the given opcode
+    const std::vector<uint64_t> &FindByOpcode(uint8_t opcode) const;
+
+    // kRegNodes for the given register name (case-insensitive, exact)
+    const std::vector<uint64_t> &FindByRegisterName(std::string_view name) const;
+
+    // Node for the given 1-based event id (see CommandHierarchy::GetEventIndex), UINT64_MAX if none
+    uint64_t FindByEventId(uint64_t event_id) const;
+
+private:
+    // Posting list of node indices, delta + varint encoded. Nodes are appended in increasing order
+    struct PostingList
+    {
+        std::vector<uint8_t> m_bytes;
+        uint64_t             m_last = 0;
+        uint64_t             m_count = 0;
+
+        void                  Append(uint64_t node_index);
+        std::vector<uint64_t> Decode() const;
+    };
+
+    static uint32_t TrigramKey(unsigned char a, unsigned char b, unsigned char c);
+
+    // Candidates containing every trigram of `lowered_text`, which must be >= 3 chars
+    std::vector<uint64_t> TrigramCandidates(std::string_view lowered_text) const;
+
+    // Keep only nodes for which `pred(description)` holds; scans every node if `candidates` is null
+    template<typename Pred>
+    std::vector<uint64_t> Verify(const std::vector<uint64_t> *candidates, Pred pred) const;
+
+    const CommandHierarchy                                *m_command_hierarchy = nullptr;
+    uint64_t                                               m_num_nodes = 0;
+    std::unordered_map<uint32_t, PostingList>              m_trigrams;
+    std::vector<uint64_t>                                  m_opcode_nodes[256];
+    std::unordered_map<std::string, std::vector<uint64_t>> m_register_nodes;
+    std::vector<uint64_t>                                  m_event_nodes;
+};
+
+}  // namespace Dive
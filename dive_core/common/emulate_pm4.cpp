@@ -298,6 +298,22 @@ bool EmulateStateTracker::IsRegSet(uint32_t offset, ShaderEnableBit shader_enabl
     return static_cast<bool>(is_reg_set);
 }
 
+//--------------------------------------------------------------------------------------------------
+bool EmulateStateTracker::IsRegSetTo(uint32_t offset, uint32_t value) const
+{
+    if (m_enable_mask == 0)
+        return false;
+    for (unsigned int i = 0; i < kShaderEnableBitCount; ++i)
+    {
+        if ((m_enable_mask & (1u << i)) == 0)
+            continue;
+        auto shader_enable_bit = static_cast<ShaderEnableBit>(i);
+        if (!IsRegSet(offset, shader_enable_bit) || m_reg[i][offset] != value)
+            return false;
+    }
+    return true;
+}
+
 // =================================================================================================
 // EmulatePM4
 // =================================================================================================
@@ -156,6 +156,10 @@ public:
 
     bool IsRegSet(uint32_t offset, ShaderEnableBit shader_enable_bit) const;
 
+    // True if the register already holds `value` for each pass of the current enable mask, i.e.
+    // if writing `value` to it now would not change any state
+    bool IsRegSetTo(uint32_t offset, uint32_t value) const;
+
 private:
     static constexpr size_t        kNumRegs = 0xffff + 1;
     uint32_t                       m_reg[kShaderEnableBitCount][kNumRegs];
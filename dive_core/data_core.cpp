@@ -35,6 +35,7 @@ DataCore::DataCore(ProgressTracker *progress_tracker) :
 //--------------------------------------------------------------------------------------------------
 CaptureData::LoadResult DataCore::LoadDiveCaptureData(const std::string &file_name)
 {
+    StopBackgroundDisassembly();
     std::filesystem::path rd_file_path(file_name);
     rd_file_path.replace_extension(".rd");
     m_capture_metadata = CaptureMetadata();
@@ -44,7 +45,7 @@ CaptureData::LoadResult DataCore::LoadDiveCaptureData(const std::string &file_na
 //--------------------------------------------------------------------------------------------------
 CaptureData::LoadResult DataCore::LoadPm4CaptureData(const std::string &file_name)
 {
-
+    StopBackgroundDisassembly();
     m_pm4_capture_data = Pm4CaptureData(m_progress_tracker);  // Clear any previously loaded data
     m_capture_metadata = CaptureMetadata();
     return m_pm4_capture_data.LoadCaptureFile(file_name);
@@ -126,6 +127,9 @@ bool DataCore::CreateDiveMetaData()
     {
         return false;
     }
+    metadata_creator.EncodeEventState();
+    m_capture_metadata.m_address_index.Build();
+    StartBackgroundDisassembly();
     return true;
 }
 
@@ -138,6 +142,9 @@ bool DataCore::CreatePm4MetaData()
     {
         return false;
     }
+    metadata_creator.EncodeEventState();
+    m_capture_metadata.m_address_index.Build();
+    StartBackgroundDisassembly();
     return true;
 }
 
@@ -199,6 +206,33 @@ bool DataCore::ParseGfxrCaptureData()
     return true;
 }
 
+//--------------------------------------------------------------------------------------------------
+void DataCore::WaitForBackgroundDisassembly()
+{
+    m_disassembly_pool.Wait();
+}
+
+//--------------------------------------------------------------------------------------------------
+void DataCore::StartBackgroundDisassembly()
+{
+    if (!m_background_disassembly || m_capture_metadata.m_shaders.empty())
+        return;
+
+    // Disassembly objects are disassembled at most once, so a view that asks for a shader before
+    // its task has run just waits for (or does) that one disassembly
+    auto task_count = static_cast<unsigned int>(m_capture_metadata.m_shaders.size());
+    m_disassembly_pool.Start(ThreadPool::SuggestedNumberOfWorkers(task_count));
+    for (const Disassembly &disassembly : m_capture_metadata.m_shaders)
+        m_disassembly_pool.Run([&disassembly]() { disassembly.EagerEval(); });
+}
+
+//--------------------------------------------------------------------------------------------------
+void DataCore::StopBackgroundDisassembly()
+{
+    // Tasks that have not started are dropped; those shaders are disassembled on first access
+    m_disassembly_pool.Stop();
+}
+
 //--------------------------------------------------------------------------------------------------
 const Pm4CaptureData &DataCore::GetPm4CaptureData() const
 {
@@ -247,15 +281,28 @@ CaptureMetadataCreator::CaptureMetadataCreator(CaptureMetadata &capture_metadata
 //--------------------------------------------------------------------------------------------------
 CaptureMetadataCreator::~CaptureMetadataCreator() {}
 
+//--------------------------------------------------------------------------------------------------
+void CaptureMetadataCreator::EncodeEventState()
+{
+    m_capture_metadata.m_event_state.Encode(m_event_state);
+    m_event_state = EventStateInfo();
+    m_capture_metadata.m_state_groups.Finalize();
+}
+
 //--------------------------------------------------------------------------------------------------
 void CaptureMetadataCreator::OnSubmitStart(uint32_t submit_index, const SubmitInfo &submit_info)
 {
     m_state_tracker.Reset();
+    m_bound_descriptors.clear();
     m_current_render_mode = RenderModeType::kUnknown;
+    m_bin_started_by_prefix = false;
 }
 
 //--------------------------------------------------------------------------------------------------
-void CaptureMetadataCreator::OnSubmitEnd(uint32_t submit_index, const SubmitInfo &submit_info) {}
+void CaptureMetadataCreator::OnSubmitEnd(uint32_t submit_index, const SubmitInfo &submit_info)
+{
+    EndRenderPass();
+}
 
 //--------------------------------------------------------------------------------------------------
 bool CaptureMetadataCreator::OnIbStart(uint32_t                  submit_index,
@@ -264,6 +311,15 @@ bool CaptureMetadataCreator::OnIbStart(uint32_t                  submit_index,
                                        IbType                    type)
 {
     EmulateCallbacksBase::OnIbStart(submit_index, ib_index, ib_info, type);
+    uint32_t num_events = static_cast<uint32_t>(m_capture_metadata.m_event_info.size());
+    m_ib_starts.push_back({ ib_info.m_va_addr, ib_info.m_size_in_dwords, num_events });
+
+    // Each bin of a CP_START_BIN starts with its own prefix IB
+    if (type == IbType::kBinPrefix)
+    {
+        BeginBin(submit_index);
+        m_bin_started_by_prefix = true;
+    }
     return true;
 }
 
@@ -273,6 +329,22 @@ bool CaptureMetadataCreator::OnIbEnd(uint32_t                  submit_index,
                                      const IndirectBufferInfo &ib_info)
 {
     EmulateCallbacksBase::OnIbEnd(submit_index, ib_index, ib_info);
+
+    // The IB is referenced by every event issued while it was executing, including from the IBs
+    // it called
+    DIVE_ASSERT(!m_ib_starts.empty());
+    IbStart ib_start = m_ib_starts.back();
+    m_ib_starts.pop_back();
+    if (ib_start.m_size_in_dwords != 0)
+    {
+        uint32_t num_events = static_cast<uint32_t>(m_capture_metadata.m_event_info.size());
+        m_capture_metadata.m_address_index.AddRange(AddressRangeType::kIndirectBuffer,
+                                                    ib_start.m_va_addr,
+                                                    ib_start.m_va_addr +
+                                                    ib_start.m_size_in_dwords * sizeof(uint32_t),
+                                                    ib_start.m_first_event,
+                                                    num_events);
+    }
     return true;
 }
 
@@ -299,6 +371,8 @@ bool CaptureMetadataCreator::OnPacket(const IMemoryManager &mem_manager,
         // as mentioned in adreno_pm4.xml, only b0-b3 are considered when b8 is not set
         DIVE_ASSERT((packet.u32All0 & 0x100) == 0);
         a6xx_marker marker = static_cast<a6xx_marker>(packet.u32All0 & 0xf);
+        bool        bin_started_by_prefix = m_bin_started_by_prefix;
+        m_bin_started_by_prefix = false;
 
         // TODO(wangra): find a way to remove the duplicatation in CommandHierarchyCreator::OnPacket
         switch (marker)
@@ -307,18 +381,26 @@ bool CaptureMetadataCreator::OnPacket(const IMemoryManager &mem_manager,
             // disabled
         case RM6_DIRECT_RENDER:
             m_current_render_mode = RenderModeType::kDirect;
+            EndRenderPass();
+            BeginRenderPass(submit_index, false);
             break;
             // This is emitted at the begining of the binning pass, although the binning pass
             // could be missing even in tiled rendering mode
         case RM6_BIN_VISIBILITY:
             m_current_render_mode = RenderModeType::kBinningVis;
+            EndRenderPass();
+            BeginRenderPass(submit_index, true);
             break;
         case RM6_BIN_DIRECT:
             m_current_render_mode = RenderModeType::kBinningDirect;
+            EndRenderPass();
+            BeginRenderPass(submit_index, true);
             break;
             // This is emitted at the begining of the tiled rendering pass
         case RM6_BIN_RENDER_START:
             m_current_render_mode = RenderModeType::kTiled;
+            if (!bin_started_by_prefix)
+                BeginBin(submit_index);
             break;
             // This is emitted at the end of the tiled rendering pass
         case RM6_BIN_END_OF_DRAWS:
@@ -333,11 +415,13 @@ bool CaptureMetadataCreator::OnPacket(const IMemoryManager &mem_manager,
             // This is emitted for each dispatch
         case RM6_COMPUTE:
             m_current_render_mode = RenderModeType::kDispatch;
+            EndRenderPass();
             break;
         // This seems to be the end of Resolve Pass
         case RM6_BIN_RENDER_END:
             // should be paired with RM6_BIN_RESOLVE, end of resolve pass
             m_current_render_mode = RenderModeType::kUnknown;
+            EndBin();
             break;
         case RM6_BLIT2DSCALE:
         case RM6_IB1LIST_START:
@@ -348,6 +432,12 @@ bool CaptureMetadataCreator::OnPacket(const IMemoryManager &mem_manager,
         }
     }
 
+    if (type7_header->opcode == CP_LOAD_STATE6 || type7_header->opcode == CP_LOAD_STATE6_GEOM ||
+        type7_header->opcode == CP_LOAD_STATE6_FRAG)
+    {
+        TrackDescriptorLoad(mem_manager, submit_index, va_addr);
+    }
+
     if (Util::IsEvent(mem_manager, submit_index, va_addr, type7_header->opcode, m_state_tracker))
     {
         // Add a new event to the EventInfo metadata array
@@ -360,6 +450,10 @@ bool CaptureMetadataCreator::OnPacket(const IMemoryManager &mem_manager,
                                                            submit_index,
                                                            va_addr,
                                                            *type7_header);
+            event_info.m_num_instances = Util::GetInstanceCount(mem_manager,
+                                                                submit_index,
+                                                                va_addr,
+                                                                *type7_header);
         }
         else if (IsDispatchEventOpcode(type7_header->opcode))
             event_info.m_type = EventInfo::EventType::kDispatch;
@@ -414,16 +508,23 @@ bool CaptureMetadataCreator::OnPacket(const IMemoryManager &mem_manager,
             }
         }
 
-        EventStateInfo::Iterator it = m_capture_metadata.m_event_state.Add();
+        EventStateInfo::Iterator it = m_event_state.Add();
 
         event_info.m_render_mode = m_current_render_mode;
-        event_info.m_str = Util::GetEventString(mem_manager,
-                                                submit_index,
-                                                va_addr,
-                                                *type7_header,
-                                                m_state_tracker);
-
-        m_capture_metadata.m_event_info.push_back(event_info);
+        std::string event_str = Util::GetEventString(mem_manager,
+                                                     submit_index,
+                                                     va_addr,
+                                                     *type7_header,
+                                                     m_state_tracker);
+
+        m_capture_metadata.m_event_info.push_back(event_info, event_str);
+        uint32_t event_id = static_cast<uint32_t>(m_capture_metadata.m_event_info.size() - 1);
+        AddAddressReferences(mem_manager, submit_index, va_addr, *type7_header, event_id);
+        if (event_info.m_type >= EventInfo::EventType::kColorSysMemToGmemResolve &&
+            event_info.m_type <= EventInfo::EventType::kSysmemToGmemResolve)
+        {
+            AddResolveInfo(event_id);
+        }
 
         // Parse and add the shader(s) info to the metadata
         if (event_info.m_type == EventInfo::EventType::kDraw ||
@@ -438,6 +539,8 @@ bool CaptureMetadataCreator::OnPacket(const IMemoryManager &mem_manager,
                 return false;
         }
 
+        m_capture_metadata.m_state_groups.AddEvent(m_event_state, m_capture_metadata.m_event_info);
+
 #if defined(ENABLE_CAPTURE_BUFFERS)
         // Parse descriptor tables, descriptors, and descriptor contents (ie: textures,
         // buffers, etc)
@@ -467,7 +570,8 @@ bool CaptureMetadataCreator::HandleShaders(const IMemoryManager &mem_manager,
         bool is_valid_shader = is_dispatch && (shader == (uint32_t)ShaderStage::kShaderStageCs);
         is_valid_shader |= !is_dispatch && (shader != (uint32_t)ShaderStage::kShaderStageCs);
 
-        EventInfo &cur_event_info = m_capture_metadata.m_event_info.back();
+        EventInfoTable &event_info = m_capture_metadata.m_event_info;
+        size_t          cur_event_id = event_info.size() - 1;
 
         for (uint32_t enable_index = 0; enable_index < kShaderEnableBitCount; ++enable_index)
         {
@@ -480,16 +584,23 @@ bool CaptureMetadataCreator::HandleShaders(const IMemoryManager &mem_manager,
             // TODO(wangra): need to investigate why `addr` could be 0 here
             if (is_valid_shader && (addr != UINT64_MAX) && (addr != 0))
             {
+                m_capture_metadata.m_address_index.AddEventReference(AddressRangeType::kShader,
+                                                                     addr,
+                                                                     addr + 1,
+                                                                     static_cast<uint32_t>(
+                                                                     cur_event_id));
+
                 // Check if we've already seen a shader at this address, in which case we just need
                 // to reference the existing shader.
-                if (m_shader_addrs.find(addr) != m_shader_addrs.end())
+                auto shader_it = m_shader_addrs.find(addr);
+                if (shader_it != m_shader_addrs.end())
                 {
-                    uint32_t shader_index = m_shader_addrs[addr];
+                    uint32_t shader_index = shader_it->second;
                     {
                         // Check if this event already has a reference to this shader, in which case
                         // we just add to the existing reference's enable mask.
                         bool found = false;
-                        for (auto &reference : cur_event_info.m_shader_references)
+                        for (auto &reference : event_info.GetShaderReferences(cur_event_id))
                         {
                             if (reference.m_shader_index == shader_index)
                             {
@@ -504,7 +615,7 @@ bool CaptureMetadataCreator::HandleShaders(const IMemoryManager &mem_manager,
                     reference.m_shader_index = shader_index;
                     reference.m_stage = (ShaderStage)shader;
                     reference.m_enable_mask = enable_mask;
-                    cur_event_info.m_shader_references.push_back(reference);
+                    event_info.AddShaderReference(reference);
                 }
                 else
                 {
@@ -516,15 +627,15 @@ bool CaptureMetadataCreator::HandleShaders(const IMemoryManager &mem_manager,
                     m_capture_metadata.m_shaders.emplace_back(mem_manager,
                                                               submit_index,
                                                               addr,
-                                                              &cur_event_info.m_metadata_log);
-                    m_shader_addrs.insert(std::make_pair(addr, shader_index));
+                                                              event_info.GetMetadataLog());
+                    m_shader_addrs.emplace(addr, shader_index);
 
-                    // Add the shader index to the EventInfo
+                    // Add the shader index to the event
                     ShaderReference reference;
-                    reference.m_shader_index = m_shader_addrs[addr];
+                    reference.m_shader_index = shader_index;
                     reference.m_stage = (ShaderStage)shader;
                     reference.m_enable_mask = enable_mask;
-                    cur_event_info.m_shader_references.push_back(reference);
+                    event_info.AddShaderReference(reference);
                 }
             }
         }
@@ -532,6 +643,176 @@ bool CaptureMetadataCreator::HandleShaders(const IMemoryManager &mem_manager,
     return true;
 }
 
+//--------------------------------------------------------------------------------------------------
+void CaptureMetadataCreator::TrackDescriptorLoad(const IMemoryManager &mem_manager,
+                                                 uint32_t              submit_index,
+                                                 uint64_t              va_addr)
+{
+    PM4_CP_LOAD_STATE6 packet;
+    DIVE_VERIFY(mem_manager.RetrieveMemoryData(&packet, submit_index, va_addr, sizeof(packet)));
+
+    const bool is_compute = (packet.bitfields0.STATE_BLOCK == SB6_CS_TEX) ||
+                            (packet.bitfields0.STATE_BLOCK == SB6_CS_SHADER) ||
+                            (packet.bitfields0.STATE_BLOCK == SB6_CS_UAV);
+
+    // Descriptors loaded directly are part of the IB, which is indexed already
+    uint64_t src_addr = 0;
+    bool     bindless = false;
+    if (packet.bitfields0.STATE_SRC == SS6_INDIRECT)
+    {
+        src_addr = packet.u32All1 & 0xfffffffc;
+        src_addr |= ((uint64_t)packet.u32All2) << 32;
+    }
+    else if (packet.bitfields0.STATE_SRC == SS6_BINDLESS)
+    {
+        bindless = true;
+        const uint32_t base_reg = is_compute ?
+                                  GetRegOffsetByName("HLSQ_CS_BINDLESS_BASE0_DESCRIPTOR") :
+                                  GetRegOffsetByName("HLSQ_BINDLESS_BASE0_DESCRIPTOR");
+        const uint32_t reg = base_reg + (packet.u32All1 >> 28) * 2;
+        if (!m_state_tracker.IsRegSet(reg) || !m_state_tracker.IsRegSet(reg + 1))
+            return;
+        src_addr = m_state_tracker.GetRegValue(reg) & 0xfffffffc;
+        src_addr |= ((uint64_t)m_state_tracker.GetRegValue(reg + 1)) << 32;
+        src_addr += 4 * (packet.u32All1 & 0xffffff);
+    }
+    if (src_addr == 0)
+        return;
+
+    // Size of each descriptor, see CommandHierarchyCreator::AppendLoadStateExtBufferNode()
+    uint32_t unit_size = 0;
+    switch (packet.bitfields0.STATE_BLOCK)
+    {
+    case SB6_CS_TEX:
+    case SB6_VS_TEX:
+    case SB6_HS_TEX:
+    case SB6_DS_TEX:
+    case SB6_GS_TEX:
+    case SB6_FS_TEX:
+        if (packet.bitfields0.STATE_TYPE == ST6_SHADER)
+            unit_size = bindless ? 16 : sizeof(A6XX_TEX_SAMP);
+        else if (packet.bitfields0.STATE_TYPE == ST6_CONSTANTS)
+            unit_size = sizeof(A6XX_TEX_CONST);
+        else if (packet.bitfields0.STATE_TYPE == ST6_UBO)
+            unit_size = bindless ? 16 : sizeof(A6XX_UBO);
+        break;
+    case SB6_CS_SHADER:
+    case SB6_VS_SHADER:
+    case SB6_HS_SHADER:
+    case SB6_DS_SHADER:
+    case SB6_GS_SHADER:
+    case SB6_FS_SHADER:
+        // Shader code and constants are not descriptors
+        if (packet.bitfields0.STATE_TYPE == ST6_UBO)
+            unit_size = bindless ? 16 : sizeof(A6XX_UBO);
+        else if (packet.bitfields0.STATE_TYPE == ST6_UAV)
+            unit_size = sizeof(A6XX_TEX_CONST);
+        break;
+    case SB6_CS_UAV:
+    case SB6_UAV:
+        if (packet.bitfields0.STATE_TYPE == ST6_SHADER)
+            unit_size = bindless ? 16 : sizeof(A6XX_TEX_CONST);
+        else if (packet.bitfields0.STATE_TYPE == ST6_CONSTANTS)
+            unit_size = 2 * sizeof(uint32_t);
+        break;
+    default:
+        break;
+    }
+    if (unit_size == 0 || packet.bitfields0.NUM_UNIT == 0)
+        return;
+
+    uint32_t key = (packet.bitfields0.STATE_BLOCK << 24) | (packet.bitfields0.STATE_TYPE << 16) |
+                   packet.bitfields0.DST_OFF;
+    m_bound_descriptors[key] = { src_addr,
+                                 src_addr + uint64_t(packet.bitfields0.NUM_UNIT) * unit_size,
+                                 is_compute };
+}
+
+//--------------------------------------------------------------------------------------------------
+void CaptureMetadataCreator::AddAddressReferences(const IMemoryManager &mem_manager,
+                                                  uint32_t              submit_index,
+                                                  uint64_t              va_addr,
+                                                  Pm4Type7Header        header,
+                                                  uint32_t              event_id)
+{
+    AddressIndex &address_index = m_capture_metadata.m_address_index;
+
+    // Index buffer. The index size is 1 << INDEX_SIZE bytes (a4xx_index_size)
+    if (header.opcode == CP_DRAW_INDX_OFFSET)
+    {
+        // Non-indexed draws do not need to fill out entire packet
+        PM4_CP_DRAW_INDX_OFFSET packet;
+        uint32_t                header_and_body_dword_count = header.count + 1;
+        if (header_and_body_dword_count * sizeof(uint32_t) >= sizeof(packet))
+        {
+            DIVE_VERIFY(
+            mem_manager.RetrieveMemoryData(&packet, submit_index, va_addr, sizeof(packet)));
+            if (packet.bitfields0.SOURCE_SELECT == DI_SRC_SEL_DMA && packet.INDX_BASE != 0 &&
+                packet.MAX_INDICES != 0)
+            {
+                uint64_t index_bytes = uint64_t(packet.MAX_INDICES)
+                                       << packet.bitfields0.INDEX_SIZE;
+                address_index.AddEventReference(AddressRangeType::kIndexBuffer,
+                                                packet.INDX_BASE,
+                                                packet.INDX_BASE + index_bytes,
+                                                event_id);
+
+                // MAX_INDICES bounds the indices drawn, from FIRST_INDX on
+                uint32_t first_index = packet.bitfields3.FIRST_INDX;
+                uint32_t num_indices = 0;
+                if (first_index < packet.MAX_INDICES)
+                {
+                    num_indices = std::min<uint32_t>(packet.bitfields2.NUM_INDICES,
+                                                     packet.MAX_INDICES - first_index);
+                }
+                if (num_indices != 0 && packet.bitfields0.INDEX_SIZE <= INDEX4_SIZE_32_BIT)
+                {
+                    uint32_t index_size = 1u << packet.bitfields0.INDEX_SIZE;
+                    m_capture_metadata.m_indexed_draws.push_back(
+                    { event_id,
+                      submit_index,
+                      packet.INDX_BASE + uint64_t(first_index) * index_size,
+                      num_indices,
+                      index_size,
+                      GetIndexTopology(packet.bitfields0.PRIM_TYPE) });
+                }
+            }
+        }
+    }
+    else if (header.opcode == CP_DRAW_INDX_INDIRECT)
+    {
+        PM4_CP_DRAW_INDX_INDIRECT packet;
+        DIVE_VERIFY(mem_manager.RetrieveMemoryData(&packet, submit_index, va_addr, sizeof(packet)));
+        uint64_t index_base_addr = ((uint64_t)packet.bitfields2.INDX_BASE_HI << 32) |
+                                   (uint64_t)packet.bitfields1.INDX_BASE_LO;
+        if (index_base_addr != 0 && packet.bitfields3.MAX_INDICES != 0)
+        {
+            uint64_t index_bytes = uint64_t(packet.bitfields3.MAX_INDICES)
+                                   << packet.bitfields0.INDEX_SIZE;
+            address_index.AddEventReference(AddressRangeType::kIndexBuffer,
+                                            index_base_addr,
+                                            index_base_addr + index_bytes,
+                                            event_id);
+        }
+    }
+
+    // Descriptors bound for the pipeline of the event
+    bool is_compute = IsDispatchEventOpcode(header.opcode);
+    if (is_compute || IsDrawEventOpcode(header.opcode))
+    {
+        for (const auto &[key, load] : m_bound_descriptors)
+        {
+            if (load.m_is_compute == is_compute)
+            {
+                address_index.AddEventReference(AddressRangeType::kDescriptors,
+                                                load.m_va_start,
+                                                load.m_va_end,
+                                                event_id);
+            }
+        }
+    }
+}
+
 //--------------------------------------------------------------------------------------------------
 void CaptureMetadataCreator::FillEventStateInfo(EventStateInfo::Iterator event_state_it)
 {
@@ -1069,4 +1350,120 @@ void CaptureMetadataCreator::FillHardwareSpecificStates(EventStateInfo::Iterator
     }
 }
 
+//--------------------------------------------------------------------------------------------------
+void CaptureMetadataCreator::BeginRenderPass(uint32_t submit_index, bool is_tiled)
+{
+    uint32_t num_events = static_cast<uint32_t>(m_capture_metadata.m_event_info.size());
+    m_capture_metadata.m_render_passes.BeginPass(submit_index, num_events, is_tiled);
+}
+
+//--------------------------------------------------------------------------------------------------
+void CaptureMetadataCreator::EndRenderPass()
+{
+    RenderPassTable &render_passes = m_capture_metadata.m_render_passes;
+    if (render_passes.IsBinOpen())
+        EndBin();
+    if (render_passes.IsPassOpen())
+        render_passes.EndPass(static_cast<uint32_t>(m_capture_metadata.m_event_info.size()));
+}
+
+//--------------------------------------------------------------------------------------------------
+void CaptureMetadataCreator::BeginBin(uint32_t submit_index)
+{
+    // Tiled passes without a binning pass have no marker before their first bin
+    RenderPassTable &render_passes = m_capture_metadata.m_render_passes;
+    if (render_passes.IsBinOpen())
+        EndBin();
+    if (!render_passes.IsTiledPassOpen())
+    {
+        EndRenderPass();
+        BeginRenderPass(submit_index, true);
+    }
+    render_passes.BeginBin(static_cast<uint32_t>(m_capture_metadata.m_event_info.size()));
+}
+
+//--------------------------------------------------------------------------------------------------
+void CaptureMetadataCreator::EndBin()
+{
+    RenderPassTable &render_passes = m_capture_metadata.m_render_passes;
+    if (!render_passes.IsBinOpen())
+        return;
+
+    // The window scissor is set to the bin by the tile select at the start of the bin
+    uint32_t x = 0, y = 0, width = 0, height = 0;
+    uint32_t tl_reg_offset = GetRegOffsetByName("GRAS_SC_WINDOW_SCISSOR_TL");
+    uint32_t br_reg_offset = GetRegOffsetByName("GRAS_SC_WINDOW_SCISSOR_BR");
+    if (m_state_tracker.IsRegSet(tl_reg_offset) && m_state_tracker.IsRegSet(br_reg_offset))
+    {
+        GRAS_SC_WINDOW_SCISSOR_TL gras_sc_window_scissor_tl;
+        GRAS_SC_WINDOW_SCISSOR_BR gras_sc_window_scissor_br;
+        gras_sc_window_scissor_tl.u32All = m_state_tracker.GetRegValue(tl_reg_offset);
+        gras_sc_window_scissor_br.u32All = m_state_tracker.GetRegValue(br_reg_offset);
+        x = gras_sc_window_scissor_tl.bitfields.X;
+        y = gras_sc_window_scissor_tl.bitfields.Y;
+        uint32_t br_x = gras_sc_window_scissor_br.bitfields.X;
+        uint32_t br_y = gras_sc_window_scissor_br.bitfields.Y;
+        if (br_x >= x && br_y >= y)
+        {
+            width = br_x - x + 1;
+            height = br_y - y + 1;
+        }
+    }
+    render_passes.EndBin(static_cast<uint32_t>(m_capture_metadata.m_event_info.size()),
+                         x,
+                         y,
+                         width,
+                         height);
+}
+
+//--------------------------------------------------------------------------------------------------
+void CaptureMetadataCreator::AddResolveInfo(uint32_t event_id)
+{
+    // The resolve area is inclusive, and the system memory buffer gives the format and number of
+    // samples of the data loaded or stored
+    uint32_t cntl_1_reg_offset = GetRegOffsetByName("RB_RESOLVE_CNTL_1");
+    uint32_t cntl_2_reg_offset = GetRegOffsetByName("RB_RESOLVE_CNTL_2");
+    uint32_t buffer_info_reg_offset = GetRegOffsetByName("RB_RESOLVE_SYSTEM_BUFFER_INFO");
+    if (!m_state_tracker.IsRegSet(cntl_1_reg_offset) ||
+        !m_state_tracker.IsRegSet(cntl_2_reg_offset) ||
+        !m_state_tracker.IsRegSet(buffer_info_reg_offset))
+    {
+        return;
+    }
+
+    RB_RESOLVE_CNTL_1             rb_resolve_cntl_1;
+    RB_RESOLVE_CNTL_2             rb_resolve_cntl_2;
+    RB_RESOLVE_SYSTEM_BUFFER_INFO rb_resolve_system_buffer_info;
+    rb_resolve_cntl_1.u32All = m_state_tracker.GetRegValue(cntl_1_reg_offset);
+    rb_resolve_cntl_2.u32All = m_state_tracker.GetRegValue(cntl_2_reg_offset);
+    rb_resolve_system_buffer_info.u32All = m_state_tracker.GetRegValue(buffer_info_reg_offset);
+    if (rb_resolve_cntl_2.bitfields.X < rb_resolve_cntl_1.bitfields.X ||
+        rb_resolve_cntl_2.bitfields.Y < rb_resolve_cntl_1.bitfields.Y)
+    {
+        return;
+    }
+
+    // Bits per pixel come from the name of the format enum, which the register tables provide
+    uint32_t        bits_per_pixel = 0;
+    const RegInfo  *buffer_info = GetRegInfo(buffer_info_reg_offset);
+    const RegField *format_field = GetRegFieldByName("COLOR_FORMAT", buffer_info);
+    if (format_field != nullptr && format_field->m_enum_handle != UINT8_MAX)
+    {
+        const char *format_str = GetEnumString(format_field->m_enum_handle,
+                                               rb_resolve_system_buffer_info.bitfields
+                                               .COLOR_FORMAT);
+        if (format_str != nullptr)
+            bits_per_pixel = GetFormatBitsPerPixel(format_str);
+    }
+
+    ResolveInfo resolve = {};
+    resolve.m_event_id = event_id;
+    resolve.m_width = rb_resolve_cntl_2.bitfields.X - rb_resolve_cntl_1.bitfields.X + 1;
+    resolve.m_height = rb_resolve_cntl_2.bitfields.Y - rb_resolve_cntl_1.bitfields.Y + 1;
+    resolve.m_bits_per_pixel = bits_per_pixel;
+    resolve.m_num_samples = 1u << static_cast<uint32_t>(
+                            rb_resolve_system_buffer_info.bitfields.SAMPLES);
+    m_capture_metadata.m_render_passes.AddResolve(resolve);
+}
+
 }  // namespace Dive
@@ -18,14 +18,20 @@
 #pragma once
 #include <deque>
 #include <map>
+#include <unordered_map>
 #include <vector>
+#include "address_index.h"
 #include "pm4_capture_data.h"
 #include "gfxr_capture_data.h"
 #include "dive_capture_data.h"
 #include "capture_event_info.h"
 #include "command_hierarchy.h"
 #include "event_state.h"
+#include "event_state_groups.h"
+#include "index_buffer_analysis.h"
 #include "progress_tracker.h"
+#include "render_pass_table.h"
+#include "thread_pool.h"
 #include "dive_command_hierarchy.h"
 
 namespace Dive
@@ -46,11 +52,26 @@ struct CaptureMetadata
     std::vector<BufferInfo> m_buffers;
 
     // Information about each event in the capture
-    std::vector<EventInfo> m_event_info;
+    EventInfoTable m_event_info;
 
     // Register state tracking for each event
-    // This is separated from EventInfo to take advantage of code-gen
-    EventStateInfo m_event_state;
+    // This is separated from EventInfo to take advantage of code-gen. Most state stays the same
+    // across consecutive events, so it is kept delta-encoded; consumers that need the flat arrays
+    // Decode() it, and those looking at a few events Decode() just those
+    EventStateInfoDelta m_event_state;
+
+    // Index of the distinct states of each state group and of the events using them. The values of
+    // the states are read from m_event_state
+    EventStateGroups m_state_groups;
+
+    // Shaders, index buffers, descriptors and IBs referenced by each event, searchable by address
+    AddressIndex m_address_index;
+
+    // Render passes and bins as event ranges, and the area and format of each resolve
+    RenderPassTable m_render_passes;
+
+    // Indices read by each indexed draw, in event order
+    std::vector<IndexedDrawInfo> m_indexed_draws;
 
     // Information about the submits in this capture
     uint64_t m_num_pm4_packets;
@@ -99,7 +120,17 @@ public:
     // Get metadata describing the capture (info obtained by parsing the capture)
     const CaptureMetadata &GetCaptureMetadata() const;
 
+    // When enabled, every shader is disassembled on a thread pool right after the metadata is
+    // created, rather than lazily on first access. Off by default
+    void SetBackgroundDisassembly(bool enable) { m_background_disassembly = enable; }
+
+    // Blocks until the background disassembly pass, if any, has finished
+    void WaitForBackgroundDisassembly();
+
 private:
+    void StartBackgroundDisassembly();
+    void StopBackgroundDisassembly();
+
     // Create command hierarchy from the captured data
     bool CreateDiveCommandHierarchy();
     bool CreatePm4CommandHierarchy();
@@ -113,6 +144,11 @@ private:
 
     // Metadata for the capture data in m_capture_data
     CaptureMetadata m_capture_metadata;
+
+    // Declared last, so that background tasks are joined before the shaders and memory they use
+    // are destroyed
+    bool       m_background_disassembly = false;
+    ThreadPool m_disassembly_pool;
 };
 
 #if defined(ENABLE_CAPTURE_BUFFERS)
@@ -155,6 +191,10 @@ public:
 
     const EmulateStateTracker &GetStateTracker() const { return m_state_tracker; }
 
+    // Encodes the event state gathered so far into the metadata, then frees the flat copy and the
+    // tables used to number the state groups. Call once all the submits have been processed
+    void EncodeEventState();
+
     // Callbacks
     virtual bool OnIbStart(uint32_t                  submit_index,
                            uint32_t                  ib_index,
@@ -173,6 +213,14 @@ public:
 
 private:
     bool HandleShaders(const IMemoryManager &mem_manager, uint32_t submit_index, uint32_t opcode);
+    void TrackDescriptorLoad(const IMemoryManager &mem_manager,
+                             uint32_t              submit_index,
+                             uint64_t              va_addr);
+    void AddAddressReferences(const IMemoryManager &mem_manager,
+                              uint32_t              submit_index,
+                              uint64_t              va_addr,
+                              Pm4Type7Header        header,
+                              uint32_t              event_id);
     void FillEventStateInfo(EventStateInfo::Iterator event_state_it);
     void FillInputAssemblyState(EventStateInfo::Iterator event_state_it);
     void FillTessellationState(EventStateInfo::Iterator event_state_it);
@@ -182,16 +230,47 @@ private:
     void FillDepthState(EventStateInfo::Iterator event_state_it);
     void FillColorBlendState(EventStateInfo::Iterator event_state_it);
     void FillHardwareSpecificStates(EventStateInfo::Iterator event_state_it);
+    void BeginRenderPass(uint32_t submit_index, bool is_tiled);
+    void EndRenderPass();
+    void BeginBin(uint32_t submit_index);
+    void EndBin();
+    void AddResolveInfo(uint32_t event_id);
 
     // Map from shader address to shader index (in m_capture_metadata.m_shaders)
-    std::map<uint64_t, uint32_t> m_shader_addrs;
+    std::unordered_map<uint64_t, uint32_t> m_shader_addrs;
 
     // Map from buffer address to buffer index (in m_capture_metadata.m_buffers)
-    std::map<uint64_t, uint32_t> m_buffer_addrs;
+    std::unordered_map<uint64_t, uint32_t> m_buffer_addrs;
+
+    // Descriptors loaded indirectly with CP_LOAD_STATE6, which stay bound until overwritten.
+    // Keyed by state block, state type and destination offset
+    struct DescriptorLoad
+    {
+        uint64_t m_va_start;
+        uint64_t m_va_end;
+        bool     m_is_compute;
+    };
+    std::map<uint32_t, DescriptorLoad> m_bound_descriptors;
+
+    // IBs being emulated, and the number of events when each one started
+    struct IbStart
+    {
+        uint64_t m_va_addr;
+        uint32_t m_size_in_dwords;
+        uint32_t m_first_event;
+    };
+    std::vector<IbStart> m_ib_starts;
+
+    // Flat event state, filled event by event and delta-encoded by EncodeEventState()
+    EventStateInfo m_event_state;
 
     CaptureMetadata &m_capture_metadata;
     RenderModeType   m_current_render_mode = RenderModeType::kUnknown;
 
+    // Set when a bin was started by its CP_START_BIN prefix IB, so the RM6_BIN_RENDER_START marker
+    // the prefix emits does not start another one
+    bool m_bin_started_by_prefix = false;
+
 #if defined(ENABLE_CAPTURE_BUFFERS)
     // SRDCallbacks is a friend class, since it is essentially doing part of
     // CaptureMetadataCreator's work and is only a separate class due to the callback nature of SRD
@@ -179,6 +179,8 @@ GfxrVulkanCommandHierarchyCreator &gfxr_command_hierarchy_creator)
         cur_topology.m_end_shared_child.resize(total_num_nodes);
         cur_topology.m_root_node_index.resize(total_num_nodes);
     }
+
+    m_command_hierarchy.BuildFilteredTopologies();
 }
 
 }  // namespace Dive
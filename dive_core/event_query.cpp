@@ -0,0 +1,623 @@
+/*
+ Copyright 2025 Google LLC
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#include "event_query.h"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include "data_core.h"
+
+namespace Dive
+{
+
+namespace
+{
+
+constexpr double kUnset = std::numeric_limits<double>::quiet_NaN();
+
+using FillFunc = void (*)(const CaptureMetadata &metadata, double *out);
+
+struct ColumnInfo
+{
+    const char        *m_name;
+    const char        *m_description;
+    FillFunc           m_fill;
+    const char *const *m_value_names;  // Indexed by value, nullptr if the column is numeric
+    uint32_t           m_num_value_names;
+    bool               m_is_state;  // Derived from the event state rather than from EventInfo
+};
+
+// Indexed by EventInfo::EventType
+const char *const kEventTypeNames[] = { "draw",
+                                        "dispatch",
+                                        "blit",
+                                        "color_sysmem_to_gmem_resolve",
+                                        "color_gmem_to_sysmem_resolve",
+                                        "color_gmem_to_sysmem_resolve_and_clear",
+                                        "color_clear_gmem",
+                                        "depth_sysmem_to_gmem_resolve",
+                                        "depth_gmem_to_sysmem_resolve",
+                                        "depth_gmem_to_sysmem_resolve_and_clear",
+                                        "depth_clear_gmem",
+                                        "sysmem_to_gmem_resolve",
+                                        "wait_mem_writes",
+                                        "wait_for_idle",
+                                        "wait_for_me",
+                                        "event_write_start",
+                                        "event_write_end" };
+static_assert(std::size(kEventTypeNames) ==
+              static_cast<size_t>(EventInfo::EventType::kEventWriteEnd) + 1);
+
+// Indexed by RenderModeType
+const char *const kRenderModeNames[] = { "direct", "binning_vis", "binning_direct", "tiled",
+                                         "resolve", "dispatch",    "unknown" };
+static_assert(std::size(kRenderModeNames) == static_cast<size_t>(RenderModeType::kUnknown) + 1);
+
+// Indexed by VkCompareOp
+const char *const kCompareOpNames[] = { "never",   "less",      "equal",            "less_or_equal",
+                                        "greater", "not_equal", "greater_or_equal", "always" };
+static_assert(std::size(kCompareOpNames) == static_cast<size_t>(VK_COMPARE_OP_ALWAYS) + 1);
+
+// Indexed by a6xx_ztest_mode
+const char *const kZTestModeNames[] = { "early_z", "late_z", "early_z_late_z", "invalid" };
+static_assert(std::size(kZTestModeNames) == static_cast<size_t>(A6XX_INVALID_ZTEST) + 1);
+
+// Size of the EventStateInfo Attachment array (one per MRT)
+constexpr uint32_t kNumAttachments = 8;
+
+//--------------------------------------------------------------------------------------------------
+template<typename Func>
+void FillEventColumn(const CaptureMetadata &metadata, double *out, Func func)
+{
+    const EventInfoTable &event_info = metadata.m_event_info;
+    for (size_t i = 0; i < event_info.size(); ++i)
+        out[i] = func(event_info[i]);
+}
+
+//--------------------------------------------------------------------------------------------------
+bool IsResolveOrClear(EventInfo::EventType type)
+{
+    return type >= EventInfo::EventType::kColorSysMemToGmemResolve &&
+           type <= EventInfo::EventType::kSysmemToGmemResolve;
+}
+
+//--------------------------------------------------------------------------------------------------
+// For resolves and GMEM clears, the number of draws since the previous event of the same type in
+// the submit. Unset for the first one of its type, and for one that directly follows another of
+// the same type with only resolves in between (one per attachment, e.g. with MRTs)
+void FillDrawsSinceResolveColumn(const CaptureMetadata &metadata, double *out)
+{
+    struct LastResolve
+    {
+        uint64_t m_num_draws;
+        uint32_t m_run;
+        bool     m_seen;
+    };
+    const size_t kNumTypes = static_cast<size_t>(EventInfo::EventType::kEventWriteEnd) + 1;
+
+    const EventInfoTable    &event_info = metadata.m_event_info;
+    std::vector<LastResolve> last(kNumTypes);
+    uint64_t                 num_draws = 0;
+    uint32_t                 run = 0;  // Incremented on every event that is not a resolve
+    uint32_t                 submit = UINT32_MAX;
+    for (size_t i = 0; i < event_info.size(); ++i)
+    {
+        const EventInfo &info = event_info[i];
+        if (info.m_submit_index != submit)
+        {
+            submit = info.m_submit_index;
+            last.assign(kNumTypes, LastResolve());
+        }
+        out[i] = kUnset;
+        if (!IsResolveOrClear(info.m_type))
+        {
+            num_draws += (info.m_type == EventInfo::EventType::kDraw) ? 1 : 0;
+            ++run;
+            continue;
+        }
+        LastResolve &prev = last[static_cast<size_t>(info.m_type)];
+        if (prev.m_seen && prev.m_run != run)
+            out[i] = static_cast<double>(num_draws - prev.m_num_draws);
+        prev = { num_draws, run, true };
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+// Fills a scalar state field one run of unchanged values at a time, looking up each run's value
+// once; events that never set the field get `unset` (kUnset unless the field has a known default)
+template<typename GetFunc, typename IsSetFunc>
+void FillStateColumn(const EventStateInfoDelta   &state,
+                     const std::vector<uint32_t> &changes,
+                     double                      *out,
+                     GetFunc                      get,
+                     IsSetFunc                    is_set,
+                     double                       unset = kUnset)
+{
+    for (size_t change = 0; change < changes.size(); ++change)
+    {
+        uint32_t     begin = changes[change];
+        uint32_t     end = (change + 1 < changes.size()) ? changes[change + 1] : state.size();
+        EventStateId id(begin);
+        std::fill(out + begin, out + end, is_set(id) ? static_cast<double>(get(id)) : unset);
+    }
+}
+
+#define EVENT_COLUMN(name, description, expr)                                           \
+    {                                                                                   \
+        name, description,                                                              \
+        [](const CaptureMetadata &metadata, double *out) {                              \
+            FillEventColumn(metadata, out, [](const EventInfo &info) -> double {        \
+                return expr;                                                            \
+            });                                                                         \
+        },                                                                              \
+        nullptr, 0, false                                                               \
+    }
+
+#define STATE_ENUM_COLUMN(name, field, value_names)                                     \
+    {                                                                                   \
+        name, nullptr,                                                                  \
+        [](const CaptureMetadata &metadata, double *out) {                              \
+            const EventStateInfoDelta &state = metadata.m_event_state;                  \
+            FillStateColumn(                                                            \
+            state,                                                                      \
+            state.field##Changes(),                                                     \
+            out,                                                                        \
+            [&](EventStateId id) { return state.field(id); },                           \
+            [&](EventStateId id) { return state.Is##field##Set(id); });                 \
+        },                                                                              \
+        value_names, static_cast<uint32_t>(std::size(value_names)), true                \
+    }
+
+#define STATE_COLUMN(name, field)                                                       \
+    {                                                                                   \
+        name, nullptr,                                                                  \
+        [](const CaptureMetadata &metadata, double *out) {                              \
+            const EventStateInfoDelta &state = metadata.m_event_state;                  \
+            FillStateColumn(                                                            \
+            state,                                                                      \
+            state.field##Changes(),                                                     \
+            out,                                                                        \
+            [&](EventStateId id) { return state.field(id); },                           \
+            [&](EventStateId id) { return state.Is##field##Set(id); });                 \
+        },                                                                              \
+        nullptr, 0, true                                                                \
+    }
+
+// clang-format off
+const ColumnInfo kColumns[] = {
+    { "type", "Type of event (draw, dispatch, blit, ...)",
+      [](const CaptureMetadata &metadata, double *out) {
+          FillEventColumn(metadata, out, [](const EventInfo &info) {
+              return static_cast<double>(info.m_type);
+          });
+      },
+      kEventTypeNames, static_cast<uint32_t>(std::size(kEventTypeNames)), false },
+    { "render_mode", "Render mode active when the event was issued",
+      [](const CaptureMetadata &metadata, double *out) {
+          FillEventColumn(metadata, out, [](const EventInfo &info) {
+              return static_cast<double>(info.m_render_mode);
+          });
+      },
+      kRenderModeNames, static_cast<uint32_t>(std::size(kRenderModeNames)), false },
+    EVENT_COLUMN("submit", "Submit that contains the event", info.m_submit_index),
+    EVENT_COLUMN("num_indices", "Number of indices processed, for draws", info.m_num_indices),
+    EVENT_COLUMN("num_instances", "Number of instances, for draws", info.m_num_instances),
+    { "num_shaders", "Number of shaders referenced",
+      [](const CaptureMetadata &metadata, double *out) {
+          for (size_t i = 0; i < metadata.m_event_info.size(); ++i)
+              out[i] = static_cast<double>(metadata.m_event_info.GetShaderReferences(i).size());
+      },
+      nullptr, 0, false },
+    { "draws_since_resolve",
+      "For resolves and GMEM clears, draws since the previous one of the same type in the submit",
+      FillDrawsSinceResolveColumn, nullptr, 0, false },
+    { "blend_enabled", "Blending enabled on any color attachment",
+      [](const CaptureMetadata &metadata, double *out) {
+          const EventStateInfoDelta &state = metadata.m_event_state;
+          for (uint32_t i = 0; i < state.size(); ++i)
+          {
+              EventStateId id(i);
+              out[i] = kUnset;
+              for (uint32_t a = 0; a < kNumAttachments; ++a)
+              {
+                  if (state.IsAttachmentSet(id, a))
+                      out[i] = (out[i] == 1.0 || state.Attachment(id, a).blendEnable) ? 1.0 : 0.0;
+              }
+          }
+      },
+      nullptr, 0, true },
+    STATE_COLUMN("topology", Topology),
+    STATE_COLUMN("prim_restart_enabled", PrimRestartEnabled),
+    STATE_COLUMN("patch_control_points", PatchControlPoints),
+    STATE_COLUMN("depth_clamp_enabled", DepthClampEnabled),
+    STATE_COLUMN("rasterizer_discard_enabled", RasterizerDiscardEnabled),
+    STATE_COLUMN("polygon_mode", PolygonMode),
+    STATE_COLUMN("cull_mode", CullMode),
+    STATE_COLUMN("front_face", FrontFace),
+    STATE_COLUMN("depth_bias_enabled", DepthBiasEnabled),
+    STATE_COLUMN("depth_bias_constant_factor", DepthBiasConstantFactor),
+    STATE_COLUMN("depth_bias_clamp", DepthBiasClamp),
+    STATE_COLUMN("depth_bias_slope_factor", DepthBiasSlopeFactor),
+    STATE_COLUMN("line_width", LineWidth),
+    STATE_COLUMN("rasterization_samples", RasterizationSamples),
+    STATE_COLUMN("sample_shading_enabled", SampleShadingEnabled),
+    STATE_COLUMN("min_sample_shading", MinSampleShading),
+    STATE_COLUMN("sample_mask", SampleMask),
+    STATE_COLUMN("alpha_to_coverage_enabled", AlphaToCoverageEnabled),
+    STATE_COLUMN("depth_test_enabled", DepthTestEnabled),
+    STATE_COLUMN("depth_write_enabled", DepthWriteEnabled),
+    STATE_ENUM_COLUMN("depth_compare_op", DepthCompareOp, kCompareOpNames),
+    STATE_COLUMN("depth_bounds_test_enabled", DepthBoundsTestEnabled),
+    STATE_COLUMN("min_depth_bounds", MinDepthBounds),
+    STATE_COLUMN("max_depth_bounds", MaxDepthBounds),
+    STATE_COLUMN("stencil_test_enabled", StencilTestEnabled),
+    { "lrz_enabled", "LRZ enabled. False where LRZ was never configured, as it is off by default",
+      [](const CaptureMetadata &metadata, double *out) {
+          const EventStateInfoDelta &state = metadata.m_event_state;
+          FillStateColumn(
+          state,
+          state.LRZEnabledChanges(),
+          out,
+          [&](EventStateId id) { return state.LRZEnabled(id); },
+          [&](EventStateId id) { return state.IsLRZEnabledSet(id); },
+          0.0);
+      },
+      nullptr, 0, true },
+    STATE_COLUMN("lrz_write", LRZWrite),
+    STATE_COLUMN("lrz_dir_status", LRZDirStatus),
+    STATE_COLUMN("lrz_dir_write", LRZDirWrite),
+    STATE_ENUM_COLUMN("ztest_mode", ZTestMode, kZTestModeNames),
+    STATE_COLUMN("bin_w", BinW),
+    STATE_COLUMN("bin_h", BinH),
+    STATE_COLUMN("window_scissor_tl_x", WindowScissorTLX),
+    STATE_COLUMN("window_scissor_tl_y", WindowScissorTLY),
+    STATE_COLUMN("window_scissor_br_x", WindowScissorBRX),
+    STATE_COLUMN("window_scissor_br_y", WindowScissorBRY),
+    STATE_COLUMN("state_render_mode", RenderMode),
+    STATE_COLUMN("buffers_location", BuffersLocation),
+    STATE_COLUMN("thread_size", ThreadSize),
+    STATE_COLUMN("enable_all_helper_lanes", EnableAllHelperLanes),
+    STATE_COLUMN("enable_partial_helper_lanes", EnablePartialHelperLanes),
+    STATE_COLUMN("ubwc_enabled_on_ds", UBWCEnabledOnDS),
+    STATE_COLUMN("ubwc_lossless_enabled_on_ds", UBWCLosslessEnabledOnDS),
+};
+// clang-format on
+
+#undef EVENT_COLUMN
+#undef STATE_ENUM_COLUMN
+#undef STATE_COLUMN
+
+constexpr uint32_t kNumColumns = static_cast<uint32_t>(std::size(kColumns));
+
+//--------------------------------------------------------------------------------------------------
+std::string_view Trim(std::string_view text)
+{
+    while (!text.empty() && std::isspace(static_cast<unsigned char>(text.front())))
+        text.remove_prefix(1);
+    while (!text.empty() && std::isspace(static_cast<unsigned char>(text.back())))
+        text.remove_suffix(1);
+    return text;
+}
+
+//--------------------------------------------------------------------------------------------------
+bool EqualsNoCase(std::string_view a, std::string_view b)
+{
+    return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin(), [](char x, char y) {
+               return std::tolower(static_cast<unsigned char>(x)) ==
+                      std::tolower(static_cast<unsigned char>(y));
+           });
+}
+
+//--------------------------------------------------------------------------------------------------
+// Appends the rows of `rows` (or of [0, num_rows) if null) for which `cmp(column[row])` holds.
+// Branch-free so the compiler can keep the loop tight.
+template<typename Cmp>
+void Select(const double                *column,
+            const std::vector<uint32_t> *rows,
+            uint32_t                     num_rows,
+            Cmp                          cmp,
+            std::vector<uint32_t>       *out)
+{
+    size_t count = (rows != nullptr) ? rows->size() : num_rows;
+    out->resize(count);
+    uint32_t *dst = out->data();
+    size_t    n = 0;
+    if (rows != nullptr)
+    {
+        for (uint32_t row : *rows)
+        {
+            dst[n] = row;
+            n += cmp(column[row]) ? 1 : 0;
+        }
+    }
+    else
+    {
+        for (uint32_t row = 0; row < num_rows; ++row)
+        {
+            dst[n] = row;
+            n += cmp(column[row]) ? 1 : 0;
+        }
+    }
+    out->resize(n);
+}
+
+//--------------------------------------------------------------------------------------------------
+// NaN (unset) never matches, including for kNotEqual
+void SelectOp(const double                *column,
+              const std::vector<uint32_t> *rows,
+              uint32_t                     num_rows,
+              EventQuery::CompareOp        op,
+              double                       value,
+              std::vector<uint32_t>       *out)
+{
+    switch (op)
+    {
+    case EventQuery::CompareOp::kEqual:
+        Select(column, rows, num_rows, [value](double v) { return v == value; }, out);
+        break;
+    case EventQuery::CompareOp::kNotEqual:
+        Select(column, rows, num_rows, [value](double v) { return v < value || v > value; }, out);
+        break;
+    case EventQuery::CompareOp::kLess:
+        Select(column, rows, num_rows, [value](double v) { return v < value; }, out);
+        break;
+    case EventQuery::CompareOp::kLessEqual:
+        Select(column, rows, num_rows, [value](double v) { return v <= value; }, out);
+        break;
+    case EventQuery::CompareOp::kGreater:
+        Select(column, rows, num_rows, [value](double v) { return v > value; }, out);
+        break;
+    case EventQuery::CompareOp::kGreaterEqual:
+        Select(column, rows, num_rows, [value](double v) { return v >= value; }, out);
+        break;
+    }
+}
+
+}  // namespace
+
+// =================================================================================================
+// EventQuery
+// =================================================================================================
+EventQuery::EventQuery(const CaptureMetadata &metadata) :
+    m_metadata(metadata),
+    m_num_events(static_cast<uint32_t>(metadata.m_event_info.size())),
+    m_columns(kNumColumns)
+{
+    DIVE_ASSERT(metadata.m_event_state.size() == m_num_events);
+}
+
+//--------------------------------------------------------------------------------------------------
+uint32_t EventQuery::GetNumColumns()
+{
+    return kNumColumns;
+}
+
+//--------------------------------------------------------------------------------------------------
+const char *EventQuery::GetColumnName(uint32_t column)
+{
+    DIVE_ASSERT(column < kNumColumns);
+    return kColumns[column].m_name;
+}
+
+//--------------------------------------------------------------------------------------------------
+const char *EventQuery::GetColumnDescription(uint32_t column)
+{
+    DIVE_ASSERT(column < kNumColumns);
+    return kColumns[column].m_description != nullptr ? kColumns[column].m_description :
+                                                       "Event state field";
+}
+
+//--------------------------------------------------------------------------------------------------
+bool EventQuery::IsStateColumn(uint32_t column)
+{
+    DIVE_ASSERT(column < kNumColumns);
+    return kColumns[column].m_is_state;
+}
+
+//--------------------------------------------------------------------------------------------------
+uint32_t EventQuery::FindColumn(std::string_view name)
+{
+    for (uint32_t column = 0; column < kNumColumns; ++column)
+    {
+        if (EqualsNoCase(name, kColumns[column].m_name))
+            return column;
+    }
+    return UINT32_MAX;
+}
+
+//--------------------------------------------------------------------------------------------------
+bool EventQuery::AddFilter(std::string_view expression)
+{
+    uint32_t  column;
+    CompareOp op;
+    double    value;
+    if (!ParseFilter(expression, &column, &op, &value))
+        return false;
+    return AddFilter(column, op, value);
+}
+
+//--------------------------------------------------------------------------------------------------
+bool EventQuery::ParseFilter(std::string_view expression,
+                             uint32_t        *column,
+                             CompareOp       *op,
+                             double          *value)
+{
+    // Longer operators first, so "<=" is not read as "<"
+    struct OpToken
+    {
+        std::string_view m_text;
+        CompareOp        m_op;
+    };
+    static const OpToken kOps[] = { { "==", CompareOp::kEqual },
+                                    { "!=", CompareOp::kNotEqual },
+                                    { "<=", CompareOp::kLessEqual },
+                                    { ">=", CompareOp::kGreaterEqual },
+                                    { "<", CompareOp::kLess },
+                                    { ">", CompareOp::kGreater },
+                                    { "=", CompareOp::kEqual } };
+
+    size_t pos = expression.find_first_of("=!<>");
+    if (pos == std::string_view::npos)
+        return false;
+    for (const OpToken &token : kOps)
+    {
+        if (expression.substr(pos, token.m_text.size()) != token.m_text)
+            continue;
+        *column = FindColumn(Trim(expression.substr(0, pos)));
+        *op = token.m_op;
+        return *column != UINT32_MAX &&
+               ParseValue(*column, Trim(expression.substr(pos + token.m_text.size())), value);
+    }
+    return false;
+}
+
+//--------------------------------------------------------------------------------------------------
+bool EventQuery::AddFilter(uint32_t column, CompareOp op, double value)
+{
+    if (column >= kNumColumns)
+        return false;
+    m_filters.push_back({ column, op, value });
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+bool EventQuery::AddProjection(std::string_view column_name)
+{
+    uint32_t column = FindColumn(Trim(column_name));
+    if (column == UINT32_MAX)
+        return false;
+    m_projections.push_back(column);
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+void EventQuery::Run(EventQueryResult *result) const
+{
+    // Each filter narrows the selection vector left by the previous one
+    std::vector<uint32_t> rows, selected;
+    bool                  all_rows = true;
+    for (const Filter &filter : m_filters)
+    {
+        Select(filter.m_column, filter.m_op, filter.m_value, all_rows ? nullptr : &rows, &selected);
+        rows.swap(selected);
+        all_rows = false;
+        if (rows.empty())
+            break;
+    }
+    if (all_rows)
+    {
+        rows.resize(m_num_events);
+        for (uint32_t i = 0; i < m_num_events; ++i)
+            rows[i] = i;
+    }
+
+    result->m_columns.clear();
+    result->m_values.clear();
+    result->m_values.resize(m_projections.size());
+    for (size_t p = 0; p < m_projections.size(); ++p)
+    {
+        const std::vector<double> &column = GetColumn(m_projections[p]);
+        std::vector<double>       &values = result->m_values[p];
+        values.resize(rows.size());
+        for (size_t r = 0; r < rows.size(); ++r)
+            values[r] = column[rows[r]];
+        result->m_columns.push_back(kColumns[m_projections[p]].m_name);
+    }
+    result->m_event_ids = std::move(rows);
+}
+
+//--------------------------------------------------------------------------------------------------
+void EventQuery::Select(uint32_t                     column,
+                        CompareOp                    op,
+                        double                       value,
+                        const std::vector<uint32_t> *rows,
+                        std::vector<uint32_t>       *out) const
+{
+    DIVE_ASSERT(column < kNumColumns);
+    SelectOp(GetColumn(column).data(), rows, m_num_events, op, value, out);
+}
+
+//--------------------------------------------------------------------------------------------------
+double EventQuery::GetValue(uint32_t column, uint32_t event_id) const
+{
+    DIVE_ASSERT(column < kNumColumns && event_id < m_num_events);
+    return GetColumn(column)[event_id];
+}
+
+//--------------------------------------------------------------------------------------------------
+std::string EventQuery::FormatValue(uint32_t column, double value)
+{
+    DIVE_ASSERT(column < kNumColumns);
+    if (std::isnan(value))
+        return "-";
+    const ColumnInfo &info = kColumns[column];
+    if (info.m_value_names != nullptr && value >= 0 && value < info.m_num_value_names)
+        return info.m_value_names[static_cast<uint32_t>(value)];
+
+    // Integral values (the vast majority) print without a fractional part
+    if (value == std::floor(value) && std::fabs(value) < 1e15)
+        return std::to_string(static_cast<int64_t>(value));
+    return std::to_string(value);
+}
+
+//--------------------------------------------------------------------------------------------------
+const std::vector<double> &EventQuery::GetColumn(uint32_t column) const
+{
+    DIVE_ASSERT(column < kNumColumns);
+    std::vector<double> &values = m_columns[column];
+    if (values.size() != m_num_events)
+    {
+        values.resize(m_num_events);
+        kColumns[column].m_fill(m_metadata, values.data());
+    }
+    return values;
+}
+
+//--------------------------------------------------------------------------------------------------
+bool EventQuery::ParseValue(uint32_t column, std::string_view text, double *value)
+{
+    if (text.empty())
+        return false;
+
+    const ColumnInfo &info = kColumns[column];
+    for (uint32_t i = 0; i < info.m_num_value_names; ++i)
+    {
+        if (EqualsNoCase(text, info.m_value_names[i]))
+        {
+            *value = i;
+            return true;
+        }
+    }
+    if (EqualsNoCase(text, "true"))
+    {
+        *value = 1.0;
+        return true;
+    }
+    if (EqualsNoCase(text, "false"))
+    {
+        *value = 0.0;
+        return true;
+    }
+
+    std::string str(text);
+    char       *end = nullptr;
+    *value = std::strtod(str.c_str(), &end);
+    return end == str.c_str() + str.size();
+}
+
+}  // namespace Dive
@@ -0,0 +1,135 @@
+/*
+ Copyright 2025 Google LLC
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+// =====================================================================================================================
+// Columnar queries over the events of a capture. Every queryable EventInfo field and scalar
+// EventStateInfo field is exposed as a named column of doubles (one row per event), materialized
+// on first use from the SOA arrays, or from the runs of the delta-encoded event state. Filters are
+// evaluated one column at a time over a selection vector, so a query touches only the columns it
+// names.
+// =====================================================================================================================
+
+#pragma once
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Dive
+{
+
+struct CaptureMetadata;
+
+//--------------------------------------------------------------------------------------------------
+struct EventQueryResult
+{
+    // Projected column names, in the order requested
+    std::vector<std::string> m_columns;
+
+    // Index into CaptureMetadata::m_event_info of each matching event, ascending
+    std::vector<uint32_t> m_event_ids;
+
+    // Column-major: m_values[column][row]. NaN where the state field was never set for the event,
+    // unless the column describes a default
+    std::vector<std::vector<double>> m_values;
+};
+
+//--------------------------------------------------------------------------------------------------
+class EventQuery
+{
+public:
+    enum class CompareOp
+    {
+        kEqual,
+        kNotEqual,
+        kLess,
+        kLessEqual,
+        kGreater,
+        kGreaterEqual
+    };
+
+    // The metadata must outlive the query
+    explicit EventQuery(const CaptureMetadata &metadata);
+
+    // Available columns, whether or not they have been materialized yet
+    static uint32_t    GetNumColumns();
+    static const char *GetColumnName(uint32_t column);
+    static const char *GetColumnDescription(uint32_t column);
+
+    // Whether the column is derived from the event state rather than from EventInfo
+    static bool IsStateColumn(uint32_t column);
+
+    // Index of the named column, UINT32_MAX if unknown
+    static uint32_t FindColumn(std::string_view name);
+
+    // Adds a filter of the form "<column><op><value>", with op one of == = != < <= > >=.
+    // The value is a number, true/false, or a symbolic name for enum columns (e.g. "type==draw").
+    // Filters are ANDed together. Returns false if the expression cannot be parsed.
+    bool AddFilter(std::string_view expression);
+    bool AddFilter(uint32_t column, CompareOp op, double value);
+
+    // Parses a filter expression as accepted by AddFilter() without adding it
+    static bool ParseFilter(std::string_view expression,
+                            uint32_t        *column,
+                            CompareOp       *op,
+                            double          *value);
+
+    // Adds a column to the output. Returns false if the column is unknown
+    bool AddProjection(std::string_view column);
+
+    void ClearFilters() { m_filters.clear(); }
+    void ClearProjections() { m_projections.clear(); }
+
+    // Evaluates all filters and gathers the projected columns for the matching events
+    void Run(EventQueryResult *result) const;
+
+    // Writes to `out` the ids in `rows` (all events if null) whose value in `column` passes the
+    // comparison, independently of the filters added. `rows` must be ascending and not alias `out`
+    void Select(uint32_t                     column,
+                CompareOp                    op,
+                double                       value,
+                const std::vector<uint32_t> *rows,
+                std::vector<uint32_t>       *out) const;
+
+    // Value of `column` for one event. NaN where the state field was never set, unless the column
+    // describes a default
+    double GetValue(uint32_t column, uint32_t event_id) const;
+
+    // Formats a value of `column` for display, using symbolic names where the column has them
+    static std::string FormatValue(uint32_t column, double value);
+
+    // Values of `column` for all events, materialized on first use and kept until the query is
+    // destroyed. NaN where the state field was never set, unless the column describes a default
+    const std::vector<double> &GetColumn(uint32_t column) const;
+
+private:
+    struct Filter
+    {
+        uint32_t  m_column;
+        CompareOp m_op;
+        double    m_value;
+    };
+
+    static bool ParseValue(uint32_t column, std::string_view text, double *value);
+
+    const CaptureMetadata                   &m_metadata;
+    uint32_t                                 m_num_events;
+    std::vector<Filter>                      m_filters;
+    std::vector<uint32_t>                    m_projections;
+    mutable std::vector<std::vector<double>> m_columns;
+};
+
+}  // namespace Dive
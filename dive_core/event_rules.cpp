@@ -0,0 +1,211 @@
+/*
+ Copyright 2025 Google LLC
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#include "event_rules.h"
+#include <cctype>
+#include "dive_core/common/common.h"
+
+namespace Dive
+{
+
+namespace
+{
+
+//--------------------------------------------------------------------------------------------------
+std::string_view Trim(std::string_view text)
+{
+    while (!text.empty() && std::isspace(static_cast<unsigned char>(text.front())))
+        text.remove_prefix(1);
+    while (!text.empty() && std::isspace(static_cast<unsigned char>(text.back())))
+        text.remove_suffix(1);
+    return text;
+}
+
+}  // namespace
+
+//--------------------------------------------------------------------------------------------------
+const std::vector<EventRule> &GetDefaultEventRules()
+{
+    // Draw rules start with the same conditions so they share the selection of draws
+    static const std::vector<EventRule> kRules = {
+        { "lrz_disabled",
+          "LRZ is disabled on a draw with a depth test that can reject fragments",
+          { "type==draw",
+            "render_mode<=binning_direct",
+            "depth_test_enabled==true",
+            "lrz_enabled==false",
+            "depth_compare_op!=never",
+            "depth_compare_op!=always" },
+          { "depth_write_enabled", "depth_compare_op", "lrz_enabled" } },
+        { "late_z",
+          "Depth test runs after the fragment shader, so no fragment is rejected early",
+          { "type==draw", "render_mode<=binning_direct", "depth_test_enabled==true",
+            "ztest_mode==late_z" },
+          { "depth_write_enabled", "depth_compare_op", "lrz_enabled" } },
+        { "blend_with_depth_write",
+          "Blending is enabled on a draw that writes depth, as opaque geometry does",
+          { "type==draw", "blend_enabled==true", "depth_write_enabled==true" },
+          { "render_mode", "depth_compare_op" } },
+        { "redundant_resolve",
+          "Resolve or GMEM clear with no draw since the previous one of the same type",
+          { "draws_since_resolve==0" },
+          { "type", "render_mode" } },
+        { "wait_for_idle_in_bin",
+          "The GPU idles in the middle of rendering a bin",
+          { "type==wait_for_idle", "render_mode==tiled" },
+          { "submit" } },
+    };
+    return kRules;
+}
+
+// =================================================================================================
+// EventRuleSet
+// =================================================================================================
+bool EventRuleSet::AddRule(const EventRule &rule)
+{
+    if (rule.m_conditions.empty())
+        return false;
+
+    std::vector<Condition> conditions(rule.m_conditions.size());
+    for (size_t i = 0; i < conditions.size(); ++i)
+    {
+        Condition &condition = conditions[i];
+        if (!EventQuery::ParseFilter(rule.m_conditions[i],
+                                     &condition.m_column,
+                                     &condition.m_op,
+                                     &condition.m_value))
+            return false;
+    }
+    ParsedRule parsed = { rule, {} };
+    for (const std::string &detail : rule.m_details)
+    {
+        uint32_t column = EventQuery::FindColumn(Trim(detail));
+        if (column == UINT32_MAX)
+            return false;
+        parsed.m_detail_columns.push_back(column);
+    }
+
+    // Follow the rules already added for as long as the conditions match, then branch off
+    uint32_t node = 0;
+    for (const Condition &condition : conditions)
+    {
+        uint32_t next = UINT32_MAX;
+        for (uint32_t child : m_nodes[node].m_children)
+        {
+            if (m_nodes[child].m_condition == condition)
+            {
+                next = child;
+                break;
+            }
+        }
+        if (next == UINT32_MAX)
+        {
+            next = static_cast<uint32_t>(m_nodes.size());
+            m_nodes.push_back({ condition, {}, {} });
+            m_nodes[node].m_children.push_back(next);
+        }
+        node = next;
+    }
+    m_nodes[node].m_rules.push_back(static_cast<uint32_t>(m_rules.size()));
+    m_rules.push_back(std::move(parsed));
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+bool EventRuleSet::AddRules(std::string_view text, std::string *error)
+{
+    uint32_t line_number = 0;
+    while (!text.empty())
+    {
+        size_t           end = text.find('\n');
+        std::string_view line = Trim(text.substr(0, end));
+        text.remove_prefix(end == std::string_view::npos ? text.size() : end + 1);
+        ++line_number;
+        if (line.empty() || line.front() == '#')
+            continue;
+
+        EventRule rule;
+        size_t    colon = line.find(':');
+        if (colon != std::string_view::npos)
+        {
+            rule.m_name = Trim(line.substr(0, colon));
+            std::string_view conditions = line.substr(colon + 1);
+            while (!conditions.empty())
+            {
+                size_t comma = conditions.find(',');
+                rule.m_conditions.emplace_back(Trim(conditions.substr(0, comma)));
+                conditions.remove_prefix(comma == std::string_view::npos ? conditions.size() :
+                                                                           comma + 1);
+            }
+        }
+        if (rule.m_name.empty() || !AddRule(rule))
+        {
+            *error = "Invalid rule on line " + std::to_string(line_number) + ": " +
+                     std::string(line);
+            return false;
+        }
+    }
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+void EventRuleSet::Evaluate(const EventQuery                   &query,
+                            std::vector<std::vector<uint32_t>> *violations) const
+{
+    violations->clear();
+    violations->resize(m_rules.size());
+    EvaluateNode(query, 0, nullptr, violations);
+}
+
+//--------------------------------------------------------------------------------------------------
+void EventRuleSet::EvaluateNode(const EventQuery                   &query,
+                                uint32_t                            node,
+                                const std::vector<uint32_t>        *events,
+                                std::vector<std::vector<uint32_t>> *violations) const
+{
+    DIVE_ASSERT(events != nullptr || m_nodes[node].m_rules.empty());
+    for (uint32_t rule : m_nodes[node].m_rules)
+        (*violations)[rule] = *events;
+    if (events != nullptr && events->empty())
+        return;
+
+    std::vector<uint32_t> selected;
+    for (uint32_t child : m_nodes[node].m_children)
+    {
+        const Condition &condition = m_nodes[child].m_condition;
+        query.Select(condition.m_column, condition.m_op, condition.m_value, events, &selected);
+        EvaluateNode(query, child, &selected, violations);
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+std::string EventRuleSet::FormatViolation(const EventQuery &query,
+                                          uint32_t          rule,
+                                          uint32_t          event_id) const
+{
+    std::string text;
+    for (uint32_t column : m_rules[rule].m_detail_columns)
+    {
+        if (!text.empty())
+            text += '\t';
+        text += EventQuery::GetColumnName(column);
+        text += ':';
+        text += EventQuery::FormatValue(column, query.GetValue(column, event_id));
+    }
+    return text;
+}
+
+}  // namespace Dive
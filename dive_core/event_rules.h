@@ -0,0 +1,113 @@
+/*
+ Copyright 2025 Google LLC
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+// =====================================================================================================================
+// Declarative checks over the events of a capture. A rule is a list of EventQuery filters that
+// together describe a problem (e.g. "depth test on, LRZ off"); the events matching all of them
+// are its violations. All rules of a set are evaluated together in bulk over the query columns,
+// and text is only formatted for the violations.
+// =====================================================================================================================
+
+#pragma once
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "event_query.h"
+
+namespace Dive
+{
+
+//--------------------------------------------------------------------------------------------------
+struct EventRule
+{
+    // Short identifier, e.g. "lrz_disabled"
+    std::string m_name;
+
+    std::string m_description;
+
+    // EventQuery filter expressions, ANDed. Rules listing their common conditions first, in the
+    // same order, share their evaluation
+    std::vector<std::string> m_conditions;
+
+    // Columns reported for each violation
+    std::vector<std::string> m_details;
+};
+
+// Checks for common performance problems: LRZ or early Z lost, blending on opaque draws, redundant
+// resolves and idling inside bins
+const std::vector<EventRule> &GetDefaultEventRules();
+
+//--------------------------------------------------------------------------------------------------
+class EventRuleSet
+{
+public:
+    // Returns false if the rule has no condition, or a condition or detail column is invalid
+    bool AddRule(const EventRule &rule);
+
+    // Adds the rules in `text`, one per line as "<name>: <condition>[, <condition>...]". Empty
+    // lines and lines starting with '#' are skipped. Returns false and sets `error` on the first
+    // line that cannot be parsed
+    bool AddRules(std::string_view text, std::string *error);
+
+    size_t           size() const { return m_rules.size(); }
+    const EventRule &GetRule(uint32_t rule) const { return m_rules[rule].m_rule; }
+
+    // Ids of the events violating each rule, ascending and indexed like the rules. Every distinct
+    // prefix of conditions is evaluated once, over the events matching the shorter prefix
+    void Evaluate(const EventQuery &query, std::vector<std::vector<uint32_t>> *violations) const;
+
+    // The detail columns of `rule` for one violating event, as "<column>:<value>" separated by tabs
+    std::string FormatViolation(const EventQuery &query, uint32_t rule, uint32_t event_id) const;
+
+private:
+    struct Condition
+    {
+        uint32_t              m_column;
+        EventQuery::CompareOp m_op;
+        double                m_value;
+
+        bool operator==(const Condition &other) const
+        {
+            return m_column == other.m_column && m_op == other.m_op && m_value == other.m_value;
+        }
+    };
+
+    // Rules are stored as a trie of their conditions. The root has no condition
+    struct Node
+    {
+        Condition             m_condition;
+        std::vector<uint32_t> m_children;
+        std::vector<uint32_t> m_rules;  // Rules whose last condition is this one
+    };
+
+    struct ParsedRule
+    {
+        EventRule             m_rule;
+        std::vector<uint32_t> m_detail_columns;
+    };
+
+    // `events` are the events matching the conditions up to `node`, all events if null
+    void EvaluateNode(const EventQuery                   &query,
+                      uint32_t                            node,
+                      const std::vector<uint32_t>        *events,
+                      std::vector<std::vector<uint32_t>> *violations) const;
+
+    std::vector<ParsedRule> m_rules;
+    std::vector<Node>       m_nodes = { Node() };
+};
+
+}  // namespace Dive
@@ -22,6 +22,7 @@
 //
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
 #include <cstring>
 
 #include "event_state.h"
@@ -30,11 +31,13 @@ namespace Dive
 {
 
 template<>
-void EventStateInfoT<EventStateInfo_CONFIG>::Reserve(
+void EventStateInfoT<EventStateInfo_CONFIG>::Reallocate(
 typename EventStateInfo::Id::basic_type new_cap)
 {
-    if (new_cap <= m_cap)
-        return;
+    // With the chunks moved out, the contiguous buffer can be accessed as usual
+    auto old_cap = m_cap;
+    auto chunks = std::move(m_chunks);
+    m_chunks.clear();
 
     // Round up to next aligned capacity. The address of each field array is:
     //     `m_buffer + field_offset * cap`
@@ -117,171 +120,372 @@ typename EventStateInfo::Id::basic_type new_cap)
     m_cap = new_cap;
 
     // Copy all of the data from the old buffer to the new buffer
+    auto num_contiguous = std::min(m_size, old_cap);
     static_assert(std::is_trivially_copyable<uint32_t>::value,
                   "Field type must be trivially copyable");
-    memcpy(TopologyPtr(), old_topology_ptr, kTopologySize * m_size);
+    memcpy(TopologyPtr(), old_topology_ptr, kTopologySize * num_contiguous);
     static_assert(std::is_trivially_copyable<bool>::value, "Field type must be trivially copyable");
-    memcpy(PrimRestartEnabledPtr(), old_prim_restart_enabled_ptr, kPrimRestartEnabledSize * m_size);
+    memcpy(PrimRestartEnabledPtr(),
+           old_prim_restart_enabled_ptr,
+           kPrimRestartEnabledSize * num_contiguous);
     static_assert(std::is_trivially_copyable<uint32_t>::value,
                   "Field type must be trivially copyable");
-    memcpy(PatchControlPointsPtr(), old_patch_control_points_ptr, kPatchControlPointsSize * m_size);
+    memcpy(PatchControlPointsPtr(),
+           old_patch_control_points_ptr,
+           kPatchControlPointsSize * num_contiguous);
     static_assert(std::is_trivially_copyable<VkViewport>::value,
                   "Field type must be trivially copyable");
-    memcpy(ViewportPtr(), old_viewport_ptr, kViewportSize * m_size);
+    memcpy(ViewportPtr(), old_viewport_ptr, kViewportSize * num_contiguous);
     static_assert(std::is_trivially_copyable<VkRect2D>::value,
                   "Field type must be trivially copyable");
-    memcpy(ScissorPtr(), old_scissor_ptr, kScissorSize * m_size);
+    memcpy(ScissorPtr(), old_scissor_ptr, kScissorSize * num_contiguous);
     static_assert(std::is_trivially_copyable<bool>::value, "Field type must be trivially copyable");
-    memcpy(DepthClampEnabledPtr(), old_depth_clamp_enabled_ptr, kDepthClampEnabledSize * m_size);
+    memcpy(DepthClampEnabledPtr(),
+           old_depth_clamp_enabled_ptr,
+           kDepthClampEnabledSize * num_contiguous);
     static_assert(std::is_trivially_copyable<bool>::value, "Field type must be trivially copyable");
     memcpy(RasterizerDiscardEnabledPtr(),
            old_rasterizer_discard_enabled_ptr,
-           kRasterizerDiscardEnabledSize * m_size);
+           kRasterizerDiscardEnabledSize * num_contiguous);
     static_assert(std::is_trivially_copyable<VkPolygonMode>::value,
                   "Field type must be trivially copyable");
-    memcpy(PolygonModePtr(), old_polygon_mode_ptr, kPolygonModeSize * m_size);
+    memcpy(PolygonModePtr(), old_polygon_mode_ptr, kPolygonModeSize * num_contiguous);
     static_assert(std::is_trivially_copyable<VkCullModeFlags>::value,
                   "Field type must be trivially copyable");
-    memcpy(CullModePtr(), old_cull_mode_ptr, kCullModeSize * m_size);
+    memcpy(CullModePtr(), old_cull_mode_ptr, kCullModeSize * num_contiguous);
     static_assert(std::is_trivially_copyable<VkFrontFace>::value,
                   "Field type must be trivially copyable");
-    memcpy(FrontFacePtr(), old_front_face_ptr, kFrontFaceSize * m_size);
+    memcpy(FrontFacePtr(), old_front_face_ptr, kFrontFaceSize * num_contiguous);
     static_assert(std::is_trivially_copyable<bool>::value, "Field type must be trivially copyable");
-    memcpy(DepthBiasEnabledPtr(), old_depth_bias_enabled_ptr, kDepthBiasEnabledSize * m_size);
+    memcpy(DepthBiasEnabledPtr(),
+           old_depth_bias_enabled_ptr,
+           kDepthBiasEnabledSize * num_contiguous);
     static_assert(std::is_trivially_copyable<float>::value,
                   "Field type must be trivially copyable");
     memcpy(DepthBiasConstantFactorPtr(),
            old_depth_bias_constant_factor_ptr,
-           kDepthBiasConstantFactorSize * m_size);
+           kDepthBiasConstantFactorSize * num_contiguous);
     static_assert(std::is_trivially_copyable<float>::value,
                   "Field type must be trivially copyable");
-    memcpy(DepthBiasClampPtr(), old_depth_bias_clamp_ptr, kDepthBiasClampSize * m_size);
+    memcpy(DepthBiasClampPtr(), old_depth_bias_clamp_ptr, kDepthBiasClampSize * num_contiguous);
     static_assert(std::is_trivially_copyable<float>::value,
                   "Field type must be trivially copyable");
     memcpy(DepthBiasSlopeFactorPtr(),
            old_depth_bias_slope_factor_ptr,
-           kDepthBiasSlopeFactorSize * m_size);
+           kDepthBiasSlopeFactorSize * num_contiguous);
     static_assert(std::is_trivially_copyable<float>::value,
                   "Field type must be trivially copyable");
-    memcpy(LineWidthPtr(), old_line_width_ptr, kLineWidthSize * m_size);
+    memcpy(LineWidthPtr(), old_line_width_ptr, kLineWidthSize * num_contiguous);
     static_assert(std::is_trivially_copyable<VkSampleCountFlagBits>::value,
                   "Field type must be trivially copyable");
     memcpy(RasterizationSamplesPtr(),
            old_rasterization_samples_ptr,
-           kRasterizationSamplesSize * m_size);
+           kRasterizationSamplesSize * num_contiguous);
     static_assert(std::is_trivially_copyable<bool>::value, "Field type must be trivially copyable");
     memcpy(SampleShadingEnabledPtr(),
            old_sample_shading_enabled_ptr,
-           kSampleShadingEnabledSize * m_size);
+           kSampleShadingEnabledSize * num_contiguous);
     static_assert(std::is_trivially_copyable<float>::value,
                   "Field type must be trivially copyable");
-    memcpy(MinSampleShadingPtr(), old_min_sample_shading_ptr, kMinSampleShadingSize * m_size);
+    memcpy(MinSampleShadingPtr(),
+           old_min_sample_shading_ptr,
+           kMinSampleShadingSize * num_contiguous);
     static_assert(std::is_trivially_copyable<VkSampleMask>::value,
                   "Field type must be trivially copyable");
-    memcpy(SampleMaskPtr(), old_sample_mask_ptr, kSampleMaskSize * m_size);
+    memcpy(SampleMaskPtr(), old_sample_mask_ptr, kSampleMaskSize * num_contiguous);
     static_assert(std::is_trivially_copyable<bool>::value, "Field type must be trivially copyable");
     memcpy(AlphaToCoverageEnabledPtr(),
            old_alpha_to_coverage_enabled_ptr,
-           kAlphaToCoverageEnabledSize * m_size);
+           kAlphaToCoverageEnabledSize * num_contiguous);
     static_assert(std::is_trivially_copyable<bool>::value, "Field type must be trivially copyable");
-    memcpy(DepthTestEnabledPtr(), old_depth_test_enabled_ptr, kDepthTestEnabledSize * m_size);
+    memcpy(DepthTestEnabledPtr(),
+           old_depth_test_enabled_ptr,
+           kDepthTestEnabledSize * num_contiguous);
     static_assert(std::is_trivially_copyable<bool>::value, "Field type must be trivially copyable");
-    memcpy(DepthWriteEnabledPtr(), old_depth_write_enabled_ptr, kDepthWriteEnabledSize * m_size);
+    memcpy(DepthWriteEnabledPtr(),
+           old_depth_write_enabled_ptr,
+           kDepthWriteEnabledSize * num_contiguous);
     static_assert(std::is_trivially_copyable<VkCompareOp>::value,
                   "Field type must be trivially copyable");
-    memcpy(DepthCompareOpPtr(), old_depth_compare_op_ptr, kDepthCompareOpSize * m_size);
+    memcpy(DepthCompareOpPtr(), old_depth_compare_op_ptr, kDepthCompareOpSize * num_contiguous);
     static_assert(std::is_trivially_copyable<bool>::value, "Field type must be trivially copyable");
     memcpy(DepthBoundsTestEnabledPtr(),
            old_depth_bounds_test_enabled_ptr,
-           kDepthBoundsTestEnabledSize * m_size);
+           kDepthBoundsTestEnabledSize * num_contiguous);
     static_assert(std::is_trivially_copyable<float>::value,
                   "Field type must be trivially copyable");
-    memcpy(MinDepthBoundsPtr(), old_min_depth_bounds_ptr, kMinDepthBoundsSize * m_size);
+    memcpy(MinDepthBoundsPtr(), old_min_depth_bounds_ptr, kMinDepthBoundsSize * num_contiguous);
     static_assert(std::is_trivially_copyable<float>::value,
                   "Field type must be trivially copyable");
-    memcpy(MaxDepthBoundsPtr(), old_max_depth_bounds_ptr, kMaxDepthBoundsSize * m_size);
+    memcpy(MaxDepthBoundsPtr(), old_max_depth_bounds_ptr, kMaxDepthBoundsSize * num_contiguous);
     static_assert(std::is_trivially_copyable<bool>::value, "Field type must be trivially copyable");
-    memcpy(StencilTestEnabledPtr(), old_stencil_test_enabled_ptr, kStencilTestEnabledSize * m_size);
+    memcpy(StencilTestEnabledPtr(),
+           old_stencil_test_enabled_ptr,
+           kStencilTestEnabledSize * num_contiguous);
     static_assert(std::is_trivially_copyable<VkStencilOpState>::value,
                   "Field type must be trivially copyable");
     memcpy(StencilOpStateFrontPtr(),
            old_stencil_op_state_front_ptr,
-           kStencilOpStateFrontSize * m_size);
+           kStencilOpStateFrontSize * num_contiguous);
     static_assert(std::is_trivially_copyable<VkStencilOpState>::value,
                   "Field type must be trivially copyable");
     memcpy(StencilOpStateBackPtr(),
            old_stencil_op_state_back_ptr,
-           kStencilOpStateBackSize * m_size);
+           kStencilOpStateBackSize * num_contiguous);
     static_assert(std::is_trivially_copyable<bool>::value, "Field type must be trivially copyable");
-    memcpy(LogicOpEnabledPtr(), old_logic_op_enabled_ptr, kLogicOpEnabledSize * m_size);
+    memcpy(LogicOpEnabledPtr(), old_logic_op_enabled_ptr, kLogicOpEnabledSize * num_contiguous);
     static_assert(std::is_trivially_copyable<VkLogicOp>::value,
                   "Field type must be trivially copyable");
-    memcpy(LogicOpPtr(), old_logic_op_ptr, kLogicOpSize * m_size);
+    memcpy(LogicOpPtr(), old_logic_op_ptr, kLogicOpSize * num_contiguous);
     static_assert(std::is_trivially_copyable<VkPipelineColorBlendAttachmentState>::value,
                   "Field type must be trivially copyable");
-    memcpy(AttachmentPtr(), old_attachment_ptr, kAttachmentSize * m_size);
+    memcpy(AttachmentPtr(), old_attachment_ptr, kAttachmentSize * num_contiguous);
     static_assert(std::is_trivially_copyable<float>::value,
                   "Field type must be trivially copyable");
-    memcpy(BlendConstantPtr(), old_blend_constant_ptr, kBlendConstantSize * m_size);
+    memcpy(BlendConstantPtr(), old_blend_constant_ptr, kBlendConstantSize * num_contiguous);
     static_assert(std::is_trivially_copyable<bool>::value, "Field type must be trivially copyable");
-    memcpy(LRZEnabledPtr(), old_lrz_enabled_ptr, kLRZEnabledSize * m_size);
+    memcpy(LRZEnabledPtr(), old_lrz_enabled_ptr, kLRZEnabledSize * num_contiguous);
     static_assert(std::is_trivially_copyable<bool>::value, "Field type must be trivially copyable");
-    memcpy(LRZWritePtr(), old_lrz_write_ptr, kLRZWriteSize * m_size);
+    memcpy(LRZWritePtr(), old_lrz_write_ptr, kLRZWriteSize * num_contiguous);
     static_assert(std::is_trivially_copyable<a6xx_lrz_dir_status>::value,
                   "Field type must be trivially copyable");
-    memcpy(LRZDirStatusPtr(), old_lrz_dir_status_ptr, kLRZDirStatusSize * m_size);
+    memcpy(LRZDirStatusPtr(), old_lrz_dir_status_ptr, kLRZDirStatusSize * num_contiguous);
     static_assert(std::is_trivially_copyable<bool>::value, "Field type must be trivially copyable");
-    memcpy(LRZDirWritePtr(), old_lrz_dir_write_ptr, kLRZDirWriteSize * m_size);
+    memcpy(LRZDirWritePtr(), old_lrz_dir_write_ptr, kLRZDirWriteSize * num_contiguous);
     static_assert(std::is_trivially_copyable<a6xx_ztest_mode>::value,
                   "Field type must be trivially copyable");
-    memcpy(ZTestModePtr(), old_z_test_mode_ptr, kZTestModeSize * m_size);
+    memcpy(ZTestModePtr(), old_z_test_mode_ptr, kZTestModeSize * num_contiguous);
     static_assert(std::is_trivially_copyable<uint32_t>::value,
                   "Field type must be trivially copyable");
-    memcpy(BinWPtr(), old_bin_w_ptr, kBinWSize * m_size);
+    memcpy(BinWPtr(), old_bin_w_ptr, kBinWSize * num_contiguous);
     static_assert(std::is_trivially_copyable<uint32_t>::value,
                   "Field type must be trivially copyable");
-    memcpy(BinHPtr(), old_bin_h_ptr, kBinHSize * m_size);
+    memcpy(BinHPtr(), old_bin_h_ptr, kBinHSize * num_contiguous);
     static_assert(std::is_trivially_copyable<uint16_t>::value,
                   "Field type must be trivially copyable");
-    memcpy(WindowScissorTLXPtr(), old_window_scissor_tlx_ptr, kWindowScissorTLXSize * m_size);
+    memcpy(WindowScissorTLXPtr(),
+           old_window_scissor_tlx_ptr,
+           kWindowScissorTLXSize * num_contiguous);
     static_assert(std::is_trivially_copyable<uint16_t>::value,
                   "Field type must be trivially copyable");
-    memcpy(WindowScissorTLYPtr(), old_window_scissor_tly_ptr, kWindowScissorTLYSize * m_size);
+    memcpy(WindowScissorTLYPtr(),
+           old_window_scissor_tly_ptr,
+           kWindowScissorTLYSize * num_contiguous);
     static_assert(std::is_trivially_copyable<uint16_t>::value,
                   "Field type must be trivially copyable");
-    memcpy(WindowScissorBRXPtr(), old_window_scissor_brx_ptr, kWindowScissorBRXSize * m_size);
+    memcpy(WindowScissorBRXPtr(),
+           old_window_scissor_brx_ptr,
+           kWindowScissorBRXSize * num_contiguous);
     static_assert(std::is_trivially_copyable<uint16_t>::value,
                   "Field type must be trivially copyable");
-    memcpy(WindowScissorBRYPtr(), old_window_scissor_bry_ptr, kWindowScissorBRYSize * m_size);
+    memcpy(WindowScissorBRYPtr(),
+           old_window_scissor_bry_ptr,
+           kWindowScissorBRYSize * num_contiguous);
     static_assert(std::is_trivially_copyable<a6xx_render_mode>::value,
                   "Field type must be trivially copyable");
-    memcpy(RenderModePtr(), old_render_mode_ptr, kRenderModeSize * m_size);
+    memcpy(RenderModePtr(), old_render_mode_ptr, kRenderModeSize * num_contiguous);
     static_assert(std::is_trivially_copyable<a6xx_buffers_location>::value,
                   "Field type must be trivially copyable");
-    memcpy(BuffersLocationPtr(), old_buffers_location_ptr, kBuffersLocationSize * m_size);
+    memcpy(BuffersLocationPtr(), old_buffers_location_ptr, kBuffersLocationSize * num_contiguous);
     static_assert(std::is_trivially_copyable<a6xx_threadsize>::value,
                   "Field type must be trivially copyable");
-    memcpy(ThreadSizePtr(), old_thread_size_ptr, kThreadSizeSize * m_size);
+    memcpy(ThreadSizePtr(), old_thread_size_ptr, kThreadSizeSize * num_contiguous);
     static_assert(std::is_trivially_copyable<bool>::value, "Field type must be trivially copyable");
     memcpy(EnableAllHelperLanesPtr(),
            old_enable_all_helper_lanes_ptr,
-           kEnableAllHelperLanesSize * m_size);
+           kEnableAllHelperLanesSize * num_contiguous);
     static_assert(std::is_trivially_copyable<bool>::value, "Field type must be trivially copyable");
     memcpy(EnablePartialHelperLanesPtr(),
            old_enable_partial_helper_lanes_ptr,
-           kEnablePartialHelperLanesSize * m_size);
+           kEnablePartialHelperLanesSize * num_contiguous);
     static_assert(std::is_trivially_copyable<bool>::value, "Field type must be trivially copyable");
-    memcpy(UBWCEnabledPtr(), old_ubwc_enabled_ptr, kUBWCEnabledSize * m_size);
+    memcpy(UBWCEnabledPtr(), old_ubwc_enabled_ptr, kUBWCEnabledSize * num_contiguous);
     static_assert(std::is_trivially_copyable<bool>::value, "Field type must be trivially copyable");
     memcpy(UBWCLosslessEnabledPtr(),
            old_ubwc_lossless_enabled_ptr,
-           kUBWCLosslessEnabledSize * m_size);
+           kUBWCLosslessEnabledSize * num_contiguous);
     static_assert(std::is_trivially_copyable<bool>::value, "Field type must be trivially copyable");
-    memcpy(UBWCEnabledOnDSPtr(), old_ubwc_enabled_on_ds_ptr, kUBWCEnabledOnDSSize * m_size);
+    memcpy(UBWCEnabledOnDSPtr(), old_ubwc_enabled_on_ds_ptr, kUBWCEnabledOnDSSize * num_contiguous);
     static_assert(std::is_trivially_copyable<bool>::value, "Field type must be trivially copyable");
     memcpy(UBWCLosslessEnabledOnDSPtr(),
            old_ubwc_lossless_enabled_on_ds_ptr,
-           kUBWCLosslessEnabledOnDSSize * m_size);
+           kUBWCLosslessEnabledOnDSSize * num_contiguous);
+
+    // Then the data from each chunk, releasing the memory as soon as it has been copied
+    old_buffer.reset();
+    auto chunk_start = old_cap;
+    for (std::unique_ptr<std::max_align_t[]>& chunk_buffer : chunks)
+    {
+        if (chunk_start >= m_size)
+            break;
+        uint8_t* chunk = reinterpret_cast<uint8_t*>(chunk_buffer.get());
+        auto num_elements = std::min<typename Id::basic_type>(m_size - chunk_start, kChunkSize);
+        memcpy(TopologyPtr(Id(chunk_start)),
+               chunk + kTopologyOffset * kChunkSize,
+               kTopologySize * num_elements);
+        memcpy(PrimRestartEnabledPtr(Id(chunk_start)),
+               chunk + kPrimRestartEnabledOffset * kChunkSize,
+               kPrimRestartEnabledSize * num_elements);
+        memcpy(PatchControlPointsPtr(Id(chunk_start)),
+               chunk + kPatchControlPointsOffset * kChunkSize,
+               kPatchControlPointsSize * num_elements);
+        memcpy(ViewportPtr(Id(chunk_start)),
+               chunk + kViewportOffset * kChunkSize,
+               kViewportSize * num_elements);
+        memcpy(ScissorPtr(Id(chunk_start)),
+               chunk + kScissorOffset * kChunkSize,
+               kScissorSize * num_elements);
+        memcpy(DepthClampEnabledPtr(Id(chunk_start)),
+               chunk + kDepthClampEnabledOffset * kChunkSize,
+               kDepthClampEnabledSize * num_elements);
+        memcpy(RasterizerDiscardEnabledPtr(Id(chunk_start)),
+               chunk + kRasterizerDiscardEnabledOffset * kChunkSize,
+               kRasterizerDiscardEnabledSize * num_elements);
+        memcpy(PolygonModePtr(Id(chunk_start)),
+               chunk + kPolygonModeOffset * kChunkSize,
+               kPolygonModeSize * num_elements);
+        memcpy(CullModePtr(Id(chunk_start)),
+               chunk + kCullModeOffset * kChunkSize,
+               kCullModeSize * num_elements);
+        memcpy(FrontFacePtr(Id(chunk_start)),
+               chunk + kFrontFaceOffset * kChunkSize,
+               kFrontFaceSize * num_elements);
+        memcpy(DepthBiasEnabledPtr(Id(chunk_start)),
+               chunk + kDepthBiasEnabledOffset * kChunkSize,
+               kDepthBiasEnabledSize * num_elements);
+        memcpy(DepthBiasConstantFactorPtr(Id(chunk_start)),
+               chunk + kDepthBiasConstantFactorOffset * kChunkSize,
+               kDepthBiasConstantFactorSize * num_elements);
+        memcpy(DepthBiasClampPtr(Id(chunk_start)),
+               chunk + kDepthBiasClampOffset * kChunkSize,
+               kDepthBiasClampSize * num_elements);
+        memcpy(DepthBiasSlopeFactorPtr(Id(chunk_start)),
+               chunk + kDepthBiasSlopeFactorOffset * kChunkSize,
+               kDepthBiasSlopeFactorSize * num_elements);
+        memcpy(LineWidthPtr(Id(chunk_start)),
+               chunk + kLineWidthOffset * kChunkSize,
+               kLineWidthSize * num_elements);
+        memcpy(RasterizationSamplesPtr(Id(chunk_start)),
+               chunk + kRasterizationSamplesOffset * kChunkSize,
+               kRasterizationSamplesSize * num_elements);
+        memcpy(SampleShadingEnabledPtr(Id(chunk_start)),
+               chunk + kSampleShadingEnabledOffset * kChunkSize,
+               kSampleShadingEnabledSize * num_elements);
+        memcpy(MinSampleShadingPtr(Id(chunk_start)),
+               chunk + kMinSampleShadingOffset * kChunkSize,
+               kMinSampleShadingSize * num_elements);
+        memcpy(SampleMaskPtr(Id(chunk_start)),
+               chunk + kSampleMaskOffset * kChunkSize,
+               kSampleMaskSize * num_elements);
+        memcpy(AlphaToCoverageEnabledPtr(Id(chunk_start)),
+               chunk + kAlphaToCoverageEnabledOffset * kChunkSize,
+               kAlphaToCoverageEnabledSize * num_elements);
+        memcpy(DepthTestEnabledPtr(Id(chunk_start)),
+               chunk + kDepthTestEnabledOffset * kChunkSize,
+               kDepthTestEnabledSize * num_elements);
+        memcpy(DepthWriteEnabledPtr(Id(chunk_start)),
+               chunk + kDepthWriteEnabledOffset * kChunkSize,
+               kDepthWriteEnabledSize * num_elements);
+        memcpy(DepthCompareOpPtr(Id(chunk_start)),
+               chunk + kDepthCompareOpOffset * kChunkSize,
+               kDepthCompareOpSize * num_elements);
+        memcpy(DepthBoundsTestEnabledPtr(Id(chunk_start)),
+               chunk + kDepthBoundsTestEnabledOffset * kChunkSize,
+               kDepthBoundsTestEnabledSize * num_elements);
+        memcpy(MinDepthBoundsPtr(Id(chunk_start)),
+               chunk + kMinDepthBoundsOffset * kChunkSize,
+               kMinDepthBoundsSize * num_elements);
+        memcpy(MaxDepthBoundsPtr(Id(chunk_start)),
+               chunk + kMaxDepthBoundsOffset * kChunkSize,
+               kMaxDepthBoundsSize * num_elements);
+        memcpy(StencilTestEnabledPtr(Id(chunk_start)),
+               chunk + kStencilTestEnabledOffset * kChunkSize,
+               kStencilTestEnabledSize * num_elements);
+        memcpy(StencilOpStateFrontPtr(Id(chunk_start)),
+               chunk + kStencilOpStateFrontOffset * kChunkSize,
+               kStencilOpStateFrontSize * num_elements);
+        memcpy(StencilOpStateBackPtr(Id(chunk_start)),
+               chunk + kStencilOpStateBackOffset * kChunkSize,
+               kStencilOpStateBackSize * num_elements);
+        memcpy(LogicOpEnabledPtr(Id(chunk_start)),
+               chunk + kLogicOpEnabledOffset * kChunkSize,
+               kLogicOpEnabledSize * num_elements);
+        memcpy(LogicOpPtr(Id(chunk_start)),
+               chunk + kLogicOpOffset * kChunkSize,
+               kLogicOpSize * num_elements);
+        memcpy(AttachmentPtr(Id(chunk_start)),
+               chunk + kAttachmentOffset * kChunkSize,
+               kAttachmentSize * num_elements);
+        memcpy(BlendConstantPtr(Id(chunk_start)),
+               chunk + kBlendConstantOffset * kChunkSize,
+               kBlendConstantSize * num_elements);
+        memcpy(LRZEnabledPtr(Id(chunk_start)),
+               chunk + kLRZEnabledOffset * kChunkSize,
+               kLRZEnabledSize * num_elements);
+        memcpy(LRZWritePtr(Id(chunk_start)),
+               chunk + kLRZWriteOffset * kChunkSize,
+               kLRZWriteSize * num_elements);
+        memcpy(LRZDirStatusPtr(Id(chunk_start)),
+               chunk + kLRZDirStatusOffset * kChunkSize,
+               kLRZDirStatusSize * num_elements);
+        memcpy(LRZDirWritePtr(Id(chunk_start)),
+               chunk + kLRZDirWriteOffset * kChunkSize,
+               kLRZDirWriteSize * num_elements);
+        memcpy(ZTestModePtr(Id(chunk_start)),
+               chunk + kZTestModeOffset * kChunkSize,
+               kZTestModeSize * num_elements);
+        memcpy(BinWPtr(Id(chunk_start)),
+               chunk + kBinWOffset * kChunkSize,
+               kBinWSize * num_elements);
+        memcpy(BinHPtr(Id(chunk_start)),
+               chunk + kBinHOffset * kChunkSize,
+               kBinHSize * num_elements);
+        memcpy(WindowScissorTLXPtr(Id(chunk_start)),
+               chunk + kWindowScissorTLXOffset * kChunkSize,
+               kWindowScissorTLXSize * num_elements);
+        memcpy(WindowScissorTLYPtr(Id(chunk_start)),
+               chunk + kWindowScissorTLYOffset * kChunkSize,
+               kWindowScissorTLYSize * num_elements);
+        memcpy(WindowScissorBRXPtr(Id(chunk_start)),
+               chunk + kWindowScissorBRXOffset * kChunkSize,
+               kWindowScissorBRXSize * num_elements);
+        memcpy(WindowScissorBRYPtr(Id(chunk_start)),
+               chunk + kWindowScissorBRYOffset * kChunkSize,
+               kWindowScissorBRYSize * num_elements);
+        memcpy(RenderModePtr(Id(chunk_start)),
+               chunk + kRenderModeOffset * kChunkSize,
+               kRenderModeSize * num_elements);
+        memcpy(BuffersLocationPtr(Id(chunk_start)),
+               chunk + kBuffersLocationOffset * kChunkSize,
+               kBuffersLocationSize * num_elements);
+        memcpy(ThreadSizePtr(Id(chunk_start)),
+               chunk + kThreadSizeOffset * kChunkSize,
+               kThreadSizeSize * num_elements);
+        memcpy(EnableAllHelperLanesPtr(Id(chunk_start)),
+               chunk + kEnableAllHelperLanesOffset * kChunkSize,
+               kEnableAllHelperLanesSize * num_elements);
+        memcpy(EnablePartialHelperLanesPtr(Id(chunk_start)),
+               chunk + kEnablePartialHelperLanesOffset * kChunkSize,
+               kEnablePartialHelperLanesSize * num_elements);
+        memcpy(UBWCEnabledPtr(Id(chunk_start)),
+               chunk + kUBWCEnabledOffset * kChunkSize,
+               kUBWCEnabledSize * num_elements);
+        memcpy(UBWCLosslessEnabledPtr(Id(chunk_start)),
+               chunk + kUBWCLosslessEnabledOffset * kChunkSize,
+               kUBWCLosslessEnabledSize * num_elements);
+        memcpy(UBWCEnabledOnDSPtr(Id(chunk_start)),
+               chunk + kUBWCEnabledOnDSOffset * kChunkSize,
+               kUBWCEnabledOnDSSize * num_elements);
+        memcpy(UBWCLosslessEnabledOnDSPtr(Id(chunk_start)),
+               chunk + kUBWCLosslessEnabledOnDSOffset * kChunkSize,
+               kUBWCLosslessEnabledOnDSSize * num_elements);
+        // `chunk_start` is a multiple of 8, so the chunk's bits start on a byte boundary
+        memcpy(m_is_set_buffer.data() + (size_t(chunk_start) * kNumFields) / 8,
+               chunk + kChunkSize * kElemSize,
+               (size_t(num_elements) * kNumFields + 7) / 8);
+        chunk_buffer.reset();
+        chunk_start += kChunkSize;
+    }
 
     // Update the debug-only ponters to the arrays
 #ifndef NDEBUG
@@ -341,21 +545,45 @@ typename EventStateInfo::Id::basic_type new_cap)
 #endif
 }
 
+template<>
+void EventStateInfoT<EventStateInfo_CONFIG>::Reserve(
+typename EventStateInfo::Id::basic_type new_cap)
+{
+    if (new_cap <= capacity())
+        return;
+    Reallocate(new_cap);
+}
+
+template<> void EventStateInfoT<EventStateInfo_CONFIG>::Compact()
+{
+    if (m_chunks.empty())
+        return;
+    Reallocate(m_size);
+}
+
 template<> EventStateInfo::Iterator EventStateInfoT<EventStateInfo_CONFIG>::Add()
 {
-    if (m_size >= m_cap)
+    if (m_cap == 0)
     {
-        auto new_cap = m_cap > 0 ? m_cap * 2 : static_cast<typename Id::basic_type>(kAlignment);
-        if (new_cap <= m_cap)
+        // The first `kChunkSize` elements are contiguous, so that small SOAs never need
+        // `Compact()`
+        Reserve(kChunkSize);
+    }
+    else if (m_size >= capacity())
+    {
+        if (capacity() + kChunkSize < capacity())
         {
             // capacity has overflowed the `Id` type.
             DIVE_ASSERT(false);
             return end();
         }
-        else
-        {
-            Reserve(new_cap);
-        }
+        // Start a new chunk. Unlike growing the contiguous buffer, this neither copies the
+        // existing elements nor holds two copies of them in memory at once
+        size_t chunk_num_bytes = kChunkSize * kElemSize + (size_t(kChunkSize) * kNumFields) / 8;
+        size_t chunk_buffer_size = (chunk_num_bytes + sizeof(std::max_align_t) - 1) /
+                                   sizeof(std::max_align_t);
+        m_chunks.emplace_back(new std::max_align_t[chunk_buffer_size]);
+        memset(m_chunks.back().get(), 0, sizeof(std::max_align_t) * chunk_buffer_size);
     }
 
     new (TopologyPtr(Id(m_size))) uint32_t();
@@ -817,4 +1045,653 @@ void EventStateInfoRefT<EventStateInfo_CONFIG>::swap(const EventStateInfoRef &ot
     }
 }
 
+void EventStateInfoDelta::Encode(const EventStateInfo& soa, uint32_t keyframe_interval)
+{
+    Reset(EventStateInfo::kNumFields, soa.size(), keyframe_interval);
+    // Elements are read in place, so `soa` may still be chunked
+    auto value = [&soa](size_t field_offset, size_t field_size, size_t elem_offset) {
+        return [&soa, field_offset, field_size, elem_offset](uint32_t id) {
+            return soa.FieldData(Id(id), field_offset, field_size) + elem_offset;
+        };
+    };
+    auto is_set = [&soa](uint32_t slot) {
+        return [&soa, slot](uint32_t id) { return soa.IsFieldSet(Id(id), slot); };
+    };
+    EncodeSlot(EventStateInfo::kTopologyIndex,
+               value(EventStateInfo::kTopologyOffset, EventStateInfo::kTopologySize, 0),
+               sizeof(uint32_t),
+               is_set(EventStateInfo::kTopologyIndex));
+    EncodeSlot(EventStateInfo::kPrimRestartEnabledIndex,
+               value(EventStateInfo::kPrimRestartEnabledOffset,
+                     EventStateInfo::kPrimRestartEnabledSize,
+                     0),
+               sizeof(bool),
+               is_set(EventStateInfo::kPrimRestartEnabledIndex));
+    EncodeSlot(EventStateInfo::kPatchControlPointsIndex,
+               value(EventStateInfo::kPatchControlPointsOffset,
+                     EventStateInfo::kPatchControlPointsSize,
+                     0),
+               sizeof(uint32_t),
+               is_set(EventStateInfo::kPatchControlPointsIndex));
+    for (uint32_t i = 0; i < EventStateInfo::kViewportArrayCount; ++i)
+    {
+        uint32_t slot = EventStateInfo::kViewportIndex + i;
+        EncodeSlot(slot,
+                   value(EventStateInfo::kViewportOffset,
+                         EventStateInfo::kViewportSize,
+                         i * sizeof(VkViewport)),
+                   sizeof(VkViewport),
+                   is_set(slot));
+    }
+    for (uint32_t i = 0; i < EventStateInfo::kScissorArrayCount; ++i)
+    {
+        uint32_t slot = EventStateInfo::kScissorIndex + i;
+        EncodeSlot(slot,
+                   value(EventStateInfo::kScissorOffset,
+                         EventStateInfo::kScissorSize,
+                         i * sizeof(VkRect2D)),
+                   sizeof(VkRect2D),
+                   is_set(slot));
+    }
+    EncodeSlot(EventStateInfo::kDepthClampEnabledIndex,
+               value(EventStateInfo::kDepthClampEnabledOffset,
+                     EventStateInfo::kDepthClampEnabledSize,
+                     0),
+               sizeof(bool),
+               is_set(EventStateInfo::kDepthClampEnabledIndex));
+    EncodeSlot(EventStateInfo::kRasterizerDiscardEnabledIndex,
+               value(EventStateInfo::kRasterizerDiscardEnabledOffset,
+                     EventStateInfo::kRasterizerDiscardEnabledSize,
+                     0),
+               sizeof(bool),
+               is_set(EventStateInfo::kRasterizerDiscardEnabledIndex));
+    EncodeSlot(EventStateInfo::kPolygonModeIndex,
+               value(EventStateInfo::kPolygonModeOffset, EventStateInfo::kPolygonModeSize, 0),
+               sizeof(VkPolygonMode),
+               is_set(EventStateInfo::kPolygonModeIndex));
+    EncodeSlot(EventStateInfo::kCullModeIndex,
+               value(EventStateInfo::kCullModeOffset, EventStateInfo::kCullModeSize, 0),
+               sizeof(VkCullModeFlags),
+               is_set(EventStateInfo::kCullModeIndex));
+    EncodeSlot(EventStateInfo::kFrontFaceIndex,
+               value(EventStateInfo::kFrontFaceOffset, EventStateInfo::kFrontFaceSize, 0),
+               sizeof(VkFrontFace),
+               is_set(EventStateInfo::kFrontFaceIndex));
+    EncodeSlot(EventStateInfo::kDepthBiasEnabledIndex,
+               value(EventStateInfo::kDepthBiasEnabledOffset,
+                     EventStateInfo::kDepthBiasEnabledSize,
+                     0),
+               sizeof(bool),
+               is_set(EventStateInfo::kDepthBiasEnabledIndex));
+    EncodeSlot(EventStateInfo::kDepthBiasConstantFactorIndex,
+               value(EventStateInfo::kDepthBiasConstantFactorOffset,
+                     EventStateInfo::kDepthBiasConstantFactorSize,
+                     0),
+               sizeof(float),
+               is_set(EventStateInfo::kDepthBiasConstantFactorIndex));
+    EncodeSlot(EventStateInfo::kDepthBiasClampIndex,
+               value(EventStateInfo::kDepthBiasClampOffset, EventStateInfo::kDepthBiasClampSize, 0),
+               sizeof(float),
+               is_set(EventStateInfo::kDepthBiasClampIndex));
+    EncodeSlot(EventStateInfo::kDepthBiasSlopeFactorIndex,
+               value(EventStateInfo::kDepthBiasSlopeFactorOffset,
+                     EventStateInfo::kDepthBiasSlopeFactorSize,
+                     0),
+               sizeof(float),
+               is_set(EventStateInfo::kDepthBiasSlopeFactorIndex));
+    EncodeSlot(EventStateInfo::kLineWidthIndex,
+               value(EventStateInfo::kLineWidthOffset, EventStateInfo::kLineWidthSize, 0),
+               sizeof(float),
+               is_set(EventStateInfo::kLineWidthIndex));
+    EncodeSlot(EventStateInfo::kRasterizationSamplesIndex,
+               value(EventStateInfo::kRasterizationSamplesOffset,
+                     EventStateInfo::kRasterizationSamplesSize,
+                     0),
+               sizeof(VkSampleCountFlagBits),
+               is_set(EventStateInfo::kRasterizationSamplesIndex));
+    EncodeSlot(EventStateInfo::kSampleShadingEnabledIndex,
+               value(EventStateInfo::kSampleShadingEnabledOffset,
+                     EventStateInfo::kSampleShadingEnabledSize,
+                     0),
+               sizeof(bool),
+               is_set(EventStateInfo::kSampleShadingEnabledIndex));
+    EncodeSlot(EventStateInfo::kMinSampleShadingIndex,
+               value(EventStateInfo::kMinSampleShadingOffset,
+                     EventStateInfo::kMinSampleShadingSize,
+                     0),
+               sizeof(float),
+               is_set(EventStateInfo::kMinSampleShadingIndex));
+    EncodeSlot(EventStateInfo::kSampleMaskIndex,
+               value(EventStateInfo::kSampleMaskOffset, EventStateInfo::kSampleMaskSize, 0),
+               sizeof(VkSampleMask),
+               is_set(EventStateInfo::kSampleMaskIndex));
+    EncodeSlot(EventStateInfo::kAlphaToCoverageEnabledIndex,
+               value(EventStateInfo::kAlphaToCoverageEnabledOffset,
+                     EventStateInfo::kAlphaToCoverageEnabledSize,
+                     0),
+               sizeof(bool),
+               is_set(EventStateInfo::kAlphaToCoverageEnabledIndex));
+    EncodeSlot(EventStateInfo::kDepthTestEnabledIndex,
+               value(EventStateInfo::kDepthTestEnabledOffset,
+                     EventStateInfo::kDepthTestEnabledSize,
+                     0),
+               sizeof(bool),
+               is_set(EventStateInfo::kDepthTestEnabledIndex));
+    EncodeSlot(EventStateInfo::kDepthWriteEnabledIndex,
+               value(EventStateInfo::kDepthWriteEnabledOffset,
+                     EventStateInfo::kDepthWriteEnabledSize,
+                     0),
+               sizeof(bool),
+               is_set(EventStateInfo::kDepthWriteEnabledIndex));
+    EncodeSlot(EventStateInfo::kDepthCompareOpIndex,
+               value(EventStateInfo::kDepthCompareOpOffset, EventStateInfo::kDepthCompareOpSize, 0),
+               sizeof(VkCompareOp),
+               is_set(EventStateInfo::kDepthCompareOpIndex));
+    EncodeSlot(EventStateInfo::kDepthBoundsTestEnabledIndex,
+               value(EventStateInfo::kDepthBoundsTestEnabledOffset,
+                     EventStateInfo::kDepthBoundsTestEnabledSize,
+                     0),
+               sizeof(bool),
+               is_set(EventStateInfo::kDepthBoundsTestEnabledIndex));
+    EncodeSlot(EventStateInfo::kMinDepthBoundsIndex,
+               value(EventStateInfo::kMinDepthBoundsOffset, EventStateInfo::kMinDepthBoundsSize, 0),
+               sizeof(float),
+               is_set(EventStateInfo::kMinDepthBoundsIndex));
+    EncodeSlot(EventStateInfo::kMaxDepthBoundsIndex,
+               value(EventStateInfo::kMaxDepthBoundsOffset, EventStateInfo::kMaxDepthBoundsSize, 0),
+               sizeof(float),
+               is_set(EventStateInfo::kMaxDepthBoundsIndex));
+    EncodeSlot(EventStateInfo::kStencilTestEnabledIndex,
+               value(EventStateInfo::kStencilTestEnabledOffset,
+                     EventStateInfo::kStencilTestEnabledSize,
+                     0),
+               sizeof(bool),
+               is_set(EventStateInfo::kStencilTestEnabledIndex));
+    EncodeSlot(EventStateInfo::kStencilOpStateFrontIndex,
+               value(EventStateInfo::kStencilOpStateFrontOffset,
+                     EventStateInfo::kStencilOpStateFrontSize,
+                     0),
+               sizeof(VkStencilOpState),
+               is_set(EventStateInfo::kStencilOpStateFrontIndex));
+    EncodeSlot(EventStateInfo::kStencilOpStateBackIndex,
+               value(EventStateInfo::kStencilOpStateBackOffset,
+                     EventStateInfo::kStencilOpStateBackSize,
+                     0),
+               sizeof(VkStencilOpState),
+               is_set(EventStateInfo::kStencilOpStateBackIndex));
+    for (uint32_t i = 0; i < EventStateInfo::kLogicOpEnabledArrayCount; ++i)
+    {
+        uint32_t slot = EventStateInfo::kLogicOpEnabledIndex + i;
+        EncodeSlot(slot,
+                   value(EventStateInfo::kLogicOpEnabledOffset,
+                         EventStateInfo::kLogicOpEnabledSize,
+                         i * sizeof(bool)),
+                   sizeof(bool),
+                   is_set(slot));
+    }
+    for (uint32_t i = 0; i < EventStateInfo::kLogicOpArrayCount; ++i)
+    {
+        uint32_t slot = EventStateInfo::kLogicOpIndex + i;
+        EncodeSlot(slot,
+                   value(EventStateInfo::kLogicOpOffset,
+                         EventStateInfo::kLogicOpSize,
+                         i * sizeof(VkLogicOp)),
+                   sizeof(VkLogicOp),
+                   is_set(slot));
+    }
+    for (uint32_t i = 0; i < EventStateInfo::kAttachmentArrayCount; ++i)
+    {
+        uint32_t slot = EventStateInfo::kAttachmentIndex + i;
+        EncodeSlot(slot,
+                   value(EventStateInfo::kAttachmentOffset,
+                         EventStateInfo::kAttachmentSize,
+                         i * sizeof(VkPipelineColorBlendAttachmentState)),
+                   sizeof(VkPipelineColorBlendAttachmentState),
+                   is_set(slot));
+    }
+    for (uint32_t i = 0; i < EventStateInfo::kBlendConstantArrayCount; ++i)
+    {
+        uint32_t slot = EventStateInfo::kBlendConstantIndex + i;
+        EncodeSlot(slot,
+                   value(EventStateInfo::kBlendConstantOffset,
+                         EventStateInfo::kBlendConstantSize,
+                         i * sizeof(float)),
+                   sizeof(float),
+                   is_set(slot));
+    }
+    EncodeSlot(EventStateInfo::kLRZEnabledIndex,
+               value(EventStateInfo::kLRZEnabledOffset, EventStateInfo::kLRZEnabledSize, 0),
+               sizeof(bool),
+               is_set(EventStateInfo::kLRZEnabledIndex));
+    EncodeSlot(EventStateInfo::kLRZWriteIndex,
+               value(EventStateInfo::kLRZWriteOffset, EventStateInfo::kLRZWriteSize, 0),
+               sizeof(bool),
+               is_set(EventStateInfo::kLRZWriteIndex));
+    EncodeSlot(EventStateInfo::kLRZDirStatusIndex,
+               value(EventStateInfo::kLRZDirStatusOffset, EventStateInfo::kLRZDirStatusSize, 0),
+               sizeof(a6xx_lrz_dir_status),
+               is_set(EventStateInfo::kLRZDirStatusIndex));
+    EncodeSlot(EventStateInfo::kLRZDirWriteIndex,
+               value(EventStateInfo::kLRZDirWriteOffset, EventStateInfo::kLRZDirWriteSize, 0),
+               sizeof(bool),
+               is_set(EventStateInfo::kLRZDirWriteIndex));
+    EncodeSlot(EventStateInfo::kZTestModeIndex,
+               value(EventStateInfo::kZTestModeOffset, EventStateInfo::kZTestModeSize, 0),
+               sizeof(a6xx_ztest_mode),
+               is_set(EventStateInfo::kZTestModeIndex));
+    EncodeSlot(EventStateInfo::kBinWIndex,
+               value(EventStateInfo::kBinWOffset, EventStateInfo::kBinWSize, 0),
+               sizeof(uint32_t),
+               is_set(EventStateInfo::kBinWIndex));
+    EncodeSlot(EventStateInfo::kBinHIndex,
+               value(EventStateInfo::kBinHOffset, EventStateInfo::kBinHSize, 0),
+               sizeof(uint32_t),
+               is_set(EventStateInfo::kBinHIndex));
+    EncodeSlot(EventStateInfo::kWindowScissorTLXIndex,
+               value(EventStateInfo::kWindowScissorTLXOffset,
+                     EventStateInfo::kWindowScissorTLXSize,
+                     0),
+               sizeof(uint16_t),
+               is_set(EventStateInfo::kWindowScissorTLXIndex));
+    EncodeSlot(EventStateInfo::kWindowScissorTLYIndex,
+               value(EventStateInfo::kWindowScissorTLYOffset,
+                     EventStateInfo::kWindowScissorTLYSize,
+                     0),
+               sizeof(uint16_t),
+               is_set(EventStateInfo::kWindowScissorTLYIndex));
+    EncodeSlot(EventStateInfo::kWindowScissorBRXIndex,
+               value(EventStateInfo::kWindowScissorBRXOffset,
+                     EventStateInfo::kWindowScissorBRXSize,
+                     0),
+               sizeof(uint16_t),
+               is_set(EventStateInfo::kWindowScissorBRXIndex));
+    EncodeSlot(EventStateInfo::kWindowScissorBRYIndex,
+               value(EventStateInfo::kWindowScissorBRYOffset,
+                     EventStateInfo::kWindowScissorBRYSize,
+                     0),
+               sizeof(uint16_t),
+               is_set(EventStateInfo::kWindowScissorBRYIndex));
+    EncodeSlot(EventStateInfo::kRenderModeIndex,
+               value(EventStateInfo::kRenderModeOffset, EventStateInfo::kRenderModeSize, 0),
+               sizeof(a6xx_render_mode),
+               is_set(EventStateInfo::kRenderModeIndex));
+    EncodeSlot(EventStateInfo::kBuffersLocationIndex,
+               value(EventStateInfo::kBuffersLocationOffset,
+                     EventStateInfo::kBuffersLocationSize,
+                     0),
+               sizeof(a6xx_buffers_location),
+               is_set(EventStateInfo::kBuffersLocationIndex));
+    EncodeSlot(EventStateInfo::kThreadSizeIndex,
+               value(EventStateInfo::kThreadSizeOffset, EventStateInfo::kThreadSizeSize, 0),
+               sizeof(a6xx_threadsize),
+               is_set(EventStateInfo::kThreadSizeIndex));
+    EncodeSlot(EventStateInfo::kEnableAllHelperLanesIndex,
+               value(EventStateInfo::kEnableAllHelperLanesOffset,
+                     EventStateInfo::kEnableAllHelperLanesSize,
+                     0),
+               sizeof(bool),
+               is_set(EventStateInfo::kEnableAllHelperLanesIndex));
+    EncodeSlot(EventStateInfo::kEnablePartialHelperLanesIndex,
+               value(EventStateInfo::kEnablePartialHelperLanesOffset,
+                     EventStateInfo::kEnablePartialHelperLanesSize,
+                     0),
+               sizeof(bool),
+               is_set(EventStateInfo::kEnablePartialHelperLanesIndex));
+    for (uint32_t i = 0; i < EventStateInfo::kUBWCEnabledArrayCount; ++i)
+    {
+        uint32_t slot = EventStateInfo::kUBWCEnabledIndex + i;
+        EncodeSlot(slot,
+                   value(EventStateInfo::kUBWCEnabledOffset,
+                         EventStateInfo::kUBWCEnabledSize,
+                         i * sizeof(bool)),
+                   sizeof(bool),
+                   is_set(slot));
+    }
+    for (uint32_t i = 0; i < EventStateInfo::kUBWCLosslessEnabledArrayCount; ++i)
+    {
+        uint32_t slot = EventStateInfo::kUBWCLosslessEnabledIndex + i;
+        EncodeSlot(slot,
+                   value(EventStateInfo::kUBWCLosslessEnabledOffset,
+                         EventStateInfo::kUBWCLosslessEnabledSize,
+                         i * sizeof(bool)),
+                   sizeof(bool),
+                   is_set(slot));
+    }
+    EncodeSlot(EventStateInfo::kUBWCEnabledOnDSIndex,
+               value(EventStateInfo::kUBWCEnabledOnDSOffset,
+                     EventStateInfo::kUBWCEnabledOnDSSize,
+                     0),
+               sizeof(bool),
+               is_set(EventStateInfo::kUBWCEnabledOnDSIndex));
+    EncodeSlot(EventStateInfo::kUBWCLosslessEnabledOnDSIndex,
+               value(EventStateInfo::kUBWCLosslessEnabledOnDSOffset,
+                     EventStateInfo::kUBWCLosslessEnabledOnDSSize,
+                     0),
+               sizeof(bool),
+               is_set(EventStateInfo::kUBWCLosslessEnabledOnDSIndex));
+}
+
+void EventStateInfoDelta::Decode(EventStateInfo* soa) const
+{
+    DecodeElements(nullptr, soa);
+}
+
+void EventStateInfoDelta::Decode(const std::vector<uint32_t>& ids, EventStateInfo* soa) const
+{
+    DecodeElements(&ids, soa);
+}
+
+void EventStateInfoDelta::DecodeElements(const std::vector<uint32_t>* ids,
+                                         EventStateInfo*              soa) const
+{
+    uint32_t count = (ids != nullptr) ? static_cast<uint32_t>(ids->size()) : size();
+    soa->Clear();
+    soa->Reserve(count);
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        DIVE_ASSERT(ids == nullptr || (*ids)[i] < size());
+        soa->Add();
+    }
+    auto mark_set = [soa](uint32_t slot) {
+        return [soa, slot](uint32_t id) { soa->MarkFieldSet(Id(id), slot); };
+    };
+    DecodeSlot(EventStateInfo::kTopologyIndex,
+               ids,
+               reinterpret_cast<uint8_t*>(soa->TopologyPtr()),
+               EventStateInfo::kTopologySize,
+               mark_set(EventStateInfo::kTopologyIndex));
+    DecodeSlot(EventStateInfo::kPrimRestartEnabledIndex,
+               ids,
+               reinterpret_cast<uint8_t*>(soa->PrimRestartEnabledPtr()),
+               EventStateInfo::kPrimRestartEnabledSize,
+               mark_set(EventStateInfo::kPrimRestartEnabledIndex));
+    DecodeSlot(EventStateInfo::kPatchControlPointsIndex,
+               ids,
+               reinterpret_cast<uint8_t*>(soa->PatchControlPointsPtr()),
+               EventStateInfo::kPatchControlPointsSize,
+               mark_set(EventStateInfo::kPatchControlPointsIndex));
+    for (uint32_t i = 0; i < EventStateInfo::kViewportArrayCount; ++i)
+    {
+        uint32_t slot = EventStateInfo::kViewportIndex + i;
+        DecodeSlot(slot,
+                   ids,
+                   reinterpret_cast<uint8_t*>(soa->ViewportPtr() + i),
+                   EventStateInfo::kViewportSize,
+                   mark_set(slot));
+    }
+    for (uint32_t i = 0; i < EventStateInfo::kScissorArrayCount; ++i)
+    {
+        uint32_t slot = EventStateInfo::kScissorIndex + i;
+        DecodeSlot(slot,
+                   ids,
+                   reinterpret_cast<uint8_t*>(soa->ScissorPtr() + i),
+                   EventStateInfo::kScissorSize,
+                   mark_set(slot));
+    }
+    DecodeSlot(EventStateInfo::kDepthClampEnabledIndex,
+               ids,
+               reinterpret_cast<uint8_t*>(soa->DepthClampEnabledPtr()),
+               EventStateInfo::kDepthClampEnabledSize,
+               mark_set(EventStateInfo::kDepthClampEnabledIndex));
+    DecodeSlot(EventStateInfo::kRasterizerDiscardEnabledIndex,
+               ids,
+               reinterpret_cast<uint8_t*>(soa->RasterizerDiscardEnabledPtr()),
+               EventStateInfo::kRasterizerDiscardEnabledSize,
+               mark_set(EventStateInfo::kRasterizerDiscardEnabledIndex));
+    DecodeSlot(EventStateInfo::kPolygonModeIndex,
+               ids,
+               reinterpret_cast<uint8_t*>(soa->PolygonModePtr()),
+               EventStateInfo::kPolygonModeSize,
+               mark_set(EventStateInfo::kPolygonModeIndex));
+    DecodeSlot(EventStateInfo::kCullModeIndex,
+               ids,
+               reinterpret_cast<uint8_t*>(soa->CullModePtr()),
+               EventStateInfo::kCullModeSize,
+               mark_set(EventStateInfo::kCullModeIndex));
+    DecodeSlot(EventStateInfo::kFrontFaceIndex,
+               ids,
+               reinterpret_cast<uint8_t*>(soa->FrontFacePtr()),
+               EventStateInfo::kFrontFaceSize,
+               mark_set(EventStateInfo::kFrontFaceIndex));
+    DecodeSlot(EventStateInfo::kDepthBiasEnabledIndex,
+               ids,
+               reinterpret_cast<uint8_t*>(soa->DepthBiasEnabledPtr()),
+               EventStateInfo::kDepthBiasEnabledSize,
+               mark_set(EventStateInfo::kDepthBiasEnabledIndex));
+    DecodeSlot(EventStateInfo::kDepthBiasConstantFactorIndex,
+               ids,
+               reinterpret_cast<uint8_t*>(soa->DepthBiasConstantFactorPtr()),
+               EventStateInfo::kDepthBiasConstantFactorSize,
+               mark_set(EventStateInfo::kDepthBiasConstantFactorIndex));
+    DecodeSlot(EventStateInfo::kDepthBiasClampIndex,
+               ids,
+               reinterpret_cast<uint8_t*>(soa->DepthBiasClampPtr()),
+               EventStateInfo::kDepthBiasClampSize,
+               mark_set(EventStateInfo::kDepthBiasClampIndex));
+    DecodeSlot(EventStateInfo::kDepthBiasSlopeFactorIndex,
+               ids,
+               reinterpret_cast<uint8_t*>(soa->DepthBiasSlopeFactorPtr()),
+               EventStateInfo::kDepthBiasSlopeFactorSize,
+               mark_set(EventStateInfo::kDepthBiasSlopeFactorIndex));
+    DecodeSlot(EventStateInfo::kLineWidthIndex,
+               ids,
+               reinterpret_cast<uint8_t*>(soa->LineWidthPtr()),
+               EventStateInfo::kLineWidthSize,
+               mark_set(EventStateInfo::kLineWidthIndex));
+    DecodeSlot(EventStateInfo::kRasterizationSamplesIndex,
+               ids,
+               reinterpret_cast<uint8_t*>(soa->RasterizationSamplesPtr()),
+               EventStateInfo::kRasterizationSamplesSize,
+               mark_set(EventStateInfo::kRasterizationSamplesIndex));
+    DecodeSlot(EventStateInfo::kSampleShadingEnabledIndex,
+               ids,
+               reinterpret_cast<uint8_t*>(soa->SampleShadingEnabledPtr()),
+               EventStateInfo::kSampleShadingEnabledSize,
+               mark_set(EventStateInfo::kSampleShadingEnabledIndex));
+    DecodeSlot(EventStateInfo::kMinSampleShadingIndex,
+               ids,
+               reinterpret_cast<uint8_t*>(soa->MinSampleShadingPtr()),
+               EventStateInfo::kMinSampleShadingSize,
+               mark_set(EventStateInfo::kMinSampleShadingIndex));
+    DecodeSlot(EventStateInfo::kSampleMaskIndex,
+               ids,
+               reinterpret_cast<uint8_t*>(soa->SampleMaskPtr()),
+               EventStateInfo::kSampleMaskSize,
+               mark_set(EventStateInfo::kSampleMaskIndex));
+    DecodeSlot(EventStateInfo::kAlphaToCoverageEnabledIndex,
+               ids,
+               reinterpret_cast<uint8_t*>(soa->AlphaToCoverageEnabledPtr()),
+               EventStateInfo::kAlphaToCoverageEnabledSize,
+               mark_set(EventStateInfo::kAlphaToCoverageEnabledIndex));
+    DecodeSlot(EventStateInfo::kDepthTestEnabledIndex,
+               ids,
+               reinterpret_cast<uint8_t*>(soa->DepthTestEnabledPtr()),
+               EventStateInfo::kDepthTestEnabledSize,
+               mark_set(EventStateInfo::kDepthTestEnabledIndex));
+    DecodeSlot(EventStateInfo::kDepthWriteEnabledIndex,
+               ids,
+               reinterpret_cast<uint8_t*>(soa->DepthWriteEnabledPtr()),
+               EventStateInfo::kDepthWriteEnabledSize,
+               mark_set(EventStateInfo::kDepthWriteEnabledIndex));
+    DecodeSlot(EventStateInfo::kDepthCompareOpIndex,
+               ids,
+               reinterpret_cast<uint8_t*>(soa->DepthCompareOpPtr()),
+               EventStateInfo::kDepthCompareOpSize,
+               mark_set(EventStateInfo::kDepthCompareOpIndex));
+    DecodeSlot(EventStateInfo::kDepthBoundsTestEnabledIndex,
+               ids,
+               reinterpret_cast<uint8_t*>(soa->DepthBoundsTestEnabledPtr()),
+               EventStateInfo::kDepthBoundsTestEnabledSize,
+               mark_set(EventStateInfo::kDepthBoundsTestEnabledIndex));
+    DecodeSlot(EventStateInfo::kMinDepthBoundsIndex,
+               ids,
+               reinterpret_cast<uint8_t*>(soa->MinDepthBoundsPtr()),
+               EventStateInfo::kMinDepthBoundsSize,
+               mark_set(EventStateInfo::kMinDepthBoundsIndex));
+    DecodeSlot(EventStateInfo::kMaxDepthBoundsIndex,
+               ids,
+               reinterpret_cast<uint8_t*>(soa->MaxDepthBoundsPtr()),
+               EventStateInfo::kMaxDepthBoundsSize,
+               mark_set(EventStateInfo::kMaxDepthBoundsIndex));
+    DecodeSlot(EventStateInfo::kStencilTestEnabledIndex,
+               ids,
+               reinterpret_cast<uint8_t*>(soa->StencilTestEnabledPtr()),
+               EventStateInfo::kStencilTestEnabledSize,
+               mark_set(EventStateInfo::kStencilTestEnabledIndex));
+    DecodeSlot(EventStateInfo::kStencilOpStateFrontIndex,
+               ids,
+               reinterpret_cast<uint8_t*>(soa->StencilOpStateFrontPtr()),
+               EventStateInfo::kStencilOpStateFrontSize,
+               mark_set(EventStateInfo::kStencilOpStateFrontIndex));
+    DecodeSlot(EventStateInfo::kStencilOpStateBackIndex,
+               ids,
+               reinterpret_cast<uint8_t*>(soa->StencilOpStateBackPtr()),
+               EventStateInfo::kStencilOpStateBackSize,
+               mark_set(EventStateInfo::kStencilOpStateBackIndex));
+    for (uint32_t i = 0; i < EventStateInfo::kLogicOpEnabledArrayCount; ++i)
+    {
+        uint32_t slot = EventStateInfo::kLogicOpEnabledIndex + i;
+        DecodeSlot(slot,
+                   ids,
+                   reinterpret_cast<uint8_t*>(soa->LogicOpEnabledPtr() + i),
+                   EventStateInfo::kLogicOpEnabledSize,
+                   mark_set(slot));
+    }
+    for (uint32_t i = 0; i < EventStateInfo::kLogicOpArrayCount; ++i)
+    {
+        uint32_t slot = EventStateInfo::kLogicOpIndex + i;
+        DecodeSlot(slot,
+                   ids,
+                   reinterpret_cast<uint8_t*>(soa->LogicOpPtr() + i),
+                   EventStateInfo::kLogicOpSize,
+                   mark_set(slot));
+    }
+    for (uint32_t i = 0; i < EventStateInfo::kAttachmentArrayCount; ++i)
+    {
+        uint32_t slot = EventStateInfo::kAttachmentIndex + i;
+        DecodeSlot(slot,
+                   ids,
+                   reinterpret_cast<uint8_t*>(soa->AttachmentPtr() + i),
+                   EventStateInfo::kAttachmentSize,
+                   mark_set(slot));
+    }
+    for (uint32_t i = 0; i < EventStateInfo::kBlendConstantArrayCount; ++i)
+    {
+        uint32_t slot = EventStateInfo::kBlendConstantIndex + i;
+        DecodeSlot(slot,
+                   ids,
+                   reinterpret_cast<uint8_t*>(soa->BlendConstantPtr() + i),
+                   EventStateInfo::kBlendConstantSize,
+                   mark_set(slot));
+    }
+    DecodeSlot(EventStateInfo::kLRZEnabledIndex,
+               ids,
+               reinterpret_cast<uint8_t*>(soa->LRZEnabledPtr()),
+               EventStateInfo::kLRZEnabledSize,
+               mark_set(EventStateInfo::kLRZEnabledIndex));
+    DecodeSlot(EventStateInfo::kLRZWriteIndex,
+               ids,
+               reinterpret_cast<uint8_t*>(soa->LRZWritePtr()),
+               EventStateInfo::kLRZWriteSize,
+               mark_set(EventStateInfo::kLRZWriteIndex));
+    DecodeSlot(EventStateInfo::kLRZDirStatusIndex,
+               ids,
+               reinterpret_cast<uint8_t*>(soa->LRZDirStatusPtr()),
+               EventStateInfo::kLRZDirStatusSize,
+               mark_set(EventStateInfo::kLRZDirStatusIndex));
+    DecodeSlot(EventStateInfo::kLRZDirWriteIndex,
+               ids,
+               reinterpret_cast<uint8_t*>(soa->LRZDirWritePtr()),
+               EventStateInfo::kLRZDirWriteSize,
+               mark_set(EventStateInfo::kLRZDirWriteIndex));
+    DecodeSlot(EventStateInfo::kZTestModeIndex,
+               ids,
+               reinterpret_cast<uint8_t*>(soa->ZTestModePtr()),
+               EventStateInfo::kZTestModeSize,
+               mark_set(EventStateInfo::kZTestModeIndex));
+    DecodeSlot(EventStateInfo::kBinWIndex,
+               ids,
+               reinterpret_cast<uint8_t*>(soa->BinWPtr()),
+               EventStateInfo::kBinWSize,
+               mark_set(EventStateInfo::kBinWIndex));
+    DecodeSlot(EventStateInfo::kBinHIndex,
+               ids,
+               reinterpret_cast<uint8_t*>(soa->BinHPtr()),
+               EventStateInfo::kBinHSize,
+               mark_set(EventStateInfo::kBinHIndex));
+    DecodeSlot(EventStateInfo::kWindowScissorTLXIndex,
+               ids,
+               reinterpret_cast<uint8_t*>(soa->WindowScissorTLXPtr()),
+               EventStateInfo::kWindowScissorTLXSize,
+               mark_set(EventStateInfo::kWindowScissorTLXIndex));
+    DecodeSlot(EventStateInfo::kWindowScissorTLYIndex,
+               ids,
+               reinterpret_cast<uint8_t*>(soa->WindowScissorTLYPtr()),
+               EventStateInfo::kWindowScissorTLYSize,
+               mark_set(EventStateInfo::kWindowScissorTLYIndex));
+    DecodeSlot(EventStateInfo::kWindowScissorBRXIndex,
+               ids,
+               reinterpret_cast<uint8_t*>(soa->WindowScissorBRXPtr()),
+               EventStateInfo::kWindowScissorBRXSize,
+               mark_set(EventStateInfo::kWindowScissorBRXIndex));
+    DecodeSlot(EventStateInfo::kWindowScissorBRYIndex,
+               ids,
+               reinterpret_cast<uint8_t*>(soa->WindowScissorBRYPtr()),
+               EventStateInfo::kWindowScissorBRYSize,
+               mark_set(EventStateInfo::kWindowScissorBRYIndex));
+    DecodeSlot(EventStateInfo::kRenderModeIndex,
+               ids,
+               reinterpret_cast<uint8_t*>(soa->RenderModePtr()),
+               EventStateInfo::kRenderModeSize,
+               mark_set(EventStateInfo::kRenderModeIndex));
+    DecodeSlot(EventStateInfo::kBuffersLocationIndex,
+               ids,
+               reinterpret_cast<uint8_t*>(soa->BuffersLocationPtr()),
+               EventStateInfo::kBuffersLocationSize,
+               mark_set(EventStateInfo::kBuffersLocationIndex));
+    DecodeSlot(EventStateInfo::kThreadSizeIndex,
+               ids,
+               reinterpret_cast<uint8_t*>(soa->ThreadSizePtr()),
+               EventStateInfo::kThreadSizeSize,
+               mark_set(EventStateInfo::kThreadSizeIndex));
+    DecodeSlot(EventStateInfo::kEnableAllHelperLanesIndex,
+               ids,
+               reinterpret_cast<uint8_t*>(soa->EnableAllHelperLanesPtr()),
+               EventStateInfo::kEnableAllHelperLanesSize,
+               mark_set(EventStateInfo::kEnableAllHelperLanesIndex));
+    DecodeSlot(EventStateInfo::kEnablePartialHelperLanesIndex,
+               ids,
+               reinterpret_cast<uint8_t*>(soa->EnablePartialHelperLanesPtr()),
+               EventStateInfo::kEnablePartialHelperLanesSize,
+               mark_set(EventStateInfo::kEnablePartialHelperLanesIndex));
+    for (uint32_t i = 0; i < EventStateInfo::kUBWCEnabledArrayCount; ++i)
+    {
+        uint32_t slot = EventStateInfo::kUBWCEnabledIndex + i;
+        DecodeSlot(slot,
+                   ids,
+                   reinterpret_cast<uint8_t*>(soa->UBWCEnabledPtr() + i),
+                   EventStateInfo::kUBWCEnabledSize,
+                   mark_set(slot));
+    }
+    for (uint32_t i = 0; i < EventStateInfo::kUBWCLosslessEnabledArrayCount; ++i)
+    {
+        uint32_t slot = EventStateInfo::kUBWCLosslessEnabledIndex + i;
+        DecodeSlot(slot,
+                   ids,
+                   reinterpret_cast<uint8_t*>(soa->UBWCLosslessEnabledPtr() + i),
+                   EventStateInfo::kUBWCLosslessEnabledSize,
+                   mark_set(slot));
+    }
+    DecodeSlot(EventStateInfo::kUBWCEnabledOnDSIndex,
+               ids,
+               reinterpret_cast<uint8_t*>(soa->UBWCEnabledOnDSPtr()),
+               EventStateInfo::kUBWCEnabledOnDSSize,
+               mark_set(EventStateInfo::kUBWCEnabledOnDSIndex));
+    DecodeSlot(EventStateInfo::kUBWCLosslessEnabledOnDSIndex,
+               ids,
+               reinterpret_cast<uint8_t*>(soa->UBWCLosslessEnabledOnDSPtr()),
+               EventStateInfo::kUBWCLosslessEnabledOnDSSize,
+               mark_set(EventStateInfo::kUBWCLosslessEnabledOnDSIndex));
+}
+
 }  // namespace Dive
@@ -4740,8 +4740,11 @@ public:
 
     inline bool empty() const { return m_size == 0; }
 
-    // `capacity()` returns the maximum number of elements before re-allocating
-    inline typename Id::basic_type capacity() const { return m_cap; }
+    // `capacity()` returns the number of elements that fit in the allocated memory
+    inline typename Id::basic_type capacity() const
+    {
+        return m_cap + static_cast<typename Id::basic_type>(m_chunks.size()) * kChunkSize;
+    }
 
     // `IsValidId` reports whether `id` identifies a valid element
     inline bool IsValidId(Id id) const { return static_cast<typename Id::basic_type>(id) < size(); }
@@ -4749,34 +4752,45 @@ public:
     // 'MarkFieldSet()' marks whether a particular field was set with a value
     inline void MarkFieldSet(Id id, uint32_t field_index)
     {
-        uint32_t bit = static_cast<typename Id::basic_type>(id) * kNumFields + field_index;
-        m_is_set_buffer[bit / 8] |= (1 << (bit % 8));
+        uint32_t bit;
+        uint8_t* bits = const_cast<uint8_t*>(GetIsSetBits(id, field_index, &bit));
+        bits[bit / 8] |= (1 << (bit % 8));
     }
 
     // 'IsFieldSet()' indicates whether a given field was set
     inline bool IsFieldSet(Id id, uint32_t field_index) const
     {
-        uint32_t bit = static_cast<typename Id::basic_type>(id) * kNumFields + field_index;
-        return (m_is_set_buffer[bit / 8] & (1 << (bit % 8))) != 0;
+        uint32_t       bit;
+        const uint8_t* bits = GetIsSetBits(id, field_index, &bit);
+        return (bits[bit / 8] & (1 << (bit % 8))) != 0;
     }
 
     //-----------------------------------------------
     // FIELD Topology: The primitive topology for this event
 
     // `TopologyPtr()` returns a shared pointer to an array of `size()` elements
+    // Requires contiguous storage, see `Compact()`
     inline const uint32_t* TopologyPtr() const
     {
+        DIVE_ASSERT(m_chunks.empty());
         return reinterpret_cast<uint32_t*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                            kTopologyOffset * m_cap);
     }
     inline uint32_t* TopologyPtr()
     {
+        DIVE_ASSERT(m_chunks.empty());
         return reinterpret_cast<uint32_t*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                            kTopologyOffset * m_cap);
     }
     // `TopologyPtr()` returns a shared pointer to an array of `size()` elements
     inline const uint32_t* TopologyPtr(Id id) const
     {
+        if (static_cast<typename Id::basic_type>(id) >= m_cap)
+        {
+            typename Id::basic_type index;
+            uint8_t*                chunk = GetChunk(id, &index);
+            return reinterpret_cast<uint32_t*>(chunk + kTopologyOffset * kChunkSize) + index;
+        }
         return reinterpret_cast<uint32_t*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                            kTopologyOffset * m_cap) +
                static_cast<typename Id::basic_type>(id)
@@ -4785,12 +4799,31 @@ public:
     }
     inline uint32_t* TopologyPtr(Id id)
     {
+        if (static_cast<typename Id::basic_type>(id) >= m_cap)
+        {
+            typename Id::basic_type index;
+            uint8_t*                chunk = GetChunk(id, &index);
+            return reinterpret_cast<uint32_t*>(chunk + kTopologyOffset * kChunkSize) + index;
+        }
         return reinterpret_cast<uint32_t*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                            kTopologyOffset * m_cap) +
                static_cast<typename Id::basic_type>(id)
 
         ;
     }
+    // `TopologyColumn()` returns a read-only view of the `Topology` array
+    inline StructOfArraysColumn<uint32_t> TopologyColumn() const
+    {
+        DIVE_ASSERT(m_chunks.empty());
+        const uint32_t* data = TopologyPtr();
+        uint32_t        stride = 1;
+        return StructOfArraysColumn<uint32_t>(data,
+                                              m_size,
+                                              stride,
+                                              m_is_set_buffer.data(),
+                                              kNumFields,
+                                              kTopologyIndex);
+    }
     // `Topology(id)` retuns the `Topology` element of the object identified by `id`
     inline VkPrimitiveTopology Topology(Id id) const
     {
@@ -4825,19 +4858,28 @@ public:
     // restarting the assembly of primitives
 
     // `PrimRestartEnabledPtr()` returns a shared pointer to an array of `size()` elements
+    // Requires contiguous storage, see `Compact()`
     inline const bool* PrimRestartEnabledPtr() const
     {
+        DIVE_ASSERT(m_chunks.empty());
         return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                        kPrimRestartEnabledOffset * m_cap);
     }
     inline bool* PrimRestartEnabledPtr()
     {
+        DIVE_ASSERT(m_chunks.empty());
         return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                        kPrimRestartEnabledOffset * m_cap);
     }
     // `PrimRestartEnabledPtr()` returns a shared pointer to an array of `size()` elements
     inline const bool* PrimRestartEnabledPtr(Id id) const
     {
+        if (static_cast<typename Id::basic_type>(id) >= m_cap)
+        {
+            typename Id::basic_type index;
+            uint8_t*                chunk = GetChunk(id, &index);
+            return reinterpret_cast<bool*>(chunk + kPrimRestartEnabledOffset * kChunkSize) + index;
+        }
         return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                        kPrimRestartEnabledOffset * m_cap) +
                static_cast<typename Id::basic_type>(id)
@@ -4846,12 +4888,31 @@ public:
     }
     inline bool* PrimRestartEnabledPtr(Id id)
     {
+        if (static_cast<typename Id::basic_type>(id) >= m_cap)
+        {
+            typename Id::basic_type index;
+            uint8_t*                chunk = GetChunk(id, &index);
+            return reinterpret_cast<bool*>(chunk + kPrimRestartEnabledOffset * kChunkSize) + index;
+        }
         return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                        kPrimRestartEnabledOffset * m_cap) +
                static_cast<typename Id::basic_type>(id)
 
         ;
     }
+    // `PrimRestartEnabledColumn()` returns a read-only view of the `PrimRestartEnabled` array
+    inline StructOfArraysColumn<bool> PrimRestartEnabledColumn() const
+    {
+        DIVE_ASSERT(m_chunks.empty());
+        const bool* data = PrimRestartEnabledPtr();
+        uint32_t    stride = 1;
+        return StructOfArraysColumn<bool>(data,
+                                          m_size,
+                                          stride,
+                                          m_is_set_buffer.data(),
+                                          kNumFields,
+                                          kPrimRestartEnabledIndex);
+    }
     // `PrimRestartEnabled(id)` retuns the `PrimRestartEnabled` element of the object identified by
     // `id`
     inline bool PrimRestartEnabled(Id id) const
@@ -4888,19 +4949,29 @@ public:
     // FIELD PatchControlPoints: Number of control points per patch
 
     // `PatchControlPointsPtr()` returns a shared pointer to an array of `size()` elements
+    // Requires contiguous storage, see `Compact()`
     inline const uint32_t* PatchControlPointsPtr() const
     {
+        DIVE_ASSERT(m_chunks.empty());
         return reinterpret_cast<uint32_t*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                            kPatchControlPointsOffset * m_cap);
     }
     inline uint32_t* PatchControlPointsPtr()
     {
+        DIVE_ASSERT(m_chunks.empty());
         return reinterpret_cast<uint32_t*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                            kPatchControlPointsOffset * m_cap);
     }
     // `PatchControlPointsPtr()` returns a shared pointer to an array of `size()` elements
     inline const uint32_t* PatchControlPointsPtr(Id id) const
     {
+        if (static_cast<typename Id::basic_type>(id) >= m_cap)
+        {
+            typename Id::basic_type index;
+            uint8_t*                chunk = GetChunk(id, &index);
+            return reinterpret_cast<uint32_t*>(chunk + kPatchControlPointsOffset * kChunkSize) +
+                   index;
+        }
         return reinterpret_cast<uint32_t*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                            kPatchControlPointsOffset * m_cap) +
                static_cast<typename Id::basic_type>(id)
@@ -4909,12 +4980,32 @@ public:
     }
     inline uint32_t* PatchControlPointsPtr(Id id)
     {
+        if (static_cast<typename Id::basic_type>(id) >= m_cap)
+        {
+            typename Id::basic_type index;
+            uint8_t*                chunk = GetChunk(id, &index);
+            return reinterpret_cast<uint32_t*>(chunk + kPatchControlPointsOffset * kChunkSize) +
+                   index;
+        }
         return reinterpret_cast<uint32_t*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                            kPatchControlPointsOffset * m_cap) +
                static_cast<typename Id::basic_type>(id)
 
         ;
     }
+    // `PatchControlPointsColumn()` returns a read-only view of the `PatchControlPoints` array
+    inline StructOfArraysColumn<uint32_t> PatchControlPointsColumn() const
+    {
+        DIVE_ASSERT(m_chunks.empty());
+        const uint32_t* data = PatchControlPointsPtr();
+        uint32_t        stride = 1;
+        return StructOfArraysColumn<uint32_t>(data,
+                                              m_size,
+                                              stride,
+                                              m_is_set_buffer.data(),
+                                              kNumFields,
+                                              kPatchControlPointsIndex);
+    }
     // `PatchControlPoints(id)` retuns the `PatchControlPoints` element of the object identified by
     // `id`
     inline uint32_t PatchControlPoints(Id id) const
@@ -4950,19 +5041,29 @@ public:
     // FIELD Viewport: Defines the viewport transforms
 
     // `ViewportPtr()` returns a shared pointer to an array of `size()` elements
+    // Requires contiguous storage, see `Compact()`
     inline const VkViewport* ViewportPtr() const
     {
+        DIVE_ASSERT(m_chunks.empty());
         return reinterpret_cast<VkViewport*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                              kViewportOffset * m_cap);
     }
     inline VkViewport* ViewportPtr()
     {
+        DIVE_ASSERT(m_chunks.empty());
         return reinterpret_cast<VkViewport*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                              kViewportOffset * m_cap);
     }
     // `ViewportPtr()` returns a shared pointer to an array of `size()` elements
     inline const VkViewport* ViewportPtr(Id id, uint32_t viewport = 0) const
     {
+        if (static_cast<typename Id::basic_type>(id) >= m_cap)
+        {
+            typename Id::basic_type index;
+            uint8_t*                chunk = GetChunk(id, &index);
+            return reinterpret_cast<VkViewport*>(chunk + kViewportOffset * kChunkSize) +
+                   index * 16 + viewport;
+        }
         return reinterpret_cast<VkViewport*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                              kViewportOffset * m_cap) +
                static_cast<typename Id::basic_type>(id) * 16 + viewport
@@ -4971,12 +5072,32 @@ public:
     }
     inline VkViewport* ViewportPtr(Id id, uint32_t viewport = 0)
     {
+        if (static_cast<typename Id::basic_type>(id) >= m_cap)
+        {
+            typename Id::basic_type index;
+            uint8_t*                chunk = GetChunk(id, &index);
+            return reinterpret_cast<VkViewport*>(chunk + kViewportOffset * kChunkSize) +
+                   index * 16 + viewport;
+        }
         return reinterpret_cast<VkViewport*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                              kViewportOffset * m_cap) +
                static_cast<typename Id::basic_type>(id) * 16 + viewport
 
         ;
     }
+    // `ViewportColumn()` returns a read-only view of the `Viewport` array
+    inline StructOfArraysColumn<VkViewport> ViewportColumn(uint32_t viewport = 0) const
+    {
+        DIVE_ASSERT(m_chunks.empty());
+        const VkViewport* data = ViewportPtr(Id(0), viewport);
+        uint32_t          stride = kViewportArrayCount;
+        return StructOfArraysColumn<VkViewport>(data,
+                                                m_size,
+                                                stride,
+                                                m_is_set_buffer.data(),
+                                                kNumFields,
+                                                kViewportIndex + viewport);
+    }
     // `Viewport(id)` retuns the `Viewport` element of the object identified by `id`
     inline VkViewport Viewport(Id id, uint32_t viewport) const
     {
@@ -5015,19 +5136,29 @@ public:
     // FIELD Scissor: Defines the rectangular bounds of the scissor for the corresponding viewport
 
     // `ScissorPtr()` returns a shared pointer to an array of `size()` elements
+    // Requires contiguous storage, see `Compact()`
     inline const VkRect2D* ScissorPtr() const
     {
+        DIVE_ASSERT(m_chunks.empty());
         return reinterpret_cast<VkRect2D*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                            kScissorOffset * m_cap);
     }
     inline VkRect2D* ScissorPtr()
     {
+        DIVE_ASSERT(m_chunks.empty());
         return reinterpret_cast<VkRect2D*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                            kScissorOffset * m_cap);
     }
     // `ScissorPtr()` returns a shared pointer to an array of `size()` elements
     inline const VkRect2D* ScissorPtr(Id id, uint32_t scissor = 0) const
     {
+        if (static_cast<typename Id::basic_type>(id) >= m_cap)
+        {
+            typename Id::basic_type index;
+            uint8_t*                chunk = GetChunk(id, &index);
+            return reinterpret_cast<VkRect2D*>(chunk + kScissorOffset * kChunkSize) +
+                   index * 16 + scissor;
+        }
         return reinterpret_cast<VkRect2D*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                            kScissorOffset * m_cap) +
                static_cast<typename Id::basic_type>(id) * 16 + scissor
@@ -5036,12 +5167,32 @@ public:
     }
     inline VkRect2D* ScissorPtr(Id id, uint32_t scissor = 0)
     {
+        if (static_cast<typename Id::basic_type>(id) >= m_cap)
+        {
+            typename Id::basic_type index;
+            uint8_t*                chunk = GetChunk(id, &index);
+            return reinterpret_cast<VkRect2D*>(chunk + kScissorOffset * kChunkSize) +
+                   index * 16 + scissor;
+        }
         return reinterpret_cast<VkRect2D*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                            kScissorOffset * m_cap) +
                static_cast<typename Id::basic_type>(id) * 16 + scissor
 
         ;
     }
+    // `ScissorColumn()` returns a read-only view of the `Scissor` array
+    inline StructOfArraysColumn<VkRect2D> ScissorColumn(uint32_t scissor = 0) const
+    {
+        DIVE_ASSERT(m_chunks.empty());
+        const VkRect2D* data = ScissorPtr(Id(0), scissor);
+        uint32_t        stride = kScissorArrayCount;
+        return StructOfArraysColumn<VkRect2D>(data,
+                                              m_size,
+                                              stride,
+                                              m_is_set_buffer.data(),
+                                              kNumFields,
+                                              kScissorIndex + scissor);
+    }
     // `Scissor(id)` retuns the `Scissor` element of the object identified by `id`
     inline VkRect2D Scissor(Id id, uint32_t scissor) const
     {
@@ -5083,19 +5234,28 @@ public:
     // FIELD DepthClampEnabled: Controls whether to clamp the fragment’s depth values
 
     // `DepthClampEnabledPtr()` returns a shared pointer to an array of `size()` elements
+    // Requires contiguous storage, see `Compact()`
     inline const bool* DepthClampEnabledPtr() const
     {
+        DIVE_ASSERT(m_chunks.empty());
         return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                        kDepthClampEnabledOffset * m_cap);
     }
     inline bool* DepthClampEnabledPtr()
     {
+        DIVE_ASSERT(m_chunks.empty());
         return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                        kDepthClampEnabledOffset * m_cap);
     }
     // `DepthClampEnabledPtr()` returns a shared pointer to an array of `size()` elements
     inline const bool* DepthClampEnabledPtr(Id id) const
     {
+        if (static_cast<typename Id::basic_type>(id) >= m_cap)
+        {
+            typename Id::basic_type index;
+            uint8_t*                chunk = GetChunk(id, &index);
+            return reinterpret_cast<bool*>(chunk + kDepthClampEnabledOffset * kChunkSize) + index;
+        }
         return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                        kDepthClampEnabledOffset * m_cap) +
                static_cast<typename Id::basic_type>(id)
@@ -5104,12 +5264,31 @@ public:
     }
     inline bool* DepthClampEnabledPtr(Id id)
     {
+        if (static_cast<typename Id::basic_type>(id) >= m_cap)
+        {
+            typename Id::basic_type index;
+            uint8_t*                chunk = GetChunk(id, &index);
+            return reinterpret_cast<bool*>(chunk + kDepthClampEnabledOffset * kChunkSize) + index;
+        }
         return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                        kDepthClampEnabledOffset * m_cap) +
                static_cast<typename Id::basic_type>(id)
 
         ;
     }
+    // `DepthClampEnabledColumn()` returns a read-only view of the `DepthClampEnabled` array
+    inline StructOfArraysColumn<bool> DepthClampEnabledColumn() const
+    {
+        DIVE_ASSERT(m_chunks.empty());
+        const bool* data = DepthClampEnabledPtr();
+        uint32_t    stride = 1;
+        return StructOfArraysColumn<bool>(data,
+                                          m_size,
+                                          stride,
+                                          m_is_set_buffer.data(),
+                                          kNumFields,
+                                          kDepthClampEnabledIndex);
+    }
     // `DepthClampEnabled(id)` retuns the `DepthClampEnabled` element of the object identified by
     // `id`
     inline bool DepthClampEnabled(Id id) const
@@ -5146,19 +5325,29 @@ public:
     // the rasterization stage
 
     // `RasterizerDiscardEnabledPtr()` returns a shared pointer to an array of `size()` elements
+    // Requires contiguous storage, see `Compact()`
     inline const bool* RasterizerDiscardEnabledPtr() const
     {
+        DIVE_ASSERT(m_chunks.empty());
         return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                        kRasterizerDiscardEnabledOffset * m_cap);
     }
     inline bool* RasterizerDiscardEnabledPtr()
     {
+        DIVE_ASSERT(m_chunks.empty());
         return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                        kRasterizerDiscardEnabledOffset * m_cap);
     }
     // `RasterizerDiscardEnabledPtr()` returns a shared pointer to an array of `size()` elements
     inline const bool* RasterizerDiscardEnabledPtr(Id id) const
     {
+        if (static_cast<typename Id::basic_type>(id) >= m_cap)
+        {
+            typename Id::basic_type index;
+            uint8_t*                chunk = GetChunk(id, &index);
+            return reinterpret_cast<bool*>(chunk + kRasterizerDiscardEnabledOffset * kChunkSize) +
+                   index;
+        }
         return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                        kRasterizerDiscardEnabledOffset * m_cap) +
                static_cast<typename Id::basic_type>(id)
@@ -5167,12 +5356,33 @@ public:
     }
     inline bool* RasterizerDiscardEnabledPtr(Id id)
     {
+        if (static_cast<typename Id::basic_type>(id) >= m_cap)
+        {
+            typename Id::basic_type index;
+            uint8_t*                chunk = GetChunk(id, &index);
+            return reinterpret_cast<bool*>(chunk + kRasterizerDiscardEnabledOffset * kChunkSize) +
+                   index;
+        }
         return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                        kRasterizerDiscardEnabledOffset * m_cap) +
                static_cast<typename Id::basic_type>(id)
 
         ;
     }
+    // `RasterizerDiscardEnabledColumn()` returns a read-only view of the `RasterizerDiscardEnabled`
+    // array
+    inline StructOfArraysColumn<bool> RasterizerDiscardEnabledColumn() const
+    {
+        DIVE_ASSERT(m_chunks.empty());
+        const bool* data = RasterizerDiscardEnabledPtr();
+        uint32_t    stride = 1;
+        return StructOfArraysColumn<bool>(data,
+                                          m_size,
+                                          stride,
+                                          m_is_set_buffer.data(),
+                                          kNumFields,
+                                          kRasterizerDiscardEnabledIndex);
+    }
     // `RasterizerDiscardEnabled(id)` retuns the `RasterizerDiscardEnabled` element of the object
     // identified by `id`
     inline bool RasterizerDiscardEnabled(Id id) const
@@ -5212,19 +5422,29 @@ public:
     // FIELD PolygonMode: The triangle rendering mode
 
     // `PolygonModePtr()` returns a shared pointer to an array of `size()` elements
+    // Requires contiguous storage, see `Compact()`
     inline const VkPolygonMode* PolygonModePtr() const
     {
+        DIVE_ASSERT(m_chunks.empty());
         return reinterpret_cast<VkPolygonMode*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                                 kPolygonModeOffset * m_cap);
     }
     inline VkPolygonMode* PolygonModePtr()
     {
+        DIVE_ASSERT(m_chunks.empty());
         return reinterpret_cast<VkPolygonMode*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                                 kPolygonModeOffset * m_cap);
     }
     // `PolygonModePtr()` returns a shared pointer to an array of `size()` elements
     inline const VkPolygonMode* PolygonModePtr(Id id) const
     {
+        if (static_cast<typename Id::basic_type>(id) >= m_cap)
+        {
+            typename Id::basic_type index;
+            uint8_t*                chunk = GetChunk(id, &index);
+            return reinterpret_cast<VkPolygonMode*>(chunk + kPolygonModeOffset * kChunkSize) +
+                   index;
+        }
         return reinterpret_cast<VkPolygonMode*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                                 kPolygonModeOffset * m_cap) +
                static_cast<typename Id::basic_type>(id)
@@ -5233,12 +5453,32 @@ public:
     }
     inline VkPolygonMode* PolygonModePtr(Id id)
     {
+        if (static_cast<typename Id::basic_type>(id) >= m_cap)
+        {
+            typename Id::basic_type index;
+            uint8_t*                chunk = GetChunk(id, &index);
+            return reinterpret_cast<VkPolygonMode*>(chunk + kPolygonModeOffset * kChunkSize) +
+                   index;
+        }
         return reinterpret_cast<VkPolygonMode*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                                 kPolygonModeOffset * m_cap) +
                static_cast<typename Id::basic_type>(id)
 
         ;
     }
+    // `PolygonModeColumn()` returns a read-only view of the `PolygonMode` array
+    inline StructOfArraysColumn<VkPolygonMode> PolygonModeColumn() const
+    {
+        DIVE_ASSERT(m_chunks.empty());
+        const VkPolygonMode* data = PolygonModePtr();
+        uint32_t             stride = 1;
+        return StructOfArraysColumn<VkPolygonMode>(data,
+                                                   m_size,
+                                                   stride,
+                                                   m_is_set_buffer.data(),
+                                                   kNumFields,
+                                                   kPolygonModeIndex);
+    }
     // `PolygonMode(id)` retuns the `PolygonMode` element of the object identified by `id`
     inline VkPolygonMode PolygonMode(Id id) const
     {
@@ -5269,19 +5509,28 @@ public:
     // FIELD CullMode: The triangle facing direction used for primitive culling
 
     // `CullModePtr()` returns a shared pointer to an array of `size()` elements
+    // Requires contiguous storage, see `Compact()`
     inline const VkCullModeFlags* CullModePtr() const
     {
+        DIVE_ASSERT(m_chunks.empty());
         return reinterpret_cast<VkCullModeFlags*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                                   kCullModeOffset * m_cap);
     }
     inline VkCullModeFlags* CullModePtr()
     {
+        DIVE_ASSERT(m_chunks.empty());
         return reinterpret_cast<VkCullModeFlags*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                                   kCullModeOffset * m_cap);
     }
     // `CullModePtr()` returns a shared pointer to an array of `size()` elements
     inline const VkCullModeFlags* CullModePtr(Id id) const
     {
+        if (static_cast<typename Id::basic_type>(id) >= m_cap)
+        {
+            typename Id::basic_type index;
+            uint8_t*                chunk = GetChunk(id, &index);
+            return reinterpret_cast<VkCullModeFlags*>(chunk + kCullModeOffset * kChunkSize) + index;
+        }
         return reinterpret_cast<VkCullModeFlags*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                                   kCullModeOffset * m_cap) +
                static_cast<typename Id::basic_type>(id)
@@ -5290,12 +5539,31 @@ public:
     }
     inline VkCullModeFlags* CullModePtr(Id id)
     {
+        if (static_cast<typename Id::basic_type>(id) >= m_cap)
+        {
+            typename Id::basic_type index;
+            uint8_t*                chunk = GetChunk(id, &index);
+            return reinterpret_cast<VkCullModeFlags*>(chunk + kCullModeOffset * kChunkSize) + index;
+        }
         return reinterpret_cast<VkCullModeFlags*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                                   kCullModeOffset * m_cap) +
                static_cast<typename Id::basic_type>(id)
 
         ;
     }
+    // `CullModeColumn()` returns a read-only view of the `CullMode` array
+    inline StructOfArraysColumn<VkCullModeFlags> CullModeColumn() const
+    {
+        DIVE_ASSERT(m_chunks.empty());
+        const VkCullModeFlags* data = CullModePtr();
+        uint32_t               stride = 1;
+        return StructOfArraysColumn<VkCullModeFlags>(data,
+                                                     m_size,
+                                                     stride,
+                                                     m_is_set_buffer.data(),
+                                                     kNumFields,
+                                                     kCullModeIndex);
+    }
     // `CullMode(id)` retuns the `CullMode` element of the object identified by `id`
     inline VkCullModeFlags CullMode(Id id) const
     {
@@ -5330,19 +5598,28 @@ public:
     // used for culling
 
     // `FrontFacePtr()` returns a shared pointer to an array of `size()` elements
+    // Requires contiguous storage, see `Compact()`
     inline const VkFrontFace* FrontFacePtr() const
     {
+        DIVE_ASSERT(m_chunks.empty());
         return reinterpret_cast<VkFrontFace*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                               kFrontFaceOffset * m_cap);
     }
     inline VkFrontFace* FrontFacePtr()
     {
+        DIVE_ASSERT(m_chunks.empty());
         return reinterpret_cast<VkFrontFace*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                               kFrontFaceOffset * m_cap);
     }
     // `FrontFacePtr()` returns a shared pointer to an array of `size()` elements
     inline const VkFrontFace* FrontFacePtr(Id id) const
     {
+        if (static_cast<typename Id::basic_type>(id) >= m_cap)
+        {
+            typename Id::basic_type index;
+            uint8_t*                chunk = GetChunk(id, &index);
+            return reinterpret_cast<VkFrontFace*>(chunk + kFrontFaceOffset * kChunkSize) + index;
+        }
         return reinterpret_cast<VkFrontFace*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                               kFrontFaceOffset * m_cap) +
                static_cast<typename Id::basic_type>(id)
@@ -5351,12 +5628,31 @@ public:
     }
     inline VkFrontFace* FrontFacePtr(Id id)
     {
+        if (static_cast<typename Id::basic_type>(id) >= m_cap)
+        {
+            typename Id::basic_type index;
+            uint8_t*                chunk = GetChunk(id, &index);
+            return reinterpret_cast<VkFrontFace*>(chunk + kFrontFaceOffset * kChunkSize) + index;
+        }
         return reinterpret_cast<VkFrontFace*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                               kFrontFaceOffset * m_cap) +
                static_cast<typename Id::basic_type>(id)
 
         ;
     }
+    // `FrontFaceColumn()` returns a read-only view of the `FrontFace` array
+    inline StructOfArraysColumn<VkFrontFace> FrontFaceColumn() const
+    {
+        DIVE_ASSERT(m_chunks.empty());
+        const VkFrontFace* data = FrontFacePtr();
+        uint32_t           stride = 1;
+        return StructOfArraysColumn<VkFrontFace>(data,
+                                                 m_size,
+                                                 stride,
+                                                 m_is_set_buffer.data(),
+                                                 kNumFields,
+                                                 kFrontFaceIndex);
+    }
     // `FrontFace(id)` retuns the `FrontFace` element of the object identified by `id`
     inline VkFrontFace FrontFace(Id id) const
     {
@@ -5391,19 +5687,28 @@ public:
     // FIELD DepthBiasEnabled: Whether to bias fragment depth values
 
     // `DepthBiasEnabledPtr()` returns a shared pointer to an array of `size()` elements
+    // Requires contiguous storage, see `Compact()`
     inline const bool* DepthBiasEnabledPtr() const
     {
+        DIVE_ASSERT(m_chunks.empty());
         return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                        kDepthBiasEnabledOffset * m_cap);
     }
     inline bool* DepthBiasEnabledPtr()
     {
+        DIVE_ASSERT(m_chunks.empty());
         return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                        kDepthBiasEnabledOffset * m_cap);
     }
     // `DepthBiasEnabledPtr()` returns a shared pointer to an array of `size()` elements
     inline const bool* DepthBiasEnabledPtr(Id id) const
     {
+        if (static_cast<typename Id::basic_type>(id) >= m_cap)
+        {
+            typename Id::basic_type index;
+            uint8_t*                chunk = GetChunk(id, &index);
+            return reinterpret_cast<bool*>(chunk + kDepthBiasEnabledOffset * kChunkSize) + index;
+        }
         return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                        kDepthBiasEnabledOffset * m_cap) +
                static_cast<typename Id::basic_type>(id)
@@ -5412,12 +5717,31 @@ public:
     }
     inline bool* DepthBiasEnabledPtr(Id id)
     {
+        if (static_cast<typename Id::basic_type>(id) >= m_cap)
+        {
+            typename Id::basic_type index;
+            uint8_t*                chunk = GetChunk(id, &index);
+            return reinterpret_cast<bool*>(chunk + kDepthBiasEnabledOffset * kChunkSize) + index;
+        }
         return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                        kDepthBiasEnabledOffset * m_cap) +
                static_cast<typename Id::basic_type>(id)
 
         ;
     }
+    // `DepthBiasEnabledColumn()` returns a read-only view of the `DepthBiasEnabled` array
+    inline StructOfArraysColumn<bool> DepthBiasEnabledColumn() const
+    {
+        DIVE_ASSERT(m_chunks.empty());
+        const bool* data = DepthBiasEnabledPtr();
+        uint32_t    stride = 1;
+        return StructOfArraysColumn<bool>(data,
+                                          m_size,
+                                          stride,
+                                          m_is_set_buffer.data(),
+                                          kNumFields,
+                                          kDepthBiasEnabledIndex);
+    }
     // `DepthBiasEnabled(id)` retuns the `DepthBiasEnabled` element of the object identified by `id`
     inline bool DepthBiasEnabled(Id id) const
     {
@@ -5453,19 +5777,29 @@ public:
     // each fragment.
 
     // `DepthBiasConstantFactorPtr()` returns a shared pointer to an array of `size()` elements
+    // Requires contiguous storage, see `Compact()`
     inline const float* DepthBiasConstantFactorPtr() const
     {
+        DIVE_ASSERT(m_chunks.empty());
         return reinterpret_cast<float*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                         kDepthBiasConstantFactorOffset * m_cap);
     }
     inline float* DepthBiasConstantFactorPtr()
     {
+        DIVE_ASSERT(m_chunks.empty());
         return reinterpret_cast<float*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                         kDepthBiasConstantFactorOffset * m_cap);
     }
     // `DepthBiasConstantFactorPtr()` returns a shared pointer to an array of `size()` elements
     inline const float* DepthBiasConstantFactorPtr(Id id) const
     {
+        if (static_cast<typename Id::basic_type>(id) >= m_cap)
+        {
+            typename Id::basic_type index;
+            uint8_t*                chunk = GetChunk(id, &index);
+            return reinterpret_cast<float*>(chunk + kDepthBiasConstantFactorOffset * kChunkSize) +
+                   index;
+        }
         return reinterpret_cast<float*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                         kDepthBiasConstantFactorOffset * m_cap) +
                static_cast<typename Id::basic_type>(id)
@@ -5474,12 +5808,33 @@ public:
     }
     inline float* DepthBiasConstantFactorPtr(Id id)
     {
+        if (static_cast<typename Id::basic_type>(id) >= m_cap)
+        {
+            typename Id::basic_type index;
+            uint8_t*                chunk = GetChunk(id, &index);
+            return reinterpret_cast<float*>(chunk + kDepthBiasConstantFactorOffset * kChunkSize) +
+                   index;
+        }
         return reinterpret_cast<float*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                         kDepthBiasConstantFactorOffset * m_cap) +
                static_cast<typename Id::basic_type>(id)
 
         ;
     }
+    // `DepthBiasConstantFactorColumn()` returns a read-only view of the `DepthBiasConstantFactor`
+    // array
+    inline StructOfArraysColumn<float> DepthBiasConstantFactorColumn() const
+    {
+        DIVE_ASSERT(m_chunks.empty());
+        const float* data = DepthBiasConstantFactorPtr();
+        uint32_t     stride = 1;
+        return StructOfArraysColumn<float>(data,
+                                           m_size,
+                                           stride,
+                                           m_is_set_buffer.data(),
+                                           kNumFields,
+                                           kDepthBiasConstantFactorIndex);
+    }
     // `DepthBiasConstantFactor(id)` retuns the `DepthBiasConstantFactor` element of the object
     // identified by `id`
     inline float DepthBiasConstantFactor(Id id) const
@@ -5515,19 +5870,28 @@ public:
     // FIELD DepthBiasClamp: The maximum (or minimum) depth bias of a fragment
 
     // `DepthBiasClampPtr()` returns a shared pointer to an array of `size()` elements
+    // Requires contiguous storage, see `Compact()`
     inline const float* DepthBiasClampPtr() const
     {
+        DIVE_ASSERT(m_chunks.empty());
         return reinterpret_cast<float*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                         kDepthBiasClampOffset * m_cap);
     }
     inline float* DepthBiasClampPtr()
     {
+        DIVE_ASSERT(m_chunks.empty());
         return reinterpret_cast<float*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                         kDepthBiasClampOffset * m_cap);
     }
     // `DepthBiasClampPtr()` returns a shared pointer to an array of `size()` elements
     inline const float* DepthBiasClampPtr(Id id) const
     {
+        if (static_cast<typename Id::basic_type>(id) >= m_cap)
+        {
+            typename Id::basic_type index;
+            uint8_t*                chunk = GetChunk(id, &index);
+            return reinterpret_cast<float*>(chunk + kDepthBiasClampOffset * kChunkSize) + index;
+        }
         return reinterpret_cast<float*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                         kDepthBiasClampOffset * m_cap) +
                static_cast<typename Id::basic_type>(id)
@@ -5536,12 +5900,31 @@ public:
     }
     inline float* DepthBiasClampPtr(Id id)
     {
+        if (static_cast<typename Id::basic_type>(id) >= m_cap)
+        {
+            typename Id::basic_type index;
+            uint8_t*                chunk = GetChunk(id, &index);
+            return reinterpret_cast<float*>(chunk + kDepthBiasClampOffset * kChunkSize) + index;
+        }
         return reinterpret_cast<float*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                         kDepthBiasClampOffset * m_cap) +
                static_cast<typename Id::basic_type>(id)
 
         ;
     }
+    // `DepthBiasClampColumn()` returns a read-only view of the `DepthBiasClamp` array
+    inline StructOfArraysColumn<float> DepthBiasClampColumn() const
+    {
+        DIVE_ASSERT(m_chunks.empty());
+        const float* data = DepthBiasClampPtr();
+        uint32_t     stride = 1;
+        return StructOfArraysColumn<float>(data,
+                                           m_size,
+                                           stride,
+                                           m_is_set_buffer.data(),
+                                           kNumFields,
+                                           kDepthBiasClampIndex);
+    }
     // `DepthBiasClamp(id)` retuns the `DepthBiasClamp` element of the object identified by `id`
     inline float DepthBiasClamp(Id id) const
     {
@@ -5577,19 +5960,29 @@ public:
     // calculations
 
     // `DepthBiasSlopeFactorPtr()` returns a shared pointer to an array of `size()` elements
+    // Requires contiguous storage, see `Compact()`
     inline const float* DepthBiasSlopeFactorPtr() const
     {
+        DIVE_ASSERT(m_chunks.empty());
         return reinterpret_cast<float*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                         kDepthBiasSlopeFactorOffset * m_cap);
     }
     inline float* DepthBiasSlopeFactorPtr()
     {
+        DIVE_ASSERT(m_chunks.empty());
         return reinterpret_cast<float*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                         kDepthBiasSlopeFactorOffset * m_cap);
     }
     // `DepthBiasSlopeFactorPtr()` returns a shared pointer to an array of `size()` elements
     inline const float* DepthBiasSlopeFactorPtr(Id id) const
     {
+        if (static_cast<typename Id::basic_type>(id) >= m_cap)
+        {
+            typename Id::basic_type index;
+            uint8_t*                chunk = GetChunk(id, &index);
+            return reinterpret_cast<float*>(chunk + kDepthBiasSlopeFactorOffset * kChunkSize) +
+                   index;
+        }
         return reinterpret_cast<float*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                         kDepthBiasSlopeFactorOffset * m_cap) +
                static_cast<typename Id::basic_type>(id)
@@ -5598,12 +5991,32 @@ public:
     }
     inline float* DepthBiasSlopeFactorPtr(Id id)
     {
+        if (static_cast<typename Id::basic_type>(id) >= m_cap)
+        {
+            typename Id::basic_type index;
+            uint8_t*                chunk = GetChunk(id, &index);
+            return reinterpret_cast<float*>(chunk + kDepthBiasSlopeFactorOffset * kChunkSize) +
+                   index;
+        }
         return reinterpret_cast<float*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                         kDepthBiasSlopeFactorOffset * m_cap) +
                static_cast<typename Id::basic_type>(id)
 
         ;
     }
+    // `DepthBiasSlopeFactorColumn()` returns a read-only view of the `DepthBiasSlopeFactor` array
+    inline StructOfArraysColumn<float> DepthBiasSlopeFactorColumn() const
+    {
+        DIVE_ASSERT(m_chunks.empty());
+        const float* data = DepthBiasSlopeFactorPtr();
+        uint32_t     stride = 1;
+        return StructOfArraysColumn<float>(data,
+                                           m_size,
+                                           stride,
+                                           m_is_set_buffer.data(),
+                                           kNumFields,
+                                           kDepthBiasSlopeFactorIndex);
+    }
     // `DepthBiasSlopeFactor(id)` retuns the `DepthBiasSlopeFactor` element of the object identified
     // by `id`
     inline float DepthBiasSlopeFactor(Id id) const
@@ -5639,19 +6052,28 @@ public:
     // FIELD LineWidth: The width of rasterized line segments
 
     // `LineWidthPtr()` returns a shared pointer to an array of `size()` elements
+    // Requires contiguous storage, see `Compact()`
     inline const float* LineWidthPtr() const
     {
+        DIVE_ASSERT(m_chunks.empty());
         return reinterpret_cast<float*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                         kLineWidthOffset * m_cap);
     }
     inline float* LineWidthPtr()
     {
+        DIVE_ASSERT(m_chunks.empty());
         return reinterpret_cast<float*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                         kLineWidthOffset * m_cap);
     }
     // `LineWidthPtr()` returns a shared pointer to an array of `size()` elements
     inline const float* LineWidthPtr(Id id) const
     {
+        if (static_cast<typename Id::basic_type>(id) >= m_cap)
+        {
+            typename Id::basic_type index;
+            uint8_t*                chunk = GetChunk(id, &index);
+            return reinterpret_cast<float*>(chunk + kLineWidthOffset * kChunkSize) + index;
+        }
         return reinterpret_cast<float*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                         kLineWidthOffset * m_cap) +
                static_cast<typename Id::basic_type>(id)
@@ -5660,12 +6082,31 @@ public:
     }
     inline float* LineWidthPtr(Id id)
     {
+        if (static_cast<typename Id::basic_type>(id) >= m_cap)
+        {
+            typename Id::basic_type index;
+            uint8_t*                chunk = GetChunk(id, &index);
+            return reinterpret_cast<float*>(chunk + kLineWidthOffset * kChunkSize) + index;
+        }
         return reinterpret_cast<float*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                         kLineWidthOffset * m_cap) +
                static_cast<typename Id::basic_type>(id)
 
         ;
     }
+    // `LineWidthColumn()` returns a read-only view of the `LineWidth` array
+    inline StructOfArraysColumn<float> LineWidthColumn() const
+    {
+        DIVE_ASSERT(m_chunks.empty());
+        const float* data = LineWidthPtr();
+        uint32_t     stride = 1;
+        return StructOfArraysColumn<float>(data,
+                                           m_size,
+                                           stride,
+                                           m_is_set_buffer.data(),
+                                           kNumFields,
+                                           kLineWidthIndex);
+    }
     // `LineWidth(id)` retuns the `LineWidth` element of the object identified by `id`
     inline float LineWidth(Id id) const
     {
@@ -5700,19 +6141,30 @@ public:
     // used in rasterization
 
     // `RasterizationSamplesPtr()` returns a shared pointer to an array of `size()` elements
+    // Requires contiguous storage, see `Compact()`
     inline const VkSampleCountFlagBits* RasterizationSamplesPtr() const
     {
+        DIVE_ASSERT(m_chunks.empty());
         return reinterpret_cast<VkSampleCountFlagBits*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                                         kRasterizationSamplesOffset * m_cap);
     }
     inline VkSampleCountFlagBits* RasterizationSamplesPtr()
     {
+        DIVE_ASSERT(m_chunks.empty());
         return reinterpret_cast<VkSampleCountFlagBits*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                                         kRasterizationSamplesOffset * m_cap);
     }
     // `RasterizationSamplesPtr()` returns a shared pointer to an array of `size()` elements
     inline const VkSampleCountFlagBits* RasterizationSamplesPtr(Id id) const
     {
+        if (static_cast<typename Id::basic_type>(id) >= m_cap)
+        {
+            typename Id::basic_type index;
+            uint8_t*                chunk = GetChunk(id, &index);
+            return reinterpret_cast<VkSampleCountFlagBits*>(
+                       chunk + kRasterizationSamplesOffset * kChunkSize) +
+                   index;
+        }
         return reinterpret_cast<VkSampleCountFlagBits*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                                         kRasterizationSamplesOffset * m_cap) +
                static_cast<typename Id::basic_type>(id)
@@ -5721,12 +6173,33 @@ public:
     }
     inline VkSampleCountFlagBits* RasterizationSamplesPtr(Id id)
     {
+        if (static_cast<typename Id::basic_type>(id) >= m_cap)
+        {
+            typename Id::basic_type index;
+            uint8_t*                chunk = GetChunk(id, &index);
+            return reinterpret_cast<VkSampleCountFlagBits*>(
+                       chunk + kRasterizationSamplesOffset * kChunkSize) +
+                   index;
+        }
         return reinterpret_cast<VkSampleCountFlagBits*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                                         kRasterizationSamplesOffset * m_cap) +
                static_cast<typename Id::basic_type>(id)
 
         ;
     }
+    // `RasterizationSamplesColumn()` returns a read-only view of the `RasterizationSamples` array
+    inline StructOfArraysColumn<VkSampleCountFlagBits> RasterizationSamplesColumn() const
+    {
+        DIVE_ASSERT(m_chunks.empty());
+        const VkSampleCountFlagBits* data = RasterizationSamplesPtr();
+        uint32_t                     stride = 1;
+        return StructOfArraysColumn<VkSampleCountFlagBits>(data,
+                                                           m_size,
+                                                           stride,
+                                                           m_is_set_buffer.data(),
+                                                           kNumFields,
+                                                           kRasterizationSamplesIndex);
+    }
     // `RasterizationSamples(id)` retuns the `RasterizationSamples` element of the object identified
     // by `id`
     inline VkSampleCountFlagBits RasterizationSamples(Id id) const
@@ -5763,19 +6236,29 @@ public:
     // FIELD SampleShadingEnabled: Whether sample shading is enabled
 
     // `SampleShadingEnabledPtr()` returns a shared pointer to an array of `size()` elements
+    // Requires contiguous storage, see `Compact()`
     inline const bool* SampleShadingEnabledPtr() const
     {
+        DIVE_ASSERT(m_chunks.empty());
         return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                        kSampleShadingEnabledOffset * m_cap);
     }
     inline bool* SampleShadingEnabledPtr()
     {
+        DIVE_ASSERT(m_chunks.empty());
         return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                        kSampleShadingEnabledOffset * m_cap);
     }
     // `SampleShadingEnabledPtr()` returns a shared pointer to an array of `size()` elements
     inline const bool* SampleShadingEnabledPtr(Id id) const
     {
+        if (static_cast<typename Id::basic_type>(id) >= m_cap)
+        {
+            typename Id::basic_type index;
+            uint8_t*                chunk = GetChunk(id, &index);
+            return reinterpret_cast<bool*>(chunk + kSampleShadingEnabledOffset * kChunkSize) +
+                   index;
+        }
         return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                        kSampleShadingEnabledOffset * m_cap) +
                static_cast<typename Id::basic_type>(id)
@@ -5784,12 +6267,32 @@ public:
     }
     inline bool* SampleShadingEnabledPtr(Id id)
     {
+        if (static_cast<typename Id::basic_type>(id) >= m_cap)
+        {
+            typename Id::basic_type index;
+            uint8_t*                chunk = GetChunk(id, &index);
+            return reinterpret_cast<bool*>(chunk + kSampleShadingEnabledOffset * kChunkSize) +
+                   index;
+        }
         return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                        kSampleShadingEnabledOffset * m_cap) +
                static_cast<typename Id::basic_type>(id)
 
         ;
     }
+    // `SampleShadingEnabledColumn()` returns a read-only view of the `SampleShadingEnabled` array
+    inline StructOfArraysColumn<bool> SampleShadingEnabledColumn() const
+    {
+        DIVE_ASSERT(m_chunks.empty());
+        const bool* data = SampleShadingEnabledPtr();
+        uint32_t    stride = 1;
+        return StructOfArraysColumn<bool>(data,
+                                          m_size,
+                                          stride,
+                                          m_is_set_buffer.data(),
+                                          kNumFields,
+                                          kSampleShadingEnabledIndex);
+    }
     // `SampleShadingEnabled(id)` retuns the `SampleShadingEnabled` element of the object identified
     // by `id`
     inline bool SampleShadingEnabled(Id id) const
@@ -5826,19 +6329,28 @@ public:
     // is set to VK_TRUE
 
     // `MinSampleShadingPtr()` returns a shared pointer to an array of `size()` elements
+    // Requires contiguous storage, see `Compact()`
     inline const float* MinSampleShadingPtr() const
     {
+        DIVE_ASSERT(m_chunks.empty());
         return reinterpret_cast<float*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                         kMinSampleShadingOffset * m_cap);
     }
     inline float* MinSampleShadingPtr()
     {
+        DIVE_ASSERT(m_chunks.empty());
         return reinterpret_cast<float*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                         kMinSampleShadingOffset * m_cap);
     }
     // `MinSampleShadingPtr()` returns a shared pointer to an array of `size()` elements
     inline const float* MinSampleShadingPtr(Id id) const
     {
+        if (static_cast<typename Id::basic_type>(id) >= m_cap)
+        {
+            typename Id::basic_type index;
+            uint8_t*                chunk = GetChunk(id, &index);
+            return reinterpret_cast<float*>(chunk + kMinSampleShadingOffset * kChunkSize) + index;
+        }
         return reinterpret_cast<float*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                         kMinSampleShadingOffset * m_cap) +
                static_cast<typename Id::basic_type>(id)
@@ -5847,12 +6359,31 @@ public:
     }
     inline float* MinSampleShadingPtr(Id id)
     {
+        if (static_cast<typename Id::basic_type>(id) >= m_cap)
+        {
+            typename Id::basic_type index;
+            uint8_t*                chunk = GetChunk(id, &index);
+            return reinterpret_cast<float*>(chunk + kMinSampleShadingOffset * kChunkSize) + index;
+        }
         return reinterpret_cast<float*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                         kMinSampleShadingOffset * m_cap) +
                static_cast<typename Id::basic_type>(id)
 
         ;
     }
+    // `MinSampleShadingColumn()` returns a read-only view of the `MinSampleShading` array
+    inline StructOfArraysColumn<float> MinSampleShadingColumn() const
+    {
+        DIVE_ASSERT(m_chunks.empty());
+        const float* data = MinSampleShadingPtr();
+        uint32_t     stride = 1;
+        return StructOfArraysColumn<float>(data,
+                                           m_size,
+                                           stride,
+                                           m_is_set_buffer.data(),
+                                           kNumFields,
+                                           kMinSampleShadingIndex);
+    }
     // `MinSampleShading(id)` retuns the `MinSampleShading` element of the object identified by `id`
     inline float MinSampleShading(Id id) const
     {
@@ -5889,19 +6420,28 @@ public:
     // defined for the coverage mask. If the bit is set to 0, the coverage mask bit is set to 0
 
     // `SampleMaskPtr()` returns a shared pointer to an array of `size()` elements
+    // Requires contiguous storage, see `Compact()`
     inline const VkSampleMask* SampleMaskPtr() const
     {
+        DIVE_ASSERT(m_chunks.empty());
         return reinterpret_cast<VkSampleMask*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                                kSampleMaskOffset * m_cap);
     }
     inline VkSampleMask* SampleMaskPtr()
     {
+        DIVE_ASSERT(m_chunks.empty());
         return reinterpret_cast<VkSampleMask*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                                kSampleMaskOffset * m_cap);
     }
     // `SampleMaskPtr()` returns a shared pointer to an array of `size()` elements
     inline const VkSampleMask* SampleMaskPtr(Id id) const
     {
+        if (static_cast<typename Id::basic_type>(id) >= m_cap)
+        {
+            typename Id::basic_type index;
+            uint8_t*                chunk = GetChunk(id, &index);
+            return reinterpret_cast<VkSampleMask*>(chunk + kSampleMaskOffset * kChunkSize) + index;
+        }
         return reinterpret_cast<VkSampleMask*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                                kSampleMaskOffset * m_cap) +
                static_cast<typename Id::basic_type>(id)
@@ -5910,12 +6450,31 @@ public:
     }
     inline VkSampleMask* SampleMaskPtr(Id id)
     {
+        if (static_cast<typename Id::basic_type>(id) >= m_cap)
+        {
+            typename Id::basic_type index;
+            uint8_t*                chunk = GetChunk(id, &index);
+            return reinterpret_cast<VkSampleMask*>(chunk + kSampleMaskOffset * kChunkSize) + index;
+        }
         return reinterpret_cast<VkSampleMask*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                                kSampleMaskOffset * m_cap) +
                static_cast<typename Id::basic_type>(id)
 
         ;
     }
+    // `SampleMaskColumn()` returns a read-only view of the `SampleMask` array
+    inline StructOfArraysColumn<VkSampleMask> SampleMaskColumn() const
+    {
+        DIVE_ASSERT(m_chunks.empty());
+        const VkSampleMask* data = SampleMaskPtr();
+        uint32_t            stride = 1;
+        return StructOfArraysColumn<VkSampleMask>(data,
+                                                  m_size,
+                                                  stride,
+                                                  m_is_set_buffer.data(),
+                                                  kNumFields,
+                                                  kSampleMaskIndex);
+    }
     // `SampleMask(id)` retuns the `SampleMask` element of the object identified by `id`
     inline VkSampleMask SampleMask(Id id) const
     {
@@ -5951,19 +6510,29 @@ public:
     // alpha component of the fragment’s first color output
 
     // `AlphaToCoverageEnabledPtr()` returns a shared pointer to an array of `size()` elements
+    // Requires contiguous storage, see `Compact()`
     inline const bool* AlphaToCoverageEnabledPtr() const
     {
+        DIVE_ASSERT(m_chunks.empty());
         return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                        kAlphaToCoverageEnabledOffset * m_cap);
     }
     inline bool* AlphaToCoverageEnabledPtr()
     {
+        DIVE_ASSERT(m_chunks.empty());
         return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                        kAlphaToCoverageEnabledOffset * m_cap);
     }
     // `AlphaToCoverageEnabledPtr()` returns a shared pointer to an array of `size()` elements
     inline const bool* AlphaToCoverageEnabledPtr(Id id) const
     {
+        if (static_cast<typename Id::basic_type>(id) >= m_cap)
+        {
+            typename Id::basic_type index;
+            uint8_t*                chunk = GetChunk(id, &index);
+            return reinterpret_cast<bool*>(chunk + kAlphaToCoverageEnabledOffset * kChunkSize) +
+                   index;
+        }
         return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                        kAlphaToCoverageEnabledOffset * m_cap) +
                static_cast<typename Id::basic_type>(id)
@@ -5972,12 +6541,33 @@ public:
     }
     inline bool* AlphaToCoverageEnabledPtr(Id id)
     {
+        if (static_cast<typename Id::basic_type>(id) >= m_cap)
+        {
+            typename Id::basic_type index;
+            uint8_t*                chunk = GetChunk(id, &index);
+            return reinterpret_cast<bool*>(chunk + kAlphaToCoverageEnabledOffset * kChunkSize) +
+                   index;
+        }
         return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                        kAlphaToCoverageEnabledOffset * m_cap) +
                static_cast<typename Id::basic_type>(id)
 
         ;
     }
+    // `AlphaToCoverageEnabledColumn()` returns a read-only view of the `AlphaToCoverageEnabled`
+    // array
+    inline StructOfArraysColumn<bool> AlphaToCoverageEnabledColumn() const
+    {
+        DIVE_ASSERT(m_chunks.empty());
+        const bool* data = AlphaToCoverageEnabledPtr();
+        uint32_t    stride = 1;
+        return StructOfArraysColumn<bool>(data,
+                                          m_size,
+                                          stride,
+                                          m_is_set_buffer.data(),
+                                          kNumFields,
+                                          kAlphaToCoverageEnabledIndex);
+    }
     // `AlphaToCoverageEnabled(id)` retuns the `AlphaToCoverageEnabled` element of the object
     // identified by `id`
     inline bool AlphaToCoverageEnabled(Id id) const
@@ -6014,19 +6604,28 @@ public:
     // FIELD DepthTestEnabled: Whether depth testing is enabled
 
     // `DepthTestEnabledPtr()` returns a shared pointer to an array of `size()` elements
+    // Requires contiguous storage, see `Compact()`
     inline const bool* DepthTestEnabledPtr() const
     {
+        DIVE_ASSERT(m_chunks.empty());
         return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                        kDepthTestEnabledOffset * m_cap);
     }
     inline bool* DepthTestEnabledPtr()
     {
+        DIVE_ASSERT(m_chunks.empty());
         return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                        kDepthTestEnabledOffset * m_cap);
     }
     // `DepthTestEnabledPtr()` returns a shared pointer to an array of `size()` elements
     inline const bool* DepthTestEnabledPtr(Id id) const
     {
+        if (static_cast<typename Id::basic_type>(id) >= m_cap)
+        {
+            typename Id::basic_type index;
+            uint8_t*                chunk = GetChunk(id, &index);
+            return reinterpret_cast<bool*>(chunk + kDepthTestEnabledOffset * kChunkSize) + index;
+        }
         return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                        kDepthTestEnabledOffset * m_cap) +
                static_cast<typename Id::basic_type>(id)
@@ -6035,12 +6634,31 @@ public:
     }
     inline bool* DepthTestEnabledPtr(Id id)
     {
+        if (static_cast<typename Id::basic_type>(id) >= m_cap)
+        {
+            typename Id::basic_type index;
+            uint8_t*                chunk = GetChunk(id, &index);
+            return reinterpret_cast<bool*>(chunk + kDepthTestEnabledOffset * kChunkSize) + index;
+        }
         return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                        kDepthTestEnabledOffset * m_cap) +
                static_cast<typename Id::basic_type>(id)
 
         ;
     }
+    // `DepthTestEnabledColumn()` returns a read-only view of the `DepthTestEnabled` array
+    inline StructOfArraysColumn<bool> DepthTestEnabledColumn() const
+    {
+        DIVE_ASSERT(m_chunks.empty());
+        const bool* data = DepthTestEnabledPtr();
+        uint32_t    stride = 1;
+        return StructOfArraysColumn<bool>(data,
+                                          m_size,
+                                          stride,
+                                          m_is_set_buffer.data(),
+                                          kNumFields,
+                                          kDepthTestEnabledIndex);
+    }
     // `DepthTestEnabled(id)` retuns the `DepthTestEnabled` element of the object identified by `id`
     inline bool DepthTestEnabled(Id id) const
     {
@@ -6076,19 +6694,28 @@ public:
     // when DepthTestEnable is false.
 
     // `DepthWriteEnabledPtr()` returns a shared pointer to an array of `size()` elements
+    // Requires contiguous storage, see `Compact()`
     inline const bool* DepthWriteEnabledPtr() const
     {
+        DIVE_ASSERT(m_chunks.empty());
         return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                        kDepthWriteEnabledOffset * m_cap);
     }
     inline bool* DepthWriteEnabledPtr()
     {
+        DIVE_ASSERT(m_chunks.empty());
         return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                        kDepthWriteEnabledOffset * m_cap);
     }
     // `DepthWriteEnabledPtr()` returns a shared pointer to an array of `size()` elements
     inline const bool* DepthWriteEnabledPtr(Id id) const
     {
+        if (static_cast<typename Id::basic_type>(id) >= m_cap)
+        {
+            typename Id::basic_type index;
+            uint8_t*                chunk = GetChunk(id, &index);
+            return reinterpret_cast<bool*>(chunk + kDepthWriteEnabledOffset * kChunkSize) + index;
+        }
         return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                        kDepthWriteEnabledOffset * m_cap) +
                static_cast<typename Id::basic_type>(id)
@@ -6097,12 +6724,31 @@ public:
     }
     inline bool* DepthWriteEnabledPtr(Id id)
     {
+        if (static_cast<typename Id::basic_type>(id) >= m_cap)
+        {
+            typename Id::basic_type index;
+            uint8_t*                chunk = GetChunk(id, &index);
+            return reinterpret_cast<bool*>(chunk + kDepthWriteEnabledOffset * kChunkSize) + index;
+        }
         return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                        kDepthWriteEnabledOffset * m_cap) +
                static_cast<typename Id::basic_type>(id)
 
         ;
     }
+    // `DepthWriteEnabledColumn()` returns a read-only view of the `DepthWriteEnabled` array
+    inline StructOfArraysColumn<bool> DepthWriteEnabledColumn() const
+    {
+        DIVE_ASSERT(m_chunks.empty());
+        const bool* data = DepthWriteEnabledPtr();
+        uint32_t    stride = 1;
+        return StructOfArraysColumn<bool>(data,
+                                          m_size,
+                                          stride,
+                                          m_is_set_buffer.data(),
+                                          kNumFields,
+                                          kDepthWriteEnabledIndex);
+    }
     // `DepthWriteEnabled(id)` retuns the `DepthWriteEnabled` element of the object identified by
     // `id`
     inline bool DepthWriteEnabled(Id id) const
@@ -6139,19 +6785,29 @@ public:
     // FIELD DepthCompareOp: Comparison operator used for the depth test
 
     // `DepthCompareOpPtr()` returns a shared pointer to an array of `size()` elements
+    // Requires contiguous storage, see `Compact()`
     inline const VkCompareOp* DepthCompareOpPtr() const
     {
+        DIVE_ASSERT(m_chunks.empty());
         return reinterpret_cast<VkCompareOp*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                               kDepthCompareOpOffset * m_cap);
     }
     inline VkCompareOp* DepthCompareOpPtr()
     {
+        DIVE_ASSERT(m_chunks.empty());
         return reinterpret_cast<VkCompareOp*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                               kDepthCompareOpOffset * m_cap);
     }
     // `DepthCompareOpPtr()` returns a shared pointer to an array of `size()` elements
     inline const VkCompareOp* DepthCompareOpPtr(Id id) const
     {
+        if (static_cast<typename Id::basic_type>(id) >= m_cap)
+        {
+            typename Id::basic_type index;
+            uint8_t*                chunk = GetChunk(id, &index);
+            return reinterpret_cast<VkCompareOp*>(chunk + kDepthCompareOpOffset * kChunkSize) +
+                   index;
+        }
         return reinterpret_cast<VkCompareOp*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                               kDepthCompareOpOffset * m_cap) +
                static_cast<typename Id::basic_type>(id)
@@ -6160,12 +6816,32 @@ public:
     }
     inline VkCompareOp* DepthCompareOpPtr(Id id)
     {
+        if (static_cast<typename Id::basic_type>(id) >= m_cap)
+        {
+            typename Id::basic_type index;
+            uint8_t*                chunk = GetChunk(id, &index);
+            return reinterpret_cast<VkCompareOp*>(chunk + kDepthCompareOpOffset * kChunkSize) +
+                   index;
+        }
         return reinterpret_cast<VkCompareOp*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                               kDepthCompareOpOffset * m_cap) +
                static_cast<typename Id::basic_type>(id)
 
         ;
     }
+    // `DepthCompareOpColumn()` returns a read-only view of the `DepthCompareOp` array
+    inline StructOfArraysColumn<VkCompareOp> DepthCompareOpColumn() const
+    {
+        DIVE_ASSERT(m_chunks.empty());
+        const VkCompareOp* data = DepthCompareOpPtr();
+        uint32_t           stride = 1;
+        return StructOfArraysColumn<VkCompareOp>(data,
+                                                 m_size,
+                                                 stride,
+                                                 m_is_set_buffer.data(),
+                                                 kNumFields,
+                                                 kDepthCompareOpIndex);
+    }
     // `DepthCompareOp(id)` retuns the `DepthCompareOp` element of the object identified by `id`
     inline VkCompareOp DepthCompareOp(Id id) const
     {
@@ -6200,19 +6876,29 @@ public:
     // FIELD DepthBoundsTestEnabled: Whether depth bounds testing is enabled
 
     // `DepthBoundsTestEnabledPtr()` returns a shared pointer to an array of `size()` elements
+    // Requires contiguous storage, see `Compact()`
     inline const bool* DepthBoundsTestEnabledPtr() const
     {
+        DIVE_ASSERT(m_chunks.empty());
         return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                        kDepthBoundsTestEnabledOffset * m_cap);
     }
     inline bool* DepthBoundsTestEnabledPtr()
     {
+        DIVE_ASSERT(m_chunks.empty());
         return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                        kDepthBoundsTestEnabledOffset * m_cap);
     }
     // `DepthBoundsTestEnabledPtr()` returns a shared pointer to an array of `size()` elements
     inline const bool* DepthBoundsTestEnabledPtr(Id id) const
     {
+        if (static_cast<typename Id::basic_type>(id) >= m_cap)
+        {
+            typename Id::basic_type index;
+            uint8_t*                chunk = GetChunk(id, &index);
+            return reinterpret_cast<bool*>(chunk + kDepthBoundsTestEnabledOffset * kChunkSize) +
+                   index;
+        }
         return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                        kDepthBoundsTestEnabledOffset * m_cap) +
                static_cast<typename Id::basic_type>(id)
@@ -6221,12 +6907,33 @@ public:
     }
     inline bool* DepthBoundsTestEnabledPtr(Id id)
     {
+        if (static_cast<typename Id::basic_type>(id) >= m_cap)
+        {
+            typename Id::basic_type index;
+            uint8_t*                chunk = GetChunk(id, &index);
+            return reinterpret_cast<bool*>(chunk + kDepthBoundsTestEnabledOffset * kChunkSize) +
+                   index;
+        }
         return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                        kDepthBoundsTestEnabledOffset * m_cap) +
                static_cast<typename Id::basic_type>(id)
 
         ;
     }
+    // `DepthBoundsTestEnabledColumn()` returns a read-only view of the `DepthBoundsTestEnabled`
+    // array
+    inline StructOfArraysColumn<bool> DepthBoundsTestEnabledColumn() const
+    {
+        DIVE_ASSERT(m_chunks.empty());
+        const bool* data = DepthBoundsTestEnabledPtr();
+        uint32_t    stride = 1;
+        return StructOfArraysColumn<bool>(data,
+                                          m_size,
+                                          stride,
+                                          m_is_set_buffer.data(),
+                                          kNumFields,
+                                          kDepthBoundsTestEnabledIndex);
+    }
     // `DepthBoundsTestEnabled(id)` retuns the `DepthBoundsTestEnabled` element of the object
     // identified by `id`
     inline bool DepthBoundsTestEnabled(Id id) const
@@ -6262,19 +6969,28 @@ public:
     // FIELD MinDepthBounds: Minimum depth bound used in the depth bounds test
 
     // `MinDepthBoundsPtr()` returns a shared pointer to an array of `size()` elements
+    // Requires contiguous storage, see `Compact()`
     inline const float* MinDepthBoundsPtr() const
     {
+        DIVE_ASSERT(m_chunks.empty());
         return reinterpret_cast<float*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                         kMinDepthBoundsOffset * m_cap);
     }
     inline float* MinDepthBoundsPtr()
     {
+        DIVE_ASSERT(m_chunks.empty());
         return reinterpret_cast<float*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                         kMinDepthBoundsOffset * m_cap);
     }
     // `MinDepthBoundsPtr()` returns a shared pointer to an array of `size()` elements
     inline const float* MinDepthBoundsPtr(Id id) const
     {
+        if (static_cast<typename Id::basic_type>(id) >= m_cap)
+        {
+            typename Id::basic_type index;
+            uint8_t*                chunk = GetChunk(id, &index);
+            return reinterpret_cast<float*>(chunk + kMinDepthBoundsOffset * kChunkSize) + index;
+        }
         return reinterpret_cast<float*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                         kMinDepthBoundsOffset * m_cap) +
                static_cast<typename Id::basic_type>(id)
@@ -6283,12 +6999,31 @@ public:
     }
     inline float* MinDepthBoundsPtr(Id id)
     {
+        if (static_cast<typename Id::basic_type>(id) >= m_cap)
+        {
+            typename Id::basic_type index;
+            uint8_t*                chunk = GetChunk(id, &index);
+            return reinterpret_cast<float*>(chunk + kMinDepthBoundsOffset * kChunkSize) + index;
+        }
         return reinterpret_cast<float*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                         kMinDepthBoundsOffset * m_cap) +
                static_cast<typename Id::basic_type>(id)
 
         ;
     }
+    // `MinDepthBoundsColumn()` returns a read-only view of the `MinDepthBounds` array
+    inline StructOfArraysColumn<float> MinDepthBoundsColumn() const
+    {
+        DIVE_ASSERT(m_chunks.empty());
+        const float* data = MinDepthBoundsPtr();
+        uint32_t     stride = 1;
+        return StructOfArraysColumn<float>(data,
+                                           m_size,
+                                           stride,
+                                           m_is_set_buffer.data(),
+                                           kNumFields,
+                                           kMinDepthBoundsIndex);
+    }
     // `MinDepthBounds(id)` retuns the `MinDepthBounds` element of the object identified by `id`
     inline float MinDepthBounds(Id id) const
     {
@@ -6323,19 +7058,28 @@ public:
     // FIELD MaxDepthBounds: Maximum depth bound used in the depth bounds test
 
     // `MaxDepthBoundsPtr()` returns a shared pointer to an array of `size()` elements
+    // Requires contiguous storage, see `Compact()`
     inline const float* MaxDepthBoundsPtr() const
     {
+        DIVE_ASSERT(m_chunks.empty());
         return reinterpret_cast<float*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                         kMaxDepthBoundsOffset * m_cap);
     }
     inline float* MaxDepthBoundsPtr()
     {
+        DIVE_ASSERT(m_chunks.empty());
         return reinterpret_cast<float*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                         kMaxDepthBoundsOffset * m_cap);
     }
     // `MaxDepthBoundsPtr()` returns a shared pointer to an array of `size()` elements
     inline const float* MaxDepthBoundsPtr(Id id) const
     {
+        if (static_cast<typename Id::basic_type>(id) >= m_cap)
+        {
+            typename Id::basic_type index;
+            uint8_t*                chunk = GetChunk(id, &index);
+            return reinterpret_cast<float*>(chunk + kMaxDepthBoundsOffset * kChunkSize) + index;
+        }
         return reinterpret_cast<float*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                         kMaxDepthBoundsOffset * m_cap) +
                static_cast<typename Id::basic_type>(id)
@@ -6344,12 +7088,31 @@ public:
     }
     inline float* MaxDepthBoundsPtr(Id id)
     {
+        if (static_cast<typename Id::basic_type>(id) >= m_cap)
+        {
+            typename Id::basic_type index;
+            uint8_t*                chunk = GetChunk(id, &index);
+            return reinterpret_cast<float*>(chunk + kMaxDepthBoundsOffset * kChunkSize) + index;
+        }
         return reinterpret_cast<float*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                         kMaxDepthBoundsOffset * m_cap) +
                static_cast<typename Id::basic_type>(id)
 
         ;
     }
+    // `MaxDepthBoundsColumn()` returns a read-only view of the `MaxDepthBounds` array
+    inline StructOfArraysColumn<float> MaxDepthBoundsColumn() const
+    {
+        DIVE_ASSERT(m_chunks.empty());
+        const float* data = MaxDepthBoundsPtr();
+        uint32_t     stride = 1;
+        return StructOfArraysColumn<float>(data,
+                                           m_size,
+                                           stride,
+                                           m_is_set_buffer.data(),
+                                           kNumFields,
+                                           kMaxDepthBoundsIndex);
+    }
     // `MaxDepthBounds(id)` retuns the `MaxDepthBounds` element of the object identified by `id`
     inline float MaxDepthBounds(Id id) const
     {
@@ -6384,19 +7147,28 @@ public:
     // FIELD StencilTestEnabled: Whether stencil testing is enabled
 
     // `StencilTestEnabledPtr()` returns a shared pointer to an array of `size()` elements
+    // Requires contiguous storage, see `Compact()`
     inline const bool* StencilTestEnabledPtr() const
     {
+        DIVE_ASSERT(m_chunks.empty());
         return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                        kStencilTestEnabledOffset * m_cap);
     }
     inline bool* StencilTestEnabledPtr()
     {
+        DIVE_ASSERT(m_chunks.empty());
         return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                        kStencilTestEnabledOffset * m_cap);
     }
     // `StencilTestEnabledPtr()` returns a shared pointer to an array of `size()` elements
     inline const bool* StencilTestEnabledPtr(Id id) const
     {
+        if (static_cast<typename Id::basic_type>(id) >= m_cap)
+        {
+            typename Id::basic_type index;
+            uint8_t*                chunk = GetChunk(id, &index);
+            return reinterpret_cast<bool*>(chunk + kStencilTestEnabledOffset * kChunkSize) + index;
+        }
         return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                        kStencilTestEnabledOffset * m_cap) +
                static_cast<typename Id::basic_type>(id)
@@ -6405,12 +7177,31 @@ public:
     }
     inline bool* StencilTestEnabledPtr(Id id)
     {
+        if (static_cast<typename Id::basic_type>(id) >= m_cap)
+        {
+            typename Id::basic_type index;
+            uint8_t*                chunk = GetChunk(id, &index);
+            return reinterpret_cast<bool*>(chunk + kStencilTestEnabledOffset * kChunkSize) + index;
+        }
         return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                        kStencilTestEnabledOffset * m_cap) +
                static_cast<typename Id::basic_type>(id)
 
         ;
     }
+    // `StencilTestEnabledColumn()` returns a read-only view of the `StencilTestEnabled` array
+    inline StructOfArraysColumn<bool> StencilTestEnabledColumn() const
+    {
+        DIVE_ASSERT(m_chunks.empty());
+        const bool* data = StencilTestEnabledPtr();
+        uint32_t    stride = 1;
+        return StructOfArraysColumn<bool>(data,
+                                          m_size,
+                                          stride,
+                                          m_is_set_buffer.data(),
+                                          kNumFields,
+                                          kStencilTestEnabledIndex);
+    }
     // `StencilTestEnabled(id)` retuns the `StencilTestEnabled` element of the object identified by
     // `id`
     inline bool StencilTestEnabled(Id id) const
@@ -6446,19 +7237,30 @@ public:
     // FIELD StencilOpStateFront: Front parameter of the stencil test
 
     // `StencilOpStateFrontPtr()` returns a shared pointer to an array of `size()` elements
+    // Requires contiguous storage, see `Compact()`
     inline const VkStencilOpState* StencilOpStateFrontPtr() const
     {
+        DIVE_ASSERT(m_chunks.empty());
         return reinterpret_cast<VkStencilOpState*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                                    kStencilOpStateFrontOffset * m_cap);
     }
     inline VkStencilOpState* StencilOpStateFrontPtr()
     {
+        DIVE_ASSERT(m_chunks.empty());
         return reinterpret_cast<VkStencilOpState*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                                    kStencilOpStateFrontOffset * m_cap);
     }
     // `StencilOpStateFrontPtr()` returns a shared pointer to an array of `size()` elements
     inline const VkStencilOpState* StencilOpStateFrontPtr(Id id) const
     {
+        if (static_cast<typename Id::basic_type>(id) >= m_cap)
+        {
+            typename Id::basic_type index;
+            uint8_t*                chunk = GetChunk(id, &index);
+            return reinterpret_cast<VkStencilOpState*>(chunk +
+                                                       kStencilOpStateFrontOffset * kChunkSize) +
+                   index;
+        }
         return reinterpret_cast<VkStencilOpState*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                                    kStencilOpStateFrontOffset * m_cap) +
                static_cast<typename Id::basic_type>(id)
@@ -6467,12 +7269,33 @@ public:
     }
     inline VkStencilOpState* StencilOpStateFrontPtr(Id id)
     {
+        if (static_cast<typename Id::basic_type>(id) >= m_cap)
+        {
+            typename Id::basic_type index;
+            uint8_t*                chunk = GetChunk(id, &index);
+            return reinterpret_cast<VkStencilOpState*>(chunk +
+                                                       kStencilOpStateFrontOffset * kChunkSize) +
+                   index;
+        }
         return reinterpret_cast<VkStencilOpState*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                                    kStencilOpStateFrontOffset * m_cap) +
                static_cast<typename Id::basic_type>(id)
 
         ;
     }
+    // `StencilOpStateFrontColumn()` returns a read-only view of the `StencilOpStateFront` array
+    inline StructOfArraysColumn<VkStencilOpState> StencilOpStateFrontColumn() const
+    {
+        DIVE_ASSERT(m_chunks.empty());
+        const VkStencilOpState* data = StencilOpStateFrontPtr();
+        uint32_t                stride = 1;
+        return StructOfArraysColumn<VkStencilOpState>(data,
+                                                      m_size,
+                                                      stride,
+                                                      m_is_set_buffer.data(),
+                                                      kNumFields,
+                                                      kStencilOpStateFrontIndex);
+    }
     // `StencilOpStateFront(id)` retuns the `StencilOpStateFront` element of the object identified
     // by `id`
     inline VkStencilOpState StencilOpStateFront(Id id) const
@@ -6508,19 +7331,30 @@ public:
     // FIELD StencilOpStateBack: Back parameter of the stencil test
 
     // `StencilOpStateBackPtr()` returns a shared pointer to an array of `size()` elements
+    // Requires contiguous storage, see `Compact()`
     inline const VkStencilOpState* StencilOpStateBackPtr() const
     {
+        DIVE_ASSERT(m_chunks.empty());
         return reinterpret_cast<VkStencilOpState*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                                    kStencilOpStateBackOffset * m_cap);
     }
     inline VkStencilOpState* StencilOpStateBackPtr()
     {
+        DIVE_ASSERT(m_chunks.empty());
         return reinterpret_cast<VkStencilOpState*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                                    kStencilOpStateBackOffset * m_cap);
     }
     // `StencilOpStateBackPtr()` returns a shared pointer to an array of `size()` elements
     inline const VkStencilOpState* StencilOpStateBackPtr(Id id) const
     {
+        if (static_cast<typename Id::basic_type>(id) >= m_cap)
+        {
+            typename Id::basic_type index;
+            uint8_t*                chunk = GetChunk(id, &index);
+            return reinterpret_cast<VkStencilOpState*>(chunk +
+                                                       kStencilOpStateBackOffset * kChunkSize) +
+                   index;
+        }
         return reinterpret_cast<VkStencilOpState*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                                    kStencilOpStateBackOffset * m_cap) +
                static_cast<typename Id::basic_type>(id)
@@ -6529,12 +7363,33 @@ public:
     }
     inline VkStencilOpState* StencilOpStateBackPtr(Id id)
     {
+        if (static_cast<typename Id::basic_type>(id) >= m_cap)
+        {
+            typename Id::basic_type index;
+            uint8_t*                chunk = GetChunk(id, &index);
+            return reinterpret_cast<VkStencilOpState*>(chunk +
+                                                       kStencilOpStateBackOffset * kChunkSize) +
+                   index;
+        }
         return reinterpret_cast<VkStencilOpState*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                                    kStencilOpStateBackOffset * m_cap) +
                static_cast<typename Id::basic_type>(id)
 
         ;
     }
+    // `StencilOpStateBackColumn()` returns a read-only view of the `StencilOpStateBack` array
+    inline StructOfArraysColumn<VkStencilOpState> StencilOpStateBackColumn() const
+    {
+        DIVE_ASSERT(m_chunks.empty());
+        const VkStencilOpState* data = StencilOpStateBackPtr();
+        uint32_t                stride = 1;
+        return StructOfArraysColumn<VkStencilOpState>(data,
+                                                      m_size,
+                                                      stride,
+                                                      m_is_set_buffer.data(),
+                                                      kNumFields,
+                                                      kStencilOpStateBackIndex);
+    }
     // `StencilOpStateBack(id)` retuns the `StencilOpStateBack` element of the object identified by
     // `id`
     inline VkStencilOpState StencilOpStateBack(Id id) const
@@ -6570,19 +7425,29 @@ public:
     // FIELD LogicOpEnabled: Whether to apply Logical Operations
 
     // `LogicOpEnabledPtr()` returns a shared pointer to an array of `size()` elements
+    // Requires contiguous storage, see `Compact()`
     inline const bool* LogicOpEnabledPtr() const
     {
+        DIVE_ASSERT(m_chunks.empty());
         return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                        kLogicOpEnabledOffset * m_cap);
     }
     inline bool* LogicOpEnabledPtr()
     {
+        DIVE_ASSERT(m_chunks.empty());
         return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                        kLogicOpEnabledOffset * m_cap);
     }
     // `LogicOpEnabledPtr()` returns a shared pointer to an array of `size()` elements
     inline const bool* LogicOpEnabledPtr(Id id, uint32_t attachment = 0) const
     {
+        if (static_cast<typename Id::basic_type>(id) >= m_cap)
+        {
+            typename Id::basic_type index;
+            uint8_t*                chunk = GetChunk(id, &index);
+            return reinterpret_cast<bool*>(chunk + kLogicOpEnabledOffset * kChunkSize) +
+                   index * 8 + attachment;
+        }
         return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                        kLogicOpEnabledOffset * m_cap) +
                static_cast<typename Id::basic_type>(id) * 8 + attachment
@@ -6591,12 +7456,32 @@ public:
     }
     inline bool* LogicOpEnabledPtr(Id id, uint32_t attachment = 0)
     {
+        if (static_cast<typename Id::basic_type>(id) >= m_cap)
+        {
+            typename Id::basic_type index;
+            uint8_t*                chunk = GetChunk(id, &index);
+            return reinterpret_cast<bool*>(chunk + kLogicOpEnabledOffset * kChunkSize) +
+                   index * 8 + attachment;
+        }
         return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                        kLogicOpEnabledOffset * m_cap) +
                static_cast<typename Id::basic_type>(id) * 8 + attachment
 
         ;
     }
+    // `LogicOpEnabledColumn()` returns a read-only view of the `LogicOpEnabled` array
+    inline StructOfArraysColumn<bool> LogicOpEnabledColumn(uint32_t attachment = 0) const
+    {
+        DIVE_ASSERT(m_chunks.empty());
+        const bool* data = LogicOpEnabledPtr(Id(0), attachment);
+        uint32_t    stride = kLogicOpEnabledArrayCount;
+        return StructOfArraysColumn<bool>(data,
+                                          m_size,
+                                          stride,
+                                          m_is_set_buffer.data(),
+                                          kNumFields,
+                                          kLogicOpEnabledIndex + attachment);
+    }
     // `LogicOpEnabled(id)` retuns the `LogicOpEnabled` element of the object identified by `id`
     inline bool LogicOpEnabled(Id id, uint32_t attachment) const
     {
@@ -6642,19 +7527,29 @@ public:
     // FIELD LogicOp: Which logical operation to apply
 
     // `LogicOpPtr()` returns a shared pointer to an array of `size()` elements
+    // Requires contiguous storage, see `Compact()`
     inline const VkLogicOp* LogicOpPtr() const
     {
+        DIVE_ASSERT(m_chunks.empty());
         return reinterpret_cast<VkLogicOp*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                             kLogicOpOffset * m_cap);
     }
     inline VkLogicOp* LogicOpPtr()
     {
+        DIVE_ASSERT(m_chunks.empty());
         return reinterpret_cast<VkLogicOp*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                             kLogicOpOffset * m_cap);
     }
     // `LogicOpPtr()` returns a shared pointer to an array of `size()` elements
     inline const VkLogicOp* LogicOpPtr(Id id, uint32_t attachment = 0) const
     {
+        if (static_cast<typename Id::basic_type>(id) >= m_cap)
+        {
+            typename Id::basic_type index;
+            uint8_t*                chunk = GetChunk(id, &index);
+            return reinterpret_cast<VkLogicOp*>(chunk + kLogicOpOffset * kChunkSize) +
+                   index * 8 + attachment;
+        }
         return reinterpret_cast<VkLogicOp*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                             kLogicOpOffset * m_cap) +
                static_cast<typename Id::basic_type>(id) * 8 + attachment
@@ -6663,12 +7558,32 @@ public:
     }
     inline VkLogicOp* LogicOpPtr(Id id, uint32_t attachment = 0)
     {
+        if (static_cast<typename Id::basic_type>(id) >= m_cap)
+        {
+            typename Id::basic_type index;
+            uint8_t*                chunk = GetChunk(id, &index);
+            return reinterpret_cast<VkLogicOp*>(chunk + kLogicOpOffset * kChunkSize) +
+                   index * 8 + attachment;
+        }
         return reinterpret_cast<VkLogicOp*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                             kLogicOpOffset * m_cap) +
                static_cast<typename Id::basic_type>(id) * 8 + attachment
 
         ;
     }
+    // `LogicOpColumn()` returns a read-only view of the `LogicOp` array
+    inline StructOfArraysColumn<VkLogicOp> LogicOpColumn(uint32_t attachment = 0) const
+    {
+        DIVE_ASSERT(m_chunks.empty());
+        const VkLogicOp* data = LogicOpPtr(Id(0), attachment);
+        uint32_t         stride = kLogicOpArrayCount;
+        return StructOfArraysColumn<VkLogicOp>(data,
+                                               m_size,
+                                               stride,
+                                               m_is_set_buffer.data(),
+                                               kNumFields,
+                                               kLogicOpIndex + attachment);
+    }
     // `LogicOp(id)` retuns the `LogicOp` element of the object identified by `id`
     inline VkLogicOp LogicOp(Id id, uint32_t attachment) const
     {
@@ -6707,13 +7622,16 @@ public:
     // FIELD Attachment: Per target attachment color blend states
 
     // `AttachmentPtr()` returns a shared pointer to an array of `size()` elements
+    // Requires contiguous storage, see `Compact()`
     inline const VkPipelineColorBlendAttachmentState* AttachmentPtr() const
     {
+        DIVE_ASSERT(m_chunks.empty());
         return reinterpret_cast<VkPipelineColorBlendAttachmentState*>(
         reinterpret_cast<uint8_t*>(m_buffer.get()) + kAttachmentOffset * m_cap);
     }
     inline VkPipelineColorBlendAttachmentState* AttachmentPtr()
     {
+        DIVE_ASSERT(m_chunks.empty());
         return reinterpret_cast<VkPipelineColorBlendAttachmentState*>(
         reinterpret_cast<uint8_t*>(m_buffer.get()) + kAttachmentOffset * m_cap);
     }
@@ -6721,6 +7639,14 @@ public:
     inline const VkPipelineColorBlendAttachmentState* AttachmentPtr(Id       id,
                                                                     uint32_t attachment = 0) const
     {
+        if (static_cast<typename Id::basic_type>(id) >= m_cap)
+        {
+            typename Id::basic_type index;
+            uint8_t*                chunk = GetChunk(id, &index);
+            return reinterpret_cast<VkPipelineColorBlendAttachmentState*>(
+                   chunk + kAttachmentOffset * kChunkSize) +
+                   index * 8 + attachment;
+        }
         return reinterpret_cast<VkPipelineColorBlendAttachmentState*>(
                reinterpret_cast<uint8_t*>(m_buffer.get()) + kAttachmentOffset * m_cap) +
                static_cast<typename Id::basic_type>(id) * 8 + attachment
@@ -6729,12 +7655,35 @@ public:
     }
     inline VkPipelineColorBlendAttachmentState* AttachmentPtr(Id id, uint32_t attachment = 0)
     {
+        if (static_cast<typename Id::basic_type>(id) >= m_cap)
+        {
+            typename Id::basic_type index;
+            uint8_t*                chunk = GetChunk(id, &index);
+            return reinterpret_cast<VkPipelineColorBlendAttachmentState*>(
+                   chunk + kAttachmentOffset * kChunkSize) +
+                   index * 8 + attachment;
+        }
         return reinterpret_cast<VkPipelineColorBlendAttachmentState*>(
                reinterpret_cast<uint8_t*>(m_buffer.get()) + kAttachmentOffset * m_cap) +
                static_cast<typename Id::basic_type>(id) * 8 + attachment
 
         ;
     }
+    // `AttachmentColumn()` returns a read-only view of the `Attachment` array
+    inline StructOfArraysColumn<VkPipelineColorBlendAttachmentState> AttachmentColumn(
+    uint32_t attachment = 0) const
+    {
+        DIVE_ASSERT(m_chunks.empty());
+        const VkPipelineColorBlendAttachmentState* data = AttachmentPtr(Id(0), attachment);
+        uint32_t                                   stride = kAttachmentArrayCount;
+        return StructOfArraysColumn<VkPipelineColorBlendAttachmentState>(
+        data,
+        m_size,
+        stride,
+        m_is_set_buffer.data(),
+        kNumFields,
+        kAttachmentIndex + attachment);
+    }
     // `Attachment(id)` retuns the `Attachment` element of the object identified by `id`
     inline VkPipelineColorBlendAttachmentState Attachment(Id id, uint32_t attachment) const
     {
@@ -6779,19 +7728,29 @@ public:
     // FIELD BlendConstant: A color constant used for blending
 
     // `BlendConstantPtr()` returns a shared pointer to an array of `size()` elements
+    // Requires contiguous storage, see `Compact()`
     inline const float* BlendConstantPtr() const
     {
+        DIVE_ASSERT(m_chunks.empty());
         return reinterpret_cast<float*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                         kBlendConstantOffset * m_cap);
     }
     inline float* BlendConstantPtr()
     {
+        DIVE_ASSERT(m_chunks.empty());
         return reinterpret_cast<float*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                         kBlendConstantOffset * m_cap);
     }
     // `BlendConstantPtr()` returns a shared pointer to an array of `size()` elements
     inline const float* BlendConstantPtr(Id id, uint32_t channel = 0) const
     {
+        if (static_cast<typename Id::basic_type>(id) >= m_cap)
+        {
+            typename Id::basic_type index;
+            uint8_t*                chunk = GetChunk(id, &index);
+            return reinterpret_cast<float*>(chunk + kBlendConstantOffset * kChunkSize) +
+                   index * 4 + channel;
+        }
         return reinterpret_cast<float*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                         kBlendConstantOffset * m_cap) +
                static_cast<typename Id::basic_type>(id) * 4 + channel
@@ -6800,12 +7759,32 @@ public:
     }
     inline float* BlendConstantPtr(Id id, uint32_t channel = 0)
     {
+        if (static_cast<typename Id::basic_type>(id) >= m_cap)
+        {
+            typename Id::basic_type index;
+            uint8_t*                chunk = GetChunk(id, &index);
+            return reinterpret_cast<float*>(chunk + kBlendConstantOffset * kChunkSize) +
+                   index * 4 + channel;
+        }
         return reinterpret_cast<float*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                         kBlendConstantOffset * m_cap) +
                static_cast<typename Id::basic_type>(id) * 4 + channel
 
         ;
     }
+    // `BlendConstantColumn()` returns a read-only view of the `BlendConstant` array
+    inline StructOfArraysColumn<float> BlendConstantColumn(uint32_t channel = 0) const
+    {
+        DIVE_ASSERT(m_chunks.empty());
+        const float* data = BlendConstantPtr(Id(0), channel);
+        uint32_t     stride = kBlendConstantArrayCount;
+        return StructOfArraysColumn<float>(data,
+                                           m_size,
+                                           stride,
+                                           m_is_set_buffer.data(),
+                                           kNumFields,
+                                           kBlendConstantIndex + channel);
+    }
     // `BlendConstant(id)` retuns the `BlendConstant` element of the object identified by `id`
     inline float BlendConstant(Id id, uint32_t channel) const
     {
@@ -6851,19 +7830,28 @@ public:
     // FIELD LRZEnabled: Whether LRZ is enabled for depth
 
     // `LRZEnabledPtr()` returns a shared pointer to an array of `size()` elements
+    // Requires contiguous storage, see `Compact()`
     inline const bool* LRZEnabledPtr() const
     {
+        DIVE_ASSERT(m_chunks.empty());
         return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                        kLRZEnabledOffset * m_cap);
     }
     inline bool* LRZEnabledPtr()
     {
+        DIVE_ASSERT(m_chunks.empty());
         return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                        kLRZEnabledOffset * m_cap);
     }
     // `LRZEnabledPtr()` returns a shared pointer to an array of `size()` elements
     inline const bool* LRZEnabledPtr(Id id) const
     {
+        if (static_cast<typename Id::basic_type>(id) >= m_cap)
+        {
+            typename Id::basic_type index;
+            uint8_t*                chunk = GetChunk(id, &index);
+            return reinterpret_cast<bool*>(chunk + kLRZEnabledOffset * kChunkSize) + index;
+        }
         return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                        kLRZEnabledOffset * m_cap) +
                static_cast<typename Id::basic_type>(id)
@@ -6872,12 +7860,31 @@ public:
     }
     inline bool* LRZEnabledPtr(Id id)
     {
+        if (static_cast<typename Id::basic_type>(id) >= m_cap)
+        {
+            typename Id::basic_type index;
+            uint8_t*                chunk = GetChunk(id, &index);
+            return reinterpret_cast<bool*>(chunk + kLRZEnabledOffset * kChunkSize) + index;
+        }
         return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                        kLRZEnabledOffset * m_cap) +
                static_cast<typename Id::basic_type>(id)
 
         ;
     }
+    // `LRZEnabledColumn()` returns a read-only view of the `LRZEnabled` array
+    inline StructOfArraysColumn<bool> LRZEnabledColumn() const
+    {
+        DIVE_ASSERT(m_chunks.empty());
+        const bool* data = LRZEnabledPtr();
+        uint32_t    stride = 1;
+        return StructOfArraysColumn<bool>(data,
+                                          m_size,
+                                          stride,
+                                          m_is_set_buffer.data(),
+                                          kNumFields,
+                                          kLRZEnabledIndex);
+    }
     // `LRZEnabled(id)` retuns the `LRZEnabled` element of the object identified by `id`
     inline bool LRZEnabled(Id id) const
     {
@@ -6911,19 +7918,28 @@ public:
     // FIELD LRZWrite: Whether LRZ write is enabled
 
     // `LRZWritePtr()` returns a shared pointer to an array of `size()` elements
+    // Requires contiguous storage, see `Compact()`
     inline const bool* LRZWritePtr() const
     {
+        DIVE_ASSERT(m_chunks.empty());
         return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                        kLRZWriteOffset * m_cap);
     }
     inline bool* LRZWritePtr()
     {
+        DIVE_ASSERT(m_chunks.empty());
         return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                        kLRZWriteOffset * m_cap);
     }
     // `LRZWritePtr()` returns a shared pointer to an array of `size()` elements
     inline const bool* LRZWritePtr(Id id) const
     {
+        if (static_cast<typename Id::basic_type>(id) >= m_cap)
+        {
+            typename Id::basic_type index;
+            uint8_t*                chunk = GetChunk(id, &index);
+            return reinterpret_cast<bool*>(chunk + kLRZWriteOffset * kChunkSize) + index;
+        }
         return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                        kLRZWriteOffset * m_cap) +
                static_cast<typename Id::basic_type>(id)
@@ -6932,12 +7948,31 @@ public:
     }
     inline bool* LRZWritePtr(Id id)
     {
+        if (static_cast<typename Id::basic_type>(id) >= m_cap)
+        {
+            typename Id::basic_type index;
+            uint8_t*                chunk = GetChunk(id, &index);
+            return reinterpret_cast<bool*>(chunk + kLRZWriteOffset * kChunkSize) + index;
+        }
         return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                        kLRZWriteOffset * m_cap) +
                static_cast<typename Id::basic_type>(id)
 
         ;
     }
+    // `LRZWriteColumn()` returns a read-only view of the `LRZWrite` array
+    inline StructOfArraysColumn<bool> LRZWriteColumn() const
+    {
+        DIVE_ASSERT(m_chunks.empty());
+        const bool* data = LRZWritePtr();
+        uint32_t    stride = 1;
+        return StructOfArraysColumn<bool>(data,
+                                          m_size,
+                                          stride,
+                                          m_is_set_buffer.data(),
+                                          kNumFields,
+                                          kLRZWriteIndex);
+    }
     // `LRZWrite(id)` retuns the `LRZWrite` element of the object identified by `id`
     inline bool LRZWrite(Id id) const
     {
@@ -6968,19 +8003,30 @@ public:
     // FIELD LRZDirStatus: LRZ direction
 
     // `LRZDirStatusPtr()` returns a shared pointer to an array of `size()` elements
+    // Requires contiguous storage, see `Compact()`
     inline const a6xx_lrz_dir_status* LRZDirStatusPtr() const
     {
+        DIVE_ASSERT(m_chunks.empty());
         return reinterpret_cast<a6xx_lrz_dir_status*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                                       kLRZDirStatusOffset * m_cap);
     }
     inline a6xx_lrz_dir_status* LRZDirStatusPtr()
     {
+        DIVE_ASSERT(m_chunks.empty());
         return reinterpret_cast<a6xx_lrz_dir_status*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                                       kLRZDirStatusOffset * m_cap);
     }
     // `LRZDirStatusPtr()` returns a shared pointer to an array of `size()` elements
     inline const a6xx_lrz_dir_status* LRZDirStatusPtr(Id id) const
     {
+        if (static_cast<typename Id::basic_type>(id) >= m_cap)
+        {
+            typename Id::basic_type index;
+            uint8_t*                chunk = GetChunk(id, &index);
+            return reinterpret_cast<a6xx_lrz_dir_status*>(chunk +
+                                                          kLRZDirStatusOffset * kChunkSize) +
+                   index;
+        }
         return reinterpret_cast<a6xx_lrz_dir_status*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                                       kLRZDirStatusOffset * m_cap) +
                static_cast<typename Id::basic_type>(id)
@@ -6989,12 +8035,33 @@ public:
     }
     inline a6xx_lrz_dir_status* LRZDirStatusPtr(Id id)
     {
+        if (static_cast<typename Id::basic_type>(id) >= m_cap)
+        {
+            typename Id::basic_type index;
+            uint8_t*                chunk = GetChunk(id, &index);
+            return reinterpret_cast<a6xx_lrz_dir_status*>(chunk +
+                                                          kLRZDirStatusOffset * kChunkSize) +
+                   index;
+        }
         return reinterpret_cast<a6xx_lrz_dir_status*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                                       kLRZDirStatusOffset * m_cap) +
                static_cast<typename Id::basic_type>(id)
 
         ;
     }
+    // `LRZDirStatusColumn()` returns a read-only view of the `LRZDirStatus` array
+    inline StructOfArraysColumn<a6xx_lrz_dir_status> LRZDirStatusColumn() const
+    {
+        DIVE_ASSERT(m_chunks.empty());
+        const a6xx_lrz_dir_status* data = LRZDirStatusPtr();
+        uint32_t                   stride = 1;
+        return StructOfArraysColumn<a6xx_lrz_dir_status>(data,
+                                                         m_size,
+                                                         stride,
+                                                         m_is_set_buffer.data(),
+                                                         kNumFields,
+                                                         kLRZDirStatusIndex);
+    }
     // `LRZDirStatus(id)` retuns the `LRZDirStatus` element of the object identified by `id`
     inline a6xx_lrz_dir_status LRZDirStatus(Id id) const
     {
@@ -7025,19 +8092,28 @@ public:
     // FIELD LRZDirWrite: Whether LRZ direction write is enabled
 
     // `LRZDirWritePtr()` returns a shared pointer to an array of `size()` elements
+    // Requires contiguous storage, see `Compact()`
     inline const bool* LRZDirWritePtr() const
     {
+        DIVE_ASSERT(m_chunks.empty());
         return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                        kLRZDirWriteOffset * m_cap);
     }
     inline bool* LRZDirWritePtr()
     {
+        DIVE_ASSERT(m_chunks.empty());
         return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                        kLRZDirWriteOffset * m_cap);
     }
     // `LRZDirWritePtr()` returns a shared pointer to an array of `size()` elements
     inline const bool* LRZDirWritePtr(Id id) const
     {
+        if (static_cast<typename Id::basic_type>(id) >= m_cap)
+        {
+            typename Id::basic_type index;
+            uint8_t*                chunk = GetChunk(id, &index);
+            return reinterpret_cast<bool*>(chunk + kLRZDirWriteOffset * kChunkSize) + index;
+        }
         return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                        kLRZDirWriteOffset * m_cap) +
                static_cast<typename Id::basic_type>(id)
@@ -7046,12 +8122,31 @@ public:
     }
     inline bool* LRZDirWritePtr(Id id)
     {
+        if (static_cast<typename Id::basic_type>(id) >= m_cap)
+        {
+            typename Id::basic_type index;
+            uint8_t*                chunk = GetChunk(id, &index);
+            return reinterpret_cast<bool*>(chunk + kLRZDirWriteOffset * kChunkSize) + index;
+        }
         return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                        kLRZDirWriteOffset * m_cap) +
                static_cast<typename Id::basic_type>(id)
 
         ;
     }
+    // `LRZDirWriteColumn()` returns a read-only view of the `LRZDirWrite` array
+    inline StructOfArraysColumn<bool> LRZDirWriteColumn() const
+    {
+        DIVE_ASSERT(m_chunks.empty());
+        const bool* data = LRZDirWritePtr();
+        uint32_t    stride = 1;
+        return StructOfArraysColumn<bool>(data,
+                                          m_size,
+                                          stride,
+                                          m_is_set_buffer.data(),
+                                          kNumFields,
+                                          kLRZDirWriteIndex);
+    }
     // `LRZDirWrite(id)` retuns the `LRZDirWrite` element of the object identified by `id`
     inline bool LRZDirWrite(Id id) const
     {
@@ -7085,19 +8180,29 @@ public:
     // FIELD ZTestMode: Depth test mode
 
     // `ZTestModePtr()` returns a shared pointer to an array of `size()` elements
+    // Requires contiguous storage, see `Compact()`
     inline const a6xx_ztest_mode* ZTestModePtr() const
     {
+        DIVE_ASSERT(m_chunks.empty());
         return reinterpret_cast<a6xx_ztest_mode*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                                   kZTestModeOffset * m_cap);
     }
     inline a6xx_ztest_mode* ZTestModePtr()
     {
+        DIVE_ASSERT(m_chunks.empty());
         return reinterpret_cast<a6xx_ztest_mode*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                                   kZTestModeOffset * m_cap);
     }
     // `ZTestModePtr()` returns a shared pointer to an array of `size()` elements
     inline const a6xx_ztest_mode* ZTestModePtr(Id id) const
     {
+        if (static_cast<typename Id::basic_type>(id) >= m_cap)
+        {
+            typename Id::basic_type index;
+            uint8_t*                chunk = GetChunk(id, &index);
+            return reinterpret_cast<a6xx_ztest_mode*>(chunk + kZTestModeOffset * kChunkSize) +
+                   index;
+        }
         return reinterpret_cast<a6xx_ztest_mode*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                                   kZTestModeOffset * m_cap) +
                static_cast<typename Id::basic_type>(id)
@@ -7106,12 +8211,32 @@ public:
     }
     inline a6xx_ztest_mode* ZTestModePtr(Id id)
     {
+        if (static_cast<typename Id::basic_type>(id) >= m_cap)
+        {
+            typename Id::basic_type index;
+            uint8_t*                chunk = GetChunk(id, &index);
+            return reinterpret_cast<a6xx_ztest_mode*>(chunk + kZTestModeOffset * kChunkSize) +
+                   index;
+        }
         return reinterpret_cast<a6xx_ztest_mode*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                                   kZTestModeOffset * m_cap) +
                static_cast<typename Id::basic_type>(id)
 
         ;
     }
+    // `ZTestModeColumn()` returns a read-only view of the `ZTestMode` array
+    inline StructOfArraysColumn<a6xx_ztest_mode> ZTestModeColumn() const
+    {
+        DIVE_ASSERT(m_chunks.empty());
+        const a6xx_ztest_mode* data = ZTestModePtr();
+        uint32_t               stride = 1;
+        return StructOfArraysColumn<a6xx_ztest_mode>(data,
+                                                     m_size,
+                                                     stride,
+                                                     m_is_set_buffer.data(),
+                                                     kNumFields,
+                                                     kZTestModeIndex);
+    }
     // `ZTestMode(id)` retuns the `ZTestMode` element of the object identified by `id`
     inline a6xx_ztest_mode ZTestMode(Id id) const
     {
@@ -7142,19 +8267,28 @@ public:
     // FIELD BinW: Bin width
 
     // `BinWPtr()` returns a shared pointer to an array of `size()` elements
+    // Requires contiguous storage, see `Compact()`
     inline const uint32_t* BinWPtr() const
     {
+        DIVE_ASSERT(m_chunks.empty());
         return reinterpret_cast<uint32_t*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                            kBinWOffset * m_cap);
     }
     inline uint32_t* BinWPtr()
     {
+        DIVE_ASSERT(m_chunks.empty());
         return reinterpret_cast<uint32_t*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                            kBinWOffset * m_cap);
     }
     // `BinWPtr()` returns a shared pointer to an array of `size()` elements
     inline const uint32_t* BinWPtr(Id id) const
     {
+        if (static_cast<typename Id::basic_type>(id) >= m_cap)
+        {
+            typename Id::basic_type index;
+            uint8_t*                chunk = GetChunk(id, &index);
+            return reinterpret_cast<uint32_t*>(chunk + kBinWOffset * kChunkSize) + index;
+        }
         return reinterpret_cast<uint32_t*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                            kBinWOffset * m_cap) +
                static_cast<typename Id::basic_type>(id)
@@ -7163,12 +8297,31 @@ public:
     }
     inline uint32_t* BinWPtr(Id id)
     {
+        if (static_cast<typename Id::basic_type>(id) >= m_cap)
+        {
+            typename Id::basic_type index;
+            uint8_t*                chunk = GetChunk(id, &index);
+            return reinterpret_cast<uint32_t*>(chunk + kBinWOffset * kChunkSize) + index;
+        }
         return reinterpret_cast<uint32_t*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                            kBinWOffset * m_cap) +
                static_cast<typename Id::basic_type>(id)
 
         ;
     }
+    // `BinWColumn()` returns a read-only view of the `BinW` array
+    inline StructOfArraysColumn<uint32_t> BinWColumn() const
+    {
+        DIVE_ASSERT(m_chunks.empty());
+        const uint32_t* data = BinWPtr();
+        uint32_t        stride = 1;
+        return StructOfArraysColumn<uint32_t>(data,
+                                              m_size,
+                                              stride,
+                                              m_is_set_buffer.data(),
+                                              kNumFields,
+                                              kBinWIndex);
+    }
     // `BinW(id)` retuns the `BinW` element of the object identified by `id`
     inline uint32_t BinW(Id id) const
     {
@@ -7199,19 +8352,28 @@ public:
     // FIELD BinH: Bin Height
 
     // `BinHPtr()` returns a shared pointer to an array of `size()` elements
+    // Requires contiguous storage, see `Compact()`
     inline const uint32_t* BinHPtr() const
     {
+        DIVE_ASSERT(m_chunks.empty());
         return reinterpret_cast<uint32_t*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                            kBinHOffset * m_cap);
     }
     inline uint32_t* BinHPtr()
     {
+        DIVE_ASSERT(m_chunks.empty());
         return reinterpret_cast<uint32_t*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                            kBinHOffset * m_cap);
     }
     // `BinHPtr()` returns a shared pointer to an array of `size()` elements
     inline const uint32_t* BinHPtr(Id id) const
     {
+        if (static_cast<typename Id::basic_type>(id) >= m_cap)
+        {
+            typename Id::basic_type index;
+            uint8_t*                chunk = GetChunk(id, &index);
+            return reinterpret_cast<uint32_t*>(chunk + kBinHOffset * kChunkSize) + index;
+        }
         return reinterpret_cast<uint32_t*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                            kBinHOffset * m_cap) +
                static_cast<typename Id::basic_type>(id)
@@ -7220,12 +8382,31 @@ public:
     }
     inline uint32_t* BinHPtr(Id id)
     {
+        if (static_cast<typename Id::basic_type>(id) >= m_cap)
+        {
+            typename Id::basic_type index;
+            uint8_t*                chunk = GetChunk(id, &index);
+            return reinterpret_cast<uint32_t*>(chunk + kBinHOffset * kChunkSize) + index;
+        }
         return reinterpret_cast<uint32_t*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                            kBinHOffset * m_cap) +
                static_cast<typename Id::basic_type>(id)
 
         ;
     }
+    // `BinHColumn()` returns a read-only view of the `BinH` array
+    inline StructOfArraysColumn<uint32_t> BinHColumn() const
+    {
+        DIVE_ASSERT(m_chunks.empty());
+        const uint32_t* data = BinHPtr();
+        uint32_t        stride = 1;
+        return StructOfArraysColumn<uint32_t>(data,
+                                              m_size,
+                                              stride,
+                                              m_is_set_buffer.data(),
+                                              kNumFields,
+                                              kBinHIndex);
+    }
     // `BinH(id)` retuns the `BinH` element of the object identified by `id`
     inline uint32_t BinH(Id id) const
     {
@@ -7256,19 +8437,29 @@ public:
     // FIELD WindowScissorTLX: Window scissor Top Left X-coordinate
 
     // `WindowScissorTLXPtr()` returns a shared pointer to an array of `size()` elements
+    // Requires contiguous storage, see `Compact()`
     inline const uint16_t* WindowScissorTLXPtr() const
     {
+        DIVE_ASSERT(m_chunks.empty());
         return reinterpret_cast<uint16_t*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                            kWindowScissorTLXOffset * m_cap);
     }
     inline uint16_t* WindowScissorTLXPtr()
     {
+        DIVE_ASSERT(m_chunks.empty());
         return reinterpret_cast<uint16_t*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                            kWindowScissorTLXOffset * m_cap);
     }
     // `WindowScissorTLXPtr()` returns a shared pointer to an array of `size()` elements
     inline const uint16_t* WindowScissorTLXPtr(Id id) const
     {
+        if (static_cast<typename Id::basic_type>(id) >= m_cap)
+        {
+            typename Id::basic_type index;
+            uint8_t*                chunk = GetChunk(id, &index);
+            return reinterpret_cast<uint16_t*>(chunk + kWindowScissorTLXOffset * kChunkSize) +
+                   index;
+        }
         return reinterpret_cast<uint16_t*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                            kWindowScissorTLXOffset * m_cap) +
                static_cast<typename Id::basic_type>(id)
@@ -7277,12 +8468,32 @@ public:
     }
     inline uint16_t* WindowScissorTLXPtr(Id id)
     {
+        if (static_cast<typename Id::basic_type>(id) >= m_cap)
+        {
+            typename Id::basic_type index;
+            uint8_t*                chunk = GetChunk(id, &index);
+            return reinterpret_cast<uint16_t*>(chunk + kWindowScissorTLXOffset * kChunkSize) +
+                   index;
+        }
         return reinterpret_cast<uint16_t*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                            kWindowScissorTLXOffset * m_cap) +
                static_cast<typename Id::basic_type>(id)
 
         ;
     }
+    // `WindowScissorTLXColumn()` returns a read-only view of the `WindowScissorTLX` array
+    inline StructOfArraysColumn<uint16_t> WindowScissorTLXColumn() const
+    {
+        DIVE_ASSERT(m_chunks.empty());
+        const uint16_t* data = WindowScissorTLXPtr();
+        uint32_t        stride = 1;
+        return StructOfArraysColumn<uint16_t>(data,
+                                              m_size,
+                                              stride,
+                                              m_is_set_buffer.data(),
+                                              kNumFields,
+                                              kWindowScissorTLXIndex);
+    }
     // `WindowScissorTLX(id)` retuns the `WindowScissorTLX` element of the object identified by `id`
     inline uint16_t WindowScissorTLX(Id id) const
     {
@@ -7317,19 +8528,29 @@ public:
     // FIELD WindowScissorTLY: Window scissor Top Left Y-coordinate
 
     // `WindowScissorTLYPtr()` returns a shared pointer to an array of `size()` elements
+    // Requires contiguous storage, see `Compact()`
     inline const uint16_t* WindowScissorTLYPtr() const
     {
+        DIVE_ASSERT(m_chunks.empty());
         return reinterpret_cast<uint16_t*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                            kWindowScissorTLYOffset * m_cap);
     }
     inline uint16_t* WindowScissorTLYPtr()
     {
+        DIVE_ASSERT(m_chunks.empty());
         return reinterpret_cast<uint16_t*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                            kWindowScissorTLYOffset * m_cap);
     }
     // `WindowScissorTLYPtr()` returns a shared pointer to an array of `size()` elements
     inline const uint16_t* WindowScissorTLYPtr(Id id) const
     {
+        if (static_cast<typename Id::basic_type>(id) >= m_cap)
+        {
+            typename Id::basic_type index;
+            uint8_t*                chunk = GetChunk(id, &index);
+            return reinterpret_cast<uint16_t*>(chunk + kWindowScissorTLYOffset * kChunkSize) +
+                   index;
+        }
         return reinterpret_cast<uint16_t*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                            kWindowScissorTLYOffset * m_cap) +
                static_cast<typename Id::basic_type>(id)
@@ -7338,12 +8559,32 @@ public:
     }
     inline uint16_t* WindowScissorTLYPtr(Id id)
     {
+        if (static_cast<typename Id::basic_type>(id) >= m_cap)
+        {
+            typename Id::basic_type index;
+            uint8_t*                chunk = GetChunk(id, &index);
+            return reinterpret_cast<uint16_t*>(chunk + kWindowScissorTLYOffset * kChunkSize) +
+                   index;
+        }
         return reinterpret_cast<uint16_t*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                            kWindowScissorTLYOffset * m_cap) +
                static_cast<typename Id::basic_type>(id)
 
         ;
     }
+    // `WindowScissorTLYColumn()` returns a read-only view of the `WindowScissorTLY` array
+    inline StructOfArraysColumn<uint16_t> WindowScissorTLYColumn() const
+    {
+        DIVE_ASSERT(m_chunks.empty());
+        const uint16_t* data = WindowScissorTLYPtr();
+        uint32_t        stride = 1;
+        return StructOfArraysColumn<uint16_t>(data,
+                                              m_size,
+                                              stride,
+                                              m_is_set_buffer.data(),
+                                              kNumFields,
+                                              kWindowScissorTLYIndex);
+    }
     // `WindowScissorTLY(id)` retuns the `WindowScissorTLY` element of the object identified by `id`
     inline uint16_t WindowScissorTLY(Id id) const
     {
@@ -7378,19 +8619,29 @@ public:
     // FIELD WindowScissorBRX: Window scissor Bottom Right X-coordinate
 
     // `WindowScissorBRXPtr()` returns a shared pointer to an array of `size()` elements
+    // Requires contiguous storage, see `Compact()`
     inline const uint16_t* WindowScissorBRXPtr() const
     {
+        DIVE_ASSERT(m_chunks.empty());
         return reinterpret_cast<uint16_t*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                            kWindowScissorBRXOffset * m_cap);
     }
     inline uint16_t* WindowScissorBRXPtr()
     {
+        DIVE_ASSERT(m_chunks.empty());
         return reinterpret_cast<uint16_t*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                            kWindowScissorBRXOffset * m_cap);
     }
     // `WindowScissorBRXPtr()` returns a shared pointer to an array of `size()` elements
     inline const uint16_t* WindowScissorBRXPtr(Id id) const
     {
+        if (static_cast<typename Id::basic_type>(id) >= m_cap)
+        {
+            typename Id::basic_type index;
+            uint8_t*                chunk = GetChunk(id, &index);
+            return reinterpret_cast<uint16_t*>(chunk + kWindowScissorBRXOffset * kChunkSize) +
+                   index;
+        }
         return reinterpret_cast<uint16_t*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                            kWindowScissorBRXOffset * m_cap) +
                static_cast<typename Id::basic_type>(id)
@@ -7399,12 +8650,32 @@ public:
     }
     inline uint16_t* WindowScissorBRXPtr(Id id)
     {
+        if (static_cast<typename Id::basic_type>(id) >= m_cap)
+        {
+            typename Id::basic_type index;
+            uint8_t*                chunk = GetChunk(id, &index);
+            return reinterpret_cast<uint16_t*>(chunk + kWindowScissorBRXOffset * kChunkSize) +
+                   index;
+        }
         return reinterpret_cast<uint16_t*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                            kWindowScissorBRXOffset * m_cap) +
                static_cast<typename Id::basic_type>(id)
 
         ;
     }
+    // `WindowScissorBRXColumn()` returns a read-only view of the `WindowScissorBRX` array
+    inline StructOfArraysColumn<uint16_t> WindowScissorBRXColumn() const
+    {
+        DIVE_ASSERT(m_chunks.empty());
+        const uint16_t* data = WindowScissorBRXPtr();
+        uint32_t        stride = 1;
+        return StructOfArraysColumn<uint16_t>(data,
+                                              m_size,
+                                              stride,
+                                              m_is_set_buffer.data(),
+                                              kNumFields,
+                                              kWindowScissorBRXIndex);
+    }
     // `WindowScissorBRX(id)` retuns the `WindowScissorBRX` element of the object identified by `id`
     inline uint16_t WindowScissorBRX(Id id) const
     {
@@ -7439,19 +8710,29 @@ public:
     // FIELD WindowScissorBRY: Window scissor Bottom Right Y-coordinate
 
     // `WindowScissorBRYPtr()` returns a shared pointer to an array of `size()` elements
+    // Requires contiguous storage, see `Compact()`
     inline const uint16_t* WindowScissorBRYPtr() const
     {
+        DIVE_ASSERT(m_chunks.empty());
         return reinterpret_cast<uint16_t*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                            kWindowScissorBRYOffset * m_cap);
     }
     inline uint16_t* WindowScissorBRYPtr()
     {
+        DIVE_ASSERT(m_chunks.empty());
         return reinterpret_cast<uint16_t*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                            kWindowScissorBRYOffset * m_cap);
     }
     // `WindowScissorBRYPtr()` returns a shared pointer to an array of `size()` elements
     inline const uint16_t* WindowScissorBRYPtr(Id id) const
     {
+        if (static_cast<typename Id::basic_type>(id) >= m_cap)
+        {
+            typename Id::basic_type index;
+            uint8_t*                chunk = GetChunk(id, &index);
+            return reinterpret_cast<uint16_t*>(chunk + kWindowScissorBRYOffset * kChunkSize) +
+                   index;
+        }
         return reinterpret_cast<uint16_t*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                            kWindowScissorBRYOffset * m_cap) +
                static_cast<typename Id::basic_type>(id)
@@ -7460,12 +8741,32 @@ public:
     }
     inline uint16_t* WindowScissorBRYPtr(Id id)
     {
+        if (static_cast<typename Id::basic_type>(id) >= m_cap)
+        {
+            typename Id::basic_type index;
+            uint8_t*                chunk = GetChunk(id, &index);
+            return reinterpret_cast<uint16_t*>(chunk + kWindowScissorBRYOffset * kChunkSize) +
+                   index;
+        }
         return reinterpret_cast<uint16_t*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                            kWindowScissorBRYOffset * m_cap) +
                static_cast<typename Id::basic_type>(id)
 
         ;
     }
+    // `WindowScissorBRYColumn()` returns a read-only view of the `WindowScissorBRY` array
+    inline StructOfArraysColumn<uint16_t> WindowScissorBRYColumn() const
+    {
+        DIVE_ASSERT(m_chunks.empty());
+        const uint16_t* data = WindowScissorBRYPtr();
+        uint32_t        stride = 1;
+        return StructOfArraysColumn<uint16_t>(data,
+                                              m_size,
+                                              stride,
+                                              m_is_set_buffer.data(),
+                                              kNumFields,
+                                              kWindowScissorBRYIndex);
+    }
     // `WindowScissorBRY(id)` retuns the `WindowScissorBRY` element of the object identified by `id`
     inline uint16_t WindowScissorBRY(Id id) const
     {
@@ -7500,19 +8801,29 @@ public:
     // FIELD RenderMode: Whether in binning pass or rendering pass
 
     // `RenderModePtr()` returns a shared pointer to an array of `size()` elements
+    // Requires contiguous storage, see `Compact()`
     inline const a6xx_render_mode* RenderModePtr() const
     {
+        DIVE_ASSERT(m_chunks.empty());
         return reinterpret_cast<a6xx_render_mode*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                                    kRenderModeOffset * m_cap);
     }
     inline a6xx_render_mode* RenderModePtr()
     {
+        DIVE_ASSERT(m_chunks.empty());
         return reinterpret_cast<a6xx_render_mode*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                                    kRenderModeOffset * m_cap);
     }
     // `RenderModePtr()` returns a shared pointer to an array of `size()` elements
     inline const a6xx_render_mode* RenderModePtr(Id id) const
     {
+        if (static_cast<typename Id::basic_type>(id) >= m_cap)
+        {
+            typename Id::basic_type index;
+            uint8_t*                chunk = GetChunk(id, &index);
+            return reinterpret_cast<a6xx_render_mode*>(chunk + kRenderModeOffset * kChunkSize) +
+                   index;
+        }
         return reinterpret_cast<a6xx_render_mode*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                                    kRenderModeOffset * m_cap) +
                static_cast<typename Id::basic_type>(id)
@@ -7521,12 +8832,32 @@ public:
     }
     inline a6xx_render_mode* RenderModePtr(Id id)
     {
+        if (static_cast<typename Id::basic_type>(id) >= m_cap)
+        {
+            typename Id::basic_type index;
+            uint8_t*                chunk = GetChunk(id, &index);
+            return reinterpret_cast<a6xx_render_mode*>(chunk + kRenderModeOffset * kChunkSize) +
+                   index;
+        }
         return reinterpret_cast<a6xx_render_mode*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                                    kRenderModeOffset * m_cap) +
                static_cast<typename Id::basic_type>(id)
 
         ;
     }
+    // `RenderModeColumn()` returns a read-only view of the `RenderMode` array
+    inline StructOfArraysColumn<a6xx_render_mode> RenderModeColumn() const
+    {
+        DIVE_ASSERT(m_chunks.empty());
+        const a6xx_render_mode* data = RenderModePtr();
+        uint32_t                stride = 1;
+        return StructOfArraysColumn<a6xx_render_mode>(data,
+                                                      m_size,
+                                                      stride,
+                                                      m_is_set_buffer.data(),
+                                                      kNumFields,
+                                                      kRenderModeIndex);
+    }
     // `RenderMode(id)` retuns the `RenderMode` element of the object identified by `id`
     inline a6xx_render_mode RenderMode(Id id) const
     {
@@ -7560,19 +8891,30 @@ public:
     // FIELD BuffersLocation: Whether the target buffer is in GMEM or SYSMEM
 
     // `BuffersLocationPtr()` returns a shared pointer to an array of `size()` elements
+    // Requires contiguous storage, see `Compact()`
     inline const a6xx_buffers_location* BuffersLocationPtr() const
     {
+        DIVE_ASSERT(m_chunks.empty());
         return reinterpret_cast<a6xx_buffers_location*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                                         kBuffersLocationOffset * m_cap);
     }
     inline a6xx_buffers_location* BuffersLocationPtr()
     {
+        DIVE_ASSERT(m_chunks.empty());
         return reinterpret_cast<a6xx_buffers_location*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                                         kBuffersLocationOffset * m_cap);
     }
     // `BuffersLocationPtr()` returns a shared pointer to an array of `size()` elements
     inline const a6xx_buffers_location* BuffersLocationPtr(Id id) const
     {
+        if (static_cast<typename Id::basic_type>(id) >= m_cap)
+        {
+            typename Id::basic_type index;
+            uint8_t*                chunk = GetChunk(id, &index);
+            return reinterpret_cast<a6xx_buffers_location*>(chunk +
+                                                            kBuffersLocationOffset * kChunkSize) +
+                   index;
+        }
         return reinterpret_cast<a6xx_buffers_location*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                                         kBuffersLocationOffset * m_cap) +
                static_cast<typename Id::basic_type>(id)
@@ -7581,12 +8923,33 @@ public:
     }
     inline a6xx_buffers_location* BuffersLocationPtr(Id id)
     {
+        if (static_cast<typename Id::basic_type>(id) >= m_cap)
+        {
+            typename Id::basic_type index;
+            uint8_t*                chunk = GetChunk(id, &index);
+            return reinterpret_cast<a6xx_buffers_location*>(chunk +
+                                                            kBuffersLocationOffset * kChunkSize) +
+                   index;
+        }
         return reinterpret_cast<a6xx_buffers_location*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                                         kBuffersLocationOffset * m_cap) +
                static_cast<typename Id::basic_type>(id)
 
         ;
     }
+    // `BuffersLocationColumn()` returns a read-only view of the `BuffersLocation` array
+    inline StructOfArraysColumn<a6xx_buffers_location> BuffersLocationColumn() const
+    {
+        DIVE_ASSERT(m_chunks.empty());
+        const a6xx_buffers_location* data = BuffersLocationPtr();
+        uint32_t                     stride = 1;
+        return StructOfArraysColumn<a6xx_buffers_location>(data,
+                                                           m_size,
+                                                           stride,
+                                                           m_is_set_buffer.data(),
+                                                           kNumFields,
+                                                           kBuffersLocationIndex);
+    }
     // `BuffersLocation(id)` retuns the `BuffersLocation` element of the object identified by `id`
     inline a6xx_buffers_location BuffersLocation(Id id) const
     {
@@ -7621,19 +8984,29 @@ public:
     // FIELD ThreadSize: Whether the thread size is 64 or 128
 
     // `ThreadSizePtr()` returns a shared pointer to an array of `size()` elements
+    // Requires contiguous storage, see `Compact()`
     inline const a6xx_threadsize* ThreadSizePtr() const
     {
+        DIVE_ASSERT(m_chunks.empty());
         return reinterpret_cast<a6xx_threadsize*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                                   kThreadSizeOffset * m_cap);
     }
     inline a6xx_threadsize* ThreadSizePtr()
     {
+        DIVE_ASSERT(m_chunks.empty());
         return reinterpret_cast<a6xx_threadsize*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                                   kThreadSizeOffset * m_cap);
     }
     // `ThreadSizePtr()` returns a shared pointer to an array of `size()` elements
     inline const a6xx_threadsize* ThreadSizePtr(Id id) const
     {
+        if (static_cast<typename Id::basic_type>(id) >= m_cap)
+        {
+            typename Id::basic_type index;
+            uint8_t*                chunk = GetChunk(id, &index);
+            return reinterpret_cast<a6xx_threadsize*>(chunk + kThreadSizeOffset * kChunkSize) +
+                   index;
+        }
         return reinterpret_cast<a6xx_threadsize*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                                   kThreadSizeOffset * m_cap) +
                static_cast<typename Id::basic_type>(id)
@@ -7642,12 +9015,32 @@ public:
     }
     inline a6xx_threadsize* ThreadSizePtr(Id id)
     {
+        if (static_cast<typename Id::basic_type>(id) >= m_cap)
+        {
+            typename Id::basic_type index;
+            uint8_t*                chunk = GetChunk(id, &index);
+            return reinterpret_cast<a6xx_threadsize*>(chunk + kThreadSizeOffset * kChunkSize) +
+                   index;
+        }
         return reinterpret_cast<a6xx_threadsize*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                                   kThreadSizeOffset * m_cap) +
                static_cast<typename Id::basic_type>(id)
 
         ;
     }
+    // `ThreadSizeColumn()` returns a read-only view of the `ThreadSize` array
+    inline StructOfArraysColumn<a6xx_threadsize> ThreadSizeColumn() const
+    {
+        DIVE_ASSERT(m_chunks.empty());
+        const a6xx_threadsize* data = ThreadSizePtr();
+        uint32_t               stride = 1;
+        return StructOfArraysColumn<a6xx_threadsize>(data,
+                                                     m_size,
+                                                     stride,
+                                                     m_is_set_buffer.data(),
+                                                     kNumFields,
+                                                     kThreadSizeIndex);
+    }
     // `ThreadSize(id)` retuns the `ThreadSize` element of the object identified by `id`
     inline a6xx_threadsize ThreadSize(Id id) const
     {
@@ -7682,19 +9075,29 @@ public:
     // derivatives
 
     // `EnableAllHelperLanesPtr()` returns a shared pointer to an array of `size()` elements
+    // Requires contiguous storage, see `Compact()`
     inline const bool* EnableAllHelperLanesPtr() const
     {
+        DIVE_ASSERT(m_chunks.empty());
         return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                        kEnableAllHelperLanesOffset * m_cap);
     }
     inline bool* EnableAllHelperLanesPtr()
     {
+        DIVE_ASSERT(m_chunks.empty());
         return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                        kEnableAllHelperLanesOffset * m_cap);
     }
     // `EnableAllHelperLanesPtr()` returns a shared pointer to an array of `size()` elements
     inline const bool* EnableAllHelperLanesPtr(Id id) const
     {
+        if (static_cast<typename Id::basic_type>(id) >= m_cap)
+        {
+            typename Id::basic_type index;
+            uint8_t*                chunk = GetChunk(id, &index);
+            return reinterpret_cast<bool*>(chunk + kEnableAllHelperLanesOffset * kChunkSize) +
+                   index;
+        }
         return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                        kEnableAllHelperLanesOffset * m_cap) +
                static_cast<typename Id::basic_type>(id)
@@ -7703,12 +9106,32 @@ public:
     }
     inline bool* EnableAllHelperLanesPtr(Id id)
     {
+        if (static_cast<typename Id::basic_type>(id) >= m_cap)
+        {
+            typename Id::basic_type index;
+            uint8_t*                chunk = GetChunk(id, &index);
+            return reinterpret_cast<bool*>(chunk + kEnableAllHelperLanesOffset * kChunkSize) +
+                   index;
+        }
         return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                        kEnableAllHelperLanesOffset * m_cap) +
                static_cast<typename Id::basic_type>(id)
 
         ;
     }
+    // `EnableAllHelperLanesColumn()` returns a read-only view of the `EnableAllHelperLanes` array
+    inline StructOfArraysColumn<bool> EnableAllHelperLanesColumn() const
+    {
+        DIVE_ASSERT(m_chunks.empty());
+        const bool* data = EnableAllHelperLanesPtr();
+        uint32_t    stride = 1;
+        return StructOfArraysColumn<bool>(data,
+                                          m_size,
+                                          stride,
+                                          m_is_set_buffer.data(),
+                                          kNumFields,
+                                          kEnableAllHelperLanesIndex);
+    }
     // `EnableAllHelperLanes(id)` retuns the `EnableAllHelperLanes` element of the object identified
     // by `id`
     inline bool EnableAllHelperLanes(Id id) const
@@ -7745,19 +9168,29 @@ public:
     // for coarse derivatives
 
     // `EnablePartialHelperLanesPtr()` returns a shared pointer to an array of `size()` elements
+    // Requires contiguous storage, see `Compact()`
     inline const bool* EnablePartialHelperLanesPtr() const
     {
+        DIVE_ASSERT(m_chunks.empty());
         return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                        kEnablePartialHelperLanesOffset * m_cap);
     }
     inline bool* EnablePartialHelperLanesPtr()
     {
+        DIVE_ASSERT(m_chunks.empty());
         return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                        kEnablePartialHelperLanesOffset * m_cap);
     }
     // `EnablePartialHelperLanesPtr()` returns a shared pointer to an array of `size()` elements
     inline const bool* EnablePartialHelperLanesPtr(Id id) const
     {
+        if (static_cast<typename Id::basic_type>(id) >= m_cap)
+        {
+            typename Id::basic_type index;
+            uint8_t*                chunk = GetChunk(id, &index);
+            return reinterpret_cast<bool*>(chunk + kEnablePartialHelperLanesOffset * kChunkSize) +
+                   index;
+        }
         return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                        kEnablePartialHelperLanesOffset * m_cap) +
                static_cast<typename Id::basic_type>(id)
@@ -7766,12 +9199,33 @@ public:
     }
     inline bool* EnablePartialHelperLanesPtr(Id id)
     {
+        if (static_cast<typename Id::basic_type>(id) >= m_cap)
+        {
+            typename Id::basic_type index;
+            uint8_t*                chunk = GetChunk(id, &index);
+            return reinterpret_cast<bool*>(chunk + kEnablePartialHelperLanesOffset * kChunkSize) +
+                   index;
+        }
         return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                        kEnablePartialHelperLanesOffset * m_cap) +
                static_cast<typename Id::basic_type>(id)
 
         ;
     }
+    // `EnablePartialHelperLanesColumn()` returns a read-only view of the `EnablePartialHelperLanes`
+    // array
+    inline StructOfArraysColumn<bool> EnablePartialHelperLanesColumn() const
+    {
+        DIVE_ASSERT(m_chunks.empty());
+        const bool* data = EnablePartialHelperLanesPtr();
+        uint32_t    stride = 1;
+        return StructOfArraysColumn<bool>(data,
+                                          m_size,
+                                          stride,
+                                          m_is_set_buffer.data(),
+                                          kNumFields,
+                                          kEnablePartialHelperLanesIndex);
+    }
     // `EnablePartialHelperLanes(id)` retuns the `EnablePartialHelperLanes` element of the object
     // identified by `id`
     inline bool EnablePartialHelperLanes(Id id) const
@@ -7810,19 +9264,29 @@ public:
     // FIELD UBWCEnabled: Whether UBWC is enabled for this attachment
 
     // `UBWCEnabledPtr()` returns a shared pointer to an array of `size()` elements
+    // Requires contiguous storage, see `Compact()`
     inline const bool* UBWCEnabledPtr() const
     {
+        DIVE_ASSERT(m_chunks.empty());
         return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                        kUBWCEnabledOffset * m_cap);
     }
     inline bool* UBWCEnabledPtr()
     {
+        DIVE_ASSERT(m_chunks.empty());
         return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                        kUBWCEnabledOffset * m_cap);
     }
     // `UBWCEnabledPtr()` returns a shared pointer to an array of `size()` elements
     inline const bool* UBWCEnabledPtr(Id id, uint32_t attachment = 0) const
     {
+        if (static_cast<typename Id::basic_type>(id) >= m_cap)
+        {
+            typename Id::basic_type index;
+            uint8_t*                chunk = GetChunk(id, &index);
+            return reinterpret_cast<bool*>(chunk + kUBWCEnabledOffset * kChunkSize) +
+                   index * 8 + attachment;
+        }
         return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                        kUBWCEnabledOffset * m_cap) +
                static_cast<typename Id::basic_type>(id) * 8 + attachment
@@ -7831,12 +9295,32 @@ public:
     }
     inline bool* UBWCEnabledPtr(Id id, uint32_t attachment = 0)
     {
+        if (static_cast<typename Id::basic_type>(id) >= m_cap)
+        {
+            typename Id::basic_type index;
+            uint8_t*                chunk = GetChunk(id, &index);
+            return reinterpret_cast<bool*>(chunk + kUBWCEnabledOffset * kChunkSize) +
+                   index * 8 + attachment;
+        }
         return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                        kUBWCEnabledOffset * m_cap) +
                static_cast<typename Id::basic_type>(id) * 8 + attachment
 
         ;
     }
+    // `UBWCEnabledColumn()` returns a read-only view of the `UBWCEnabled` array
+    inline StructOfArraysColumn<bool> UBWCEnabledColumn(uint32_t attachment = 0) const
+    {
+        DIVE_ASSERT(m_chunks.empty());
+        const bool* data = UBWCEnabledPtr(Id(0), attachment);
+        uint32_t    stride = kUBWCEnabledArrayCount;
+        return StructOfArraysColumn<bool>(data,
+                                          m_size,
+                                          stride,
+                                          m_is_set_buffer.data(),
+                                          kNumFields,
+                                          kUBWCEnabledIndex + attachment);
+    }
     // `UBWCEnabled(id)` retuns the `UBWCEnabled` element of the object identified by `id`
     inline bool UBWCEnabled(Id id, uint32_t attachment) const
     {
@@ -7882,19 +9366,29 @@ public:
     // attachment
 
     // `UBWCLosslessEnabledPtr()` returns a shared pointer to an array of `size()` elements
+    // Requires contiguous storage, see `Compact()`
     inline const bool* UBWCLosslessEnabledPtr() const
     {
+        DIVE_ASSERT(m_chunks.empty());
         return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                        kUBWCLosslessEnabledOffset * m_cap);
     }
     inline bool* UBWCLosslessEnabledPtr()
     {
+        DIVE_ASSERT(m_chunks.empty());
         return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                        kUBWCLosslessEnabledOffset * m_cap);
     }
     // `UBWCLosslessEnabledPtr()` returns a shared pointer to an array of `size()` elements
     inline const bool* UBWCLosslessEnabledPtr(Id id, uint32_t attachment = 0) const
     {
+        if (static_cast<typename Id::basic_type>(id) >= m_cap)
+        {
+            typename Id::basic_type index;
+            uint8_t*                chunk = GetChunk(id, &index);
+            return reinterpret_cast<bool*>(chunk + kUBWCLosslessEnabledOffset * kChunkSize) +
+                   index * 8 + attachment;
+        }
         return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                        kUBWCLosslessEnabledOffset * m_cap) +
                static_cast<typename Id::basic_type>(id) * 8 + attachment
@@ -7903,12 +9397,32 @@ public:
     }
     inline bool* UBWCLosslessEnabledPtr(Id id, uint32_t attachment = 0)
     {
+        if (static_cast<typename Id::basic_type>(id) >= m_cap)
+        {
+            typename Id::basic_type index;
+            uint8_t*                chunk = GetChunk(id, &index);
+            return reinterpret_cast<bool*>(chunk + kUBWCLosslessEnabledOffset * kChunkSize) +
+                   index * 8 + attachment;
+        }
         return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                        kUBWCLosslessEnabledOffset * m_cap) +
                static_cast<typename Id::basic_type>(id) * 8 + attachment
 
         ;
     }
+    // `UBWCLosslessEnabledColumn()` returns a read-only view of the `UBWCLosslessEnabled` array
+    inline StructOfArraysColumn<bool> UBWCLosslessEnabledColumn(uint32_t attachment = 0) const
+    {
+        DIVE_ASSERT(m_chunks.empty());
+        const bool* data = UBWCLosslessEnabledPtr(Id(0), attachment);
+        uint32_t    stride = kUBWCLosslessEnabledArrayCount;
+        return StructOfArraysColumn<bool>(data,
+                                          m_size,
+                                          stride,
+                                          m_is_set_buffer.data(),
+                                          kNumFields,
+                                          kUBWCLosslessEnabledIndex + attachment);
+    }
     // `UBWCLosslessEnabled(id)` retuns the `UBWCLosslessEnabled` element of the object identified
     // by `id`
     inline bool UBWCLosslessEnabled(Id id, uint32_t attachment) const
@@ -7955,19 +9469,28 @@ public:
     // FIELD UBWCEnabledOnDS: Whether UBWC is enabled for this depth stencil attachment
 
     // `UBWCEnabledOnDSPtr()` returns a shared pointer to an array of `size()` elements
+    // Requires contiguous storage, see `Compact()`
     inline const bool* UBWCEnabledOnDSPtr() const
     {
+        DIVE_ASSERT(m_chunks.empty());
         return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                        kUBWCEnabledOnDSOffset * m_cap);
     }
     inline bool* UBWCEnabledOnDSPtr()
     {
+        DIVE_ASSERT(m_chunks.empty());
         return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                        kUBWCEnabledOnDSOffset * m_cap);
     }
     // `UBWCEnabledOnDSPtr()` returns a shared pointer to an array of `size()` elements
     inline const bool* UBWCEnabledOnDSPtr(Id id) const
     {
+        if (static_cast<typename Id::basic_type>(id) >= m_cap)
+        {
+            typename Id::basic_type index;
+            uint8_t*                chunk = GetChunk(id, &index);
+            return reinterpret_cast<bool*>(chunk + kUBWCEnabledOnDSOffset * kChunkSize) + index;
+        }
         return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                        kUBWCEnabledOnDSOffset * m_cap) +
                static_cast<typename Id::basic_type>(id)
@@ -7976,12 +9499,31 @@ public:
     }
     inline bool* UBWCEnabledOnDSPtr(Id id)
     {
+        if (static_cast<typename Id::basic_type>(id) >= m_cap)
+        {
+            typename Id::basic_type index;
+            uint8_t*                chunk = GetChunk(id, &index);
+            return reinterpret_cast<bool*>(chunk + kUBWCEnabledOnDSOffset * kChunkSize) + index;
+        }
         return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                        kUBWCEnabledOnDSOffset * m_cap) +
                static_cast<typename Id::basic_type>(id)
 
         ;
     }
+    // `UBWCEnabledOnDSColumn()` returns a read-only view of the `UBWCEnabledOnDS` array
+    inline StructOfArraysColumn<bool> UBWCEnabledOnDSColumn() const
+    {
+        DIVE_ASSERT(m_chunks.empty());
+        const bool* data = UBWCEnabledOnDSPtr();
+        uint32_t    stride = 1;
+        return StructOfArraysColumn<bool>(data,
+                                          m_size,
+                                          stride,
+                                          m_is_set_buffer.data(),
+                                          kNumFields,
+                                          kUBWCEnabledOnDSIndex);
+    }
     // `UBWCEnabledOnDS(id)` retuns the `UBWCEnabledOnDS` element of the object identified by `id`
     inline bool UBWCEnabledOnDS(Id id) const
     {
@@ -8017,19 +9559,29 @@ public:
     // depth stencil attachment
 
     // `UBWCLosslessEnabledOnDSPtr()` returns a shared pointer to an array of `size()` elements
+    // Requires contiguous storage, see `Compact()`
     inline const bool* UBWCLosslessEnabledOnDSPtr() const
     {
+        DIVE_ASSERT(m_chunks.empty());
         return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                        kUBWCLosslessEnabledOnDSOffset * m_cap);
     }
     inline bool* UBWCLosslessEnabledOnDSPtr()
     {
+        DIVE_ASSERT(m_chunks.empty());
         return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                        kUBWCLosslessEnabledOnDSOffset * m_cap);
     }
     // `UBWCLosslessEnabledOnDSPtr()` returns a shared pointer to an array of `size()` elements
     inline const bool* UBWCLosslessEnabledOnDSPtr(Id id) const
     {
+        if (static_cast<typename Id::basic_type>(id) >= m_cap)
+        {
+            typename Id::basic_type index;
+            uint8_t*                chunk = GetChunk(id, &index);
+            return reinterpret_cast<bool*>(chunk + kUBWCLosslessEnabledOnDSOffset * kChunkSize) +
+                   index;
+        }
         return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                        kUBWCLosslessEnabledOnDSOffset * m_cap) +
                static_cast<typename Id::basic_type>(id)
@@ -8038,12 +9590,33 @@ public:
     }
     inline bool* UBWCLosslessEnabledOnDSPtr(Id id)
     {
+        if (static_cast<typename Id::basic_type>(id) >= m_cap)
+        {
+            typename Id::basic_type index;
+            uint8_t*                chunk = GetChunk(id, &index);
+            return reinterpret_cast<bool*>(chunk + kUBWCLosslessEnabledOnDSOffset * kChunkSize) +
+                   index;
+        }
         return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
                                        kUBWCLosslessEnabledOnDSOffset * m_cap) +
                static_cast<typename Id::basic_type>(id)
 
         ;
     }
+    // `UBWCLosslessEnabledOnDSColumn()` returns a read-only view of the `UBWCLosslessEnabledOnDS`
+    // array
+    inline StructOfArraysColumn<bool> UBWCLosslessEnabledOnDSColumn() const
+    {
+        DIVE_ASSERT(m_chunks.empty());
+        const bool* data = UBWCLosslessEnabledOnDSPtr();
+        uint32_t    stride = 1;
+        return StructOfArraysColumn<bool>(data,
+                                          m_size,
+                                          stride,
+                                          m_is_set_buffer.data(),
+                                          kNumFields,
+                                          kUBWCLosslessEnabledOnDSIndex);
+    }
     // `UBWCLosslessEnabledOnDS(id)` retuns the `UBWCLosslessEnabledOnDS` element of the object
     // identified by `id`
     inline bool UBWCLosslessEnabledOnDS(Id id) const
@@ -8110,19 +9683,69 @@ public:
     void Reserve(typename Id::basic_type new_cap);
 
     // `Add` adds a single element and returns an iterator referring to the new
-    // element. This will re-allocate memory if necessary
+    // element. Once the contiguous buffer is full, elements go to fixed-size
+    // chunks instead, so existing elements are never moved or copied
     Iterator Add();
 
+    // `Compact` moves the chunked elements into a single contiguous buffer of
+    // exactly `size()` elements (rounded up to the alignment), as required by
+    // the whole-array accessors (`MyFieldPtr()`, `MyFieldColumn()`).
+    // Call it once all elements have been added
+    void Compact();
+
     // `Clear` resets size to 0, but keeps the allocated memory.
     inline void Clear() { m_size = 0; }
 
 protected:
     template<typename CONFIG_> friend class EventStateInfoRefT;
     template<typename CONFIG_> friend class EventStateInfoConstRefT;
+    friend class EventStateInfoDelta;
 
     // The start of the array for each field will be aligned to `kAlignment`
     static constexpr size_t kAlignment = alignof(std::max_align_t);
 
+    // Number of elements in each chunk, and in the first contiguous buffer.
+    // Each chunk has the same layout as a contiguous buffer of this capacity
+    static constexpr typename Id::basic_type kChunkSize = 1024;
+    static_assert((kChunkSize & (kChunkSize - 1)) == 0 && kChunkSize % kAlignment == 0,
+                  "kChunkSize must be a power of 2 and a multiple of kAlignment");
+
+    // `GetChunk(id, &index)` returns the chunk storing element `id`, which must
+    // lie past the contiguous buffer, and its index within that chunk
+    inline uint8_t* GetChunk(Id id, typename Id::basic_type* index) const
+    {
+        typename Id::basic_type chunk_id = static_cast<typename Id::basic_type>(id) - m_cap;
+        *index = chunk_id % kChunkSize;
+        return reinterpret_cast<uint8_t*>(m_chunks[chunk_id / kChunkSize].get());
+    }
+
+    // Moves all elements into a new contiguous buffer of `new_cap` elements
+    void Reallocate(typename Id::basic_type new_cap);
+
+    // `GetIsSetBits(id, field_index, &bit)` returns the is-set bit-array holding the bit of field
+    // `field_index` of element `id`, and that bit's index in it. Each chunk keeps the is-set bits
+    // of its elements after its fields, so that adding a chunk never grows `m_is_set_buffer`
+    inline const uint8_t* GetIsSetBits(Id id, uint32_t field_index, uint32_t* bit) const
+    {
+        typename Id::basic_type index = static_cast<typename Id::basic_type>(id);
+        const uint8_t*          bits = m_is_set_buffer.data();
+        if (index >= m_cap)
+            bits = GetChunk(id, &index) + kChunkSize * kElemSize;
+        *bit = index * kNumFields + field_index;
+        return bits;
+    }
+
+    // `FieldData(id, field_offset, field_size)` returns the bytes of the field at `field_offset`
+    // (a `kMyFieldOffset`) of element `id`, wherever the element is stored
+    inline const uint8_t* FieldData(Id id, size_t field_offset, size_t field_size) const
+    {
+        typename Id::basic_type index = static_cast<typename Id::basic_type>(id);
+        if (index >= m_cap)
+            return GetChunk(id, &index) + field_offset * kChunkSize + index * field_size;
+        return reinterpret_cast<const uint8_t*>(m_buffer.get()) + field_offset * m_cap +
+               index * field_size;
+    }
+
 #define PARTIAL_SIZE_EventStateInfo 0u
 #define PARTIAL_INDEX_EventStateInfo 0u
     static_assert(alignof(uint32_t) <= kAlignment,
@@ -8637,9 +10260,14 @@ protected:
     //     with `operator new []`.
     std::unique_ptr<std::max_align_t[]> m_buffer;
 
+    // Elements past `m_cap`, `kChunkSize` per chunk. Element `m_cap + i` is
+    // element `i % kChunkSize` of chunk `i / kChunkSize`. Empty once compacted
+    std::vector<std::unique_ptr<std::max_align_t[]>> m_chunks;
+
     // Pointer to a bit-array, where each field is marked with a 1 if set, and 0
     // if not set. Unlike m_buffer, this bit-array is in a AOS rather than SOA
     // memory layout. This makes the management of this small buffer simpler.
+    // Covers the contiguous buffer only; the chunks hold their own bits
     std::vector<uint8_t> m_is_set_buffer;
 
     // The following fields point to each of the arrays. These are not used,
@@ -8775,4 +10403,1325 @@ public:
 class EventStateInfo : public EventStateInfoT<EventStateInfo_CONFIG>
 {};
 
+//--------------------------------------------------------------------------------------------------
+// EventStateInfoDelta is a read-only, delta-encoded copy of a `EventStateInfo`. It has the same
+// getters, plus `MyFieldChanges()` listing the ids at which a field changes, and `MyFieldColumn()`
+// running the column kernels over the runs of a field.
+class EventStateInfoDelta : public StructOfArraysDeltaStorage
+{
+public:
+    using Id = EventStateId;
+    using SOA = EventStateInfo;
+
+    // `Encode` replaces the contents with a copy of `soa`
+    void Encode(const SOA& soa, uint32_t keyframe_interval = kDefaultKeyframeInterval);
+
+    // `Decode` replaces the contents of `soa` with the decoded elements
+    void Decode(SOA* soa) const;
+
+    // `Decode(ids, soa)` replaces the contents of `soa` with the elements `ids` only, so a few
+    // elements can be inspected with the full SOA interface. Element i of `soa` is element `ids[i]`
+    void Decode(const std::vector<uint32_t>& ids, SOA* soa) const;
+
+    // `IsValidId` reports whether `id` identifies a valid element
+    inline bool IsValidId(Id id) const { return static_cast<typename Id::basic_type>(id) < size(); }
+
+    //-----------------------------------------------
+    // FIELD Topology
+    inline VkPrimitiveTopology Topology(Id id) const
+    {
+        DIVE_ASSERT(IsValidId(id));
+        uint32_t index = static_cast<typename Id::basic_type>(id);
+        return static_cast<VkPrimitiveTopology>(SlotValue<uint32_t>(SOA::kTopologyIndex, index));
+    }
+    inline bool IsTopologySet(Id id) const
+    {
+        DIVE_ASSERT(IsValidId(id));
+        return IsSlotSet(SOA::kTopologyIndex, static_cast<typename Id::basic_type>(id));
+    }
+    // `TopologyChanges()` returns the ids at which `Topology` changes
+    inline const std::vector<uint32_t>& TopologyChanges() const
+    {
+        return GetSlotChanges(SOA::kTopologyIndex);
+    }
+    // `TopologyColumn()` returns a read-only view of the runs of `Topology`
+    inline StructOfArraysDeltaColumn<uint32_t> TopologyColumn() const
+    {
+        return SlotColumn<uint32_t>(SOA::kTopologyIndex);
+    }
+
+    //-----------------------------------------------
+    // FIELD PrimRestartEnabled
+    inline bool PrimRestartEnabled(Id id) const
+    {
+        DIVE_ASSERT(IsValidId(id));
+        uint32_t index = static_cast<typename Id::basic_type>(id);
+        return SlotValue<bool>(SOA::kPrimRestartEnabledIndex, index);
+    }
+    inline bool IsPrimRestartEnabledSet(Id id) const
+    {
+        DIVE_ASSERT(IsValidId(id));
+        return IsSlotSet(SOA::kPrimRestartEnabledIndex, static_cast<typename Id::basic_type>(id));
+    }
+    // `PrimRestartEnabledChanges()` returns the ids at which `PrimRestartEnabled` changes
+    inline const std::vector<uint32_t>& PrimRestartEnabledChanges() const
+    {
+        return GetSlotChanges(SOA::kPrimRestartEnabledIndex);
+    }
+    // `PrimRestartEnabledColumn()` returns a read-only view of the runs of `PrimRestartEnabled`
+    inline StructOfArraysDeltaColumn<bool> PrimRestartEnabledColumn() const
+    {
+        return SlotColumn<bool>(SOA::kPrimRestartEnabledIndex);
+    }
+
+    //-----------------------------------------------
+    // FIELD PatchControlPoints
+    inline uint32_t PatchControlPoints(Id id) const
+    {
+        DIVE_ASSERT(IsValidId(id));
+        uint32_t index = static_cast<typename Id::basic_type>(id);
+        return SlotValue<uint32_t>(SOA::kPatchControlPointsIndex, index);
+    }
+    inline bool IsPatchControlPointsSet(Id id) const
+    {
+        DIVE_ASSERT(IsValidId(id));
+        return IsSlotSet(SOA::kPatchControlPointsIndex, static_cast<typename Id::basic_type>(id));
+    }
+    // `PatchControlPointsChanges()` returns the ids at which `PatchControlPoints` changes
+    inline const std::vector<uint32_t>& PatchControlPointsChanges() const
+    {
+        return GetSlotChanges(SOA::kPatchControlPointsIndex);
+    }
+    // `PatchControlPointsColumn()` returns a read-only view of the runs of `PatchControlPoints`
+    inline StructOfArraysDeltaColumn<uint32_t> PatchControlPointsColumn() const
+    {
+        return SlotColumn<uint32_t>(SOA::kPatchControlPointsIndex);
+    }
+
+    //-----------------------------------------------
+    // FIELD Viewport
+    inline VkViewport Viewport(Id id, uint32_t viewport) const
+    {
+        DIVE_ASSERT(IsValidId(id));
+        uint32_t index = static_cast<typename Id::basic_type>(id);
+        return SlotValue<VkViewport>(SOA::kViewportIndex + viewport, index);
+    }
+    inline bool IsViewportSet(Id id, uint32_t viewport) const
+    {
+        DIVE_ASSERT(IsValidId(id));
+        return IsSlotSet(SOA::kViewportIndex + viewport, static_cast<typename Id::basic_type>(id));
+    }
+    // `ViewportChanges()` returns the ids at which `Viewport` changes
+    inline const std::vector<uint32_t>& ViewportChanges(uint32_t viewport = 0) const
+    {
+        return GetSlotChanges(SOA::kViewportIndex + viewport);
+    }
+    // `ViewportColumn()` returns a read-only view of the runs of `Viewport`
+    inline StructOfArraysDeltaColumn<VkViewport> ViewportColumn(uint32_t viewport = 0) const
+    {
+        return SlotColumn<VkViewport>(SOA::kViewportIndex + viewport);
+    }
+
+    //-----------------------------------------------
+    // FIELD Scissor
+    inline VkRect2D Scissor(Id id, uint32_t scissor) const
+    {
+        DIVE_ASSERT(IsValidId(id));
+        uint32_t index = static_cast<typename Id::basic_type>(id);
+        return SlotValue<VkRect2D>(SOA::kScissorIndex + scissor, index);
+    }
+    inline bool IsScissorSet(Id id, uint32_t scissor) const
+    {
+        DIVE_ASSERT(IsValidId(id));
+        return IsSlotSet(SOA::kScissorIndex + scissor, static_cast<typename Id::basic_type>(id));
+    }
+    // `ScissorChanges()` returns the ids at which `Scissor` changes
+    inline const std::vector<uint32_t>& ScissorChanges(uint32_t scissor = 0) const
+    {
+        return GetSlotChanges(SOA::kScissorIndex + scissor);
+    }
+    // `ScissorColumn()` returns a read-only view of the runs of `Scissor`
+    inline StructOfArraysDeltaColumn<VkRect2D> ScissorColumn(uint32_t scissor = 0) const
+    {
+        return SlotColumn<VkRect2D>(SOA::kScissorIndex + scissor);
+    }
+
+    //-----------------------------------------------
+    // FIELD DepthClampEnabled
+    inline bool DepthClampEnabled(Id id) const
+    {
+        DIVE_ASSERT(IsValidId(id));
+        uint32_t index = static_cast<typename Id::basic_type>(id);
+        return SlotValue<bool>(SOA::kDepthClampEnabledIndex, index);
+    }
+    inline bool IsDepthClampEnabledSet(Id id) const
+    {
+        DIVE_ASSERT(IsValidId(id));
+        return IsSlotSet(SOA::kDepthClampEnabledIndex, static_cast<typename Id::basic_type>(id));
+    }
+    // `DepthClampEnabledChanges()` returns the ids at which `DepthClampEnabled` changes
+    inline const std::vector<uint32_t>& DepthClampEnabledChanges() const
+    {
+        return GetSlotChanges(SOA::kDepthClampEnabledIndex);
+    }
+    // `DepthClampEnabledColumn()` returns a read-only view of the runs of `DepthClampEnabled`
+    inline StructOfArraysDeltaColumn<bool> DepthClampEnabledColumn() const
+    {
+        return SlotColumn<bool>(SOA::kDepthClampEnabledIndex);
+    }
+
+    //-----------------------------------------------
+    // FIELD RasterizerDiscardEnabled
+    inline bool RasterizerDiscardEnabled(Id id) const
+    {
+        DIVE_ASSERT(IsValidId(id));
+        uint32_t index = static_cast<typename Id::basic_type>(id);
+        return SlotValue<bool>(SOA::kRasterizerDiscardEnabledIndex, index);
+    }
+    inline bool IsRasterizerDiscardEnabledSet(Id id) const
+    {
+        DIVE_ASSERT(IsValidId(id));
+        return IsSlotSet(SOA::kRasterizerDiscardEnabledIndex,
+                         static_cast<typename Id::basic_type>(id));
+    }
+    // `RasterizerDiscardEnabledChanges()` returns the ids at which `RasterizerDiscardEnabled`
+    // changes
+    inline const std::vector<uint32_t>& RasterizerDiscardEnabledChanges() const
+    {
+        return GetSlotChanges(SOA::kRasterizerDiscardEnabledIndex);
+    }
+    // `RasterizerDiscardEnabledColumn()` returns a read-only view of the runs of
+    // `RasterizerDiscardEnabled`
+    inline StructOfArraysDeltaColumn<bool> RasterizerDiscardEnabledColumn() const
+    {
+        return SlotColumn<bool>(SOA::kRasterizerDiscardEnabledIndex);
+    }
+
+    //-----------------------------------------------
+    // FIELD PolygonMode
+    inline VkPolygonMode PolygonMode(Id id) const
+    {
+        DIVE_ASSERT(IsValidId(id));
+        uint32_t index = static_cast<typename Id::basic_type>(id);
+        return SlotValue<VkPolygonMode>(SOA::kPolygonModeIndex, index);
+    }
+    inline bool IsPolygonModeSet(Id id) const
+    {
+        DIVE_ASSERT(IsValidId(id));
+        return IsSlotSet(SOA::kPolygonModeIndex, static_cast<typename Id::basic_type>(id));
+    }
+    // `PolygonModeChanges()` returns the ids at which `PolygonMode` changes
+    inline const std::vector<uint32_t>& PolygonModeChanges() const
+    {
+        return GetSlotChanges(SOA::kPolygonModeIndex);
+    }
+    // `PolygonModeColumn()` returns a read-only view of the runs of `PolygonMode`
+    inline StructOfArraysDeltaColumn<VkPolygonMode> PolygonModeColumn() const
+    {
+        return SlotColumn<VkPolygonMode>(SOA::kPolygonModeIndex);
+    }
+
+    //-----------------------------------------------
+    // FIELD CullMode
+    inline VkCullModeFlags CullMode(Id id) const
+    {
+        DIVE_ASSERT(IsValidId(id));
+        uint32_t index = static_cast<typename Id::basic_type>(id);
+        return SlotValue<VkCullModeFlags>(SOA::kCullModeIndex, index);
+    }
+    inline bool IsCullModeSet(Id id) const
+    {
+        DIVE_ASSERT(IsValidId(id));
+        return IsSlotSet(SOA::kCullModeIndex, static_cast<typename Id::basic_type>(id));
+    }
+    // `CullModeChanges()` returns the ids at which `CullMode` changes
+    inline const std::vector<uint32_t>& CullModeChanges() const
+    {
+        return GetSlotChanges(SOA::kCullModeIndex);
+    }
+    // `CullModeColumn()` returns a read-only view of the runs of `CullMode`
+    inline StructOfArraysDeltaColumn<VkCullModeFlags> CullModeColumn() const
+    {
+        return SlotColumn<VkCullModeFlags>(SOA::kCullModeIndex);
+    }
+
+    //-----------------------------------------------
+    // FIELD FrontFace
+    inline VkFrontFace FrontFace(Id id) const
+    {
+        DIVE_ASSERT(IsValidId(id));
+        uint32_t index = static_cast<typename Id::basic_type>(id);
+        return SlotValue<VkFrontFace>(SOA::kFrontFaceIndex, index);
+    }
+    inline bool IsFrontFaceSet(Id id) const
+    {
+        DIVE_ASSERT(IsValidId(id));
+        return IsSlotSet(SOA::kFrontFaceIndex, static_cast<typename Id::basic_type>(id));
+    }
+    // `FrontFaceChanges()` returns the ids at which `FrontFace` changes
+    inline const std::vector<uint32_t>& FrontFaceChanges() const
+    {
+        return GetSlotChanges(SOA::kFrontFaceIndex);
+    }
+    // `FrontFaceColumn()` returns a read-only view of the runs of `FrontFace`
+    inline StructOfArraysDeltaColumn<VkFrontFace> FrontFaceColumn() const
+    {
+        return SlotColumn<VkFrontFace>(SOA::kFrontFaceIndex);
+    }
+
+    //-----------------------------------------------
+    // FIELD DepthBiasEnabled
+    inline bool DepthBiasEnabled(Id id) const
+    {
+        DIVE_ASSERT(IsValidId(id));
+        uint32_t index = static_cast<typename Id::basic_type>(id);
+        return SlotValue<bool>(SOA::kDepthBiasEnabledIndex, index);
+    }
+    inline bool IsDepthBiasEnabledSet(Id id) const
+    {
+        DIVE_ASSERT(IsValidId(id));
+        return IsSlotSet(SOA::kDepthBiasEnabledIndex, static_cast<typename Id::basic_type>(id));
+    }
+    // `DepthBiasEnabledChanges()` returns the ids at which `DepthBiasEnabled` changes
+    inline const std::vector<uint32_t>& DepthBiasEnabledChanges() const
+    {
+        return GetSlotChanges(SOA::kDepthBiasEnabledIndex);
+    }
+    // `DepthBiasEnabledColumn()` returns a read-only view of the runs of `DepthBiasEnabled`
+    inline StructOfArraysDeltaColumn<bool> DepthBiasEnabledColumn() const
+    {
+        return SlotColumn<bool>(SOA::kDepthBiasEnabledIndex);
+    }
+
+    //-----------------------------------------------
+    // FIELD DepthBiasConstantFactor
+    inline float DepthBiasConstantFactor(Id id) const
+    {
+        DIVE_ASSERT(IsValidId(id));
+        uint32_t index = static_cast<typename Id::basic_type>(id);
+        return SlotValue<float>(SOA::kDepthBiasConstantFactorIndex, index);
+    }
+    inline bool IsDepthBiasConstantFactorSet(Id id) const
+    {
+        DIVE_ASSERT(IsValidId(id));
+        return IsSlotSet(SOA::kDepthBiasConstantFactorIndex,
+                         static_cast<typename Id::basic_type>(id));
+    }
+    // `DepthBiasConstantFactorChanges()` returns the ids at which `DepthBiasConstantFactor` changes
+    inline const std::vector<uint32_t>& DepthBiasConstantFactorChanges() const
+    {
+        return GetSlotChanges(SOA::kDepthBiasConstantFactorIndex);
+    }
+    // `DepthBiasConstantFactorColumn()` returns a read-only view of the runs of
+    // `DepthBiasConstantFactor`
+    inline StructOfArraysDeltaColumn<float> DepthBiasConstantFactorColumn() const
+    {
+        return SlotColumn<float>(SOA::kDepthBiasConstantFactorIndex);
+    }
+
+    //-----------------------------------------------
+    // FIELD DepthBiasClamp
+    inline float DepthBiasClamp(Id id) const
+    {
+        DIVE_ASSERT(IsValidId(id));
+        uint32_t index = static_cast<typename Id::basic_type>(id);
+        return SlotValue<float>(SOA::kDepthBiasClampIndex, index);
+    }
+    inline bool IsDepthBiasClampSet(Id id) const
+    {
+        DIVE_ASSERT(IsValidId(id));
+        return IsSlotSet(SOA::kDepthBiasClampIndex, static_cast<typename Id::basic_type>(id));
+    }
+    // `DepthBiasClampChanges()` returns the ids at which `DepthBiasClamp` changes
+    inline const std::vector<uint32_t>& DepthBiasClampChanges() const
+    {
+        return GetSlotChanges(SOA::kDepthBiasClampIndex);
+    }
+    // `DepthBiasClampColumn()` returns a read-only view of the runs of `DepthBiasClamp`
+    inline StructOfArraysDeltaColumn<float> DepthBiasClampColumn() const
+    {
+        return SlotColumn<float>(SOA::kDepthBiasClampIndex);
+    }
+
+    //-----------------------------------------------
+    // FIELD DepthBiasSlopeFactor
+    inline float DepthBiasSlopeFactor(Id id) const
+    {
+        DIVE_ASSERT(IsValidId(id));
+        uint32_t index = static_cast<typename Id::basic_type>(id);
+        return SlotValue<float>(SOA::kDepthBiasSlopeFactorIndex, index);
+    }
+    inline bool IsDepthBiasSlopeFactorSet(Id id) const
+    {
+        DIVE_ASSERT(IsValidId(id));
+        return IsSlotSet(SOA::kDepthBiasSlopeFactorIndex, static_cast<typename Id::basic_type>(id));
+    }
+    // `DepthBiasSlopeFactorChanges()` returns the ids at which `DepthBiasSlopeFactor` changes
+    inline const std::vector<uint32_t>& DepthBiasSlopeFactorChanges() const
+    {
+        return GetSlotChanges(SOA::kDepthBiasSlopeFactorIndex);
+    }
+    // `DepthBiasSlopeFactorColumn()` returns a read-only view of the runs of `DepthBiasSlopeFactor`
+    inline StructOfArraysDeltaColumn<float> DepthBiasSlopeFactorColumn() const
+    {
+        return SlotColumn<float>(SOA::kDepthBiasSlopeFactorIndex);
+    }
+
+    //-----------------------------------------------
+    // FIELD LineWidth
+    inline float LineWidth(Id id) const
+    {
+        DIVE_ASSERT(IsValidId(id));
+        uint32_t index = static_cast<typename Id::basic_type>(id);
+        return SlotValue<float>(SOA::kLineWidthIndex, index);
+    }
+    inline bool IsLineWidthSet(Id id) const
+    {
+        DIVE_ASSERT(IsValidId(id));
+        return IsSlotSet(SOA::kLineWidthIndex, static_cast<typename Id::basic_type>(id));
+    }
+    // `LineWidthChanges()` returns the ids at which `LineWidth` changes
+    inline const std::vector<uint32_t>& LineWidthChanges() const
+    {
+        return GetSlotChanges(SOA::kLineWidthIndex);
+    }
+    // `LineWidthColumn()` returns a read-only view of the runs of `LineWidth`
+    inline StructOfArraysDeltaColumn<float> LineWidthColumn() const
+    {
+        return SlotColumn<float>(SOA::kLineWidthIndex);
+    }
+
+    //-----------------------------------------------
+    // FIELD RasterizationSamples
+    inline VkSampleCountFlagBits RasterizationSamples(Id id) const
+    {
+        DIVE_ASSERT(IsValidId(id));
+        uint32_t index = static_cast<typename Id::basic_type>(id);
+        return SlotValue<VkSampleCountFlagBits>(SOA::kRasterizationSamplesIndex, index);
+    }
+    inline bool IsRasterizationSamplesSet(Id id) const
+    {
+        DIVE_ASSERT(IsValidId(id));
+        return IsSlotSet(SOA::kRasterizationSamplesIndex, static_cast<typename Id::basic_type>(id));
+    }
+    // `RasterizationSamplesChanges()` returns the ids at which `RasterizationSamples` changes
+    inline const std::vector<uint32_t>& RasterizationSamplesChanges() const
+    {
+        return GetSlotChanges(SOA::kRasterizationSamplesIndex);
+    }
+    // `RasterizationSamplesColumn()` returns a read-only view of the runs of `RasterizationSamples`
+    inline StructOfArraysDeltaColumn<VkSampleCountFlagBits> RasterizationSamplesColumn() const
+    {
+        return SlotColumn<VkSampleCountFlagBits>(SOA::kRasterizationSamplesIndex);
+    }
+
+    //-----------------------------------------------
+    // FIELD SampleShadingEnabled
+    inline bool SampleShadingEnabled(Id id) const
+    {
+        DIVE_ASSERT(IsValidId(id));
+        uint32_t index = static_cast<typename Id::basic_type>(id);
+        return SlotValue<bool>(SOA::kSampleShadingEnabledIndex, index);
+    }
+    inline bool IsSampleShadingEnabledSet(Id id) const
+    {
+        DIVE_ASSERT(IsValidId(id));
+        return IsSlotSet(SOA::kSampleShadingEnabledIndex, static_cast<typename Id::basic_type>(id));
+    }
+    // `SampleShadingEnabledChanges()` returns the ids at which `SampleShadingEnabled` changes
+    inline const std::vector<uint32_t>& SampleShadingEnabledChanges() const
+    {
+        return GetSlotChanges(SOA::kSampleShadingEnabledIndex);
+    }
+    // `SampleShadingEnabledColumn()` returns a read-only view of the runs of `SampleShadingEnabled`
+    inline StructOfArraysDeltaColumn<bool> SampleShadingEnabledColumn() const
+    {
+        return SlotColumn<bool>(SOA::kSampleShadingEnabledIndex);
+    }
+
+    //-----------------------------------------------
+    // FIELD MinSampleShading
+    inline float MinSampleShading(Id id) const
+    {
+        DIVE_ASSERT(IsValidId(id));
+        uint32_t index = static_cast<typename Id::basic_type>(id);
+        return SlotValue<float>(SOA::kMinSampleShadingIndex, index);
+    }
+    inline bool IsMinSampleShadingSet(Id id) const
+    {
+        DIVE_ASSERT(IsValidId(id));
+        return IsSlotSet(SOA::kMinSampleShadingIndex, static_cast<typename Id::basic_type>(id));
+    }
+    // `MinSampleShadingChanges()` returns the ids at which `MinSampleShading` changes
+    inline const std::vector<uint32_t>& MinSampleShadingChanges() const
+    {
+        return GetSlotChanges(SOA::kMinSampleShadingIndex);
+    }
+    // `MinSampleShadingColumn()` returns a read-only view of the runs of `MinSampleShading`
+    inline StructOfArraysDeltaColumn<float> MinSampleShadingColumn() const
+    {
+        return SlotColumn<float>(SOA::kMinSampleShadingIndex);
+    }
+
+    //-----------------------------------------------
+    // FIELD SampleMask
+    inline VkSampleMask SampleMask(Id id) const
+    {
+        DIVE_ASSERT(IsValidId(id));
+        uint32_t index = static_cast<typename Id::basic_type>(id);
+        return SlotValue<VkSampleMask>(SOA::kSampleMaskIndex, index);
+    }
+    inline bool IsSampleMaskSet(Id id) const
+    {
+        DIVE_ASSERT(IsValidId(id));
+        return IsSlotSet(SOA::kSampleMaskIndex, static_cast<typename Id::basic_type>(id));
+    }
+    // `SampleMaskChanges()` returns the ids at which `SampleMask` changes
+    inline const std::vector<uint32_t>& SampleMaskChanges() const
+    {
+        return GetSlotChanges(SOA::kSampleMaskIndex);
+    }
+    // `SampleMaskColumn()` returns a read-only view of the runs of `SampleMask`
+    inline StructOfArraysDeltaColumn<VkSampleMask> SampleMaskColumn() const
+    {
+        return SlotColumn<VkSampleMask>(SOA::kSampleMaskIndex);
+    }
+
+    //-----------------------------------------------
+    // FIELD AlphaToCoverageEnabled
+    inline bool AlphaToCoverageEnabled(Id id) const
+    {
+        DIVE_ASSERT(IsValidId(id));
+        uint32_t index = static_cast<typename Id::basic_type>(id);
+        return SlotValue<bool>(SOA::kAlphaToCoverageEnabledIndex, index);
+    }
+    inline bool IsAlphaToCoverageEnabledSet(Id id) const
+    {
+        DIVE_ASSERT(IsValidId(id));
+        return IsSlotSet(SOA::kAlphaToCoverageEnabledIndex,
+                         static_cast<typename Id::basic_type>(id));
+    }
+    // `AlphaToCoverageEnabledChanges()` returns the ids at which `AlphaToCoverageEnabled` changes
+    inline const std::vector<uint32_t>& AlphaToCoverageEnabledChanges() const
+    {
+        return GetSlotChanges(SOA::kAlphaToCoverageEnabledIndex);
+    }
+    // `AlphaToCoverageEnabledColumn()` returns a read-only view of the runs of
+    // `AlphaToCoverageEnabled`
+    inline StructOfArraysDeltaColumn<bool> AlphaToCoverageEnabledColumn() const
+    {
+        return SlotColumn<bool>(SOA::kAlphaToCoverageEnabledIndex);
+    }
+
+    //-----------------------------------------------
+    // FIELD DepthTestEnabled
+    inline bool DepthTestEnabled(Id id) const
+    {
+        DIVE_ASSERT(IsValidId(id));
+        uint32_t index = static_cast<typename Id::basic_type>(id);
+        return SlotValue<bool>(SOA::kDepthTestEnabledIndex, index);
+    }
+    inline bool IsDepthTestEnabledSet(Id id) const
+    {
+        DIVE_ASSERT(IsValidId(id));
+        return IsSlotSet(SOA::kDepthTestEnabledIndex, static_cast<typename Id::basic_type>(id));
+    }
+    // `DepthTestEnabledChanges()` returns the ids at which `DepthTestEnabled` changes
+    inline const std::vector<uint32_t>& DepthTestEnabledChanges() const
+    {
+        return GetSlotChanges(SOA::kDepthTestEnabledIndex);
+    }
+    // `DepthTestEnabledColumn()` returns a read-only view of the runs of `DepthTestEnabled`
+    inline StructOfArraysDeltaColumn<bool> DepthTestEnabledColumn() const
+    {
+        return SlotColumn<bool>(SOA::kDepthTestEnabledIndex);
+    }
+
+    //-----------------------------------------------
+    // FIELD DepthWriteEnabled
+    inline bool DepthWriteEnabled(Id id) const
+    {
+        DIVE_ASSERT(IsValidId(id));
+        uint32_t index = static_cast<typename Id::basic_type>(id);
+        return SlotValue<bool>(SOA::kDepthWriteEnabledIndex, index);
+    }
+    inline bool IsDepthWriteEnabledSet(Id id) const
+    {
+        DIVE_ASSERT(IsValidId(id));
+        return IsSlotSet(SOA::kDepthWriteEnabledIndex, static_cast<typename Id::basic_type>(id));
+    }
+    // `DepthWriteEnabledChanges()` returns the ids at which `DepthWriteEnabled` changes
+    inline const std::vector<uint32_t>& DepthWriteEnabledChanges() const
+    {
+        return GetSlotChanges(SOA::kDepthWriteEnabledIndex);
+    }
+    // `DepthWriteEnabledColumn()` returns a read-only view of the runs of `DepthWriteEnabled`
+    inline StructOfArraysDeltaColumn<bool> DepthWriteEnabledColumn() const
+    {
+        return SlotColumn<bool>(SOA::kDepthWriteEnabledIndex);
+    }
+
+    //-----------------------------------------------
+    // FIELD DepthCompareOp
+    inline VkCompareOp DepthCompareOp(Id id) const
+    {
+        DIVE_ASSERT(IsValidId(id));
+        uint32_t index = static_cast<typename Id::basic_type>(id);
+        return SlotValue<VkCompareOp>(SOA::kDepthCompareOpIndex, index);
+    }
+    inline bool IsDepthCompareOpSet(Id id) const
+    {
+        DIVE_ASSERT(IsValidId(id));
+        return IsSlotSet(SOA::kDepthCompareOpIndex, static_cast<typename Id::basic_type>(id));
+    }
+    // `DepthCompareOpChanges()` returns the ids at which `DepthCompareOp` changes
+    inline const std::vector<uint32_t>& DepthCompareOpChanges() const
+    {
+        return GetSlotChanges(SOA::kDepthCompareOpIndex);
+    }
+    // `DepthCompareOpColumn()` returns a read-only view of the runs of `DepthCompareOp`
+    inline StructOfArraysDeltaColumn<VkCompareOp> DepthCompareOpColumn() const
+    {
+        return SlotColumn<VkCompareOp>(SOA::kDepthCompareOpIndex);
+    }
+
+    //-----------------------------------------------
+    // FIELD DepthBoundsTestEnabled
+    inline bool DepthBoundsTestEnabled(Id id) const
+    {
+        DIVE_ASSERT(IsValidId(id));
+        uint32_t index = static_cast<typename Id::basic_type>(id);
+        return SlotValue<bool>(SOA::kDepthBoundsTestEnabledIndex, index);
+    }
+    inline bool IsDepthBoundsTestEnabledSet(Id id) const
+    {
+        DIVE_ASSERT(IsValidId(id));
+        return IsSlotSet(SOA::kDepthBoundsTestEnabledIndex,
+                         static_cast<typename Id::basic_type>(id));
+    }
+    // `DepthBoundsTestEnabledChanges()` returns the ids at which `DepthBoundsTestEnabled` changes
+    inline const std::vector<uint32_t>& DepthBoundsTestEnabledChanges() const
+    {
+        return GetSlotChanges(SOA::kDepthBoundsTestEnabledIndex);
+    }
+    // `DepthBoundsTestEnabledColumn()` returns a read-only view of the runs of
+    // `DepthBoundsTestEnabled`
+    inline StructOfArraysDeltaColumn<bool> DepthBoundsTestEnabledColumn() const
+    {
+        return SlotColumn<bool>(SOA::kDepthBoundsTestEnabledIndex);
+    }
+
+    //-----------------------------------------------
+    // FIELD MinDepthBounds
+    inline float MinDepthBounds(Id id) const
+    {
+        DIVE_ASSERT(IsValidId(id));
+        uint32_t index = static_cast<typename Id::basic_type>(id);
+        return SlotValue<float>(SOA::kMinDepthBoundsIndex, index);
+    }
+    inline bool IsMinDepthBoundsSet(Id id) const
+    {
+        DIVE_ASSERT(IsValidId(id));
+        return IsSlotSet(SOA::kMinDepthBoundsIndex, static_cast<typename Id::basic_type>(id));
+    }
+    // `MinDepthBoundsChanges()` returns the ids at which `MinDepthBounds` changes
+    inline const std::vector<uint32_t>& MinDepthBoundsChanges() const
+    {
+        return GetSlotChanges(SOA::kMinDepthBoundsIndex);
+    }
+    // `MinDepthBoundsColumn()` returns a read-only view of the runs of `MinDepthBounds`
+    inline StructOfArraysDeltaColumn<float> MinDepthBoundsColumn() const
+    {
+        return SlotColumn<float>(SOA::kMinDepthBoundsIndex);
+    }
+
+    //-----------------------------------------------
+    // FIELD MaxDepthBounds
+    inline float MaxDepthBounds(Id id) const
+    {
+        DIVE_ASSERT(IsValidId(id));
+        uint32_t index = static_cast<typename Id::basic_type>(id);
+        return SlotValue<float>(SOA::kMaxDepthBoundsIndex, index);
+    }
+    inline bool IsMaxDepthBoundsSet(Id id) const
+    {
+        DIVE_ASSERT(IsValidId(id));
+        return IsSlotSet(SOA::kMaxDepthBoundsIndex, static_cast<typename Id::basic_type>(id));
+    }
+    // `MaxDepthBoundsChanges()` returns the ids at which `MaxDepthBounds` changes
+    inline const std::vector<uint32_t>& MaxDepthBoundsChanges() const
+    {
+        return GetSlotChanges(SOA::kMaxDepthBoundsIndex);
+    }
+    // `MaxDepthBoundsColumn()` returns a read-only view of the runs of `MaxDepthBounds`
+    inline StructOfArraysDeltaColumn<float> MaxDepthBoundsColumn() const
+    {
+        return SlotColumn<float>(SOA::kMaxDepthBoundsIndex);
+    }
+
+    //-----------------------------------------------
+    // FIELD StencilTestEnabled
+    inline bool StencilTestEnabled(Id id) const
+    {
+        DIVE_ASSERT(IsValidId(id));
+        uint32_t index = static_cast<typename Id::basic_type>(id);
+        return SlotValue<bool>(SOA::kStencilTestEnabledIndex, index);
+    }
+    inline bool IsStencilTestEnabledSet(Id id) const
+    {
+        DIVE_ASSERT(IsValidId(id));
+        return IsSlotSet(SOA::kStencilTestEnabledIndex, static_cast<typename Id::basic_type>(id));
+    }
+    // `StencilTestEnabledChanges()` returns the ids at which `StencilTestEnabled` changes
+    inline const std::vector<uint32_t>& StencilTestEnabledChanges() const
+    {
+        return GetSlotChanges(SOA::kStencilTestEnabledIndex);
+    }
+    // `StencilTestEnabledColumn()` returns a read-only view of the runs of `StencilTestEnabled`
+    inline StructOfArraysDeltaColumn<bool> StencilTestEnabledColumn() const
+    {
+        return SlotColumn<bool>(SOA::kStencilTestEnabledIndex);
+    }
+
+    //-----------------------------------------------
+    // FIELD StencilOpStateFront
+    inline VkStencilOpState StencilOpStateFront(Id id) const
+    {
+        DIVE_ASSERT(IsValidId(id));
+        uint32_t index = static_cast<typename Id::basic_type>(id);
+        return SlotValue<VkStencilOpState>(SOA::kStencilOpStateFrontIndex, index);
+    }
+    inline bool IsStencilOpStateFrontSet(Id id) const
+    {
+        DIVE_ASSERT(IsValidId(id));
+        return IsSlotSet(SOA::kStencilOpStateFrontIndex, static_cast<typename Id::basic_type>(id));
+    }
+    // `StencilOpStateFrontChanges()` returns the ids at which `StencilOpStateFront` changes
+    inline const std::vector<uint32_t>& StencilOpStateFrontChanges() const
+    {
+        return GetSlotChanges(SOA::kStencilOpStateFrontIndex);
+    }
+    // `StencilOpStateFrontColumn()` returns a read-only view of the runs of `StencilOpStateFront`
+    inline StructOfArraysDeltaColumn<VkStencilOpState> StencilOpStateFrontColumn() const
+    {
+        return SlotColumn<VkStencilOpState>(SOA::kStencilOpStateFrontIndex);
+    }
+
+    //-----------------------------------------------
+    // FIELD StencilOpStateBack
+    inline VkStencilOpState StencilOpStateBack(Id id) const
+    {
+        DIVE_ASSERT(IsValidId(id));
+        uint32_t index = static_cast<typename Id::basic_type>(id);
+        return SlotValue<VkStencilOpState>(SOA::kStencilOpStateBackIndex, index);
+    }
+    inline bool IsStencilOpStateBackSet(Id id) const
+    {
+        DIVE_ASSERT(IsValidId(id));
+        return IsSlotSet(SOA::kStencilOpStateBackIndex, static_cast<typename Id::basic_type>(id));
+    }
+    // `StencilOpStateBackChanges()` returns the ids at which `StencilOpStateBack` changes
+    inline const std::vector<uint32_t>& StencilOpStateBackChanges() const
+    {
+        return GetSlotChanges(SOA::kStencilOpStateBackIndex);
+    }
+    // `StencilOpStateBackColumn()` returns a read-only view of the runs of `StencilOpStateBack`
+    inline StructOfArraysDeltaColumn<VkStencilOpState> StencilOpStateBackColumn() const
+    {
+        return SlotColumn<VkStencilOpState>(SOA::kStencilOpStateBackIndex);
+    }
+
+    //-----------------------------------------------
+    // FIELD LogicOpEnabled
+    inline bool LogicOpEnabled(Id id, uint32_t attachment) const
+    {
+        DIVE_ASSERT(IsValidId(id));
+        uint32_t index = static_cast<typename Id::basic_type>(id);
+        return SlotValue<bool>(SOA::kLogicOpEnabledIndex + attachment, index);
+    }
+    inline bool IsLogicOpEnabledSet(Id id, uint32_t attachment) const
+    {
+        DIVE_ASSERT(IsValidId(id));
+        return IsSlotSet(SOA::kLogicOpEnabledIndex + attachment,
+                         static_cast<typename Id::basic_type>(id));
+    }
+    // `LogicOpEnabledChanges()` returns the ids at which `LogicOpEnabled` changes
+    inline const std::vector<uint32_t>& LogicOpEnabledChanges(uint32_t attachment = 0) const
+    {
+        return GetSlotChanges(SOA::kLogicOpEnabledIndex + attachment);
+    }
+    // `LogicOpEnabledColumn()` returns a read-only view of the runs of `LogicOpEnabled`
+    inline StructOfArraysDeltaColumn<bool> LogicOpEnabledColumn(uint32_t attachment = 0) const
+    {
+        return SlotColumn<bool>(SOA::kLogicOpEnabledIndex + attachment);
+    }
+
+    //-----------------------------------------------
+    // FIELD LogicOp
+    inline VkLogicOp LogicOp(Id id, uint32_t attachment) const
+    {
+        DIVE_ASSERT(IsValidId(id));
+        uint32_t index = static_cast<typename Id::basic_type>(id);
+        return SlotValue<VkLogicOp>(SOA::kLogicOpIndex + attachment, index);
+    }
+    inline bool IsLogicOpSet(Id id, uint32_t attachment) const
+    {
+        DIVE_ASSERT(IsValidId(id));
+        return IsSlotSet(SOA::kLogicOpIndex + attachment, static_cast<typename Id::basic_type>(id));
+    }
+    // `LogicOpChanges()` returns the ids at which `LogicOp` changes
+    inline const std::vector<uint32_t>& LogicOpChanges(uint32_t attachment = 0) const
+    {
+        return GetSlotChanges(SOA::kLogicOpIndex + attachment);
+    }
+    // `LogicOpColumn()` returns a read-only view of the runs of `LogicOp`
+    inline StructOfArraysDeltaColumn<VkLogicOp> LogicOpColumn(uint32_t attachment = 0) const
+    {
+        return SlotColumn<VkLogicOp>(SOA::kLogicOpIndex + attachment);
+    }
+
+    //-----------------------------------------------
+    // FIELD Attachment
+    inline VkPipelineColorBlendAttachmentState Attachment(Id id, uint32_t attachment) const
+    {
+        DIVE_ASSERT(IsValidId(id));
+        uint32_t index = static_cast<typename Id::basic_type>(id);
+        return SlotValue<VkPipelineColorBlendAttachmentState>(SOA::kAttachmentIndex + attachment,
+                                                              index);
+    }
+    inline bool IsAttachmentSet(Id id, uint32_t attachment) const
+    {
+        DIVE_ASSERT(IsValidId(id));
+        return IsSlotSet(SOA::kAttachmentIndex + attachment,
+                         static_cast<typename Id::basic_type>(id));
+    }
+    // `AttachmentChanges()` returns the ids at which `Attachment` changes
+    inline const std::vector<uint32_t>& AttachmentChanges(uint32_t attachment = 0) const
+    {
+        return GetSlotChanges(SOA::kAttachmentIndex + attachment);
+    }
+    // `AttachmentColumn()` returns a read-only view of the runs of `Attachment`
+    inline StructOfArraysDeltaColumn<VkPipelineColorBlendAttachmentState> AttachmentColumn(
+    uint32_t attachment = 0) const
+    {
+        return SlotColumn<VkPipelineColorBlendAttachmentState>(SOA::kAttachmentIndex + attachment);
+    }
+
+    //-----------------------------------------------
+    // FIELD BlendConstant
+    inline float BlendConstant(Id id, uint32_t channel) const
+    {
+        DIVE_ASSERT(IsValidId(id));
+        uint32_t index = static_cast<typename Id::basic_type>(id);
+        return SlotValue<float>(SOA::kBlendConstantIndex + channel, index);
+    }
+    inline bool IsBlendConstantSet(Id id, uint32_t channel) const
+    {
+        DIVE_ASSERT(IsValidId(id));
+        return IsSlotSet(SOA::kBlendConstantIndex + channel,
+                         static_cast<typename Id::basic_type>(id));
+    }
+    // `BlendConstantChanges()` returns the ids at which `BlendConstant` changes
+    inline const std::vector<uint32_t>& BlendConstantChanges(uint32_t channel = 0) const
+    {
+        return GetSlotChanges(SOA::kBlendConstantIndex + channel);
+    }
+    // `BlendConstantColumn()` returns a read-only view of the runs of `BlendConstant`
+    inline StructOfArraysDeltaColumn<float> BlendConstantColumn(uint32_t channel = 0) const
+    {
+        return SlotColumn<float>(SOA::kBlendConstantIndex + channel);
+    }
+
+    //-----------------------------------------------
+    // FIELD LRZEnabled
+    inline bool LRZEnabled(Id id) const
+    {
+        DIVE_ASSERT(IsValidId(id));
+        uint32_t index = static_cast<typename Id::basic_type>(id);
+        return SlotValue<bool>(SOA::kLRZEnabledIndex, index);
+    }
+    inline bool IsLRZEnabledSet(Id id) const
+    {
+        DIVE_ASSERT(IsValidId(id));
+        return IsSlotSet(SOA::kLRZEnabledIndex, static_cast<typename Id::basic_type>(id));
+    }
+    // `LRZEnabledChanges()` returns the ids at which `LRZEnabled` changes
+    inline const std::vector<uint32_t>& LRZEnabledChanges() const
+    {
+        return GetSlotChanges(SOA::kLRZEnabledIndex);
+    }
+    // `LRZEnabledColumn()` returns a read-only view of the runs of `LRZEnabled`
+    inline StructOfArraysDeltaColumn<bool> LRZEnabledColumn() const
+    {
+        return SlotColumn<bool>(SOA::kLRZEnabledIndex);
+    }
+
+    //-----------------------------------------------
+    // FIELD LRZWrite
+    inline bool LRZWrite(Id id) const
+    {
+        DIVE_ASSERT(IsValidId(id));
+        uint32_t index = static_cast<typename Id::basic_type>(id);
+        return SlotValue<bool>(SOA::kLRZWriteIndex, index);
+    }
+    inline bool IsLRZWriteSet(Id id) const
+    {
+        DIVE_ASSERT(IsValidId(id));
+        return IsSlotSet(SOA::kLRZWriteIndex, static_cast<typename Id::basic_type>(id));
+    }
+    // `LRZWriteChanges()` returns the ids at which `LRZWrite` changes
+    inline const std::vector<uint32_t>& LRZWriteChanges() const
+    {
+        return GetSlotChanges(SOA::kLRZWriteIndex);
+    }
+    // `LRZWriteColumn()` returns a read-only view of the runs of `LRZWrite`
+    inline StructOfArraysDeltaColumn<bool> LRZWriteColumn() const
+    {
+        return SlotColumn<bool>(SOA::kLRZWriteIndex);
+    }
+
+    //-----------------------------------------------
+    // FIELD LRZDirStatus
+    inline a6xx_lrz_dir_status LRZDirStatus(Id id) const
+    {
+        DIVE_ASSERT(IsValidId(id));
+        uint32_t index = static_cast<typename Id::basic_type>(id);
+        return SlotValue<a6xx_lrz_dir_status>(SOA::kLRZDirStatusIndex, index);
+    }
+    inline bool IsLRZDirStatusSet(Id id) const
+    {
+        DIVE_ASSERT(IsValidId(id));
+        return IsSlotSet(SOA::kLRZDirStatusIndex, static_cast<typename Id::basic_type>(id));
+    }
+    // `LRZDirStatusChanges()` returns the ids at which `LRZDirStatus` changes
+    inline const std::vector<uint32_t>& LRZDirStatusChanges() const
+    {
+        return GetSlotChanges(SOA::kLRZDirStatusIndex);
+    }
+    // `LRZDirStatusColumn()` returns a read-only view of the runs of `LRZDirStatus`
+    inline StructOfArraysDeltaColumn<a6xx_lrz_dir_status> LRZDirStatusColumn() const
+    {
+        return SlotColumn<a6xx_lrz_dir_status>(SOA::kLRZDirStatusIndex);
+    }
+
+    //-----------------------------------------------
+    // FIELD LRZDirWrite
+    inline bool LRZDirWrite(Id id) const
+    {
+        DIVE_ASSERT(IsValidId(id));
+        uint32_t index = static_cast<typename Id::basic_type>(id);
+        return SlotValue<bool>(SOA::kLRZDirWriteIndex, index);
+    }
+    inline bool IsLRZDirWriteSet(Id id) const
+    {
+        DIVE_ASSERT(IsValidId(id));
+        return IsSlotSet(SOA::kLRZDirWriteIndex, static_cast<typename Id::basic_type>(id));
+    }
+    // `LRZDirWriteChanges()` returns the ids at which `LRZDirWrite` changes
+    inline const std::vector<uint32_t>& LRZDirWriteChanges() const
+    {
+        return GetSlotChanges(SOA::kLRZDirWriteIndex);
+    }
+    // `LRZDirWriteColumn()` returns a read-only view of the runs of `LRZDirWrite`
+    inline StructOfArraysDeltaColumn<bool> LRZDirWriteColumn() const
+    {
+        return SlotColumn<bool>(SOA::kLRZDirWriteIndex);
+    }
+
+    //-----------------------------------------------
+    // FIELD ZTestMode
+    inline a6xx_ztest_mode ZTestMode(Id id) const
+    {
+        DIVE_ASSERT(IsValidId(id));
+        uint32_t index = static_cast<typename Id::basic_type>(id);
+        return SlotValue<a6xx_ztest_mode>(SOA::kZTestModeIndex, index);
+    }
+    inline bool IsZTestModeSet(Id id) const
+    {
+        DIVE_ASSERT(IsValidId(id));
+        return IsSlotSet(SOA::kZTestModeIndex, static_cast<typename Id::basic_type>(id));
+    }
+    // `ZTestModeChanges()` returns the ids at which `ZTestMode` changes
+    inline const std::vector<uint32_t>& ZTestModeChanges() const
+    {
+        return GetSlotChanges(SOA::kZTestModeIndex);
+    }
+    // `ZTestModeColumn()` returns a read-only view of the runs of `ZTestMode`
+    inline StructOfArraysDeltaColumn<a6xx_ztest_mode> ZTestModeColumn() const
+    {
+        return SlotColumn<a6xx_ztest_mode>(SOA::kZTestModeIndex);
+    }
+
+    //-----------------------------------------------
+    // FIELD BinW
+    inline uint32_t BinW(Id id) const
+    {
+        DIVE_ASSERT(IsValidId(id));
+        uint32_t index = static_cast<typename Id::basic_type>(id);
+        return SlotValue<uint32_t>(SOA::kBinWIndex, index);
+    }
+    inline bool IsBinWSet(Id id) const
+    {
+        DIVE_ASSERT(IsValidId(id));
+        return IsSlotSet(SOA::kBinWIndex, static_cast<typename Id::basic_type>(id));
+    }
+    // `BinWChanges()` returns the ids at which `BinW` changes
+    inline const std::vector<uint32_t>& BinWChanges() const
+    {
+        return GetSlotChanges(SOA::kBinWIndex);
+    }
+    // `BinWColumn()` returns a read-only view of the runs of `BinW`
+    inline StructOfArraysDeltaColumn<uint32_t> BinWColumn() const
+    {
+        return SlotColumn<uint32_t>(SOA::kBinWIndex);
+    }
+
+    //-----------------------------------------------
+    // FIELD BinH
+    inline uint32_t BinH(Id id) const
+    {
+        DIVE_ASSERT(IsValidId(id));
+        uint32_t index = static_cast<typename Id::basic_type>(id);
+        return SlotValue<uint32_t>(SOA::kBinHIndex, index);
+    }
+    inline bool IsBinHSet(Id id) const
+    {
+        DIVE_ASSERT(IsValidId(id));
+        return IsSlotSet(SOA::kBinHIndex, static_cast<typename Id::basic_type>(id));
+    }
+    // `BinHChanges()` returns the ids at which `BinH` changes
+    inline const std::vector<uint32_t>& BinHChanges() const
+    {
+        return GetSlotChanges(SOA::kBinHIndex);
+    }
+    // `BinHColumn()` returns a read-only view of the runs of `BinH`
+    inline StructOfArraysDeltaColumn<uint32_t> BinHColumn() const
+    {
+        return SlotColumn<uint32_t>(SOA::kBinHIndex);
+    }
+
+    //-----------------------------------------------
+    // FIELD WindowScissorTLX
+    inline uint16_t WindowScissorTLX(Id id) const
+    {
+        DIVE_ASSERT(IsValidId(id));
+        uint32_t index = static_cast<typename Id::basic_type>(id);
+        return SlotValue<uint16_t>(SOA::kWindowScissorTLXIndex, index);
+    }
+    inline bool IsWindowScissorTLXSet(Id id) const
+    {
+        DIVE_ASSERT(IsValidId(id));
+        return IsSlotSet(SOA::kWindowScissorTLXIndex, static_cast<typename Id::basic_type>(id));
+    }
+    // `WindowScissorTLXChanges()` returns the ids at which `WindowScissorTLX` changes
+    inline const std::vector<uint32_t>& WindowScissorTLXChanges() const
+    {
+        return GetSlotChanges(SOA::kWindowScissorTLXIndex);
+    }
+    // `WindowScissorTLXColumn()` returns a read-only view of the runs of `WindowScissorTLX`
+    inline StructOfArraysDeltaColumn<uint16_t> WindowScissorTLXColumn() const
+    {
+        return SlotColumn<uint16_t>(SOA::kWindowScissorTLXIndex);
+    }
+
+    //-----------------------------------------------
+    // FIELD WindowScissorTLY
+    inline uint16_t WindowScissorTLY(Id id) const
+    {
+        DIVE_ASSERT(IsValidId(id));
+        uint32_t index = static_cast<typename Id::basic_type>(id);
+        return SlotValue<uint16_t>(SOA::kWindowScissorTLYIndex, index);
+    }
+    inline bool IsWindowScissorTLYSet(Id id) const
+    {
+        DIVE_ASSERT(IsValidId(id));
+        return IsSlotSet(SOA::kWindowScissorTLYIndex, static_cast<typename Id::basic_type>(id));
+    }
+    // `WindowScissorTLYChanges()` returns the ids at which `WindowScissorTLY` changes
+    inline const std::vector<uint32_t>& WindowScissorTLYChanges() const
+    {
+        return GetSlotChanges(SOA::kWindowScissorTLYIndex);
+    }
+    // `WindowScissorTLYColumn()` returns a read-only view of the runs of `WindowScissorTLY`
+    inline StructOfArraysDeltaColumn<uint16_t> WindowScissorTLYColumn() const
+    {
+        return SlotColumn<uint16_t>(SOA::kWindowScissorTLYIndex);
+    }
+
+    //-----------------------------------------------
+    // FIELD WindowScissorBRX
+    inline uint16_t WindowScissorBRX(Id id) const
+    {
+        DIVE_ASSERT(IsValidId(id));
+        uint32_t index = static_cast<typename Id::basic_type>(id);
+        return SlotValue<uint16_t>(SOA::kWindowScissorBRXIndex, index);
+    }
+    inline bool IsWindowScissorBRXSet(Id id) const
+    {
+        DIVE_ASSERT(IsValidId(id));
+        return IsSlotSet(SOA::kWindowScissorBRXIndex, static_cast<typename Id::basic_type>(id));
+    }
+    // `WindowScissorBRXChanges()` returns the ids at which `WindowScissorBRX` changes
+    inline const std::vector<uint32_t>& WindowScissorBRXChanges() const
+    {
+        return GetSlotChanges(SOA::kWindowScissorBRXIndex);
+    }
+    // `WindowScissorBRXColumn()` returns a read-only view of the runs of `WindowScissorBRX`
+    inline StructOfArraysDeltaColumn<uint16_t> WindowScissorBRXColumn() const
+    {
+        return SlotColumn<uint16_t>(SOA::kWindowScissorBRXIndex);
+    }
+
+    //-----------------------------------------------
+    // FIELD WindowScissorBRY
+    inline uint16_t WindowScissorBRY(Id id) const
+    {
+        DIVE_ASSERT(IsValidId(id));
+        uint32_t index = static_cast<typename Id::basic_type>(id);
+        return SlotValue<uint16_t>(SOA::kWindowScissorBRYIndex, index);
+    }
+    inline bool IsWindowScissorBRYSet(Id id) const
+    {
+        DIVE_ASSERT(IsValidId(id));
+        return IsSlotSet(SOA::kWindowScissorBRYIndex, static_cast<typename Id::basic_type>(id));
+    }
+    // `WindowScissorBRYChanges()` returns the ids at which `WindowScissorBRY` changes
+    inline const std::vector<uint32_t>& WindowScissorBRYChanges() const
+    {
+        return GetSlotChanges(SOA::kWindowScissorBRYIndex);
+    }
+    // `WindowScissorBRYColumn()` returns a read-only view of the runs of `WindowScissorBRY`
+    inline StructOfArraysDeltaColumn<uint16_t> WindowScissorBRYColumn() const
+    {
+        return SlotColumn<uint16_t>(SOA::kWindowScissorBRYIndex);
+    }
+
+    //-----------------------------------------------
+    // FIELD RenderMode
+    inline a6xx_render_mode RenderMode(Id id) const
+    {
+        DIVE_ASSERT(IsValidId(id));
+        uint32_t index = static_cast<typename Id::basic_type>(id);
+        return SlotValue<a6xx_render_mode>(SOA::kRenderModeIndex, index);
+    }
+    inline bool IsRenderModeSet(Id id) const
+    {
+        DIVE_ASSERT(IsValidId(id));
+        return IsSlotSet(SOA::kRenderModeIndex, static_cast<typename Id::basic_type>(id));
+    }
+    // `RenderModeChanges()` returns the ids at which `RenderMode` changes
+    inline const std::vector<uint32_t>& RenderModeChanges() const
+    {
+        return GetSlotChanges(SOA::kRenderModeIndex);
+    }
+    // `RenderModeColumn()` returns a read-only view of the runs of `RenderMode`
+    inline StructOfArraysDeltaColumn<a6xx_render_mode> RenderModeColumn() const
+    {
+        return SlotColumn<a6xx_render_mode>(SOA::kRenderModeIndex);
+    }
+
+    //-----------------------------------------------
+    // FIELD BuffersLocation
+    inline a6xx_buffers_location BuffersLocation(Id id) const
+    {
+        DIVE_ASSERT(IsValidId(id));
+        uint32_t index = static_cast<typename Id::basic_type>(id);
+        return SlotValue<a6xx_buffers_location>(SOA::kBuffersLocationIndex, index);
+    }
+    inline bool IsBuffersLocationSet(Id id) const
+    {
+        DIVE_ASSERT(IsValidId(id));
+        return IsSlotSet(SOA::kBuffersLocationIndex, static_cast<typename Id::basic_type>(id));
+    }
+    // `BuffersLocationChanges()` returns the ids at which `BuffersLocation` changes
+    inline const std::vector<uint32_t>& BuffersLocationChanges() const
+    {
+        return GetSlotChanges(SOA::kBuffersLocationIndex);
+    }
+    // `BuffersLocationColumn()` returns a read-only view of the runs of `BuffersLocation`
+    inline StructOfArraysDeltaColumn<a6xx_buffers_location> BuffersLocationColumn() const
+    {
+        return SlotColumn<a6xx_buffers_location>(SOA::kBuffersLocationIndex);
+    }
+
+    //-----------------------------------------------
+    // FIELD ThreadSize
+    inline a6xx_threadsize ThreadSize(Id id) const
+    {
+        DIVE_ASSERT(IsValidId(id));
+        uint32_t index = static_cast<typename Id::basic_type>(id);
+        return SlotValue<a6xx_threadsize>(SOA::kThreadSizeIndex, index);
+    }
+    inline bool IsThreadSizeSet(Id id) const
+    {
+        DIVE_ASSERT(IsValidId(id));
+        return IsSlotSet(SOA::kThreadSizeIndex, static_cast<typename Id::basic_type>(id));
+    }
+    // `ThreadSizeChanges()` returns the ids at which `ThreadSize` changes
+    inline const std::vector<uint32_t>& ThreadSizeChanges() const
+    {
+        return GetSlotChanges(SOA::kThreadSizeIndex);
+    }
+    // `ThreadSizeColumn()` returns a read-only view of the runs of `ThreadSize`
+    inline StructOfArraysDeltaColumn<a6xx_threadsize> ThreadSizeColumn() const
+    {
+        return SlotColumn<a6xx_threadsize>(SOA::kThreadSizeIndex);
+    }
+
+    //-----------------------------------------------
+    // FIELD EnableAllHelperLanes
+    inline bool EnableAllHelperLanes(Id id) const
+    {
+        DIVE_ASSERT(IsValidId(id));
+        uint32_t index = static_cast<typename Id::basic_type>(id);
+        return SlotValue<bool>(SOA::kEnableAllHelperLanesIndex, index);
+    }
+    inline bool IsEnableAllHelperLanesSet(Id id) const
+    {
+        DIVE_ASSERT(IsValidId(id));
+        return IsSlotSet(SOA::kEnableAllHelperLanesIndex, static_cast<typename Id::basic_type>(id));
+    }
+    // `EnableAllHelperLanesChanges()` returns the ids at which `EnableAllHelperLanes` changes
+    inline const std::vector<uint32_t>& EnableAllHelperLanesChanges() const
+    {
+        return GetSlotChanges(SOA::kEnableAllHelperLanesIndex);
+    }
+    // `EnableAllHelperLanesColumn()` returns a read-only view of the runs of `EnableAllHelperLanes`
+    inline StructOfArraysDeltaColumn<bool> EnableAllHelperLanesColumn() const
+    {
+        return SlotColumn<bool>(SOA::kEnableAllHelperLanesIndex);
+    }
+
+    //-----------------------------------------------
+    // FIELD EnablePartialHelperLanes
+    inline bool EnablePartialHelperLanes(Id id) const
+    {
+        DIVE_ASSERT(IsValidId(id));
+        uint32_t index = static_cast<typename Id::basic_type>(id);
+        return SlotValue<bool>(SOA::kEnablePartialHelperLanesIndex, index);
+    }
+    inline bool IsEnablePartialHelperLanesSet(Id id) const
+    {
+        DIVE_ASSERT(IsValidId(id));
+        return IsSlotSet(SOA::kEnablePartialHelperLanesIndex,
+                         static_cast<typename Id::basic_type>(id));
+    }
+    // `EnablePartialHelperLanesChanges()` returns the ids at which `EnablePartialHelperLanes`
+    // changes
+    inline const std::vector<uint32_t>& EnablePartialHelperLanesChanges() const
+    {
+        return GetSlotChanges(SOA::kEnablePartialHelperLanesIndex);
+    }
+    // `EnablePartialHelperLanesColumn()` returns a read-only view of the runs of
+    // `EnablePartialHelperLanes`
+    inline StructOfArraysDeltaColumn<bool> EnablePartialHelperLanesColumn() const
+    {
+        return SlotColumn<bool>(SOA::kEnablePartialHelperLanesIndex);
+    }
+
+    //-----------------------------------------------
+    // FIELD UBWCEnabled
+    inline bool UBWCEnabled(Id id, uint32_t attachment) const
+    {
+        DIVE_ASSERT(IsValidId(id));
+        uint32_t index = static_cast<typename Id::basic_type>(id);
+        return SlotValue<bool>(SOA::kUBWCEnabledIndex + attachment, index);
+    }
+    inline bool IsUBWCEnabledSet(Id id, uint32_t attachment) const
+    {
+        DIVE_ASSERT(IsValidId(id));
+        return IsSlotSet(SOA::kUBWCEnabledIndex + attachment,
+                         static_cast<typename Id::basic_type>(id));
+    }
+    // `UBWCEnabledChanges()` returns the ids at which `UBWCEnabled` changes
+    inline const std::vector<uint32_t>& UBWCEnabledChanges(uint32_t attachment = 0) const
+    {
+        return GetSlotChanges(SOA::kUBWCEnabledIndex + attachment);
+    }
+    // `UBWCEnabledColumn()` returns a read-only view of the runs of `UBWCEnabled`
+    inline StructOfArraysDeltaColumn<bool> UBWCEnabledColumn(uint32_t attachment = 0) const
+    {
+        return SlotColumn<bool>(SOA::kUBWCEnabledIndex + attachment);
+    }
+
+    //-----------------------------------------------
+    // FIELD UBWCLosslessEnabled
+    inline bool UBWCLosslessEnabled(Id id, uint32_t attachment) const
+    {
+        DIVE_ASSERT(IsValidId(id));
+        uint32_t index = static_cast<typename Id::basic_type>(id);
+        return SlotValue<bool>(SOA::kUBWCLosslessEnabledIndex + attachment, index);
+    }
+    inline bool IsUBWCLosslessEnabledSet(Id id, uint32_t attachment) const
+    {
+        DIVE_ASSERT(IsValidId(id));
+        return IsSlotSet(SOA::kUBWCLosslessEnabledIndex + attachment,
+                         static_cast<typename Id::basic_type>(id));
+    }
+    // `UBWCLosslessEnabledChanges()` returns the ids at which `UBWCLosslessEnabled` changes
+    inline const std::vector<uint32_t>& UBWCLosslessEnabledChanges(uint32_t attachment = 0) const
+    {
+        return GetSlotChanges(SOA::kUBWCLosslessEnabledIndex + attachment);
+    }
+    // `UBWCLosslessEnabledColumn()` returns a read-only view of the runs of `UBWCLosslessEnabled`
+    inline StructOfArraysDeltaColumn<bool> UBWCLosslessEnabledColumn(uint32_t attachment = 0) const
+    {
+        return SlotColumn<bool>(SOA::kUBWCLosslessEnabledIndex + attachment);
+    }
+
+    //-----------------------------------------------
+    // FIELD UBWCEnabledOnDS
+    inline bool UBWCEnabledOnDS(Id id) const
+    {
+        DIVE_ASSERT(IsValidId(id));
+        uint32_t index = static_cast<typename Id::basic_type>(id);
+        return SlotValue<bool>(SOA::kUBWCEnabledOnDSIndex, index);
+    }
+    inline bool IsUBWCEnabledOnDSSet(Id id) const
+    {
+        DIVE_ASSERT(IsValidId(id));
+        return IsSlotSet(SOA::kUBWCEnabledOnDSIndex, static_cast<typename Id::basic_type>(id));
+    }
+    // `UBWCEnabledOnDSChanges()` returns the ids at which `UBWCEnabledOnDS` changes
+    inline const std::vector<uint32_t>& UBWCEnabledOnDSChanges() const
+    {
+        return GetSlotChanges(SOA::kUBWCEnabledOnDSIndex);
+    }
+    // `UBWCEnabledOnDSColumn()` returns a read-only view of the runs of `UBWCEnabledOnDS`
+    inline StructOfArraysDeltaColumn<bool> UBWCEnabledOnDSColumn() const
+    {
+        return SlotColumn<bool>(SOA::kUBWCEnabledOnDSIndex);
+    }
+
+    //-----------------------------------------------
+    // FIELD UBWCLosslessEnabledOnDS
+    inline bool UBWCLosslessEnabledOnDS(Id id) const
+    {
+        DIVE_ASSERT(IsValidId(id));
+        uint32_t index = static_cast<typename Id::basic_type>(id);
+        return SlotValue<bool>(SOA::kUBWCLosslessEnabledOnDSIndex, index);
+    }
+    inline bool IsUBWCLosslessEnabledOnDSSet(Id id) const
+    {
+        DIVE_ASSERT(IsValidId(id));
+        return IsSlotSet(SOA::kUBWCLosslessEnabledOnDSIndex,
+                         static_cast<typename Id::basic_type>(id));
+    }
+    // `UBWCLosslessEnabledOnDSChanges()` returns the ids at which `UBWCLosslessEnabledOnDS` changes
+    inline const std::vector<uint32_t>& UBWCLosslessEnabledOnDSChanges() const
+    {
+        return GetSlotChanges(SOA::kUBWCLosslessEnabledOnDSIndex);
+    }
+    // `UBWCLosslessEnabledOnDSColumn()` returns a read-only view of the runs of
+    // `UBWCLosslessEnabledOnDS`
+    inline StructOfArraysDeltaColumn<bool> UBWCLosslessEnabledOnDSColumn() const
+    {
+        return SlotColumn<bool>(SOA::kUBWCLosslessEnabledOnDSIndex);
+    }
+
+private:
+    // Decodes the elements `ids` into `soa`, or every element if `ids` is null
+    void DecodeElements(const std::vector<uint32_t>* ids, SOA* soa) const;
+};
+
 }  // namespace Dive
@@ -0,0 +1,258 @@
+/*
+ Copyright 2025 Google LLC
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#include "event_state_groups.h"
+#include <type_traits>
+#include <utility>
+#include "capture_event_info.h"
+
+namespace Dive
+{
+
+namespace
+{
+
+// Array sizes of the EventStateInfo array fields (see event_state.json)
+constexpr uint32_t kNumViewports = 16;
+constexpr uint32_t kNumAttachments = 8;
+constexpr uint32_t kNumBlendConstants = 4;
+
+// Serializes a group of fields. Only the is-set flag is recorded for unset fields, so that stale
+// values in unset fields never split a state.
+class StateKey
+{
+public:
+    template<typename T> void Add(bool is_set, const T &value)
+    {
+        static_assert(std::is_trivially_copyable<T>::value,
+                      "Field type must be trivially copyable");
+        m_bytes.push_back(is_set ? 1 : 0);
+        if (is_set)
+            m_bytes.append(reinterpret_cast<const char *>(&value), sizeof(T));
+    }
+
+    std::string &&Take() { return std::move(m_bytes); }
+
+private:
+    std::string m_bytes;
+};
+
+#define ADD_FIELD(key, field) key.Add(event_state.Is##field##Set(id), event_state.field(id))
+
+#define ADD_ARRAY_FIELD(key, field, count)                                    \
+    for (uint32_t i = 0; i < count; ++i)                                      \
+    {                                                                         \
+        key.Add(event_state.Is##field##Set(id, i), event_state.field(id, i)); \
+    }
+
+}  // namespace
+
+// =====================================================================================================================
+// EventStateGroups
+// =====================================================================================================================
+const char *EventStateGroups::GetGroupName(Group group)
+{
+    switch (group)
+    {
+    case kInputAssembly: return "Input Assembly";
+    case kViewport: return "Viewport";
+    case kRasterizer: return "Rasterizer";
+    case kMultisample: return "Multisample";
+    case kDepthStencil: return "Depth/Stencil";
+    case kColorBlend: return "Color Blend";
+    case kLrz: return "LRZ";
+    case kHardware: return "GPU-specific";
+    case kShaders: return "Shaders";
+    default: DIVE_ASSERT(false); return "";
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+void EventStateGroups::AddEvent(const EventStateInfo &event_state, const EventInfoTable &event_info)
+{
+    DIVE_ASSERT(!m_finalized);
+    DIVE_ASSERT(event_state.size() == m_num_events + 1);
+    DIVE_ASSERT(event_info.size() == m_num_events + 1);
+    EventStateId id(m_num_events);
+
+    {
+        StateKey key;
+        ADD_FIELD(key, Topology);
+        ADD_FIELD(key, PrimRestartEnabled);
+        ADD_FIELD(key, PatchControlPoints);
+        AssignStateId(kInputAssembly, key.Take());
+    }
+    {
+        StateKey key;
+        ADD_ARRAY_FIELD(key, Viewport, kNumViewports);
+        ADD_ARRAY_FIELD(key, Scissor, kNumViewports);
+        AssignStateId(kViewport, key.Take());
+    }
+    {
+        StateKey key;
+        ADD_FIELD(key, DepthClampEnabled);
+        ADD_FIELD(key, RasterizerDiscardEnabled);
+        ADD_FIELD(key, PolygonMode);
+        ADD_FIELD(key, CullMode);
+        ADD_FIELD(key, FrontFace);
+        ADD_FIELD(key, DepthBiasEnabled);
+        ADD_FIELD(key, DepthBiasConstantFactor);
+        ADD_FIELD(key, DepthBiasClamp);
+        ADD_FIELD(key, DepthBiasSlopeFactor);
+        ADD_FIELD(key, LineWidth);
+        AssignStateId(kRasterizer, key.Take());
+    }
+    {
+        StateKey key;
+        ADD_FIELD(key, RasterizationSamples);
+        ADD_FIELD(key, SampleShadingEnabled);
+        ADD_FIELD(key, MinSampleShading);
+        ADD_FIELD(key, SampleMask);
+        ADD_FIELD(key, AlphaToCoverageEnabled);
+        AssignStateId(kMultisample, key.Take());
+    }
+    {
+        StateKey key;
+        ADD_FIELD(key, DepthTestEnabled);
+        ADD_FIELD(key, DepthWriteEnabled);
+        ADD_FIELD(key, DepthCompareOp);
+        ADD_FIELD(key, DepthBoundsTestEnabled);
+        ADD_FIELD(key, MinDepthBounds);
+        ADD_FIELD(key, MaxDepthBounds);
+        ADD_FIELD(key, StencilTestEnabled);
+        ADD_FIELD(key, StencilOpStateFront);
+        ADD_FIELD(key, StencilOpStateBack);
+        AssignStateId(kDepthStencil, key.Take());
+    }
+    {
+        StateKey key;
+        ADD_ARRAY_FIELD(key, LogicOpEnabled, kNumAttachments);
+        ADD_ARRAY_FIELD(key, LogicOp, kNumAttachments);
+        ADD_ARRAY_FIELD(key, Attachment, kNumAttachments);
+        ADD_ARRAY_FIELD(key, BlendConstant, kNumBlendConstants);
+        AssignStateId(kColorBlend, key.Take());
+    }
+    {
+        StateKey key;
+        ADD_FIELD(key, LRZEnabled);
+        ADD_FIELD(key, LRZWrite);
+        ADD_FIELD(key, LRZDirStatus);
+        ADD_FIELD(key, LRZDirWrite);
+        ADD_FIELD(key, ZTestMode);
+        AssignStateId(kLrz, key.Take());
+    }
+    {
+        StateKey key;
+        ADD_FIELD(key, BinW);
+        ADD_FIELD(key, BinH);
+        ADD_FIELD(key, WindowScissorTLX);
+        ADD_FIELD(key, WindowScissorTLY);
+        ADD_FIELD(key, WindowScissorBRX);
+        ADD_FIELD(key, WindowScissorBRY);
+        ADD_FIELD(key, RenderMode);
+        ADD_FIELD(key, BuffersLocation);
+        ADD_FIELD(key, ThreadSize);
+        ADD_FIELD(key, EnableAllHelperLanes);
+        ADD_FIELD(key, EnablePartialHelperLanes);
+        ADD_ARRAY_FIELD(key, UBWCEnabled, kNumAttachments);
+        ADD_ARRAY_FIELD(key, UBWCLosslessEnabled, kNumAttachments);
+        ADD_FIELD(key, UBWCEnabledOnDS);
+        ADD_FIELD(key, UBWCLosslessEnabledOnDS);
+        AssignStateId(kHardware, key.Take());
+    }
+    {
+        StateKey key;
+        for (const ShaderReference &ref : event_info.GetShaderReferences(m_num_events))
+        {
+            key.Add(true, ref.m_shader_index);
+            key.Add(true, ref.m_stage);
+            key.Add(true, ref.m_enable_mask);
+        }
+        for (uint32_t stage = 0; stage < (uint32_t)ShaderStage::kShaderStageCount; ++stage)
+        {
+            // Separates the lists of consecutive stages
+            auto                      shader_stage = static_cast<ShaderStage>(stage);
+            std::span<const uint32_t> buffer_indices = event_info.GetBufferIndices(m_num_events,
+                                                                                   shader_stage);
+            key.Add(true, static_cast<uint32_t>(buffer_indices.size()));
+            for (uint32_t buffer_index : buffer_indices)
+                key.Add(true, buffer_index);
+        }
+        AssignStateId(kShaders, key.Take());
+    }
+
+    m_num_events++;
+}
+
+//--------------------------------------------------------------------------------------------------
+void EventStateGroups::Finalize()
+{
+    for (Table &table : m_tables)
+    {
+        table.m_state_ids = std::unordered_map<std::string, uint32_t>();
+        table.m_state_events.shrink_to_fit();
+        for (std::vector<uint32_t> &events : table.m_state_events)
+            events.shrink_to_fit();
+        table.m_event_state_ids.shrink_to_fit();
+    }
+    m_finalized = true;
+}
+
+//--------------------------------------------------------------------------------------------------
+void EventStateGroups::Clear()
+{
+    m_num_events = 0;
+    m_finalized = false;
+    for (Table &table : m_tables)
+        table = Table();
+}
+
+//--------------------------------------------------------------------------------------------------
+uint32_t EventStateGroups::GetStateId(Group group, uint32_t event_id) const
+{
+    DIVE_ASSERT(group < kGroupCount);
+    DIVE_ASSERT(event_id < m_num_events);
+    return m_tables[group].m_event_state_ids[event_id];
+}
+
+//--------------------------------------------------------------------------------------------------
+uint32_t EventStateGroups::GetNumDistinctStates(Group group) const
+{
+    DIVE_ASSERT(group < kGroupCount);
+    return static_cast<uint32_t>(m_tables[group].m_state_events.size());
+}
+
+//--------------------------------------------------------------------------------------------------
+const std::vector<uint32_t> &EventStateGroups::GetEvents(Group group, uint32_t state_id) const
+{
+    DIVE_ASSERT(group < kGroupCount);
+    DIVE_ASSERT(state_id < m_tables[group].m_state_events.size());
+    return m_tables[group].m_state_events[state_id];
+}
+
+//--------------------------------------------------------------------------------------------------
+void EventStateGroups::AssignStateId(Group group, std::string &&key)
+{
+    Table   &table = m_tables[group];
+    uint32_t next_id = static_cast<uint32_t>(table.m_state_events.size());
+    auto [it, inserted] = table.m_state_ids.emplace(std::move(key), next_id);
+    if (inserted)
+        table.m_state_events.emplace_back();
+    table.m_state_events[it->second].push_back(m_num_events);
+    table.m_event_state_ids.push_back(it->second);
+}
+
+}  // namespace Dive
@@ -0,0 +1,105 @@
+/*
+ Copyright 2025 Google LLC
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+// =====================================================================================================================
+// State group ids. The state of each event is split into groups (blend, depth/stencil, raster,
+// ...) and the distinct states of each group are numbered in order of first use, so two events
+// share a group's state iff they have the same id, and the events using each state can be listed.
+//
+// This is an index over CaptureMetadata::m_event_state, which stays the storage of the values: its
+// delta encoding already keeps one copy per change of state, which is smaller than one id per group
+// per event. The values of a state are read from the state of any of its events.
+// =====================================================================================================================
+
+#pragma once
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "event_state.h"
+
+namespace Dive
+{
+
+class EventInfoTable;
+
+//--------------------------------------------------------------------------------------------------
+class EventStateGroups
+{
+public:
+    enum Group : uint32_t
+    {
+        kInputAssembly,  // Topology, primitive restart, tessellation
+        kViewport,       // Viewports and scissors
+        kRasterizer,
+        kMultisample,
+        kDepthStencil,
+        kColorBlend,
+        kLrz,       // LRZ and Z-test mode
+        kHardware,  // Remaining GPU-specific state: bins, window scissor, UBWC, ...
+        kShaders,   // Shader references and buffer indices
+        kGroupCount
+    };
+
+    static const char *GetGroupName(Group group);
+
+    // Assigns the state ids of the next event, i.e. the last element of `event_state` and of
+    // `event_info`. Events must be added in order.
+    void AddEvent(const EventStateInfo &event_state, const EventInfoTable &event_info);
+
+    // Frees the tables used to number new states. No event can be added afterwards
+    void Finalize();
+
+    void Clear();
+
+    uint32_t GetNumEvents() const { return m_num_events; }
+
+    // Id of the distinct state of `group` used by `event_id`
+    uint32_t GetStateId(Group group, uint32_t event_id) const;
+
+    bool IsSameState(Group group, uint32_t event_a, uint32_t event_b) const
+    {
+        return GetStateId(group, event_a) == GetStateId(group, event_b);
+    }
+
+    uint32_t GetNumDistinctStates(Group group) const;
+
+    // Events using the given distinct state, in ascending order. The first one can be used to read
+    // the values of the state from the EventStateInfo/EventInfo.
+    const std::vector<uint32_t> &GetEvents(Group group, uint32_t state_id) const;
+
+private:
+    struct Table
+    {
+        // Serialized state (is-set flags + values of the set fields) to its id
+        std::unordered_map<std::string, uint32_t> m_state_ids;
+
+        // Events using each distinct state, indexed by state id
+        std::vector<std::vector<uint32_t>> m_state_events;
+
+        // State id of each event
+        std::vector<uint32_t> m_event_state_ids;
+    };
+
+    void AssignStateId(Group group, std::string &&key);
+
+    uint32_t m_num_events = 0;
+    bool     m_finalized = false;
+    Table    m_tables[kGroupCount];
+};
+
+}  // namespace Dive
@@ -0,0 +1,388 @@
+/*
+ Copyright 2025 Google LLC
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+
+#include "frame_stability.h"
+#include <algorithm>
+#include <unordered_map>
+#include <utility>
+#include "dive_core/common/common.h"
+#include "data_core.h"
+#include "pm4_capture_data.h"
+#include "thread_pool.h"
+
+namespace Dive
+{
+
+namespace
+{
+
+// Edits beyond which two frames are paired in order rather than aligned, which bounds the memory
+// of an alignment to about 2 * kMaxEdits^2 ints
+constexpr int32_t kMaxEdits = 1024;
+
+//--------------------------------------------------------------------------------------------------
+// FNV-1a over the bytes of `value`
+uint64_t HashCombine(uint64_t hash, uint64_t value)
+{
+    for (uint32_t i = 0; i < sizeof(value); ++i)
+    {
+        hash ^= (value >> (i * 8)) & 0xff;
+        hash *= 0x100000001b3ull;
+    }
+    return hash;
+}
+
+constexpr uint64_t kHashSeed = 0xcbf29ce484222325ull;
+
+//--------------------------------------------------------------------------------------------------
+// Myers' diff of previous[a_begin, a_end) and frame[b_begin, b_end). Appends the pairs of indices
+// of a longest common subsequence to `matches`, in order. Returns false if it takes more than
+// kMaxEdits insertions and deletions
+bool AlignFingerprints(const std::vector<DrawFingerprint>         &previous,
+                       const std::vector<DrawFingerprint>         &frame,
+                       uint32_t                                    a_begin,
+                       uint32_t                                    a_end,
+                       uint32_t                                    b_begin,
+                       uint32_t                                    b_end,
+                       std::vector<std::pair<uint32_t, uint32_t>> &matches)
+{
+    int32_t n = static_cast<int32_t>(a_end - a_begin);
+    int32_t m = static_cast<int32_t>(b_end - b_begin);
+    int32_t max_edits = std::min(n + m, kMaxEdits);
+
+    // v[offset + k] is the furthest x reached on diagonal k = x - y, and trace[d] is v before the
+    // paths of d edits are extended
+    int32_t                           offset = max_edits + 1;
+    std::vector<int32_t>              v(2 * offset + 1, 0);
+    std::vector<std::vector<int32_t>> trace;
+    int32_t                           num_edits = -1;
+
+    // Whether the furthest path on diagonal k comes down from diagonal k + 1, rather than right
+    // from diagonal k - 1
+    const auto is_down = [offset](const std::vector<int32_t> &v, int32_t d, int32_t k) {
+        return k == -d || (k != d && v[offset + k - 1] < v[offset + k + 1]);
+    };
+    for (int32_t d = 0; d <= max_edits && num_edits < 0; ++d)
+    {
+        trace.push_back(v);
+        for (int32_t k = -d; k <= d; k += 2)
+        {
+            int32_t x = is_down(v, d, k) ? v[offset + k + 1] : v[offset + k - 1] + 1;
+            int32_t y = x - k;
+            while (x < n && y < m && previous[a_begin + x].m_hash == frame[b_begin + y].m_hash)
+            {
+                ++x;
+                ++y;
+            }
+            v[offset + k] = x;
+            if (x >= n && y >= m)
+            {
+                num_edits = d;
+                break;
+            }
+        }
+    }
+    if (num_edits < 0)
+        return false;
+
+    // Walk the edits back from the end, collecting the diagonal runs between them
+    std::vector<std::pair<uint32_t, uint32_t>> reversed;
+    int32_t                                    x = n;
+    int32_t                                    y = m;
+    for (int32_t d = num_edits; d >= 0; --d)
+    {
+        int32_t prev_x = 0;
+        int32_t prev_y = 0;
+        if (d > 0)
+        {
+            int32_t k = x - y;
+            int32_t prev_k = is_down(trace[d], d, k) ? k + 1 : k - 1;
+            prev_x = trace[d][offset + prev_k];
+            prev_y = prev_x - prev_k;
+        }
+        while (x > prev_x && y > prev_y)
+        {
+            --x;
+            --y;
+            reversed.emplace_back(a_begin + x, b_begin + y);
+        }
+        x = prev_x;
+        y = prev_y;
+    }
+    matches.insert(matches.end(), reversed.rbegin(), reversed.rend());
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+// Adds the draws previous[a_begin, a_end) and frame[b_begin, b_end) left between two aligned ones
+void AddUnalignedDraws(const std::vector<DrawFingerprint> &previous,
+                       const std::vector<DrawFingerprint> &frame,
+                       uint32_t                            a_begin,
+                       uint32_t                            a_end,
+                       uint32_t                            b_begin,
+                       uint32_t                            b_end,
+                       FrameDiff                          &diff)
+{
+    uint32_t num_pairs = std::min(a_end - a_begin, b_end - b_begin);
+    for (uint32_t i = 0; i < num_pairs; ++i)
+    {
+        const DrawFingerprint &before = previous[a_begin + i];
+        const DrawFingerprint &after = frame[b_begin + i];
+        if (before.m_hash == after.m_hash)
+            continue;
+        ++diff.m_num_changed;
+        uint32_t changed_components = 0;
+        for (uint32_t component = 0; component < kFingerprintComponentCount; ++component)
+        {
+            if (before.m_components[component] != after.m_components[component])
+            {
+                ++diff.m_changed_components[component];
+                changed_components |= 1u << component;
+            }
+        }
+        diff.m_differences.push_back(
+        { FrameDifference::Type::kChanged, b_begin + i, a_begin + i, changed_components });
+    }
+    for (uint32_t i = a_begin + num_pairs; i < a_end; ++i)
+    {
+        ++diff.m_num_deleted;
+        diff.m_differences.push_back({ FrameDifference::Type::kDeleted, i, i, 0 });
+    }
+    for (uint32_t i = b_begin + num_pairs; i < b_end; ++i)
+    {
+        ++diff.m_num_inserted;
+        diff.m_differences.push_back({ FrameDifference::Type::kInserted, i, i, 0 });
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+DrawFingerprint GetFingerprint(const CaptureMetadata &meta_data, uint32_t event_id)
+{
+    DrawFingerprint fingerprint;
+    for (uint32_t group = 0; group < EventStateGroups::kGroupCount; ++group)
+    {
+        auto group_type = static_cast<EventStateGroups::Group>(group);
+        fingerprint.m_components[group] = meta_data.m_state_groups.GetStateId(group_type,
+                                                                               event_id);
+    }
+
+    uint64_t shaders = kHashSeed;
+    for (const ShaderReference &reference : meta_data.m_event_info.GetShaderReferences(event_id))
+    {
+        shaders = HashCombine(shaders, reference.m_shader_index);
+        shaders = HashCombine(shaders, static_cast<uint64_t>(reference.m_stage));
+        shaders = HashCombine(shaders, reference.m_enable_mask);
+    }
+    fingerprint.m_components[EventStateGroups::kShaders] = shaders;
+
+    const EventInfo &info = meta_data.m_event_info[event_id];
+    uint64_t         arguments = HashCombine(kHashSeed, static_cast<uint64_t>(info.m_type));
+    arguments = HashCombine(arguments, info.m_num_indices);
+    arguments = HashCombine(arguments, info.m_num_instances);
+    fingerprint.m_components[kDrawArguments] = arguments;
+
+    fingerprint.UpdateHash();
+    return fingerprint;
+}
+
+}  // namespace
+
+//--------------------------------------------------------------------------------------------------
+const char *GetFingerprintComponentName(uint32_t component)
+{
+    DIVE_ASSERT(component < kFingerprintComponentCount);
+    if (component == kDrawArguments)
+        return "Draw arguments";
+    return EventStateGroups::GetGroupName(static_cast<EventStateGroups::Group>(component));
+}
+
+//--------------------------------------------------------------------------------------------------
+void DrawFingerprint::UpdateHash()
+{
+    m_hash = kHashSeed;
+    for (uint64_t component : m_components)
+        m_hash = HashCombine(m_hash, component);
+}
+
+//--------------------------------------------------------------------------------------------------
+FrameDiff DiffFrames(const std::vector<DrawFingerprint> &previous,
+                     const std::vector<DrawFingerprint> &frame)
+{
+    // Only the draws between the common prefix and suffix need aligning
+    uint32_t n = static_cast<uint32_t>(previous.size());
+    uint32_t m = static_cast<uint32_t>(frame.size());
+    uint32_t prefix = 0;
+    while (prefix < n && prefix < m && previous[prefix].m_hash == frame[prefix].m_hash)
+        ++prefix;
+    uint32_t suffix = 0;
+    while (suffix < n - prefix && suffix < m - prefix &&
+           previous[n - 1 - suffix].m_hash == frame[m - 1 - suffix].m_hash)
+    {
+        ++suffix;
+    }
+
+    FrameDiff                                  diff;
+    std::vector<std::pair<uint32_t, uint32_t>> matches;
+    diff.m_is_aligned = AlignFingerprints(previous,
+                                          frame,
+                                          prefix,
+                                          n - suffix,
+                                          prefix,
+                                          m - suffix,
+                                          matches);
+    matches.emplace_back(n - suffix, m - suffix);
+
+    uint32_t a_begin = prefix;
+    uint32_t b_begin = prefix;
+    for (const auto &[a, b] : matches)
+    {
+        AddUnalignedDraws(previous, frame, a_begin, a, b_begin, b, diff);
+        a_begin = a + 1;
+        b_begin = b + 1;
+    }
+    return diff;
+}
+
+// =================================================================================================
+// FrameStabilityReport
+// =================================================================================================
+FrameDiff FrameStabilityReport::GetTotals() const
+{
+    FrameDiff totals;
+    for (const FrameStability &frame : m_frames)
+    {
+        totals.m_num_inserted += frame.m_diff.m_num_inserted;
+        totals.m_num_deleted += frame.m_diff.m_num_deleted;
+        totals.m_num_changed += frame.m_diff.m_num_changed;
+        for (uint32_t component = 0; component < kFingerprintComponentCount; ++component)
+            totals.m_changed_components[component] += frame.m_diff.m_changed_components[component];
+        totals.m_is_aligned = totals.m_is_aligned && frame.m_diff.m_is_aligned;
+    }
+    return totals;
+}
+
+//--------------------------------------------------------------------------------------------------
+std::vector<uint32_t> GetFrameEndSubmits(const Pm4CaptureData &capture_data)
+{
+    std::vector<uint32_t> frame_end_submits;
+    for (uint32_t i = 0; i < capture_data.GetNumPresents(); ++i)
+    {
+        // A present before the first submit wraps to 0 and ends no frame
+        uint32_t end_submit = capture_data.GetPresentInfo(i).GetSubmitIndex() + 1;
+        if (end_submit == 0)
+            continue;
+        if (frame_end_submits.empty() || frame_end_submits.back() < end_submit)
+            frame_end_submits.push_back(end_submit);
+    }
+    if (capture_data.GetNumPresents() == 0)
+    {
+        for (uint32_t i = 0; i < capture_data.GetNumSubmits(); ++i)
+            frame_end_submits.push_back(i + 1);
+    }
+    return frame_end_submits;
+}
+
+//--------------------------------------------------------------------------------------------------
+void AnalyzeFrameStability(const CaptureMetadata       &meta_data,
+                           const std::vector<uint32_t> &frame_end_submits,
+                           uint32_t                     num_threads,
+                           FrameStabilityReport        &report)
+{
+    report = FrameStabilityReport();
+    const EventInfoTable &event_info = meta_data.m_event_info;
+    DIVE_ASSERT(meta_data.m_state_groups.GetNumEvents() == event_info.size());
+
+    // Events are in submit order, so each frame is a range of them
+    uint32_t event_id = 0;
+    uint32_t first_submit = 0;
+    for (uint32_t end_submit : frame_end_submits)
+    {
+        FrameStability frame;
+        frame.m_first_submit = first_submit;
+        frame.m_end_submit = end_submit;
+        for (; event_id < event_info.size() && event_info[event_id].m_submit_index < end_submit;
+             ++event_id)
+        {
+            EventInfo::EventType type = event_info[event_id].m_type;
+            if (type == EventInfo::EventType::kDraw || type == EventInfo::EventType::kDispatch)
+                frame.m_event_ids.push_back(event_id);
+        }
+        report.m_frames.push_back(std::move(frame));
+        first_submit = end_submit;
+    }
+    if (report.m_frames.empty())
+        return;
+
+    auto num_frames = static_cast<uint32_t>(report.m_frames.size());
+    std::vector<std::vector<DrawFingerprint>> fingerprints(num_frames);
+    ThreadPool                                thread_pool;
+    thread_pool.Start(std::min(num_threads > 0 ? num_threads : ThreadPool::GetDefaultThreadCount(),
+                               num_frames));
+    for (uint32_t i = 0; i < num_frames; ++i)
+    {
+        thread_pool.Run([&meta_data, &report, &fingerprints, i]() {
+            for (uint32_t id : report.m_frames[i].m_event_ids)
+                fingerprints[i].push_back(GetFingerprint(meta_data, id));
+        });
+    }
+    thread_pool.Wait();
+    for (uint32_t i = 1; i < num_frames; ++i)
+    {
+        thread_pool.Run([&report, &fingerprints, i]() {
+            report.m_frames[i].m_diff = DiffFrames(fingerprints[i - 1], fingerprints[i]);
+        });
+    }
+    thread_pool.Wait();
+
+    // Fingerprints missing from some frames, such as draws made only every other frame
+    struct FingerprintFrames
+    {
+        uint32_t m_first_event_id;
+        uint32_t m_last_frame;
+        uint32_t m_num_frames;
+    };
+    std::unordered_map<uint64_t, FingerprintFrames> fingerprint_frames;
+    for (uint32_t i = 0; i < num_frames; ++i)
+    {
+        for (size_t j = 0; j < fingerprints[i].size(); ++j)
+        {
+            FingerprintFrames first = { report.m_frames[i].m_event_ids[j], i, 0 };
+            auto [it, inserted] = fingerprint_frames.try_emplace(fingerprints[i][j].m_hash, first);
+            if (inserted || it->second.m_last_frame != i)
+            {
+                it->second.m_last_frame = i;
+                ++it->second.m_num_frames;
+            }
+        }
+    }
+    report.m_num_fingerprints = static_cast<uint32_t>(fingerprint_frames.size());
+    for (const auto &[hash, frames] : fingerprint_frames)
+    {
+        if (frames.m_num_frames < num_frames)
+        {
+            report.m_intermittent_fingerprints.push_back(
+            { hash, frames.m_first_event_id, frames.m_num_frames });
+        }
+    }
+    std::sort(report.m_intermittent_fingerprints.begin(),
+              report.m_intermittent_fingerprints.end(),
+              [](const IntermittentFingerprint &lhs, const IntermittentFingerprint &rhs) {
+                  return lhs.m_first_event_id < rhs.m_first_event_id;
+              });
+}
+
+}  // namespace Dive
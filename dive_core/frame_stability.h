@@ -0,0 +1,141 @@
+/*
+ Copyright 2025 Google LLC
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+
+// =====================================================================================================================
+// Frame-over-frame stability of a capture of several frames. The capture is split into frames at
+// its presents, and each draw and dispatch is fingerprinted by its shaders, its state groups and
+// its arguments. Each frame is aligned with the frame before it, and the draws that differ are
+// counted as inserted, deleted or changed, with what changed.
+// =====================================================================================================================
+
+#pragma once
+#include <array>
+#include <cstdint>
+#include <vector>
+#include "event_state_groups.h"
+
+namespace Dive
+{
+
+struct CaptureMetadata;
+class Pm4CaptureData;
+
+//--------------------------------------------------------------------------------------------------
+// The state groups of EventStateGroups, then the draw arguments. The kShaders component only
+// covers the shaders bound and not the buffers, which are often suballocated anew every frame
+enum FingerprintComponent : uint32_t
+{
+    kDrawArguments = EventStateGroups::kGroupCount,  // Type, indices and instances
+    kFingerprintComponentCount
+};
+
+const char *GetFingerprintComponentName(uint32_t component);
+
+//--------------------------------------------------------------------------------------------------
+struct DrawFingerprint
+{
+    std::array<uint64_t, kFingerprintComponentCount> m_components;  // State ids or hashes
+    uint64_t                                         m_hash;        // Of the components
+
+    // Sets m_hash from m_components
+    void UpdateHash();
+};
+
+//--------------------------------------------------------------------------------------------------
+// Draws of a frame that differ from the frame before it
+struct FrameDifference
+{
+    enum class Type : uint8_t
+    {
+        kInserted,
+        kDeleted,
+        kChanged,
+    };
+
+    Type     m_type;
+    uint32_t m_index;               // In the frame, or in the previous frame if deleted
+    uint32_t m_previous_index;      // In the previous frame, if changed
+    uint32_t m_changed_components;  // Bit per FingerprintComponent, if changed
+};
+
+//--------------------------------------------------------------------------------------------------
+struct FrameDiff
+{
+    uint32_t m_num_inserted = 0;
+    uint32_t m_num_deleted = 0;
+    uint32_t m_num_changed = 0;
+
+    // Changed draws whose fingerprint differs in each component
+    std::array<uint32_t, kFingerprintComponentCount> m_changed_components = {};
+
+    // False if the frames differ in too many draws to be aligned, in which case their draws are
+    // paired in order
+    bool m_is_aligned = true;
+
+    std::vector<FrameDifference> m_differences;
+
+    uint32_t GetNumDifferences() const { return m_num_inserted + m_num_deleted + m_num_changed; }
+};
+
+// Aligns `frame` with `previous` on their longest common run of fingerprints, then pairs the draws
+// left between two aligned ones in order as changed, the rest being inserted or deleted
+FrameDiff DiffFrames(const std::vector<DrawFingerprint> &previous,
+                     const std::vector<DrawFingerprint> &frame);
+
+//--------------------------------------------------------------------------------------------------
+struct FrameStability
+{
+    uint32_t              m_first_submit;
+    uint32_t              m_end_submit;
+    std::vector<uint32_t> m_event_ids;  // Of the draws and dispatches
+    FrameDiff             m_diff;       // From the previous frame, empty for the first one
+};
+
+//--------------------------------------------------------------------------------------------------
+// A fingerprint missing from some frames, such as a draw made only every other frame
+struct IntermittentFingerprint
+{
+    uint64_t m_hash;
+    uint32_t m_first_event_id;  // Of its first draw or dispatch
+    uint32_t m_num_frames;      // Holding it
+};
+
+//--------------------------------------------------------------------------------------------------
+struct FrameStabilityReport
+{
+    std::vector<FrameStability> m_frames;
+
+    // Distinct fingerprints over the capture, and those missing from some frames in event order
+    uint32_t                             m_num_fingerprints = 0;
+    std::vector<IntermittentFingerprint> m_intermittent_fingerprints;
+
+    // Sum of the differences of the frames
+    FrameDiff GetTotals() const;
+};
+
+// End submit of each frame: one per present, after the submit it follows. Submits after the last
+// present are not a whole frame, and are left out. Without presents, each submit is a frame
+std::vector<uint32_t> GetFrameEndSubmits(const Pm4CaptureData &capture_data);
+
+// Fingerprints the draws and dispatches of each frame and diffs the frames on `num_threads`
+// threads (0 for the default)
+void AnalyzeFrameStability(const CaptureMetadata       &meta_data,
+                           const std::vector<uint32_t> &frame_end_submits,
+                           uint32_t                     num_threads,
+                           FrameStabilityReport        &report);
+
+}  // namespace Dive
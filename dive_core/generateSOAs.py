@@ -84,6 +84,32 @@ EventmarkerInfo &events = marker_data.Events();
 auto it = events.Add();
 it->SetThreadY(7);
 ```
+
+# Chunked growth
+
+With the "chunked" option, `Add()` never re-allocates: the first 1024 elements are stored
+contiguously, and later elements in fixed-size chunks of 1024. Existing elements are never copied
+while adding, and no capacity has to be guessed up front with `Reserve()`. Per-element access works
+at any time, but the whole-array accessors (`MyFieldPtr()`, `MyFieldColumn()`) require contiguous
+storage, so call `Compact()` once all elements are added. E.g.
+```
+for (...) { auto it = events.Add(); ... }
+events.Compact();
+const uint32_t *thread_x = events.ThreadXPtr();
+```
+
+# Delta-encoded copies
+
+With the "delta" option (which requires "isSet"), a read-only companion class is also generated,
+e.g. `EventStateInfoDelta` for `EventStateInfo`. It stores each field as a run of changes plus
+periodic keyframes, so fields that rarely change between consecutive elements cost almost nothing.
+It has the same getters, plus `MyFieldChanges()` listing the ids at which a field changes. E.g.
+```
+EventStateInfoDelta delta;
+delta.Encode(state);
+uint32_t thread_x = delta.ThreadX(EventStateId(0));
+for (uint32_t id : delta.ThreadXChanges()) { ... }
+```
 '''
 
 
@@ -147,6 +173,8 @@ def generate(spec: Dict, gen_name: str) -> None:
     if 'options' in spec['header']:
         spec_options=spec['header']['options']
     env.globals['options'] = spec_options
+    if 'delta' in spec_options and 'isSet' not in spec_options:
+        raise (Exception('The "delta" option requires the "isSet" option'))
 
     gen_file('{{macros.soa_h(soas, includes, namespace, gen_name)}}',
              spec['header']['path'],
@@ -164,14 +192,16 @@ def generate(spec: Dict, gen_name: str) -> None:
         namespace=spec['namespace'],
         gen_name=gen_name)
 
-    gen_file(
-        '{{macros.soa_py_cpp(soas, py_bind_func, includes, namespace, gen_name)}}',
-        spec['py_wrapper']['path'],
-        soas=spec['soa_types'],
-        includes=spec['py_wrapper']['includes'],
-        py_bind_func=spec['py_wrapper']['func'],
-        namespace=spec['namespace'],
-        gen_name=gen_name)
+    # Python bindings are optional
+    if 'py_wrapper' in spec:
+        gen_file(
+            '{{macros.soa_py_cpp(soas, py_bind_func, includes, namespace, gen_name)}}',
+            spec['py_wrapper']['path'],
+            soas=spec['soa_types'],
+            includes=spec['py_wrapper']['includes'],
+            py_bind_func=spec['py_wrapper']['func'],
+            namespace=spec['namespace'],
+            gen_name=gen_name)
 
     gen_file('{{macros.natvis(soas, gen_name)}}',
              spec['natvis']['path'],
@@ -420,5 +420,7 @@ void GfxrVulkanCommandHierarchyCreator::CreateTopologies()
         cur_topology.AddChildren(node_index,
                                  m_node_children[CommandHierarchy::kAllEventTopology][node_index]);
     }
+
+    m_command_hierarchy.BuildFilteredTopologies();
 }
 }  // namespace Dive
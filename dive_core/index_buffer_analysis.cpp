@@ -0,0 +1,293 @@
+/*
+ Copyright 2025 Google LLC
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+
+#include "index_buffer_analysis.h"
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <unordered_map>
+#include "adreno.h"
+#include "dive_core/common/common.h"
+#include "dive_core/common/memory_manager_base.h"
+#include "thread_pool.h"
+
+namespace Dive
+{
+
+namespace
+{
+
+// Reading and hashing a draw's indices is cheap next to analyzing them, so fewer ranges make a task
+constexpr size_t kDrawsPerTask = 256;
+constexpr size_t kRangesPerTask = 16;
+
+//--------------------------------------------------------------------------------------------------
+template<typename T>
+void WidenIndices(const void *indices, uint32_t num_indices, std::vector<uint32_t> &widened)
+{
+    const uint8_t *bytes = static_cast<const uint8_t *>(indices);
+    widened.resize(num_indices);
+    for (uint32_t i = 0; i < num_indices; ++i)
+    {
+        T index;
+        memcpy(&index, bytes + size_t(i) * sizeof(T), sizeof(T));
+        widened[i] = index;
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+// Counts the triangles of the indices [begin, end), which hold no restart index
+void CountTriangles(const std::vector<uint32_t> &indices,
+                    uint32_t                     begin,
+                    uint32_t                     end,
+                    IndexTopology                topology,
+                    IndexBufferStats            &stats)
+{
+    const auto add_triangle = [&stats](uint32_t a, uint32_t b, uint32_t c) {
+        ++stats.m_num_triangles;
+        if (a == b || b == c || a == c)
+            ++stats.m_num_degenerate_triangles;
+    };
+    switch (topology)
+    {
+    case IndexTopology::kTriangleList:
+        for (uint32_t i = begin; i + 3 <= end; i += 3)
+            add_triangle(indices[i], indices[i + 1], indices[i + 2]);
+        break;
+    case IndexTopology::kTriangleStrip:
+        for (uint32_t i = begin; i + 3 <= end; ++i)
+            add_triangle(indices[i], indices[i + 1], indices[i + 2]);
+        break;
+    case IndexTopology::kTriangleFan:
+        for (uint32_t i = begin + 1; i + 2 <= end; ++i)
+            add_triangle(indices[begin], indices[i], indices[i + 1]);
+        break;
+    case IndexTopology::kOther:
+        break;
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+// FNV-1a, seeded with how the bytes are drawn so that the same bytes drawn differently differ
+uint64_t HashIndices(const std::vector<uint8_t> &bytes, uint32_t index_size, IndexTopology topology)
+{
+    uint64_t hash = 0xcbf29ce484222325ull;
+    const auto add_byte = [&hash](uint8_t byte) {
+        hash ^= byte;
+        hash *= 0x100000001b3ull;
+    };
+    add_byte(static_cast<uint8_t>(index_size));
+    add_byte(static_cast<uint8_t>(topology));
+    for (uint8_t byte : bytes)
+        add_byte(byte);
+    return hash;
+}
+
+//--------------------------------------------------------------------------------------------------
+bool ReadIndices(const IMemoryManager  &mem_manager,
+                 const IndexedDrawInfo &draw,
+                 std::vector<uint8_t>  &bytes)
+{
+    bytes.resize(size_t(draw.m_num_indices) * draw.m_index_size);
+    return bytes.empty() || mem_manager.RetrieveMemoryData(bytes.data(),
+                                                           draw.m_submit_index,
+                                                           draw.m_va_addr,
+                                                           bytes.size());
+}
+
+//--------------------------------------------------------------------------------------------------
+// Calls `func` on [begin, end) ranges of `num_items` items, from `num_threads` threads
+void ParallelFor(size_t                                    num_items,
+                 size_t                                    items_per_task,
+                 uint32_t                                  num_threads,
+                 const std::function<void(size_t, size_t)> &func)
+{
+    size_t num_tasks = (num_items + items_per_task - 1) / items_per_task;
+    if (num_tasks <= 1)
+    {
+        func(0, num_items);
+        return;
+    }
+    if (num_threads == 0)
+        num_threads = ThreadPool::GetDefaultThreadCount();
+
+    ThreadPool thread_pool;
+    thread_pool.Start(static_cast<unsigned int>(std::min<size_t>(num_threads, num_tasks)));
+    for (size_t begin = 0; begin < num_items; begin += items_per_task)
+    {
+        size_t end = std::min(begin + items_per_task, num_items);
+        thread_pool.Run([&func, begin, end]() { func(begin, end); });
+    }
+    thread_pool.Wait();
+}
+
+}  // namespace
+
+//--------------------------------------------------------------------------------------------------
+IndexTopology GetIndexTopology(uint32_t prim_type)
+{
+    switch (prim_type)
+    {
+    case DI_PT_TRILIST:
+        return IndexTopology::kTriangleList;
+    case DI_PT_TRISTRIP:
+        return IndexTopology::kTriangleStrip;
+    case DI_PT_TRIFAN:
+        return IndexTopology::kTriangleFan;
+    default:
+        return IndexTopology::kOther;
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+IndexBufferStats AnalyzeIndices(const void   *indices,
+                                uint32_t      num_indices,
+                                uint32_t      index_size,
+                                IndexTopology topology,
+                                uint32_t      cache_size)
+{
+    std::vector<uint32_t> widened;
+    switch (index_size)
+    {
+    case 1:
+        WidenIndices<uint8_t>(indices, num_indices, widened);
+        break;
+    case 2:
+        WidenIndices<uint16_t>(indices, num_indices, widened);
+        break;
+    case 4:
+        WidenIndices<uint32_t>(indices, num_indices, widened);
+        break;
+    default:
+        DIVE_ASSERT(false);
+        return IndexBufferStats();
+    }
+    uint32_t restart_index = (index_size == 4) ? UINT32_MAX : (1u << (index_size * 8)) - 1;
+    bool     has_restart = (topology == IndexTopology::kTriangleStrip ||
+                            topology == IndexTopology::kTriangleFan);
+
+    IndexBufferStats stats;
+    stats.m_num_indices = num_indices;
+
+    // The cache holds the last `cache_size` vertices shaded, so a vertex is a hit if fewer misses
+    // than that happened since it was shaded
+    std::unordered_map<uint32_t, uint64_t> shaded_at_miss;
+    shaded_at_miss.reserve(num_indices);
+    uint32_t run_begin = 0;
+    for (uint32_t i = 0; i < num_indices; ++i)
+    {
+        uint32_t index = widened[i];
+        if (has_restart && index == restart_index)
+        {
+            CountTriangles(widened, run_begin, i, topology, stats);
+            run_begin = i + 1;
+            continue;
+        }
+        auto [it, inserted] = shaded_at_miss.try_emplace(index, stats.m_num_cache_misses);
+        if (inserted || stats.m_num_cache_misses - it->second > cache_size)
+        {
+            it->second = stats.m_num_cache_misses;
+            ++stats.m_num_cache_misses;
+        }
+    }
+    CountTriangles(widened, run_begin, num_indices, topology, stats);
+    stats.m_num_unique_vertices = shaded_at_miss.size();
+    return stats;
+}
+
+// =================================================================================================
+// IndexBufferReport
+// =================================================================================================
+IndexBufferStats IndexBufferReport::GetTotals() const
+{
+    IndexBufferStats totals;
+    for (const Draw &draw : m_draws)
+        totals.Add(m_ranges[draw.m_range_index]);
+    return totals;
+}
+
+//--------------------------------------------------------------------------------------------------
+void AnalyzeIndexBuffers(const std::vector<IndexedDrawInfo> &draws,
+                         const IMemoryManager               &mem_manager,
+                         uint32_t                            cache_size,
+                         uint32_t                            num_threads,
+                         IndexBufferReport                  &report)
+{
+    report = IndexBufferReport();
+    report.m_cache_size = cache_size;
+
+    // Hash the indices of every draw
+    struct DrawHash
+    {
+        uint64_t m_hash;
+        bool     m_is_readable;
+    };
+    std::vector<DrawHash> draw_hashes(draws.size());
+    ParallelFor(draws.size(),
+                kDrawsPerTask,
+                num_threads,
+                [&draws, &mem_manager, &draw_hashes](size_t begin, size_t end) {
+                    std::vector<uint8_t> bytes;
+                    for (size_t i = begin; i < end; ++i)
+                    {
+                        const IndexedDrawInfo &draw = draws[i];
+                        bool is_readable = ReadIndices(mem_manager, draw, bytes);
+                        draw_hashes[i] = { is_readable ?
+                                           HashIndices(bytes, draw.m_index_size, draw.m_topology) :
+                                           0,
+                                           is_readable };
+                    }
+                });
+
+    // Give each distinct hash a range, analyzed from the first draw with it
+    std::unordered_map<uint64_t, uint32_t> range_of_hash;
+    std::vector<size_t>                    range_draws;
+    for (size_t i = 0; i < draws.size(); ++i)
+    {
+        if (!draw_hashes[i].m_is_readable)
+        {
+            report.m_unreadable_draws.push_back(draws[i].m_event_id);
+            continue;
+        }
+        uint32_t num_ranges = static_cast<uint32_t>(range_draws.size());
+        auto [it, inserted] = range_of_hash.try_emplace(draw_hashes[i].m_hash, num_ranges);
+        if (inserted)
+            range_draws.push_back(i);
+        report.m_draws.push_back({ draws[i].m_event_id, draws[i].m_submit_index, it->second });
+    }
+
+    report.m_ranges.resize(range_draws.size());
+    ParallelFor(range_draws.size(),
+                kRangesPerTask,
+                num_threads,
+                [&draws, &mem_manager, &range_draws, &report, cache_size](size_t begin,
+                                                                           size_t end) {
+                    std::vector<uint8_t> bytes;
+                    for (size_t i = begin; i < end; ++i)
+                    {
+                        const IndexedDrawInfo &draw = draws[range_draws[i]];
+                        DIVE_VERIFY(ReadIndices(mem_manager, draw, bytes));
+                        report.m_ranges[i] = AnalyzeIndices(bytes.data(),
+                                                            draw.m_num_indices,
+                                                            draw.m_index_size,
+                                                            draw.m_topology,
+                                                            cache_size);
+                    }
+                });
+}
+
+}  // namespace Dive
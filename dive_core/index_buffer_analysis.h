@@ -0,0 +1,137 @@
+/*
+ Copyright 2025 Google LLC
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+
+// =====================================================================================================================
+// Vertex reuse of the indexed draws of a capture, from the indices they read: the number of unique
+// vertices, the vertices shaded under a FIFO model of the post-transform vertex cache (ACMR and
+// ATVR), and the degenerate triangles. Draws reading the same indices are analyzed once.
+// =====================================================================================================================
+
+#pragma once
+#include <cstdint>
+#include <vector>
+
+namespace Dive
+{
+
+class IMemoryManager;
+
+//--------------------------------------------------------------------------------------------------
+enum class IndexTopology : uint8_t
+{
+    kTriangleList,
+    kTriangleStrip,
+    kTriangleFan,
+    kOther,  // Points and lines, which only count vertices
+};
+
+// Topology of a pc_di_primtype
+IndexTopology GetIndexTopology(uint32_t prim_type);
+
+//--------------------------------------------------------------------------------------------------
+// Indices read by an indexed draw (CP_DRAW_INDX_OFFSET sourcing them from memory)
+struct IndexedDrawInfo
+{
+    uint32_t      m_event_id;
+    uint32_t      m_submit_index;
+    uint64_t      m_va_addr;  // Of the first index drawn
+    uint32_t      m_num_indices;
+    uint32_t      m_index_size;  // In bytes: 1, 2 or 4
+    IndexTopology m_topology;
+};
+
+//--------------------------------------------------------------------------------------------------
+struct IndexBufferStats
+{
+    uint64_t m_num_indices = 0;
+    uint64_t m_num_unique_vertices = 0;
+    uint64_t m_num_triangles = 0;
+    uint64_t m_num_degenerate_triangles = 0;  // With 2 indices the same
+    uint64_t m_num_cache_misses = 0;          // Vertices shaded
+
+    void Add(const IndexBufferStats &other)
+    {
+        m_num_indices += other.m_num_indices;
+        m_num_unique_vertices += other.m_num_unique_vertices;
+        m_num_triangles += other.m_num_triangles;
+        m_num_degenerate_triangles += other.m_num_degenerate_triangles;
+        m_num_cache_misses += other.m_num_cache_misses;
+    }
+
+    // Average cache miss ratio: vertices shaded per triangle, 3 at worst
+    double GetAcmr() const
+    {
+        return m_num_triangles == 0 ? 0.0 :
+                                      static_cast<double>(m_num_cache_misses) /
+                                      static_cast<double>(m_num_triangles);
+    }
+
+    // Average transformed vertex ratio: vertices shaded per unique vertex, 1 at best
+    double GetAtvr() const
+    {
+        return m_num_unique_vertices == 0 ? 0.0 :
+                                            static_cast<double>(m_num_cache_misses) /
+                                            static_cast<double>(m_num_unique_vertices);
+    }
+};
+
+// Entries of the FIFO vertex cache modelled by default. The size of the Adreno post-transform
+// cache is not documented, and it depends on the outputs of the vertex shader
+constexpr uint32_t kDefaultVertexCacheSize = 32;
+
+// Analyzes `num_indices` indices of `index_size` bytes. In strips and fans, an index with all bits
+// set restarts the primitive and is neither shaded nor counted as a vertex
+IndexBufferStats AnalyzeIndices(const void   *indices,
+                                uint32_t      num_indices,
+                                uint32_t      index_size,
+                                IndexTopology topology,
+                                uint32_t      cache_size = kDefaultVertexCacheSize);
+
+//--------------------------------------------------------------------------------------------------
+struct IndexBufferReport
+{
+    struct Draw
+    {
+        uint32_t m_event_id;
+        uint32_t m_submit_index;
+        uint32_t m_range_index;  // In m_ranges
+    };
+
+    uint32_t m_cache_size = 0;
+
+    // Stats of each distinct run of indices, by contents, index size and topology
+    std::vector<IndexBufferStats> m_ranges;
+
+    // Draws whose indices were read, in the order given
+    std::vector<Draw> m_draws;
+
+    // Event ids of the draws whose indices are not in the capture
+    std::vector<uint32_t> m_unreadable_draws;
+
+    // Sum over the draws, so that indices drawn twice count twice
+    IndexBufferStats GetTotals() const;
+};
+
+// Reads the indices of each draw from `mem_manager` and analyzes each distinct run of them once.
+// Reading and analyzing are both spread over `num_threads` threads (0 for the default)
+void AnalyzeIndexBuffers(const std::vector<IndexedDrawInfo> &draws,
+                         const IMemoryManager               &mem_manager,
+                         uint32_t                            cache_size,
+                         uint32_t                            num_threads,
+                         IndexBufferReport                  &report);
+
+}  // namespace Dive
@@ -16,6 +16,7 @@
 
 #include "log.h"
 #include <stdarg.h>
+#include <algorithm>
 #include <iostream>
 #include "common.h"
 #if defined(WIN32)
@@ -117,6 +118,104 @@ void DeferredLog::LogEntriesTo(LogAssociation association, uint32_t id, ILog& ot
     }
 }
 
+// =================================================================================================
+// LogArena
+// =================================================================================================
+void LogArena::Reset()
+{
+    *this = LogArena();
+}
+
+//--------------------------------------------------------------------------------------------------
+void LogArena::Log(const LogEntry& entry)
+{
+    uint32_t message_id = InternMessage(entry);
+    Record   record;
+    record.m_message_id = message_id;
+    record.m_ref = (entry.m_ref.Type() == CrossRefType::kNone) ? m_default_ref : entry.m_ref;
+    m_message_records[message_id].push_back(static_cast<uint32_t>(m_records.size()));
+    m_records.push_back(record);
+}
+
+//--------------------------------------------------------------------------------------------------
+uint32_t LogArena::InternMessage(const LogEntry& entry)
+{
+    const char* file = (entry.m_file != nullptr) ? entry.m_file : "";
+
+    std::string key;
+    key.reserve(32 + entry.m_short_desc.size() + entry.m_long_desc.size());
+    key += std::to_string(static_cast<int>(entry.m_type)) + ',' +
+           std::to_string(static_cast<int>(entry.m_cat)) + ',' +
+           std::to_string(static_cast<int>(entry.m_code)) + ',' + std::to_string(entry.m_line) +
+           ',';
+    key.append(file).push_back('\0');
+    key.append(entry.m_short_desc).push_back('\0');
+    key.append(entry.m_long_desc);
+
+    auto [it, inserted] = m_message_ids.try_emplace(std::move(key),
+                                                    static_cast<uint32_t>(m_messages.size()));
+    if (inserted)
+    {
+        Message message;
+        message.m_type = entry.m_type;
+        message.m_cat = entry.m_cat;
+        message.m_code = entry.m_code;
+        message.m_file = file;
+        message.m_line = entry.m_line;
+        message.m_short_desc = entry.m_short_desc;
+        message.m_long_desc = entry.m_long_desc;
+        m_messages.push_back(std::move(message));
+        m_message_records.emplace_back();
+    }
+    return it->second;
+}
+
+//--------------------------------------------------------------------------------------------------
+ILog::LogEntry LogArena::GetEntry(uint32_t record_index) const
+{
+    const Record&  record = m_records[record_index];
+    const Message& message = m_messages[record.m_message_id];
+    LogEntry       entry;
+    entry.m_type = message.m_type;
+    entry.m_cat = message.m_cat;
+    entry.m_code = message.m_code;
+    entry.m_ref = record.m_ref;
+    entry.m_file = message.m_file;
+    entry.m_line = message.m_line;
+    entry.m_short_desc = message.m_short_desc;
+    entry.m_long_desc = message.m_long_desc;
+    return entry;
+}
+
+//--------------------------------------------------------------------------------------------------
+std::vector<uint32_t> LogArena::FindProblems(LogType min_type) const
+{
+    std::vector<uint32_t> records;
+    for (uint32_t message_id = 0; message_id < m_messages.size(); ++message_id)
+    {
+        if (static_cast<int>(m_messages[message_id].m_type) >= static_cast<int>(min_type))
+        {
+            const std::vector<uint32_t>& message_records = m_message_records[message_id];
+            records.insert(records.end(), message_records.begin(), message_records.end());
+        }
+    }
+    std::sort(records.begin(), records.end());
+    return records;
+}
+
+//--------------------------------------------------------------------------------------------------
+size_t LogArena::GetMemoryUsage() const
+{
+    size_t size = m_messages.capacity() * sizeof(Message) + m_records.capacity() * sizeof(Record);
+    for (uint32_t message_id = 0; message_id < m_messages.size(); ++message_id)
+    {
+        size += m_messages[message_id].m_short_desc.capacity() +
+                m_messages[message_id].m_long_desc.capacity();
+        size += m_message_records[message_id].capacity() * sizeof(uint32_t);
+    }
+    return size;
+}
+
 // =================================================================================================
 // LogCompound
 // =================================================================================================
@@ -18,6 +18,7 @@
 #include <ostream>
 #include <sstream>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "cross_ref.h"
@@ -112,6 +113,62 @@ public:
     void LogEntriesTo(LogAssociation association, uint32_t id, ILog& other) const;
 };
 
+//--------------------------------------------------------------------------------------------------
+// Capture-wide log storage. Each distinct message is stored once, and each logged entry is a small
+// record referencing its message, so the same warning logged for many events is pooled
+class LogArena : public ILog
+{
+public:
+    struct Message
+    {
+        LogType     m_type;
+        LogCategory m_cat;
+        LogCode     m_code;
+        const char* m_file;
+        int         m_line;
+        std::string m_short_desc;
+        std::string m_long_desc;
+    };
+
+    struct Record
+    {
+        uint32_t m_message_id;
+        CrossRef m_ref;
+    };
+
+    virtual void Reset() override;
+    virtual void Log(const LogEntry& entry) override;
+
+    // Records logged without an association (CrossRefType::kNone) get this reference instead,
+    // e.g. the event being parsed
+    void SetDefaultRef(CrossRef ref) { m_default_ref = ref; }
+
+    uint32_t       GetNumMessages() const { return static_cast<uint32_t>(m_messages.size()); }
+    const Message& GetLogMessage(uint32_t message_id) const { return m_messages[message_id]; }
+    uint32_t       GetNumRecords() const { return static_cast<uint32_t>(m_records.size()); }
+    const Record&  GetRecord(uint32_t record_index) const { return m_records[record_index]; }
+
+    // Entry of the record, for ILog consumers
+    LogEntry GetEntry(uint32_t record_index) const;
+
+    // Indices of the records whose message type is at least `min_type`, in logging order. Only the
+    // records of matching messages are visited
+    std::vector<uint32_t> FindProblems(LogType min_type = LogType::kWarning) const;
+
+    // Bytes used by the arena
+    size_t GetMemoryUsage() const;
+
+private:
+    // Returns the id of the entry's message, adding it if it has not been seen before
+    uint32_t InternMessage(const LogEntry& entry);
+
+    std::vector<Message>                      m_messages;
+    std::unordered_map<std::string, uint32_t> m_message_ids;
+    std::vector<std::vector<uint32_t>>        m_message_records;
+    std::vector<Record>                       m_records;
+    CrossRef                                  m_default_ref;
+};
+
 //--------------------------------------------------------------------------------------------------
 // A log that outputs to multiple logging streams
 class LogCompound : public ILog
@@ -584,6 +584,13 @@ PresentInfo::PresentInfo()
     m_valid_data = false;
 }
 
+//--------------------------------------------------------------------------------------------------
+PresentInfo::PresentInfo(uint32_t submit_index)
+{
+    m_valid_data = false;
+    m_submit_index = submit_index;
+}
+
 //--------------------------------------------------------------------------------------------------
 PresentInfo::PresentInfo(EngineType engine_type,
                          QueueType  queue_type,
@@ -1345,7 +1352,7 @@ bool Pm4CaptureData::LoadPresentBlock(std::istream &capture_file)
     }
     else
     {
-        m_presents.push_back(PresentInfo());
+        m_presents.push_back(PresentInfo(submit_index));
     }
     return true;
 }
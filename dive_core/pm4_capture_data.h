@@ -176,6 +176,8 @@ class PresentInfo
 {
 public:
     PresentInfo();
+    // A present without valid surface data, which still ends a frame after `submit_index`
+    explicit PresentInfo(uint32_t submit_index);
     PresentInfo(EngineType engine_type,
                 QueueType  queue_type,
                 uint32_t   submit_index,
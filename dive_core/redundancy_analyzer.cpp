@@ -0,0 +1,447 @@
+/*
+ Copyright 2025 Google LLC
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#include "redundancy_analyzer.h"
+#include "dive_core/common/common.h"
+#include "dive_core/common/memory_manager_base.h"
+#include "pm4_info.h"
+
+namespace Dive
+{
+
+namespace
+{
+
+constexpr uint32_t kDrawStateElementDwords = sizeof(PM4_CP_SET_DRAW_STATE::ARRAY_ELEMENT) /
+                                             sizeof(uint32_t);
+
+//--------------------------------------------------------------------------------------------------
+// FNV-1a
+uint64_t HashDwords(const std::vector<uint32_t> &dwords)
+{
+    uint64_t hash = 0xcbf29ce484222325ull;
+    for (uint32_t dword : dwords)
+    {
+        hash ^= dword;
+        hash *= 0x100000001b3ull;
+    }
+    return hash;
+}
+
+//--------------------------------------------------------------------------------------------------
+// Packets doing work that a wait for idle or for the ME waits for
+bool IsWaitedForOpcode(uint32_t opcode)
+{
+    return IsDrawDispatchEventOpcode(opcode) || opcode == CP_EVENT_WRITE7 || opcode == CP_BLIT ||
+           opcode == CP_MEM_WRITE || opcode == CP_REG_TO_MEM || opcode == CP_MEM_TO_MEM;
+}
+
+}  // namespace
+
+//--------------------------------------------------------------------------------------------------
+SubmitRedundancy RedundancyReport::GetTotals() const
+{
+    SubmitRedundancy totals;
+    for (const SubmitRedundancy &submit : m_submits)
+    {
+        totals.m_num_dwords += submit.m_num_dwords;
+        totals.m_reg_writes.Add(submit.m_reg_writes);
+        totals.m_draw_state_groups.Add(submit.m_draw_state_groups);
+        totals.m_waits.Add(submit.m_waits);
+        totals.m_draws.Add(submit.m_draws);
+        totals.m_bins.Add(submit.m_bins);
+    }
+    return totals;
+}
+
+// =================================================================================================
+// RedundancyAnalyzer
+// =================================================================================================
+RedundancyAnalyzer::RedundancyAnalyzer(RedundancyReport &report) :
+    m_report(report)
+{
+}
+
+//--------------------------------------------------------------------------------------------------
+void RedundancyAnalyzer::OnSubmitStart(uint32_t submit_index, const SubmitInfo &submit_info)
+{
+    m_state_tracker.Reset();
+    m_submit = SubmitRedundancy();
+    m_submit.m_submit_index = submit_index;
+    m_draw_states = {};
+
+    // Work from previous submits may still be running
+    m_work_since_wait_for_idle = true;
+    m_work_since_wait_for_me = true;
+    m_in_bin = false;
+    m_bin_started_by_prefix = false;
+    m_ib_types.clear();
+    m_draw_state_ib_depth = 0;
+}
+
+//--------------------------------------------------------------------------------------------------
+void RedundancyAnalyzer::OnSubmitEnd(uint32_t submit_index, const SubmitInfo &submit_info)
+{
+    EndBin();
+    m_report.m_submits.push_back(m_submit);
+}
+
+//--------------------------------------------------------------------------------------------------
+bool RedundancyAnalyzer::OnIbStart(uint32_t                  submit_index,
+                                   uint32_t                  ib_index,
+                                   const IndirectBufferInfo &ib_info,
+                                   IbType                    type)
+{
+    EmulateCallbacksBase::OnIbStart(submit_index, ib_index, ib_info, type);
+    m_ib_types.push_back(type);
+    m_draw_state_ib_depth += (type == IbType::kDrawState) ? 1 : 0;
+
+    // Each bin of a CP_START_BIN starts with its own prefix IB
+    if (type == IbType::kBinPrefix)
+    {
+        EndBin();
+        BeginBin();
+        m_bin_started_by_prefix = true;
+    }
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+bool RedundancyAnalyzer::OnIbEnd(uint32_t                  submit_index,
+                                 uint32_t                  ib_index,
+                                 const IndirectBufferInfo &ib_info)
+{
+    if (!m_ib_types.empty())
+    {
+        m_draw_state_ib_depth -= (m_ib_types.back() == IbType::kDrawState) ? 1 : 0;
+        m_ib_types.pop_back();
+    }
+    return EmulateCallbacksBase::OnIbEnd(submit_index, ib_index, ib_info);
+}
+
+//--------------------------------------------------------------------------------------------------
+bool RedundancyAnalyzer::OnPacket(const IMemoryManager &mem_manager,
+                                  uint32_t              submit_index,
+                                  uint32_t              ib_index,
+                                  uint64_t              va_addr,
+                                  Pm4Header             header)
+{
+    if (m_draw_state_ib_depth > 0)
+        return EmulateCallbacksBase::OnPacket(mem_manager, submit_index, ib_index, va_addr, header);
+
+    uint32_t num_dwords = GetPacketSize(header);
+    m_submit.m_num_dwords += num_dwords;
+    m_bin_dwords += m_in_bin ? num_dwords : 0;
+
+    // Register writes are checked before the state tracker applies them
+    if (header.type == 4)
+        CheckType4Packet(mem_manager, submit_index, va_addr, header);
+    else if (header.type == 7)
+    {
+        uint32_t opcode = header.type7.opcode;
+        if (opcode == CP_CONTEXT_REG_BUNCH)
+            CheckRegBunch(mem_manager, submit_index, va_addr, header);
+        else if (opcode == CP_SET_DRAW_STATE)
+            CheckDrawState(mem_manager, submit_index, va_addr, header);
+        else if (opcode == CP_WAIT_FOR_IDLE || opcode == CP_WAIT_FOR_ME)
+            CheckWait(header);
+        else if (opcode == CP_SET_MARKER)
+            CheckMarker(mem_manager, submit_index, va_addr);
+        else if (IsDrawEventOpcode(opcode))
+            CheckDraw(mem_manager, submit_index, va_addr, header);
+
+        if (IsWaitedForOpcode(opcode))
+        {
+            m_work_since_wait_for_idle = true;
+            m_work_since_wait_for_me = true;
+        }
+    }
+
+    return EmulateCallbacksBase::OnPacket(mem_manager, submit_index, ib_index, va_addr, header);
+}
+
+//--------------------------------------------------------------------------------------------------
+bool RedundancyAnalyzer::CheckRegWrite(uint32_t offset, uint32_t value, uint32_t num_dwords)
+{
+    bool is_redundant = m_state_tracker.IsRegSetTo(offset, value);
+
+    // Applied right away so that a register written twice by the same packet is caught too
+    m_state_tracker.SetReg(offset, value);
+
+    RedundancyCount &reg_count = m_report.m_registers[offset];
+    reg_count.m_total++;
+    m_submit.m_reg_writes.m_total++;
+    if (is_redundant)
+    {
+        reg_count.m_redundant++;
+        reg_count.m_redundant_dwords += num_dwords;
+        m_submit.m_reg_writes.m_redundant++;
+    }
+    return is_redundant;
+}
+
+//--------------------------------------------------------------------------------------------------
+void RedundancyAnalyzer::CheckType4Packet(const IMemoryManager &mem_manager,
+                                          uint32_t              submit_index,
+                                          uint64_t              va_addr,
+                                          Pm4Header             header)
+{
+    // Consecutive registers from the packet's offset, one dword each
+    uint32_t              count = header.type4.count;
+    std::vector<uint32_t> values(count);
+    DIVE_VERIFY(mem_manager.RetrieveMemoryData(values.data(),
+                                               submit_index,
+                                               va_addr + sizeof(header),
+                                               count * sizeof(uint32_t)));
+    uint32_t num_redundant = 0;
+    for (uint32_t i = 0; i < count; ++i)
+        num_redundant += CheckRegWrite(header.type4.offset + i, values[i], 1) ? 1 : 0;
+
+    // Dropping only some of the writes may split the packet, which is not accounted for
+    uint32_t num_dwords = count + 1;
+    uint32_t redundant_dwords = (num_redundant == count) ? num_dwords : num_redundant;
+    m_submit.m_reg_writes.m_redundant_dwords += redundant_dwords;
+    AddPacket(RedundancyReport::kType4Packet, num_dwords, redundant_dwords);
+}
+
+//--------------------------------------------------------------------------------------------------
+void RedundancyAnalyzer::CheckRegBunch(const IMemoryManager &mem_manager,
+                                       uint32_t              submit_index,
+                                       uint64_t              va_addr,
+                                       Pm4Header             header)
+{
+    // Pairs of register offset and value
+    uint32_t              count = header.type7.count;
+    std::vector<uint32_t> dwords(count);
+    DIVE_VERIFY(mem_manager.RetrieveMemoryData(dwords.data(),
+                                               submit_index,
+                                               va_addr + sizeof(header),
+                                               count * sizeof(uint32_t)));
+    uint32_t num_pairs = count / 2;
+    uint32_t num_redundant = 0;
+    for (uint32_t i = 0; i < num_pairs; ++i)
+        num_redundant += CheckRegWrite(dwords[2 * i], dwords[2 * i + 1], 2) ? 1 : 0;
+
+    uint32_t num_dwords = count + 1;
+    uint32_t redundant_dwords = (num_pairs > 0 && num_redundant == num_pairs) ? num_dwords :
+                                                                                 2 * num_redundant;
+    m_submit.m_reg_writes.m_redundant_dwords += redundant_dwords;
+    AddPacket(CP_CONTEXT_REG_BUNCH, num_dwords, redundant_dwords);
+}
+
+//--------------------------------------------------------------------------------------------------
+void RedundancyAnalyzer::CheckDrawState(const IMemoryManager &mem_manager,
+                                        uint32_t              submit_index,
+                                        uint64_t              va_addr,
+                                        Pm4Header             header)
+{
+    PM4_CP_SET_DRAW_STATE packet;
+    DIVE_VERIFY(mem_manager.RetrieveMemoryData(&packet,
+                                               submit_index,
+                                               va_addr,
+                                               (header.type7.count + 1) * sizeof(uint32_t)));
+    uint32_t array_size = header.type7.count / kDrawStateElementDwords;
+
+    // An entry is redundant if it binds a group to the contents and passes it already has, or
+    // disables groups that are not bound
+    uint32_t num_redundant = 0;
+    for (uint32_t i = 0; i < array_size; i++)
+    {
+        const auto &element = packet.ARRAY[i];
+        bool        is_redundant = false;
+        if (element.bitfields0.DISABLE_ALL_GROUPS)
+        {
+            is_redundant = true;
+            for (DrawStateBinding &binding : m_draw_states)
+            {
+                is_redundant &= !binding.m_is_bound;
+                binding.m_is_bound = false;
+            }
+        }
+        else
+        {
+            DrawStateBinding &binding = m_draw_states[element.bitfields0.GROUP_ID %
+                                                      kNumDrawStateGroups];
+            if (element.bitfields0.DISABLE)
+            {
+                is_redundant = !binding.m_is_bound;
+                binding.m_is_bound = false;
+            }
+            else
+            {
+                DrawStateBinding new_binding = {};
+                new_binding.m_enable_mask = element.bitfields0.BINNING |
+                                            (element.bitfields0.GMEM << 1) |
+                                            (element.bitfields0.SYSMEM << 2) |
+                                            (element.bitfields0.LOAD_IMMED << 3);
+                new_binding.m_num_dwords = element.bitfields0.COUNT;
+
+                // Contents that cannot be read are never considered identical
+                std::vector<uint32_t> contents(new_binding.m_num_dwords);
+                new_binding.m_is_bound = mem_manager.RetrieveMemoryData(contents.data(),
+                                                                        submit_index,
+                                                                        element.ADDR,
+                                                                        contents.size() *
+                                                                        sizeof(uint32_t));
+                new_binding.m_hash = HashDwords(contents);
+                is_redundant = binding.m_is_bound && new_binding.m_is_bound &&
+                               binding.m_enable_mask == new_binding.m_enable_mask &&
+                               binding.m_num_dwords == new_binding.m_num_dwords &&
+                               binding.m_hash == new_binding.m_hash;
+                binding = new_binding;
+            }
+        }
+
+        m_submit.m_draw_state_groups.m_total++;
+        if (is_redundant)
+        {
+            m_submit.m_draw_state_groups.m_redundant++;
+            num_redundant++;
+        }
+        if (element.bitfields0.DISABLE_ALL_GROUPS)
+            break;
+    }
+
+    uint32_t num_dwords = header.type7.count + 1;
+    uint32_t redundant_dwords = (array_size > 0 && num_redundant == array_size) ?
+                                num_dwords :
+                                num_redundant * kDrawStateElementDwords;
+    m_submit.m_draw_state_groups.m_redundant_dwords += redundant_dwords;
+    AddPacket(CP_SET_DRAW_STATE, num_dwords, redundant_dwords);
+}
+
+//--------------------------------------------------------------------------------------------------
+void RedundancyAnalyzer::CheckDraw(const IMemoryManager &mem_manager,
+                                   uint32_t              submit_index,
+                                   uint64_t              va_addr,
+                                   Pm4Header             header)
+{
+    // Indirect draws take their counts from memory written by the GPU, so only direct draws can
+    // be known to draw nothing
+    bool is_noop = false;
+    if (header.type7.opcode == CP_DRAW_INDX_OFFSET)
+    {
+        PM4_CP_DRAW_INDX_OFFSET packet;
+        DIVE_VERIFY(mem_manager.RetrieveMemoryData(&packet,
+                                                   submit_index,
+                                                   va_addr,
+                                                   (header.type7.count + 1) * sizeof(uint32_t)));
+        is_noop = packet.bitfields1.NUM_INSTANCES == 0 || packet.bitfields2.NUM_INDICES == 0;
+    }
+    else if (header.type7.opcode == CP_DRAW_INDX)
+    {
+        PM4_CP_DRAW_INDX packet;
+        DIVE_VERIFY(mem_manager.RetrieveMemoryData(&packet, submit_index, va_addr, sizeof(packet)));
+        is_noop = packet.bitfields1.NUM_INSTANCES == 0 || packet.bitfields2.NUM_INDICES == 0;
+    }
+
+    uint32_t num_dwords = GetPacketSize(header);
+    uint32_t redundant_dwords = is_noop ? num_dwords : 0;
+    m_submit.m_draws.m_total++;
+    m_submit.m_draws.m_redundant += is_noop ? 1 : 0;
+    m_submit.m_draws.m_redundant_dwords += redundant_dwords;
+    AddPacket(header.type7.opcode, num_dwords, redundant_dwords);
+    if (!is_noop)
+        m_bin_draws++;
+}
+
+//--------------------------------------------------------------------------------------------------
+void RedundancyAnalyzer::CheckWait(Pm4Header header)
+{
+    // Register writes, markers and IB jumps between two waits give the second one nothing to wait
+    // for
+    bool &work_since_wait = (header.type7.opcode == CP_WAIT_FOR_IDLE) ?
+                            m_work_since_wait_for_idle :
+                            m_work_since_wait_for_me;
+    bool  is_redundant = !work_since_wait;
+    work_since_wait = false;
+
+    uint32_t num_dwords = GetPacketSize(header);
+    uint32_t redundant_dwords = is_redundant ? num_dwords : 0;
+    m_submit.m_waits.m_total++;
+    m_submit.m_waits.m_redundant += is_redundant ? 1 : 0;
+    m_submit.m_waits.m_redundant_dwords += redundant_dwords;
+    AddPacket(header.type7.opcode, num_dwords, redundant_dwords);
+}
+
+//--------------------------------------------------------------------------------------------------
+void RedundancyAnalyzer::CheckMarker(const IMemoryManager &mem_manager,
+                                     uint32_t              submit_index,
+                                     uint64_t              va_addr)
+{
+    PM4_CP_SET_MARKER packet;
+    DIVE_VERIFY(mem_manager.RetrieveMemoryData(&packet, submit_index, va_addr, sizeof(packet)));
+    a6xx_marker marker = static_cast<a6xx_marker>(packet.u32All0 & 0xf);
+    bool        bin_started_by_prefix = m_bin_started_by_prefix;
+    m_bin_started_by_prefix = false;
+    switch (marker)
+    {
+    case RM6_BIN_RENDER_START:
+        // Already started if emitted by the bin's CP_START_BIN prefix
+        if (!bin_started_by_prefix)
+        {
+            EndBin();
+            BeginBin();
+        }
+        break;
+    case RM6_BIN_RENDER_END:
+    case RM6_DIRECT_RENDER:
+    case RM6_BIN_VISIBILITY:
+    case RM6_BIN_DIRECT:
+    case RM6_COMPUTE:
+        EndBin();
+        break;
+    default:
+        break;
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+void RedundancyAnalyzer::BeginBin()
+{
+    m_in_bin = true;
+    m_bin_draws = 0;
+    m_bin_dwords = 0;
+    m_bin_redundant_dwords = m_submit.GetRedundantDwords();
+}
+
+//--------------------------------------------------------------------------------------------------
+void RedundancyAnalyzer::EndBin()
+{
+    if (!m_in_bin)
+        return;
+    m_in_bin = false;
+
+    // The whole bin can go, less what was already counted as redundant within it
+    m_submit.m_bins.m_total++;
+    if (m_bin_draws == 0)
+    {
+        uint64_t counted_dwords = m_submit.GetRedundantDwords() - m_bin_redundant_dwords;
+        m_submit.m_bins.m_redundant++;
+        m_submit.m_bins.m_redundant_dwords += m_bin_dwords - counted_dwords;
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+void RedundancyAnalyzer::AddPacket(uint32_t key, uint32_t num_dwords, uint32_t redundant_dwords)
+{
+    RedundancyCount &packet_count = m_report.m_packets[key];
+    packet_count.m_total++;
+    packet_count.m_redundant += (redundant_dwords == num_dwords) ? 1 : 0;
+    packet_count.m_redundant_dwords += redundant_dwords;
+}
+
+}  // namespace Dive
@@ -0,0 +1,178 @@
+/*
+ Copyright 2025 Google LLC
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+// =====================================================================================================================
+// Finds PM4 that changes nothing while emulating a capture: register writes of the value already
+// set, draw state groups re-bound with identical contents, waits with no work to wait for since the
+// previous one, draws of 0 indices or instances, and bins with no draw. Each is counted with the
+// dwords its removal would save, per submit, per register and per packet type.
+// =====================================================================================================================
+
+#pragma once
+#include <array>
+#include <cstdint>
+#include <map>
+#include <vector>
+#include "dive_core/common/emulate_pm4.h"
+
+namespace Dive
+{
+
+//--------------------------------------------------------------------------------------------------
+struct RedundancyCount
+{
+    uint64_t m_total = 0;
+    uint64_t m_redundant = 0;
+    uint64_t m_redundant_dwords = 0;  // Estimated dwords saved by removing the redundant ones
+
+    void Add(const RedundancyCount &other)
+    {
+        m_total += other.m_total;
+        m_redundant += other.m_redundant;
+        m_redundant_dwords += other.m_redundant_dwords;
+    }
+};
+
+//--------------------------------------------------------------------------------------------------
+struct SubmitRedundancy
+{
+    uint32_t m_submit_index = 0;
+
+    // Dwords of all the packets emulated, so an IB called several times counts several times.
+    // The contents of draw state groups are not included
+    uint64_t m_num_dwords = 0;
+
+    RedundancyCount m_reg_writes;         // Registers written, and those set to their value
+    RedundancyCount m_draw_state_groups;  // CP_SET_DRAW_STATE entries, and those changing nothing
+    RedundancyCount m_waits;              // CP_WAIT_FOR_IDLE/ME, and those with no work to wait for
+    RedundancyCount m_draws;              // Direct draws, and those of 0 indices or instances
+    RedundancyCount m_bins;               // Bins, and those without draws
+
+    uint64_t GetRedundantDwords() const
+    {
+        return m_reg_writes.m_redundant_dwords + m_draw_state_groups.m_redundant_dwords +
+               m_waits.m_redundant_dwords + m_draws.m_redundant_dwords +
+               m_bins.m_redundant_dwords;
+    }
+};
+
+//--------------------------------------------------------------------------------------------------
+struct RedundancyReport
+{
+    // Key of the type 4 register write packets in m_packets, which are otherwise keyed by opcode
+    static constexpr uint32_t kType4Packet = UINT32_MAX;
+
+    std::vector<SubmitRedundancy> m_submits;
+
+    // Register writes by register offset
+    std::map<uint32_t, RedundancyCount> m_registers;
+
+    // Packets of the types above by opcode, where a packet is redundant if it can be removed whole
+    // and its redundant dwords include the partially redundant packets
+    std::map<uint32_t, RedundancyCount> m_packets;
+
+    // Totals over the submits
+    SubmitRedundancy GetTotals() const;
+};
+
+//--------------------------------------------------------------------------------------------------
+// Emulation callbacks filling a RedundancyReport. Register state and draw state bindings are not
+// carried over from one submit to the next, since a submit cannot rely on the state left by
+// another one
+class RedundancyAnalyzer : public EmulateCallbacksBase
+{
+public:
+    RedundancyAnalyzer(RedundancyReport &report);
+
+    virtual void OnSubmitStart(uint32_t submit_index, const SubmitInfo &submit_info) override;
+    virtual void OnSubmitEnd(uint32_t submit_index, const SubmitInfo &submit_info) override;
+
+    virtual bool OnIbStart(uint32_t                  submit_index,
+                           uint32_t                  ib_index,
+                           const IndirectBufferInfo &ib_info,
+                           IbType                    type) override;
+
+    virtual bool OnIbEnd(uint32_t                  submit_index,
+                         uint32_t                  ib_index,
+                         const IndirectBufferInfo &ib_info) override;
+
+    virtual bool OnPacket(const IMemoryManager &mem_manager,
+                          uint32_t              submit_index,
+                          uint32_t              ib_index,
+                          uint64_t              va_addr,
+                          Pm4Header             header) override;
+
+private:
+    // Counts one register write, before it is applied. Returns true if it is redundant
+    bool CheckRegWrite(uint32_t offset, uint32_t value, uint32_t num_dwords);
+
+    void CheckType4Packet(const IMemoryManager &mem_manager,
+                          uint32_t              submit_index,
+                          uint64_t              va_addr,
+                          Pm4Header             header);
+    void CheckRegBunch(const IMemoryManager &mem_manager,
+                       uint32_t              submit_index,
+                       uint64_t              va_addr,
+                       Pm4Header             header);
+    void CheckDrawState(const IMemoryManager &mem_manager,
+                        uint32_t              submit_index,
+                        uint64_t              va_addr,
+                        Pm4Header             header);
+    void CheckDraw(const IMemoryManager &mem_manager,
+                   uint32_t              submit_index,
+                   uint64_t              va_addr,
+                   Pm4Header             header);
+    void CheckWait(Pm4Header header);
+    void CheckMarker(const IMemoryManager &mem_manager, uint32_t submit_index, uint64_t va_addr);
+
+    void BeginBin();
+    void EndBin();
+
+    // Adds a packet of `num_dwords`, of which `redundant_dwords` can be removed
+    void AddPacket(uint32_t key, uint32_t num_dwords, uint32_t redundant_dwords);
+
+    static constexpr uint32_t kNumDrawStateGroups = 32;
+    struct DrawStateBinding
+    {
+        bool     m_is_bound;
+        uint32_t m_enable_mask;
+        uint32_t m_num_dwords;
+        uint64_t m_hash;  // Of the group's contents
+    };
+
+    RedundancyReport &m_report;
+    SubmitRedundancy  m_submit;
+
+    std::array<DrawStateBinding, kNumDrawStateGroups> m_draw_states = {};
+
+    // Type of each IB being emulated, and how many of them are draw state groups. The packets of
+    // a group belong to the CP_SET_DRAW_STATE that bound it, which is checked as a whole, so they
+    // are neither checked nor counted again
+    std::vector<IbType> m_ib_types;
+    uint32_t            m_draw_state_ib_depth = 0;
+
+    // Set by the work the waits wait for: draws, dispatches, events and memory writes
+    bool m_work_since_wait_for_idle = true;
+    bool m_work_since_wait_for_me = true;
+
+    bool     m_in_bin = false;
+    bool     m_bin_started_by_prefix = false;  // Until the first marker of the bin
+    uint32_t m_bin_draws = 0;
+    uint64_t m_bin_dwords = 0;
+    uint64_t m_bin_redundant_dwords = 0;  // Redundant dwords of the submit when the bin started
+};
+
+}  // namespace Dive
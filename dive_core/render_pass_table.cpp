@@ -0,0 +1,166 @@
+/*
+ Copyright 2025 Google LLC
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#include "render_pass_table.h"
+#include <algorithm>
+#include "dive_core/common/common.h"
+
+namespace Dive
+{
+
+//--------------------------------------------------------------------------------------------------
+uint32_t GetFormatBitsPerPixel(std::string_view format_name)
+{
+    constexpr std::string_view kPrefix = "FMT6_";
+    if (format_name.substr(0, kPrefix.size()) != kPrefix)
+        return 0;
+    format_name.remove_prefix(kPrefix.size());
+
+    // The components are the '_'-separated parts that are either a bit count ("8", "10") or
+    // channels with their bit counts ("Z24", "X8Z24", "E5"). Any other part with a digit is a
+    // compressed or YUV format ("ETC2", "4x4", "NV12")
+    uint32_t bits = 0;
+    while (!format_name.empty())
+    {
+        size_t           end = format_name.find('_');
+        std::string_view part = format_name.substr(0, end);
+        format_name.remove_prefix(end == std::string_view::npos ? format_name.size() : end + 1);
+
+        uint32_t part_bits = 0;
+        uint32_t value = 0;
+        bool     has_digit = false;
+        for (size_t i = 0; i < part.size(); ++i)
+        {
+            char c = part[i];
+            if (c >= '0' && c <= '9')
+            {
+                value = value * 10 + static_cast<uint32_t>(c - '0');
+                has_digit = true;
+                continue;
+            }
+            part_bits += value;
+            value = 0;
+            bool is_channel = (c == 'X' || c == 'Z' || c == 'S' || c == 'E') &&
+                              i + 1 < part.size() && part[i + 1] >= '0' && part[i + 1] <= '9';
+            if (has_digit && !is_channel)
+                return 0;
+            if (!is_channel)
+                break;
+        }
+        bits += part_bits + value;
+    }
+
+    // Subsampled formats name their sampling ("R8G8R8B8_422") like a bit count
+    return (bits <= 128) ? bits : 0;
+}
+
+// =================================================================================================
+// RenderPassTable
+// =================================================================================================
+void RenderPassTable::Clear()
+{
+    *this = RenderPassTable();
+}
+
+//--------------------------------------------------------------------------------------------------
+void RenderPassTable::BeginPass(uint32_t submit_index, uint32_t first_event, bool is_tiled)
+{
+    DIVE_ASSERT(!m_pass_open);
+    uint32_t num_bins = static_cast<uint32_t>(m_bins.size());
+    m_render_passes.push_back(
+    { submit_index, first_event, first_event, num_bins, num_bins, is_tiled });
+    m_pass_open = true;
+}
+
+//--------------------------------------------------------------------------------------------------
+void RenderPassTable::EndPass(uint32_t end_event)
+{
+    DIVE_ASSERT(m_pass_open && !m_bin_open);
+    RenderPassInfo &pass = m_render_passes.back();
+    pass.m_end_event = end_event;
+    pass.m_end_bin = static_cast<uint32_t>(m_bins.size());
+    m_pass_open = false;
+}
+
+//--------------------------------------------------------------------------------------------------
+void RenderPassTable::BeginBin(uint32_t first_event)
+{
+    DIVE_ASSERT(IsTiledPassOpen() && !m_bin_open);
+    m_bins.push_back({ first_event, first_event, 0, 0, 0, 0 });
+    m_bin_open = true;
+}
+
+//--------------------------------------------------------------------------------------------------
+void RenderPassTable::EndBin(uint32_t end_event,
+                             uint32_t x,
+                             uint32_t y,
+                             uint32_t width,
+                             uint32_t height)
+{
+    DIVE_ASSERT(m_bin_open);
+    BinInfo &bin = m_bins.back();
+    bin = { bin.m_first_event, end_event, x, y, width, height };
+    m_bin_open = false;
+
+    // A tiled pass without a binning pass has no marker at its start, so a bin revisiting the
+    // window of an earlier bin of the pass is taken as the first bin of the next pass
+    if (width == 0)
+        return;
+    RenderPassInfo &pass = m_render_passes.back();
+    uint32_t        bin_index = static_cast<uint32_t>(m_bins.size() - 1);
+    for (uint32_t i = pass.m_first_bin; i < bin_index; ++i)
+    {
+        const BinInfo &other = m_bins[i];
+        if (other.m_x == x && other.m_y == y && other.m_width == width && other.m_height == height)
+        {
+            RenderPassInfo next = pass;
+            pass.m_end_event = bin.m_first_event;
+            pass.m_end_bin = bin_index;
+            next.m_first_event = bin.m_first_event;
+            next.m_first_bin = bin_index;
+            m_render_passes.push_back(next);
+            return;
+        }
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+void RenderPassTable::AddResolve(const ResolveInfo &resolve)
+{
+    DIVE_ASSERT(m_resolves.empty() || m_resolves.back().m_event_id < resolve.m_event_id);
+    m_resolves.push_back(resolve);
+}
+
+//--------------------------------------------------------------------------------------------------
+const ResolveInfo *RenderPassTable::FindResolve(uint32_t event_id) const
+{
+    auto it = std::lower_bound(m_resolves.begin(),
+                               m_resolves.end(),
+                               event_id,
+                               [](const ResolveInfo &resolve, uint32_t id) {
+                                   return resolve.m_event_id < id;
+                               });
+    return (it != m_resolves.end() && it->m_event_id == event_id) ? &*it : nullptr;
+}
+
+//--------------------------------------------------------------------------------------------------
+size_t RenderPassTable::GetMemoryUsage() const
+{
+    return m_render_passes.capacity() * sizeof(RenderPassInfo) +
+           m_bins.capacity() * sizeof(BinInfo) + m_resolves.capacity() * sizeof(ResolveInfo);
+}
+
+}  // namespace Dive
@@ -0,0 +1,116 @@
+/*
+ Copyright 2025 Google LLC
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+// =====================================================================================================================
+// Render passes and bins of a capture, as ranges of events, plus the area and format of each
+// resolve and GMEM clear. Built while emulating from the render mode markers and the CP_START_BIN
+// prefix IBs, so that GMEM traffic can be attributed to the pass and bin that caused it.
+// =====================================================================================================================
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace Dive
+{
+
+//--------------------------------------------------------------------------------------------------
+// Area and format of the system memory side of a resolve or GMEM clear
+struct ResolveInfo
+{
+    uint32_t m_event_id;
+    uint32_t m_width;
+    uint32_t m_height;
+    uint32_t m_bits_per_pixel;  // 0 if the format is unknown
+    uint32_t m_num_samples;
+
+    // Bytes of system memory read by a load or written by a store
+    uint64_t GetNumBytes() const
+    {
+        return uint64_t(m_width) * m_height * m_num_samples * m_bits_per_pixel / 8;
+    }
+};
+
+//--------------------------------------------------------------------------------------------------
+// The events [m_first_event, m_end_event) rendered into a bin, with the bin's window scissor
+struct BinInfo
+{
+    uint32_t m_first_event;
+    uint32_t m_end_event;
+    uint32_t m_x;
+    uint32_t m_y;
+    uint32_t m_width;  // 0 if the window scissor is unknown
+    uint32_t m_height;
+};
+
+//--------------------------------------------------------------------------------------------------
+// The events [m_first_event, m_end_event) of a render pass. A tiled pass includes its binning
+// pass, and its bins are [m_first_bin, m_end_bin) in RenderPassTable::GetBins(). A direct pass
+// has no end marker, so it lasts until the next pass or dispatch
+struct RenderPassInfo
+{
+    uint32_t m_submit_index;
+    uint32_t m_first_event;
+    uint32_t m_end_event;
+    uint32_t m_first_bin;
+    uint32_t m_end_bin;
+    bool     m_is_tiled;
+};
+
+// Bits per pixel of an a6xx_format, from its enum name (e.g. "FMT6_8_8_8_8_UNORM" is 32 bits and
+// "FMT6_Z24_UNORM_S8_UINT" 32 bits). 0 for compressed, YUV and unknown formats
+uint32_t GetFormatBitsPerPixel(std::string_view format_name);
+
+//--------------------------------------------------------------------------------------------------
+class RenderPassTable
+{
+public:
+    void Clear();
+
+    // Builder, called with the number of events added so far. Passes and bins must be ended
+    // before the next one begins, and bins are only added to a tiled pass
+    void BeginPass(uint32_t submit_index, uint32_t first_event, bool is_tiled);
+    void EndPass(uint32_t end_event);
+    void BeginBin(uint32_t first_event);
+    void EndBin(uint32_t end_event, uint32_t x, uint32_t y, uint32_t width, uint32_t height);
+
+    bool IsPassOpen() const { return m_pass_open; }
+    bool IsBinOpen() const { return m_bin_open; }
+    bool IsTiledPassOpen() const { return m_pass_open && m_render_passes.back().m_is_tiled; }
+
+    // Resolves must be added in event order
+    void AddResolve(const ResolveInfo &resolve);
+
+    const std::vector<RenderPassInfo> &GetRenderPasses() const { return m_render_passes; }
+    const std::vector<BinInfo>        &GetBins() const { return m_bins; }
+    const std::vector<ResolveInfo>    &GetResolves() const { return m_resolves; }
+
+    // Resolve info of `event_id`, nullptr if it is not a resolve or its registers were not set
+    const ResolveInfo *FindResolve(uint32_t event_id) const;
+
+    size_t GetMemoryUsage() const;
+
+private:
+    std::vector<RenderPassInfo> m_render_passes;
+    std::vector<BinInfo>        m_bins;
+    std::vector<ResolveInfo>    m_resolves;
+    bool                        m_pass_open = false;
+    bool                        m_bin_open = false;
+};
+
+}  // namespace Dive
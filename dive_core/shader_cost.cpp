@@ -0,0 +1,152 @@
+/*
+ Copyright 2025 Google LLC
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#include "shader_cost.h"
+#include <algorithm>
+#include "shader_disassembly.h"
+
+namespace Dive
+{
+
+namespace
+{
+
+// Register file and wave limits of a6xx, from freedreno_devices.py
+constexpr uint32_t kRegSizeVec4 = 96;
+constexpr uint32_t kWaveGranularity = 2;
+constexpr uint32_t kMaxWaves = 16;
+
+// Relative cost of one instruction of each class. SFU instructions issue at a quarter of the ALU
+// rate, and texture and memory instructions are weighted for the fetch they start, which the
+// other waves only partly hide
+constexpr std::array<uint32_t, kShaderInstructionClassCount> kClassCycles = { 1, 4, 8, 8, 1 };
+
+//--------------------------------------------------------------------------------------------------
+inline uint32_t GetBits(uint64_t instruction, uint32_t low, uint32_t high)
+{
+    return static_cast<uint32_t>((instruction >> low) & ((1ull << (high - low + 1)) - 1));
+}
+
+}  // namespace
+
+//--------------------------------------------------------------------------------------------------
+const char *GetShaderInstructionClassName(ShaderInstructionClass instruction_class)
+{
+    switch (instruction_class)
+    {
+    case ShaderInstructionClass::kAlu:
+        return "alu";
+    case ShaderInstructionClass::kSfu:
+        return "sfu";
+    case ShaderInstructionClass::kTexture:
+        return "texture";
+    case ShaderInstructionClass::kMemory:
+        return "memory";
+    case ShaderInstructionClass::kFlow:
+        return "flow";
+    default:
+        return "unknown";
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+uint32_t GetMaxWavesPerSp(uint32_t gpr_count)
+{
+    if (gpr_count == 0)
+        return kMaxWaves;
+    return std::min(kRegSizeVec4 / gpr_count * kWaveGranularity, kMaxWaves);
+}
+
+// =================================================================================================
+// ShaderCost
+// =================================================================================================
+uint32_t ShaderCost::GetCycles() const
+{
+    uint32_t cycles = m_num_nops;
+    for (uint32_t i = 0; i < kShaderInstructionClassCount; ++i)
+        cycles += m_num_instructions[i] * kClassCycles[i];
+    return cycles;
+}
+
+//--------------------------------------------------------------------------------------------------
+void ShaderCost::AddInstruction(uint64_t instruction)
+{
+    // Field positions are those of src/freedreno/isa/ir3-cat*.xml
+    uint32_t               category = GetBits(instruction, 61, 63);
+    uint32_t               repeat = 0;
+    uint32_t               nops = 0;
+    bool                   is_nop = false;
+    bool                   has_ss = false;
+    ShaderInstructionClass instruction_class = ShaderInstructionClass::kFlow;
+    switch (category)
+    {
+    case 0:
+        repeat = GetBits(instruction, 40, 42);
+        is_nop = GetBits(instruction, 55, 58) == 0 && GetBits(instruction, 49, 49) == 0;
+        has_ss = GetBits(instruction, 44, 44) != 0;
+        break;
+    case 1:
+    case 2:
+    case 3:
+        instruction_class = ShaderInstructionClass::kAlu;
+        repeat = GetBits(instruction, 40, 41);
+        has_ss = GetBits(instruction, 44, 44) != 0;
+
+        // Without a repeat, the (r) flags of cat2 and cat3 encode (nopN) instead
+        if (category != 1 && repeat == 0)
+        {
+            uint32_t src2_r_bit = (category == 2) ? 51 : 15;
+            nops = GetBits(instruction, 43, 43) |
+                   (GetBits(instruction, src2_r_bit, src2_r_bit) << 1);
+        }
+        break;
+    case 4:
+        instruction_class = ShaderInstructionClass::kSfu;
+        repeat = GetBits(instruction, 40, 41);
+        has_ss = GetBits(instruction, 44, 44) != 0;
+        break;
+    case 5:
+        instruction_class = ShaderInstructionClass::kTexture;
+        break;
+    case 6:
+        instruction_class = ShaderInstructionClass::kMemory;
+        break;
+    case 7:
+        has_ss = GetBits(instruction, 44, 44) != 0;
+        break;
+    }
+
+    if (is_nop)
+        m_num_nops += 1 + repeat;
+    else
+        m_num_instructions[static_cast<uint32_t>(instruction_class)] += 1 + repeat;
+    m_num_nops += nops;
+    m_num_syncs += GetBits(instruction, 60, 60) + (has_ss ? 1 : 0);
+}
+
+//--------------------------------------------------------------------------------------------------
+ShaderCost GetShaderCost(const Disassembly &disassembly)
+{
+    ShaderCost cost;
+    size_t     num_instructions = disassembly.GetNumInstructions();
+    for (size_t i = 0; i < num_instructions; ++i)
+        cost.AddInstruction(disassembly.GetInstructionRaw(static_cast<uint32_t>(i)));
+    cost.m_gpr_count = disassembly.GetGPRCount();
+    cost.m_max_waves = GetMaxWavesPerSp(cost.m_gpr_count);
+    return cost;
+}
+
+}  // namespace Dive
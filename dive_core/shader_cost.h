@@ -0,0 +1,72 @@
+/*
+ Copyright 2025 Google LLC
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+// =====================================================================================================================
+// Static cost estimate of an ir3 shader, from the raw instructions of its disassembly: the
+// instructions executed per invocation by category, the syncs waiting on their results, and the
+// occupancy its GPR count allows. Meant to rank shaders and draws without a GPU, not to predict
+// their timings.
+// =====================================================================================================================
+
+#pragma once
+#include <array>
+#include <cstdint>
+
+namespace Dive
+{
+class Disassembly;
+
+//--------------------------------------------------------------------------------------------------
+enum class ShaderInstructionClass : uint8_t
+{
+    kAlu,      // cat1-cat3: moves, conversions, arithmetic
+    kSfu,      // cat4: transcendental and other special functions
+    kTexture,  // cat5: samples and texture queries
+    kMemory,   // cat6: loads, stores and atomics
+    kFlow,     // cat0 and cat7: branches, barriers and fences
+    kCount
+};
+constexpr uint32_t kShaderInstructionClassCount = static_cast<uint32_t>(
+ShaderInstructionClass::kCount);
+
+const char *GetShaderInstructionClassName(ShaderInstructionClass instruction_class);
+
+//--------------------------------------------------------------------------------------------------
+struct ShaderCost
+{
+    // Instructions executed by one invocation, counting each (rptN) repeat, by class. Branches are
+    // not followed, so each instruction counts once
+    std::array<uint32_t, kShaderInstructionClassCount> m_num_instructions = {};
+
+    uint32_t m_num_nops = 0;   // nop instructions and (nopN) cycles
+    uint32_t m_num_syncs = 0;  // (sy) and (ss) waits on texture, memory and SFU results
+    uint32_t m_gpr_count = 0;  // Full precision vec4 GPRs
+    uint32_t m_max_waves = 0;  // Waves per SP allowed by the GPR count
+
+    // Estimated cycles of one invocation, weighting each class by its relative cost
+    uint32_t GetCycles() const;
+
+    // Adds one raw 64-bit instruction
+    void AddInstruction(uint64_t instruction);
+};
+
+// Waves per SP that `gpr_count` vec4 GPRs allow, as computed by ir3 for a6xx with the 96 vec4
+// register file of most parts
+uint32_t GetMaxWavesPerSp(uint32_t gpr_count);
+
+ShaderCost GetShaderCost(const Disassembly &disassembly);
+
+}  // namespace Dive
@@ -16,11 +16,13 @@
 
 #include "shader_disassembly.h"
 
+#include <cstring>
 #include <mutex>
 #include <string_view>
 
 #include "dive_core/common/memory_manager_base.h"
 #include "pm4_info.h"
+#include "shader_disassembly_cache.h"
 
 #ifdef _MSC_VER
 #    include <stdio.h>
@@ -37,6 +39,43 @@ extern "C"
 namespace Dive
 {
 
+namespace
+{
+// Fixed bits of the upper dword of a cat0 instruction without sources, and the values of that
+// dword (masked) for the instructions that end a shader (see ir3-cat0.xml)
+constexpr uint32_t kCat0Mask = 0xE7F2E0FC;
+constexpr uint32_t kCat0Nop = 0;
+constexpr uint32_t kCat0End = 6 << 23;
+constexpr uint32_t kCat0Chsh = 10 << 23;
+
+//--------------------------------------------------------------------------------------------------
+// Returns the size of the shader at `data`, i.e. the offset where the disassembler stops: the 4th
+// consecutive nop after an "end", or a "chsh". Returns max_size if the shader doesn't end before
+uint64_t FindShaderEnd(const uint8_t* data, uint64_t max_size)
+{
+    bool     has_end = false;
+    uint32_t nop_count = 0;
+    for (uint64_t offset = 0; offset + sizeof(uint64_t) <= max_size; offset += sizeof(uint64_t))
+    {
+        uint32_t dword1;
+        memcpy(&dword1, data + offset + sizeof(uint32_t), sizeof(dword1));
+        const uint32_t cat0 = dword1 & kCat0Mask;
+        if (cat0 == kCat0Nop)
+        {
+            if (has_end && ++nop_count > 3)
+                return offset + sizeof(uint64_t);
+            continue;
+        }
+        nop_count = 0;
+        if (cat0 == kCat0End)
+            has_end = true;
+        else if (cat0 == kCat0Chsh)
+            return offset + sizeof(uint64_t);
+    }
+    return max_size;
+}
+}  // namespace
+
 //--------------------------------------------------------------------------------------------------
 bool Disassemble(const uint8_t*                             shader_memory,
                  uint64_t                                   shader_address,
@@ -132,6 +171,22 @@ void Disassembly::Disassemble() const
         DIVE_VERIFY(
         m_mem_manager.RetrieveMemoryData(data_ptr, m_submit_index, m_address, max_size));
 
+        ShaderDisassemblyCache     &cache = ShaderDisassemblyCache::GetInstance();
+        ShaderDisassemblyCache::Key cache_key = {};
+        const bool                  use_cache = cache.IsEnabled();
+        if (use_cache)
+        {
+            // Key on the shader's own instructions only, so the same shader hits the cache
+            // regardless of what follows it in memory
+            const uint64_t shader_size = FindShaderEnd(data_ptr, max_size);
+            cache_key = ShaderDisassemblyCache::ComputeKey(data_ptr, shader_size, GetGPUID());
+            if (cache.Load(cache_key, &m_disassembled_data))
+            {
+                delete[] data_ptr;
+                return;
+            }
+        }
+
         struct shader_stats stats;
         std::string         disasm = DisassembleA3XX(data_ptr, max_size, &stats, PRINT_RAW);
         std::istringstream  disasm_istr(disasm);
@@ -181,6 +236,8 @@ void Disassembly::Disassemble() const
         disassembled_data.m_gpr_count = (stats.fullreg + 3) / 4;
         disassembled_data.m_listing = DisassembleA3XX(data_ptr, max_size, &stats, PRINT_STATS);
         delete[] data_ptr;
+        if (use_cache)
+            cache.Store(cache_key, disassembled_data);
         m_disassembled_data = disassembled_data;
     });
 }
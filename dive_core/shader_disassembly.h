@@ -59,6 +59,14 @@ private:
 class Disassembly
 {
 public:
+    struct DisassembledData
+    {
+        std::string              m_listing;
+        std::vector<std::string> m_instructions_text;
+        std::vector<uint64_t>    m_instructions_raw;
+        uint32_t                 m_gpr_count;
+    };
+
     Disassembly(const IMemoryManager& mem_manager,
                 uint32_t              submit_index,
                 uint64_t              address,
@@ -81,14 +89,6 @@ public:
     void EagerEval() const { Disassemble(); }
 
 private:
-    struct DisassembledData
-    {
-        std::string              m_listing;
-        std::vector<std::string> m_instructions_text;
-        std::vector<uint64_t>    m_instructions_raw;
-        uint32_t                 m_gpr_count;
-    };
-
     void Disassemble() const;
 
     const DisassembledData& GetData() const
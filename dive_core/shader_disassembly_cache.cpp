@@ -0,0 +1,398 @@
+/*
+ Copyright 2025 Google LLC
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#include "shader_disassembly_cache.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <vector>
+
+namespace Dive
+{
+
+namespace
+{
+constexpr uint32_t kMagic = 0x43535644;  // "DVSC"
+constexpr char     kEntryExtension[] = ".dvsc";
+constexpr char     kTempExtension[] = ".tmp";
+
+// Temp files older than this are left over from writers that crashed between writing and renaming
+// them. Live writers finish well within this age, so removing them never races a rename
+constexpr std::chrono::hours kStaleTempAge(1);
+
+//--------------------------------------------------------------------------------------------------
+uint64_t Mix(uint64_t x)
+{
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdull;
+    x ^= x >> 33;
+    x *= 0xc4ceb9fe1a85ec53ull;
+    x ^= x >> 33;
+    return x;
+}
+
+//--------------------------------------------------------------------------------------------------
+uint64_t RotateLeft(uint64_t x, int bits)
+{
+    return (x << bits) | (x >> (64 - bits));
+}
+
+//--------------------------------------------------------------------------------------------------
+template<typename T> void Write(std::string *out, T value)
+{
+    out->append(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+//--------------------------------------------------------------------------------------------------
+void WriteString(std::string *out, const std::string &str)
+{
+    Write<uint64_t>(out, str.size());
+    out->append(str);
+}
+
+//--------------------------------------------------------------------------------------------------
+// Bounds-checked reads from a loaded entry
+class Reader
+{
+public:
+    explicit Reader(const std::string &data) :
+        m_data(data)
+    {
+    }
+
+    template<typename T> bool Read(T *value)
+    {
+        if (m_data.size() - m_pos < sizeof(T))
+            return false;
+        memcpy(value, m_data.data() + m_pos, sizeof(T));
+        m_pos += sizeof(T);
+        return true;
+    }
+
+    bool ReadString(std::string *str)
+    {
+        uint64_t size = 0;
+        if (!Read(&size) || m_data.size() - m_pos < size)
+            return false;
+        str->assign(m_data, m_pos, size);
+        m_pos += size;
+        return true;
+    }
+
+    bool AtEnd() const { return m_pos == m_data.size(); }
+
+private:
+    const std::string &m_data;
+    size_t             m_pos = 0;
+};
+
+//--------------------------------------------------------------------------------------------------
+struct EntryFile
+{
+    std::filesystem::path           m_path;
+    uint64_t                        m_size;
+    std::filesystem::file_time_type m_time;
+};
+
+//--------------------------------------------------------------------------------------------------
+// Lists the entries in `directory`, removing stale temp files along the way
+std::vector<EntryFile> ListEntries(const std::filesystem::path &directory)
+{
+    std::vector<EntryFile> entries;
+    std::error_code        ec;
+    const auto             stale_time = std::filesystem::file_time_type::clock::now() -
+                                        kStaleTempAge;
+    for (std::filesystem::directory_iterator it(directory, ec), end; !ec && it != end;
+         it.increment(ec))
+    {
+        if (it->path().extension() == kTempExtension)
+        {
+            std::error_code temp_ec;
+            auto            time = it->last_write_time(temp_ec);
+            if (!temp_ec && time < stale_time)
+                std::filesystem::remove(it->path(), temp_ec);
+            continue;
+        }
+        if (it->path().extension() != kEntryExtension)
+            continue;
+        EntryFile entry;
+        entry.m_path = it->path();
+        entry.m_size = it->file_size(ec);
+        if (ec)
+            continue;
+        entry.m_time = it->last_write_time(ec);
+        if (ec)
+            continue;
+        entries.push_back(std::move(entry));
+    }
+    return entries;
+}
+
+//--------------------------------------------------------------------------------------------------
+// Unique per thread and process, so concurrent writers of the same entry never share a temp file
+std::string GetTempSuffix()
+{
+    static std::atomic<uint64_t> counter = 0;
+    static const uint64_t        process_id = std::random_device()();
+    char                         buffer[64];
+    snprintf(buffer,
+             sizeof(buffer),
+             ".%016llx.%llu%s",
+             static_cast<unsigned long long>(process_id),
+             static_cast<unsigned long long>(counter++),
+             kTempExtension);
+    return buffer;
+}
+
+}  // namespace
+
+// =================================================================================================
+// ShaderDisassemblyCache
+// =================================================================================================
+std::string ShaderDisassemblyCache::Key::ToString() const
+{
+    char buffer[64];
+    snprintf(buffer,
+             sizeof(buffer),
+             "%016llx%016llx",
+             static_cast<unsigned long long>(m_hash[0]),
+             static_cast<unsigned long long>(m_hash[1]));
+    return buffer;
+}
+
+//--------------------------------------------------------------------------------------------------
+ShaderDisassemblyCache &ShaderDisassemblyCache::GetInstance()
+{
+    static ShaderDisassemblyCache cache;
+    return cache;
+}
+
+//--------------------------------------------------------------------------------------------------
+bool ShaderDisassemblyCache::SetDirectory(const std::filesystem::path &directory,
+                                          uint64_t                     max_size)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_directory.clear();
+    m_total_size = 0;
+    if (directory.empty())
+        return true;
+
+    std::error_code ec;
+    std::filesystem::create_directories(directory, ec);
+    if (ec || !std::filesystem::is_directory(directory, ec))
+        return false;
+
+    m_directory = directory;
+    m_max_size = max_size;
+    for (const EntryFile &entry : ListEntries(m_directory))
+        m_total_size += entry.m_size;
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+bool ShaderDisassemblyCache::IsEnabled() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return !m_directory.empty();
+}
+
+//--------------------------------------------------------------------------------------------------
+ShaderDisassemblyCache::Key ShaderDisassemblyCache::ComputeKey(const uint8_t *shader_data,
+                                                               size_t         size,
+                                                               uint32_t       gpu_id)
+{
+    // Two independent 64-bit lanes over 8-byte words, so a 128-bit key
+    uint64_t h0 = Mix(0x9e3779b97f4a7c15ull ^ gpu_id);
+    uint64_t h1 = Mix(0x2545f4914f6cdd1dull ^ kVersion);
+    for (size_t offset = 0; offset < size; offset += sizeof(uint64_t))
+    {
+        uint64_t word = 0;
+        memcpy(&word, shader_data + offset, std::min(sizeof(uint64_t), size - offset));
+        h0 = Mix(h0 + word);
+        h1 = RotateLeft(h1 ^ (word * 0x87c37b91114253d5ull), 31) * 0x4cf5ad432745937full;
+    }
+
+    Key key;
+    key.m_hash[0] = Mix(h0 ^ size);
+    key.m_hash[1] = Mix(h1 ^ (static_cast<uint64_t>(gpu_id) << 32) ^ kVersion);
+    key.m_size = size;
+    return key;
+}
+
+//--------------------------------------------------------------------------------------------------
+std::filesystem::path ShaderDisassemblyCache::GetEntryPath(const Key &key) const
+{
+    return m_directory / (key.ToString() + kEntryExtension);
+}
+
+//--------------------------------------------------------------------------------------------------
+bool ShaderDisassemblyCache::Load(const Key &key, Disassembly::DisassembledData *data)
+{
+    std::filesystem::path path;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_directory.empty())
+            return false;
+        path = GetEntryPath(key);
+    }
+
+    std::string contents;
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file)
+            return false;
+        contents.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        if (file.bad())
+            return false;
+    }
+
+    Reader                        reader(contents);
+    uint32_t                      magic = 0, version = 0;
+    Key                           entry_key = {};
+    Disassembly::DisassembledData entry;
+    uint64_t                      num_instructions = 0;
+    bool valid = reader.Read(&magic) && magic == kMagic && reader.Read(&version) &&
+                 version == kVersion && reader.Read(&entry_key.m_hash[0]) &&
+                 reader.Read(&entry_key.m_hash[1]) && reader.Read(&entry_key.m_size) &&
+                 entry_key.m_hash[0] == key.m_hash[0] && entry_key.m_hash[1] == key.m_hash[1] &&
+                 entry_key.m_size == key.m_size && reader.Read(&entry.m_gpr_count) &&
+                 reader.ReadString(&entry.m_listing) && reader.Read(&num_instructions);
+
+    // Each instruction takes at least 16 bytes, which bounds the allocation below
+    valid = valid && num_instructions <= contents.size() / 16;
+    if (valid)
+    {
+        entry.m_instructions_text.resize(num_instructions);
+        entry.m_instructions_raw.resize(num_instructions);
+        for (uint64_t i = 0; valid && i < num_instructions; ++i)
+        {
+            valid = reader.Read(&entry.m_instructions_raw[i]) &&
+                    reader.ReadString(&entry.m_instructions_text[i]);
+        }
+        valid = valid && reader.AtEnd();
+    }
+
+    std::error_code ec;
+    if (!valid)
+    {
+        std::filesystem::remove(path, ec);
+        return false;
+    }
+
+    // The modification time doubles as the last access time for LRU eviction
+    std::filesystem::last_write_time(path, std::filesystem::file_time_type::clock::now(), ec);
+    *data = std::move(entry);
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+void ShaderDisassemblyCache::Store(const Key &key, const Disassembly::DisassembledData &data)
+{
+    std::filesystem::path path;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_directory.empty())
+            return;
+        path = GetEntryPath(key);
+    }
+
+    std::string contents;
+    Write<uint32_t>(&contents, kMagic);
+    Write<uint32_t>(&contents, kVersion);
+    Write<uint64_t>(&contents, key.m_hash[0]);
+    Write<uint64_t>(&contents, key.m_hash[1]);
+    Write<uint64_t>(&contents, key.m_size);
+    Write<uint32_t>(&contents, data.m_gpr_count);
+    WriteString(&contents, data.m_listing);
+    Write<uint64_t>(&contents, data.m_instructions_text.size());
+    for (size_t i = 0; i < data.m_instructions_text.size(); ++i)
+    {
+        Write<uint64_t>(&contents, data.m_instructions_raw[i]);
+        WriteString(&contents, data.m_instructions_text[i]);
+    }
+
+    // Readers only ever see complete entries: the entry is written under a name nobody else uses,
+    // then renamed into place. If another writer wins the race, both wrote the same contents
+    std::filesystem::path temp_path = path;
+    temp_path += GetTempSuffix();
+    {
+        std::ofstream file(temp_path, std::ios::binary | std::ios::trunc);
+        file.write(contents.data(), static_cast<std::streamsize>(contents.size()));
+        if (!file)
+        {
+            file.close();
+            std::error_code ec;
+            std::filesystem::remove(temp_path, ec);
+            return;
+        }
+    }
+    std::error_code ec;
+    std::filesystem::rename(temp_path, path, ec);
+    if (ec)
+    {
+        std::filesystem::remove(temp_path, ec);
+        return;
+    }
+
+    uint64_t max_size;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_total_size += contents.size();
+        if (m_total_size <= m_max_size)
+            return;
+        max_size = m_max_size;
+    }
+
+    // Evict down to 3/4 of the limit so that eviction (a directory scan) stays infrequent
+    Evict(max_size / 4 * 3);
+}
+
+//--------------------------------------------------------------------------------------------------
+void ShaderDisassemblyCache::Evict(uint64_t target_size)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_directory.empty())
+        return;
+
+    std::vector<EntryFile> entries = ListEntries(m_directory);
+    std::sort(entries.begin(), entries.end(), [](const EntryFile &a, const EntryFile &b) {
+        return a.m_time < b.m_time;
+    });
+
+    uint64_t total_size = 0;
+    for (const EntryFile &entry : entries)
+        total_size += entry.m_size;
+
+    for (const EntryFile &entry : entries)
+    {
+        if (total_size <= target_size)
+            break;
+
+        // Another process may have evicted it already
+        std::error_code ec;
+        std::filesystem::remove(entry.m_path, ec);
+        total_size -= entry.m_size;
+    }
+    m_total_size = total_size;
+}
+
+}  // namespace Dive
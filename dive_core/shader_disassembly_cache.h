@@ -0,0 +1,83 @@
+/*
+ Copyright 2025 Google LLC
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+// =====================================================================================================================
+// On-disk cache of shader disassembly results, keyed by a hash of the shader binary, the GPU id and
+// the disassembler version. Each entry is one file, written to a temporary name and renamed into
+// place, so several threads or processes can share a cache directory. Reads refresh an entry's
+// modification time, and the oldest entries are evicted once the directory exceeds its size limit.
+// =====================================================================================================================
+
+#pragma once
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <string>
+
+#include "shader_disassembly.h"
+
+namespace Dive
+{
+
+//--------------------------------------------------------------------------------------------------
+class ShaderDisassemblyCache
+{
+public:
+    // Bump whenever the disassembler (third_party/mesa) or the DisassembledData layout changes.
+    // Entries of other versions are never read, and age out through eviction
+    static constexpr uint32_t kVersion = 1;
+
+    static constexpr uint64_t kDefaultMaxSize = 256ull * 1024 * 1024;
+
+    struct Key
+    {
+        uint64_t m_hash[2];
+        uint64_t m_size;
+
+        std::string ToString() const;
+    };
+
+    // Process-wide cache used by Disassembly. Disabled until a directory is set
+    static ShaderDisassemblyCache &GetInstance();
+
+    // Enables the cache in `directory`, creating it if needed. An empty path disables the cache.
+    // Returns false (and leaves the cache disabled) if the directory cannot be created
+    bool SetDirectory(const std::filesystem::path &directory, uint64_t max_size = kDefaultMaxSize);
+    bool IsEnabled() const;
+
+    static Key ComputeKey(const uint8_t *shader_data, size_t size, uint32_t gpu_id);
+
+    // Returns false on a miss, or if the entry is unreadable (in which case it is removed)
+    bool Load(const Key &key, Disassembly::DisassembledData *data);
+    void Store(const Key &key, const Disassembly::DisassembledData &data);
+
+    // Removes the least recently used entries until the directory holds at most `target_size`
+    // bytes of entries
+    void Evict(uint64_t target_size);
+
+private:
+    std::filesystem::path GetEntryPath(const Key &key) const;
+
+    mutable std::mutex    m_mutex;
+    std::filesystem::path m_directory;
+    uint64_t              m_max_size = kDefaultMaxSize;
+
+    // Bytes of entries in the directory, as of the last scan plus what this process stored since.
+    // Other processes sharing the directory are only accounted for on the next scan
+    uint64_t m_total_size = 0;
+};
+
+}  // namespace Dive
@@ -0,0 +1,169 @@
+/*
+ Copyright 2025 Google LLC
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#include "streaming_stats.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include "common.h"
+
+namespace Dive
+{
+
+namespace
+{
+const double kGamma = (1.0 + QuantileSketch::kRelativeAccuracy) /
+                      (1.0 - QuantileSketch::kRelativeAccuracy);
+const double kLogGamma = std::log(kGamma);
+}  // namespace
+
+// =================================================================================================
+// QuantileSketch
+// =================================================================================================
+int32_t QuantileSketch::GetBucketIndex(uint64_t value)
+{
+    return static_cast<int32_t>(std::ceil(std::log(static_cast<double>(value)) / kLogGamma));
+}
+
+//--------------------------------------------------------------------------------------------------
+double QuantileSketch::GetBucketValue(int32_t index)
+{
+    // The value with the same relative error to both bounds of the bucket
+    return 2.0 * std::pow(kGamma, index) / (kGamma + 1.0);
+}
+
+//--------------------------------------------------------------------------------------------------
+void QuantileSketch::AddToBucket(int32_t index, uint64_t count)
+{
+    if (m_buckets.empty())
+    {
+        m_first_bucket = index;
+    }
+    else if (index < m_first_bucket)
+    {
+        m_buckets.insert(m_buckets.begin(), m_first_bucket - index, 0);
+        m_first_bucket = index;
+    }
+    size_t offset = static_cast<size_t>(index - m_first_bucket);
+    if (offset >= m_buckets.size())
+        m_buckets.resize(offset + 1, 0);
+    m_buckets[offset] += count;
+}
+
+//--------------------------------------------------------------------------------------------------
+void QuantileSketch::Add(uint64_t value, uint64_t count)
+{
+    if (value == 0)
+        m_zero_count += count;
+    else
+        AddToBucket(GetBucketIndex(value), count);
+    m_count += count;
+}
+
+//--------------------------------------------------------------------------------------------------
+void QuantileSketch::Merge(const QuantileSketch &other)
+{
+    for (size_t i = 0; i < other.m_buckets.size(); ++i)
+    {
+        if (other.m_buckets[i] != 0)
+            AddToBucket(other.m_first_bucket + static_cast<int32_t>(i), other.m_buckets[i]);
+    }
+    m_zero_count += other.m_zero_count;
+    m_count += other.m_count;
+}
+
+//--------------------------------------------------------------------------------------------------
+double QuantileSketch::GetQuantile(double q) const
+{
+    if (m_count == 0)
+        return 0.0;
+
+    DIVE_ASSERT(q >= 0.0 && q <= 1.0);
+    uint64_t rank = static_cast<uint64_t>(q * static_cast<double>(m_count - 1));
+    if (rank < m_zero_count)
+        return 0.0;
+
+    uint64_t seen = m_zero_count;
+    for (size_t i = 0; i < m_buckets.size(); ++i)
+    {
+        seen += m_buckets[i];
+        if (rank < seen)
+            return GetBucketValue(m_first_bucket + static_cast<int32_t>(i));
+    }
+    return GetBucketValue(m_first_bucket + static_cast<int32_t>(m_buckets.size()) - 1);
+}
+
+// =================================================================================================
+// Log2Histogram
+// =================================================================================================
+void Log2Histogram::Merge(const Log2Histogram &other)
+{
+    for (uint32_t bucket = 0; bucket < kNumBuckets; ++bucket)
+        m_counts[bucket] += other.m_counts[bucket];
+}
+
+//--------------------------------------------------------------------------------------------------
+uint32_t Log2Histogram::GetBucket(uint64_t value)
+{
+    return static_cast<uint32_t>(std::bit_width(value));
+}
+
+//--------------------------------------------------------------------------------------------------
+uint64_t Log2Histogram::GetBucketMin(uint32_t bucket)
+{
+    return bucket == 0 ? 0 : uint64_t(1) << (bucket - 1);
+}
+
+//--------------------------------------------------------------------------------------------------
+uint64_t Log2Histogram::GetBucketMax(uint32_t bucket)
+{
+    return bucket == 0 ? 0 : (GetBucketMin(bucket) - 1) * 2 + 1;
+}
+
+// =================================================================================================
+// StreamingStats
+// =================================================================================================
+void StreamingStats::Add(uint64_t value)
+{
+    m_count++;
+    m_sum += value;
+    m_min = std::min(m_min, value);
+    m_max = std::max(m_max, value);
+    m_sketch.Add(value);
+    m_histogram.Add(value);
+}
+
+//--------------------------------------------------------------------------------------------------
+void StreamingStats::Merge(const StreamingStats &other)
+{
+    m_count += other.m_count;
+    m_sum += other.m_sum;
+    m_min = std::min(m_min, other.m_min);
+    m_max = std::max(m_max, other.m_max);
+    m_sketch.Merge(other.m_sketch);
+    m_histogram.Merge(other.m_histogram);
+}
+
+//--------------------------------------------------------------------------------------------------
+uint64_t StreamingStats::GetQuantile(double q) const
+{
+    if (m_count == 0)
+        return 0;
+    double value = std::round(m_sketch.GetQuantile(q));
+    return std::clamp(static_cast<uint64_t>(value), m_min, m_max);
+}
+
+}  // namespace Dive
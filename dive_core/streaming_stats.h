@@ -0,0 +1,109 @@
+/*
+ Copyright 2025 Google LLC
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+// =====================================================================================================================
+// Single-pass estimators for the distribution of a stream of unsigned values. Their size does not
+// depend on the number of values added, and two instances can be merged, so partial results
+// gathered in parallel combine into the same result as a single pass.
+// =====================================================================================================================
+
+#pragma once
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace Dive
+{
+
+//--------------------------------------------------------------------------------------------------
+// Quantile sketch with bounded relative error (DDSketch). Values are counted in buckets whose
+// bounds grow geometrically, so a quantile is within kRelativeAccuracy of a value of that rank.
+// Buckets are plain counters: merging is exact and does not depend on the order of the values.
+class QuantileSketch
+{
+public:
+    static constexpr double kRelativeAccuracy = 0.01;
+
+    void Add(uint64_t value, uint64_t count = 1);
+    void Merge(const QuantileSketch &other);
+
+    uint64_t GetCount() const { return m_count; }
+
+    // Estimate of the value of rank q * (count - 1) in sorted order, for q in [0, 1]. 0 if empty
+    double GetQuantile(double q) const;
+
+private:
+    static int32_t GetBucketIndex(uint64_t value);
+    static double  GetBucketValue(int32_t index);
+    void           AddToBucket(int32_t index, uint64_t count);
+
+    // m_buckets[i] counts the values of bucket m_first_bucket + i. Bucket k holds the values in
+    // (gamma^(k-1), gamma^k], with gamma = (1 + kRelativeAccuracy) / (1 - kRelativeAccuracy)
+    std::vector<uint64_t> m_buckets;
+    int32_t               m_first_bucket = 0;
+    uint64_t              m_zero_count = 0;
+    uint64_t              m_count = 0;
+};
+
+//--------------------------------------------------------------------------------------------------
+// Counts of values per power-of-two bucket: bucket 0 holds 0, bucket k > 0 holds [2^(k-1), 2^k)
+class Log2Histogram
+{
+public:
+    static constexpr uint32_t kNumBuckets = 65;
+
+    void Add(uint64_t value, uint64_t count = 1) { m_counts[GetBucket(value)] += count; }
+    void Merge(const Log2Histogram &other);
+
+    uint64_t GetCount(uint32_t bucket) const { return m_counts[bucket]; }
+
+    static uint32_t GetBucket(uint64_t value);
+    static uint64_t GetBucketMin(uint32_t bucket);
+    static uint64_t GetBucketMax(uint32_t bucket);  // Inclusive
+
+private:
+    std::array<uint64_t, kNumBuckets> m_counts = {};
+};
+
+//--------------------------------------------------------------------------------------------------
+// Exact count, sum, min and max, plus a quantile sketch and a histogram of the values
+class StreamingStats
+{
+public:
+    void Add(uint64_t value);
+    void Merge(const StreamingStats &other);
+
+    bool     empty() const { return m_count == 0; }
+    uint64_t GetCount() const { return m_count; }
+    uint64_t GetSum() const { return m_sum; }
+    uint64_t GetMin() const { return m_count != 0 ? m_min : 0; }
+    uint64_t GetMax() const { return m_max; }
+
+    // Quantile estimate rounded to the nearest integer and clamped to [GetMin(), GetMax()]
+    uint64_t GetQuantile(double q) const;
+
+    const Log2Histogram &GetHistogram() const { return m_histogram; }
+
+private:
+    uint64_t       m_count = 0;
+    uint64_t       m_sum = 0;
+    uint64_t       m_min = UINT64_MAX;
+    uint64_t       m_max = 0;
+    QuantileSketch m_sketch;
+    Log2Histogram  m_histogram;
+};
+
+}  // namespace Dive
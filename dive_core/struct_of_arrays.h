@@ -14,9 +14,17 @@
  limitations under the License.
 */
 #pragma once
+#include <algorithm>
 #include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <memory>
 #include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "dive_core/common/common.h"
 
 namespace Dive
 {
@@ -320,4 +328,520 @@ public:
         return StructOfArraysConstIterator(left) >= right;
     }
 };
+
+//--------------------------------------------------------------------------------------------------
+// StructOfArraysColumn is a read-only view of one field array (or one element of an array field)
+// of a generated structure-of-array class, e.g. `event_state.DepthTestEnabledColumn()`.
+//
+// For classes with the "isSet" option, only elements whose field was set are valid; unset
+// elements are skipped by every kernel below. The kernels either scan all elements or only those
+// in a `selection` (ascending element indices, e.g. the output of a previous `Filter`), and are
+// written branch-free over contiguous data so that the compiler can vectorize them.
+template<typename T> class StructOfArraysColumn
+{
+public:
+    struct Summary
+    {
+        uint64_t m_count = 0;  // Number of valid elements reduced
+        T        m_min = T();
+        T        m_max = T();
+        double   m_sum = 0;
+    };
+
+    StructOfArraysColumn(const T*       data,
+                         uint32_t       size,
+                         uint32_t       stride,
+                         const uint8_t* is_set_bits,
+                         uint32_t       num_fields,
+                         uint32_t       field_index) :
+        m_data(data),
+        m_size(size),
+        m_stride(stride),
+        m_is_set_bits(is_set_bits),
+        m_num_fields(num_fields),
+        m_field_index(field_index)
+    {
+    }
+
+    inline uint32_t size() const { return m_size; }
+
+    inline T operator[](uint32_t index) const { return m_data[size_t(index) * m_stride]; }
+
+    // `IsSet(index)` reports whether the element is valid. Always true without is-set bits
+    inline bool IsSet(uint32_t index) const
+    {
+        if (m_is_set_bits == nullptr)
+            return true;
+        size_t bit = size_t(index) * m_num_fields + m_field_index;
+        return (m_is_set_bits[bit / 8] >> (bit % 8)) & 1;
+    }
+
+    // `CountWhere(pred)` returns the number of valid elements for which `pred(value)` holds
+    template<typename Pred> uint64_t CountWhere(Pred pred) const
+    {
+        uint64_t count = 0;
+        for (uint32_t i = 0; i < m_size; ++i)
+            count += static_cast<uint64_t>(IsSet(i) & static_cast<bool>(pred((*this)[i])));
+        return count;
+    }
+    template<typename Pred>
+    uint64_t CountWhere(const std::vector<uint32_t>& selection, Pred pred) const
+    {
+        uint64_t count = 0;
+        for (uint32_t i : selection)
+            count += static_cast<uint64_t>(IsSet(i) & static_cast<bool>(pred((*this)[i])));
+        return count;
+    }
+
+    // `Filter(pred)` returns the indices of the valid elements for which `pred(value)` holds
+    template<typename Pred> std::vector<uint32_t> Filter(Pred pred) const
+    {
+        std::vector<uint32_t> indices(m_size);
+        size_t                count = 0;
+        for (uint32_t i = 0; i < m_size; ++i)
+        {
+            indices[count] = i;
+            count += IsSet(i) & static_cast<bool>(pred((*this)[i]));
+        }
+        indices.resize(count);
+        return indices;
+    }
+    template<typename Pred>
+    std::vector<uint32_t> Filter(const std::vector<uint32_t>& selection, Pred pred) const
+    {
+        std::vector<uint32_t> indices(selection.size());
+        size_t                count = 0;
+        for (uint32_t i : selection)
+        {
+            indices[count] = i;
+            count += IsSet(i) & static_cast<bool>(pred((*this)[i]));
+        }
+        indices.resize(count);
+        return indices;
+    }
+
+    // `Reduce()` returns the count, min, max and sum of the valid elements
+    Summary Reduce() const
+    {
+        Summary summary;
+        for (uint32_t i = 0; i < m_size; ++i)
+            Accumulate(i, &summary);
+        return summary;
+    }
+    Summary Reduce(const std::vector<uint32_t>& selection) const
+    {
+        Summary summary;
+        for (uint32_t i : selection)
+            Accumulate(i, &summary);
+        return summary;
+    }
+
+    // `Histogram()` returns the number of valid elements for each distinct value, in ascending
+    // order of value
+    std::vector<std::pair<T, uint64_t>> Histogram() const
+    {
+        std::vector<T> values;
+        for (uint32_t i = 0; i < m_size; ++i)
+            if (IsSet(i))
+                values.push_back((*this)[i]);
+        return CountSorted(&values);
+    }
+    std::vector<std::pair<T, uint64_t>> Histogram(const std::vector<uint32_t>& selection) const
+    {
+        std::vector<T> values;
+        for (uint32_t i : selection)
+            if (IsSet(i))
+                values.push_back((*this)[i]);
+        return CountSorted(&values);
+    }
+
+private:
+    inline void Accumulate(uint32_t index, Summary* summary) const
+    {
+        if (!IsSet(index))
+            return;
+        T value = (*this)[index];
+        if (summary->m_count == 0 || value < summary->m_min)
+            summary->m_min = value;
+        if (summary->m_count == 0 || summary->m_max < value)
+            summary->m_max = value;
+        summary->m_sum += static_cast<double>(value);
+        summary->m_count++;
+    }
+
+    static std::vector<std::pair<T, uint64_t>> CountSorted(std::vector<T>* values)
+    {
+        std::sort(values->begin(), values->end());
+        std::vector<std::pair<T, uint64_t>> histogram;
+        for (const T& value : *values)
+        {
+            if (histogram.empty() || histogram.back().first != value)
+                histogram.emplace_back(value, 0);
+            histogram.back().second++;
+        }
+        return histogram;
+    }
+
+    const T*       m_data;
+    uint32_t       m_size;
+    uint32_t       m_stride;  // In elements; the array count for array fields
+    const uint8_t* m_is_set_bits;
+    uint32_t       m_num_fields;
+    uint32_t       m_field_index;
+};
+
+template<typename T> class StructOfArraysDeltaColumn;
+
+//--------------------------------------------------------------------------------------------------
+// StructOfArraysDeltaStorage is the storage behind the read-only delta-encoded companion classes
+// generated for structure-of-array classes with the "delta" option (e.g. `EventStateInfoDelta`).
+//
+// Every field slot (one per array element for array fields) is kept as a run of changes: the ids
+// at which its value or is-set state differs from the previous element, along with the new value.
+// Consecutive elements that repeat a value cost nothing. Every `keyframe_interval` ids, a keyframe
+// records the change in effect for each slot, so a lookup only searches the changes made within a
+// single keyframe interval.
+class StructOfArraysDeltaStorage
+{
+public:
+    static constexpr uint32_t kDefaultKeyframeInterval = 256;
+
+    // `size()` returns the number of elements encoded
+    inline uint32_t size() const { return m_size; }
+
+    inline bool empty() const { return m_size == 0; }
+
+    inline uint32_t GetKeyframeInterval() const { return m_keyframe_interval; }
+
+    // `GetSlotChanges(slot)` returns the ids at which `slot` changes value or is-set state, in
+    // ascending order. Id 0 is always included when not empty.
+    inline const std::vector<uint32_t>& GetSlotChanges(uint32_t slot) const
+    {
+        return m_slots[slot].m_ids;
+    }
+
+    // `GetMemoryUsage()` returns the number of bytes used by the change runs and keyframes
+    inline size_t GetMemoryUsage() const
+    {
+        size_t num_bytes = m_slots.size() * sizeof(Slot);
+        for (const Slot& slot : m_slots)
+        {
+            num_bytes += slot.m_ids.capacity() * sizeof(uint32_t);
+            num_bytes += slot.m_values.capacity() + slot.m_is_set.capacity();
+            num_bytes += slot.m_keyframes.capacity() * sizeof(uint32_t);
+        }
+        return num_bytes;
+    }
+
+protected:
+    template<typename T> friend class StructOfArraysDeltaColumn;
+
+    struct Slot
+    {
+        size_t                m_elem_size = 0;
+        std::vector<uint32_t> m_ids;        // Ids of the changes, ascending
+        std::vector<uint8_t>  m_values;     // `m_elem_size` bytes per change
+        std::vector<uint8_t>  m_is_set;     // Is-set state per change
+        std::vector<uint32_t> m_keyframes;  // Index into `m_ids` of the change in effect at each
+                                            // multiple of `m_keyframe_interval`
+    };
+
+    inline void Reset(uint32_t num_slots, uint32_t size, uint32_t keyframe_interval)
+    {
+        m_size = size;
+        m_keyframe_interval = std::max(keyframe_interval, 1u);
+        m_slots.clear();
+        m_slots.resize(num_slots);
+    }
+
+    // `EncodeSlot` encodes all elements of `slot`. The value of element `id` is the `elem_size`
+    // bytes at `value_at(id)`, and `is_set(id)` returns its is-set state.
+    template<typename ValueFn, typename IsSetFn>
+    void EncodeSlot(uint32_t slot_index, ValueFn value_at, size_t elem_size, IsSetFn is_set)
+    {
+        Slot& slot = m_slots[slot_index];
+        slot.m_elem_size = elem_size;
+        slot.m_keyframes.reserve((m_size + m_keyframe_interval - 1) / m_keyframe_interval);
+        const uint8_t* prev_value = nullptr;
+        bool           prev_is_set = false;
+        for (uint32_t id = 0; id < m_size; ++id)
+        {
+            const uint8_t* value = value_at(id);
+            bool           value_is_set = is_set(id);
+            if (prev_value == nullptr || value_is_set != prev_is_set ||
+                memcmp(value, prev_value, elem_size) != 0)
+            {
+                slot.m_ids.push_back(id);
+                slot.m_values.insert(slot.m_values.end(), value, value + elem_size);
+                slot.m_is_set.push_back(value_is_set ? 1 : 0);
+                prev_is_set = value_is_set;
+            }
+            prev_value = value;
+            if (id % m_keyframe_interval == 0)
+                slot.m_keyframes.push_back(static_cast<uint32_t>(slot.m_ids.size() - 1));
+        }
+        slot.m_ids.shrink_to_fit();
+        slot.m_values.shrink_to_fit();
+        slot.m_is_set.shrink_to_fit();
+    }
+
+    // `DecodeSlot` is the inverse of `EncodeSlot`: it writes the value of every element of `slot`
+    // to `values + id * stride`, and calls `mark_set(id)` for the elements that are set. If `ids`
+    // is not null, only those elements are decoded, with element `(*ids)[i]` written to position i
+    template<typename MarkSetFn>
+    void DecodeSlot(uint32_t                     slot_index,
+                    const std::vector<uint32_t>* ids,
+                    uint8_t*                     values,
+                    size_t                       stride,
+                    MarkSetFn                    mark_set) const
+    {
+        const Slot& slot = m_slots[slot_index];
+        if (ids != nullptr)
+        {
+            for (uint32_t i = 0; i < ids->size(); ++i)
+            {
+                size_t change = FindChange(slot, (*ids)[i]);
+                memcpy(values + i * stride,
+                       slot.m_values.data() + change * slot.m_elem_size,
+                       slot.m_elem_size);
+                if (slot.m_is_set[change])
+                    mark_set(i);
+            }
+            return;
+        }
+        for (size_t change = 0; change < slot.m_ids.size(); ++change)
+        {
+            uint32_t       end = (change + 1 < slot.m_ids.size()) ? slot.m_ids[change + 1] : m_size;
+            const uint8_t* value = slot.m_values.data() + change * slot.m_elem_size;
+            for (uint32_t id = slot.m_ids[change]; id < end; ++id)
+            {
+                memcpy(values + id * stride, value, slot.m_elem_size);
+                if (slot.m_is_set[change])
+                    mark_set(id);
+            }
+        }
+    }
+
+    // `FindChange` returns the index into `Slot::m_ids` of the change in effect at `id`
+    inline size_t FindChange(const Slot& slot, uint32_t id) const
+    {
+        uint32_t keyframe = id / m_keyframe_interval;
+        auto     first = slot.m_ids.begin() + slot.m_keyframes[keyframe];
+        auto     last = (keyframe + 1 < slot.m_keyframes.size()) ?
+                            slot.m_ids.begin() + slot.m_keyframes[keyframe + 1] + 1 :
+                            slot.m_ids.end();
+        return static_cast<size_t>(std::upper_bound(first, last, id) - slot.m_ids.begin()) - 1;
+    }
+
+    template<typename T> inline T SlotValue(uint32_t slot_index, uint32_t id) const
+    {
+        const Slot& slot = m_slots[slot_index];
+        T           value;
+        static_assert(std::is_trivially_copyable<T>::value,
+                      "Field type must be trivially copyable");
+        memcpy(&value, slot.m_values.data() + FindChange(slot, id) * sizeof(T), sizeof(T));
+        return value;
+    }
+
+    inline bool IsSlotSet(uint32_t slot_index, uint32_t id) const
+    {
+        const Slot& slot = m_slots[slot_index];
+        return slot.m_is_set[FindChange(slot, id)] != 0;
+    }
+
+    template<typename T> inline StructOfArraysDeltaColumn<T> SlotColumn(uint32_t slot_index) const
+    {
+        DIVE_ASSERT(m_slots[slot_index].m_elem_size == sizeof(T));
+        return StructOfArraysDeltaColumn<T>(*this, m_slots[slot_index]);
+    }
+
+    // Number of elements encoded
+    uint32_t m_size = 0;
+
+    // Number of ids between consecutive keyframes
+    uint32_t m_keyframe_interval = kDefaultKeyframeInterval;
+
+    std::vector<Slot> m_slots;
+};
+//--------------------------------------------------------------------------------------------------
+// StructOfArraysDeltaColumn is the StructOfArraysColumn of a delta-encoded class, e.g.
+// `event_state_delta.DepthTestEnabledColumn()`, with the same kernels. They walk the runs of the
+// field instead of its elements: the predicate is evaluated once per run, and a `selection` is
+// split at the run boundaries, so nothing is decoded.
+template<typename T> class StructOfArraysDeltaColumn
+{
+public:
+    using Summary = typename StructOfArraysColumn<T>::Summary;
+
+    StructOfArraysDeltaColumn(const StructOfArraysDeltaStorage&       storage,
+                              const StructOfArraysDeltaStorage::Slot& slot) :
+        m_storage(storage),
+        m_slot(slot)
+    {
+    }
+
+    inline uint32_t size() const { return m_storage.size(); }
+
+    inline T operator[](uint32_t index) const { return Value(m_storage.FindChange(m_slot, index)); }
+
+    // `IsSet(index)` reports whether the element is valid
+    inline bool IsSet(uint32_t index) const
+    {
+        return m_slot.m_is_set[m_storage.FindChange(m_slot, index)] != 0;
+    }
+
+    // `CountWhere(pred)` returns the number of valid elements for which `pred(value)` holds
+    template<typename Pred> uint64_t CountWhere(Pred pred) const
+    {
+        uint64_t count = 0;
+        ForEachRun([&](size_t change, uint32_t begin, uint32_t end) {
+            if (IsRunSet(change) && pred(Value(change)))
+                count += end - begin;
+        });
+        return count;
+    }
+    template<typename Pred>
+    uint64_t CountWhere(const std::vector<uint32_t>& selection, Pred pred) const
+    {
+        uint64_t count = 0;
+        ForEachRun(selection, [&](size_t change, size_t begin, size_t end) {
+            if (IsRunSet(change) && pred(Value(change)))
+                count += end - begin;
+        });
+        return count;
+    }
+
+    // `Filter(pred)` returns the indices of the valid elements for which `pred(value)` holds
+    template<typename Pred> std::vector<uint32_t> Filter(Pred pred) const
+    {
+        std::vector<uint32_t> indices;
+        ForEachRun([&](size_t change, uint32_t begin, uint32_t end) {
+            if (IsRunSet(change) && pred(Value(change)))
+            {
+                for (uint32_t i = begin; i < end; ++i)
+                    indices.push_back(i);
+            }
+        });
+        return indices;
+    }
+    template<typename Pred>
+    std::vector<uint32_t> Filter(const std::vector<uint32_t>& selection, Pred pred) const
+    {
+        std::vector<uint32_t> indices;
+        ForEachRun(selection, [&](size_t change, size_t begin, size_t end) {
+            if (IsRunSet(change) && pred(Value(change)))
+                indices.insert(indices.end(), selection.begin() + begin, selection.begin() + end);
+        });
+        return indices;
+    }
+
+    // `Reduce()` returns the count, min, max and sum of the valid elements
+    Summary Reduce() const
+    {
+        Summary summary;
+        ForEachRun([&](size_t change, uint32_t begin, uint32_t end) {
+            Accumulate(change, end - begin, &summary);
+        });
+        return summary;
+    }
+    Summary Reduce(const std::vector<uint32_t>& selection) const
+    {
+        Summary summary;
+        ForEachRun(selection, [&](size_t change, size_t begin, size_t end) {
+            Accumulate(change, end - begin, &summary);
+        });
+        return summary;
+    }
+
+    // `Histogram()` returns the number of valid elements for each distinct value, in ascending
+    // order of value
+    std::vector<std::pair<T, uint64_t>> Histogram() const
+    {
+        std::vector<std::pair<T, uint64_t>> runs;
+        ForEachRun([&](size_t change, uint32_t begin, uint32_t end) {
+            if (IsRunSet(change))
+                runs.emplace_back(Value(change), end - begin);
+        });
+        return MergeSorted(&runs);
+    }
+    std::vector<std::pair<T, uint64_t>> Histogram(const std::vector<uint32_t>& selection) const
+    {
+        std::vector<std::pair<T, uint64_t>> runs;
+        ForEachRun(selection, [&](size_t change, size_t begin, size_t end) {
+            if (IsRunSet(change))
+                runs.emplace_back(Value(change), end - begin);
+        });
+        return MergeSorted(&runs);
+    }
+
+private:
+    inline T Value(size_t change) const
+    {
+        T value;
+        memcpy(&value, m_slot.m_values.data() + change * sizeof(T), sizeof(T));
+        return value;
+    }
+
+    inline bool IsRunSet(size_t change) const { return m_slot.m_is_set[change] != 0; }
+
+    // Calls `fn(change, begin, end)` for each run, with [begin, end) the elements of the run
+    template<typename Fn> void ForEachRun(Fn fn) const
+    {
+        const std::vector<uint32_t>& ids = m_slot.m_ids;
+        for (size_t change = 0; change < ids.size(); ++change)
+            fn(change, ids[change], (change + 1 < ids.size()) ? ids[change + 1] : size());
+    }
+
+    // Calls `fn(change, begin, end)` for each run holding selected elements, with [begin, end)
+    // the positions in `selection` of the run's elements
+    template<typename Fn> void ForEachRun(const std::vector<uint32_t>& selection, Fn fn) const
+    {
+        const std::vector<uint32_t>& ids = m_slot.m_ids;
+        size_t                       begin = 0;
+        while (begin < selection.size())
+        {
+            size_t   change = m_storage.FindChange(m_slot, selection[begin]);
+            uint32_t run_end = (change + 1 < ids.size()) ? ids[change + 1] : size();
+            size_t   end = static_cast<size_t>(
+            std::lower_bound(selection.begin() + begin, selection.end(), run_end) -
+            selection.begin());
+            fn(change, begin, end);
+            begin = end;
+        }
+    }
+
+    inline void Accumulate(size_t change, uint64_t count, Summary* summary) const
+    {
+        if (!IsRunSet(change) || count == 0)
+            return;
+        T value = Value(change);
+        if (summary->m_count == 0 || value < summary->m_min)
+            summary->m_min = value;
+        if (summary->m_count == 0 || summary->m_max < value)
+            summary->m_max = value;
+        summary->m_sum += static_cast<double>(value) * static_cast<double>(count);
+        summary->m_count += count;
+    }
+
+    // Sorts the (value, count) pairs by value and adds up the counts of equal values
+    static std::vector<std::pair<T, uint64_t>> MergeSorted(
+    std::vector<std::pair<T, uint64_t>>* runs)
+    {
+        std::stable_sort(runs->begin(), runs->end(), [](const auto& a, const auto& b) {
+            return a.first < b.first;
+        });
+        std::vector<std::pair<T, uint64_t>> histogram;
+        for (const auto& [value, count] : *runs)
+        {
+            if (histogram.empty() || histogram.back().first != value)
+                histogram.emplace_back(value, 0);
+            histogram.back().second += count;
+        }
+        return histogram;
+    }
+
+    const StructOfArraysDeltaStorage&       m_storage;
+    const StructOfArraysDeltaStorage::Slot& m_slot;
+};
+
 }  // namespace Dive
\ No newline at end of file
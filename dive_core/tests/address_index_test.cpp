@@ -0,0 +1,125 @@
+/*
+ Copyright 2025 Google LLC
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#include "dive_core/address_index.h"
+#include <algorithm>
+#include <random>
+#include "gtest/gtest.h"
+
+namespace Dive
+{
+namespace
+{
+
+TEST(AddressIndex, MatchesBruteForce)
+{
+    std::mt19937_64           rng(1234);
+    std::vector<AddressRange> ranges;
+    AddressIndex              index;
+    for (uint32_t i = 0; i < 3000; ++i)
+    {
+        uint64_t start = rng() % 100000;
+        uint64_t size = 1 + rng() % (i % 10 == 0 ? 5000 : 100);
+        uint32_t first_event = static_cast<uint32_t>(rng() % 500);
+        AddressRange range = { start, start + size, first_event, first_event + 1,
+                               AddressRangeType::kDescriptors };
+        ranges.push_back(range);
+        index.AddRange(range.m_type, range.m_va_start, range.m_va_end, first_event,
+                       first_event + 1);
+    }
+    index.Build();
+    ASSERT_TRUE(index.IsBuilt());
+    ASSERT_EQ(index.size(), ranges.size());
+
+    for (uint32_t query = 0; query < 500; ++query)
+    {
+        uint64_t va_start = rng() % 110000;
+        uint64_t va_end = va_start + 1 + rng() % 200;
+
+        std::vector<uint32_t> expected;
+        for (const AddressRange &range : ranges)
+        {
+            if (range.m_va_start < va_end && va_start < range.m_va_end)
+                expected.push_back(range.m_first_event);
+        }
+        std::sort(expected.begin(), expected.end());
+        expected.erase(std::unique(expected.begin(), expected.end()), expected.end());
+
+        ASSERT_EQ(index.FindEvents(va_start, va_end), expected) << "query " << query;
+    }
+}
+
+TEST(AddressIndex, ConsecutiveEventsShareARange)
+{
+    AddressIndex index;
+    for (uint32_t event_id = 10; event_id < 20; ++event_id)
+    {
+        index.AddEventReference(AddressRangeType::kShader, 0x1000, 0x1001, event_id);
+        // A second reference from the same event is a no-op
+        index.AddEventReference(AddressRangeType::kShader, 0x1000, 0x1001, event_id);
+    }
+    index.AddEventReference(AddressRangeType::kShader, 0x1000, 0x1001, 25);
+    index.Build();
+
+    ASSERT_EQ(index.size(), 2u);
+    EXPECT_EQ(index.GetRange(0).m_first_event, 10u);
+    EXPECT_EQ(index.GetRange(0).m_end_event, 20u);
+    EXPECT_EQ(index.GetRange(1).m_first_event, 25u);
+
+    std::vector<uint32_t> events = index.FindEvents(0x1000, 0x1001);
+    ASSERT_EQ(events.size(), 11u);
+    EXPECT_EQ(events.front(), 10u);
+    EXPECT_EQ(events.back(), 25u);
+    EXPECT_TRUE(index.FindEvents(0x1001, 0x2000).empty());
+}
+
+TEST(AddressIndex, FiltersByType)
+{
+    AddressIndex index;
+    index.AddEventReference(AddressRangeType::kIndexBuffer, 0x2000, 0x3000, 1);
+    index.AddEventReference(AddressRangeType::kDescriptors, 0x2800, 0x2900, 2);
+    index.AddRange(AddressRangeType::kIndirectBuffer, 0x0, 0x10000, 0, 4);
+    // An indirect buffer that issued no events
+    index.AddRange(AddressRangeType::kIndirectBuffer, 0x2400, 0x2500, 3, 3);
+    index.Build();
+
+    EXPECT_EQ(index.FindEvents(0x2880, 0x2881), (std::vector<uint32_t>{ 0, 1, 2, 3 }));
+    EXPECT_EQ(index.FindEvents(0x2880, 0x2881, AddressRangeType::kDescriptors),
+              (std::vector<uint32_t>{ 2 }));
+    EXPECT_EQ(index.FindEvents(0x2000, 0x2001, AddressRangeType::kIndexBuffer),
+              (std::vector<uint32_t>{ 1 }));
+    EXPECT_TRUE(index.FindEvents(0x2400, 0x2500, AddressRangeType::kShader).empty());
+
+    std::vector<uint32_t> range_indices;
+    index.FindOverlapping(0x2450, 0x2460, &range_indices);
+    EXPECT_EQ(range_indices.size(), 3u);
+}
+
+TEST(AddressIndex, EmptyIndex)
+{
+    AddressIndex index;
+    index.Build();
+    EXPECT_TRUE(index.FindEvents(0, UINT64_MAX).empty());
+
+    index.Clear();
+    EXPECT_FALSE(index.IsBuilt());
+    index.AddEventReference(AddressRangeType::kShader, 0x40, 0x41, 7);
+    index.Build();
+    EXPECT_EQ(index.FindEvents(0, UINT64_MAX), (std::vector<uint32_t>{ 7 }));
+}
+
+}  // namespace
+}  // namespace Dive
@@ -0,0 +1,235 @@
+/*
+ Copyright 2025 Google LLC
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#include "dive_core/command_hierarchy_file.h"
+
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "pm4_info.h"
+#include "pm4_test_stream.h"
+
+namespace Dive
+{
+namespace
+{
+
+class CommandHierarchyFileTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        Pm4InfoInit();
+
+        std::vector<uint32_t>   dwords = test::CreateNopAndWaitStream(64);
+        CommandHierarchyCreator creator(m_command_hierarchy, m_capture_data);
+        ASSERT_TRUE(creator.CreateTrees(EngineType::kUniversal,
+                                        QueueType::kUniversal,
+                                        dwords,
+                                        static_cast<uint32_t>(dwords.size())));
+
+        m_file_name = (std::filesystem::temp_directory_path() /
+                       ("command_hierarchy_file_test_" +
+                        std::string(::testing::UnitTest::GetInstance()->current_test_info()->name()) +
+                        ".bin"))
+                      .string();
+    }
+
+    void TearDown() override { std::filesystem::remove(m_file_name); }
+
+    static void ExpectSameTopology(const SharedNodeTopology &expected,
+                                   const SharedNodeTopology &actual)
+    {
+        ASSERT_EQ(expected.GetNumNodes(), actual.GetNumNodes());
+        for (uint64_t node = 0; node < expected.GetNumNodes(); ++node)
+        {
+            EXPECT_EQ(expected.GetParentNodeIndex(node), actual.GetParentNodeIndex(node));
+            EXPECT_EQ(expected.GetChildIndex(node), actual.GetChildIndex(node));
+            ASSERT_EQ(expected.GetNumChildren(node), actual.GetNumChildren(node));
+            for (uint64_t child = 0; child < expected.GetNumChildren(node); ++child)
+            {
+                EXPECT_EQ(expected.GetChildNodeIndex(node, child),
+                          actual.GetChildNodeIndex(node, child));
+            }
+            ASSERT_EQ(expected.GetNumSharedChildren(node), actual.GetNumSharedChildren(node));
+            for (uint64_t child = 0; child < expected.GetNumSharedChildren(node); ++child)
+            {
+                EXPECT_EQ(expected.GetSharedChildNodeIndex(node, child),
+                          actual.GetSharedChildNodeIndex(node, child));
+            }
+        }
+    }
+
+    static void ExpectSameTopology(const SharedNodeTopology            &expected,
+                                   const MappedCommandHierarchy         &mapped,
+                                   MappedCommandHierarchy::TopologyType type)
+    {
+        for (uint64_t node = 0; node < expected.GetNumNodes(); ++node)
+        {
+            EXPECT_EQ(expected.GetParentNodeIndex(node), mapped.GetParentNodeIndex(type, node));
+            ASSERT_EQ(expected.GetNumChildren(node), mapped.GetNumChildren(type, node));
+            for (uint64_t child = 0; child < expected.GetNumChildren(node); ++child)
+            {
+                EXPECT_EQ(expected.GetChildNodeIndex(node, child),
+                          mapped.GetChildNodeIndex(type, node, child));
+            }
+            ASSERT_EQ(expected.GetNumSharedChildren(node), mapped.GetNumSharedChildren(type, node));
+            for (uint64_t child = 0; child < expected.GetNumSharedChildren(node); ++child)
+            {
+                EXPECT_EQ(expected.GetSharedChildNodeIndex(node, child),
+                          mapped.GetSharedChildNodeIndex(type, node, child));
+            }
+        }
+    }
+
+    static constexpr uint32_t kChildrenListSection = CommandHierarchyFile::TopologySectionIndex(
+    MappedCommandHierarchy::kSubmitTopology,
+    CommandHierarchyFile::kChildrenList);
+    static constexpr uint32_t kNodeChildrenSection = CommandHierarchyFile::TopologySectionIndex(
+    MappedCommandHierarchy::kSubmitTopology,
+    CommandHierarchyFile::kNodeChildren);
+
+    // Overwrites element `index` of `section` in the saved file, viewed as an array of T
+    template<typename T> void Patch(uint32_t section, uint64_t index, T value)
+    {
+        std::fstream file(m_file_name, std::ios::in | std::ios::out | std::ios::binary);
+        CommandHierarchyFile::SectionInfo info;
+        file.seekg(CommandHierarchyFile::kSectionTableOffset + section * sizeof(info));
+        file.read(reinterpret_cast<char *>(&info), sizeof(info));
+        ASSERT_LT(index * sizeof(T), info.m_size);
+        file.seekp(info.m_offset + index * sizeof(T));
+        file.write(reinterpret_cast<const char *>(&value), sizeof(T));
+    }
+
+    // Saves the hierarchy, applies `patch` to the file and expects opening it to fail
+    template<typename Fn> void ExpectRejected(Fn patch)
+    {
+        ASSERT_TRUE(CommandHierarchyFile::Save(m_command_hierarchy, m_file_name.c_str()));
+        patch();
+        MappedCommandHierarchy mapped;
+        EXPECT_FALSE(mapped.Open(m_file_name.c_str()));
+        CommandHierarchy loaded;
+        EXPECT_FALSE(CommandHierarchyFile::Load(m_file_name.c_str(), loaded));
+    }
+
+    Pm4CaptureData   m_capture_data;
+    CommandHierarchy m_command_hierarchy;
+    std::string      m_file_name;
+};
+
+TEST_F(CommandHierarchyFileTest, RoundTrip)
+{
+    ASSERT_GT(m_command_hierarchy.size(), 1u);
+    ASSERT_TRUE(CommandHierarchyFile::Save(m_command_hierarchy, m_file_name.c_str()));
+
+    CommandHierarchy loaded;
+    ASSERT_TRUE(CommandHierarchyFile::Load(m_file_name.c_str(), loaded));
+    ASSERT_EQ(m_command_hierarchy.size(), loaded.size());
+    for (uint64_t node = 0; node < m_command_hierarchy.size(); ++node)
+    {
+        EXPECT_EQ(m_command_hierarchy.GetNodeType(node), loaded.GetNodeType(node));
+        EXPECT_STREQ(m_command_hierarchy.GetNodeDesc(node), loaded.GetNodeDesc(node));
+        EXPECT_EQ(m_command_hierarchy.GetEventIndex(node), loaded.GetEventIndex(node));
+    }
+    ExpectSameTopology(m_command_hierarchy.GetSubmitHierarchyTopology(),
+                       loaded.GetSubmitHierarchyTopology());
+    ExpectSameTopology(m_command_hierarchy.GetAllEventHierarchyTopology(),
+                       loaded.GetAllEventHierarchyTopology());
+    for (uint32_t filter = 0; filter < CommandHierarchy::kFilterListTypeCount; ++filter)
+    {
+        auto filter_type = static_cast<CommandHierarchy::FilterListType>(filter);
+        EXPECT_EQ(m_command_hierarchy.GetFilterExcludeIndices(filter_type),
+                  loaded.GetFilterExcludeIndices(filter_type));
+    }
+}
+
+TEST_F(CommandHierarchyFileTest, MappedMatchesSource)
+{
+    ASSERT_TRUE(CommandHierarchyFile::Save(m_command_hierarchy, m_file_name.c_str()));
+
+    MappedCommandHierarchy mapped;
+    ASSERT_TRUE(mapped.Open(m_file_name.c_str()));
+    ASSERT_EQ(m_command_hierarchy.size(), mapped.size());
+    for (uint64_t node = 0; node < m_command_hierarchy.size(); ++node)
+    {
+        EXPECT_EQ(m_command_hierarchy.GetNodeType(node), mapped.GetNodeType(node));
+        EXPECT_STREQ(m_command_hierarchy.GetNodeDesc(node), mapped.GetNodeDesc(node));
+    }
+    ExpectSameTopology(m_command_hierarchy.GetSubmitHierarchyTopology(),
+                       mapped,
+                       MappedCommandHierarchy::kSubmitTopology);
+    ExpectSameTopology(m_command_hierarchy.GetAllEventHierarchyTopology(),
+                       mapped,
+                       MappedCommandHierarchy::kAllEventTopology);
+    mapped.Close();
+    EXPECT_FALSE(mapped.IsOpen());
+    EXPECT_EQ(mapped.size(), 0u);
+}
+
+TEST_F(CommandHierarchyFileTest, RejectsCorruptFile)
+{
+    ASSERT_TRUE(CommandHierarchyFile::Save(m_command_hierarchy, m_file_name.c_str()));
+
+    // Bad magic
+    {
+        std::fstream file(m_file_name, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(0);
+        file.put('X');
+    }
+    MappedCommandHierarchy mapped;
+    EXPECT_FALSE(mapped.Open(m_file_name.c_str()));
+
+    // Truncated
+    ASSERT_TRUE(CommandHierarchyFile::Save(m_command_hierarchy, m_file_name.c_str()));
+    std::filesystem::resize_file(m_file_name, std::filesystem::file_size(m_file_name) / 2);
+    EXPECT_FALSE(mapped.Open(m_file_name.c_str()));
+
+    CommandHierarchy loaded;
+    EXPECT_FALSE(CommandHierarchyFile::Load(m_file_name.c_str(), loaded));
+    EXPECT_FALSE(mapped.Open("this_file_does_not_exist.bin"));
+}
+
+TEST_F(CommandHierarchyFileTest, RejectsCorruptSections)
+{
+    const uint64_t num_nodes = m_command_hierarchy.size();
+    ASSERT_GT(num_nodes, 1u);
+    ASSERT_GT(m_command_hierarchy.GetSubmitHierarchyTopology().GetNumChildren(0), 0u);
+
+    // Description offsets going backwards
+    ExpectRejected([&]() { Patch<uint64_t>(CommandHierarchyFile::kDescOffsets, 1, 0); });
+
+    // Last description not null-terminated
+    uint64_t desc_size = 0;
+    for (uint64_t node = 0; node < num_nodes; ++node)
+        desc_size += strlen(m_command_hierarchy.GetNodeDesc(node)) + 1;
+    ExpectRejected([&]() { Patch<char>(CommandHierarchyFile::kDescData, desc_size - 1, 'X'); });
+
+    // Children range running past the end of the children list
+    ExpectRejected([&]() {
+        Patch<uint64_t>(kNodeChildrenSection, 1, UINT64_MAX);  // Node 0's m_num_children
+    });
+
+    // Child index that isn't a node
+    ExpectRejected([&]() { Patch<uint64_t>(kChildrenListSection, 0, num_nodes); });
+}
+
+}  // namespace
+}  // namespace Dive
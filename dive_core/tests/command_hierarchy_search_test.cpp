@@ -0,0 +1,128 @@
+/*
+ Copyright 2025 Google LLC
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#include "dive_core/command_hierarchy_search.h"
+
+#include <algorithm>
+#include <cctype>
+#include <regex>
+#include <string>
+#include <vector>
+
+#include "dive_core/command_hierarchy.h"
+#include "gtest/gtest.h"
+#include "pm4_info.h"
+#include "pm4_test_stream.h"
+
+namespace Dive
+{
+namespace
+{
+
+std::string ToLower(std::string text)
+{
+    std::transform(text.begin(), text.end(), text.begin(), [](unsigned char c) {
+        return static_cast<char>(std::tolower(c));
+    });
+    return text;
+}
+
+class CommandHierarchySearchTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        Pm4InfoInit();
+
+        std::vector<uint32_t>   dwords = test::CreateNopAndWaitStream(256);
+        CommandHierarchyCreator creator(m_command_hierarchy, m_capture_data);
+        ASSERT_TRUE(creator.CreateTrees(EngineType::kUniversal,
+                                        QueueType::kUniversal,
+                                        dwords,
+                                        static_cast<uint32_t>(dwords.size())));
+        m_search_index.Build(m_command_hierarchy);
+    }
+
+    template<typename Pred> std::vector<uint64_t> BruteForce(Pred pred) const
+    {
+        std::vector<uint64_t> result;
+        for (uint64_t node = 0; node < m_command_hierarchy.size(); ++node)
+        {
+            if (pred(node))
+                result.push_back(node);
+        }
+        return result;
+    }
+
+    Pm4CaptureData              m_capture_data;
+    CommandHierarchy            m_command_hierarchy;
+    CommandHierarchySearchIndex m_search_index;
+};
+
+TEST_F(CommandHierarchySearchTest, SubstringAndPrefixMatchLinearScan)
+{
+    ASSERT_EQ(m_search_index.size(), m_command_hierarchy.size());
+    for (const char *query : { "cp_", "NOP", "wait_for_idle", "Wait_For", "e", "ib", "no match" })
+    {
+        std::string lowered = ToLower(query);
+        EXPECT_EQ(m_search_index.FindSubstring(query), BruteForce([&](uint64_t node) {
+                      return ToLower(m_command_hierarchy.GetNodeDesc(node)).find(lowered) !=
+                             std::string::npos;
+                  })) << query;
+        EXPECT_EQ(m_search_index.FindPrefix(query), BruteForce([&](uint64_t node) {
+                      return ToLower(m_command_hierarchy.GetNodeDesc(node)).rfind(lowered, 0) == 0;
+                  })) << query;
+    }
+    EXPECT_FALSE(m_search_index.FindSubstring("cp_wait").empty());
+}
+
+TEST_F(CommandHierarchySearchTest, RegexMatchesLinearScan)
+{
+    for (const char *pattern : { "^cp_nop", "wait_for_(idle|me)", "CP_WAIT_FOR_M?E", "[0-9]+" })
+    {
+        std::regex            regex(pattern, std::regex::ECMAScript | std::regex::icase);
+        std::vector<uint64_t> nodes;
+        ASSERT_TRUE(m_search_index.FindRegex(pattern, &nodes)) << pattern;
+        EXPECT_EQ(nodes, BruteForce([&](uint64_t node) {
+                      return std::regex_search(m_command_hierarchy.GetNodeDesc(node), regex);
+                  })) << pattern;
+    }
+
+    std::vector<uint64_t> nodes;
+    EXPECT_FALSE(m_search_index.FindRegex("(unbalanced", &nodes));
+}
+
+TEST_F(CommandHierarchySearchTest, TypedLookups)
+{
+    const std::vector<uint64_t> &nops = m_search_index.FindByOpcode(CP_NOP);
+    EXPECT_EQ(nops, BruteForce([&](uint64_t node) {
+                  return m_command_hierarchy.GetNodeType(node) == NodeType::kPacketNode &&
+                         m_command_hierarchy.GetPacketNodeOpcode(node) == CP_NOP;
+              }));
+    EXPECT_FALSE(nops.empty());
+
+    for (uint64_t node = 0; node < m_command_hierarchy.size(); ++node)
+    {
+        size_t event_id = m_command_hierarchy.GetEventIndex(node);
+        if (event_id != 0)
+            EXPECT_EQ(m_search_index.FindByEventId(event_id), node);
+    }
+    EXPECT_EQ(m_search_index.FindByEventId(0), UINT64_MAX);
+    EXPECT_TRUE(m_search_index.FindByRegisterName("NOT_A_REGISTER").empty());
+}
+
+}  // namespace
+}  // namespace Dive
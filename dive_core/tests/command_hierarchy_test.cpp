@@ -0,0 +1,157 @@
+/*
+ Copyright 2025 Google LLC
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#include "dive_core/command_hierarchy.h"
+
+#include <unordered_set>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "pm4_info.h"
+#include "pm4_test_stream.h"
+
+namespace Dive
+{
+namespace
+{
+
+void CreateHierarchy(CommandHierarchy &command_hierarchy, bool parallel_topologies)
+{
+    Pm4CaptureData          capture_data;
+    std::vector<uint32_t>   dwords = test::CreateNopAndWaitStream(2048);
+    CommandHierarchyCreator creator(command_hierarchy, capture_data);
+    creator.SetParallelTopologies(parallel_topologies);
+    ASSERT_TRUE(creator.CreateTrees(EngineType::kUniversal,
+                                    QueueType::kUniversal,
+                                    dwords,
+                                    static_cast<uint32_t>(dwords.size())));
+}
+
+void ExpectIdenticalTopology(const SharedNodeTopology &serial, const SharedNodeTopology &parallel)
+{
+    ASSERT_EQ(serial.GetNumNodes(), parallel.GetNumNodes());
+    for (uint64_t node = 0; node < serial.GetNumNodes(); ++node)
+    {
+        ASSERT_EQ(serial.GetParentNodeIndex(node), parallel.GetParentNodeIndex(node));
+        ASSERT_EQ(serial.GetChildIndex(node), parallel.GetChildIndex(node));
+        ASSERT_EQ(serial.GetNumChildren(node), parallel.GetNumChildren(node));
+        for (uint64_t child = 0; child < serial.GetNumChildren(node); ++child)
+        {
+            ASSERT_EQ(serial.GetChildNodeIndex(node, child),
+                      parallel.GetChildNodeIndex(node, child));
+        }
+        ASSERT_EQ(serial.GetNumSharedChildren(node), parallel.GetNumSharedChildren(node));
+        for (uint64_t child = 0; child < serial.GetNumSharedChildren(node); ++child)
+        {
+            ASSERT_EQ(serial.GetSharedChildNodeIndex(node, child),
+                      parallel.GetSharedChildNodeIndex(node, child));
+        }
+        ASSERT_EQ(serial.GetStartSharedChildNodeIndex(node),
+                  parallel.GetStartSharedChildNodeIndex(node));
+        ASSERT_EQ(serial.GetEndSharedChildNodeIndex(node),
+                  parallel.GetEndSharedChildNodeIndex(node));
+        ASSERT_EQ(serial.GetSharedChildRootNodeIndex(node),
+                  parallel.GetSharedChildRootNodeIndex(node));
+    }
+}
+
+TEST(CommandHierarchy, ParallelTopologiesMatchSerial)
+{
+    Pm4InfoInit();
+
+    CommandHierarchy serial;
+    CommandHierarchy parallel;
+    CreateHierarchy(serial, false);
+    CreateHierarchy(parallel, true);
+
+    ASSERT_GT(serial.size(), 1u);
+    ASSERT_EQ(serial.size(), parallel.size());
+    for (uint64_t node = 0; node < serial.size(); ++node)
+    {
+        ASSERT_EQ(serial.GetNodeType(node), parallel.GetNodeType(node));
+        ASSERT_STREQ(serial.GetNodeDesc(node), parallel.GetNodeDesc(node));
+    }
+    ExpectIdenticalTopology(serial.GetSubmitHierarchyTopology(),
+                            parallel.GetSubmitHierarchyTopology());
+    ExpectIdenticalTopology(serial.GetAllEventHierarchyTopology(),
+                            parallel.GetAllEventHierarchyTopology());
+    for (uint32_t filter = 0; filter < CommandHierarchy::kFilterListTypeCount; ++filter)
+    {
+        auto filter_type = static_cast<CommandHierarchy::FilterListType>(filter);
+        EXPECT_EQ(serial.GetFilterExcludeIndices(filter_type),
+                  parallel.GetFilterExcludeIndices(filter_type));
+    }
+}
+
+void ExpectFilteredMatchesExcludeList(const SharedNodeTopology           &topology,
+                                      const FilteredTopology             &filtered,
+                                      const std::unordered_set<uint64_t> &exclude_indices)
+{
+    for (uint64_t node = 0; node < topology.GetNumNodes(); ++node)
+    {
+        std::vector<uint64_t> visible;
+        for (uint64_t child = 0; child < topology.GetNumChildren(node); ++child)
+        {
+            uint64_t child_node = topology.GetChildNodeIndex(node, child);
+            if (exclude_indices.count(child_node) == 0)
+                visible.push_back(child_node);
+        }
+        ASSERT_EQ(filtered.GetNumChildren(node), visible.size());
+        for (uint64_t child = 0; child < visible.size(); ++child)
+        {
+            EXPECT_EQ(filtered.GetChildNodeIndex(node, child), visible[child]);
+            EXPECT_EQ(filtered.GetChildIndex(visible[child]), child);
+        }
+        EXPECT_EQ(filtered.IsExcluded(node), exclude_indices.count(node) != 0);
+    }
+}
+
+TEST(CommandHierarchy, FilteredTopologiesMatchExcludeLists)
+{
+    Pm4InfoInit();
+
+    CommandHierarchy        command_hierarchy;
+    Pm4CaptureData          capture_data;
+    std::vector<uint32_t>   dwords = test::CreateBinnedPassStream(4);
+    CommandHierarchyCreator creator(command_hierarchy, capture_data);
+    ASSERT_TRUE(creator.CreateTrees(EngineType::kUniversal,
+                                    QueueType::kUniversal,
+                                    dwords,
+                                    static_cast<uint32_t>(dwords.size())));
+
+    for (uint32_t filter = 0; filter < CommandHierarchy::kFilterListTypeCount; ++filter)
+    {
+        auto        filter_type = static_cast<CommandHierarchy::FilterListType>(filter);
+        const auto &exclude_indices = command_hierarchy.GetFilterExcludeIndices(filter_type);
+        EXPECT_FALSE(exclude_indices.empty());
+        for (uint64_t node = 0; node < command_hierarchy.size(); ++node)
+        {
+            EXPECT_EQ(command_hierarchy.IsFilterExcluded(filter_type, node),
+                      exclude_indices.count(node) != 0);
+        }
+        ExpectFilteredMatchesExcludeList(command_hierarchy.GetSubmitHierarchyTopology(),
+                                         command_hierarchy.GetFilteredSubmitHierarchyTopology(
+                                         filter_type),
+                                         exclude_indices);
+        ExpectFilteredMatchesExcludeList(command_hierarchy.GetAllEventHierarchyTopology(),
+                                         command_hierarchy.GetFilteredAllEventHierarchyTopology(
+                                         filter_type),
+                                         exclude_indices);
+    }
+}
+
+}  // namespace
+}  // namespace Dive
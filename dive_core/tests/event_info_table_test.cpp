@@ -0,0 +1,133 @@
+/*
+ Copyright 2025 Google LLC
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#include <string>
+
+#include "dive_core/capture_event_info.h"
+#include "gtest/gtest.h"
+
+namespace Dive
+{
+namespace
+{
+
+constexpr uint32_t kNumEvents = 100;
+
+// Event i has i % 4 shader references, and i % 3 buffer indices for both the VS and the PS
+EventInfoTable CreateTable()
+{
+    EventInfoTable table;
+    for (uint32_t i = 0; i < kNumEvents; ++i)
+    {
+        EventInfo info = {};
+        info.m_submit_index = i;
+        info.m_type = EventInfo::EventType::kDraw;
+        table.push_back(info, "Draw" + std::to_string(i));
+
+        for (uint32_t ref = 0; ref < i % 4; ++ref)
+        {
+            ShaderReference reference;
+            reference.m_shader_index = i * 10 + ref;
+            reference.m_stage = ShaderStage::kShaderStagePs;
+            reference.m_enable_mask = 1;
+            table.AddShaderReference(reference);
+        }
+        // Buffer indices are added in stage order, and kShaderStagePs < kShaderStageVs
+        for (uint32_t buffer = 0; buffer < i % 3; ++buffer)
+            table.AddBufferIndex(ShaderStage::kShaderStagePs, i * 1000 + buffer);
+        for (uint32_t buffer = 0; buffer < i % 3; ++buffer)
+            table.AddBufferIndex(ShaderStage::kShaderStageVs, i * 100 + buffer);
+    }
+    return table;
+}
+
+TEST(EventInfoTable, ListsPerEvent)
+{
+    EventInfoTable table = CreateTable();
+    ASSERT_EQ(table.size(), kNumEvents);
+
+    for (uint32_t i = 0; i < kNumEvents; ++i)
+    {
+        EXPECT_EQ(table[i].m_submit_index, i);
+        EXPECT_EQ(table.GetString(i), "Draw" + std::to_string(i));
+
+        std::span<const ShaderReference> refs = table.GetShaderReferences(i);
+        ASSERT_EQ(refs.size(), i % 4);
+        for (uint32_t ref = 0; ref < refs.size(); ++ref)
+            EXPECT_EQ(refs[ref].m_shader_index, i * 10 + ref);
+
+        std::span<const uint32_t> vs = table.GetBufferIndices(i, ShaderStage::kShaderStageVs);
+        std::span<const uint32_t> ps = table.GetBufferIndices(i, ShaderStage::kShaderStagePs);
+        std::span<const uint32_t> cs = table.GetBufferIndices(i, ShaderStage::kShaderStageCs);
+        ASSERT_EQ(vs.size(), i % 3);
+        ASSERT_EQ(ps.size(), i % 3);
+        EXPECT_TRUE(cs.empty());
+        for (uint32_t buffer = 0; buffer < vs.size(); ++buffer)
+        {
+            EXPECT_EQ(vs[buffer], i * 100 + buffer);
+            EXPECT_EQ(ps[buffer], i * 1000 + buffer);
+        }
+    }
+}
+
+TEST(EventInfoTable, UpdateShaderReferenceInPlace)
+{
+    EventInfoTable table = CreateTable();
+    table.GetShaderReferences(7)[1].m_enable_mask |= 4;
+
+    EXPECT_EQ(table.GetShaderReferences(7)[1].m_enable_mask, 5u);
+    EXPECT_EQ(table.GetShaderReferences(7)[0].m_enable_mask, 1u);
+    EXPECT_EQ(table.GetShaderReferences(6)[1].m_enable_mask, 1u);
+}
+
+TEST(EventInfoTable, MetadataLogBelongsToLastEvent)
+{
+    EventInfoTable table;
+    table.push_back(EventInfo{});
+    table.push_back(EventInfo{});
+
+    ILog::LogEntry entry = {};
+    entry.m_short_desc = "first";
+    table.GetMetadataLog()->Log(entry);
+    table.GetMetadataLog()->Log(entry);
+    table.push_back(EventInfo{});
+    entry.m_short_desc = "second";
+    table.GetMetadataLog()->Log(entry);
+
+    EXPECT_EQ(table.GetNumMetadataLogEntries(0), 0u);
+    EXPECT_EQ(table.GetNumMetadataLogEntries(1), 2u);
+    EXPECT_EQ(table.GetNumMetadataLogEntries(2), 1u);
+
+    LogRecord record;
+    table.LogMetadataEntriesTo(2, LogAssociation::kEvent, 2, record);
+    ASSERT_EQ(record.GetNumEntries(), 1u);
+    EXPECT_EQ(record.GetEntry(0).m_short_desc, "second");
+}
+
+TEST(EventInfoTable, Clear)
+{
+    EventInfoTable table = CreateTable();
+    table.clear();
+    EXPECT_TRUE(table.empty());
+
+    table.push_back(EventInfo{}, "Dispatch");
+    EXPECT_EQ(table.GetString(0), "Dispatch");
+    EXPECT_TRUE(table.GetShaderReferences(0).empty());
+    EXPECT_TRUE(table.GetBufferIndices(0, ShaderStage::kShaderStageVs).empty());
+}
+
+}  // namespace
+}  // namespace Dive
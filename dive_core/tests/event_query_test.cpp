@@ -0,0 +1,154 @@
+/*
+ Copyright 2025 Google LLC
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#include "dive_core/event_query.h"
+
+#include <cmath>
+#include <memory>
+
+#include "dive_core/data_core.h"
+#include "gtest/gtest.h"
+
+namespace Dive
+{
+namespace
+{
+
+constexpr uint32_t kNumEvents = 1000;
+
+// Draws on 2 of every 3 events, with blending on odd events and depth test on every 5th one.
+// Dispatches never set any state.
+std::unique_ptr<CaptureMetadata> CreateMetadata()
+{
+    auto           metadata = std::make_unique<CaptureMetadata>();
+    EventStateInfo event_state;
+    for (uint32_t i = 0; i < kNumEvents; ++i)
+    {
+        EventInfo info = {};
+        info.m_submit_index = i % 4;
+        info.m_type = (i % 3) ? EventInfo::EventType::kDraw : EventInfo::EventType::kDispatch;
+        info.m_num_indices = i * 20;
+        metadata->m_event_info.push_back(info);
+
+        EventStateInfo::Iterator it = event_state.Add();
+        if (info.m_type == EventInfo::EventType::kDraw)
+        {
+            VkPipelineColorBlendAttachmentState attachment = {};
+            attachment.blendEnable = (i % 2) ? VK_TRUE : VK_FALSE;
+            it->SetAttachment(0, attachment);
+            it->SetDepthTestEnabled(i % 5 == 0);
+        }
+    }
+    metadata->m_event_state.Encode(event_state);
+    return metadata;
+}
+
+TEST(EventQuery, FiltersAreAnded)
+{
+    std::unique_ptr<CaptureMetadata> metadata = CreateMetadata();
+    EventQuery                       query(*metadata);
+    ASSERT_TRUE(query.AddFilter("type==draw"));
+    ASSERT_TRUE(query.AddFilter("blend_enabled = true"));
+    ASSERT_TRUE(query.AddFilter("num_indices>10000"));
+    ASSERT_TRUE(query.AddFilter("submit==3"));
+    ASSERT_TRUE(query.AddProjection("num_indices"));
+    ASSERT_TRUE(query.AddProjection("type"));
+
+    EventQueryResult result;
+    query.Run(&result);
+    ASSERT_EQ(result.m_columns.size(), 2u);
+    EXPECT_EQ(result.m_columns[0], "num_indices");
+
+    std::vector<uint32_t> expected;
+    for (uint32_t i = 0; i < kNumEvents; ++i)
+    {
+        if ((i % 3) && (i % 2) && i * 20 > 10000 && i % 4 == 3)
+            expected.push_back(i);
+    }
+    ASSERT_EQ(result.m_event_ids, expected);
+    for (size_t row = 0; row < expected.size(); ++row)
+    {
+        EXPECT_EQ(result.m_values[0][row], expected[row] * 20.0);
+        EXPECT_EQ(EventQuery::FormatValue(EventQuery::FindColumn("type"), result.m_values[1][row]),
+                  "draw");
+    }
+}
+
+TEST(EventQuery, UnsetStateNeverMatches)
+{
+    std::unique_ptr<CaptureMetadata> metadata = CreateMetadata();
+    EventQuery                       query(*metadata);
+    ASSERT_TRUE(query.AddFilter("depth_test_enabled != 1"));
+    ASSERT_TRUE(query.AddProjection("depth_test_enabled"));
+
+    EventQueryResult result;
+    query.Run(&result);
+    uint32_t expected = 0;
+    for (uint32_t i = 0; i < kNumEvents; ++i)
+    {
+        if ((i % 3) && (i % 5))
+            ++expected;
+    }
+    EXPECT_EQ(result.m_event_ids.size(), expected);
+
+    // Without filters, every event is returned and dispatches read as unset
+    query.ClearFilters();
+    query.Run(&result);
+    ASSERT_EQ(result.m_event_ids.size(), kNumEvents);
+    EXPECT_TRUE(std::isnan(result.m_values[0][0]));
+    EXPECT_EQ(EventQuery::FormatValue(EventQuery::FindColumn("depth_test_enabled"),
+                                      result.m_values[0][0]),
+              "-");
+}
+
+TEST(EventQuery, StateColumnsMatchEventState)
+{
+    std::unique_ptr<CaptureMetadata> metadata = CreateMetadata();
+    EventStateInfo                   event_state;
+    metadata->m_event_state.Decode(&event_state);
+
+    EventQuery query(*metadata);
+    EXPECT_FALSE(EventQuery::IsStateColumn(EventQuery::FindColumn("submit")));
+    EXPECT_TRUE(EventQuery::IsStateColumn(EventQuery::FindColumn("blend_enabled")));
+    uint32_t column = EventQuery::FindColumn("depth_test_enabled");
+    ASSERT_TRUE(EventQuery::IsStateColumn(column));
+
+    const std::vector<double> &values = query.GetColumn(column);
+    ASSERT_EQ(values.size(), kNumEvents);
+    for (uint32_t i = 0; i < kNumEvents; ++i)
+    {
+        EventStateId id(i);
+        if (event_state.IsDepthTestEnabledSet(id))
+            EXPECT_EQ(values[i], event_state.DepthTestEnabled(id) ? 1.0 : 0.0);
+        else
+            EXPECT_TRUE(std::isnan(values[i]));
+    }
+}
+
+TEST(EventQuery, RejectsBadExpressions)
+{
+    std::unique_ptr<CaptureMetadata> metadata = CreateMetadata();
+    EventQuery                       query(*metadata);
+    EXPECT_FALSE(query.AddFilter("not_a_column>1"));
+    EXPECT_FALSE(query.AddFilter("submit>"));
+    EXPECT_FALSE(query.AddFilter("submit>abc"));
+    EXPECT_FALSE(query.AddFilter("submit"));
+    EXPECT_FALSE(query.AddProjection("not_a_column"));
+    EXPECT_TRUE(query.AddFilter("submit<=0x2"));
+}
+
+}  // namespace
+}  // namespace Dive
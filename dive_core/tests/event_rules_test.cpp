@@ -0,0 +1,242 @@
+/*
+ Copyright 2025 Google LLC
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#include "dive_core/event_rules.h"
+
+#include <cmath>
+#include <memory>
+
+#include "dive_core/data_core.h"
+#include "gtest/gtest.h"
+
+namespace Dive
+{
+namespace
+{
+
+using EventType = EventInfo::EventType;
+
+constexpr uint32_t kNumDraws = 600;
+
+// Draws in direct mode with depth test on every 2nd one, LRZ on every 3rd one and a depth func
+// cycling through all compare ops
+std::unique_ptr<CaptureMetadata> CreateDrawMetadata()
+{
+    auto           metadata = std::make_unique<CaptureMetadata>();
+    EventStateInfo event_state;
+    for (uint32_t i = 0; i < kNumDraws; ++i)
+    {
+        EventInfo info = {};
+        info.m_type = EventType::kDraw;
+        info.m_render_mode = RenderModeType::kDirect;
+        metadata->m_event_info.push_back(info);
+
+        EventStateInfo::Iterator it = event_state.Add();
+        it->SetDepthTestEnabled(i % 2 == 0);
+        it->SetDepthWriteEnabled(true);
+        it->SetLRZEnabled(i % 3 == 0);
+        it->SetDepthCompareOp(static_cast<VkCompareOp>(i % 8));
+        it->SetZTestMode((i % 5 == 0) ? A6XX_LATE_Z : A6XX_EARLY_Z);
+    }
+    metadata->m_event_state.Encode(event_state);
+    return metadata;
+}
+
+//--------------------------------------------------------------------------------------------------
+std::unique_ptr<CaptureMetadata> CreateMetadata(const std::vector<EventInfo> &events)
+{
+    auto           metadata = std::make_unique<CaptureMetadata>();
+    EventStateInfo event_state;
+    for (const EventInfo &info : events)
+    {
+        metadata->m_event_info.push_back(info);
+        event_state.Add();
+    }
+    metadata->m_event_state.Encode(event_state);
+    return metadata;
+}
+
+//--------------------------------------------------------------------------------------------------
+EventInfo MakeEvent(EventType type, uint32_t submit = 0)
+{
+    EventInfo info = {};
+    info.m_type = type;
+    info.m_submit_index = submit;
+    info.m_render_mode = RenderModeType::kTiled;
+    return info;
+}
+
+TEST(EventRules, DefaultRulesAreValid)
+{
+    EventRuleSet rules;
+    for (const EventRule &rule : GetDefaultEventRules())
+        EXPECT_TRUE(rules.AddRule(rule)) << rule.m_name;
+    EXPECT_EQ(rules.size(), GetDefaultEventRules().size());
+}
+
+TEST(EventRules, LrzDisabled)
+{
+    std::unique_ptr<CaptureMetadata> metadata = CreateDrawMetadata();
+    EventRuleSet                     rules;
+    ASSERT_TRUE(rules.AddRule(GetDefaultEventRules()[0]));
+    ASSERT_EQ(rules.GetRule(0).m_name, "lrz_disabled");
+
+    EventQuery                         query(*metadata);
+    std::vector<std::vector<uint32_t>> violations;
+    rules.Evaluate(query, &violations);
+
+    std::vector<uint32_t> expected;
+    for (uint32_t i = 0; i < kNumDraws; ++i)
+    {
+        uint32_t op = i % 8;
+        if (i % 2 == 0 && i % 3 != 0 && op != VK_COMPARE_OP_NEVER && op != VK_COMPARE_OP_ALWAYS)
+            expected.push_back(i);
+    }
+    ASSERT_EQ(violations.size(), 1u);
+    EXPECT_EQ(violations[0], expected);
+
+    ASSERT_FALSE(expected.empty());
+    EXPECT_EQ(rules.FormatViolation(query, 0, expected[0]),
+              "depth_write_enabled:1\tdepth_compare_op:equal\tlrz_enabled:0");
+}
+
+TEST(EventRules, LrzDisabledWhenNeverConfigured)
+{
+    // A depth-tested draw before anything configured LRZ, then one with LRZ enabled
+    auto           metadata = std::make_unique<CaptureMetadata>();
+    EventStateInfo event_state;
+    for (uint32_t i = 0; i < 2; ++i)
+    {
+        EventInfo info = {};
+        info.m_type = EventType::kDraw;
+        info.m_render_mode = RenderModeType::kDirect;
+        metadata->m_event_info.push_back(info);
+
+        EventStateInfo::Iterator it = event_state.Add();
+        it->SetDepthTestEnabled(true);
+        it->SetDepthCompareOp(VK_COMPARE_OP_LESS);
+        if (i == 1)
+            it->SetLRZEnabled(true);
+    }
+    metadata->m_event_state.Encode(event_state);
+
+    EventRuleSet rules;
+    ASSERT_TRUE(rules.AddRule(GetDefaultEventRules()[0]));
+    EventQuery                         query(*metadata);
+    std::vector<std::vector<uint32_t>> violations;
+    rules.Evaluate(query, &violations);
+    ASSERT_EQ(violations.size(), 1u);
+    EXPECT_EQ(violations[0], std::vector<uint32_t>{ 0 });
+}
+
+TEST(EventRules, SharedConditionsMatchSeparateQueries)
+{
+    std::unique_ptr<CaptureMetadata> metadata = CreateDrawMetadata();
+    const std::vector<std::vector<std::string>> kConditions = {
+        { "type==draw", "depth_test_enabled==true" },
+        { "type==draw", "depth_test_enabled==true", "lrz_enabled==false" },
+        { "type==draw", "depth_test_enabled==true", "ztest_mode==late_z" },
+        { "type==draw", "depth_test_enabled==false", "ztest_mode==late_z" },
+        { "type==draw", "depth_compare_op>=greater" },
+        { "depth_compare_op>=greater", "type==draw" },
+        { "type==dispatch", "depth_test_enabled==true" },
+    };
+
+    EventRuleSet rules;
+    for (size_t i = 0; i < kConditions.size(); ++i)
+        ASSERT_TRUE(rules.AddRule({ "rule" + std::to_string(i), "", kConditions[i], {} }));
+
+    EventQuery                         query(*metadata);
+    std::vector<std::vector<uint32_t>> violations;
+    rules.Evaluate(query, &violations);
+    ASSERT_EQ(violations.size(), kConditions.size());
+    for (size_t i = 0; i < kConditions.size(); ++i)
+    {
+        EventQuery separate(*metadata);
+        for (const std::string &condition : kConditions[i])
+            ASSERT_TRUE(separate.AddFilter(condition));
+        EventQueryResult result;
+        separate.Run(&result);
+        EXPECT_EQ(violations[i], result.m_event_ids) << "rule " << i;
+    }
+    EXPECT_EQ(violations[4], violations[5]);
+    EXPECT_TRUE(violations[6].empty());
+}
+
+TEST(EventRules, RedundantResolves)
+{
+    std::unique_ptr<CaptureMetadata> metadata = CreateMetadata({
+        MakeEvent(EventType::kColorClearGmem),               // 0: first clear
+        MakeEvent(EventType::kColorClearGmem),               // 1: second attachment
+        MakeEvent(EventType::kDraw),                         // 2
+        MakeEvent(EventType::kColorGmemToSysMemResolve),     // 3: first resolve
+        MakeEvent(EventType::kColorGmemToSysMemResolve),     // 4: second attachment
+        MakeEvent(EventType::kWaitForIdle),                  // 5
+        MakeEvent(EventType::kColorGmemToSysMemResolve),     // 6: redundant
+        MakeEvent(EventType::kDraw),                         // 7
+        MakeEvent(EventType::kColorGmemToSysMemResolve),     // 8
+        MakeEvent(EventType::kColorClearGmem),               // 9: 2 draws since the last clear
+        MakeEvent(EventType::kColorGmemToSysMemResolve, 1),  // 10: first of the submit
+    });
+    EventRuleSet rules;
+    for (const EventRule &rule : GetDefaultEventRules())
+        ASSERT_TRUE(rules.AddRule(rule));
+
+    EventQuery                         query(*metadata);
+    std::vector<std::vector<uint32_t>> violations;
+    rules.Evaluate(query, &violations);
+    for (uint32_t rule = 0; rule < rules.size(); ++rule)
+    {
+        if (rules.GetRule(rule).m_name == "redundant_resolve")
+            EXPECT_EQ(violations[rule], std::vector<uint32_t>({ 6 }));
+        else if (rules.GetRule(rule).m_name == "wait_for_idle_in_bin")
+            EXPECT_EQ(violations[rule], std::vector<uint32_t>({ 5 }));
+        else
+            EXPECT_TRUE(violations[rule].empty()) << rules.GetRule(rule).m_name;
+    }
+
+    uint32_t column = EventQuery::FindColumn("draws_since_resolve");
+    EXPECT_TRUE(std::isnan(query.GetValue(column, 1)));
+    EXPECT_TRUE(std::isnan(query.GetValue(column, 4)));
+    EXPECT_EQ(query.GetValue(column, 8), 1.0);
+    EXPECT_EQ(query.GetValue(column, 9), 2.0);
+    EXPECT_TRUE(std::isnan(query.GetValue(column, 10)));
+}
+
+TEST(EventRules, ParsesRuleText)
+{
+    EventRuleSet rules;
+    std::string  error;
+    EXPECT_TRUE(rules.AddRules("# Comment\n"
+                               "\n"
+                               "late_z: type==draw, ztest_mode == late_z\n"
+                               "  no_lrz :lrz_enabled==false",
+                               &error));
+    ASSERT_EQ(rules.size(), 2u);
+    EXPECT_EQ(rules.GetRule(0).m_name, "late_z");
+    EXPECT_EQ(rules.GetRule(0).m_conditions,
+              std::vector<std::string>({ "type==draw", "ztest_mode == late_z" }));
+    EXPECT_EQ(rules.GetRule(1).m_name, "no_lrz");
+
+    EXPECT_FALSE(rules.AddRules("ok: type==draw\nbad: not_a_column==1\n", &error));
+    EXPECT_EQ(error, "Invalid rule on line 2: bad: not_a_column==1");
+    EXPECT_FALSE(rules.AddRules("type==draw", &error));
+    EXPECT_FALSE(rules.AddRules("empty:", &error));
+    EXPECT_FALSE(rules.AddRule({ "bad_detail", "", { "type==draw" }, { "not_a_column" } }));
+}
+
+}  // namespace
+}  // namespace Dive
@@ -0,0 +1,137 @@
+/*
+ Copyright 2025 Google LLC
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#include "dive_core/event_state.h"
+#include "gtest/gtest.h"
+
+namespace Dive
+{
+namespace
+{
+
+// Spans the initial contiguous buffer plus several chunks, the last one partially filled
+constexpr uint32_t kNumEvents = 3500;
+
+void FillState(EventStateInfo *state)
+{
+    for (uint32_t i = 0; i < kNumEvents; ++i)
+    {
+        EventStateInfo::Iterator it = state->Add();
+        it->SetLineWidth(static_cast<float>(i));
+        if (i % 3 == 0)
+            it->SetDepthTestEnabled(true);
+
+        VkViewport viewport = {};
+        viewport.width = static_cast<float>(i);
+        it->SetViewport(2, viewport);
+    }
+}
+
+void CheckState(const EventStateInfo &state)
+{
+    ASSERT_EQ(state.size(), kNumEvents);
+    for (uint32_t i = 0; i < kNumEvents; ++i)
+    {
+        EventStateId id(i);
+        ASSERT_EQ(state.LineWidth(id), static_cast<float>(i));
+        ASSERT_EQ(state.IsDepthTestEnabledSet(id), i % 3 == 0);
+        ASSERT_EQ(state.Viewport(id, 2).width, static_cast<float>(i));
+        ASSERT_EQ(state.Viewport(id, 1).width, 0.f);
+    }
+}
+
+TEST(EventStateInfoChunked, ElementsAreStableWhileGrowing)
+{
+    EventStateInfo state;
+    state.Add()->SetLineWidth(42.f);
+    const float *first = state.LineWidthPtr(EventStateId(0));
+    for (uint32_t i = 1; i < kNumEvents; ++i)
+        state.Add();
+
+    // Growth never moves existing elements
+    EXPECT_EQ(state.LineWidthPtr(EventStateId(0)), first);
+    EXPECT_EQ(*first, 42.f);
+    EXPECT_GE(state.capacity(), kNumEvents);
+}
+
+TEST(EventStateInfoChunked, PerElementAccessBeforeCompact)
+{
+    EventStateInfo state;
+    FillState(&state);
+    CheckState(state);
+}
+
+TEST(EventStateInfoChunked, CompactMakesColumnsContiguous)
+{
+    EventStateInfo state;
+    FillState(&state);
+    state.Compact();
+    CheckState(state);
+
+    const float *line_width = state.LineWidthPtr();
+    for (uint32_t i = 0; i < kNumEvents; ++i)
+        ASSERT_EQ(line_width[i], static_cast<float>(i));
+
+    StructOfArraysColumn<float> column = state.LineWidthColumn();
+    ASSERT_EQ(column.size(), kNumEvents);
+    EXPECT_EQ(column.CountWhere([](float w) { return w >= 1000.f; }), kNumEvents - 1000);
+
+    // Adding after compaction chunks again, and a second compaction keeps everything
+    EventStateInfo::Iterator it = state.Add();
+    it->SetLineWidth(-1.f);
+    state.Compact();
+    EXPECT_EQ(state.LineWidthPtr()[kNumEvents], -1.f);
+}
+
+TEST(EventStateInfoChunked, ReserveMergesChunks)
+{
+    EventStateInfo state;
+    FillState(&state);
+    state.Reserve(kNumEvents * 2);
+    EXPECT_GE(state.capacity(), kNumEvents * 2);
+    CheckState(state);
+    EXPECT_EQ(state.LineWidthPtr()[kNumEvents - 1], static_cast<float>(kNumEvents - 1));
+}
+
+TEST(EventStateInfoChunked, EncodeReadsChunksInPlace)
+{
+    EventStateInfo state;
+    FillState(&state);
+
+    EventStateInfoDelta delta;
+    delta.Encode(state, 64);
+    ASSERT_EQ(delta.size(), kNumEvents);
+    for (uint32_t i = 0; i < kNumEvents; ++i)
+    {
+        EventStateId id(i);
+        ASSERT_EQ(delta.LineWidth(id), static_cast<float>(i));
+        ASSERT_EQ(delta.IsDepthTestEnabledSet(id), i % 3 == 0);
+        ASSERT_EQ(delta.IsViewportSet(id, 2), true);
+        ASSERT_EQ(delta.IsViewportSet(id, 1), false);
+        ASSERT_EQ(delta.Viewport(id, 2).width, static_cast<float>(i));
+    }
+}
+
+TEST(EventStateInfoChunked, SmallStateNeedsNoCompaction)
+{
+    EventStateInfo state;
+    for (uint32_t i = 0; i < 100; ++i)
+        state.Add()->SetLineWidth(static_cast<float>(i));
+    EXPECT_EQ(state.LineWidthPtr()[99], 99.f);
+}
+
+}  // namespace
+}  // namespace Dive
@@ -0,0 +1,154 @@
+/*
+ Copyright 2025 Google LLC
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#include "dive_core/event_state.h"
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace Dive
+{
+namespace
+{
+
+constexpr uint32_t kNumEvents = 1000;
+
+// Line width is set on every other event to (i % 10), and the second scissor on every 4th event
+void FillState(EventStateInfo *state)
+{
+    for (uint32_t i = 0; i < kNumEvents; ++i)
+    {
+        EventStateInfo::Iterator it = state->Add();
+        if (i % 2 == 0)
+            it->SetLineWidth(static_cast<float>(i % 10));
+        if (i % 4 == 0)
+        {
+            VkRect2D rect = {};
+            rect.extent.width = i;
+            it->SetScissor(1, rect);
+        }
+    }
+}
+
+TEST(EventStateInfoColumn, SkipsUnsetElements)
+{
+    EventStateInfo state;
+    FillState(&state);
+
+    StructOfArraysColumn<float> line_width = state.LineWidthColumn();
+    ASSERT_EQ(line_width.size(), kNumEvents);
+    EXPECT_TRUE(line_width.IsSet(0));
+    EXPECT_FALSE(line_width.IsSet(1));
+
+    // Unset elements hold 0, which must not be counted
+    EXPECT_EQ(line_width.CountWhere([](float w) { return w == 0.f; }), kNumEvents / 10);
+    EXPECT_EQ(line_width.CountWhere([](float w) { return w >= 0.f; }), kNumEvents / 2);
+
+    std::vector<uint32_t> wide = line_width.Filter([](float w) { return w > 6.f; });
+    ASSERT_EQ(wide.size(), kNumEvents / 10);
+    for (uint32_t id : wide)
+        EXPECT_EQ(id % 10, 8u);
+}
+
+TEST(EventStateInfoColumn, ReductionsAndHistogram)
+{
+    EventStateInfo state;
+    FillState(&state);
+
+    StructOfArraysColumn<float>          line_width = state.LineWidthColumn();
+    StructOfArraysColumn<float>::Summary summary = line_width.Reduce();
+    EXPECT_EQ(summary.m_count, kNumEvents / 2);
+    EXPECT_EQ(summary.m_min, 0.f);
+    EXPECT_EQ(summary.m_max, 8.f);
+    EXPECT_EQ(summary.m_sum, (0 + 2 + 4 + 6 + 8) * (kNumEvents / 10.0));
+
+    auto histogram = line_width.Histogram();
+    ASSERT_EQ(histogram.size(), 5u);
+    for (size_t i = 0; i < histogram.size(); ++i)
+    {
+        EXPECT_EQ(histogram[i].first, static_cast<float>(i * 2));
+        EXPECT_EQ(histogram[i].second, kNumEvents / 10);
+    }
+}
+
+TEST(EventStateInfoColumn, SelectionsAndArrayElements)
+{
+    EventStateInfo state;
+    FillState(&state);
+
+    std::vector<uint32_t> selection;
+    for (uint32_t i = 0; i < kNumEvents; i += 8)
+        selection.push_back(i);
+
+    StructOfArraysColumn<VkRect2D> scissor = state.ScissorColumn(1);
+    auto                           any = [](const VkRect2D &) { return true; };
+    EXPECT_EQ(scissor.CountWhere(any), kNumEvents / 4);
+    EXPECT_EQ(scissor.CountWhere(selection, any), selection.size());
+    EXPECT_EQ(state.ScissorColumn(0).CountWhere(any), 0u);
+
+    std::vector<uint32_t> filtered = scissor.Filter(selection, [](const VkRect2D &rect) {
+        return rect.extent.width >= 500;
+    });
+    ASSERT_FALSE(filtered.empty());
+    EXPECT_EQ(filtered.front(), 504u);
+    EXPECT_EQ(scissor[filtered.front()].extent.width, 504u);
+}
+
+TEST(EventStateInfoColumn, DeltaColumnsMatchFullColumns)
+{
+    EventStateInfo state;
+    FillState(&state);
+    EventStateInfoDelta delta;
+    delta.Encode(state, 16);
+
+    std::vector<uint32_t> selection;
+    for (uint32_t i = 0; i < kNumEvents; i += 3)
+        selection.push_back(i);
+
+    StructOfArraysColumn<float>      line_width = state.LineWidthColumn();
+    StructOfArraysDeltaColumn<float> delta_line_width = delta.LineWidthColumn();
+    ASSERT_EQ(delta_line_width.size(), kNumEvents);
+    for (uint32_t i = 0; i < kNumEvents; ++i)
+    {
+        ASSERT_EQ(delta_line_width.IsSet(i), line_width.IsSet(i));
+        EXPECT_EQ(delta_line_width[i], line_width[i]);
+    }
+
+    auto is_wide = [](float w) { return w > 2.f; };
+    EXPECT_EQ(delta_line_width.CountWhere(is_wide), line_width.CountWhere(is_wide));
+    EXPECT_EQ(delta_line_width.CountWhere(selection, is_wide),
+              line_width.CountWhere(selection, is_wide));
+    EXPECT_EQ(delta_line_width.Filter(is_wide), line_width.Filter(is_wide));
+    EXPECT_EQ(delta_line_width.Filter(selection, is_wide), line_width.Filter(selection, is_wide));
+    EXPECT_EQ(delta_line_width.Histogram(), line_width.Histogram());
+    EXPECT_EQ(delta_line_width.Histogram(selection), line_width.Histogram(selection));
+
+    StructOfArraysColumn<float>::Summary summary = line_width.Reduce(selection);
+    StructOfArraysColumn<float>::Summary delta_summary = delta_line_width.Reduce(selection);
+    EXPECT_EQ(delta_summary.m_count, summary.m_count);
+    EXPECT_EQ(delta_summary.m_min, summary.m_min);
+    EXPECT_EQ(delta_summary.m_max, summary.m_max);
+    EXPECT_EQ(delta_summary.m_sum, summary.m_sum);
+
+    auto any = [](const VkRect2D &) { return true; };
+    EXPECT_EQ(delta.ScissorColumn(1).Filter(selection, any),
+              state.ScissorColumn(1).Filter(selection, any));
+    EXPECT_EQ(delta.ScissorColumn(0).CountWhere(any), 0u);
+}
+
+}  // namespace
+}  // namespace Dive
@@ -0,0 +1,162 @@
+/*
+ Copyright 2025 Google LLC
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#include "dive_core/event_state.h"
+
+#include <cstring>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace Dive
+{
+namespace
+{
+
+constexpr uint32_t kNumEvents = 5000;
+
+// EventStateInfo holds 8 color attachments per event
+constexpr size_t kAttachmentsSize = 8 * sizeof(VkPipelineColorBlendAttachmentState);
+
+// Depth test toggles every 100 events, the second attachment's blend state every 7, and the
+// viewport width every 1000. Nothing is set on the first 10 events.
+void FillState(EventStateInfo *state)
+{
+    for (uint32_t i = 0; i < kNumEvents; ++i)
+    {
+        EventStateInfo::Iterator it = state->Add();
+        if (i < 10)
+            continue;
+        it->SetDepthTestEnabled((i / 100) % 2 == 0);
+
+        VkPipelineColorBlendAttachmentState attachment = {};
+        attachment.blendEnable = ((i / 7) % 2) ? VK_TRUE : VK_FALSE;
+        it->SetAttachment(1, attachment);
+
+        VkViewport viewport = {};
+        viewport.width = static_cast<float>(i / 1000);
+        it->SetViewport(0, viewport);
+    }
+    state->Compact();
+}
+
+TEST(EventStateInfoDelta, GettersMatchFullStorage)
+{
+    EventStateInfo state;
+    FillState(&state);
+
+    EventStateInfoDelta delta;
+    delta.Encode(state, 64);
+    ASSERT_EQ(delta.size(), state.size());
+    for (uint32_t i = 0; i < kNumEvents; ++i)
+    {
+        EventStateId id(i);
+        EXPECT_EQ(delta.IsDepthTestEnabledSet(id), state.IsDepthTestEnabledSet(id));
+        EXPECT_EQ(delta.DepthTestEnabled(id), state.DepthTestEnabled(id));
+        EXPECT_EQ(delta.IsAttachmentSet(id, 1), state.IsAttachmentSet(id, 1));
+        EXPECT_EQ(delta.Attachment(id, 1).blendEnable, state.Attachment(id, 1).blendEnable);
+        EXPECT_FALSE(delta.IsAttachmentSet(id, 0));
+        EXPECT_EQ(delta.Viewport(id, 0).width, state.Viewport(id, 0).width);
+        EXPECT_EQ(delta.IsStencilTestEnabledSet(id), false);
+    }
+}
+
+TEST(EventStateInfoDelta, ChangesListsTransitions)
+{
+    EventStateInfo state;
+    FillState(&state);
+
+    EventStateInfoDelta delta;
+    delta.Encode(state);
+
+    // Unset at 0, set at 10, then toggles every 100 events
+    std::vector<uint32_t> expected = { 0, 10 };
+    for (uint32_t i = 100; i < kNumEvents; i += 100)
+        expected.push_back(i);
+    EXPECT_EQ(delta.DepthTestEnabledChanges(), expected);
+
+    expected = { 0, 10 };
+    for (uint32_t i = 1000; i < kNumEvents; i += 1000)
+        expected.push_back(i);
+    EXPECT_EQ(delta.ViewportChanges(0), expected);
+
+    // Never set
+    EXPECT_EQ(delta.StencilTestEnabledChanges(), std::vector<uint32_t>{ 0 });
+}
+
+TEST(EventStateInfoDelta, DecodeRoundTrips)
+{
+    EventStateInfo state;
+    FillState(&state);
+
+    EventStateInfoDelta delta;
+    delta.Encode(state, 100);
+
+    EventStateInfo decoded;
+    delta.Decode(&decoded);
+    ASSERT_EQ(decoded.size(), state.size());
+    for (uint32_t i = 0; i < kNumEvents; ++i)
+    {
+        EventStateId id(i);
+        EXPECT_EQ(decoded.IsDepthTestEnabledSet(id), state.IsDepthTestEnabledSet(id));
+        EXPECT_EQ(decoded.DepthTestEnabled(id), state.DepthTestEnabled(id));
+        EXPECT_EQ(decoded.IsAttachmentSet(id, 1), state.IsAttachmentSet(id, 1));
+        EXPECT_EQ(memcmp(decoded.AttachmentPtr(id), state.AttachmentPtr(id), kAttachmentsSize), 0);
+        EXPECT_EQ(decoded.IsViewportSet(id, 1), false);
+    }
+}
+
+TEST(EventStateInfoDelta, DecodeSelectedIds)
+{
+    EventStateInfo state;
+    FillState(&state);
+
+    EventStateInfoDelta delta;
+    delta.Encode(state, 100);
+
+    std::vector<uint32_t> ids = { 4999, 5, 10, 1234 };
+    EventStateInfo        decoded;
+    delta.Decode(ids, &decoded);
+    ASSERT_EQ(decoded.size(), ids.size());
+    for (uint32_t i = 0; i < ids.size(); ++i)
+    {
+        EventStateId id(ids[i]);
+        EventStateId decoded_id(i);
+        EXPECT_EQ(decoded.IsDepthTestEnabledSet(decoded_id), state.IsDepthTestEnabledSet(id));
+        EXPECT_EQ(decoded.DepthTestEnabled(decoded_id), state.DepthTestEnabled(id));
+        EXPECT_EQ(decoded.IsAttachmentSet(decoded_id, 1), state.IsAttachmentSet(id, 1));
+        EXPECT_EQ(memcmp(decoded.AttachmentPtr(decoded_id),
+                         state.AttachmentPtr(id),
+                         kAttachmentsSize),
+                  0);
+        EXPECT_EQ(decoded.Viewport(decoded_id, 0).width, state.Viewport(id, 0).width);
+    }
+}
+
+TEST(EventStateInfoDelta, SmallerThanFullStorage)
+{
+    EventStateInfo state;
+    FillState(&state);
+
+    EventStateInfoDelta delta;
+    delta.Encode(state);
+
+    // The full storage holds at least the attachments of every event
+    EXPECT_LT(delta.GetMemoryUsage() * 10, kNumEvents * kAttachmentsSize);
+}
+
+}  // namespace
+}  // namespace Dive
@@ -0,0 +1,117 @@
+/*
+ Copyright 2025 Google LLC
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#include "dive_core/event_state_groups.h"
+
+#include <vector>
+
+#include "dive_core/capture_event_info.h"
+#include "gtest/gtest.h"
+
+namespace Dive
+{
+namespace
+{
+
+constexpr uint32_t kNumEvents = 600;
+
+// Blending alternates between 2 attachment states, depth test cycles through 3 compare ops, and
+// the depth-write flag is never set. Every 3rd event uses a second shader.
+void AddEvents(EventStateInfo *event_state, EventStateGroups *groups)
+{
+    EventInfoTable event_info;
+    for (uint32_t i = 0; i < kNumEvents; ++i)
+    {
+        EventStateInfo::Iterator it = event_state->Add();
+        VkPipelineColorBlendAttachmentState attachment = {};
+        attachment.blendEnable = (i % 2) ? VK_TRUE : VK_FALSE;
+        it->SetAttachment(0, attachment);
+        it->SetDepthTestEnabled(true);
+        it->SetDepthCompareOp(static_cast<VkCompareOp>(i % 3));
+
+        ShaderReference ref;
+        ref.m_shader_index = (i % 3 == 0) ? 1 : 0;
+        ref.m_stage = ShaderStage::kShaderStagePs;
+        ref.m_enable_mask = 0;
+        event_info.push_back(EventInfo{});
+        event_info.AddShaderReference(ref);
+        groups->AddEvent(*event_state, event_info);
+    }
+}
+
+TEST(EventStateGroups, DistinctStates)
+{
+    EventStateInfo   event_state;
+    EventStateGroups groups;
+    AddEvents(&event_state, &groups);
+    ASSERT_EQ(groups.GetNumEvents(), kNumEvents);
+
+    EXPECT_EQ(groups.GetNumDistinctStates(EventStateGroups::kColorBlend), 2u);
+    EXPECT_EQ(groups.GetNumDistinctStates(EventStateGroups::kDepthStencil), 3u);
+    EXPECT_EQ(groups.GetNumDistinctStates(EventStateGroups::kShaders), 2u);
+    EXPECT_EQ(groups.GetNumDistinctStates(EventStateGroups::kRasterizer), 1u);
+}
+
+TEST(EventStateGroups, EventsPerState)
+{
+    EventStateInfo   event_state;
+    EventStateGroups groups;
+    AddEvents(&event_state, &groups);
+
+    for (uint32_t state_id = 0; state_id < 3; ++state_id)
+    {
+        const std::vector<uint32_t> &events = groups.GetEvents(EventStateGroups::kDepthStencil,
+                                                               state_id);
+        ASSERT_EQ(events.size(), kNumEvents / 3);
+        VkCompareOp op = event_state.DepthCompareOp(EventStateId(events[0]));
+        for (uint32_t event_id : events)
+        {
+            EXPECT_EQ(event_state.DepthCompareOp(EventStateId(event_id)), op);
+            EXPECT_EQ(groups.GetStateId(EventStateGroups::kDepthStencil, event_id), state_id);
+        }
+    }
+}
+
+TEST(EventStateGroups, SameStateIsIdCompare)
+{
+    EventStateInfo   event_state;
+    EventStateGroups groups;
+    AddEvents(&event_state, &groups);
+
+    EXPECT_TRUE(groups.IsSameState(EventStateGroups::kColorBlend, 1, 3));
+    EXPECT_FALSE(groups.IsSameState(EventStateGroups::kColorBlend, 1, 2));
+    EXPECT_TRUE(groups.IsSameState(EventStateGroups::kDepthStencil, 0, 6));
+    EXPECT_FALSE(groups.IsSameState(EventStateGroups::kDepthStencil, 0, 1));
+    EXPECT_TRUE(groups.IsSameState(EventStateGroups::kShaders, 0, 3));
+    EXPECT_FALSE(groups.IsSameState(EventStateGroups::kShaders, 0, 1));
+}
+
+TEST(EventStateGroups, QueriesAfterFinalize)
+{
+    EventStateInfo   event_state;
+    EventStateGroups groups;
+    AddEvents(&event_state, &groups);
+    groups.Finalize();
+
+    EXPECT_EQ(groups.GetNumEvents(), kNumEvents);
+    EXPECT_EQ(groups.GetNumDistinctStates(EventStateGroups::kDepthStencil), 3u);
+    EXPECT_EQ(groups.GetEvents(EventStateGroups::kDepthStencil, 0).size(), kNumEvents / 3);
+    EXPECT_TRUE(groups.IsSameState(EventStateGroups::kDepthStencil, 0, 6));
+    EXPECT_FALSE(groups.IsSameState(EventStateGroups::kShaders, 0, 1));
+}
+
+}  // namespace
+}  // namespace Dive
@@ -0,0 +1,267 @@
+/*
+ Copyright 2025 Google LLC
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+
+#include "dive_core/frame_stability.h"
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "dive_core/common/dive_capture_format.h"
+#include "dive_core/data_core.h"
+#include "dive_core/pm4_capture_data.h"
+#include "gtest/gtest.h"
+#include "pm4_info.h"
+#include "pm4_test_stream.h"
+
+namespace Dive
+{
+namespace
+{
+
+// A draw whose depth/stencil state is `state` and whose arguments are `arguments`
+DrawFingerprint MakeFingerprint(uint64_t state, uint64_t arguments = 0)
+{
+    DrawFingerprint fingerprint = {};
+    fingerprint.m_components[EventStateGroups::kDepthStencil] = state;
+    fingerprint.m_components[kDrawArguments] = arguments;
+    fingerprint.UpdateHash();
+    return fingerprint;
+}
+
+std::vector<DrawFingerprint> MakeFrame(const std::vector<uint64_t> &states)
+{
+    std::vector<DrawFingerprint> frame;
+    for (uint64_t state : states)
+        frame.push_back(MakeFingerprint(state));
+    return frame;
+}
+
+TEST(FrameStability, SameFrames)
+{
+    FrameDiff diff = DiffFrames(MakeFrame({ 1, 2, 3 }), MakeFrame({ 1, 2, 3 }));
+    EXPECT_TRUE(diff.m_is_aligned);
+    EXPECT_EQ(diff.GetNumDifferences(), 0u);
+    EXPECT_TRUE(diff.m_differences.empty());
+
+    diff = DiffFrames({}, {});
+    EXPECT_EQ(diff.GetNumDifferences(), 0u);
+}
+
+TEST(FrameStability, InsertionsAndDeletions)
+{
+    FrameDiff diff = DiffFrames(MakeFrame({ 1, 2, 3, 4 }), MakeFrame({ 1, 2, 5, 3, 4 }));
+    EXPECT_EQ(diff.m_num_inserted, 1u);
+    EXPECT_EQ(diff.m_num_deleted, 0u);
+    EXPECT_EQ(diff.m_num_changed, 0u);
+    ASSERT_EQ(diff.m_differences.size(), 1u);
+    EXPECT_EQ(diff.m_differences[0].m_type, FrameDifference::Type::kInserted);
+    EXPECT_EQ(diff.m_differences[0].m_index, 2u);
+
+    // Draws swapped cannot both be aligned
+    diff = DiffFrames(MakeFrame({ 1, 2, 3, 4, 5 }), MakeFrame({ 1, 3, 2, 4 }));
+    EXPECT_EQ(diff.m_num_inserted, 1u);
+    EXPECT_EQ(diff.m_num_deleted, 2u);
+    EXPECT_EQ(diff.m_num_changed, 0u);
+
+    diff = DiffFrames(MakeFrame({ 1, 2, 3 }), {});
+    EXPECT_EQ(diff.m_num_deleted, 3u);
+    EXPECT_EQ(diff.m_differences.back().m_index, 2u);
+}
+
+TEST(FrameStability, Changes)
+{
+    std::vector<DrawFingerprint> previous = MakeFrame({ 1, 2, 3, 4 });
+    std::vector<DrawFingerprint> frame = { MakeFingerprint(1),
+                                           MakeFingerprint(2, 6),
+                                           MakeFingerprint(7),
+                                           MakeFingerprint(4) };
+    FrameDiff                    diff = DiffFrames(previous, frame);
+    EXPECT_TRUE(diff.m_is_aligned);
+    EXPECT_EQ(diff.m_num_changed, 2u);
+    EXPECT_EQ(diff.m_num_inserted, 0u);
+    EXPECT_EQ(diff.m_num_deleted, 0u);
+    EXPECT_EQ(diff.m_changed_components[EventStateGroups::kDepthStencil], 1u);
+    EXPECT_EQ(diff.m_changed_components[kDrawArguments], 1u);
+    EXPECT_EQ(diff.m_changed_components[EventStateGroups::kShaders], 0u);
+    ASSERT_EQ(diff.m_differences.size(), 2u);
+    EXPECT_EQ(diff.m_differences[1].m_type, FrameDifference::Type::kChanged);
+    EXPECT_EQ(diff.m_differences[1].m_index, 2u);
+    EXPECT_EQ(diff.m_differences[1].m_previous_index, 2u);
+    EXPECT_EQ(diff.m_differences[1].m_changed_components, 1u << EventStateGroups::kDepthStencil);
+
+    // The draws between two aligned ones are paired in order, the rest deleted
+    diff = DiffFrames(MakeFrame({ 1, 2, 3, 4 }), MakeFrame({ 1, 5, 4 }));
+    EXPECT_EQ(diff.m_num_changed, 1u);
+    EXPECT_EQ(diff.m_num_deleted, 1u);
+    ASSERT_EQ(diff.m_differences.size(), 2u);
+    EXPECT_EQ(diff.m_differences[1].m_type, FrameDifference::Type::kDeleted);
+    EXPECT_EQ(diff.m_differences[1].m_index, 2u);
+}
+
+TEST(FrameStability, LongFrames)
+{
+    std::vector<uint64_t> previous_states;
+    std::vector<uint64_t> states;
+    for (uint64_t i = 0; i < 5000; ++i)
+    {
+        previous_states.push_back(i);
+        if (i % 1000 != 500)
+            states.push_back(i);
+        if (i % 1000 == 0)
+            states.push_back(10000 + i);
+    }
+    FrameDiff diff = DiffFrames(MakeFrame(previous_states), MakeFrame(states));
+    EXPECT_TRUE(diff.m_is_aligned);
+    EXPECT_EQ(diff.m_num_inserted, 5u);
+    EXPECT_EQ(diff.m_num_deleted, 5u);
+    EXPECT_EQ(diff.m_num_changed, 0u);
+
+    // Frames with nothing in common are too far apart to align
+    for (uint64_t &state : states)
+        state += 100000;
+    diff = DiffFrames(MakeFrame(previous_states), MakeFrame(states));
+    EXPECT_FALSE(diff.m_is_aligned);
+    EXPECT_EQ(diff.m_num_changed, 5000u);
+    EXPECT_EQ(diff.m_num_inserted, 0u);
+    EXPECT_EQ(diff.m_num_deleted, 0u);
+}
+
+// Writes a .dive capture of submits of a single IB each, and of presents
+class CaptureWriter
+{
+public:
+    CaptureWriter()
+    {
+        Write(FileHeader());
+        Write(BlockInfo(BlockType::kCapture, 0));
+        CaptureDataHeader data_header = {};
+        data_header.m_capture_type = CaptureDataHeader::CaptureType::kBeginEndRange;
+        data_header.m_capture_pm4 = 1;
+        data_header.m_reset_memory_tracker = 1;
+        Write(data_header);
+    }
+
+    void AddSubmit(const std::vector<uint32_t> &dwords)
+    {
+        constexpr uint64_t kIbAddr = 0x10000;
+        uint32_t           num_bytes = static_cast<uint32_t>(dwords.size() * sizeof(uint32_t));
+
+        SubmitDataHeader submit = {};
+        submit.m_num_ibs = 1;
+        submit.m_engine_type = EngineType::kUniversal;
+        submit.m_queue_type = QueueType::kUniversal;
+        IndirectBufferData ib = {};
+        ib.m_va_addr = kIbAddr;
+        ib.m_size_in_dwords = static_cast<uint32_t>(dwords.size());
+        Write(BlockInfo(BlockType::kSubmit, sizeof(submit) + sizeof(ib)));
+        Write(submit);
+        Write(ib);
+
+        MemoryRawDataHeader memory = {};
+        memory.m_va_addr = kIbAddr;
+        memory.m_size_in_bytes = num_bytes;
+        Write(BlockInfo(BlockType::kMemoryRaw, sizeof(memory) + num_bytes));
+        Write(memory);
+        m_stream.write(reinterpret_cast<const char *>(dwords.data()), num_bytes);
+    }
+
+    void AddPresent(bool valid_data)
+    {
+        PresentData present = {};
+        present.m_valid_data = valid_data ? 1 : 0;
+        Write(BlockInfo(BlockType::kPresent, sizeof(present)));
+        Write(present);
+    }
+
+    std::string str() const { return m_stream.str(); }
+
+private:
+    template<typename T> void Write(const T &value)
+    {
+        m_stream.write(reinterpret_cast<const char *>(&value), sizeof(value));
+    }
+
+    std::ostringstream m_stream;
+};
+
+// An IB of non-indexed draws of `num_indices` each
+std::vector<uint32_t> MakeDraws(const std::vector<uint32_t> &num_indices)
+{
+    std::vector<uint32_t> dwords;
+    for (uint32_t count : num_indices)
+    {
+        PM4_CP_DRAW_INDX_OFFSET packet = {};
+        packet.bitfields0.PRIM_TYPE = DI_PT_TRILIST;
+        packet.bitfields0.SOURCE_SELECT = DI_SRC_SEL_AUTO_INDEX;
+        packet.bitfields1.NUM_INSTANCES = 1;
+        packet.bitfields2.NUM_INDICES = count;
+
+        // A non-indexed draw only has the first 3 dwords after the header
+        const uint32_t *packet_dwords = reinterpret_cast<const uint32_t *>(&packet);
+        test::AppendType7(dwords,
+                          CP_DRAW_INDX_OFFSET,
+                          { packet_dwords[1], packet_dwords[2], packet_dwords[3] });
+    }
+    return dwords;
+}
+
+TEST(FrameStability, Pm4Capture)
+{
+    // A present before any submit, then 2 frames, the second ended by a present without surface
+    // data, and a submit after the last present
+    CaptureWriter writer;
+    writer.AddPresent(true);
+    writer.AddSubmit(MakeDraws({ 3, 6 }));
+    writer.AddPresent(true);
+    writer.AddSubmit(MakeDraws({ 3, 9 }));
+    writer.AddPresent(false);
+    writer.AddSubmit(MakeDraws({ 3 }));
+
+    Pm4InfoInit();
+    DataCore           data_core(nullptr);
+    std::istringstream stream(writer.str());
+    ASSERT_EQ(data_core.GetMutablePm4CaptureData().LoadCaptureFileStream(stream),
+              CaptureData::LoadResult::kSuccess);
+    ASSERT_TRUE(data_core.CreatePm4MetaData());
+
+    std::vector<uint32_t> frame_end_submits = GetFrameEndSubmits(data_core.GetPm4CaptureData());
+    ASSERT_EQ(frame_end_submits, std::vector<uint32_t>({ 1, 2 }));
+
+    FrameStabilityReport report;
+    AnalyzeFrameStability(data_core.GetCaptureMetadata(), frame_end_submits, 2, report);
+    ASSERT_EQ(report.m_frames.size(), 2u);
+    EXPECT_EQ(report.m_frames[0].m_event_ids, std::vector<uint32_t>({ 0, 1 }));
+    EXPECT_EQ(report.m_frames[1].m_first_submit, 1u);
+    EXPECT_EQ(report.m_frames[1].m_event_ids, std::vector<uint32_t>({ 2, 3 }));
+
+    const FrameDiff &diff = report.m_frames[1].m_diff;
+    EXPECT_EQ(diff.m_num_changed, 1u);
+    EXPECT_EQ(diff.m_num_inserted, 0u);
+    EXPECT_EQ(diff.m_num_deleted, 0u);
+    EXPECT_EQ(diff.m_changed_components[kDrawArguments], 1u);
+
+    // The draws of 6 and 9 indices are each in one frame only
+    EXPECT_EQ(report.m_num_fingerprints, 3u);
+    ASSERT_EQ(report.m_intermittent_fingerprints.size(), 2u);
+    EXPECT_EQ(report.m_intermittent_fingerprints[0].m_first_event_id, 1u);
+    EXPECT_EQ(report.m_intermittent_fingerprints[0].m_num_frames, 1u);
+    EXPECT_EQ(report.m_intermittent_fingerprints[1].m_first_event_id, 3u);
+}
+
+}  // namespace
+}  // namespace Dive
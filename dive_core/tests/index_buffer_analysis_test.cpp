@@ -0,0 +1,138 @@
+/*
+ Copyright 2025 Google LLC
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+
+#include "dive_core/index_buffer_analysis.h"
+
+#include <cstring>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "test_memory_manager.h"
+
+namespace Dive
+{
+namespace
+{
+
+TEST(IndexBufferAnalysis, TriangleList)
+{
+    const uint16_t   indices[] = { 0, 1, 2, 2, 1, 3, 3, 3, 0 };
+    IndexBufferStats stats = AnalyzeIndices(indices, 9, 2, IndexTopology::kTriangleList);
+    EXPECT_EQ(stats.m_num_indices, 9u);
+    EXPECT_EQ(stats.m_num_unique_vertices, 4u);
+    EXPECT_EQ(stats.m_num_triangles, 3u);
+    EXPECT_EQ(stats.m_num_degenerate_triangles, 1u);
+    EXPECT_EQ(stats.m_num_cache_misses, 4u);
+    EXPECT_DOUBLE_EQ(stats.GetAcmr(), 4.0 / 3.0);
+    EXPECT_DOUBLE_EQ(stats.GetAtvr(), 1.0);
+}
+
+TEST(IndexBufferAnalysis, FifoCache)
+{
+    // The first vertices are evicted by the time they are drawn again, unless the cache holds all 6
+    const uint32_t indices[] = { 0, 1, 2, 3, 4, 5, 0, 1, 2 };
+    IndexBufferStats stats = AnalyzeIndices(indices, 9, 4, IndexTopology::kTriangleList, 6);
+    EXPECT_EQ(stats.m_num_cache_misses, 6u);
+    stats = AnalyzeIndices(indices, 9, 4, IndexTopology::kTriangleList, 5);
+    EXPECT_EQ(stats.m_num_cache_misses, 9u);
+    EXPECT_DOUBLE_EQ(stats.GetAtvr(), 1.5);
+
+    // A hit does not refresh a vertex, so 0 is evicted after 3 other vertices even though it is
+    // drawn in between
+    const uint32_t fifo_indices[] = { 0, 1, 0, 2, 0, 3, 0 };
+    stats = AnalyzeIndices(fifo_indices, 7, 4, IndexTopology::kOther, 3);
+    EXPECT_EQ(stats.m_num_cache_misses, 5u);
+    EXPECT_EQ(stats.m_num_triangles, 0u);
+    EXPECT_DOUBLE_EQ(stats.GetAcmr(), 0.0);
+}
+
+TEST(IndexBufferAnalysis, StripsAndFans)
+{
+    // Two strips, the second stitched with degenerate triangles
+    const uint8_t    strip[] = { 0, 1, 2, 3, 0xFF, 4, 5, 6, 6, 7 };
+    IndexBufferStats stats = AnalyzeIndices(strip, 10, 1, IndexTopology::kTriangleStrip);
+    EXPECT_EQ(stats.m_num_indices, 10u);
+    EXPECT_EQ(stats.m_num_unique_vertices, 8u);
+    EXPECT_EQ(stats.m_num_triangles, 5u);
+    EXPECT_EQ(stats.m_num_degenerate_triangles, 2u);
+    EXPECT_EQ(stats.m_num_cache_misses, 8u);
+
+    // In a list, 0xFF is a vertex like any other
+    stats = AnalyzeIndices(strip, 9, 1, IndexTopology::kTriangleList);
+    EXPECT_EQ(stats.m_num_unique_vertices, 8u);
+    EXPECT_EQ(stats.m_num_triangles, 3u);
+
+    const uint16_t fan[] = { 0, 1, 2, 3, 4, 0xFFFF, 5, 6, 7 };
+    stats = AnalyzeIndices(fan, 9, 2, IndexTopology::kTriangleFan);
+    EXPECT_EQ(stats.m_num_unique_vertices, 8u);
+    EXPECT_EQ(stats.m_num_triangles, 4u);
+    EXPECT_EQ(stats.m_num_degenerate_triangles, 0u);
+}
+
+TEST(IndexBufferAnalysis, Topology)
+{
+    EXPECT_EQ(GetIndexTopology(4), IndexTopology::kTriangleList);   // DI_PT_TRILIST
+    EXPECT_EQ(GetIndexTopology(5), IndexTopology::kTriangleFan);    // DI_PT_TRIFAN
+    EXPECT_EQ(GetIndexTopology(6), IndexTopology::kTriangleStrip);  // DI_PT_TRISTRIP
+    EXPECT_EQ(GetIndexTopology(2), IndexTopology::kOther);          // DI_PT_LINELIST
+}
+
+TEST(IndexBufferAnalysis, DistinctRanges)
+{
+    // The same 16-bit triangle list at 0x0 and 0x10
+    std::vector<uint8_t> memory(0x20);
+    const uint16_t       indices[] = { 0, 1, 2, 2, 1, 3 };
+    memcpy(memory.data(), indices, sizeof(indices));
+    memcpy(memory.data() + 0x10, indices, sizeof(indices));
+    test::BufferMemoryManager mem_manager(memory);
+
+    // Enough draws to be split over several tasks
+    std::vector<IndexedDrawInfo> draws;
+    for (uint32_t i = 0; i < 1000; ++i)
+    {
+        uint64_t address = (i % 2 == 0) ? 0x0 : 0x10;
+        draws.push_back({ i, 0, address, 6, 2, IndexTopology::kTriangleList });
+    }
+    draws.push_back({ 1000, 0, 0x0, 6, 2, IndexTopology::kTriangleStrip });
+    draws.push_back({ 1001, 0, 0x0, 3, 2, IndexTopology::kTriangleList });
+    draws.push_back({ 1002, 0, 0x1c, 6, 2, IndexTopology::kTriangleList });
+
+    IndexBufferReport report;
+    AnalyzeIndexBuffers(draws, mem_manager, kDefaultVertexCacheSize, 4, report);
+    EXPECT_EQ(report.m_cache_size, kDefaultVertexCacheSize);
+    ASSERT_EQ(report.m_ranges.size(), 3u);
+    ASSERT_EQ(report.m_draws.size(), 1002u);
+    ASSERT_EQ(report.m_unreadable_draws.size(), 1u);
+    EXPECT_EQ(report.m_unreadable_draws[0], 1002u);
+
+    EXPECT_EQ(report.m_draws[1].m_event_id, 1u);
+    EXPECT_EQ(report.m_draws[1].m_range_index, report.m_draws[0].m_range_index);
+    const IndexBufferStats &list = report.m_ranges[report.m_draws[0].m_range_index];
+    EXPECT_EQ(list.m_num_triangles, 2u);
+    const IndexBufferStats &strip = report.m_ranges[report.m_draws[1000].m_range_index];
+    EXPECT_EQ(strip.m_num_triangles, 4u);
+    EXPECT_EQ(strip.m_num_degenerate_triangles, 2u);
+    EXPECT_EQ(report.m_ranges[report.m_draws[1001].m_range_index].m_num_indices, 3u);
+
+    IndexBufferStats totals = report.GetTotals();
+    EXPECT_EQ(totals.m_num_indices, 1000u * 6 + 6 + 3);
+    EXPECT_EQ(totals.m_num_triangles, 1000u * 2 + 4 + 1);
+    EXPECT_EQ(totals.m_num_cache_misses, 1000u * 4 + 4 + 3);
+}
+
+}  // namespace
+}  // namespace Dive
@@ -0,0 +1,116 @@
+/*
+ Copyright 2025 Google LLC
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#include "dive_core/log.h"
+#include "gtest/gtest.h"
+
+namespace Dive
+{
+namespace
+{
+
+ILog::LogEntry MakeEntry(LogType type, const char *short_desc, CrossRef ref = CrossRef())
+{
+    ILog::LogEntry entry = {};
+    entry.m_type = type;
+    entry.m_cat = LogCategory::kParsing;
+    entry.m_file = "file.cpp";
+    entry.m_ref = ref;
+    entry.m_short_desc = short_desc;
+    return entry;
+}
+
+TEST(LogArena, MessagesAreInterned)
+{
+    LogArena arena;
+    for (uint32_t i = 0; i < 1000; ++i)
+    {
+        arena.Log(MakeEntry(LogType::kWarning, "Unknown packet"));
+        arena.Log(MakeEntry(LogType::kError, "Unknown packet"));
+    }
+    arena.Log(MakeEntry(LogType::kWarning, "Unknown register"));
+    EXPECT_EQ(arena.GetNumMessages(), 3u);
+    EXPECT_EQ(arena.GetNumRecords(), 2001u);
+    EXPECT_EQ(arena.GetRecord(0).m_message_id, arena.GetRecord(2).m_message_id);
+    EXPECT_NE(arena.GetRecord(0).m_message_id, arena.GetRecord(1).m_message_id);
+}
+
+TEST(LogArena, EntriesRoundTrip)
+{
+    LogArena       arena;
+    ILog::LogEntry logged = MakeEntry(LogType::kWarning,
+                                      "Shader uses 48 GPRs",
+                                      CrossRef(CrossRefType::kEvent, 7));
+    logged.m_long_desc = "details";
+    logged.m_line = 12;
+    arena.Log(logged);
+
+    ILog::LogEntry entry = arena.GetEntry(0);
+    EXPECT_EQ(entry.m_type, LogType::kWarning);
+    EXPECT_EQ(entry.m_short_desc, "Shader uses 48 GPRs");
+    EXPECT_EQ(entry.m_long_desc, "details");
+    EXPECT_STREQ(entry.m_file, "file.cpp");
+    EXPECT_EQ(entry.m_line, 12);
+    EXPECT_EQ(entry.m_ref.Type(), CrossRefType::kEvent);
+    EXPECT_EQ(entry.m_ref.Id(), 7u);
+}
+
+TEST(LogArena, DefaultRef)
+{
+    LogArena arena;
+    arena.SetDefaultRef(CrossRef(CrossRefType::kEvent, 3));
+    arena.Log(MakeEntry(LogType::kInfo, "a"));
+    arena.Log(MakeEntry(LogType::kInfo, "a", CrossRef(CrossRefType::kNodeIndex, 9)));
+
+    EXPECT_EQ(arena.GetRecord(0).m_ref.Type(), CrossRefType::kEvent);
+    EXPECT_EQ(arena.GetRecord(0).m_ref.Id(), 3u);
+    EXPECT_EQ(arena.GetRecord(1).m_ref.Type(), CrossRefType::kNodeIndex);
+}
+
+TEST(LogArena, FindProblems)
+{
+    LogArena arena;
+    for (uint32_t i = 0; i < 30; ++i)
+    {
+        if (i % 3 == 0)
+            arena.Log(MakeEntry(LogType::kError, "error"));
+        else if (i % 3 == 1)
+            arena.Log(MakeEntry(LogType::kWarning, "warning"));
+        else
+            arena.Log(MakeEntry(LogType::kInfo, "info"));
+    }
+
+    std::vector<uint32_t> problems = arena.FindProblems();
+    ASSERT_EQ(problems.size(), 20u);
+    for (size_t i = 0; i < problems.size(); ++i)
+    {
+        EXPECT_NE(problems[i] % 3, 2u);
+        if (i > 0)
+        {
+            EXPECT_LT(problems[i - 1], problems[i]);
+        }
+    }
+
+    std::vector<uint32_t> errors = arena.FindProblems(LogType::kError);
+    ASSERT_EQ(errors.size(), 10u);
+    for (uint32_t record_index : errors)
+        EXPECT_EQ(arena.GetRecord(record_index).m_message_id, arena.GetRecord(0).m_message_id);
+
+    EXPECT_EQ(arena.FindProblems(LogType::kInfo).size(), 30u);
+}
+
+}  // namespace
+}  // namespace Dive
@@ -0,0 +1,106 @@
+/*
+ Copyright 2025 Google LLC
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+// Helpers for tests that need a small, valid PM4 command stream without a capture file
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "adreno.h"
+
+namespace Dive
+{
+namespace test
+{
+
+inline uint32_t OddParity(uint32_t val)
+{
+    val ^= val >> 16;
+    val ^= val >> 8;
+    val ^= val >> 4;
+    val &= 0xf;
+    return (~0x6996 >> val) & 1;
+}
+
+// Appends a type-7 packet followed by its payload
+inline void AppendType7(std::vector<uint32_t>       &dwords,
+                        uint32_t                     opcode,
+                        const std::vector<uint32_t> &payload = {})
+{
+    uint32_t       count = static_cast<uint32_t>(payload.size());
+    Pm4Type7Header header;
+    header.u32All = 0;
+    header.count = count;
+    header.count_parity = OddParity(count);
+    header.opcode = opcode;
+    header.opcode_parity = OddParity(opcode);
+    header.type = 7;
+    dwords.push_back(header.u32All);
+    dwords.insert(dwords.end(), payload.begin(), payload.end());
+}
+
+// Appends a type-4 packet writing `values` to consecutive registers from `offset`
+inline void AppendType4(std::vector<uint32_t>       &dwords,
+                        uint32_t                     offset,
+                        const std::vector<uint32_t> &values)
+{
+    uint32_t       count = static_cast<uint32_t>(values.size());
+    Pm4Type4Header header;
+    header.u32All = 0;
+    header.count = count;
+    header.count_parity = OddParity(count);
+    header.offset = offset;
+    header.offset_parity = OddParity(offset);
+    header.type = 4;
+    dwords.push_back(header.u32All);
+    dwords.insert(dwords.end(), values.begin(), values.end());
+}
+
+// A single IB of NOPs interleaved with waits, so that both topologies get event nodes
+inline std::vector<uint32_t> CreateNopAndWaitStream(uint32_t num_pairs)
+{
+    std::vector<uint32_t> dwords;
+    for (uint32_t i = 0; i < num_pairs; ++i)
+    {
+        AppendType7(dwords, CP_NOP);
+        AppendType7(dwords, (i % 2) ? CP_WAIT_FOR_IDLE : CP_WAIT_FOR_ME);
+    }
+    return dwords;
+}
+
+// A binning pass followed by `num_tiles` tile render + resolve passes, each holding a few waits.
+// This populates every CommandHierarchy filter list.
+inline std::vector<uint32_t> CreateBinnedPassStream(uint32_t num_tiles)
+{
+    std::vector<uint32_t> dwords;
+    auto                  append_pass = [&dwords](uint32_t marker) {
+        AppendType7(dwords, CP_SET_MARKER, { marker });
+        AppendType7(dwords, CP_WAIT_FOR_IDLE);
+        AppendType7(dwords, CP_WAIT_FOR_ME);
+    };
+    append_pass(RM6_BIN_VISIBILITY);
+    for (uint32_t tile = 0; tile < num_tiles; ++tile)
+    {
+        append_pass(RM6_BIN_RENDER_START);
+        append_pass(RM6_BIN_RESOLVE);
+    }
+    return dwords;
+}
+
+}  // namespace test
+}  // namespace Dive
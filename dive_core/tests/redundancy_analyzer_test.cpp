@@ -0,0 +1,142 @@
+/*
+ Copyright 2025 Google LLC
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#include "dive_core/redundancy_analyzer.h"
+
+#include <vector>
+
+#include "dive_core/pm4_capture_data.h"
+#include "gtest/gtest.h"
+#include "pm4_info.h"
+#include "pm4_test_stream.h"
+#include "test_memory_manager.h"
+
+namespace Dive
+{
+namespace
+{
+
+// Emulates the IB made of `dwords` from `first_dword` on. The dwords before it are only memory
+RedundancyReport Analyze(const std::vector<uint32_t> &dwords, uint32_t first_dword = 0)
+{
+    Pm4InfoInit();
+    IndirectBufferInfo ib_info = {};
+    ib_info.m_va_addr = first_dword * sizeof(uint32_t);
+    ib_info.m_size_in_dwords = static_cast<uint32_t>(dwords.size()) - first_dword;
+    ib_info.m_enable_mask = 0x7;
+    ib_info.m_skip = false;
+
+    DiveVector<IndirectBufferInfo> ibs;
+    ibs.push_back(ib_info);
+    DiveVector<SubmitInfo> submits;
+    submits.emplace_back(EngineType::kUniversal, QueueType::kUniversal, 0, false, std::move(ibs));
+
+    RedundancyReport          report;
+    RedundancyAnalyzer        analyzer(report);
+    test::BufferMemoryManager mem_manager(dwords);
+    EXPECT_TRUE(analyzer.ProcessSubmits(submits, mem_manager));
+    return report;
+}
+
+TEST(RedundancyAnalyzer, RegisterWrites)
+{
+    constexpr uint32_t    kReg = 0x8800;
+    std::vector<uint32_t> dwords;
+    test::AppendType7(dwords, CP_CONTEXT_REG_BUNCH, { kReg, 1, kReg + 1, 2 });
+    test::AppendType7(dwords, CP_CONTEXT_REG_BUNCH, { kReg, 1, kReg + 1, 3 });
+    test::AppendType7(dwords, CP_CONTEXT_REG_BUNCH, { kReg, 1, kReg + 1, 3 });
+
+    RedundancyReport report = Analyze(dwords);
+    ASSERT_EQ(report.m_submits.size(), 1u);
+    const SubmitRedundancy &submit = report.m_submits[0];
+    EXPECT_EQ(submit.m_num_dwords, dwords.size());
+    EXPECT_EQ(submit.m_reg_writes.m_total, 6u);
+    EXPECT_EQ(submit.m_reg_writes.m_redundant, 3u);
+
+    // One pair of the second packet, and the whole third packet
+    EXPECT_EQ(submit.m_reg_writes.m_redundant_dwords, 2u + 5u);
+    EXPECT_EQ(report.m_registers[kReg].m_redundant, 2u);
+    EXPECT_EQ(report.m_registers[kReg + 1].m_redundant, 1u);
+
+    const RedundancyCount &packets = report.m_packets[CP_CONTEXT_REG_BUNCH];
+    EXPECT_EQ(packets.m_total, 3u);
+    EXPECT_EQ(packets.m_redundant, 1u);
+    EXPECT_EQ(packets.m_redundant_dwords, 7u);
+}
+
+TEST(RedundancyAnalyzer, DrawStateGroups)
+{
+    // A group setting one register, bound twice, and the register then written directly
+    constexpr uint32_t    kReg = 0x8800;
+    std::vector<uint32_t> dwords;
+    test::AppendType4(dwords, kReg, { 1 });
+    uint32_t group_dwords = static_cast<uint32_t>(dwords.size());
+
+    // COUNT, BINNING, GMEM and SYSMEM, and GROUP_ID 3, then the group's address (0)
+    uint32_t element = group_dwords | (1u << 20) | (1u << 21) | (1u << 22) | (3u << 24);
+    test::AppendType7(dwords, CP_SET_DRAW_STATE, { element, 0, 0 });
+    test::AppendType7(dwords, CP_SET_DRAW_STATE, { element, 0, 0 });
+    test::AppendType4(dwords, kReg, { 1 });
+
+    RedundancyReport        report = Analyze(dwords, group_dwords);
+    const SubmitRedundancy &submit = report.m_submits[0];
+    EXPECT_EQ(submit.m_num_dwords, dwords.size() - group_dwords);
+    EXPECT_EQ(submit.m_draw_state_groups.m_total, 2u);
+    EXPECT_EQ(submit.m_draw_state_groups.m_redundant, 1u);
+    EXPECT_EQ(submit.m_draw_state_groups.m_redundant_dwords, 4u);
+
+    // The writes of the group are not counted, but the value they set is known
+    EXPECT_EQ(submit.m_reg_writes.m_total, 1u);
+    EXPECT_EQ(submit.m_reg_writes.m_redundant, 1u);
+    EXPECT_EQ(report.m_registers[kReg].m_total, 1u);
+}
+
+TEST(RedundancyAnalyzer, Waits)
+{
+    std::vector<uint32_t> dwords;
+    test::AppendType7(dwords, CP_WAIT_FOR_IDLE);
+    test::AppendType7(dwords, CP_NOP);
+    test::AppendType7(dwords, CP_WAIT_FOR_IDLE);
+    test::AppendType7(dwords, CP_MEM_WRITE, { 0, 0, 0 });
+    test::AppendType7(dwords, CP_WAIT_FOR_IDLE);
+    test::AppendType7(dwords, CP_WAIT_FOR_ME);
+
+    // The first waits of each kind may wait for work of an earlier submit
+    RedundancyReport        report = Analyze(dwords);
+    const SubmitRedundancy &submit = report.m_submits[0];
+    EXPECT_EQ(submit.m_waits.m_total, 4u);
+    EXPECT_EQ(submit.m_waits.m_redundant, 1u);
+    EXPECT_EQ(submit.m_waits.m_redundant_dwords, 1u);
+    EXPECT_EQ(report.m_packets[CP_WAIT_FOR_IDLE].m_redundant, 1u);
+    EXPECT_EQ(report.m_packets[CP_WAIT_FOR_ME].m_redundant, 0u);
+}
+
+TEST(RedundancyAnalyzer, EmptyBins)
+{
+    // The bins hold only a wait each, so everything between their markers can go
+    std::vector<uint32_t> dwords = test::CreateBinnedPassStream(2);
+
+    RedundancyReport        report = Analyze(dwords);
+    const SubmitRedundancy &submit = report.m_submits[0];
+    EXPECT_EQ(submit.m_bins.m_total, 2u);
+    EXPECT_EQ(submit.m_bins.m_redundant, 2u);
+    EXPECT_EQ(submit.GetRedundantDwords(),
+              submit.m_waits.m_redundant_dwords + submit.m_bins.m_redundant_dwords);
+    EXPECT_EQ(report.GetTotals().m_bins.m_redundant, 2u);
+}
+
+}  // namespace
+}  // namespace Dive
@@ -0,0 +1,137 @@
+/*
+ Copyright 2025 Google LLC
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#include "dive_core/render_pass_table.h"
+
+#include "gtest/gtest.h"
+
+namespace Dive
+{
+namespace
+{
+
+TEST(RenderPassTable, FormatBitsPerPixel)
+{
+    EXPECT_EQ(GetFormatBitsPerPixel("FMT6_8_UNORM"), 8u);
+    EXPECT_EQ(GetFormatBitsPerPixel("FMT6_8_8_8_8_UNORM"), 32u);
+    EXPECT_EQ(GetFormatBitsPerPixel("FMT6_5_6_5_UNORM"), 16u);
+    EXPECT_EQ(GetFormatBitsPerPixel("FMT6_10_10_10_2_UNORM_DEST"), 32u);
+    EXPECT_EQ(GetFormatBitsPerPixel("FMT6_16_16_16_16_FLOAT"), 64u);
+    EXPECT_EQ(GetFormatBitsPerPixel("FMT6_32_32_32_32_UINT"), 128u);
+    EXPECT_EQ(GetFormatBitsPerPixel("FMT6_9_9_9_E5_FLOAT"), 32u);
+    EXPECT_EQ(GetFormatBitsPerPixel("FMT6_Z24_UNORM_S8_UINT"), 32u);
+    EXPECT_EQ(GetFormatBitsPerPixel("FMT6_X8Z24_UNORM"), 32u);
+    EXPECT_EQ(GetFormatBitsPerPixel("FMT6_Z32_FLOAT_S8X24_UINT"), 64u);
+    EXPECT_EQ(GetFormatBitsPerPixel("FMT6_ETC2_RGB8"), 0u);
+    EXPECT_EQ(GetFormatBitsPerPixel("FMT6_ASTC_4x4"), 0u);
+    EXPECT_EQ(GetFormatBitsPerPixel("FMT6_R8G8R8B8_422_UNORM"), 0u);
+    EXPECT_EQ(GetFormatBitsPerPixel("FMT6_NONE"), 0u);
+    EXPECT_EQ(GetFormatBitsPerPixel("8_8_8_8_UNORM"), 0u);
+}
+
+TEST(RenderPassTable, ResolveBytes)
+{
+    ResolveInfo resolve = { 0, 1920, 1080, 32, 1 };
+    EXPECT_EQ(resolve.GetNumBytes(), 1920u * 1080u * 4u);
+    resolve.m_num_samples = 4;
+    EXPECT_EQ(resolve.GetNumBytes(), 1920u * 1080u * 16u);
+    resolve.m_bits_per_pixel = 0;
+    EXPECT_EQ(resolve.GetNumBytes(), 0u);
+}
+
+TEST(RenderPassTable, PassesAndBins)
+{
+    RenderPassTable table;
+    table.BeginPass(0, 0, false);
+    EXPECT_TRUE(table.IsPassOpen());
+    EXPECT_FALSE(table.IsTiledPassOpen());
+    table.EndPass(3);
+
+    // A tiled pass with a binning pass, then one without whose first bin revisits a window
+    table.BeginPass(0, 3, true);
+    table.BeginBin(5);
+    table.EndBin(8, 0, 0, 256, 128);
+    table.BeginBin(8);
+    table.EndBin(11, 256, 0, 256, 128);
+    table.BeginBin(11);
+    table.EndBin(13, 0, 0, 256, 128);
+    table.BeginBin(13);
+    table.EndBin(15, 256, 0, 256, 128);
+    table.EndPass(16);
+    EXPECT_FALSE(table.IsPassOpen());
+
+    const std::vector<RenderPassInfo> &passes = table.GetRenderPasses();
+    ASSERT_EQ(passes.size(), 3u);
+    EXPECT_FALSE(passes[0].m_is_tiled);
+    EXPECT_EQ(passes[0].m_end_event, 3u);
+    EXPECT_EQ(passes[0].m_first_bin, passes[0].m_end_bin);
+
+    EXPECT_TRUE(passes[1].m_is_tiled);
+    EXPECT_EQ(passes[1].m_first_event, 3u);
+    EXPECT_EQ(passes[1].m_end_event, 11u);
+    EXPECT_EQ(passes[1].m_first_bin, 0u);
+    EXPECT_EQ(passes[1].m_end_bin, 2u);
+
+    EXPECT_TRUE(passes[2].m_is_tiled);
+    EXPECT_EQ(passes[2].m_first_event, 11u);
+    EXPECT_EQ(passes[2].m_end_event, 16u);
+    EXPECT_EQ(passes[2].m_first_bin, 2u);
+    EXPECT_EQ(passes[2].m_end_bin, 4u);
+
+    const std::vector<BinInfo> &bins = table.GetBins();
+    ASSERT_EQ(bins.size(), 4u);
+    EXPECT_EQ(bins[1].m_first_event, 8u);
+    EXPECT_EQ(bins[1].m_end_event, 11u);
+    EXPECT_EQ(bins[1].m_x, 256u);
+    EXPECT_EQ(bins[1].m_height, 128u);
+}
+
+TEST(RenderPassTable, UnknownWindowsDoNotSplitPasses)
+{
+    RenderPassTable table;
+    table.BeginPass(0, 0, true);
+    for (uint32_t bin = 0; bin < 4; ++bin)
+    {
+        table.BeginBin(bin);
+        table.EndBin(bin + 1, 0, 0, 0, 0);
+    }
+    table.EndPass(4);
+    ASSERT_EQ(table.GetRenderPasses().size(), 1u);
+    EXPECT_EQ(table.GetRenderPasses()[0].m_end_bin, 4u);
+}
+
+TEST(RenderPassTable, FindResolve)
+{
+    RenderPassTable table;
+    table.AddResolve({ 2, 64, 64, 32, 1 });
+    table.AddResolve({ 5, 32, 32, 16, 1 });
+    table.AddResolve({ 9, 16, 16, 8, 4 });
+
+    EXPECT_EQ(table.FindResolve(0), nullptr);
+    EXPECT_EQ(table.FindResolve(6), nullptr);
+    EXPECT_EQ(table.FindResolve(10), nullptr);
+    ASSERT_NE(table.FindResolve(5), nullptr);
+    EXPECT_EQ(table.FindResolve(5)->m_width, 32u);
+    ASSERT_NE(table.FindResolve(9), nullptr);
+    EXPECT_EQ(table.FindResolve(9)->GetNumBytes(), 16u * 16u * 4u);
+
+    table.Clear();
+    EXPECT_TRUE(table.GetResolves().empty());
+    EXPECT_EQ(table.FindResolve(2), nullptr);
+}
+
+}  // namespace
+}  // namespace Dive
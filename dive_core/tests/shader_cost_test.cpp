@@ -0,0 +1,92 @@
+/*
+ Copyright 2025 Google LLC
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#include "dive_core/shader_cost.h"
+
+#include "gtest/gtest.h"
+
+namespace Dive
+{
+namespace
+{
+
+constexpr uint64_t Category(uint64_t category)
+{
+    return category << 61;
+}
+
+uint32_t GetCount(const ShaderCost &cost, ShaderInstructionClass instruction_class)
+{
+    return cost.m_num_instructions[static_cast<uint32_t>(instruction_class)];
+}
+
+TEST(ShaderCost, Categories)
+{
+    ShaderCost cost;
+    cost.AddInstruction(Category(1));
+    cost.AddInstruction(Category(2));
+    cost.AddInstruction(Category(3));
+    cost.AddInstruction(Category(4));
+    cost.AddInstruction(Category(5));
+    cost.AddInstruction(Category(6));
+    cost.AddInstruction(Category(7));
+    cost.AddInstruction(Category(0) | (6ull << 55));  // end
+
+    EXPECT_EQ(GetCount(cost, ShaderInstructionClass::kAlu), 3u);
+    EXPECT_EQ(GetCount(cost, ShaderInstructionClass::kSfu), 1u);
+    EXPECT_EQ(GetCount(cost, ShaderInstructionClass::kTexture), 1u);
+    EXPECT_EQ(GetCount(cost, ShaderInstructionClass::kMemory), 1u);
+    EXPECT_EQ(GetCount(cost, ShaderInstructionClass::kFlow), 2u);
+    EXPECT_EQ(cost.m_num_nops, 0u);
+    EXPECT_EQ(cost.GetCycles(), 3u + 4u + 8u + 8u + 2u);
+}
+
+TEST(ShaderCost, RepeatsAndNops)
+{
+    ShaderCost cost;
+    cost.AddInstruction(Category(2) | (3ull << 40));                // (rpt3)add.f
+    cost.AddInstruction(Category(2) | (1ull << 43) | (1ull << 51));  // (nop3) add.f
+    cost.AddInstruction(Category(3) | (1ull << 15));                // (nop2) mad.f32
+    cost.AddInstruction(Category(0) | (5ull << 40));                // (rpt5)nop
+
+    EXPECT_EQ(GetCount(cost, ShaderInstructionClass::kAlu), 4u + 1u + 1u);
+    EXPECT_EQ(GetCount(cost, ShaderInstructionClass::kFlow), 0u);
+    EXPECT_EQ(cost.m_num_nops, 3u + 2u + 6u);
+    EXPECT_EQ(cost.GetCycles(), 6u + 11u);
+}
+
+TEST(ShaderCost, Syncs)
+{
+    ShaderCost cost;
+    cost.AddInstruction(Category(5) | (1ull << 60));                // (sy)sam
+    cost.AddInstruction(Category(4) | (1ull << 44));                // (ss)rcp
+    cost.AddInstruction(Category(2) | (1ull << 60) | (1ull << 44));  // (sy)(ss)add.f
+    cost.AddInstruction(Category(6) | (1ull << 44));                // No (ss) in cat6
+    EXPECT_EQ(cost.m_num_syncs, 4u);
+}
+
+TEST(ShaderCost, MaxWaves)
+{
+    EXPECT_EQ(GetMaxWavesPerSp(0), 16u);
+    EXPECT_EQ(GetMaxWavesPerSp(12), 16u);
+    EXPECT_EQ(GetMaxWavesPerSp(16), 12u);
+    EXPECT_EQ(GetMaxWavesPerSp(24), 8u);
+    EXPECT_EQ(GetMaxWavesPerSp(48), 4u);
+    EXPECT_EQ(GetMaxWavesPerSp(96), 2u);
+}
+
+}  // namespace
+}  // namespace Dive
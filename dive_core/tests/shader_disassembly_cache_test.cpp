@@ -0,0 +1,205 @@
+/*
+ Copyright 2025 Google LLC
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+#include <vector>
+
+#include "dive_core/shader_disassembly_cache.h"
+#include "gtest/gtest.h"
+
+namespace Dive
+{
+namespace
+{
+
+constexpr uint32_t kGpuId = 740;
+
+class ShaderDisassemblyCacheTest : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        const testing::TestInfo *info = testing::UnitTest::GetInstance()->current_test_info();
+        m_directory = std::filesystem::temp_directory_path() /
+                      (std::string("dive_shader_cache_") + info->name());
+        std::filesystem::remove_all(m_directory);
+        ASSERT_TRUE(m_cache.SetDirectory(m_directory));
+    }
+
+    void TearDown() override { std::filesystem::remove_all(m_directory); }
+
+    static std::vector<uint8_t> CreateShader(uint32_t seed)
+    {
+        std::vector<uint8_t> shader(1000);
+        for (size_t i = 0; i < shader.size(); ++i)
+            shader[i] = static_cast<uint8_t>(i * 7 + seed);
+        return shader;
+    }
+
+    static Disassembly::DisassembledData CreateData(uint32_t seed)
+    {
+        Disassembly::DisassembledData data;
+        data.m_listing = "listing " + std::to_string(seed);
+        for (uint32_t i = 0; i < 10; ++i)
+        {
+            data.m_instructions_text.push_back("mov.u32u32 r0.x, " + std::to_string(i + seed));
+            data.m_instructions_raw.push_back((uint64_t(seed) << 32) | i);
+        }
+        data.m_gpr_count = seed % 64;
+        return data;
+    }
+
+    static ShaderDisassemblyCache::Key KeyOf(const std::vector<uint8_t> &shader)
+    {
+        return ShaderDisassemblyCache::ComputeKey(shader.data(), shader.size(), kGpuId);
+    }
+
+    std::filesystem::path EntryPath(const std::vector<uint8_t> &shader) const
+    {
+        return m_directory / (KeyOf(shader).ToString() + ".dvsc");
+    }
+
+    std::filesystem::path  m_directory;
+    ShaderDisassemblyCache m_cache;
+};
+
+TEST_F(ShaderDisassemblyCacheTest, RoundTrip)
+{
+    std::vector<uint8_t>          shader = CreateShader(1);
+    Disassembly::DisassembledData stored = CreateData(1);
+
+    Disassembly::DisassembledData loaded;
+    EXPECT_FALSE(m_cache.Load(KeyOf(shader), &loaded));
+    m_cache.Store(KeyOf(shader), stored);
+    ASSERT_TRUE(m_cache.Load(KeyOf(shader), &loaded));
+
+    EXPECT_EQ(loaded.m_listing, stored.m_listing);
+    EXPECT_EQ(loaded.m_instructions_text, stored.m_instructions_text);
+    EXPECT_EQ(loaded.m_instructions_raw, stored.m_instructions_raw);
+    EXPECT_EQ(loaded.m_gpr_count, stored.m_gpr_count);
+}
+
+TEST_F(ShaderDisassemblyCacheTest, KeyDependsOnContentsAndGpu)
+{
+    std::vector<uint8_t>        shader = CreateShader(1);
+    ShaderDisassemblyCache::Key key = KeyOf(shader);
+
+    std::vector<uint8_t> modified = shader;
+    modified.back() ^= 1;
+    ShaderDisassemblyCache::Key modified_key = KeyOf(modified);
+    EXPECT_NE(key.ToString(), modified_key.ToString());
+
+    ShaderDisassemblyCache::Key other_gpu_key = ShaderDisassemblyCache::ComputeKey(shader.data(),
+                                                                                   shader.size(),
+                                                                                   kGpuId + 10);
+    EXPECT_NE(key.ToString(), other_gpu_key.ToString());
+
+    m_cache.Store(key, CreateData(1));
+    Disassembly::DisassembledData loaded;
+    EXPECT_FALSE(m_cache.Load(modified_key, &loaded));
+    EXPECT_FALSE(m_cache.Load(other_gpu_key, &loaded));
+}
+
+TEST_F(ShaderDisassemblyCacheTest, CorruptEntryIsAMiss)
+{
+    std::vector<uint8_t> shader = CreateShader(1);
+    m_cache.Store(KeyOf(shader), CreateData(1));
+
+    std::filesystem::path path = EntryPath(shader);
+    ASSERT_TRUE(std::filesystem::exists(path));
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) / 2);
+
+    Disassembly::DisassembledData loaded;
+    EXPECT_FALSE(m_cache.Load(KeyOf(shader), &loaded));
+    EXPECT_FALSE(std::filesystem::exists(path));
+}
+
+TEST_F(ShaderDisassemblyCacheTest, EvictsLeastRecentlyUsed)
+{
+    constexpr uint32_t kNumShaders = 8;
+    for (uint32_t i = 0; i < kNumShaders; ++i)
+    {
+        m_cache.Store(KeyOf(CreateShader(i)), CreateData(i));
+        std::filesystem::last_write_time(EntryPath(CreateShader(i)),
+                                         std::filesystem::file_time_type::clock::now() -
+                                         std::chrono::hours(kNumShaders - i));
+    }
+
+    // Reading shader 0 makes it the most recently used
+    Disassembly::DisassembledData loaded;
+    ASSERT_TRUE(m_cache.Load(KeyOf(CreateShader(0)), &loaded));
+
+    // Room for exactly the 3 most recently used entries
+    uint64_t kept_size = 0;
+    for (uint32_t i : { 0u, kNumShaders - 1, kNumShaders - 2 })
+        kept_size += std::filesystem::file_size(EntryPath(CreateShader(i)));
+    m_cache.Evict(kept_size);
+
+    EXPECT_TRUE(m_cache.Load(KeyOf(CreateShader(0)), &loaded));
+    EXPECT_TRUE(m_cache.Load(KeyOf(CreateShader(kNumShaders - 1)), &loaded));
+    EXPECT_TRUE(m_cache.Load(KeyOf(CreateShader(kNumShaders - 2)), &loaded));
+    for (uint32_t i = 1; i < kNumShaders - 2; ++i)
+        EXPECT_FALSE(m_cache.Load(KeyOf(CreateShader(i)), &loaded));
+}
+
+TEST_F(ShaderDisassemblyCacheTest, RemovesStaleTempFiles)
+{
+    // Left behind by writers that crashed before renaming, long ago and just now
+    std::filesystem::path stale = m_directory / "stale.dvsc.0.0.tmp";
+    std::filesystem::path fresh = m_directory / "fresh.dvsc.0.0.tmp";
+    std::ofstream(stale) << "stale";
+    std::ofstream(fresh) << "fresh";
+    std::filesystem::last_write_time(stale,
+                                     std::filesystem::file_time_type::clock::now() -
+                                     std::chrono::hours(2));
+
+    ShaderDisassemblyCache cache;
+    ASSERT_TRUE(cache.SetDirectory(m_directory));
+    EXPECT_FALSE(std::filesystem::exists(stale));
+    EXPECT_TRUE(std::filesystem::exists(fresh));
+}
+
+TEST_F(ShaderDisassemblyCacheTest, ConcurrentWriters)
+{
+    constexpr uint32_t       kNumThreads = 8;
+    std::vector<std::thread> threads;
+    for (uint32_t t = 0; t < kNumThreads; ++t)
+    {
+        threads.emplace_back([this]() {
+            for (uint32_t i = 0; i < 20; ++i)
+                m_cache.Store(KeyOf(CreateShader(i)), CreateData(i));
+        });
+    }
+    for (std::thread &thread : threads)
+        thread.join();
+
+    for (uint32_t i = 0; i < 20; ++i)
+    {
+        Disassembly::DisassembledData loaded;
+        ASSERT_TRUE(m_cache.Load(KeyOf(CreateShader(i)), &loaded));
+        EXPECT_EQ(loaded.m_listing, CreateData(i).m_listing);
+    }
+
+    // No temporary files are left behind
+    for (const auto &entry : std::filesystem::directory_iterator(m_directory))
+        EXPECT_EQ(entry.path().extension(), ".dvsc");
+}
+
+}  // namespace
+}  // namespace Dive
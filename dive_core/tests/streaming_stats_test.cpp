@@ -0,0 +1,130 @@
+/*
+ Copyright 2025 Google LLC
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#include "dive_core/streaming_stats.h"
+#include <algorithm>
+#include <random>
+#include "gtest/gtest.h"
+
+namespace Dive
+{
+namespace
+{
+
+std::vector<uint64_t> RandomValues(uint32_t count, uint32_t seed)
+{
+    // Log-uniform, like index and instruction counts
+    std::mt19937_64                        rng(seed);
+    std::uniform_real_distribution<double> exponent(0.0, 20.0);
+    std::vector<uint64_t>                  values;
+    for (uint32_t i = 0; i < count; ++i)
+        values.push_back(static_cast<uint64_t>(std::exp2(exponent(rng))) - 1);
+    return values;
+}
+
+TEST(StreamingStats, QuantilesHaveBoundedRelativeError)
+{
+    std::vector<uint64_t> values = RandomValues(100000, 7);
+    StreamingStats        stats;
+    for (uint64_t value : values)
+        stats.Add(value);
+    std::sort(values.begin(), values.end());
+
+    EXPECT_EQ(stats.GetCount(), values.size());
+    EXPECT_EQ(stats.GetMin(), values.front());
+    EXPECT_EQ(stats.GetMax(), values.back());
+    for (double q : { 0.0, 0.1, 0.5, 0.9, 0.99, 1.0 })
+    {
+        double exact = static_cast<double>(values[size_t(q * (values.size() - 1))]);
+        double estimate = static_cast<double>(stats.GetQuantile(q));
+        // Relative error, plus rounding to an integer
+        EXPECT_LE(std::abs(estimate - exact), exact * QuantileSketch::kRelativeAccuracy + 0.5)
+        << "q=" << q;
+    }
+}
+
+TEST(StreamingStats, SmallValuesAreExact)
+{
+    StreamingStats stats;
+    for (uint64_t value : { 3, 0, 1, 4, 1, 5, 9, 2, 6 })
+        stats.Add(value);
+    EXPECT_EQ(stats.GetSum(), 31u);
+    EXPECT_EQ(stats.GetMin(), 0u);
+    EXPECT_EQ(stats.GetMax(), 9u);
+    EXPECT_EQ(stats.GetQuantile(0.5), 3u);
+    EXPECT_EQ(stats.GetQuantile(0.0), 0u);
+    EXPECT_EQ(stats.GetQuantile(1.0), 9u);
+}
+
+TEST(StreamingStats, MergeMatchesSinglePass)
+{
+    std::vector<uint64_t> values = RandomValues(20000, 11);
+    StreamingStats        single;
+    StreamingStats        parts[4];
+    for (size_t i = 0; i < values.size(); ++i)
+    {
+        single.Add(values[i]);
+        parts[i * 4 / values.size()].Add(values[i]);
+    }
+
+    // Merged in any order, the result is identical
+    StreamingStats merged;
+    for (int i = 3; i >= 0; --i)
+        merged.Merge(parts[i]);
+    EXPECT_EQ(merged.GetCount(), single.GetCount());
+    EXPECT_EQ(merged.GetSum(), single.GetSum());
+    EXPECT_EQ(merged.GetMin(), single.GetMin());
+    EXPECT_EQ(merged.GetMax(), single.GetMax());
+    for (double q : { 0.5, 0.9, 0.99 })
+        EXPECT_EQ(merged.GetQuantile(q), single.GetQuantile(q));
+    for (uint32_t bucket = 0; bucket < Log2Histogram::kNumBuckets; ++bucket)
+        EXPECT_EQ(merged.GetHistogram().GetCount(bucket), single.GetHistogram().GetCount(bucket));
+}
+
+TEST(StreamingStats, Log2HistogramBuckets)
+{
+    EXPECT_EQ(Log2Histogram::GetBucket(0), 0u);
+    EXPECT_EQ(Log2Histogram::GetBucket(1), 1u);
+    EXPECT_EQ(Log2Histogram::GetBucket(3), 2u);
+    EXPECT_EQ(Log2Histogram::GetBucket(4), 3u);
+    EXPECT_EQ(Log2Histogram::GetBucket(UINT64_MAX), 64u);
+    EXPECT_EQ(Log2Histogram::GetBucketMin(3), 4u);
+    EXPECT_EQ(Log2Histogram::GetBucketMax(3), 7u);
+    EXPECT_EQ(Log2Histogram::GetBucketMax(64), UINT64_MAX);
+
+    Log2Histogram histogram;
+    histogram.Add(5);
+    histogram.Add(6, 2);
+    EXPECT_EQ(histogram.GetCount(3), 3u);
+}
+
+TEST(StreamingStats, Empty)
+{
+    StreamingStats stats;
+    EXPECT_TRUE(stats.empty());
+    EXPECT_EQ(stats.GetMin(), 0u);
+    EXPECT_EQ(stats.GetMax(), 0u);
+    EXPECT_EQ(stats.GetQuantile(0.5), 0u);
+
+    StreamingStats other;
+    other.Add(42);
+    stats.Merge(other);
+    EXPECT_EQ(stats.GetMin(), 42u);
+    EXPECT_EQ(stats.GetQuantile(0.5), 42u);
+}
+
+}  // namespace
+}  // namespace Dive
@@ -0,0 +1,75 @@
+/*
+ Copyright 2025 Google LLC
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+// Memory manager for tests that read GPU memory without a capture file
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "dive_core/common/memory_manager_base.h"
+
+namespace Dive
+{
+namespace test
+{
+
+// Memory of a single buffer at address 0, in every submit. The buffer must outlive the manager and
+// keep its size
+class BufferMemoryManager : public IMemoryManager
+{
+public:
+    template<typename T>
+    explicit BufferMemoryManager(const std::vector<T> &buffer) :
+        m_data(reinterpret_cast<const uint8_t *>(buffer.data())),
+        m_size(buffer.size() * sizeof(T))
+    {
+    }
+    virtual bool RetrieveMemoryData(void    *buffer_ptr,
+                                    uint32_t submit_index,
+                                    uint64_t va_addr,
+                                    uint64_t size) const override
+    {
+        if (!IsValid(submit_index, va_addr, size))
+            return false;
+        memcpy(buffer_ptr, m_data + va_addr, size);
+        return true;
+    }
+    virtual bool GetMemoryOfUnknownSizeViaCallback(uint32_t     submit_index,
+                                                   uint64_t     va_addr,
+                                                   PfnGetMemory data_callback,
+                                                   void        *user_ptr) const override
+    {
+        return false;
+    }
+    virtual uint64_t GetMaxContiguousSize(uint32_t submit_index, uint64_t va_addr) const override
+    {
+        return (va_addr < m_size) ? m_size - va_addr : 0;
+    }
+    virtual bool IsValid(uint32_t submit_index, uint64_t addr, uint64_t size) const override
+    {
+        return addr <= m_size && size <= m_size - addr;
+    }
+
+private:
+    const uint8_t *m_data;
+    uint64_t       m_size;
+};
+
+}  // namespace test
+}  // namespace Dive
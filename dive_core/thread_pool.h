@@ -0,0 +1,144 @@
+/*
+ Copyright 2025 Google LLC
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace Dive
+{
+
+//--------------------------------------------------------------------------------------------------
+// Minimal fixed-size worker pool. Tasks are run in FIFO order; Wait() blocks until every task
+// submitted so far has finished. Stop() discards tasks that have not started yet.
+class ThreadPool
+{
+public:
+    ThreadPool() = default;
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+    ~ThreadPool() { Stop(); }
+
+    void Run(std::function<void()> &&func)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_tasks.push_back(std::move(func));
+            ++m_num_unfinished;
+        }
+        m_condition_variable.notify_one();
+    }
+
+    void Start(unsigned int num_workers = 0)
+    {
+        num_workers = (num_workers > 0 ? num_workers : GetDefaultThreadCount());
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_running = true;
+        for (unsigned int i = static_cast<unsigned int>(m_workers.size()); i < num_workers; ++i)
+        {
+            m_workers.emplace_back([this]() { this->WorkerImpl(); });
+        }
+    }
+
+    void Wait()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_idle_condition_variable.wait(lock, [this] { return m_num_unfinished == 0; });
+    }
+
+    void Stop()
+    {
+        std::deque<std::thread> workers;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            if (!m_running)
+            {
+                return;
+            }
+            m_running = false;
+            std::swap(workers, m_workers);
+        }
+        m_condition_variable.notify_all();
+        for (std::thread &worker : workers)
+        {
+            worker.join();
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_num_unfinished -= m_tasks.size();
+        m_tasks.clear();
+        m_idle_condition_variable.notify_all();
+    }
+
+    static unsigned int SuggestedNumberOfWorkers(unsigned int task_count)
+    {
+        // We are still bottlenecked by the slowest disassembly task.
+        // 4x less worker than disassembly tasks seems be the point of diminishing return.
+        constexpr unsigned int kLoadFactor = 4;
+        return std::min<unsigned int>((task_count + kLoadFactor - 1) / kLoadFactor,
+                                      GetDefaultThreadCount());
+    }
+
+    static unsigned int GetDefaultThreadCount()
+    {
+        unsigned int count = std::thread::hardware_concurrency();
+        return (count > 1 ? count - 1 : 1);
+    }
+
+private:
+    std::function<void()> NextTask()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_condition_variable.wait(lock, [this] { return !m_running || !m_tasks.empty(); });
+        if (!m_running || m_tasks.empty())
+        {
+            return {};
+        }
+        std::function<void()> result = std::move(m_tasks.front());
+        m_tasks.pop_front();
+        return result;
+    }
+
+    void WorkerImpl()
+    {
+        while (auto task = NextTask())
+        {
+            task();
+
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (--m_num_unfinished == 0)
+            {
+                m_idle_condition_variable.notify_all();
+            }
+        }
+    }
+
+    bool                              m_running = false;
+    size_t                            m_num_unfinished = 0;
+    std::mutex                        m_mutex;
+    std::deque<std::thread>           m_workers;
+    std::deque<std::function<void()>> m_tasks;
+    std::condition_variable           m_condition_variable;
+    std::condition_variable           m_idle_condition_variable;
+};
+
+}  // namespace Dive
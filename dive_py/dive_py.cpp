@@ -0,0 +1,408 @@
+/*
+ Copyright 2025 Google LLC
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+// =====================================================================================================================
+// Python module exposing the columns of a parsed capture as NumPy arrays, for offline analysis
+// with NumPy/pandas. Arrays are read-only views into dive_core's own storage: the EventInfo array,
+// the EventQuery state columns, the CSR shader reference lists, the command hierarchy topologies
+// and the perf counter records. Each view holds a reference to the object that owns its storage,
+// whose viewed arrays are never modified once created, so views stay valid after the Python object
+// goes out of scope.
+//
+//   capture = dive_py.Capture("frame.rd")   # The GIL is released while loading and parsing
+//   df = capture.to_dataframe()
+//   draws = df[df.type == 0]
+// =====================================================================================================================
+
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <limits>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "dive_core/available_metrics.h"
+#include "dive_core/command_hierarchy.h"
+#include "dive_core/data_core.h"
+#include "dive_core/event_query.h"
+#include "dive_core/perf_metrics_data.h"
+#include "py_common.h"
+
+namespace Dive
+{
+
+namespace
+{
+
+//--------------------------------------------------------------------------------------------------
+// View of one field of an array of structs
+template<typename Record, typename T>
+py::array MakeFieldView(const Record *records, size_t count, T Record::*field, py::handle owner)
+{
+    const T *data = (count != 0) ? &(records[0].*field) : nullptr;
+    return MakeArrayView(data, count, sizeof(Record), owner);
+}
+
+//--------------------------------------------------------------------------------------------------
+const char *GetLoadResultString(CaptureData::LoadResult result)
+{
+    switch (result)
+    {
+    case CaptureData::LoadResult::kSuccess:
+        return "success";
+    case CaptureData::LoadResult::kFileIoError:
+        return "file I/O error";
+    case CaptureData::LoadResult::kCorruptData:
+        return "corrupt data";
+    case CaptureData::LoadResult::kVersionError:
+        return "unsupported version";
+    }
+    return "unknown error";
+}
+
+//--------------------------------------------------------------------------------------------------
+// Index of the named EventQuery state column
+uint32_t FindStateColumn(const std::string &name)
+{
+    uint32_t column = EventQuery::FindColumn(name);
+    if (column == UINT32_MAX || !EventQuery::IsStateColumn(column))
+        throw py::key_error("Unknown event state field: " + name);
+    return column;
+}
+
+//--------------------------------------------------------------------------------------------------
+// A loaded and parsed capture. Never modified after construction, so views of its arrays remain
+// valid for as long as they hold a reference to it
+class Capture
+{
+public:
+    explicit Capture(const std::string &file_name) :
+        m_data_core(nullptr)
+    {
+        std::string extension = std::filesystem::path(file_name).extension().string();
+        CaptureData::LoadResult load_result;
+        bool                    parsed;
+        if (extension == ".dive")
+        {
+            load_result = m_data_core.LoadDiveCaptureData(file_name);
+            parsed = (load_result == CaptureData::LoadResult::kSuccess) &&
+                     m_data_core.ParseDiveCaptureData();
+        }
+        else if (extension == ".rd")
+        {
+            load_result = m_data_core.LoadPm4CaptureData(file_name);
+            parsed = (load_result == CaptureData::LoadResult::kSuccess) &&
+                     m_data_core.ParsePm4CaptureData();
+        }
+        else
+        {
+            throw std::invalid_argument("Unsupported capture file (expected .rd or .dive): " +
+                                        file_name);
+        }
+
+        if (load_result != CaptureData::LoadResult::kSuccess)
+        {
+            throw std::runtime_error("Loading capture \"" + file_name +
+                                     "\" failed: " + GetLoadResultString(load_result));
+        }
+        if (!parsed)
+            throw std::runtime_error("Parsing capture \"" + file_name + "\" failed");
+
+        // The metadata keeps the event state delta-encoded. Rather than decoding all of it, each
+        // state column is materialized from its runs the first time it is asked for
+        m_event_query = std::make_unique<EventQuery>(GetMetadata());
+    }
+
+    const CaptureMetadata  &GetMetadata() const { return m_data_core.GetCaptureMetadata(); }
+    const EventQuery       &GetEventQuery() const { return *m_event_query; }
+    const CommandHierarchy &GetCommandHierarchy() const
+    {
+        return m_data_core.GetCommandHierarchy();
+    }
+
+    const Topology &GetTopology(const std::string &name) const
+    {
+        if (name == "submit")
+            return GetCommandHierarchy().GetSubmitHierarchyTopology();
+        if (name == "all_event")
+            return GetCommandHierarchy().GetAllEventHierarchyTopology();
+        throw py::value_error("Unknown topology (expected \"submit\" or \"all_event\"): " + name);
+    }
+
+private:
+    DataCore                    m_data_core;
+    std::unique_ptr<EventQuery> m_event_query;
+};
+
+//--------------------------------------------------------------------------------------------------
+// Perf counter records, with the per-record metric values gathered into one row-major matrix at
+// load time, so the counters can be viewed as a single 2D array
+class PerfCounters
+{
+public:
+    PerfCounters(const std::string &csv_file_name, const std::string &metrics_description_file_name)
+    {
+        m_available_metrics = AvailableMetrics::LoadFromCsv(metrics_description_file_name);
+        if (m_available_metrics == nullptr)
+        {
+            throw std::runtime_error("Loading metrics description \"" +
+                                     metrics_description_file_name + "\" failed");
+        }
+        m_data = PerfMetricsData::LoadFromCsv(csv_file_name, *m_available_metrics);
+        if (m_data == nullptr)
+            throw std::runtime_error("Loading perf counters \"" + csv_file_name + "\" failed");
+
+        const std::vector<PerfMetricsRecord> &records = m_data->GetRecords();
+        size_t num_metrics = m_data->GetMetricNames().size();
+        m_values.assign(records.size() * num_metrics, std::numeric_limits<double>::quiet_NaN());
+        for (size_t i = 0; i < records.size(); ++i)
+        {
+            const std::vector<double> &values = records[i].m_metric_values;
+            std::copy_n(values.begin(),
+                        std::min(values.size(), num_metrics),
+                        m_values.begin() + i * num_metrics);
+        }
+    }
+
+    const std::vector<PerfMetricsRecord> &GetRecords() const { return m_data->GetRecords(); }
+    const std::vector<std::string> &GetMetricNames() const { return m_data->GetMetricNames(); }
+    const std::vector<double>      &GetValues() const { return m_values; }
+
+private:
+    // PerfMetricsData refers to the MetricInfos owned by AvailableMetrics
+    std::unique_ptr<AvailableMetrics> m_available_metrics;
+    std::unique_ptr<PerfMetricsData>  m_data;
+    std::vector<double>               m_values;
+};
+
+//--------------------------------------------------------------------------------------------------
+py::dict GetEventInfoColumns(py::object owner)
+{
+    const EventInfoTable &event_info = owner.cast<const Capture &>().GetMetadata().m_event_info;
+    const EventInfo      *data = event_info.data();
+    size_t                count = event_info.size();
+
+    py::dict columns;
+    columns["type"] = MakeFieldView(data, count, &EventInfo::m_type, owner);
+    columns["render_mode"] = MakeFieldView(data, count, &EventInfo::m_render_mode, owner);
+    columns["submit"] = MakeFieldView(data, count, &EventInfo::m_submit_index, owner);
+    columns["num_indices"] = MakeFieldView(data, count, &EventInfo::m_num_indices, owner);
+    columns["num_instances"] = MakeFieldView(data, count, &EventInfo::m_num_instances, owner);
+    return columns;
+}
+
+//--------------------------------------------------------------------------------------------------
+py::dict GetEventStateColumns(py::object owner)
+{
+    const EventQuery &query = owner.cast<const Capture &>().GetEventQuery();
+
+    py::dict columns;
+    for (uint32_t column = 0; column < EventQuery::GetNumColumns(); ++column)
+    {
+        if (!EventQuery::IsStateColumn(column))
+            continue;
+        const std::vector<double> &values = query.GetColumn(column);
+        columns[EventQuery::GetColumnName(column)] = MakeArrayView(values.data(),
+                                                                   values.size(),
+                                                                   sizeof(double),
+                                                                   owner);
+    }
+    return columns;
+}
+
+//--------------------------------------------------------------------------------------------------
+py::dict GetTopologyColumns(py::object owner, const std::string &name)
+{
+    const Topology &topology = owner.cast<const Capture &>().GetTopology(name);
+    size_t          num_nodes = topology.GetNumNodes();
+
+    py::dict columns;
+    columns["parent"] = MakeArrayView(topology.GetParentNodeIndexData(),
+                                      num_nodes,
+                                      sizeof(uint64_t),
+                                      owner);
+    columns["child_index"] = MakeArrayView(topology.GetChildIndexData(),
+                                           num_nodes,
+                                           sizeof(uint64_t),
+                                           owner);
+    columns["children"] = MakeArrayView(topology.GetChildrenData(),
+                                        num_nodes,
+                                        2,
+                                        2 * sizeof(uint64_t),
+                                        owner);
+    columns["children_list"] = MakeArrayView(topology.GetChildrenListData(),
+                                             topology.GetChildrenListSize(),
+                                             sizeof(uint64_t),
+                                             owner);
+    return columns;
+}
+
+}  // namespace
+}  // namespace Dive
+
+// =================================================================================================
+// Module
+// =================================================================================================
+PYBIND11_MODULE(dive_py, m)
+{
+    using namespace Dive;
+
+    m.doc() = "Zero-copy NumPy views of the data in a Dive capture";
+
+    py::class_<Capture>(m, "Capture")
+    .def(py::init<const std::string &>(),
+         py::arg("file_name"),
+         py::call_guard<py::gil_scoped_release>(),
+         "Loads and parses a .rd or .dive capture")
+    .def_property_readonly("num_events",
+                           [](const Capture &self) {
+                               return self.GetMetadata().m_event_info.size();
+                           })
+    .def("event_info",
+         &GetEventInfoColumns,
+         "Per-event columns of EventInfo: type, render_mode, submit, num_indices and "
+         "num_instances")
+    .def("event_state",
+         &GetEventStateColumns,
+         "Per-event float64 columns of the EventQuery state fields. NaN where an event never set "
+         "the field, unless the field has a known default; see event_state_is_set()")
+    .def(
+    "event_state_is_set",
+    [](const Capture &self, const std::string &name) {
+        const std::vector<double> &values = self.GetEventQuery().GetColumn(FindStateColumn(name));
+        py::array_t<bool>          is_set(values.size());
+        bool                      *data = is_set.mutable_data();
+        for (size_t i = 0; i < values.size(); ++i)
+            data[i] = !std::isnan(values[i]);
+        return is_set;
+    },
+    py::arg("name"),
+    "Per-event mask of the events with a value for the named event state field (a copy)")
+    .def(
+    "shader_references",
+    [](py::object owner) {
+        const EventInfoTable &event_info = owner.cast<const Capture &>()
+                                           .GetMetadata()
+                                           .m_event_info;
+        std::span<const ShaderReference> refs = event_info.GetAllShaderReferences();
+        std::span<const uint32_t>        offsets = event_info.GetShaderReferenceOffsets();
+
+        py::dict columns;
+        columns["offsets"] = MakeArrayView(offsets.data(),
+                                           offsets.size(),
+                                           sizeof(uint32_t),
+                                           owner);
+        columns["shader_index"] = MakeFieldView(refs.data(),
+                                                refs.size(),
+                                                &ShaderReference::m_shader_index,
+                                                owner);
+        columns["stage"] = MakeFieldView(refs.data(),
+                                         refs.size(),
+                                         &ShaderReference::m_stage,
+                                         owner);
+        columns["enable_mask"] = MakeFieldView(refs.data(),
+                                               refs.size(),
+                                               &ShaderReference::m_enable_mask,
+                                               owner);
+        return columns;
+    },
+    "Shader references of all events in CSR form: event i's references are rows "
+    "[offsets[i], offsets[i + 1])")
+    .def(
+    "node_types",
+    [](py::object owner) {
+        const CommandHierarchy &hierarchy = owner.cast<const Capture &>().GetCommandHierarchy();
+        return MakeArrayView(hierarchy.GetNodeTypeData(),
+                             hierarchy.size(),
+                             sizeof(NodeType),
+                             owner);
+    },
+    "NodeType of every command hierarchy node")
+    .def("topology",
+         &GetTopologyColumns,
+         py::arg("name") = "all_event",
+         "Topology (\"submit\" or \"all_event\") of the command hierarchy: per-node parent, "
+         "child_index and (start, count) children into children_list")
+    .def(
+    "to_dataframe",
+    [](py::object owner) {
+        py::dict columns = GetEventInfoColumns(owner);
+        for (auto item : GetEventStateColumns(owner))
+            columns[item.first] = item.second;
+        return py::module::import("pandas").attr("DataFrame")(columns);
+    },
+    "pandas DataFrame with one row per event, of the event_info() and event_state() columns");
+
+    py::class_<PerfCounters>(m, "PerfCounters")
+    .def(py::init<const std::string &, const std::string &>(),
+         py::arg("csv_file_name"),
+         py::arg("metrics_description_file_name"),
+         py::call_guard<py::gil_scoped_release>(),
+         "Loads perf counter records from a CSV file")
+    .def_property_readonly("metric_names", &PerfCounters::GetMetricNames)
+    .def(
+    "records",
+    [](py::object owner) {
+        const std::vector<PerfMetricsRecord> &records = owner.cast<const PerfCounters &>()
+                                                        .GetRecords();
+        const PerfMetricsRecord *data = records.data();
+        size_t                   count = records.size();
+
+        py::dict columns;
+        columns["context_id"] = MakeFieldView(data,
+                                              count,
+                                              &PerfMetricsRecord::m_context_id,
+                                              owner);
+        columns["process_id"] = MakeFieldView(data,
+                                              count,
+                                              &PerfMetricsRecord::m_process_id,
+                                              owner);
+        columns["frame_id"] = MakeFieldView(data, count, &PerfMetricsRecord::m_frame_id, owner);
+        columns["cmd_buffer_id"] = MakeFieldView(data,
+                                                 count,
+                                                 &PerfMetricsRecord::m_cmd_buffer_id,
+                                                 owner);
+        columns["draw_id"] = MakeFieldView(data, count, &PerfMetricsRecord::m_draw_id, owner);
+        columns["draw_label"] = MakeFieldView(data,
+                                              count,
+                                              &PerfMetricsRecord::m_draw_label,
+                                              owner);
+        columns["program_id"] = MakeFieldView(data,
+                                              count,
+                                              &PerfMetricsRecord::m_program_id,
+                                              owner);
+        columns["draw_type"] = MakeFieldView(data, count, &PerfMetricsRecord::m_draw_type, owner);
+        columns["lrz_state"] = MakeFieldView(data, count, &PerfMetricsRecord::m_lrz_state, owner);
+        return columns;
+    },
+    "Per-record identifying columns")
+    .def(
+    "values",
+    [](py::object owner) {
+        const PerfCounters &self = owner.cast<const PerfCounters &>();
+        size_t              num_metrics = self.GetMetricNames().size();
+        return MakeArrayView(self.GetValues().data(),
+                             self.GetRecords().size(),
+                             num_metrics,
+                             num_metrics * sizeof(double),
+                             owner);
+    },
+    "Metric values, one row per record and one column per metric_names entry. NaN where a "
+    "record has no value");
+}
@@ -0,0 +1,80 @@
+/*
+ Copyright 2025 Google LLC
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+// Shared by the dive_py module and the SOA bindings generated from struct_of_arrays.jinja
+
+#pragma once
+#include <cstddef>
+#include <type_traits>
+
+#include <pybind11/numpy.h>
+#include <pybind11/pybind11.h>
+
+namespace py = pybind11;
+
+namespace Dive
+{
+
+//--------------------------------------------------------------------------------------------------
+// NumPy element type used to view a C++ array of T. Enums are viewed as their underlying type
+template<typename T, typename Enable = void> struct numpy_type
+{
+    using type = T;
+};
+
+template<typename T> struct numpy_type<T, std::enable_if_t<std::is_enum_v<T>>>
+{
+    using type = std::underlying_type_t<T>;
+};
+
+//--------------------------------------------------------------------------------------------------
+// Read-only NumPy view of `count` elements starting at `data`, `stride` bytes apart. Nothing is
+// copied: `owner` becomes the array's base, so it stays alive as long as the array (or any view
+// derived from it) does. The caller guarantees that `owner` never reallocates the data
+template<typename T>
+py::array MakeArrayView(const T *data, size_t count, size_t stride, py::handle owner)
+{
+    using NumpyT = typename numpy_type<T>::type;
+    static_assert(sizeof(NumpyT) == sizeof(T));
+    py::array_t<NumpyT> array({ static_cast<py::ssize_t>(count) },
+                              { static_cast<py::ssize_t>(stride) },
+                              reinterpret_cast<const NumpyT *>(data),
+                              owner);
+    array.attr("setflags")(py::arg("write") = false);
+    return array;
+}
+
+//--------------------------------------------------------------------------------------------------
+// Read-only 2D view of `rows` x `cols` elements, rows `row_stride` bytes apart
+template<typename T>
+py::array MakeArrayView(const T   *data,
+                        size_t     rows,
+                        size_t     cols,
+                        size_t     row_stride,
+                        py::handle owner)
+{
+    using NumpyT = typename numpy_type<T>::type;
+    static_assert(sizeof(NumpyT) == sizeof(T));
+    py::array_t<NumpyT> array({ static_cast<py::ssize_t>(rows), static_cast<py::ssize_t>(cols) },
+                              { static_cast<py::ssize_t>(row_stride),
+                                static_cast<py::ssize_t>(sizeof(T)) },
+                              reinterpret_cast<const NumpyT *>(data),
+                              owner);
+    array.attr("setflags")(py::arg("write") = false);
+    return array;
+}
+
+}  // namespace Dive
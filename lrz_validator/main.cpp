@@ -13,132 +13,64 @@
  See the License for the specific language governing permissions and
  limitations under the License.
 */
+#include <fstream>
 #include <iostream>
-#include <optional>
+#include <sstream>
 #include <vector>
 
 #include "dive_core/data_core.h"
+#include "dive_core/event_rules.h"
 #include "pm4_info.h"
 
-bool ValidateLRZ(const Dive::CaptureMetadata &meta_data, const std::string &output_file_name)
+// Evaluates all rules in one pass over the capture. Text is only formatted for the violations, and
+// only when an output file is given. Returns false if any rule is violated
+bool ValidateRules(const Dive::CaptureMetadata &meta_data,
+                   const Dive::EventRuleSet    &rules,
+                   const std::string           &output_file_name)
 {
-    size_t                       event_count = meta_data.m_event_info.size();
-    const Dive::EventStateInfo  &event_state = meta_data.m_event_state;
-    bool                         lrz_test_passed = true;
-    std::optional<std::ofstream> output_file = std::nullopt;
+    Dive::EventQuery                   query(meta_data);
+    std::vector<std::vector<uint32_t>> violations;
+    rules.Evaluate(query, &violations);
+
+    std::ofstream output_file;
     if (!output_file_name.empty())
     {
         std::cout << "Output detailed validation result to \"" << output_file_name << "\""
                   << std::endl;
-        output_file.emplace(std::ofstream(output_file_name));
-    }
-
-    std::function<void(const std::string &)> OutputDetails;
-
-    if (output_file.has_value())
-    {
-        OutputDetails = [&output_file](const std::string &str) { *output_file << str; };
-    }
-    else
-    {
-        OutputDetails = [](const std::string &) {};
+        output_file.open(output_file_name);
     }
 
-    for (size_t i = 0; i < event_count; ++i)
+    bool passed = true;
+    for (uint32_t rule_index = 0; rule_index < rules.size(); ++rule_index)
     {
-        const Dive::EventInfo &info = meta_data.m_event_info[i];
-        // We only output the drawcalls in direct/binning mode
-        if ((info.m_type == Dive::EventInfo::EventType::kDraw) &&
-            (info.m_render_mode == Dive::RenderModeType::kDirect ||
-             info.m_render_mode == Dive::RenderModeType::kBinningVis ||
-             info.m_render_mode == Dive::RenderModeType::kBinningDirect))
+        const Dive::EventRule       &rule = rules.GetRule(rule_index);
+        const std::vector<uint32_t> &event_ids = violations[rule_index];
+        if (event_ids.empty())
+        {
+            std::cout << "[Pass] " << rule.m_name << "\n";
+            continue;
+        }
+        passed = false;
+        std::cout << "[Fail] " << rule.m_name << ": " << event_ids.size() << " event(s)";
+        if (!rule.m_description.empty())
+            std::cout << ". " << rule.m_description;
+        std::cout << "\n";
+
+        if (!output_file.is_open())
+            continue;
+        output_file << "[" << rule.m_name << "] " << rule.m_description << "\n";
+        for (uint32_t event_id : event_ids)
         {
             // This is just to align the strings so that they are easier to read
-            auto AppendSpace = [](std::string &str, uint32_t desired_len) {
-                if (str.length() < desired_len)
-                {
-                    str.append(desired_len - str.length(), ' ');
-                }
-            };
-
-            const uint32_t event_id = static_cast<uint32_t>(i);
-            auto event_state_it = event_state.find(static_cast<Dive::EventStateId>(event_id));
-
-            const uint32_t desired_draw_string_len = 64;
-            std::string    draw_string = info.m_str;
-            AppendSpace(draw_string, desired_draw_string_len);
-            OutputDetails(draw_string + "\t");
-
-            const bool  is_depth_test_enabled = event_state_it->DepthTestEnabled();
-            const bool  is_depth_write_enabled = event_state_it->DepthWriteEnabled();
-            VkCompareOp zfunc = event_state_it->DepthCompareOp();
-
-            OutputDetails("DepthTest:" +
-                          std::string(is_depth_test_enabled ? "Enabled\t" : "Disabled\t"));
-            OutputDetails("DepthWrite:" +
-                          std::string(is_depth_write_enabled ? "Enabled\t" : "Disabled\t"));
-
-            std::string zfunc_str = "Invalid";
-            switch (zfunc)
-            {
-            case VK_COMPARE_OP_NEVER:
-                zfunc_str = "Never";
-                break;
-            case VK_COMPARE_OP_LESS:
-                zfunc_str = "Less";
-                break;
-            case VK_COMPARE_OP_EQUAL:
-                zfunc_str = "Equal";
-                break;
-            case VK_COMPARE_OP_LESS_OR_EQUAL:
-                zfunc_str = "Less or Equal";
-                break;
-            case VK_COMPARE_OP_GREATER:
-                zfunc_str = "Greater";
-                break;
-            case VK_COMPARE_OP_NOT_EQUAL:
-                zfunc_str = "Not Equal";
-                break;
-            case VK_COMPARE_OP_GREATER_OR_EQUAL:
-                zfunc_str = "Greater or Equal";
-                break;
-            case VK_COMPARE_OP_ALWAYS:
-                zfunc_str = "Always";
-                break;
-            default:
-                DIVE_ASSERT(false);
-                break;
-            }
-            const uint32_t desired_zfunc_str_len = 16;
-            AppendSpace(zfunc_str, desired_zfunc_str_len);
-            OutputDetails("DepthFunc:" + zfunc_str + "\t");
-            if (is_depth_test_enabled)
-            {
-                const bool lrz_enabled = event_state_it->LRZEnabled();
-                if (!lrz_enabled)
-                {
-                    OutputDetails("LRZ:Disabled\t");
-                    // if depth func is Always or Never, we don't really care about LRZ
-                    if (is_depth_test_enabled &&
-                        ((zfunc != VK_COMPARE_OP_NEVER) && (zfunc != VK_COMPARE_OP_ALWAYS)))
-                    {
-                        lrz_test_passed = false;
-                        OutputDetails("[WARNING!] LRZ is disabled with performance penalties!");
-                    }
-                }
-                else
-                {
-                    OutputDetails("LRZ:Enabled\t");
-                }
-            }
-            else
-            {
-                OutputDetails("LRZ:Disabled\t");
-            }
-            OutputDetails("\n");
+            const size_t desired_event_string_len = 64;
+            std::string  event_string(meta_data.m_event_info.GetString(event_id));
+            if (event_string.length() < desired_event_string_len)
+                event_string.append(desired_event_string_len - event_string.length(), ' ');
+            output_file << event_string << "\t"
+                        << rules.FormatViolation(query, rule_index, event_id) << "\n";
         }
     }
-    return lrz_test_passed;
+    return passed;
 }
 
 int main(int argc, char **argv)
@@ -146,18 +78,67 @@ int main(int argc, char **argv)
     Pm4InfoInit();
 
     // Handle args
-    if ((argc != 2) && (argc != 3))
+    std::string input_file_name;
+    std::string output_file_name;
+    std::string rules_file_name;
+    bool        use_default_rules = true;
+    bool        valid_args = true;
+    for (int i = 1; i < argc && valid_args; ++i)
+    {
+        std::string arg = argv[i];
+        if (arg == "--rules" && i + 1 < argc)
+            rules_file_name = argv[++i];
+        else if (arg == "--no-default-rules")
+            use_default_rules = false;
+        else if (input_file_name.empty())
+            input_file_name = arg;
+        else if (output_file_name.empty())
+            output_file_name = arg;
+        else
+            valid_args = false;
+    }
+    if (!valid_args || input_file_name.empty())
     {
         std::cout << "You need to call: lrz_validator <input_file_name.rd> "
-                     "<output_details_file_name.txt>(optional)";
+                     "<output_details_file_name.txt>(optional) [--rules <rules_file.txt>] "
+                     "[--no-default-rules]\n"
+                     "Each line of a rules file is \"<name>: <condition>[, <condition>...]\", "
+                     "with conditions as accepted by the query command (e.g. "
+                     "\"type==draw\").";
         return 0;
     }
-    char *input_file_name = argv[1];
 
-    std::string output_file_name = "";
-    if (argc == 3)
+    Dive::EventRuleSet rules;
+    if (use_default_rules)
+    {
+        for (const Dive::EventRule &rule : Dive::GetDefaultEventRules())
+        {
+            bool added = rules.AddRule(rule);
+            DIVE_ASSERT(added);
+            (void)added;
+        }
+    }
+    if (!rules_file_name.empty())
+    {
+        std::ifstream rules_file(rules_file_name);
+        if (!rules_file)
+        {
+            std::cout << "Failed to open rules file \"" << rules_file_name << "\"!";
+            return 0;
+        }
+        std::stringstream text;
+        text << rules_file.rdbuf();
+        std::string error;
+        if (!rules.AddRules(text.str(), &error))
+        {
+            std::cout << error;
+            return 0;
+        }
+    }
+    if (rules.size() == 0)
     {
-        output_file_name = argv[2];
+        std::cout << "No rules to validate!";
+        return 0;
     }
 
     // Load capture
@@ -176,20 +157,13 @@ int main(int argc, char **argv)
         std::cout << "Failed to create meta data!";
         return 0;
     }
-    std::cout << "Validating LRZ...\n";
+    std::cout << "Validating " << rules.size() << " rule(s)...\n";
 
-    // LRZ Validation
     const Dive::CaptureMetadata &meta_data = data_core->GetCaptureMetadata();
-    const bool                   lrz_test_passed = ValidateLRZ(meta_data, output_file_name);
-    if (lrz_test_passed)
-    {
-        std::cout << "[LRZ Pass] LRZ is correctly set for all drawcalls!\n";
-    }
+    if (ValidateRules(meta_data, rules, output_file_name))
+        std::cout << "All rules passed for all events!\n";
     else
-    {
-        std::cout << "[LRZ Fail] Some drawcalls have LRZ disabled but depth test is enabled and "
-                     "depth func is not set to NEVER or ALWAYS!\n";
-    }
+        std::cout << "Some events violate the rules above!\n";
 
     return 1;
 }
@@ -20,55 +20,606 @@
 #include <numeric>
 #include <set>
 #include <array>
+#include <algorithm>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
 
 #include "dive_core/context.h"
 #include "dive_core/data_core.h"
+#include "dive_core/thread_pool.h"
 #include "trace_stats.h"
 #include "pm4_info.h"
 
+namespace
+{
+
+// A parsed capture takes several times its file size in memory. Used to estimate how many captures
+// fit in the memory budget of the batch mode
+constexpr uint64_t kMemoryPerCaptureByte = 8;
+
+//--------------------------------------------------------------------------------------------------
+// Bytes shared by the captures processed concurrently
+class MemoryBudget
+{
+public:
+    explicit MemoryBudget(uint64_t budget) :
+        m_budget(budget),
+        m_available(budget)
+    {
+    }
+
+    // Blocks until `size` bytes are available, and returns the bytes to release. A request larger
+    // than the whole budget waits for every other capture to be done
+    uint64_t Acquire(uint64_t size)
+    {
+        size = std::min(size, m_budget);
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_condition_variable.wait(lock, [this, size] { return m_available >= size; });
+        m_available -= size;
+        return size;
+    }
+
+    void Release(uint64_t size)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_available += size;
+        }
+        m_condition_variable.notify_all();
+    }
+
+private:
+    const uint64_t          m_budget;
+    uint64_t                m_available;
+    std::mutex              m_mutex;
+    std::condition_variable m_condition_variable;
+};
+
+struct BatchResult
+{
+    std::string        m_error;  // Empty on success
+    Dive::CaptureStats m_stats;
+};
+
+//--------------------------------------------------------------------------------------------------
+const char *GetLoadResultString(Dive::CaptureData::LoadResult result)
+{
+    switch (result)
+    {
+    case Dive::CaptureData::LoadResult::kSuccess:
+        return "success";
+    case Dive::CaptureData::LoadResult::kFileIoError:
+        return "file I/O error";
+    case Dive::CaptureData::LoadResult::kCorruptData:
+        return "corrupt data";
+    case Dive::CaptureData::LoadResult::kVersionError:
+        return "unsupported version";
+    }
+    return "unknown error";
+}
+
+//--------------------------------------------------------------------------------------------------
+// The .rd captures under a directory, in sorted order, or the captures listed one per line in a
+// file. Empty lines and lines starting with '#' are skipped
+bool CollectCaptures(const std::filesystem::path &input, std::vector<std::string> &captures)
+{
+    std::error_code ec;
+    if (std::filesystem::is_directory(input, ec))
+    {
+        for (auto it = std::filesystem::recursive_directory_iterator(input, ec);
+             !ec && it != std::filesystem::recursive_directory_iterator();
+             it.increment(ec))
+        {
+            if (it->is_regular_file(ec) && it->path().extension() == ".rd")
+                captures.push_back(it->path().string());
+        }
+        std::sort(captures.begin(), captures.end());
+        return !ec;
+    }
+
+    std::ifstream list(input);
+    if (!list)
+        return false;
+    std::string line;
+    while (std::getline(list, line))
+    {
+        line.erase(line.find_last_not_of(" \t\r") + 1);
+        line.erase(0, line.find_first_not_of(" \t"));
+        if (!line.empty() && line[0] != '#')
+            captures.push_back(line);
+    }
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+// Gathers the stats of a capture on at most `num_threads` threads, see TraceStats::GatherTraceStats
+BatchResult GatherCaptureStats(const std::string &file_name, unsigned int num_threads)
+{
+    BatchResult result;
+    try
+    {
+        Dive::DataCore                data_core;
+        Dive::CaptureData::LoadResult load_res = data_core.LoadPm4CaptureData(file_name);
+        if (load_res != Dive::CaptureData::LoadResult::kSuccess)
+        {
+            result.m_error = std::string("loading failed: ") + GetLoadResultString(load_res);
+            return result;
+        }
+        if (!data_core.CreatePm4MetaData())
+        {
+            result.m_error = "failed to create meta data";
+            return result;
+        }
+
+        Dive::TraceStats trace_stats;
+        trace_stats.GatherTraceStats(Dive::Context::Background(),
+                                     data_core.GetCaptureMetadata(),
+                                     result.m_stats,
+                                     num_threads);
+    }
+    catch (const std::exception &e)
+    {
+        result.m_error = e.what();
+    }
+    return result;
+}
+
+//--------------------------------------------------------------------------------------------------
+// Gathers the stats of many captures concurrently, and writes them as a tab-separated table with
+// one row per capture and one column per stat. Returns 0 if every capture was processed, 2 if any
+// failed, and 1 on error
+int RunBatch(int argc, char **argv)
+{
+    const char  *input = nullptr;
+    const char  *output_file_name = nullptr;
+    unsigned int num_jobs = Dive::ThreadPool::GetDefaultThreadCount();
+    uint64_t     memory_budget = UINT64_MAX;
+    bool         valid_args = true;
+    for (int i = 2; i < argc; ++i)
+    {
+        if (!strcmp(argv[i], "--jobs") && i + 1 < argc)
+            num_jobs = static_cast<unsigned int>(std::max(1, atoi(argv[++i])));
+        else if (!strcmp(argv[i], "--memory-budget-mb") && i + 1 < argc)
+            memory_budget = std::max<uint64_t>(1, strtoull(argv[++i], nullptr, 10)) << 20;
+        else if (!strcmp(argv[i], "--output") && i + 1 < argc)
+            output_file_name = argv[++i];
+        else if (input == nullptr)
+            input = argv[i];
+        else
+            valid_args = false;
+    }
+    if (!valid_args || input == nullptr)
+    {
+        std::cout << "You need to call: trace_stats --batch <capture_directory | capture_list.txt> "
+                     "[--jobs <n>] [--memory-budget-mb <mb>] [--output <stats.tsv>]\n"
+                     "  Exits with 0 if every capture was processed, 2 if any failed, and 1 on "
+                     "error\n";
+        return 1;
+    }
+
+    std::vector<std::string> captures;
+    if (!CollectCaptures(input, captures))
+    {
+        std::cerr << "Not able to read captures from \"" << input << "\"\n";
+        return 1;
+    }
+
+    // Split the threads between the jobs, so that they do not oversubscribe the cores
+    unsigned int threads_per_job = std::max(1u,
+                                            Dive::ThreadPool::GetDefaultThreadCount() / num_jobs);
+
+    std::vector<BatchResult> results(captures.size());
+    MemoryBudget             budget(memory_budget);
+    std::mutex               progress_mutex;
+    size_t                   num_done = 0;
+    {
+        Dive::ThreadPool thread_pool;
+        thread_pool.Start(std::min<unsigned int>(num_jobs,
+                                                 std::max<size_t>(captures.size(), 1)));
+        for (size_t i = 0; i < captures.size(); ++i)
+        {
+            thread_pool.Run([&, i]() {
+                std::error_code ec;
+                uint64_t        file_size = std::filesystem::file_size(captures[i], ec);
+                uint64_t        estimate = ec ? 0 : file_size * kMemoryPerCaptureByte;
+                uint64_t        reserved = budget.Acquire(estimate);
+                results[i] = GatherCaptureStats(captures[i], threads_per_job);
+                budget.Release(reserved);
+
+                std::lock_guard<std::mutex> lock(progress_mutex);
+                ++num_done;
+                std::cerr << "[" << num_done << "/" << captures.size() << "] " << captures[i];
+                if (!results[i].m_error.empty())
+                    std::cerr << ": " << results[i].m_error;
+                std::cerr << "\n";
+            });
+        }
+        thread_pool.Wait();
+    }
+
+    std::ostream *ostream = &std::cout;
+    std::ofstream ofstream;
+    if (output_file_name != nullptr)
+    {
+        ofstream.open(output_file_name);
+        if (!ofstream)
+        {
+            std::cerr << "Not able to open \"" << output_file_name << "\"\n";
+            return 1;
+        }
+        ostream = &ofstream;
+    }
+
+    // Rows are in input order, whatever order the captures finished in
+    *ostream << "capture\tstatus";
+    for (const auto &[stat, key] : Dive::kStatKeyMap)
+        *ostream << "\t" << key;
+    *ostream << "\n";
+
+    size_t num_failed = 0;
+    for (size_t i = 0; i < captures.size(); ++i)
+    {
+        const BatchResult &result = results[i];
+        *ostream << captures[i] << "\t" << (result.m_error.empty() ? "ok" : result.m_error);
+        for (uint64_t value : result.m_stats.m_stats_list)
+        {
+            *ostream << "\t";
+            if (result.m_error.empty())
+                *ostream << value;
+        }
+        *ostream << "\n";
+        num_failed += result.m_error.empty() ? 0 : 1;
+    }
+
+    std::cerr << captures.size() << " captures processed, " << num_failed << " failed\n";
+    return num_failed == 0 ? 0 : 2;
+}
+
+//--------------------------------------------------------------------------------------------------
+// Parses "<stat_key>=<max_increase>[%]"
+bool ParseThreshold(const char *arg, Dive::StatThreshold &threshold)
+{
+    const char *separator = strchr(arg, '=');
+    if (separator == nullptr ||
+        !Dive::FindStatByKey(std::string_view(arg, separator - arg), threshold.m_stat))
+        return false;
+    char *end = nullptr;
+    threshold.m_max_increase = strtod(separator + 1, &end);
+    threshold.m_is_relative = (*end == '%');
+    end += threshold.m_is_relative ? 1 : 0;
+    return end != separator + 1 && *end == '\0' && threshold.m_max_increase >= 0.0;
+}
+
+//--------------------------------------------------------------------------------------------------
+// Compares the stats of two captures. Returns 0 if no stat regressed, 2 if any did, and 1 on error
+int RunDiff(int argc, char **argv)
+{
+    std::vector<const char *>        captures;
+    std::vector<Dive::StatThreshold> thresholds;
+    bool                             default_thresholds = true;
+    bool                             valid_args = true;
+    for (int i = 2; i < argc; ++i)
+    {
+        Dive::StatThreshold threshold;
+        if (!strcmp(argv[i], "--threshold") && i + 1 < argc)
+        {
+            valid_args &= ParseThreshold(argv[++i], threshold);
+            thresholds.push_back(threshold);
+        }
+        else if (!strcmp(argv[i], "--no-default-thresholds"))
+            default_thresholds = false;
+        else
+            captures.push_back(argv[i]);
+    }
+    if (!valid_args || captures.size() != 2)
+    {
+        std::cout << "You need to call: trace_stats --diff <baseline.rd> <candidate.rd> "
+                     "[--threshold <stat>=<max_increase>[%]]... [--no-default-thresholds]\n"
+                     "  Stats are named as in the JSON output. By default, any increase in waits "
+                     "or GMEM resolves is a regression; a --threshold replaces the default for "
+                     "its stat\n";
+        return 1;
+    }
+    if (default_thresholds)
+    {
+        // Before the user's, since the last threshold of a stat is the one applied
+        std::vector<Dive::StatThreshold> defaults = Dive::GetDefaultStatThresholds();
+        thresholds.insert(thresholds.begin(), defaults.begin(), defaults.end());
+    }
+
+    BatchResult results[2];
+    {
+        unsigned int threads_per_capture = std::max(1u,
+                                                    Dive::ThreadPool::GetDefaultThreadCount() / 2);
+        Dive::ThreadPool thread_pool;
+        thread_pool.Start(2);
+        for (int i = 0; i < 2; ++i)
+            thread_pool.Run([&results, &captures, threads_per_capture, i]() {
+                results[i] = GatherCaptureStats(captures[i], threads_per_capture);
+            });
+        thread_pool.Wait();
+    }
+    for (int i = 0; i < 2; ++i)
+    {
+        if (!results[i].m_error.empty())
+        {
+            std::cerr << captures[i] << ": " << results[i].m_error << "\n";
+            return 1;
+        }
+    }
+
+    Dive::TraceStats            trace_stats;
+    std::vector<Dive::StatDiff> diffs;
+
+    bool regressed = trace_stats.DiffTraceStats(results[0].m_stats,
+                                                results[1].m_stats,
+                                                thresholds,
+                                                diffs);
+    trace_stats.PrintTraceStatsDiff(diffs, std::cout);
+    return regressed ? 2 : 0;
+}
+
+//--------------------------------------------------------------------------------------------------
+// A report on a single capture: parses "<input_file_name.rd> <output_file_name>(optional)" plus
+// the report's options, loads the capture and opens the output (stdout without an output file)
+class CaptureReport
+{
+public:
+    explicit CaptureReport(const char *usage) :
+        m_usage(usage)
+    {
+    }
+
+    // Option taking an integer value, clamped to `min_value`
+    void AddOption(const char *name, uint32_t *value, int min_value)
+    {
+        m_options.push_back({ name, value, min_value });
+    }
+
+    // Prints the usage or the error and returns false if the arguments are invalid, the capture
+    // cannot be loaded (or its metadata created) or the output file cannot be opened
+    bool Open(int argc, char **argv, bool create_metadata)
+    {
+        std::vector<char *> positional_args;
+        for (int i = 2; i < argc; ++i)
+        {
+            const Option *option = nullptr;
+            for (const Option &o : m_options)
+            {
+                if (!strcmp(argv[i], o.m_name) && i + 1 < argc)
+                    option = &o;
+            }
+            if (option != nullptr)
+                *option->m_value = static_cast<uint32_t>(std::max(option->m_min_value,
+                                                                  atoi(argv[++i])));
+            else
+                positional_args.push_back(argv[i]);
+        }
+        if (positional_args.empty() || positional_args.size() > 2)
+        {
+            std::cout << "You need to call: " << m_usage << "\n";
+            return false;
+        }
+
+        Dive::CaptureData::LoadResult load_res = m_data_core.LoadPm4CaptureData(
+        positional_args[0]);
+        if (load_res != Dive::CaptureData::LoadResult::kSuccess)
+        {
+            std::cerr << "Loading capture \"" << positional_args[0]
+                      << "\" failed: " << GetLoadResultString(load_res) << "\n";
+            return false;
+        }
+        if (create_metadata && !m_data_core.CreatePm4MetaData())
+        {
+            std::cerr << "Failed to create meta data\n";
+            return false;
+        }
+        if (positional_args.size() == 2)
+        {
+            m_ofstream.open(positional_args[1]);
+            if (!m_ofstream.is_open())
+            {
+                std::cerr << "Cannot open output file \"" << positional_args[1] << "\"\n";
+                return false;
+            }
+            m_ostream = &m_ofstream;
+        }
+        return true;
+    }
+
+    Dive::DataCore &GetDataCore() { return m_data_core; }
+    std::ostream   &GetOutput() { return *m_ostream; }
+
+private:
+    struct Option
+    {
+        const char *m_name;
+        uint32_t   *m_value;
+        int         m_min_value;
+    };
+
+    const char         *m_usage;
+    std::vector<Option> m_options;
+    Dive::DataCore      m_data_core;
+    std::ofstream       m_ofstream;
+    std::ostream       *m_ostream = &std::cout;
+};
+
+//--------------------------------------------------------------------------------------------------
+// Reports the redundant PM4 of a capture. Only emulates the submits, without creating the metadata
+int RunRedundancy(int argc, char **argv)
+{
+    CaptureReport capture_report("trace_stats --redundancy <input_file_name.rd> "
+                                 "<output_details_file_name.txt>(optional)");
+    if (!capture_report.Open(argc, argv, false))
+        return EXIT_FAILURE;
+
+    const Dive::Pm4CaptureData &capture_data = capture_report.GetDataCore().GetPm4CaptureData();
+    Dive::RedundancyReport      report;
+    Dive::RedundancyAnalyzer    analyzer(report);
+    if (!analyzer.ProcessSubmits(capture_data.GetSubmits(), capture_data.GetMemoryManager()))
+    {
+        std::cerr << "Failed to emulate the capture\n";
+        return EXIT_FAILURE;
+    }
+
+    Dive::TraceStats trace_stats;
+    trace_stats.PrintRedundancyReport(report, capture_report.GetOutput());
+    return EXIT_SUCCESS;
+}
+
+//--------------------------------------------------------------------------------------------------
+// Reports the vertex reuse of the indexed draws of a capture, from the indices in its memory
+int RunIndexBuffers(int argc, char **argv)
+{
+    uint32_t      cache_size = Dive::kDefaultVertexCacheSize;
+    uint32_t      num_threads = 0;
+    CaptureReport capture_report("trace_stats --index-buffers <input_file_name.rd> "
+                                 "<output_details_file_name.txt>(optional) "
+                                 "[--cache-size <vertices>] [--jobs <n>]");
+    capture_report.AddOption("--cache-size", &cache_size, 0);
+    capture_report.AddOption("--jobs", &num_threads, 1);
+    if (!capture_report.Open(argc, argv, true))
+        return EXIT_FAILURE;
+
+    const Dive::DataCore   &data_core = capture_report.GetDataCore();
+    Dive::IndexBufferReport report;
+    Dive::AnalyzeIndexBuffers(data_core.GetCaptureMetadata().m_indexed_draws,
+                              data_core.GetPm4CaptureData().GetMemoryManager(),
+                              cache_size,
+                              num_threads,
+                              report);
+
+    Dive::TraceStats trace_stats;
+    trace_stats.PrintIndexBufferReport(report, capture_report.GetOutput());
+    return EXIT_SUCCESS;
+}
+
+//--------------------------------------------------------------------------------------------------
+// Reports which draws and states change from one frame of a capture to the next
+int RunFrames(int argc, char **argv)
+{
+    uint32_t      num_threads = 0;
+    CaptureReport capture_report("trace_stats --frames <input_file_name.rd> "
+                                 "<output_details_file_name.txt>(optional) [--jobs <n>]");
+    capture_report.AddOption("--jobs", &num_threads, 1);
+    if (!capture_report.Open(argc, argv, true))
+        return EXIT_FAILURE;
+
+    const Dive::DataCore       &data_core = capture_report.GetDataCore();
+    const Dive::Pm4CaptureData &capture_data = data_core.GetPm4CaptureData();
+    if (capture_data.GetNumPresents() == 0)
+        std::cerr << "The capture has no presents, so each submit is taken as a frame\n";
+    Dive::FrameStabilityReport report;
+    Dive::AnalyzeFrameStability(data_core.GetCaptureMetadata(),
+                                Dive::GetFrameEndSubmits(capture_data),
+                                num_threads,
+                                report);
+
+    Dive::TraceStats trace_stats;
+    trace_stats.PrintFrameStabilityReport(report, capture_report.GetOutput());
+    return EXIT_SUCCESS;
+}
+
+}  // namespace
+
 int main(int argc, char **argv)
 {
     Pm4InfoInit();
 
+    if (argc >= 2 && !strcmp(argv[1], "--batch"))
+    {
+        return RunBatch(argc, argv);
+    }
+    if (argc >= 2 && !strcmp(argv[1], "--diff"))
+    {
+        return RunDiff(argc, argv);
+    }
+    if (argc >= 2 && !strcmp(argv[1], "--redundancy"))
+    {
+        return RunRedundancy(argc, argv);
+    }
+    if (argc >= 2 && !strcmp(argv[1], "--index-buffers"))
+    {
+        return RunIndexBuffers(argc, argv);
+    }
+    if (argc >= 2 && !strcmp(argv[1], "--frames"))
+    {
+        return RunFrames(argc, argv);
+    }
+
     // Handle args
-    if ((argc != 2) && (argc != 3))
+    std::vector<char *> positional_args;
+    std::string         format = "text";
+    for (int i = 1; i < argc; ++i)
+    {
+        if (!strcmp(argv[i], "--format") && i + 1 < argc)
+            format = argv[++i];
+        else
+            positional_args.push_back(argv[i]);
+    }
+    if (positional_args.empty() || positional_args.size() > 2 ||
+        (format != "text" && format != "json" && format != "csv"))
     {
-        std::cout << "You need to call: lrz_validator <input_file_name.rd> "
-                     "<output_details_file_name.txt>(optional)";
-        return 0;
+        std::cout << "You need to call: trace_stats <input_file_name.rd> "
+                     "<output_details_file_name.txt>(optional) [--format text|json|csv]\n"
+                     "or: trace_stats --batch <capture_directory | capture_list.txt> "
+                     "[--jobs <n>] [--memory-budget-mb <mb>] [--output <stats.tsv>]\n"
+                     "or: trace_stats --diff <baseline.rd> <candidate.rd> "
+                     "[--threshold <stat>=<max_increase>[%]]... [--no-default-thresholds]\n"
+                     "or: trace_stats --redundancy <input_file_name.rd> "
+                     "<output_details_file_name.txt>(optional)\n"
+                     "or: trace_stats --index-buffers <input_file_name.rd> "
+                     "<output_details_file_name.txt>(optional) [--cache-size <vertices>] "
+                     "[--jobs <n>]\n"
+                     "or: trace_stats --frames <input_file_name.rd> "
+                     "<output_details_file_name.txt>(optional) [--jobs <n>]";
+        return EXIT_FAILURE;
     }
-    char *input_file_name = argv[1];
+    char *input_file_name = positional_args[0];
 
     std::string output_file_name = "";
-    if (argc == 3)
+    if (positional_args.size() == 2)
     {
-        output_file_name = argv[2];
+        output_file_name = positional_args[1];
     }
 
+    // Keep stdout machine-readable when it holds the stats
+    std::ostream &log = (format == "text") ? std::cout : std::cerr;
+
     // Load capture
     std::unique_ptr<Dive::DataCore> data_core = std::make_unique<Dive::DataCore>();
     Dive::CaptureData::LoadResult   load_res = data_core->LoadPm4CaptureData(input_file_name);
     if (load_res != Dive::CaptureData::LoadResult::kSuccess)
     {
-        std::cout << "Loading capture \"" << input_file_name << "\" failed!";
-        return 0;
+        log << "Loading capture \"" << input_file_name << "\" failed!";
+        return EXIT_FAILURE;
     }
-    std::cout << "Capture file \"" << input_file_name << "\" is loaded!\n";
+    log << "Capture file \"" << input_file_name << "\" is loaded!\n";
 
     // Create meta data
     if (!data_core->CreatePm4MetaData())
     {
-        std::cout << "Failed to create meta data!";
-        return 0;
+        log << "Failed to create meta data!";
+        return EXIT_FAILURE;
     }
-    std::cout << "Gathering Stats...\n";
+    log << "Gathering Stats...\n";
 
     std::ostream *ostream = &std::cout;
     std::ofstream ofstream;
     if (!output_file_name.empty())
     {
-        std::cout << "Output details to \"" << output_file_name << "\"" << std::endl;
+        log << "Output details to \"" << output_file_name << "\"" << std::endl;
         ofstream.open(output_file_name);
+        if (!ofstream.is_open())
+        {
+            log << "Cannot open output file \"" << output_file_name << "\"\n";
+            return EXIT_FAILURE;
+        }
         ostream = &ofstream;
     }
 
@@ -78,7 +629,12 @@ int main(int argc, char **argv)
     Dive::TraceStats             trace_stats;
 
     trace_stats.GatherTraceStats(Dive::Context::Background(), meta_data, capture_stats);
-    trace_stats.PrintTraceStats(capture_stats, *ostream);
+    if (format == "json")
+        trace_stats.PrintTraceStatsJson(capture_stats, *ostream);
+    else if (format == "csv")
+        trace_stats.PrintTraceStatsCsv(capture_stats, *ostream);
+    else
+        trace_stats.PrintTraceStats(capture_stats, *ostream);
 
-    return 1;
+    return EXIT_SUCCESS;
 }
@@ -16,198 +16,350 @@
 
 #include "trace_stats.h"
 
-#include <functional>
-#include <thread>
-#include <mutex>
-#include <condition_variable>
-#include <deque>
-
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <sstream>
 #include "dive_core/event_state.h"
+#include "dive_core/thread_pool.h"
+#include "pm4_info.h"
 
 namespace Dive
 {
+
+#define GATHER_DISTRIBUTION(streaming_stats, type)                                 \
+    {                                                                              \
+        stats_list[Dive::Stats::kTotal##type] = streaming_stats.GetSum();          \
+        stats_list[Dive::Stats::kMin##type] = streaming_stats.GetMin();            \
+        stats_list[Dive::Stats::kMax##type] = streaming_stats.GetMax();            \
+        stats_list[Dive::Stats::kMedian##type] = streaming_stats.GetQuantile(0.5); \
+        stats_list[Dive::Stats::kP90##type] = streaming_stats.GetQuantile(0.9);    \
+        stats_list[Dive::Stats::kP99##type] = streaming_stats.GetQuantile(0.99);   \
+    }
+
+#define GATHER_RESOLVES(type)                         \
+    do                                                \
+    {                                                 \
+        stats_list[Dive::Stats::kTotalResolves]++;    \
+        stats_list[Dive::Stats::k##type##Resolves]++; \
+    } while (0)
+
 namespace
 {
 
-class ThreadPool
+// The instruction counts of the shaders are stored in the order of ShaderInstructionClass
+static_assert(Stats::kFlowInstructions - Stats::kAluInstructions + 1 ==
+              Dive::kShaderInstructionClassCount);
+
+//--------------------------------------------------------------------------------------------------
+std::vector<Viewport> GetSortedViewports(const CaptureStats &capture_stats)
+{
+    std::vector<Viewport> viewports(capture_stats.m_viewports.begin(),
+                                    capture_stats.m_viewports.end());
+    std::sort(viewports.begin(), viewports.end());
+    return viewports;
+}
+
+//--------------------------------------------------------------------------------------------------
+std::vector<WindowScissor> GetSortedWindowScissors(const CaptureStats &capture_stats)
 {
-public:
-    ThreadPool() = default;
-    ThreadPool(const ThreadPool &) = delete;
-    ThreadPool &operator=(const ThreadPool &) = delete;
-    ~ThreadPool() { Stop(); }
+    std::vector<WindowScissor> window_scissors(capture_stats.m_window_scissors.begin(),
+                                               capture_stats.m_window_scissors.end());
+    std::sort(window_scissors.begin(), window_scissors.end());
+    return window_scissors;
+}
 
-    void Run(std::function<void()> &&func)
+//--------------------------------------------------------------------------------------------------
+// The distributions with a histogram in the JSON and CSV outputs
+std::array<std::pair<const char *, const StreamingStats *>, 3> GetDistributions(
+const CaptureStats &capture_stats)
+{
+    return { std::pair("indices", &capture_stats.m_num_indices),
+             std::pair("instructions", &capture_stats.m_num_instructions),
+             std::pair("gprs", &capture_stats.m_num_gprs) };
+}
+
+//--------------------------------------------------------------------------------------------------
+void PrintJsonString(std::ostream &ostream, std::string_view str)
+{
+    ostream << '"';
+    for (char c : str)
     {
-        {
-            std::lock_guard<std::mutex> lock(m_mutex);
-            m_tasks.push_back(std::move(func));
-        }
-        m_condition_variable.notify_one();
+        if (c == '"' || c == '\\')
+            ostream << '\\' << c;
+        else if (static_cast<unsigned char>(c) < 0x20)
+            ostream << "\\u" << std::hex << std::setw(4) << std::setfill('0') << int(c)
+                    << std::dec << std::setfill(' ');
+        else
+            ostream << c;
     }
+    ostream << '"';
+}
 
-    void Start(unsigned int num_workers = 0)
-    {
-        num_workers = (num_workers > 0 ? num_workers : GetDefaultThreadCount());
+//--------------------------------------------------------------------------------------------------
+// JSON has no NaN or infinity
+void PrintJsonNumber(std::ostream &ostream, double value)
+{
+    if (std::isfinite(value))
+        ostream << value;
+    else
+        ostream << "null";
+}
 
-        std::unique_lock<std::mutex> lock(m_mutex);
-        m_running = true;
-        for (unsigned int i = static_cast<unsigned int>(m_workers.size()); i < num_workers; ++i)
+//--------------------------------------------------------------------------------------------------
+void PrintCsvRow(std::ostream    &ostream,
+                 std::string_view section,
+                 std::string_view item,
+                 std::string_view field,
+                 std::string_view value)
+{
+    bool first = true;
+    for (std::string_view column : { section, item, field, value })
+    {
+        if (!first)
+            ostream << ',';
+        first = false;
+        if (column.find_first_of(",\"\n") == std::string_view::npos)
         {
-            m_workers.emplace_back([this]() { this->WorkerImpl(); });
+            ostream << column;
+            continue;
         }
+        ostream << '"';
+        for (char c : column)
+            ostream << (c == '"' ? "\"\"" : std::string(1, c));
+        ostream << '"';
     }
+    ostream << '\n';
+}
+
+//--------------------------------------------------------------------------------------------------
+bool IsGmemLoad(Dive::EventInfo::EventType type)
+{
+    return type == Dive::EventInfo::EventType::kColorSysMemToGmemResolve ||
+           type == Dive::EventInfo::EventType::kDepthSysMemToGmemResolve ||
+           type == Dive::EventInfo::EventType::kSysmemToGmemResolve;
+}
+
+//--------------------------------------------------------------------------------------------------
+bool IsGmemStore(Dive::EventInfo::EventType type)
+{
+    return type == Dive::EventInfo::EventType::kColorGmemToSysMemResolve ||
+           type == Dive::EventInfo::EventType::kColorGmemToSysMemResolveAndClear ||
+           type == Dive::EventInfo::EventType::kDepthGmemToSysMemResolve ||
+           type == Dive::EventInfo::EventType::kDepthGmemToSysMemResolveAndClear;
+}
 
-    void Stop()
+//--------------------------------------------------------------------------------------------------
+// Share of `bytes` in the GMEM traffic of the whole capture, in percent
+double GetTrafficShare(uint64_t bytes, const CaptureStats &capture_stats)
+{
+    uint64_t total = capture_stats.m_stats_list[Stats::kGmemLoadBytes] +
+                     capture_stats.m_stats_list[Stats::kGmemStoreBytes];
+    return total == 0 ? 0.0 : 100.0 * static_cast<double>(bytes) / static_cast<double>(total);
+}
+
+//--------------------------------------------------------------------------------------------------
+// Enable mask of the shaders that a draw of `render_mode` runs
+uint32_t GetDrawShaderEnableMask(Dive::RenderModeType render_mode)
+{
+    switch (render_mode)
     {
-        std::deque<std::thread> workers;
-        {
-            std::unique_lock<std::mutex> lock(m_mutex);
-            if (!m_running)
-            {
-                return;
-            }
-            m_running = false;
-            std::swap(workers, m_workers);
-        }
-        m_condition_variable.notify_all();
-        for (std::thread &worker : workers)
-        {
-            worker.join();
-        }
+    case Dive::RenderModeType::kBinningVis:
+    case Dive::RenderModeType::kBinningDirect:
+        return static_cast<uint32_t>(Dive::ShaderEnableBitMask::kBINNING);
+    case Dive::RenderModeType::kTiled:
+        return static_cast<uint32_t>(Dive::ShaderEnableBitMask::kGMEM);
+    case Dive::RenderModeType::kDirect:
+        return static_cast<uint32_t>(Dive::ShaderEnableBitMask::kSYSMEM);
+    default:
+        return UINT32_MAX;
     }
+}
+
+//--------------------------------------------------------------------------------------------------
+// "<redundant>/<total> (<dwords> dwords)"
+std::string FormatRedundancy(const RedundancyCount &count)
+{
+    std::ostringstream string_stream;
+    string_stream << count.m_redundant << "/" << count.m_total << " (" << count.m_redundant_dwords
+                  << " dwords)";
+    return string_stream.str();
+}
 
-    static unsigned int SuggestedNumberOfWorkers(unsigned int task_count)
+//--------------------------------------------------------------------------------------------------
+// Entries of `counts` with a redundancy, by descending dwords saved
+std::vector<std::pair<uint32_t, RedundancyCount>> GetSortedRedundancies(
+const std::map<uint32_t, RedundancyCount> &counts)
+{
+    std::vector<std::pair<uint32_t, RedundancyCount>> sorted;
+    for (const auto &[key, count] : counts)
     {
-        // We are still bottlenecked by the slowest disassembly task.
-        // 4x less worker than disassembly tasks seems be the point of diminishing return.
-        constexpr unsigned int kLoadFactor = 4;
-        return std::min<unsigned int>((task_count + kLoadFactor - 1) / kLoadFactor,
-                                      GetDefaultThreadCount());
+        if (count.m_redundant_dwords != 0)
+            sorted.emplace_back(key, count);
     }
+    std::stable_sort(sorted.begin(), sorted.end(), [](const auto &a, const auto &b) {
+        return a.second.m_redundant_dwords > b.second.m_redundant_dwords;
+    });
+    return sorted;
+}
+
+//--------------------------------------------------------------------------------------------------
+template<typename T> std::string ToString(T value)
+{
+    std::ostringstream string_stream;
+    string_stream << std::setprecision(9) << value;
+    return string_stream.str();
+}
+
+// The instruction stats are indexed by ShaderInstructionClass from kAluInstructions
+static_assert(Stats::kSfuInstructions - Stats::kAluInstructions ==
+              static_cast<uint32_t>(ShaderInstructionClass::kSfu));
+static_assert(Stats::kTextureInstructions - Stats::kAluInstructions ==
+              static_cast<uint32_t>(ShaderInstructionClass::kTexture));
+static_assert(Stats::kMemoryInstructions - Stats::kAluInstructions ==
+              static_cast<uint32_t>(ShaderInstructionClass::kMemory));
+static_assert(Stats::kFlowInstructions - Stats::kAluInstructions ==
+              static_cast<uint32_t>(ShaderInstructionClass::kFlow));
+static_assert(Stats::kMinWaves - Stats::kAluInstructions == kShaderInstructionClassCount);
+
+//--------------------------------------------------------------------------------------------------
+// Stats for which a decrease is the regression, e.g. fewer waves in flight
+bool IsDecreaseRegression(Stats::Type stat)
+{
+    return stat == Stats::kMinWaves;
+}
 
-private:
-    std::function<void()> NextTask()
+}  // namespace
+
+//--------------------------------------------------------------------------------------------------
+bool FindStatByKey(std::string_view key, Stats::Type &stat)
+{
+    for (const auto &[stat_type, stat_key] : kStatKeyMap)
     {
-        std::unique_lock<std::mutex> lock(m_mutex);
-        m_condition_variable.wait(lock, [this] { return !m_running || !m_tasks.empty(); });
-        if (!m_running || m_tasks.empty())
+        if (key == stat_key)
         {
-            return {};
+            stat = stat_type;
+            return true;
         }
-        std::function<void()> result = m_tasks.front();
-        m_tasks.pop_front();
-        return result;
     }
+    return false;
+}
 
-    static unsigned int GetDefaultThreadCount()
+//--------------------------------------------------------------------------------------------------
+std::vector<StatThreshold> GetDefaultStatThresholds()
+{
+    std::vector<StatThreshold> thresholds;
+    for (Stats::Type stat : { Stats::kWaitMemWrites,
+                              Stats::kWaitForIdle,
+                              Stats::kWaitForMe,
+                              Stats::kColorSysMemToGmemResolves,
+                              Stats::kColorGmemToSysMemResolves,
+                              Stats::kDepthSysMemToGmemResolves,
+                              Stats::kDepthGmemToSysMemResolves,
+                              Stats::kColorClearGmemResolves,
+                              Stats::kDepthClearGmemResolves,
+                              Stats::kGmemLoadBytes,
+                              Stats::kGmemStoreBytes })
     {
-        unsigned int count = std::thread::hardware_concurrency();
-        return (count > 1 ? count - 1 : 1);
+        thresholds.push_back({ stat, 0.0, false });
     }
+    return thresholds;
+}
 
-    void WorkerImpl()
+//--------------------------------------------------------------------------------------------------
+void TraceStats::GatherDrawStateStats(const Dive::EventStateInfoDelta &event_state,
+                                      const std::vector<uint32_t>     &draws,
+                                      const std::vector<uint32_t>     &binning_draws,
+                                      const std::vector<uint32_t>     &direct_or_binning_draws,
+                                      CaptureStats                    &capture_stats)
+{
+    std::array<uint64_t, Dive::Stats::kNumStats> &stats_list = capture_stats.m_stats_list;
+
+    const auto is_true = [](bool value) { return value; };
+    const auto is_any = [](auto) { return true; };
+
+    // Depth and Z-test mode, binning pass only
+    std::vector<uint32_t> binning_depth_test = event_state.DepthTestEnabledColumn().Filter(
+    binning_draws,
+    is_true);
+    stats_list[Stats::kDepthTestEnabled] += binning_depth_test.size();
+    stats_list[Stats::kDepthWriteEnabled] += event_state.DepthWriteEnabledColumn().CountWhere(
+    binning_depth_test,
+    is_true);
+    for (const auto &[mode, count] : event_state.ZTestModeColumn().Histogram(binning_depth_test))
     {
-        while (auto task = NextTask())
-        {
-            task();
-        }
+        if (mode == A6XX_EARLY_Z)
+            stats_list[Stats::kEarlyZ] += count;
+        else if (mode == A6XX_LATE_Z)
+            stats_list[Stats::kLateZ] += count;
+        else if (mode == A6XX_EARLY_Z_LATE_Z)
+            stats_list[Stats::kEarlyZLateZ] += count;
     }
 
-    bool                              m_running;
-    std::mutex                        m_mutex;
-    std::deque<std::thread>           m_workers;
-    std::deque<std::function<void()>> m_tasks;
-    std::condition_variable           m_condition_variable;
-};
+    // LRZ, direct and binning passes
+    std::vector<uint32_t> depth_test = event_state.DepthTestEnabledColumn().Filter(
+    direct_or_binning_draws,
+    is_true);
+    stats_list[Stats::kLrzEnabled] += event_state.LRZEnabledColumn().CountWhere(depth_test,
+                                                                                is_true);
+    std::vector<uint32_t> depth_write = event_state.DepthWriteEnabledColumn().Filter(depth_test,
+                                                                                     is_true);
+    stats_list[Stats::kLrzWriteEnabled] += event_state.LRZWriteColumn().CountWhere(depth_write,
+                                                                                   is_true);
 
-}  // namespace
+    stats_list[Stats::kCullModeEnabled] += event_state.CullModeColumn().CountWhere(
+    draws,
+    [](VkCullModeFlags mode) { return mode != VK_CULL_MODE_NONE; });
 
-#define CHECK_AND_TRACK_STATE_1(stats_enum, state)                   \
-    if (event_state_it->Is##state##Set() && event_state_it->state()) \
-        stats_list[stats_enum]++;
-
-#define CHECK_AND_TRACK_STATE_2(stats_enum, state1, state2)                       \
-    if (event_state_it->Is##state1##Set() && event_state_it->Is##state2##Set() && \
-        event_state_it->state1() && event_state_it->state2())                     \
-        stats_list[stats_enum]++;
-
-#define CHECK_AND_TRACK_STATE_3(stats_enum, state1, state2, state3)               \
-    if (event_state_it->Is##state1##Set() && event_state_it->Is##state2##Set() && \
-        event_state_it->Is##state3##Set() && event_state_it->state1() &&          \
-        event_state_it->state2() && event_state_it->state3())                     \
-        stats_list[stats_enum]++;
-
-#define CHECK_AND_TRACK_STATE_EQUAL(stats_enum, state, state_value) \
-    if (event_state_it->Is##state##Set())                           \
-        if (event_state_it->state() == state_value)                 \
-            stats_list[stats_enum]++;
-
-#define CHECK_AND_TRACK_STATE_NOT_EQUAL(stats_enum, state, state_value) \
-    if (event_state_it->Is##state##Set())                               \
-        if (event_state_it->state() != state_value)                     \
-            stats_list[stats_enum]++;
-
-#define FUNC_CHOOSER(_f1, _f2, _f3, _f4, ...) _f4
-#define MSVC_WORKAROUND(argsWithParentheses) FUNC_CHOOSER argsWithParentheses
-
-// Trailing , is workaround for GCC/CLANG, suppressing false positive error "ISO C99 requires rest
-// arguments to be used" MSVC_WORKAROUND is workaround for MSVC for counting # of arguments
-// correctly
-#define CHECK_AND_TRACK_STATE_N(...) \
-    MSVC_WORKAROUND(                 \
-    (__VA_ARGS__, CHECK_AND_TRACK_STATE_3, CHECK_AND_TRACK_STATE_2, CHECK_AND_TRACK_STATE_1, ))
-#define CHECK_AND_TRACK_STATE(stats_enum, ...) \
-    CHECK_AND_TRACK_STATE_N(__VA_ARGS__)(stats_enum, __VA_ARGS__)
-
-#define GATHER_TOTAL_MIN_MAX_MEDIAN(array_name, type)                                         \
-    {                                                                                         \
-        std::sort(array_name.begin(), array_name.end());                                      \
-        size_t n = array_name.size();                                                         \
-        if (n % 2 != 0)                                                                       \
-        {                                                                                     \
-            stats_list[Dive::Stats::kMedian##type] = array_name[n / 2];                       \
-        }                                                                                     \
-        else                                                                                  \
-        {                                                                                     \
-            auto mid1 = array_name[n / 2 - 1];                                                \
-            auto mid2 = array_name[n / 2];                                                    \
-            stats_list[Dive::Stats::kMedian##type] = (uint64_t)((float)(mid1 + mid2) / 2.0f); \
-        }                                                                                     \
-        stats_list[Dive::Stats::kMin##type] = *std::min_element(array_name.begin(),           \
-                                                                array_name.end());            \
-        stats_list[Dive::Stats::kMax##type] = *std::max_element(array_name.begin(),           \
-                                                                array_name.end());            \
-        stats_list[Dive::Stats::kTotal##type] = std::accumulate(array_name.begin(),           \
-                                                                array_name.end(),             \
-                                                                (uint64_t)0);                 \
+    for (uint32_t v = 0; v < 16; ++v)
+    {
+        StructOfArraysDeltaColumn<VkViewport> viewports = event_state.ViewportColumn(v);
+        for (uint32_t event_id : viewports.Filter(draws, is_any))
+        {
+            Viewport viewport;
+            viewport.m_vk_viewport = viewports[event_id];
+            capture_stats.m_viewports.insert(viewport);
+        }
     }
 
-#define GATHER_RESOLVES(type)                         \
-    do                                                \
-    {                                                 \
-        stats_list[Dive::Stats::kTotalResolves]++;    \
-        stats_list[Dive::Stats::k##type##Resolves]++; \
-    } while (0)
+    StructOfArraysDeltaColumn<uint16_t> tl_x = event_state.WindowScissorTLXColumn();
+    StructOfArraysDeltaColumn<uint16_t> tl_y = event_state.WindowScissorTLYColumn();
+    StructOfArraysDeltaColumn<uint16_t> br_x = event_state.WindowScissorBRXColumn();
+    StructOfArraysDeltaColumn<uint16_t> br_y = event_state.WindowScissorBRYColumn();
+    std::vector<uint32_t>               scissor_draws = br_y.Filter(
+    br_x.Filter(tl_y.Filter(tl_x.Filter(draws, is_any), is_any), is_any),
+    is_any);
+    for (uint32_t event_id : scissor_draws)
+    {
+        WindowScissor window_scissor;
+        window_scissor.m_tl_x = tl_x[event_id];
+        window_scissor.m_tl_y = tl_y[event_id];
+        window_scissor.m_br_x = br_x[event_id];
+        window_scissor.m_br_y = br_y[event_id];
+        capture_stats.m_window_scissors.insert(window_scissor);
+    }
+}
 
 //--------------------------------------------------------------------------------------------------
-void TraceStats::GatherTraceStats(const Dive::Context         &context,
+void TraceStats::GatherEventStats(const Dive::Context         &context,
                                   const Dive::CaptureMetadata &meta_data,
-                                  CaptureStats                &capture_stats)
+                                  size_t                       begin,
+                                  size_t                       end,
+                                  CaptureStats                &capture_stats,
+                                  std::vector<uint32_t>       &draws)
 {
-    capture_stats = CaptureStats();  // Reset any previous stats
-
     std::array<uint64_t, Dive::Stats::kNumStats> &stats_list = capture_stats.m_stats_list;
 
-    size_t                      event_count = meta_data.m_event_info.size();
-    const Dive::EventStateInfo &event_state = meta_data.m_event_state;
+    // Draws are bucketed here, and their state is then gathered one column at a time
+    std::vector<uint32_t> binning_draws;
+    std::vector<uint32_t> direct_or_binning_draws;
 
-    Dive::RenderModeType cur_type = Dive::RenderModeType::kUnknown;
-    for (size_t i = 0; i < event_count; ++i)
+    Dive::RenderModeType cur_type = begin > 0 ? meta_data.m_event_info[begin - 1].m_render_mode :
+                                                Dive::RenderModeType::kUnknown;
+    for (size_t i = begin; i < end; ++i)
     {
         if (context.Cancelled())
         {
-            capture_stats = CaptureStats();
             return;
         }
         const Dive::EventInfo &info = meta_data.m_event_info[i];
@@ -263,100 +415,266 @@ void TraceStats::GatherTraceStats(const Dive::Context         &context,
                 stats_list[Dive::Stats::kTiledDraws]++;
 
             if (info.m_num_indices != 0)
-                capture_stats.m_event_num_indices.push_back(info.m_num_indices);
+                capture_stats.m_num_indices.Add(info.m_num_indices);
 
             const uint32_t event_id = static_cast<uint32_t>(i);
-            auto event_state_it = event_state.find(static_cast<Dive::EventStateId>(event_id));
-
+            draws.push_back(event_id);
             if (info.m_render_mode == Dive::RenderModeType::kBinningVis ||
                 info.m_render_mode == Dive::RenderModeType::kBinningDirect)
             {
-                CHECK_AND_TRACK_STATE(Dive::Stats::kDepthTestEnabled, DepthTestEnabled);
-                CHECK_AND_TRACK_STATE(Dive::Stats::kDepthWriteEnabled,
-                                      DepthTestEnabled,
-                                      DepthWriteEnabled);
-                if (event_state_it->DepthTestEnabled())
-                {
-                    CHECK_AND_TRACK_STATE_EQUAL(Dive::Stats::kEarlyZ, ZTestMode, A6XX_EARLY_Z);
-                    CHECK_AND_TRACK_STATE_EQUAL(Dive::Stats::kLateZ, ZTestMode, A6XX_LATE_Z);
-                    CHECK_AND_TRACK_STATE_EQUAL(Dive::Stats::kEarlyZLateZ,
-                                                ZTestMode,
-                                                A6XX_EARLY_Z_LATE_Z);
-                }
+                binning_draws.push_back(event_id);
+                direct_or_binning_draws.push_back(event_id);
             }
-            if (info.m_render_mode == Dive::RenderModeType::kDirect ||
-                info.m_render_mode == Dive::RenderModeType::kBinningVis ||
-                info.m_render_mode == Dive::RenderModeType::kBinningDirect)
+            else if (info.m_render_mode == Dive::RenderModeType::kDirect)
             {
-                CHECK_AND_TRACK_STATE(Dive::Stats::kLrzEnabled, DepthTestEnabled, LRZEnabled);
-                CHECK_AND_TRACK_STATE(Dive::Stats::kLrzWriteEnabled,
-                                      DepthTestEnabled,
-                                      DepthWriteEnabled,
-                                      LRZWrite);
+                direct_or_binning_draws.push_back(event_id);
             }
+        }
+
+        for (const Dive::ShaderReference &ref : meta_data.m_event_info.GetShaderReferences(i))
+            if (ref.m_shader_index != UINT32_MAX)
+                capture_stats.m_shader_ref_set.insert(ref);
+    }
+
+    GatherDrawStateStats(meta_data.m_event_state,
+                         draws,
+                         binning_draws,
+                         direct_or_binning_draws,
+                         capture_stats);
+}
+
+//--------------------------------------------------------------------------------------------------
+void TraceStats::MergeTraceStats(const CaptureStats &partial, CaptureStats &capture_stats)
+{
+    // Only the counters are set at this point, the min/max/median stats are derived after merging
+    for (uint32_t i = 0; i < Dive::Stats::kNumStats; ++i)
+        capture_stats.m_stats_list[i] += partial.m_stats_list[i];
+
+    capture_stats.m_num_indices.Merge(partial.m_num_indices);
+    capture_stats.m_shader_ref_set.insert(partial.m_shader_ref_set.begin(),
+                                          partial.m_shader_ref_set.end());
+    capture_stats.m_viewports.insert(partial.m_viewports.begin(), partial.m_viewports.end());
+    capture_stats.m_window_scissors.insert(partial.m_window_scissors.begin(),
+                                           partial.m_window_scissors.end());
+    capture_stats.m_num_binning_passes += partial.m_num_binning_passes;
+    capture_stats.m_num_tiling_passes += partial.m_num_tiling_passes;
+}
+
+//--------------------------------------------------------------------------------------------------
+void TraceStats::GatherRenderPassStats(const Dive::CaptureMetadata &meta_data,
+                                       CaptureStats                &capture_stats)
+{
+    std::array<uint64_t, Dive::Stats::kNumStats> &stats_list = capture_stats.m_stats_list;
+
+    // Events of a pass outside of its bins, such as the loads and stores of a direct pass, only
+    // count toward the pass
+    const Dive::RenderPassTable      &render_passes = meta_data.m_render_passes;
+    const std::vector<Dive::BinInfo> &bins = render_passes.GetBins();
+    for (const Dive::RenderPassInfo &pass : render_passes.GetRenderPasses())
+    {
+        RenderPassStats pass_stats = {};
+        pass_stats.m_submit_index = pass.m_submit_index;
+        pass_stats.m_first_event = pass.m_first_event;
+        pass_stats.m_end_event = pass.m_end_event;
+        pass_stats.m_is_tiled = pass.m_is_tiled;
 
-            CHECK_AND_TRACK_STATE_NOT_EQUAL(Dive::Stats::kCullModeEnabled,
-                                            CullMode,
-                                            VK_CULL_MODE_NONE);
+        for (uint32_t bin = pass.m_first_bin; bin < pass.m_end_bin; ++bin)
+        {
+            const Dive::BinInfo &info = bins[bin];
+            pass_stats.m_bins.push_back({ info.m_x, info.m_y, info.m_width, info.m_height });
+        }
 
-            for (uint32_t v = 0; v < 16; ++v)
+        uint32_t bin = pass.m_first_bin;
+        for (uint32_t event_id = pass.m_first_event; event_id < pass.m_end_event; ++event_id)
+        {
+            while (bin < pass.m_end_bin && bins[bin].m_end_event <= event_id)
+                ++bin;
+            BinStats *bin_stats = nullptr;
+            if (bin < pass.m_end_bin && bins[bin].m_first_event <= event_id)
+                bin_stats = &pass_stats.m_bins[bin - pass.m_first_bin];
+
+            const Dive::EventInfo &info = meta_data.m_event_info[event_id];
+            if (info.m_type == Dive::EventInfo::EventType::kDraw)
             {
-                if (event_state_it->IsViewportSet(v))
-                {
-                    Viewport viewport;
-                    viewport.m_vk_viewport = event_state_it->Viewport(v);
-                    capture_stats.m_viewports.insert(viewport);
-                }
+                if (info.m_render_mode == Dive::RenderModeType::kBinningVis ||
+                    info.m_render_mode == Dive::RenderModeType::kBinningDirect)
+                    continue;
+                pass_stats.m_num_draws++;
+                if (bin_stats)
+                    bin_stats->m_num_draws++;
             }
-
-            if (event_state_it->IsWindowScissorTLXSet() &&
-                event_state_it->IsWindowScissorTLYSet() &&
-                event_state_it->IsWindowScissorBRXSet() && event_state_it->IsWindowScissorBRYSet())
+            else if (IsGmemLoad(info.m_type) || IsGmemStore(info.m_type))
             {
-                WindowScissor window_scissor;
-                window_scissor.m_tl_x = event_state_it->WindowScissorTLX();
-                window_scissor.m_tl_y = event_state_it->WindowScissorTLY();
-                window_scissor.m_br_x = event_state_it->WindowScissorBRX();
-                window_scissor.m_br_y = event_state_it->WindowScissorBRY();
-                capture_stats.m_window_scissors.insert(window_scissor);
+                const Dive::ResolveInfo *resolve = render_passes.FindResolve(event_id);
+                if (resolve == nullptr)
+                    continue;
+                uint64_t num_bytes = resolve->GetNumBytes();
+                bool     is_load = IsGmemLoad(info.m_type);
+                (is_load ? pass_stats.m_load_bytes : pass_stats.m_store_bytes) += num_bytes;
+                if (bin_stats)
+                    (is_load ? bin_stats->m_load_bytes : bin_stats->m_store_bytes) += num_bytes;
             }
         }
 
-        for (size_t ref = 0; ref < info.m_shader_references.size(); ++ref)
-            if (info.m_shader_references[ref].m_shader_index != UINT32_MAX)
-                capture_stats.m_shader_ref_set.insert(info.m_shader_references[ref]);
+        stats_list[Dive::Stats::kNumBins] += pass_stats.m_bins.size();
+        stats_list[Dive::Stats::kGmemLoadBytes] += pass_stats.m_load_bytes;
+        stats_list[Dive::Stats::kGmemStoreBytes] += pass_stats.m_store_bytes;
+        capture_stats.m_render_passes.push_back(std::move(pass_stats));
     }
+}
 
-    stats_list[Dive::Stats::kNumBinningPasses] = capture_stats.m_num_binning_passes;
-    stats_list[Dive::Stats::kNumTilingPasses] = capture_stats.m_num_tiling_passes;
+//--------------------------------------------------------------------------------------------------
+void TraceStats::GatherDrawCostStats(const Dive::CaptureMetadata         &meta_data,
+                                     const std::vector<uint32_t>         &draws,
+                                     const std::vector<Dive::ShaderCost> &shader_costs,
+                                     CaptureStats                        &capture_stats)
+{
+    std::vector<DrawCostStats> draw_costs;
+    draw_costs.reserve(draws.size());
+    for (uint32_t event_id : draws)
+    {
+        const Dive::EventInfo &info = meta_data.m_event_info[event_id];
+        DrawCostStats          draw_cost = {};
+        draw_cost.m_event_id = event_id;
+        draw_cost.m_submit_index = info.m_submit_index;
+        draw_cost.m_num_vertices = uint64_t(info.m_num_indices) * info.m_num_instances;
+
+        // An event references the shaders bound for each pass, of which it runs those of its own.
+        // Should several shaders of a stage remain, the most expensive one is counted
+        uint32_t enable_mask = GetDrawShaderEnableMask(info.m_render_mode);
+        uint32_t min_waves = UINT32_MAX;
 
-    if (!capture_stats.m_event_num_indices.empty())
+        std::array<uint32_t, Dive::kShaderStageCount> stage_cycles = {};
+        for (const Dive::ShaderReference &ref : meta_data.m_event_info.GetShaderReferences(
+             event_id))
+        {
+            if (ref.m_shader_index == UINT32_MAX || (ref.m_enable_mask & enable_mask) == 0)
+                continue;
+            const Dive::ShaderCost &cost = shader_costs[ref.m_shader_index];
+            uint32_t               &cycles = stage_cycles[static_cast<uint32_t>(ref.m_stage)];
+            cycles = std::max(cycles, cost.GetCycles());
+            min_waves = std::min(min_waves, cost.m_max_waves);
+        }
+        for (uint32_t stage = 0; stage < Dive::kShaderStageCount; ++stage)
+        {
+            if (stage == static_cast<uint32_t>(Dive::ShaderStage::kShaderStagePs))
+                draw_cost.m_fragment_cycles = stage_cycles[stage];
+            else
+                draw_cost.m_vertex_cycles += stage_cycles[stage];
+        }
+        draw_cost.m_min_waves = (min_waves == UINT32_MAX) ? 0 : min_waves;
+
+        capture_stats.m_stats_list[Stats::kVertexShaderCycles] += draw_cost.GetVertexCost();
+        draw_costs.push_back(draw_cost);
+    }
+
+    size_t num_kept = std::min(draw_costs.size(), CaptureStats::kMaxDrawCosts);
+    std::partial_sort(draw_costs.begin(), draw_costs.begin() + num_kept, draw_costs.end());
+    draw_costs.resize(num_kept);
+    capture_stats.m_draw_costs = std::move(draw_costs);
+}
+
+//--------------------------------------------------------------------------------------------------
+void TraceStats::GatherTraceStats(const Dive::Context         &context,
+                                  const Dive::CaptureMetadata &meta_data,
+                                  CaptureStats                &capture_stats,
+                                  unsigned int                 num_threads)
+{
+    capture_stats = CaptureStats();  // Reset any previous stats
+
+    std::array<uint64_t, Dive::Stats::kNumStats> &stats_list = capture_stats.m_stats_list;
+
+    size_t event_count = meta_data.m_event_info.size();
+
+    // The events are split in fixed-size chunks gathered in parallel, then merged in order. The
+    // chunks do not depend on the number of workers, so neither does the result
+    constexpr size_t kEventsPerChunk = 16 * 1024;
+    size_t           num_chunks = (event_count + kEventsPerChunk - 1) / kEventsPerChunk;
+
+    // The shader costs and the event chunks share one pool, which bounds the threads used
+    size_t       task_count = meta_data.m_shaders.size() + num_chunks;
+    unsigned int max_workers = (num_threads > 0) ? num_threads :
+                                                   ThreadPool::GetDefaultThreadCount();
+    ThreadPool   thread_pool;
+    bool         use_pool = (max_workers > 1 && task_count > 1);
+    if (use_pool)
+        thread_pool.Start(static_cast<unsigned int>(std::min<size_t>(max_workers, task_count)));
+    const auto run_task = [&thread_pool, use_pool](std::function<void()> &&task) {
+        if (use_pool)
+            thread_pool.Run(std::move(task));
+        else
+            task();
+    };
+
+    // Disassemble the shaders and estimate their costs while the events are gathered
+    std::vector<Dive::ShaderCost> shader_costs(meta_data.m_shaders.size());
+    for (size_t i = 0; i < meta_data.m_shaders.size(); ++i)
     {
-        GATHER_TOTAL_MIN_MAX_MEDIAN(capture_stats.m_event_num_indices, Indices);
+        run_task([&context, &meta_data, &shader_costs, i]() {
+            if (context.Cancelled())
+            {
+                return;
+            }
+            shader_costs[i] = Dive::GetShaderCost(meta_data.m_shaders[i]);
+        });
     }
 
-    std::vector<size_t>   shaders_num_instructions;
-    std::vector<uint32_t> shaders_num_gprs;
+    std::vector<CaptureStats>          chunk_stats(num_chunks);
+    std::vector<std::vector<uint32_t>> chunk_draws(num_chunks);
+    for (size_t chunk = 0; chunk < num_chunks; ++chunk)
+    {
+        run_task([&, chunk]() {
+            size_t begin = chunk * kEventsPerChunk;
+            size_t end = std::min(begin + kEventsPerChunk, event_count);
+            GatherEventStats(context,
+                             meta_data,
+                             begin,
+                             end,
+                             chunk_stats[chunk],
+                             chunk_draws[chunk]);
+        });
+    }
+    thread_pool.Wait();
+    if (context.Cancelled())
+    {
+        capture_stats = CaptureStats();
+        return;
+    }
 
-    stats_list[Dive::Stats::kShaders] = meta_data.m_shaders.size();
+    std::vector<uint32_t> draws;
+    for (size_t chunk = 0; chunk < num_chunks; ++chunk)
+    {
+        MergeTraceStats(chunk_stats[chunk], capture_stats);
+        draws.insert(draws.end(), chunk_draws[chunk].begin(), chunk_draws[chunk].end());
+    }
+    chunk_stats.clear();
+    GatherRenderPassStats(meta_data, capture_stats);
+    GatherDrawCostStats(meta_data, draws, shader_costs, capture_stats);
 
-    ThreadPool thread_pool;
-    if (meta_data.m_shaders.size() > 0)
+    const Dive::EventStateGroups &state_groups = meta_data.m_state_groups;
+    if (state_groups.GetNumEvents() == event_count)
     {
-        auto task_count = static_cast<unsigned int>(meta_data.m_shaders.size());
-        thread_pool.Start(thread_pool.SuggestedNumberOfWorkers(task_count));
-        for (const Dive::Disassembly &disassembly : meta_data.m_shaders)
+        for (uint32_t group = 0; group < Dive::EventStateGroups::kGroupCount; ++group)
         {
-            thread_pool.Run([&context, &disassembly]() {
-                if (context.Cancelled())
-                {
-                    return;
-                }
-                disassembly.EagerEval();
-            });
+            auto              group_type = static_cast<Dive::EventStateGroups::Group>(group);
+            std::vector<bool> seen(state_groups.GetNumDistinctStates(group_type), false);
+            for (uint32_t event_id : draws)
+            {
+                uint32_t state_id = state_groups.GetStateId(group_type, event_id);
+                capture_stats.m_num_distinct_draw_states[group] += seen[state_id] ? 0 : 1;
+                seen[state_id] = true;
+            }
         }
     }
 
+    stats_list[Dive::Stats::kNumBinningPasses] = capture_stats.m_num_binning_passes;
+    stats_list[Dive::Stats::kNumTilingPasses] = capture_stats.m_num_tiling_passes;
+
+    GATHER_DISTRIBUTION(capture_stats.m_num_indices, Indices);
+
+    stats_list[Dive::Stats::kShaders] = meta_data.m_shaders.size();
+
+    uint32_t min_waves = UINT32_MAX;
     for (const Dive::ShaderReference &ref : capture_stats.m_shader_ref_set)
     {
         if (context.Cancelled())
@@ -375,18 +693,18 @@ void TraceStats::GatherTraceStats(const Dive::Context         &context,
             stats_list[Dive::Stats::kNonVS]++;
 
         const Dive::Disassembly &disass = meta_data.m_shaders[ref.m_shader_index];
-        shaders_num_instructions.push_back(disass.GetNumInstructions());
-        shaders_num_gprs.push_back(disass.GetGPRCount());
-    }
+        capture_stats.m_num_instructions.Add(disass.GetNumInstructions());
+        capture_stats.m_num_gprs.Add(disass.GetGPRCount());
 
-    if (!shaders_num_instructions.empty())
-    {
-        GATHER_TOTAL_MIN_MAX_MEDIAN(shaders_num_instructions, Instructions);
-    }
-    if (!shaders_num_gprs.empty())
-    {
-        GATHER_TOTAL_MIN_MAX_MEDIAN(shaders_num_gprs, GPRs);
+        const Dive::ShaderCost &cost = shader_costs[ref.m_shader_index];
+        for (uint32_t i = 0; i < Dive::kShaderInstructionClassCount; ++i)
+            stats_list[Dive::Stats::kAluInstructions + i] += cost.m_num_instructions[i];
+        min_waves = std::min(min_waves, cost.m_max_waves);
     }
+    stats_list[Dive::Stats::kMinWaves] = capture_stats.m_shader_ref_set.empty() ? 0 : min_waves;
+
+    GATHER_DISTRIBUTION(capture_stats.m_num_instructions, Instructions);
+    GATHER_DISTRIBUTION(capture_stats.m_num_gprs, GPRs);
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -416,6 +734,25 @@ void TraceStats::PrintTraceStats(const CaptureStats &capture_stats, std::ostream
         }
     }
 
+    const auto print_histogram = [&ostream](const char *name, const StreamingStats &stats) {
+        if (stats.empty())
+            return;
+        ostream << name << ":\n";
+        const Log2Histogram &histogram = stats.GetHistogram();
+        for (uint32_t bucket = 0; bucket < Log2Histogram::kNumBuckets; ++bucket)
+        {
+            if (histogram.GetCount(bucket) == 0)
+                continue;
+            std::ostringstream range;
+            range << Log2Histogram::GetBucketMin(bucket) << "-"
+                  << Log2Histogram::GetBucketMax(bucket);
+            ostream << "\t" << std::setw(24) << range.str() << histogram.GetCount(bucket) << "\n";
+        }
+    };
+    print_histogram("Indices per draw", capture_stats.m_num_indices);
+    print_histogram("Instructions per shader", capture_stats.m_num_instructions);
+    print_histogram("GPRs per shader", capture_stats.m_num_gprs);
+
     ostream << viewport_stats_desc[kViewport] << ":\n";
 
     auto print_field = [&ostream](std::string_view name, auto value, bool is_last_item) {
@@ -430,7 +767,7 @@ void TraceStats::PrintTraceStats(const CaptureStats &capture_stats, std::ostream
         ostream << std::left << string_stream.str();
     };
 
-    for (const Viewport &vp : capture_stats.m_viewports)
+    for (const Viewport &vp : GetSortedViewports(capture_stats))
     {
         ostream << "\t";
         print_field(viewport_stats_desc[kViewport_x], vp.m_vk_viewport.x, false);
@@ -442,6 +779,14 @@ void TraceStats::PrintTraceStats(const CaptureStats &capture_stats, std::ostream
         ostream << std::endl;
     }
 
+    ostream << "Distinct draw states:\n";
+    for (uint32_t group = 0; group < Dive::EventStateGroups::kGroupCount; ++group)
+    {
+        auto group_type = static_cast<Dive::EventStateGroups::Group>(group);
+        ostream << "\t" << Dive::EventStateGroups::GetGroupName(group_type) << ": "
+                << capture_stats.m_num_distinct_draw_states[group] << "\n";
+    }
+
     ostream << window_scissor_stats_desc[kWindowScissors] << ":\n";
     ostream << "\t" << kStatDescriptions[Stats::kNumBinningPasses] << ": "
             << stats_list[Stats::kNumBinningPasses] << "\n";
@@ -449,7 +794,7 @@ void TraceStats::PrintTraceStats(const CaptureStats &capture_stats, std::ostream
             << stats_list[Stats::kNumTilingPasses] << "\n";
 
     uint32_t count = 0;
-    for (const WindowScissor &ws : capture_stats.m_window_scissors)
+    for (const WindowScissor &ws : GetSortedWindowScissors(capture_stats))
     {
         ostream << "\t" << count++ << "\t";
         print_field(window_scissor_stats_desc[kWindowScissors_tl_x], ws.m_tl_x, false);
@@ -464,6 +809,521 @@ void TraceStats::PrintTraceStats(const CaptureStats &capture_stats, std::ostream
                     true);
         ostream << std::endl;
     }
+
+    // GMEM traffic is given in bytes per capture, along with each pass's share of it
+    ostream << "Render passes:\n";
+    count = 0;
+    for (const RenderPassStats &pass : capture_stats.m_render_passes)
+    {
+        std::ostringstream share;
+        share << std::fixed << std::setprecision(1)
+              << GetTrafficShare(pass.m_load_bytes + pass.m_store_bytes, capture_stats);
+        ostream << "\t" << count++ << "\t" << (pass.m_is_tiled ? "Tiled" : "Direct")
+                << ", submit: " << pass.m_submit_index << ", events: " << pass.m_first_event
+                << "-" << pass.m_end_event << ", draws: " << pass.m_num_draws
+                << ", bins: " << pass.m_bins.size() << ", load bytes: " << pass.m_load_bytes
+                << ", store bytes: " << pass.m_store_bytes << " (" << share.str()
+                << "% of GMEM traffic)\n";
+        for (uint32_t bin = 0; bin < pass.m_bins.size(); ++bin)
+        {
+            const BinStats &bin_stats = pass.m_bins[bin];
+            ostream << "\t\tBin " << bin << "\tx: " << bin_stats.m_x << ", y: " << bin_stats.m_y
+                    << ", width: " << bin_stats.m_width << ", height: " << bin_stats.m_height
+                    << ", draws: " << bin_stats.m_num_draws
+                    << ", load bytes: " << bin_stats.m_load_bytes
+                    << ", store bytes: " << bin_stats.m_store_bytes << "\n";
+        }
+    }
+
+    // Vertex cycles are per vertex and for all the vertices, fragment cycles per fragment
+    ostream << "Most expensive draws:\n";
+    count = 0;
+    for (const DrawCostStats &draw : capture_stats.m_draw_costs)
+    {
+        ostream << "\t" << count++ << "\tevent: " << draw.m_event_id
+                << ", submit: " << draw.m_submit_index << ", vertices: " << draw.m_num_vertices
+                << ", vertex cycles: " << draw.m_vertex_cycles << " (" << draw.GetVertexCost()
+                << " total), fragment cycles: " << draw.m_fragment_cycles
+                << ", min waves: " << draw.m_min_waves << "\n";
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+void TraceStats::PrintTraceStatsJson(const CaptureStats &capture_stats, std::ostream &ostream)
+{
+    std::ios_base::fmtflags flags = ostream.flags();
+    std::streamsize         precision = ostream.precision(9);
+    ostream.unsetf(std::ios_base::floatfield);
+
+    ostream << "{\n  \"stats\": {";
+    for (uint32_t i = 0; i < kStatKeyMap.size(); ++i)
+    {
+        const auto &[stat, key] = kStatKeyMap[i];
+        ostream << (i == 0 ? "\n    " : ",\n    ");
+        PrintJsonString(ostream, key);
+        ostream << ": " << capture_stats.m_stats_list[stat];
+    }
+
+    ostream << "\n  },\n  \"distinct_draw_states\": {";
+    for (uint32_t group = 0; group < Dive::EventStateGroups::kGroupCount; ++group)
+    {
+        auto group_type = static_cast<Dive::EventStateGroups::Group>(group);
+        ostream << (group == 0 ? "\n    " : ",\n    ");
+        PrintJsonString(ostream, Dive::EventStateGroups::GetGroupName(group_type));
+        ostream << ": " << capture_stats.m_num_distinct_draw_states[group];
+    }
+
+    ostream << "\n  },\n  \"histograms\": {";
+    bool first = true;
+    for (const auto &[name, stats] : GetDistributions(capture_stats))
+    {
+        ostream << (first ? "\n    " : ",\n    ");
+        first = false;
+        PrintJsonString(ostream, name);
+        ostream << ": [";
+        const Log2Histogram &histogram = stats->GetHistogram();
+        bool                 first_bucket = true;
+        for (uint32_t bucket = 0; bucket < Log2Histogram::kNumBuckets; ++bucket)
+        {
+            if (histogram.GetCount(bucket) == 0)
+                continue;
+            ostream << (first_bucket ? "" : ", ")
+                    << "{\"min\": " << Log2Histogram::GetBucketMin(bucket)
+                    << ", \"max\": " << Log2Histogram::GetBucketMax(bucket)
+                    << ", \"count\": " << histogram.GetCount(bucket) << "}";
+            first_bucket = false;
+        }
+        ostream << "]";
+    }
+
+    ostream << "\n  },\n  \"viewports\": [";
+    first = true;
+    for (const Viewport &vp : GetSortedViewports(capture_stats))
+    {
+        const VkViewport &viewport = vp.m_vk_viewport;
+        ostream << (first ? "\n    " : ",\n    ");
+        first = false;
+        ostream << "{\"x\": ";
+        PrintJsonNumber(ostream, viewport.x);
+        ostream << ", \"y\": ";
+        PrintJsonNumber(ostream, viewport.y);
+        ostream << ", \"width\": ";
+        PrintJsonNumber(ostream, viewport.width);
+        ostream << ", \"height\": ";
+        PrintJsonNumber(ostream, viewport.height);
+        ostream << ", \"min_depth\": ";
+        PrintJsonNumber(ostream, viewport.minDepth);
+        ostream << ", \"max_depth\": ";
+        PrintJsonNumber(ostream, viewport.maxDepth);
+        ostream << "}";
+    }
+
+    ostream << (first ? "" : "\n  ") << "],\n  \"window_scissors\": [";
+    first = true;
+    for (const WindowScissor &ws : GetSortedWindowScissors(capture_stats))
+    {
+        ostream << (first ? "\n    " : ",\n    ");
+        first = false;
+        ostream << "{\"tl_x\": " << ws.m_tl_x << ", \"tl_y\": " << ws.m_tl_y
+                << ", \"br_x\": " << ws.m_br_x << ", \"br_y\": " << ws.m_br_y << "}";
+    }
+
+    ostream << (first ? "" : "\n  ") << "],\n  \"render_passes\": [";
+    first = true;
+    for (const RenderPassStats &pass : capture_stats.m_render_passes)
+    {
+        ostream << (first ? "\n    " : ",\n    ");
+        first = false;
+        ostream << "{\"submit\": " << pass.m_submit_index
+                << ", \"first_event\": " << pass.m_first_event
+                << ", \"end_event\": " << pass.m_end_event
+                << ", \"tiled\": " << (pass.m_is_tiled ? "true" : "false")
+                << ", \"draws\": " << pass.m_num_draws << ", \"load_bytes\": " << pass.m_load_bytes
+                << ", \"store_bytes\": " << pass.m_store_bytes << ", \"traffic_share\": ";
+        PrintJsonNumber(ostream,
+                        GetTrafficShare(pass.m_load_bytes + pass.m_store_bytes, capture_stats));
+        ostream << ", \"bins\": [";
+        for (uint32_t bin = 0; bin < pass.m_bins.size(); ++bin)
+        {
+            const BinStats &bin_stats = pass.m_bins[bin];
+            ostream << (bin == 0 ? "\n      " : ",\n      ");
+            ostream << "{\"x\": " << bin_stats.m_x << ", \"y\": " << bin_stats.m_y
+                    << ", \"width\": " << bin_stats.m_width
+                    << ", \"height\": " << bin_stats.m_height
+                    << ", \"draws\": " << bin_stats.m_num_draws
+                    << ", \"load_bytes\": " << bin_stats.m_load_bytes
+                    << ", \"store_bytes\": " << bin_stats.m_store_bytes << "}";
+        }
+        ostream << (pass.m_bins.empty() ? "" : "\n    ") << "]}";
+    }
+
+    ostream << (first ? "" : "\n  ") << "],\n  \"draw_costs\": [";
+    first = true;
+    for (const DrawCostStats &draw : capture_stats.m_draw_costs)
+    {
+        ostream << (first ? "\n    " : ",\n    ");
+        first = false;
+        ostream << "{\"event\": " << draw.m_event_id << ", \"submit\": " << draw.m_submit_index
+                << ", \"vertices\": " << draw.m_num_vertices
+                << ", \"vertex_cycles\": " << draw.m_vertex_cycles
+                << ", \"vertex_cost\": " << draw.GetVertexCost()
+                << ", \"fragment_cycles\": " << draw.m_fragment_cycles
+                << ", \"min_waves\": " << draw.m_min_waves << "}";
+    }
+    ostream << (first ? "" : "\n  ") << "]\n}\n";
+
+    ostream.flags(flags);
+    ostream.precision(precision);
+}
+
+//--------------------------------------------------------------------------------------------------
+void TraceStats::PrintTraceStatsCsv(const CaptureStats &capture_stats, std::ostream &ostream)
+{
+    PrintCsvRow(ostream, "section", "item", "field", "value");
+    for (const auto &[stat, key] : kStatKeyMap)
+        PrintCsvRow(ostream, "stat", "", key, ToString(capture_stats.m_stats_list[stat]));
+
+    for (uint32_t group = 0; group < Dive::EventStateGroups::kGroupCount; ++group)
+    {
+        auto group_type = static_cast<Dive::EventStateGroups::Group>(group);
+        PrintCsvRow(ostream,
+                    "distinct_draw_states",
+                    "",
+                    Dive::EventStateGroups::GetGroupName(group_type),
+                    ToString(capture_stats.m_num_distinct_draw_states[group]));
+    }
+
+    for (const auto &[name, stats] : GetDistributions(capture_stats))
+    {
+        std::string          section = std::string(name) + "_histogram";
+        const Log2Histogram &histogram = stats->GetHistogram();
+        uint32_t             item = 0;
+        for (uint32_t bucket = 0; bucket < Log2Histogram::kNumBuckets; ++bucket)
+        {
+            if (histogram.GetCount(bucket) == 0)
+                continue;
+            std::string item_str = ToString(item++);
+            std::string min_str = ToString(Log2Histogram::GetBucketMin(bucket));
+            std::string max_str = ToString(Log2Histogram::GetBucketMax(bucket));
+            PrintCsvRow(ostream, section, item_str, "min", min_str);
+            PrintCsvRow(ostream, section, item_str, "max", max_str);
+            PrintCsvRow(ostream, section, item_str, "count", ToString(histogram.GetCount(bucket)));
+        }
+    }
+
+    uint32_t item = 0;
+    for (const Viewport &vp : GetSortedViewports(capture_stats))
+    {
+        const VkViewport &viewport = vp.m_vk_viewport;
+        std::string       item_str = ToString(item++);
+        PrintCsvRow(ostream, "viewport", item_str, "x", ToString(viewport.x));
+        PrintCsvRow(ostream, "viewport", item_str, "y", ToString(viewport.y));
+        PrintCsvRow(ostream, "viewport", item_str, "width", ToString(viewport.width));
+        PrintCsvRow(ostream, "viewport", item_str, "height", ToString(viewport.height));
+        PrintCsvRow(ostream, "viewport", item_str, "min_depth", ToString(viewport.minDepth));
+        PrintCsvRow(ostream, "viewport", item_str, "max_depth", ToString(viewport.maxDepth));
+    }
+
+    item = 0;
+    for (const WindowScissor &ws : GetSortedWindowScissors(capture_stats))
+    {
+        std::string item_str = ToString(item++);
+        PrintCsvRow(ostream, "window_scissor", item_str, "tl_x", ToString(ws.m_tl_x));
+        PrintCsvRow(ostream, "window_scissor", item_str, "tl_y", ToString(ws.m_tl_y));
+        PrintCsvRow(ostream, "window_scissor", item_str, "br_x", ToString(ws.m_br_x));
+        PrintCsvRow(ostream, "window_scissor", item_str, "br_y", ToString(ws.m_br_y));
+    }
+
+    item = 0;
+    for (const RenderPassStats &pass : capture_stats.m_render_passes)
+    {
+        std::string item_str = ToString(item++);
+        double share = GetTrafficShare(pass.m_load_bytes + pass.m_store_bytes, capture_stats);
+        PrintCsvRow(ostream, "render_pass", item_str, "submit", ToString(pass.m_submit_index));
+        PrintCsvRow(ostream, "render_pass", item_str, "first_event", ToString(pass.m_first_event));
+        PrintCsvRow(ostream, "render_pass", item_str, "end_event", ToString(pass.m_end_event));
+        PrintCsvRow(ostream, "render_pass", item_str, "tiled", ToString(int(pass.m_is_tiled)));
+        PrintCsvRow(ostream, "render_pass", item_str, "draws", ToString(pass.m_num_draws));
+        PrintCsvRow(ostream, "render_pass", item_str, "load_bytes", ToString(pass.m_load_bytes));
+        PrintCsvRow(ostream, "render_pass", item_str, "store_bytes", ToString(pass.m_store_bytes));
+        PrintCsvRow(ostream, "render_pass", item_str, "traffic_share", ToString(share));
+        for (uint32_t bin = 0; bin < pass.m_bins.size(); ++bin)
+        {
+            const BinStats &bin_stats = pass.m_bins[bin];
+            std::string     bin_str = item_str + "." + ToString(bin);
+            PrintCsvRow(ostream, "bin", bin_str, "x", ToString(bin_stats.m_x));
+            PrintCsvRow(ostream, "bin", bin_str, "y", ToString(bin_stats.m_y));
+            PrintCsvRow(ostream, "bin", bin_str, "width", ToString(bin_stats.m_width));
+            PrintCsvRow(ostream, "bin", bin_str, "height", ToString(bin_stats.m_height));
+            PrintCsvRow(ostream, "bin", bin_str, "draws", ToString(bin_stats.m_num_draws));
+            PrintCsvRow(ostream, "bin", bin_str, "load_bytes", ToString(bin_stats.m_load_bytes));
+            PrintCsvRow(ostream, "bin", bin_str, "store_bytes", ToString(bin_stats.m_store_bytes));
+        }
+    }
+
+    item = 0;
+    for (const DrawCostStats &draw : capture_stats.m_draw_costs)
+    {
+        std::string item_str = ToString(item++);
+        const auto  print_field = [&](std::string_view field, uint64_t value) {
+            PrintCsvRow(ostream, "draw_cost", item_str, field, ToString(value));
+        };
+        print_field("event", draw.m_event_id);
+        print_field("submit", draw.m_submit_index);
+        print_field("vertices", draw.m_num_vertices);
+        print_field("vertex_cycles", draw.m_vertex_cycles);
+        print_field("vertex_cost", draw.GetVertexCost());
+        print_field("fragment_cycles", draw.m_fragment_cycles);
+        print_field("min_waves", draw.m_min_waves);
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+bool TraceStats::DiffTraceStats(const CaptureStats               &baseline,
+                                const CaptureStats               &candidate,
+                                const std::vector<StatThreshold> &thresholds,
+                                std::vector<StatDiff>            &diffs)
+{
+    diffs.clear();
+    bool regressed = false;
+    for (uint32_t i = 0; i < Stats::kNumStats; ++i)
+    {
+        StatDiff diff = { static_cast<Stats::Type>(i),
+                          baseline.m_stats_list[i],
+                          candidate.m_stats_list[i],
+                          false };
+        auto threshold = std::find_if(thresholds.rbegin(),
+                                      thresholds.rend(),
+                                      [&diff](const StatThreshold &threshold) {
+                                          return threshold.m_stat == diff.m_stat;
+                                      });
+        uint64_t worse = diff.m_candidate, better = diff.m_baseline;
+        if (IsDecreaseRegression(diff.m_stat))
+            std::swap(worse, better);
+        if (threshold != thresholds.rend() && worse > better)
+        {
+            double increase = static_cast<double>(worse - better);
+            double max_increase = threshold->m_max_increase;
+            if (threshold->m_is_relative)
+                max_increase *= static_cast<double>(diff.m_baseline) / 100.0;
+            diff.m_regressed = (increase > max_increase);
+        }
+        regressed |= diff.m_regressed;
+        diffs.push_back(diff);
+    }
+    return regressed;
+}
+
+//--------------------------------------------------------------------------------------------------
+void TraceStats::PrintTraceStatsDiff(const std::vector<StatDiff> &diffs, std::ostream &ostream)
+{
+    ostream << std::left << std::setw(36) << "stat" << std::setw(14) << "baseline"
+            << std::setw(14) << "candidate" << "change\n";
+
+    uint32_t num_regressions = 0;
+    for (const StatDiff &diff : diffs)
+    {
+        if (diff.m_baseline == diff.m_candidate)
+            continue;
+
+        int64_t change = static_cast<int64_t>(diff.m_candidate - diff.m_baseline);
+        std::ostringstream change_str;
+        change_str << (change > 0 ? "+" : "") << change;
+        if (diff.m_baseline != 0)
+        {
+            change_str << " (" << (change > 0 ? "+" : "") << std::fixed << std::setprecision(1)
+                       << 100.0 * static_cast<double>(change) / static_cast<double>(diff.m_baseline)
+                       << "%)";
+        }
+        ostream << std::setw(36) << kStatKeyMap[diff.m_stat].second << std::setw(14)
+                << diff.m_baseline << std::setw(14) << diff.m_candidate << std::setw(20)
+                << change_str.str() << (diff.m_regressed ? "REGRESSION" : "") << "\n";
+        num_regressions += diff.m_regressed ? 1 : 0;
+    }
+    ostream << num_regressions << " regression(s)\n";
+}
+
+//--------------------------------------------------------------------------------------------------
+void TraceStats::PrintRedundancyReport(const RedundancyReport &report, std::ostream &ostream)
+{
+    const auto print_submit = [&ostream](const SubmitRedundancy &submit) {
+        uint64_t redundant_dwords = submit.GetRedundantDwords();
+        double   share = submit.m_num_dwords == 0 ? 0.0 :
+                                                    100.0 * static_cast<double>(redundant_dwords) /
+                                                    static_cast<double>(submit.m_num_dwords);
+        std::ostringstream share_stream;
+        share_stream << std::fixed << std::setprecision(1) << share;
+        ostream << "Redundant dwords: " << redundant_dwords << " of " << submit.m_num_dwords << " ("
+                << share_stream.str() << "%)\n";
+        ostream << "\t\tRedundant register writes: " << FormatRedundancy(submit.m_reg_writes)
+                << "\n";
+        ostream << "\t\tRedundant draw state groups: "
+                << FormatRedundancy(submit.m_draw_state_groups) << "\n";
+        ostream << "\t\tUnnecessary waits: " << FormatRedundancy(submit.m_waits) << "\n";
+        ostream << "\t\tNo-op draws: " << FormatRedundancy(submit.m_draws) << "\n";
+        ostream << "\t\tEmpty bins: " << FormatRedundancy(submit.m_bins) << "\n";
+    };
+
+    ostream << "Capture:\n\t";
+    print_submit(report.GetTotals());
+    ostream << "Submits:\n";
+    for (const SubmitRedundancy &submit : report.m_submits)
+    {
+        ostream << "\t" << submit.m_submit_index << "\t";
+        print_submit(submit);
+    }
+
+    ostream << "Registers with redundant writes:\n";
+    for (const auto &[offset, count] : GetSortedRedundancies(report.m_registers))
+    {
+        const RegInfo *reg_info = GetRegInfo(offset);
+        ostream << "\t";
+        if (reg_info != nullptr)
+            ostream << reg_info->m_name;
+        else
+            ostream << "0x" << std::hex << offset << std::dec;
+        ostream << ": " << FormatRedundancy(count) << "\n";
+    }
+
+    ostream << "Packets with redundancies:\n";
+    for (const auto &[key, count] : GetSortedRedundancies(report.m_packets))
+    {
+        const char *name = (key == RedundancyReport::kType4Packet) ? "TYPE4" :
+                                                                      GetOpCodeString(key);
+        ostream << "\t" << (name ? name : "UNKNOWN") << ": " << FormatRedundancy(count) << "\n";
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+void TraceStats::PrintIndexBufferReport(const IndexBufferReport &report, std::ostream &ostream)
+{
+    constexpr size_t kMaxDraws = 20;
+
+    const auto print_stats = [&ostream](const IndexBufferStats &stats) {
+        std::ostringstream ratios;
+        ratios << std::fixed << std::setprecision(2) << "ACMR: " << stats.GetAcmr()
+               << ", ATVR: " << stats.GetAtvr();
+        ostream << "indices: " << stats.m_num_indices
+                << ", unique vertices: " << stats.m_num_unique_vertices
+                << ", vertices shaded: " << stats.m_num_cache_misses
+                << ", triangles: " << stats.m_num_triangles
+                << " (degenerate: " << stats.m_num_degenerate_triangles << "), " << ratios.str()
+                << "\n";
+    };
+
+    ostream << "Vertex cache: FIFO of " << report.m_cache_size << " vertices\n";
+    ostream << "Indexed draws: " << report.m_draws.size() << ", distinct index ranges: "
+            << report.m_ranges.size()
+            << ", draws with indices not in the capture: " << report.m_unreadable_draws.size()
+            << "\n";
+    ostream << "Capture:\n\t";
+    print_stats(report.GetTotals());
+
+    // Vertices shaded more than once, which a better vertex order would save
+    const auto get_reshaded = [&report](const IndexBufferReport::Draw &draw) {
+        const IndexBufferStats &stats = report.m_ranges[draw.m_range_index];
+        return stats.m_num_cache_misses - stats.m_num_unique_vertices;
+    };
+    std::vector<IndexBufferReport::Draw> draws = report.m_draws;
+    size_t                               num_draws = std::min(draws.size(), kMaxDraws);
+    std::partial_sort(draws.begin(),
+                      draws.begin() + num_draws,
+                      draws.end(),
+                      [&get_reshaded](const auto &a, const auto &b) {
+                          return get_reshaded(a) > get_reshaded(b);
+                      });
+    ostream << "Draws shading the most vertices more than once:\n";
+    for (size_t i = 0; i < num_draws && get_reshaded(draws[i]) != 0; ++i)
+    {
+        ostream << "\t" << i << "\tevent: " << draws[i].m_event_id
+                << ", submit: " << draws[i].m_submit_index << ", ";
+        print_stats(report.m_ranges[draws[i].m_range_index]);
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+void TraceStats::PrintFrameStabilityReport(const FrameStabilityReport &report,
+                                           std::ostream               &ostream)
+{
+    // Listed per frame, and for the fingerprints missing from some frames
+    constexpr size_t kMaxListedDifferences = 10;
+
+    const auto print_diff = [&ostream](const FrameDiff &diff) {
+        ostream << "inserted: " << diff.m_num_inserted << ", deleted: " << diff.m_num_deleted
+                << ", changed: " << diff.m_num_changed;
+        if (!diff.m_is_aligned)
+            ostream << " (too different to align, paired in order)";
+        ostream << "\n";
+    };
+    const auto print_components = [&ostream](uint32_t mask) {
+        const char *separator = "";
+        for (uint32_t component = 0; component < kFingerprintComponentCount; ++component)
+        {
+            if ((mask & (1u << component)) != 0)
+            {
+                ostream << separator << GetFingerprintComponentName(component);
+                separator = ", ";
+            }
+        }
+    };
+
+    FrameDiff totals = report.GetTotals();
+    ostream << "Frames: " << report.m_frames.size() << "\n";
+    const std::vector<IntermittentFingerprint> &intermittent = report.m_intermittent_fingerprints;
+    ostream << "Draw fingerprints: " << report.m_num_fingerprints
+            << ", in only some frames: " << intermittent.size() << "\n";
+    for (size_t i = 0; i < std::min(intermittent.size(), kMaxListedDifferences); ++i)
+    {
+        ostream << "\tfirst at event " << intermittent[i].m_first_event_id << ", in "
+                << intermittent[i].m_num_frames << " of " << report.m_frames.size()
+                << " frames\n";
+    }
+    if (intermittent.size() > kMaxListedDifferences)
+        ostream << "\t... " << intermittent.size() - kMaxListedDifferences << " more\n";
+    ostream << "Differences from the previous frame:\n\t";
+    print_diff(totals);
+    ostream << "Changes by component:\n";
+    for (uint32_t component = 0; component < kFingerprintComponentCount; ++component)
+    {
+        ostream << "\t" << GetFingerprintComponentName(component) << ": "
+                << totals.m_changed_components[component] << "\n";
+    }
+
+    ostream << "Frames:\n";
+    for (size_t i = 0; i < report.m_frames.size(); ++i)
+    {
+        const FrameStability &frame = report.m_frames[i];
+        ostream << "\t" << i << "\tsubmits: [" << frame.m_first_submit << ", "
+                << frame.m_end_submit << "), draws: " << frame.m_event_ids.size() << ", ";
+        print_diff(frame.m_diff);
+
+        const std::vector<FrameDifference> &differences = frame.m_diff.m_differences;
+        for (size_t j = 0; j < std::min(differences.size(), kMaxListedDifferences); ++j)
+        {
+            const FrameDifference &difference = differences[j];
+            ostream << "\t\t";
+            switch (difference.m_type)
+            {
+            case FrameDifference::Type::kInserted:
+                ostream << "inserted event " << frame.m_event_ids[difference.m_index];
+                break;
+            case FrameDifference::Type::kDeleted:
+                ostream << "deleted event "
+                        << report.m_frames[i - 1].m_event_ids[difference.m_index];
+                break;
+            case FrameDifference::Type::kChanged:
+                ostream << "changed event " << frame.m_event_ids[difference.m_index]
+                        << " (was event "
+                        << report.m_frames[i - 1].m_event_ids[difference.m_previous_index]
+                        << "): ";
+                print_components(difference.m_changed_components);
+                break;
+            }
+            ostream << "\n";
+        }
+        if (differences.size() > kMaxListedDifferences)
+            ostream << "\t\t... " << differences.size() - kMaxListedDifferences << " more\n";
+    }
 }
 
 }  // namespace Dive
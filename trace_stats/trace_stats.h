@@ -19,11 +19,18 @@
 
 #include "vulkan/vulkan_core.h"
 #include <array>
-#include <set>
+#include <functional>
+#include <string_view>
+#include <unordered_set>
 #include <vector>
 #include "dive_core/context.h"
 #include "dive_core/capture_event_info.h"
 #include "dive_core/data_core.h"
+#include "dive_core/frame_stability.h"
+#include "dive_core/index_buffer_analysis.h"
+#include "dive_core/redundancy_analyzer.h"
+#include "dive_core/shader_cost.h"
+#include "dive_core/streaming_stats.h"
 
 namespace Dive
 {
@@ -42,6 +49,8 @@ namespace Dive
 // Number of unique shaders, per stage (BINNING vs TILING)
 //  Min, Max, and total instruction counts
 //  Min, Max, and total GPR count
+//  Instructions per category, and min occupancy
+// Estimated shader cost of the draws
 // Number of CPEventWrites
 //  RESOLVE, FLUSH_COLOR, FLUSH_DEPTH, INVALIDATE_COLOR, INVALIDATE_DEPTH
 // Number of CpWaitForIdle()
@@ -72,6 +81,8 @@ struct Stats
         kMinIndices,
         kMaxIndices,
         kMedianIndices,
+        kP90Indices,
+        kP99Indices,
         kShaders,
         kBinningVS,
         kNonBinningVS,
@@ -80,10 +91,21 @@ struct Stats
         kMinInstructions,
         kMaxInstructions,
         kMedianInstructions,
+        kP90Instructions,
+        kP99Instructions,
         kTotalGPRs,
         kMinGPRs,
         kMaxGPRs,
         kMedianGPRs,
+        kP90GPRs,
+        kP99GPRs,
+        kAluInstructions,
+        kSfuInstructions,
+        kTextureInstructions,
+        kMemoryInstructions,
+        kFlowInstructions,
+        kMinWaves,
+        kVertexShaderCycles,
         kTotalResolves,
         kColorSysMemToGmemResolves,
         kColorGmemToSysMemResolves,
@@ -91,6 +113,9 @@ struct Stats
         kDepthGmemToSysMemResolves,
         kColorClearGmemResolves,
         kDepthClearGmemResolves,
+        kNumBins,
+        kGmemLoadBytes,
+        kGmemStoreBytes,
         kNumStats
     };
 };
@@ -117,6 +142,8 @@ constexpr std::array kStatMap = {
     std::pair(Stats::kMinIndices, "\tMin indices in a single draw"),
     std::pair(Stats::kMaxIndices, "\tMax indices in a single draw"),
     std::pair(Stats::kMedianIndices, "\tMedian indices in a single draw"),
+    std::pair(Stats::kP90Indices, "\t90th percentile indices in a single draw"),
+    std::pair(Stats::kP99Indices, "\t99th percentile indices in a single draw"),
     std::pair(Stats::kShaders, "Number of unique shaders"),
     std::pair(Stats::kBinningVS, "\tNumber of BINNING VS"),
     std::pair(Stats::kNonBinningVS, "\tNumber of non-BINNING VS"),
@@ -125,10 +152,21 @@ constexpr std::array kStatMap = {
     std::pair(Stats::kMinInstructions, "\tMin instructions in a single shader"),
     std::pair(Stats::kMaxInstructions, "\tMax instructions in a single shader"),
     std::pair(Stats::kMedianInstructions, "\tMedian instructions in a single shader"),
+    std::pair(Stats::kP90Instructions, "\t90th percentile instructions in a single shader"),
+    std::pair(Stats::kP99Instructions, "\t99th percentile instructions in a single shader"),
     std::pair(Stats::kTotalGPRs, "Total GPRs in all shaders"),
     std::pair(Stats::kMinGPRs, "\tMin GPRs in a single shader"),
     std::pair(Stats::kMaxGPRs, "\tMax GPRs in a single shader"),
     std::pair(Stats::kMedianGPRs, "\tMedian GPRs in a single shader"),
+    std::pair(Stats::kP90GPRs, "\t90th percentile GPRs in a single shader"),
+    std::pair(Stats::kP99GPRs, "\t99th percentile GPRs in a single shader"),
+    std::pair(Stats::kAluInstructions, "ALU instructions in all shaders, with repeats"),
+    std::pair(Stats::kSfuInstructions, "\tSFU instructions in all shaders, with repeats"),
+    std::pair(Stats::kTextureInstructions, "\tTexture instructions in all shaders"),
+    std::pair(Stats::kMemoryInstructions, "\tMemory instructions in all shaders"),
+    std::pair(Stats::kFlowInstructions, "\tFlow control instructions in all shaders"),
+    std::pair(Stats::kMinWaves, "Min waves per SP allowed by the GPRs of a shader"),
+    std::pair(Stats::kVertexShaderCycles, "Estimated vertex shader cycles in all draws"),
     std::pair(Stats::kTotalResolves, "Total resolves"),
     std::pair(Stats::kColorSysMemToGmemResolves, "\tColor SysMem to Gmem Resolves"),
     std::pair(Stats::kColorGmemToSysMemResolves, "\tColor Gmem to SysMem Resolves"),
@@ -136,8 +174,82 @@ constexpr std::array kStatMap = {
     std::pair(Stats::kDepthGmemToSysMemResolves, "\tDepth Gmem to SysMem Resolves"),
     std::pair(Stats::kColorClearGmemResolves, "\tColor Gmem Clears"),
     std::pair(Stats::kDepthClearGmemResolves, "\tDepth Gmem Clears"),
+    std::pair(Stats::kNumBins, "Num Bins"),
+    std::pair(Stats::kGmemLoadBytes, "Bytes loaded from SysMem to Gmem"),
+    std::pair(Stats::kGmemStoreBytes, "Bytes stored from Gmem to SysMem"),
 };
 
+// Machine-readable name of each stat, used as its key in the JSON and CSV outputs. In the order of
+// Stats::Type, so kStatKeyMap[stat] is the entry of `stat`
+constexpr std::array kStatKeyMap = {
+    std::pair(Stats::kNumBinningPasses, "num_binning_passes"),
+    std::pair(Stats::kNumTilingPasses, "num_tiling_passes"),
+    std::pair(Stats::kBinningDraws, "binning_draws"),
+    std::pair(Stats::kDirectDraws, "direct_draws"),
+    std::pair(Stats::kTiledDraws, "tiled_draws"),
+    std::pair(Stats::kDispatches, "dispatches"),
+    std::pair(Stats::kWaitMemWrites, "wait_mem_writes"),
+    std::pair(Stats::kWaitForIdle, "wait_for_idle"),
+    std::pair(Stats::kWaitForMe, "wait_for_me"),
+    std::pair(Stats::kDepthTestEnabled, "depth_test_enabled_draws"),
+    std::pair(Stats::kDepthWriteEnabled, "depth_write_enabled_draws"),
+    std::pair(Stats::kEarlyZ, "early_z_draws"),
+    std::pair(Stats::kLateZ, "late_z_draws"),
+    std::pair(Stats::kEarlyZLateZ, "early_z_late_z_draws"),
+    std::pair(Stats::kLrzEnabled, "lrz_enabled_draws"),
+    std::pair(Stats::kLrzWriteEnabled, "lrz_write_enabled_draws"),
+    std::pair(Stats::kCullModeEnabled, "cull_mode_enabled_draws"),
+    std::pair(Stats::kTotalIndices, "total_indices"),
+    std::pair(Stats::kMinIndices, "min_indices"),
+    std::pair(Stats::kMaxIndices, "max_indices"),
+    std::pair(Stats::kMedianIndices, "median_indices"),
+    std::pair(Stats::kP90Indices, "p90_indices"),
+    std::pair(Stats::kP99Indices, "p99_indices"),
+    std::pair(Stats::kShaders, "shaders"),
+    std::pair(Stats::kBinningVS, "binning_vs"),
+    std::pair(Stats::kNonBinningVS, "non_binning_vs"),
+    std::pair(Stats::kNonVS, "non_vs"),
+    std::pair(Stats::kTotalInstructions, "total_instructions"),
+    std::pair(Stats::kMinInstructions, "min_instructions"),
+    std::pair(Stats::kMaxInstructions, "max_instructions"),
+    std::pair(Stats::kMedianInstructions, "median_instructions"),
+    std::pair(Stats::kP90Instructions, "p90_instructions"),
+    std::pair(Stats::kP99Instructions, "p99_instructions"),
+    std::pair(Stats::kTotalGPRs, "total_gprs"),
+    std::pair(Stats::kMinGPRs, "min_gprs"),
+    std::pair(Stats::kMaxGPRs, "max_gprs"),
+    std::pair(Stats::kMedianGPRs, "median_gprs"),
+    std::pair(Stats::kP90GPRs, "p90_gprs"),
+    std::pair(Stats::kP99GPRs, "p99_gprs"),
+    std::pair(Stats::kAluInstructions, "alu_instructions"),
+    std::pair(Stats::kSfuInstructions, "sfu_instructions"),
+    std::pair(Stats::kTextureInstructions, "texture_instructions"),
+    std::pair(Stats::kMemoryInstructions, "memory_instructions"),
+    std::pair(Stats::kFlowInstructions, "flow_instructions"),
+    std::pair(Stats::kMinWaves, "min_waves"),
+    std::pair(Stats::kVertexShaderCycles, "vertex_shader_cycles"),
+    std::pair(Stats::kTotalResolves, "total_resolves"),
+    std::pair(Stats::kColorSysMemToGmemResolves, "color_sysmem_to_gmem_resolves"),
+    std::pair(Stats::kColorGmemToSysMemResolves, "color_gmem_to_sysmem_resolves"),
+    std::pair(Stats::kDepthSysMemToGmemResolves, "depth_sysmem_to_gmem_resolves"),
+    std::pair(Stats::kDepthGmemToSysMemResolves, "depth_gmem_to_sysmem_resolves"),
+    std::pair(Stats::kColorClearGmemResolves, "color_gmem_clears"),
+    std::pair(Stats::kDepthClearGmemResolves, "depth_gmem_clears"),
+    std::pair(Stats::kNumBins, "num_bins"),
+    std::pair(Stats::kGmemLoadBytes, "gmem_load_bytes"),
+    std::pair(Stats::kGmemStoreBytes, "gmem_store_bytes"),
+};
+static_assert(kStatKeyMap.size() == Stats::kNumStats);
+static_assert([] {
+    for (uint32_t i = 0; i < kStatKeyMap.size(); ++i)
+        if (kStatKeyMap[i].first != i)
+            return false;
+    return true;
+}());
+
+// Finds the stat named `key` in kStatKeyMap
+bool FindStatByKey(std::string_view key, Stats::Type &stat);
+
 enum ViewPortStats
 {
     kViewport,
@@ -187,6 +299,15 @@ struct Viewport
             return m_vk_viewport.minDepth < other.m_vk_viewport.minDepth;
         return m_vk_viewport.maxDepth < other.m_vk_viewport.maxDepth;
     }
+    bool operator==(const Viewport &other) const
+    {
+        return m_vk_viewport.x == other.m_vk_viewport.x &&
+               m_vk_viewport.y == other.m_vk_viewport.y &&
+               m_vk_viewport.width == other.m_vk_viewport.width &&
+               m_vk_viewport.height == other.m_vk_viewport.height &&
+               m_vk_viewport.minDepth == other.m_vk_viewport.minDepth &&
+               m_vk_viewport.maxDepth == other.m_vk_viewport.maxDepth;
+    }
 };
 
 struct WindowScissor
@@ -209,6 +330,98 @@ struct WindowScissor
             return m_br_y < other.m_br_y;
         return m_br_x < other.m_br_x;
     }
+    bool operator==(const WindowScissor &other) const
+    {
+        return m_tl_x == other.m_tl_x && m_tl_y == other.m_tl_y && m_br_x == other.m_br_x &&
+               m_br_y == other.m_br_y;
+    }
+};
+
+// Hashes for the unique sets below. They are unordered since they are filled from several
+// threads and merged; sort them with operator< before presenting them
+struct ShaderReferenceHash
+{
+    size_t operator()(const Dive::ShaderReference &ref) const
+    {
+        uint64_t key = (uint64_t(ref.m_shader_index) << 32) |
+                       ((uint64_t(ref.m_stage) << 24) ^ ref.m_enable_mask);
+        return std::hash<uint64_t>()(key);
+    }
+};
+
+struct ViewportHash
+{
+    size_t operator()(const Viewport &viewport) const
+    {
+        // std::hash<float> maps 0.0 and -0.0, which compare equal, to the same value
+        const VkViewport &vp = viewport.m_vk_viewport;
+        size_t            hash = 0;
+        for (float value : { vp.x, vp.y, vp.width, vp.height, vp.minDepth, vp.maxDepth })
+            hash = hash * 31 + std::hash<float>()(value);
+        return hash;
+    }
+};
+
+struct WindowScissorHash
+{
+    size_t operator()(const WindowScissor &scissor) const
+    {
+        uint64_t key = (uint64_t(scissor.m_tl_x) << 48) | (uint64_t(scissor.m_tl_y) << 32) |
+                       (uint64_t(scissor.m_br_x) << 16) | uint64_t(scissor.m_br_y);
+        return std::hash<uint64_t>()(key ^ (key >> 29));
+    }
+};
+
+// Draws and GMEM traffic of a bin. Bytes are those of the system memory side of the loads and
+// stores, from the resolve area and format; resolves of unknown format count as 0 bytes
+struct BinStats
+{
+    uint32_t m_x;
+    uint32_t m_y;
+    uint32_t m_width;
+    uint32_t m_height;
+    uint32_t m_num_draws = 0;
+    uint64_t m_load_bytes = 0;
+    uint64_t m_store_bytes = 0;
+};
+
+// Draws and GMEM traffic of a render pass, in total and per bin. Draws of the binning pass are not
+// counted, and direct passes have no bins nor GMEM traffic
+struct RenderPassStats
+{
+    uint32_t              m_submit_index;
+    uint32_t              m_first_event;
+    uint32_t              m_end_event;
+    bool                  m_is_tiled;
+    uint32_t              m_num_draws = 0;
+    uint64_t              m_load_bytes = 0;
+    uint64_t              m_store_bytes = 0;
+    std::vector<BinStats> m_bins;
+};
+
+// Estimated shader cost of a draw. Vertex, geometry and tessellation shaders are weighted by the
+// vertices drawn; fragment shaders by nothing, since the pixels a draw covers are not known
+// without a GPU
+struct DrawCostStats
+{
+    uint32_t m_event_id;
+    uint32_t m_submit_index;
+    uint64_t m_num_vertices;     // Indices times instances
+    uint32_t m_vertex_cycles;    // Per vertex, over the vertex stages
+    uint32_t m_fragment_cycles;  // Per fragment
+    uint32_t m_min_waves;        // Over the shaders of the draw
+
+    uint64_t GetVertexCost() const { return m_num_vertices * m_vertex_cycles; }
+
+    // By descending vertex cost, then fragment cycles
+    bool operator<(const DrawCostStats &other) const
+    {
+        if (GetVertexCost() != other.GetVertexCost())
+            return GetVertexCost() > other.GetVertexCost();
+        if (m_fragment_cycles != other.m_fragment_cycles)
+            return m_fragment_cycles > other.m_fragment_cycles;
+        return m_event_id < other.m_event_id;
+    }
 };
 
 // ---------------------------------------------------------------------
@@ -219,14 +432,51 @@ struct CaptureStats
 {
     std::array<uint64_t, Dive::Stats::kNumStats> m_stats_list = {};
 
-    std::vector<uint32_t> m_event_num_indices;
+    // Distributions of the index count of the draws, and of the instruction and GPR counts of the
+    // unique shaders
+    Dive::StreamingStats m_num_indices;
+    Dive::StreamingStats m_num_instructions;
+    Dive::StreamingStats m_num_gprs;
 
-    std::set<Dive::ShaderReference> m_shader_ref_set;
-    std::set<Viewport>              m_viewports;
-    std::set<WindowScissor>         m_window_scissors;
+    std::unordered_set<Dive::ShaderReference, ShaderReferenceHash> m_shader_ref_set;
+    std::unordered_set<Viewport, ViewportHash>                     m_viewports;
+    std::unordered_set<WindowScissor, WindowScissorHash>           m_window_scissors;
 
     uint32_t m_num_binning_passes = 0;
     uint32_t m_num_tiling_passes = 0;
+
+    // Number of distinct states of each state group used by the draws
+    std::array<uint32_t, Dive::EventStateGroups::kGroupCount> m_num_distinct_draw_states = {};
+
+    std::vector<RenderPassStats> m_render_passes;
+
+    // The most expensive draws, most expensive first
+    static constexpr size_t    kMaxDrawCosts = 20;
+    std::vector<DrawCostStats> m_draw_costs;
+};
+
+// ---------------------------------------------------------------------
+// Comparison of two captures
+// ---------------------------------------------------------------------
+
+// A stat regresses when it increases by more than m_max_increase, in percent of the baseline value
+// if m_is_relative. For min_waves, it is a decrease by more than m_max_increase that regresses
+struct StatThreshold
+{
+    Stats::Type m_stat;
+    double      m_max_increase;
+    bool        m_is_relative;
+};
+
+// Thresholds used when none are given: any increase in waits or in GMEM resolves and clears
+std::vector<StatThreshold> GetDefaultStatThresholds();
+
+struct StatDiff
+{
+    Stats::Type m_stat;
+    uint64_t    m_baseline;
+    uint64_t    m_candidate;
+    bool        m_regressed;
 };
 
 class TraceStats
@@ -235,13 +485,78 @@ public:
     TraceStats() = default;
     ~TraceStats() = default;
 
-    // Gather the trace statistics from the metadata
+    // Gather the trace statistics from the metadata, on at most `num_threads` worker threads (0 for
+    // ThreadPool::GetDefaultThreadCount()). With 1, everything runs on the calling thread
     void GatherTraceStats(const Dive::Context         &context,
                           const Dive::CaptureMetadata &meta_data,
-                          CaptureStats                &capture_stats);
+                          CaptureStats                &capture_stats,
+                          unsigned int                 num_threads = 0);
 
     // Print the capture statistics to the output stream
     void PrintTraceStats(const CaptureStats &capture_stats, std::ostream &ostream);
+
+    // Print the capture statistics as a JSON object, with the kStatKeyMap keys
+    void PrintTraceStatsJson(const CaptureStats &capture_stats, std::ostream &ostream);
+
+    // Print the capture statistics as CSV rows of "section,item,field,value". Stats have no item,
+    // the rows of the viewports, window scissors, histograms and render passes are numbered by
+    // item, and those of the bins by "<pass>.<bin>"
+    void PrintTraceStatsCsv(const CaptureStats &capture_stats, std::ostream &ostream);
+
+    // Compares each stat of the two captures. Returns true if any stat regressed. Only the last
+    // threshold given for a stat applies to it
+    bool DiffTraceStats(const CaptureStats               &baseline,
+                        const CaptureStats               &candidate,
+                        const std::vector<StatThreshold> &thresholds,
+                        std::vector<StatDiff>            &diffs);
+
+    // Print the stats that changed, flagging the regressions
+    void PrintTraceStatsDiff(const std::vector<StatDiff> &diffs, std::ostream &ostream);
+
+    // Print the redundant PM4 of a capture in total and per submit, then the registers and packet
+    // types with redundant writes or packets, by descending dwords saved
+    void PrintRedundancyReport(const RedundancyReport &report, std::ostream &ostream);
+
+    // Print the vertex reuse of the indexed draws of a capture in total, then the draws shading
+    // the most vertices more than once
+    void PrintIndexBufferReport(const IndexBufferReport &report, std::ostream &ostream);
+
+    // Print the differences between consecutive frames in total and per frame, with the first
+    // draws that differ in each frame
+    void PrintFrameStabilityReport(const FrameStabilityReport &report, std::ostream &ostream);
+
+private:
+    // Gathers the statistics of the events [begin, end) into `capture_stats`, and appends their
+    // draws to `draws`. Passes are counted from the render mode of event `begin - 1`, so that the
+    // chunks of a capture add up to the same totals as a single pass over it.
+    void GatherEventStats(const Dive::Context         &context,
+                          const Dive::CaptureMetadata &meta_data,
+                          size_t                       begin,
+                          size_t                       end,
+                          CaptureStats                &capture_stats,
+                          std::vector<uint32_t>       &draws);
+
+    // Adds the counters and unique sets of `partial` into `capture_stats`
+    void MergeTraceStats(const CaptureStats &partial, CaptureStats &capture_stats);
+
+    // Attributes the draws and GMEM loads and stores to the render passes and bins of the capture
+    void GatherRenderPassStats(const Dive::CaptureMetadata &meta_data, CaptureStats &capture_stats);
+
+    // Estimates the shader cost of the draws from the costs of the shaders, indexed like
+    // CaptureMetadata::m_shaders, and keeps the most expensive ones
+    void GatherDrawCostStats(const Dive::CaptureMetadata         &meta_data,
+                             const std::vector<uint32_t>         &draws,
+                             const std::vector<Dive::ShaderCost> &shader_costs,
+                             CaptureStats                        &capture_stats);
+
+    // Gathers the per-draw state statistics, scanning one state column at a time over the draws of
+    // each render mode. The columns are scanned run by run on the delta-encoded state, without
+    // decoding it. Each list holds ascending event indices.
+    void GatherDrawStateStats(const Dive::EventStateInfoDelta &event_state,
+                              const std::vector<uint32_t>     &draws,
+                              const std::vector<uint32_t>     &binning_draws,
+                              const std::vector<uint32_t>     &direct_or_binning_draws,
+                              CaptureStats                    &capture_stats);
 };
 
 }  // namespace Dive
@@ -90,14 +90,12 @@ void BufferView::OnEventSelected(uint32_t event_index)
     const Dive::CaptureMetadata &metadata = m_data_core.GetCaptureMetadata();
 
     // Add the buffer(s) to the list
-    const uint32_t         kShaderStageCount = (uint32_t)Dive::ShaderStage::kShaderStageCount;
-    const Dive::EventInfo &event_info = metadata.m_event_info[event_index];
+    const uint32_t kShaderStageCount = (uint32_t)Dive::ShaderStage::kShaderStageCount;
     for (uint32_t shader_stage = 0; shader_stage < kShaderStageCount; ++shader_stage)
     {
-        uint32_t num_buffers = (uint32_t)event_info.m_buffer_indices[shader_stage].size();
-        for (uint32_t buffer = 0; buffer < num_buffers; ++buffer)
+        auto stage = (Dive::ShaderStage)shader_stage;
+        for (uint32_t buffer_index : metadata.m_event_info.GetBufferIndices(event_index, stage))
         {
-            uint32_t buffer_index = event_info.m_buffer_indices[shader_stage][buffer];
             const Dive::BufferInfo &buffer_info = metadata.m_buffers[buffer_index];
             BufferWidgetItem       *treeItem = new BufferWidgetItem(buffer_index, m_buffer_list);
 
@@ -17,6 +17,7 @@
 #include <QString>
 #include <QStringList>
 #include <QTreeWidget>
+#include <algorithm>
 
 #include "dive_core/command_hierarchy.h"
 
@@ -30,6 +31,8 @@ CommandModel::CommandModel(const Dive::CommandHierarchy &command_hierarchy) :
     m_command_hierarchy(command_hierarchy)
 {
     m_topology_ptr = nullptr;
+    m_filter_type = Dive::CommandHierarchy::kFilterListTypeCount;
+    m_filtered_topology_ptr = nullptr;
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -40,6 +43,9 @@ void CommandModel::Reset()
 {
     emit beginResetModel();
     m_topology_ptr = nullptr;
+    m_filtered_topology_ptr = nullptr;
+    m_node_lookup.clear();
+    m_search_index.Clear();
     emit endResetModel();
 }
 
@@ -60,10 +66,63 @@ void CommandModel::SetTopologyToView(const Dive::SharedNodeTopology *topology_pt
 {
     BeginResetModel();
     m_topology_ptr = topology_ptr;
+    UpdateFilteredTopology();
+    m_node_lookup.clear();
+    EndResetModel();
+}
+
+//--------------------------------------------------------------------------------------------------
+void CommandModel::SetFilterList(Dive::CommandHierarchy::FilterListType filter_type)
+{
+    BeginResetModel();
+    m_filter_type = filter_type;
+    UpdateFilteredTopology();
     m_node_lookup.clear();
     EndResetModel();
 }
 
+//--------------------------------------------------------------------------------------------------
+void CommandModel::UpdateFilteredTopology()
+{
+    m_filtered_topology_ptr = nullptr;
+    if (m_topology_ptr == nullptr || m_filter_type == Dive::CommandHierarchy::kFilterListTypeCount)
+        return;
+    if (m_topology_ptr == &m_command_hierarchy.GetAllEventHierarchyTopology())
+    {
+        m_filtered_topology_ptr = &m_command_hierarchy.GetFilteredAllEventHierarchyTopology(
+        m_filter_type);
+    }
+    else if (m_topology_ptr == &m_command_hierarchy.GetSubmitHierarchyTopology())
+    {
+        m_filtered_topology_ptr = &m_command_hierarchy.GetFilteredSubmitHierarchyTopology(
+        m_filter_type);
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+uint64_t CommandModel::GetNumChildren(uint64_t node_index) const
+{
+    if (m_filtered_topology_ptr != nullptr)
+        return m_filtered_topology_ptr->GetNumChildren(node_index);
+    return m_topology_ptr->GetNumChildren(node_index);
+}
+
+//--------------------------------------------------------------------------------------------------
+uint64_t CommandModel::GetChildNodeIndex(uint64_t node_index, uint64_t child_index) const
+{
+    if (m_filtered_topology_ptr != nullptr)
+        return m_filtered_topology_ptr->GetChildNodeIndex(node_index, child_index);
+    return m_topology_ptr->GetChildNodeIndex(node_index, child_index);
+}
+
+//--------------------------------------------------------------------------------------------------
+uint64_t CommandModel::GetChildIndex(uint64_t node_index) const
+{
+    if (m_filtered_topology_ptr != nullptr)
+        return m_filtered_topology_ptr->GetChildIndex(node_index);
+    return m_topology_ptr->GetChildIndex(node_index);
+}
+
 //--------------------------------------------------------------------------------------------------
 QVariant CommandModel::data(const QModelIndex &index, int role) const
 {
@@ -139,12 +198,12 @@ QModelIndex CommandModel::index(int row, int column, const QModelIndex &parent)
     {
         // Root level in the model, which is actually one-level down in the topology, since the root
         // node is ignored
-        node_index = m_topology_ptr->GetChildNodeIndex(Dive::Topology::kRootNodeIndex, row);
+        node_index = GetChildNodeIndex(Dive::Topology::kRootNodeIndex, row);
     }
     else
     {
         uint64_t parent_node_index = (uint64_t)(parent.internalPointer());
-        node_index = m_topology_ptr->GetChildNodeIndex(parent_node_index, row);
+        node_index = GetChildNodeIndex(parent_node_index, row);
     }
     return createIndex(row, column, node_index);
 }
@@ -162,7 +221,8 @@ QModelIndex CommandModel::parent(const QModelIndex &index) const
     if (parent_node_index == UINT64_MAX)
         return QModelIndex();
 
-    uint64_t row = m_topology_ptr->GetChildIndex(parent_node_index);
+    // A filter only removes nodes, so a visible node keeps its parent
+    uint64_t row = GetChildIndex(parent_node_index);
     return createIndex(row, 0, (void *)parent_node_index);
 }
 
@@ -180,7 +240,7 @@ int CommandModel::rowCount(const QModelIndex &parent) const
     else
         parent_node_index = (uint64_t)(parent.internalPointer());
 
-    return m_topology_ptr->GetNumChildren(parent_node_index);
+    return GetNumChildren(parent_node_index);
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -234,6 +294,8 @@ void CommandModel::BuildNodeLookup(const QModelIndex &parent) const
     {
         m_node_lookup.clear();
         m_node_lookup.resize(m_command_hierarchy.size());
+        m_node_rank.assign(m_command_hierarchy.size(), UINT64_MAX);
+        m_num_ranked_nodes = 0;
     }
     int n = rowCount(parent);
     for (int r = 0; r < n; ++r)
@@ -241,7 +303,10 @@ void CommandModel::BuildNodeLookup(const QModelIndex &parent) const
         auto     idx = index(r, 0, parent);
         uint64_t node_index = (uint64_t)idx.internalPointer();
         if (node_index < m_node_lookup.size())
+        {
             m_node_lookup[node_index] = QPersistentModelIndex(idx);
+            m_node_rank[node_index] = m_num_ranked_nodes++;
+        }
         BuildNodeLookup(idx);
     }
 }
@@ -249,31 +314,33 @@ void CommandModel::BuildNodeLookup(const QModelIndex &parent) const
 //--------------------------------------------------------------------------------------------------
 QList<QModelIndex> CommandModel::search(const QModelIndex &start, const QVariant &value) const
 {
-    QList<QModelIndex>  result;
-    Qt::CaseSensitivity cs = Qt::CaseInsensitive;
+    QList<QModelIndex> result;
+    if (!start.isValid())
+        return result;
 
-    QString     text;
-    QModelIndex p = parent(start);
-    int         from = start.row();
-    int         to = rowCount(p);
+    if (m_search_index.size() != m_command_hierarchy.size())
+        m_search_index.Build(m_command_hierarchy);
+    if (m_node_lookup.size() != m_command_hierarchy.size())
+        BuildNodeLookup();
 
-    for (int r = from; r < to; ++r)
+    // Matches come back in node order; keep those visible in this view at or after `start`, and
+    // return them in the order they appear in the tree
+    uint64_t start_node = (uint64_t)start.internalPointer();
+    uint64_t start_rank = (start_node < m_node_rank.size()) ? m_node_rank[start_node] : 0;
+
+    std::vector<uint64_t> matches;
+    for (uint64_t node_index : m_search_index.FindSubstring(value.toString().toStdString()))
     {
-        QModelIndex idx = index(r, start.column(), p);
-        if (!idx.isValid())
-            continue;
-        QVariant v = data(idx, Qt::DisplayRole);
-
-        if (text.isEmpty())
-            text = value.toString();
-        QString t = v.toString();
-        if (t.contains(text, cs))
-            result.append(idx);
-
-        // Search the hierarchy
-        if (hasChildren(idx))
-            result += search(index(0, idx.column(), idx), (text.isEmpty() ? value : text));
+        if (m_node_lookup[node_index].isValid() && m_node_rank[node_index] >= start_rank)
+            matches.push_back(node_index);
+    }
+    std::sort(matches.begin(), matches.end(), [this](uint64_t a, uint64_t b) {
+        return m_node_rank[a] < m_node_rank[b];
+    });
+    for (uint64_t node_index : matches)
+    {
+        QModelIndex idx = m_node_lookup[node_index];
+        result.append(index(idx.row(), start.column(), idx.parent()));
     }
-
     return result;
 }
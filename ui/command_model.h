@@ -17,13 +17,10 @@
 #include <QList>
 #include <QModelIndex>
 #include <QVariant>
+#include <vector>
 
-// Forward Declarations
-namespace Dive
-{
-class CommandHierarchy;
-class SharedNodeTopology;
-};  // namespace Dive
+#include "dive_core/command_hierarchy.h"
+#include "dive_core/command_hierarchy_search.h"
 
 class CommandModel : public QAbstractItemModel
 {
@@ -45,6 +42,10 @@ public:
     void EndResetModel();
     void SetTopologyToView(const Dive::SharedNodeTopology *topology_ptr);
 
+    // Shows only the nodes kept by `filter_type`, or all of them for kFilterListTypeCount. The rows
+    // come from the topology's precomputed filtered view, so switching filters is a single reset
+    void SetFilterList(Dive::CommandHierarchy::FilterListType filter_type);
+
     QVariant      data(const QModelIndex &index, int role) const override;
     Qt::ItemFlags flags(const QModelIndex &index) const override;
     QVariant      headerData(int             section,
@@ -76,7 +77,24 @@ private:
     uint32_t GetEventNodeIndexInStream(uint64_t node_index) const;
     void     BuildNodeLookup(const QModelIndex &parent = QModelIndex()) const;
 
+    // Picks the filtered view of m_topology_ptr for m_filter_type
+    void UpdateFilteredTopology();
+
+    // Children of a node in the current view, through the filtered topology if there is a filter
+    uint64_t GetNumChildren(uint64_t node_index) const;
+    uint64_t GetChildNodeIndex(uint64_t node_index, uint64_t child_index) const;
+    uint64_t GetChildIndex(uint64_t node_index) const;
+
     const Dive::CommandHierarchy              &m_command_hierarchy;
     const Dive::SharedNodeTopology            *m_topology_ptr;
+    Dive::CommandHierarchy::FilterListType     m_filter_type;
+    const Dive::FilteredTopology              *m_filtered_topology_ptr;
     mutable std::vector<QPersistentModelIndex> m_node_lookup;
+
+    // Pre-order position of each node in the current view, filled alongside m_node_lookup
+    mutable std::vector<uint64_t> m_node_rank;
+    mutable uint64_t              m_num_ranked_nodes = 0;
+
+    // Built on the first search after the hierarchy changes
+    mutable Dive::CommandHierarchySearchIndex m_search_index;
 };
@@ -47,56 +47,37 @@ DiveFilterModel::DiveFilterModel(const Dive::CommandHierarchy &command_hierarchy
 {
 }
 
+static Dive::CommandHierarchy::FilterListType GetFilterListType(DiveFilterModel::FilterMode mode)
+{
+    switch (mode)
+    {
+    case DiveFilterModel::kBinningPassOnly:
+        return Dive::CommandHierarchy::kBinningPassOnly;
+    case DiveFilterModel::kFirstTilePassOnly:
+        return Dive::CommandHierarchy::kFirstTilePassOnly;
+    case DiveFilterModel::kBinningAndFirstTilePass:
+        return Dive::CommandHierarchy::kBinningAndFirstTilePass;
+    default:
+        return Dive::CommandHierarchy::kFilterListTypeCount;
+    }
+}
+
 void DiveFilterModel::applyNewFilterMode(FilterMode new_mode)
 {
     // Check if the mode is actually changing to avoid unnecessary resets
     if (m_filter_mode == new_mode)
         return;
 
-    beginResetModel();
     m_filter_mode = new_mode;
 
-    // Clear the vector of pm4 draw call indices.
-    m_pm4_draw_call_indices.clear();
+    // The command model serves the rows of the precomputed filtered topology, so no row is
+    // re-filtered here. Its reset also resets this proxy's mapping.
+    CommandModel *command_model = qobject_cast<CommandModel *>(sourceModel());
+    if (command_model)
+        command_model->SetFilterList(GetFilterListType(new_mode));
+
     // Recollect pm4 draw call indices when new filter is applied.
     CollectPm4DrawCallIndices(QModelIndex());
-
-    // invalidateFilter() doesn't invalidate all nodes
-    // begin/endResetModel() will cause a full re-evaluation and rebuild of the proxy's internal
-    // mapping.
-    endResetModel();
-}
-
-bool DiveFilterModel::IncludeIndex(uint64_t node_index) const
-{
-    Dive::CommandHierarchy::FilterListType
-    filter_list_type = Dive::CommandHierarchy::kFilterListTypeCount;
-
-    switch (m_filter_mode)
-    {
-    case kBinningPassOnly:
-        filter_list_type = Dive::CommandHierarchy::kBinningPassOnly;
-        break;
-    case kFirstTilePassOnly:
-        filter_list_type = Dive::CommandHierarchy::kFirstTilePassOnly;
-        break;
-    case kBinningAndFirstTilePass:
-        filter_list_type = Dive::CommandHierarchy::kBinningAndFirstTilePass;
-        break;
-    default:
-        return true;
-    }
-
-    const auto &filter_exclude_indices = m_command_hierarchy.GetFilterExcludeIndices(
-    filter_list_type);
-
-    // If the node index is in the exclude list, we exclude the index.
-    if (filter_exclude_indices.find(node_index) != filter_exclude_indices.end())
-    {
-        return false;
-    }
-
-    return true;
 }
 
 void DiveFilterModel::SetMode(FilterMode filter_mode)
@@ -106,20 +87,11 @@ void DiveFilterModel::SetMode(FilterMode filter_mode)
 
 void DiveFilterModel::CollectPm4DrawCallIndices(const QModelIndex &parent_index)
 {
+    // The source model only has the rows kept by the filter
     if (!parent_index.isValid())
     {
         m_pm4_draw_call_indices.clear();
     }
-    else
-    {
-        // Check if the current parent node is filtered out.
-        uint64_t parent_node_index = (uint64_t)parent_index.internalPointer();
-
-        if (!IncludeIndex(parent_node_index))
-        {
-            return;
-        }
-    }
 
     int row_count = sourceModel()->rowCount(parent_index);
     for (int row = 0; row < row_count; ++row)
@@ -160,17 +132,8 @@ bool DiveFilterModel::filterAcceptsRow(int sourceRow, const QModelIndex &sourceP
         return false;
     }
 
-    if (!index.isValid())
-    {
-        return false;
-    }
-
-    if (m_filter_mode == kNone)
-    {
-        return true;
-    }
-
-    return IncludeIndex(node_index);
+    // The filter mode is applied by the source model, see applyNewFilterMode()
+    return index.isValid();
 }
 
 // =================================================================================================
@@ -52,7 +52,6 @@ public:
     };
 
     DiveFilterModel(const Dive::CommandHierarchy &command_hierarchy, QObject *parent = nullptr);
-    bool IncludeIndex(uint64_t node_index) const;
     void SetMode(FilterMode filter_mode);
     void CollectPm4DrawCallIndices(const QModelIndex &parent_index = QModelIndex());
     void ClearDrawCallIndices();
@@ -17,7 +17,7 @@
 #include <QStringList>
 #include <QDebug>
 
-constexpr std::array<Dive::Stats::Type, 28> kDrawDispatchStats = {
+constexpr std::array<Dive::Stats::Type, 41> kDrawDispatchStats = {
     Dive::Stats::kBinningDraws,
     Dive::Stats::kDirectDraws,
     Dive::Stats::kTiledDraws,
@@ -28,6 +28,8 @@ constexpr std::array<Dive::Stats::Type, 28> kDrawDispatchStats = {
     Dive::Stats::kMinIndices,
     Dive::Stats::kMaxIndices,
     Dive::Stats::kMedianIndices,
+    Dive::Stats::kP90Indices,
+    Dive::Stats::kP99Indices,
 
     // Draw State Stats
     Dive::Stats::kDepthTestEnabled,
@@ -47,10 +49,21 @@ constexpr std::array<Dive::Stats::Type, 28> kDrawDispatchStats = {
     Dive::Stats::kMinInstructions,
     Dive::Stats::kMaxInstructions,
     Dive::Stats::kMedianInstructions,
+    Dive::Stats::kP90Instructions,
+    Dive::Stats::kP99Instructions,
     Dive::Stats::kTotalGPRs,
     Dive::Stats::kMinGPRs,
     Dive::Stats::kMaxGPRs,
     Dive::Stats::kMedianGPRs,
+    Dive::Stats::kP90GPRs,
+    Dive::Stats::kP99GPRs,
+    Dive::Stats::kAluInstructions,
+    Dive::Stats::kSfuInstructions,
+    Dive::Stats::kTextureInstructions,
+    Dive::Stats::kMemoryInstructions,
+    Dive::Stats::kFlowInstructions,
+    Dive::Stats::kMinWaves,
+    Dive::Stats::kVertexShaderCycles,
 };
 
 constexpr std::array<const char *, Dive::Stats::kNumStats> kStatDescriptions = [] {
@@ -20,6 +20,7 @@
 #include <QVBoxLayout>
 #include <map>
 #include <string>
+#include <vector>
 #include "dive_core/command_hierarchy.h"
 #include "dive_core/data_core.h"
 #include "dive_core/dive_strings.h"
@@ -156,23 +157,17 @@ void EventStateView::OnEventSelected(uint64_t node_index)
 
     auto &metadata = m_data_core.GetCaptureMetadata();
     auto &command_hierarchy = m_data_core.GetCommandHierarchy();
-    auto &event_state = metadata.m_event_state;
 
-    auto previous_event_state = [&](auto it) {
-        auto prev_it = std::prev(it);
-        while (prev_it->IsValid())
+    // Id of the draw or dispatch before `event_id`, UINT32_MAX if there is none
+    auto previous_event_id = [&](uint32_t event_id) {
+        while (event_id-- > 0)
         {
-            auto id = static_cast<Dive::EventStateId>(prev_it->id());
-            // Check if it's draw or dispatch events
-            const Dive::EventInfo &prev_event_info = metadata
-                                                     .m_event_info[static_cast<uint32_t>(id)];
+            const Dive::EventInfo &prev_event_info = metadata.m_event_info[event_id];
             if (prev_event_info.m_type == Dive::EventInfo::EventType::kDraw ||
                 prev_event_info.m_type == Dive::EventInfo::EventType::kDispatch)
-                break;
-            else
-                prev_it = std::prev(prev_it);
+                return event_id;
         }
-        return prev_it;
+        return UINT32_MAX;
     };
 
     auto display_event_state_info = [&](uint64_t event_node_index) {
@@ -184,9 +179,18 @@ void EventStateView::OnEventSelected(uint64_t node_index)
         if (event_info.m_type == Dive::EventInfo::EventType::kDraw ||
             event_info.m_type == Dive::EventInfo::EventType::kDispatch)
         {
-            auto event_state_it = GetStateInfoForEvent(event_state, event_id);
-            auto prev_event_state_it = previous_event_state(event_state_it);
-            DisplayEventStateInfo(event_state_it, prev_event_state_it);
+            // Only this event and the previous draw/dispatch are decoded from the metadata. With
+            // no previous one, the iterator before the decoded event is invalid as expected
+            std::vector<uint32_t> ids;
+            uint32_t              prev_event_id = previous_event_id(event_id);
+            if (prev_event_id != UINT32_MAX)
+                ids.push_back(prev_event_id);
+            ids.push_back(event_id);
+            Dive::EventStateInfo event_state;
+            metadata.m_event_state.Decode(ids, &event_state);
+
+            auto event_state_it = event_state.find(Dive::EventStateId(ids.size() - 1));
+            DisplayEventStateInfo(event_state_it, std::prev(event_state_it));
         }
     };
 
@@ -222,13 +226,6 @@ void EventStateView::OnEventSelected(uint64_t node_index)
         m_event_state_tree->resizeColumnToContents(column);
 }
 
-Dive::EventStateInfo::ConstIterator EventStateView::GetStateInfoForEvent(
-const Dive::EventStateInfo &state,
-uint32_t                    event_id)
-{
-    return state.find(static_cast<Dive::EventStateId>(event_id));
-}
-
 //--------------------------------------------------------------------------------------------------
 void EventStateView::DisplayEventStateInfo(Dive::EventStateInfo::ConstIterator event_state_it,
                                            Dive::EventStateInfo::ConstIterator prev_event_state_it)
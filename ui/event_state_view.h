@@ -47,8 +47,6 @@ private:
     const Dive::DataCore              &m_data_core;
     QTreeWidget                       *m_event_state_tree;
 
-    Dive::EventStateInfo::ConstIterator GetStateInfoForEvent(const Dive::EventStateInfo &state,
-                                                             uint32_t                    event_id);
     void BuildDescriptionMap(Dive::EventStateInfo::ConstIterator event_state_it);
     void DisplayEventStateInfo(Dive::EventStateInfo::ConstIterator event_state_it,
                                Dive::EventStateInfo::ConstIterator prev_event_state_it);
@@ -26,6 +26,7 @@
 #include <QMenuBar>
 #include <QMessageBox>
 #include <QSplitter>
+#include <QStandardPaths>
 #include <QStandardItemModel>
 #include <QTabWidget>
 #include <QToolButton>
@@ -67,6 +68,7 @@
 #endif
 #include "command_tab_view.h"
 #include "dive_core/data_core.h"
+#include "dive_core/shader_disassembly_cache.h"
 #include "event_selection_model.h"
 #include "event_state_view.h"
 #include "gfxr_vulkan_command_model.h"
@@ -217,6 +219,13 @@ MainWindow::MainWindow()
     m_log_compound.AddLog(&m_log_console);
 
     m_data_core = std::make_unique<Dive::DataCore>(&m_progress_tracker);
+    m_data_core->SetBackgroundDisassembly(true);
+    QString cache_dir = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+    if (!cache_dir.isEmpty())
+    {
+        std::filesystem::path cache_path(cache_dir.toStdString());
+        Dive::ShaderDisassemblyCache::GetInstance().SetDirectory(cache_path / "shader_disassembly");
+    }
     m_data_core_lock.lockForRead();
 
     m_event_selection = new EventSelection(m_data_core->GetCommandHierarchy());
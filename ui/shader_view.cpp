@@ -188,7 +188,7 @@ void ShaderView::paintEvent(QPaintEvent *event)
                 return;
             }
             const Dive::EventInfo &event = metadata.m_event_info[event_id];
-            for (const auto &reference : event.m_shader_references)
+            for (const auto &reference : metadata.m_event_info.GetShaderReferences(event_id))
             {
                 auto shader_stage = (uint32_t)reference.m_stage;
                 // Do not add shaders that are not used by the event
@@ -16,6 +16,7 @@
 #include <QTextStream>
 #include <QStringList>
 #include <QDebug>
+#include <algorithm>
 
 ViewportStatsModel::ViewportStatsModel(QObject *parent) :
     QAbstractItemModel(parent)
@@ -32,12 +33,14 @@ ViewportStatsModel::ViewportStatsModel(QObject *parent) :
 }
 
 //--------------------------------------------------------------------------------------------------
-void ViewportStatsModel::LoadData(const std::set<Dive::Viewport> &viewports)
+void ViewportStatsModel::LoadData(
+const std::unordered_set<Dive::Viewport, Dive::ViewportHash> &viewports)
 {
     beginResetModel();
     // Clear existing data
     m_viewports.clear();
     m_viewports.assign(viewports.begin(), viewports.end());
+    std::sort(m_viewports.begin(), m_viewports.end());
     endResetModel();
 }
 
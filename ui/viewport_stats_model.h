@@ -23,7 +23,7 @@ class ViewportStatsModel : public QAbstractItemModel
 public:
     explicit ViewportStatsModel(QObject *parent = nullptr);
 
-    void LoadData(const std::set<Dive::Viewport> &viewports);
+    void LoadData(const std::unordered_set<Dive::Viewport, Dive::ViewportHash> &viewports);
 
     // QAbstractItemModel interface
     QModelIndex index(int                row,
@@ -16,6 +16,7 @@
 #include <QTextStream>
 #include <QStringList>
 #include <QDebug>
+#include <algorithm>
 
 WindowScissorsStatsModel::WindowScissorsStatsModel(QObject *parent) :
     QAbstractItemModel(parent)
@@ -33,12 +34,14 @@ WindowScissorsStatsModel::WindowScissorsStatsModel(QObject *parent) :
 }
 
 //--------------------------------------------------------------------------------------------------
-void WindowScissorsStatsModel::LoadData(const std::set<Dive::WindowScissor> &window_scissors)
+void WindowScissorsStatsModel::LoadData(
+const std::unordered_set<Dive::WindowScissor, Dive::WindowScissorHash> &window_scissors)
 {
     beginResetModel();
     // Clear existing data
     m_window_scissors.clear();
     m_window_scissors.assign(window_scissors.begin(), window_scissors.end());
+    std::sort(m_window_scissors.begin(), m_window_scissors.end());
     endResetModel();
 }
 
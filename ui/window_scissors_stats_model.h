@@ -23,7 +23,8 @@ class WindowScissorsStatsModel : public QAbstractItemModel
 public:
     explicit WindowScissorsStatsModel(QObject *parent = nullptr);
 
-    void LoadData(const std::set<Dive::WindowScissor> &window_scissors);
+    void LoadData(
+    const std::unordered_set<Dive::WindowScissor, Dive::WindowScissorHash> &window_scissors);
 
     // QAbstractItemModel interface
     QModelIndex index(int                row,